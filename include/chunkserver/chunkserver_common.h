@@ -125,6 +125,8 @@ inline std::string ToGroupIdString(const LogicPoolID &logicPoolId,
 
 // TODO(wudmeiao): 是否需要考虑可配置
 const uint32_t kOpRequestAlignSize = 4096;
+// 批量读写请求中子请求的最大个数
+const uint32_t kMaxBatchSubRequests = 128;
 
 }  // namespace chunkserver
 }  // namespace curve
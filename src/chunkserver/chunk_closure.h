@@ -27,6 +27,7 @@
 #include <memory>
 
 #include "src/chunkserver/op_request.h"
+#include "src/common/object_pool.h"
 
 namespace curve {
 namespace chunkserver {
@@ -47,6 +48,14 @@ class ChunkClosure : public braft::Closure {
 
     void Run() override;
 
+    // 每个propose的请求都会创建一个closure，从对象池分配
+    static void *operator new(size_t size) {
+        return common::PoolNew<ChunkClosure>(size);
+    }
+    static void operator delete(void *p, size_t size) {
+        common::PoolDelete<ChunkClosure>(p, size);
+    }
+
  public:
     // 包含了op request 的上下文信息
     std::shared_ptr<ChunkOpRequest> request_;
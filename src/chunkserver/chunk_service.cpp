@@ -35,14 +35,18 @@
 #include "src/chunkserver/chunkserver_metrics.h"
 #include "src/chunkserver/op_request.h"
 #include "src/chunkserver/chunk_service_closure.h"
+#include "src/common/object_pool.h"
 
 namespace curve {
 namespace chunkserver {
 
+using curve::common::MakePooledShared;
+
 ChunkServiceImpl::ChunkServiceImpl(ChunkServiceOptions chunkServiceOptions) :
     chunkServiceOptions_(chunkServiceOptions),
     copysetNodeManager_(chunkServiceOptions.copysetNodeManager),
-    inflightThrottle_(chunkServiceOptions.inflightThrottle) {
+    inflightThrottle_(chunkServiceOptions.inflightThrottle),
+    ioThrottle_(chunkServiceOptions.ioThrottle) {
     maxChunkSize_ = copysetNodeManager_->GetCopysetNodeOptions().maxChunkSize;
 }
 
@@ -54,12 +58,13 @@ void ChunkServiceImpl::DeleteChunk(RpcController *controller,
         new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
                                                request,
                                                response,
-                                               done);
+                                               done,
+                                               QOS_CLASS_CLIENT);
     CHECK(nullptr != closure) << "new chunk service closure failed";
 
     brpc::ClosureGuard doneGuard(closure);
 
-    if (inflightThrottle_->IsOverLoad()) {
+    if (IsOverLoad(QOS_CLASS_CLIENT, request, 0)) {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
         LOG_EVERY_N(WARNING, 100)
             << "DeleteChunk: "
@@ -78,7 +83,7 @@ void ChunkServiceImpl::DeleteChunk(RpcController *controller,
     }
 
     std::shared_ptr<DeleteChunkRequest>
-        req = std::make_shared<DeleteChunkRequest>(nodePtr,
+        req = MakePooledShared<DeleteChunkRequest>(nodePtr,
                                                    controller,
                                                    request,
                                                    response,
@@ -94,12 +99,13 @@ void ChunkServiceImpl::WriteChunk(RpcController *controller,
         new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
                                                request,
                                                response,
-                                               done);
+                                               done,
+                                               QOS_CLASS_CLIENT);
     CHECK(nullptr != closure) << "new chunk service closure failed";
 
     brpc::ClosureGuard doneGuard(closure);
 
-    if (inflightThrottle_->IsOverLoad()) {
+    if (IsOverLoad(QOS_CLASS_CLIENT, request, request->size())) {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
         LOG_EVERY_N(WARNING, 100)
             << "WriteChunk: "
@@ -135,11 +141,94 @@ void ChunkServiceImpl::WriteChunk(RpcController *controller,
     }
 
     std::shared_ptr<WriteChunkRequest>
-        req = std::make_shared<WriteChunkRequest>(nodePtr,
+        req = MakePooledShared<WriteChunkRequest>(nodePtr,
                                                   controller,
-                                                  request,
-                                                  response,
-                                                  doneGuard.release());
+            request,
+            response,
+            doneGuard.release());
+    req->Process();
+}
+
+void ChunkServiceImpl::ReadChunks(RpcController *controller,
+                                  const ChunkRequest *request,
+                                  ChunkResponse *response,
+                                  Closure *done) {
+    ProcessBatch(controller, request, response, done);
+}
+
+void ChunkServiceImpl::WriteChunks(RpcController *controller,
+                                   const ChunkRequest *request,
+                                   ChunkResponse *response,
+                                   Closure *done) {
+    ProcessBatch(controller, request, response, done);
+}
+
+void ChunkServiceImpl::ProcessBatch(RpcController *controller,
+                                    const ChunkRequest *request,
+                                    ChunkResponse *response,
+                                    Closure *done) {
+    brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
+    // 批量请求的raft日志老版本的chunkserver无法解析, 没有开启时按不支持该接口
+    // 返回, client收到ENOMETHOD后关闭批量请求
+    if (!chunkServiceOptions_.enableBatchRequest) {
+        brpc::ClosureGuard doneGuard(done);
+        cntl->SetFailed(brpc::ENOMETHOD, "batch request is disabled");
+        return;
+    }
+
+    ChunkServiceClosure* closure =
+        new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
+                                               request,
+                                               response,
+                                               done,
+                                               QOS_CLASS_CLIENT);
+    CHECK(nullptr != closure) << "new chunk service closure failed";
+
+    brpc::ClosureGuard doneGuard(closure);
+
+    bool isWrite =
+        request->optype() == CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH;
+    uint64_t dataSize = isWrite ? cntl->request_attachment().size() : 0;
+    uint64_t bytes = 0;
+    // 判断request参数是否合法
+    if ((!isWrite &&
+         request->optype() != CHUNK_OP_TYPE::CHUNK_OP_READ_BATCH) ||
+        !CheckBatchRequest(request, dataSize, &bytes)) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST);
+        LOG(WARNING) << "invalid batch request, op: " << request->optype()
+                     << " sub requests: " << request->subrequests_size()
+                     << " data size: " << dataSize;
+        return;
+    }
+
+    // 批量请求按子请求个数消耗iops令牌, inflight计数在closure中同样按子请求
+    // 个数统计
+    if (IsOverLoad(QOS_CLASS_CLIENT, request, bytes,
+                   request->subrequests_size())) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
+        LOG_EVERY_N(WARNING, 100)
+            << (isWrite ? "WriteChunks: " : "ReadChunks: ")
+            << "too many inflight requests to process in chunkserver";
+        return;
+    }
+
+    // 判断copyset是否存在
+    auto nodePtr = copysetNodeManager_->GetCopysetNode(request->logicpoolid(),
+                                                       request->copysetid());
+    if (nullptr == nodePtr) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_COPYSET_NOTEXIST);
+        LOG(WARNING) << "batch request failed, copyset node is not found:"
+                     << request->logicpoolid() << "," << request->copysetid();
+        return;
+    }
+
+    std::shared_ptr<ChunkBatchRequest> req =
+        MakePooledShared<ChunkBatchRequest>(nodePtr,
+                                            chunkServiceOptions_.cloneManager,
+                                            controller,
+                                            request,
+                                            response,
+                                            doneGuard.release());
     req->Process();
 }
 
@@ -151,12 +240,13 @@ void ChunkServiceImpl::CreateCloneChunk(RpcController *controller,
         new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
                                                request,
                                                response,
-                                               done);
+                                               done,
+                                               QOS_CLASS_CLONE);
     CHECK(nullptr != closure) << "new chunk service closure failed";
 
     brpc::ClosureGuard doneGuard(closure);
 
-    if (inflightThrottle_->IsOverLoad()) {
+    if (IsOverLoad(QOS_CLASS_CLONE, request, 0)) {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
         LOG_EVERY_N(WARNING, 100)
             << "CreateCloneChunk: "
@@ -184,7 +274,7 @@ void ChunkServiceImpl::CreateCloneChunk(RpcController *controller,
     }
 
     std::shared_ptr<CreateCloneChunkRequest>
-        req = std::make_shared<CreateCloneChunkRequest>(nodePtr,
+        req = MakePooledShared<CreateCloneChunkRequest>(nodePtr,
                                                         controller,
                                                         request,
                                                         response,
@@ -209,12 +299,13 @@ void ChunkServiceImpl::ReadChunk(RpcController *controller,
         new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
                                                request,
                                                response,
-                                               done);
+                                               done,
+                                               QOS_CLASS_CLIENT);
     CHECK(nullptr != closure) << "new chunk service closure failed";
 
     brpc::ClosureGuard doneGuard(closure);
 
-    if (inflightThrottle_->IsOverLoad()) {
+    if (IsOverLoad(QOS_CLASS_CLIENT, request, request->size())) {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
         LOG_EVERY_N(WARNING, 100)
             << "ReadChunk: "
@@ -244,7 +335,7 @@ void ChunkServiceImpl::ReadChunk(RpcController *controller,
     }
 
     std::shared_ptr<ReadChunkRequest> req =
-        std::make_shared<ReadChunkRequest>(nodePtr,
+        MakePooledShared<ReadChunkRequest>(nodePtr,
                                            chunkServiceOptions_.cloneManager,
                                            controller,
                                            request,
@@ -261,12 +352,13 @@ void ChunkServiceImpl::RecoverChunk(RpcController *controller,
         new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
                                                request,
                                                response,
-                                               done);
+                                               done,
+                                               QOS_CLASS_CLONE);
     CHECK(nullptr != closure) << "new chunk service closure failed";
 
     brpc::ClosureGuard doneGuard(closure);
 
-    if (inflightThrottle_->IsOverLoad()) {
+    if (IsOverLoad(QOS_CLASS_CLONE, request, request->size())) {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
         LOG_EVERY_N(WARNING, 100)
             << "RecoverChunk: "
@@ -296,7 +388,7 @@ void ChunkServiceImpl::RecoverChunk(RpcController *controller,
 
     // RecoverChunk请求和ReadChunk请求共用ReadChunkRequest
     std::shared_ptr<ReadChunkRequest> req =
-        std::make_shared<ReadChunkRequest>(nodePtr,
+        MakePooledShared<ReadChunkRequest>(nodePtr,
                                            chunkServiceOptions_.cloneManager,
                                            controller,
                                            request,
@@ -313,12 +405,13 @@ void ChunkServiceImpl::ReadChunkSnapshot(RpcController *controller,
         new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
                                                request,
                                                response,
-                                               done);
+                                               done,
+                                               QOS_CLASS_SNAPSHOT);
     CHECK(nullptr != closure) << "new chunk service closure failed";
 
     brpc::ClosureGuard doneGuard(closure);
 
-    if (inflightThrottle_->IsOverLoad()) {
+    if (IsOverLoad(QOS_CLASS_SNAPSHOT, request, request->size())) {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
         LOG_EVERY_N(WARNING, 100)
             << "ReadChunkSnapshot: "
@@ -343,7 +436,7 @@ void ChunkServiceImpl::ReadChunkSnapshot(RpcController *controller,
     }
 
     std::shared_ptr<ReadSnapshotRequest>
-        req = std::make_shared<ReadSnapshotRequest>(nodePtr,
+        req = MakePooledShared<ReadSnapshotRequest>(nodePtr,
                                                     controller,
                                                     request,
                                                     response,
@@ -360,12 +453,13 @@ void ChunkServiceImpl::DeleteChunkSnapshotOrCorrectSn(
         new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
                                                request,
                                                response,
-                                               done);
+                                               done,
+                                               QOS_CLASS_SNAPSHOT);
     CHECK(nullptr != closure) << "new chunk service closure failed";
 
     brpc::ClosureGuard doneGuard(closure);
 
-    if (inflightThrottle_->IsOverLoad()) {
+    if (IsOverLoad(QOS_CLASS_SNAPSHOT, request, 0)) {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
         LOG_EVERY_N(WARNING, 100)
             << "DeleteChunkSnapshotOrCorrectSn: "
@@ -392,7 +486,7 @@ void ChunkServiceImpl::DeleteChunkSnapshotOrCorrectSn(
     }
 
     std::shared_ptr<DeleteSnapshotRequest>
-        req = std::make_shared<DeleteSnapshotRequest>(nodePtr,
+        req = MakePooledShared<DeleteSnapshotRequest>(nodePtr,
                                                       controller,
                                                       request,
                                                       response,
@@ -414,12 +508,13 @@ void ChunkServiceImpl::GetChunkInfo(RpcController *controller,
         new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
                                                nullptr,
                                                nullptr,
-                                               done);
+                                               done,
+                                               QOS_CLASS_CLIENT);
     CHECK(nullptr != closure) << "new chunk service closure failed";
 
     brpc::ClosureGuard doneGuard(closure);
 
-    if (inflightThrottle_->IsOverLoad()) {
+    if (inflightThrottle_->IsOverLoad(QOS_CLASS_CLIENT)) {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
         LOG_EVERY_N(WARNING, 100)
             << "GetChunkInfo: "
@@ -448,6 +543,11 @@ void ChunkServiceImpl::GetChunkInfo(RpcController *controller,
         return;
     }
 
+    // follower读先向leader获取read index，在获取chunk信息之前取，
+    // 保证不早于收到请求前已应答的写
+    uint64_t readIndex = 0;
+    bool hasReadIndex = nodePtr->GetReadIndex(&readIndex);
+
     CSErrorCode ret;
     CSChunkInfo chunkInfo;
 
@@ -458,9 +558,18 @@ void ChunkServiceImpl::GetChunkInfo(RpcController *controller,
         response->add_chunksn(chunkInfo.curSn);
         if (chunkInfo.snapSn > 0)
             response->add_chunksn(chunkInfo.snapSn);
+        response->set_isclone(chunkInfo.isClone);
+        response->set_appliedindex(nodePtr->GetAppliedIndex());
+        if (hasReadIndex) {
+            response->set_readindex(readIndex);
+        }
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
     } else if (CSErrorCode::ChunkNotExistError == ret) {
         // 2.chunk文件不存在，返回的版本集合为空
+        response->set_appliedindex(nodePtr->GetAppliedIndex());
+        if (hasReadIndex) {
+            response->set_readindex(readIndex);
+        }
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
     } else {
         // 3.其他错误
@@ -475,11 +584,117 @@ void ChunkServiceImpl::GetChunkInfo(RpcController *controller,
     }
 }
 
+/**
+ * 同GetChunkInfo，一次查询同一个copyset中的多个chunk，
+ * 只读取CSMetaCache中的元数据，不访问磁盘
+ */
+void ChunkServiceImpl::GetChunksInfo(RpcController *controller,
+                                     const GetChunksInfoRequest *request,
+                                     GetChunksInfoResponse *response,
+                                     Closure *done) {
+    ChunkServiceClosure* closure =
+        new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
+                                               nullptr,
+                                               nullptr,
+                                               done,
+                                               QOS_CLASS_CLIENT);
+    CHECK(nullptr != closure) << "new chunk service closure failed";
+
+    brpc::ClosureGuard doneGuard(closure);
+
+    if (inflightThrottle_->IsOverLoad(QOS_CLASS_CLIENT)) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
+        LOG_EVERY_N(WARNING, 100)
+            << "GetChunksInfo: "
+            << "too many inflight requests to process in chunkserver";
+        return;
+    }
+
+    // 判断copyset是否存在
+    auto nodePtr =
+        copysetNodeManager_->GetCopysetNode(request->logicpoolid(),
+                                            request->copysetid());
+    if (nullptr == nodePtr) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_COPYSET_NOTEXIST);
+        LOG(WARNING) << "GetChunksInfo failed, copyset node is not found: "
+                     << request->logicpoolid() << "," << request->copysetid();
+        return;
+    }
+
+    // 检查任期和自己是不是Leader
+    if (!nodePtr->IsLeaderTerm()) {
+        PeerId leader = nodePtr->GetLeaderId();
+        if (!leader.is_empty()) {
+            response->set_redirect(leader.to_string());
+        }
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED);
+        return;
+    }
+
+    auto dataStore = nodePtr->GetDataStore();
+    for (int i = 0; i < request->chunkids_size(); ++i) {
+        ChunkID chunkId = request->chunkids(i);
+        ChunkInfoSummary *summary = response->add_chunkinfos();
+        summary->set_chunkid(chunkId);
+
+        CSChunkInfo chunkInfo;
+        CSErrorCode ret = dataStore->GetChunkInfo(chunkId, &chunkInfo);
+        if (CSErrorCode::ChunkNotExistError == ret) {
+            // chunk文件不存在，返回的版本集合为空
+            continue;
+        } else if (CSErrorCode::Success != ret) {
+            LOG(ERROR) << "get chunk info failed, "
+                       << " logic pool id: " << request->logicpoolid()
+                       << " copyset id: " << request->copysetid()
+                       << " chunk id: " << chunkId
+                       << " data store return: " << ret;
+            response->clear_chunkinfos();
+            response->set_status(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN);
+            return;
+        }
+
+        summary->add_chunksn(chunkInfo.curSn);
+        if (chunkInfo.snapSn > 0)
+            summary->add_chunksn(chunkInfo.snapSn);
+        summary->set_correctedsn(chunkInfo.correctedSn);
+        summary->set_isclone(chunkInfo.isClone);
+        if (chunkInfo.isClone && chunkInfo.bitmap != nullptr) {
+            std::vector<curve::common::BitRange> setRanges;
+            chunkInfo.bitmap->Divide(0, chunkInfo.bitmap->Size() - 1,
+                                     nullptr, &setRanges);
+            uint32_t writtenPageNum = 0;
+            for (auto &range : setRanges) {
+                writtenPageNum += range.endIndex - range.beginIndex + 1;
+            }
+            summary->set_writtenpagenum(writtenPageNum);
+        }
+    }
+    response->set_appliedindex(nodePtr->GetAppliedIndex());
+    response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+}
+
 void ChunkServiceImpl::GetChunkHash(RpcController *controller,
                                     const GetChunkHashRequest *request,
                                     GetChunkHashResponse *response,
                                     Closure *done) {
-    brpc::ClosureGuard doneGuard(done);
+    ChunkServiceClosure* closure =
+        new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
+                                               nullptr,
+                                               nullptr,
+                                               done,
+                                               QOS_CLASS_SCRUB);
+    CHECK(nullptr != closure) << "new chunk service closure failed";
+
+    brpc::ClosureGuard doneGuard(closure);
+
+    if (IsOverLoad(QOS_CLASS_SCRUB, nullptr, request->length())) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
+        LOG_EVERY_N(WARNING, 100)
+            << "GetChunkHash: "
+            << "too many inflight requests to process in chunkserver";
+        return;
+    }
 
     // 判断request参数是否合法
     if (!CheckRequestOffsetAndLength(request->offset(), request->length())) {
@@ -534,6 +749,47 @@ void ChunkServiceImpl::GetChunkHash(RpcController *controller,
     }
 }
 
+bool ChunkServiceImpl::IsOverLoad(QosClass qosClass,
+                                  const ChunkRequest *request,
+                                  uint64_t bytes,
+                                  uint32_t ops) {
+    if (inflightThrottle_->IsOverLoad(qosClass)) {
+        return true;
+    }
+    if (nullptr != ioThrottle_ &&
+        ioThrottle_->IsOverLoad(qosClass, request, bytes, ops)) {
+        return true;
+    }
+    return false;
+}
+
+bool ChunkServiceImpl::CheckBatchRequest(const ChunkRequest *request,
+                                         uint64_t dataSize,
+                                         uint64_t *bytes) {
+    uint32_t subCount = request->subrequests_size();
+    if (subCount == 0 || subCount > kMaxBatchSubRequests) {
+        return false;
+    }
+
+    CHUNK_OP_TYPE subOpType =
+        request->optype() == CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH
+        ? CHUNK_OP_TYPE::CHUNK_OP_WRITE : CHUNK_OP_TYPE::CHUNK_OP_READ;
+    *bytes = 0;
+    for (const auto &sub : request->subrequests()) {
+        if (sub.optype() != subOpType ||
+            sub.logicpoolid() != request->logicpoolid() ||
+            sub.copysetid() != request->copysetid() ||
+            sub.subrequests_size() != 0 || sub.size() == 0 ||
+            !CheckRequestOffsetAndLength(sub.offset(), sub.size())) {
+            return false;
+        }
+        *bytes += sub.size();
+    }
+
+    // 写请求的数据按顺序拼接在attachment中
+    return subOpType == CHUNK_OP_TYPE::CHUNK_OP_READ || *bytes == dataSize;
+}
+
 bool ChunkServiceImpl::CheckRequestOffsetAndLength(uint32_t offset,
                                                    uint32_t len) {
     // 检查offset+len是否越界
@@ -58,6 +58,16 @@ class ChunkServiceImpl : public ChunkService {
                     ChunkResponse *response,
                     Closure *done);
 
+    void ReadChunks(RpcController *controller,
+                    const ChunkRequest *request,
+                    ChunkResponse *response,
+                    Closure *done);
+
+    void WriteChunks(RpcController *controller,
+                     const ChunkRequest *request,
+                     ChunkResponse *response,
+                     Closure *done);
+
     void ReadChunkSnapshot(RpcController *controller,
                            const ChunkRequest *request,
                            ChunkResponse *response,
@@ -86,6 +96,11 @@ class ChunkServiceImpl : public ChunkService {
                       GetChunkInfoResponse *response,
                       Closure *done);
 
+    void GetChunksInfo(RpcController *controller,
+                       const GetChunksInfoRequest *request,
+                       GetChunksInfoResponse *response,
+                       Closure *done);
+
     void GetChunkHash(RpcController *controller,
                       const GetChunkHashRequest *request,
                       GetChunkHashResponse *response,
@@ -100,10 +115,44 @@ class ChunkServiceImpl : public ChunkService {
      */
     bool CheckRequestOffsetAndLength(uint32_t offset, uint32_t len);
 
+    /**
+     * 验证批量读写请求，子请求数量不能超过上限，子请求和批量请求属于同一个
+     * copyset，offset和length合法，写请求的数据长度和子请求一致
+     * @param request[in]: 批量读写请求
+     * @param dataSize[in]: 写请求attachment的长度，读请求为0
+     * @param bytes[out]: 子请求的数据总量
+     * @return true，说明合法，否则返回false
+     */
+    bool CheckBatchRequest(const ChunkRequest *request,
+                           uint64_t dataSize,
+                           uint64_t *bytes);
+
+    /**
+     * ReadChunks/WriteChunks的共同处理逻辑
+     */
+    void ProcessBatch(RpcController *controller,
+                      const ChunkRequest *request,
+                      ChunkResponse *response,
+                      Closure *done);
+
+    /**
+     * 判断请求是否需要被流控
+     * @param qosClass[in]: 请求的QoS类别
+     * @param request[in]: 请求, 没有ChunkRequest时为nullptr
+     * @param bytes[in]: 请求的数据量
+     * @param ops[in]: 请求包含的读写次数, 批量请求为子请求个数
+     * @return true，说明过载，请求需要返回OVERLOAD
+     */
+    bool IsOverLoad(QosClass qosClass,
+                    const ChunkRequest *request,
+                    uint64_t bytes,
+                    uint32_t ops = 1);
+
  private:
     ChunkServiceOptions chunkServiceOptions_;
     CopysetNodeManager  *copysetNodeManager_;
     std::shared_ptr<InflightThrottle> inflightThrottle_;
+    std::shared_ptr<IOThrottle> ioThrottle_;
     uint32_t            maxChunkSize_;
 };
 
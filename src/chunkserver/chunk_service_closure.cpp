@@ -46,7 +46,7 @@ void ChunkServiceClosure::Run() {
     // 这一行必须放在brpcDone_调用之后，ut里需要测试inflightio超过限制时的表现
     // 会在传进来的closure里面加一个sleep来控制inflightio个数
     if (nullptr != inflightThrottle_) {
-        inflightThrottle_->Decrement();
+        inflightThrottle_->Decrement(qosClass_, inflightCount_);
     }
 }
 
@@ -82,6 +82,19 @@ void ChunkServiceClosure::OnRequest() {
                               CSIOMetricType::PASTE_CHUNK);
             break;
         }
+        // 批量请求按子请求统计
+        case CHUNK_OP_TYPE::CHUNK_OP_READ_BATCH:
+        case CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH: {
+            CSIOMetricType type =
+                request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_READ_BATCH
+                ? CSIOMetricType::READ_CHUNK : CSIOMetricType::WRITE_CHUNK;
+            for (int i = 0; i < request_->subrequests_size(); ++i) {
+                metric->OnRequest(request_->logicpoolid(),
+                                  request_->copysetid(),
+                                  type);
+            }
+            break;
+        }
         default:
             break;
     }
@@ -97,6 +110,11 @@ void ChunkServiceClosure::OnResonse() {
     bool hasError = false;
     uint64_t latencyUs =
         common::TimeUtility::GetTimeofDayUs() - receivedTimeUs_;
+    // 被client采样的请求，把总耗时和各阶段耗时一起返回给client
+    if (request_->trace()) {
+        response_->mutable_trace()->set_totalus(latencyUs);
+        metric->OnTrace(*request_, response_->trace());
+    }
     switch (request_->optype()) {
         case CHUNK_OP_TYPE::CHUNK_OP_READ: {
             // 如果是read请求，返回CHUNK_OP_STATUS_CHUNK_NOTEXIST也认为是正确的
@@ -146,10 +164,42 @@ void ChunkServiceClosure::OnResonse() {
                                hasError);
             break;
         }
+        case CHUNK_OP_TYPE::CHUNK_OP_READ_BATCH:
+        case CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH: {
+            OnBatchResponse(latencyUs);
+            break;
+        }
         default:
             break;
     }
 }
 
+void ChunkServiceClosure::OnBatchResponse(uint64_t latencyUs) {
+    ChunkServerMetric* metric = ChunkServerMetric::GetInstance();
+    bool isRead = request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_READ_BATCH;
+    CSIOMetricType type =
+        isRead ? CSIOMetricType::READ_CHUNK : CSIOMetricType::WRITE_CHUNK;
+    for (int i = 0; i < request_->subrequests_size(); ++i) {
+        // 整个请求失败时没有子请求的结果
+        CHUNK_OP_STATUS status = response_->status();
+        if (status == CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            status = i < response_->subresponses_size()
+                ? response_->subresponses(i).status()
+                : CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN;
+        }
+        // 和单个读请求相同，返回CHUNK_OP_STATUS_CHUNK_NOTEXIST也认为是正确的
+        bool hasError =
+            (status != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) &&
+            !(isRead &&
+              status == CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_NOTEXIST);
+        metric->OnResponse(request_->logicpoolid(),
+                           request_->copysetid(),
+                           type,
+                           request_->subrequests(i).size(),
+                           latencyUs,
+                           hasError);
+    }
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -29,6 +29,7 @@
 #include "proto/chunk.pb.h"
 #include "src/chunkserver/op_request.h"
 #include "src/chunkserver/inflight_throttle.h"
+#include "src/common/object_pool.h"
 #include "src/common/timeutility.h"
 
 namespace curve {
@@ -41,15 +42,18 @@ class ChunkServiceClosure : public braft::Closure {
             std::shared_ptr<InflightThrottle> inflightThrottle,
             const ChunkRequest *request,
             ChunkResponse *response,
-            google::protobuf::Closure *done)
+            google::protobuf::Closure *done,
+            QosClass qosClass = QOS_CLASS_CLIENT)
         : inflightThrottle_(inflightThrottle)
         , request_(request)
         , response_(response)
         , brpcDone_(done)
-        , receivedTimeUs_(common::TimeUtility::GetTimeofDayUs()) {
+        , receivedTimeUs_(common::TimeUtility::GetTimeofDayUs())
+        , qosClass_(qosClass)
+        , inflightCount_(GetInflightCount(request)) {
             // closure创建的什么加1，closure调用的时候减1
             if (nullptr != inflightThrottle_) {
-                inflightThrottle_->Increment();
+                inflightThrottle_->Increment(qosClass_, inflightCount_);
             }
             // 统计请求数量
             OnRequest();
@@ -57,6 +61,17 @@ class ChunkServiceClosure : public braft::Closure {
 
     ~ChunkServiceClosure() = default;
 
+    // 每个rpc都会创建一个closure，从对象池分配
+    static void *operator new(size_t size) {
+        return common::PoolNew<ChunkServiceClosure>(size);
+    }
+    static void *operator new(size_t size, const std::nothrow_t &tag) {
+        return common::PoolNew<ChunkServiceClosure>(size, tag);
+    }
+    static void operator delete(void *p, size_t size) {
+        common::PoolDelete<ChunkServiceClosure>(p, size);
+    }
+
     /**
      * 该闭包的guard生命周期结束时会调用该函数
      * 该函数内目前主要是对读写请求返回结果的一些metric统计
@@ -65,6 +80,15 @@ class ChunkServiceClosure : public braft::Closure {
     void Run() override;
 
  private:
+    /**
+     * 请求计入inflight的数量, 批量请求按子请求个数计数
+     */
+    static uint32_t GetInflightCount(const ChunkRequest *request) {
+        if (request == nullptr || request->subrequests_size() == 0) {
+            return 1;
+        }
+        return request->subrequests_size();
+    }
     /**
      * 统计请求数量和速率
      */
@@ -73,6 +97,11 @@ class ChunkServiceClosure : public braft::Closure {
      * 记录请求处理的结果，例如请求是否出错、请求的延时等
      */
     void OnResonse();
+    /**
+     * 批量读写请求按子请求记录处理结果
+     * @param latencyUs: 整个批量请求的延时
+     */
+    void OnBatchResponse(uint64_t latencyUs);
 
  private:
     // inflight流控
@@ -85,6 +114,10 @@ class ChunkServiceClosure : public braft::Closure {
     google::protobuf::Closure *brpcDone_;
     // 接受到请求的时间
     uint64_t receivedTimeUs_;
+    // 请求的QoS类别, inflight计数按类别统计
+    QosClass qosClass_;
+    // 请求计入inflight的数量
+    uint32_t inflightCount_;
 };
 
 }  // namespace chunkserver
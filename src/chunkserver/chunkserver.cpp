@@ -27,6 +27,7 @@
 #include <braft/raft_service.h>
 #include <braft/storage.h>
 
+#include <functional>
 #include <memory>
 
 #include "src/chunkserver/chunkserver.h"
@@ -38,6 +39,7 @@
 #include "src/chunkserver/braft_cli_service2.h"
 #include "src/chunkserver/chunkserver_helper.h"
 #include "src/chunkserver/uri_paser.h"
+#include "src/chunkserver/datastore/chunkfile_fd_cache.h"
 #include "src/chunkserver/raftsnapshot/curve_snapshot_attachment.h"
 #include "src/chunkserver/raftsnapshot/curve_file_service.h"
 #include "src/chunkserver/raftsnapshot/curve_snapshot_storage.h"
@@ -135,6 +137,18 @@ int ChunkServer::Run(int argc, char** argv) {
     LOG_IF(FATAL, false == chunkfilePool->Initialize(chunkFilePoolOptions))
         << "Failed to init chunk file pool";
 
+    // 初始化chunk文件的fd缓存，限制同时打开的chunk文件和快照文件数
+    uint32_t maxOpenChunkFiles = 0;
+    if (!conf.GetUInt32Value("chunkserver.max_open_chunk_files",
+                             &maxOpenChunkFiles)) {
+        LOG(WARNING) << "chunkserver.max_open_chunk_files not set, "
+                     << "open chunk files are unlimited";
+    }
+    std::shared_ptr<ChunkFdCache> chunkFdCache;
+    if (maxOpenChunkFiles > 0) {
+        chunkFdCache = std::make_shared<ChunkFdCache>(fs, maxOpenChunkFiles);
+    }
+
 
 
     // Init Wal file pool
@@ -211,6 +225,7 @@ int ChunkServer::Run(int argc, char** argv) {
     InitCopysetNodeOptions(&conf, &copysetNodeOptions);
     copysetNodeOptions.concurrentapply = &concurrentapply;
     copysetNodeOptions.chunkFilePool = chunkfilePool;
+    copysetNodeOptions.chunkFdCache = chunkFdCache;
     copysetNodeOptions.localFileSystem = fs;
     copysetNodeOptions.trash = trash_;
 
@@ -260,6 +275,7 @@ int ChunkServer::Run(int argc, char** argv) {
     // 监控部分模块的metric指标
     metric->MonitorTrash(trash_.get());
     metric->MonitorChunkFilePool(chunkfilePool.get());
+    metric->MonitorChunkFdCache(chunkFdCache.get());
     metric->MonitorWalFilePool(kWalFilePool.get());
     metric->ExposeConfigMetric(&conf);
 
@@ -281,15 +297,25 @@ int ChunkServer::Run(int argc, char** argv) {
     LOG_IF(FATAL,
            !conf.GetIntValue("copyset.max_inflight_requests",
                              &maxInflight));
+    IOThrottleOptions ioThrottleOptions;
+    InitIOThrottleOptions(&conf, &ioThrottleOptions);
     std::shared_ptr<InflightThrottle> inflightThrottle
-        = std::make_shared<InflightThrottle>(maxInflight);
+        = std::make_shared<InflightThrottle>(maxInflight,
+                                             ioThrottleOptions.weights);
     CHECK(nullptr != inflightThrottle) << "new inflight throttle failed";
 
+    // disk and volume throttle
+    std::shared_ptr<IOThrottle> ioThrottle
+        = std::make_shared<IOThrottle>(ioThrottleOptions);
+
     // chunk service
     ChunkServiceOptions chunkServiceOptions;
     chunkServiceOptions.copysetNodeManager = copysetNodeManager_;
     chunkServiceOptions.cloneManager = &cloneManager_;
     chunkServiceOptions.inflightThrottle = inflightThrottle;
+    chunkServiceOptions.ioThrottle = ioThrottle;
+    chunkServiceOptions.enableBatchRequest =
+        copysetNodeOptions.enableBatchRequest;
     ChunkServiceImpl chunkService(chunkServiceOptions);
     ret = server.AddService(&chunkService,
                         brpc::SERVER_DOESNT_OWN_SERVICE);
@@ -314,7 +340,10 @@ int ChunkServer::Run(int argc, char** argv) {
     service = server.FindServiceByName("FileService");
     ret = server.RemoveService(service);
     CHECK(0 == ret) << "Fail to remove braft::FileService";
-    kCurveFileService.set_snapshot_attachment(new CurveSnapshotAttachment(fs));
+    // 快照文件列表从copyset datastore的chunk清单获取，不再list数据目录
+    kCurveFileService.set_snapshot_attachment(new CurveSnapshotAttachment(fs,
+        std::bind(&CopysetNodeManager::ListSnapshotFiles, copysetNodeManager_,
+                  std::placeholders::_1, std::placeholders::_2)));
     ret = server.AddService(&kCurveFileService,
         brpc::SERVER_DOESNT_OWN_SERVICE);
     CHECK(0 == ret) << "Fail to add CurveFileService";
@@ -448,6 +477,24 @@ void ChunkServer::InitConcurrentApplyOptions(common::Configuration *conf,
         "rconcurrentapply.queuedepth", &concurrentApplyOptions->rqueuedepth));
     LOG_IF(FATAL, !conf->GetIntValue(
         "wconcurrentapply.queuedepth", &concurrentApplyOptions->wqueuedepth));
+    if (!conf->GetUInt32Value("rconcurrentapply.stripe_size",
+        &concurrentApplyOptions->rstripesize)) {
+        concurrentApplyOptions->rstripesize = 0;
+        LOG(WARNING) << "Not found rconcurrentapply.stripe_size in conf, "
+                     << "use default value 0";
+    }
+    if (!conf->GetUInt32Value("wconcurrentapply.stripe_size",
+        &concurrentApplyOptions->wstripesize)) {
+        concurrentApplyOptions->wstripesize = 0;
+        LOG(WARNING) << "Not found wconcurrentapply.stripe_size in conf, "
+                     << "use default value 0";
+    }
+    if (!conf->GetUInt32Value("wconcurrentapply.stripe_queues",
+        &concurrentApplyOptions->wstripequeues)) {
+        concurrentApplyOptions->wstripequeues = 0;
+        LOG(WARNING) << "Not found wconcurrentapply.stripe_queues in conf, "
+                     << "use default value 0";
+    }
 }
 
 void ChunkServer::InitWalFilePoolOptions(
@@ -516,6 +563,60 @@ void ChunkServer::InitCopysetNodeOptions(
         &copysetNodeOptions->finishLoadMargin));
     LOG_IF(FATAL, !conf->GetUInt32Value("copyset.check_loadmargin_interval_ms",
         &copysetNodeOptions->checkLoadMarginIntervalMs));
+    if (!conf->GetUInt32Value("copyset.cow_unit_size",
+        &copysetNodeOptions->cowUnitSize)) {
+        LOG(WARNING) << "copyset.cow_unit_size not set, use default value "
+                     << copysetNodeOptions->cowUnitSize;
+    }
+    if (!conf->GetBoolValue("copyset.enable_lease_read",
+        &copysetNodeOptions->enableLeaseRead)) {
+        LOG(WARNING) << "copyset.enable_lease_read not set, use default value "
+                     << copysetNodeOptions->enableLeaseRead;
+    }
+    // lease读依赖braft维护的leader lease，只有显式开启lease读时
+    // 才修改braft的全局开关，未开启时保持braft的配置不变
+    if (copysetNodeOptions->enableLeaseRead) {
+        if (gflags::SetCommandLineOption("raft_enable_leader_lease",
+                                         "true").empty()) {
+            LOG(WARNING) << "set raft_enable_leader_lease failed, "
+                         << "disable lease read";
+            copysetNodeOptions->enableLeaseRead = false;
+        } else {
+            LOG(INFO) << "lease read enabled, set raft_enable_leader_lease";
+        }
+    }
+    if (!conf->GetUInt32Value("copyset.propose_batch_max_ops",
+        &copysetNodeOptions->proposeBatchMaxOps)) {
+        LOG(WARNING) << "copyset.propose_batch_max_ops not set, "
+                     << "use default value "
+                     << copysetNodeOptions->proposeBatchMaxOps;
+    }
+    if (!conf->GetUInt32Value("copyset.propose_batch_max_bytes",
+        &copysetNodeOptions->proposeBatchMaxBytes)) {
+        LOG(WARNING) << "copyset.propose_batch_max_bytes not set, "
+                     << "use default value "
+                     << copysetNodeOptions->proposeBatchMaxBytes;
+    }
+    if (!conf->GetUInt32Value("copyset.propose_batch_wait_us",
+        &copysetNodeOptions->proposeBatchWaitUs)) {
+        LOG(WARNING) << "copyset.propose_batch_wait_us not set, "
+                     << "use default value "
+                     << copysetNodeOptions->proposeBatchWaitUs;
+    }
+    if (!conf->GetBoolValue("copyset.enable_batch_request",
+        &copysetNodeOptions->enableBatchRequest)) {
+        LOG(WARNING) << "copyset.enable_batch_request not set, "
+                     << "disable batch request";
+        copysetNodeOptions->enableBatchRequest = false;
+    }
+    // 合并propose写入的也是批量写日志，和批量请求使用同一个升级开关
+    if (copysetNodeOptions->proposeBatchMaxOps > 1
+        && !copysetNodeOptions->enableBatchRequest) {
+        LOG(WARNING) << "copyset.propose_batch_max_ops is "
+                     << copysetNodeOptions->proposeBatchMaxOps
+                     << " but copyset.enable_batch_request is false, "
+                     << "disable propose batch";
+    }
 }
 
 void ChunkServer::InitCopyerOptions(
@@ -569,6 +670,12 @@ void ChunkServer::InitHeartbeatOptions(
         &heartbeatOptions->intervalSec));
     LOG_IF(FATAL, !conf->GetUInt32Value("mds.heartbeat_timeout",
         &heartbeatOptions->timeout));
+    if (!conf->GetUInt32Value("mds.heartbeat_full_report_interval",
+        &heartbeatOptions->fullReportInterval)) {
+        LOG(WARNING) << "mds.heartbeat_full_report_interval not found, "
+                     << "report all copysets in every heartbeat";
+        heartbeatOptions->fullReportInterval = 0;
+    }
 }
 
 void ChunkServer::InitRegisterOptions(
@@ -615,6 +722,36 @@ void ChunkServer::InitMetricOptions(
         "metric.onoff", &metricOptions->collectMetric));
 }
 
+void ChunkServer::InitIOThrottleOptions(
+    common::Configuration *conf, IOThrottleOptions *ioThrottleOptions) {
+    // 以下配置项是后加的, 老的配置文件中没有, 使用默认值
+    const char* weightKeys[QOS_CLASS_NUM] = {
+        "chunkserver.qos_client_weight",
+        "chunkserver.qos_clone_weight",
+        "chunkserver.qos_snapshot_weight",
+        "chunkserver.qos_scrub_weight",
+    };
+    for (int i = 0; i < QOS_CLASS_NUM; ++i) {
+        if (!conf->GetUInt32Value(weightKeys[i],
+                                  &ioThrottleOptions->weights[i])) {
+            LOG(WARNING) << weightKeys[i] << " not found, use default value "
+                         << ioThrottleOptions->weights[i];
+        }
+    }
+    if (!conf->GetUInt64Value("chunkserver.disk_iops_limit",
+                              &ioThrottleOptions->diskIopsLimit)) {
+        LOG(WARNING) << "chunkserver.disk_iops_limit not found, "
+                     << "disk iops is unlimited";
+        ioThrottleOptions->diskIopsLimit = 0;
+    }
+    if (!conf->GetUInt64Value("chunkserver.disk_bps_limit",
+                              &ioThrottleOptions->diskBpsLimit)) {
+        LOG(WARNING) << "chunkserver.disk_bps_limit not found, "
+                     << "disk bandwidth is unlimited";
+        ioThrottleOptions->diskBpsLimit = 0;
+    }
+}
+
 void ChunkServer::LoadConfigFromCmdline(common::Configuration *conf) {
     // 如果命令行有设置, 命令行覆盖配置文件中的字段
     google::CommandLineFlagInfo info;
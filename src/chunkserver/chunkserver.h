@@ -86,6 +86,9 @@ class ChunkServer {
     void InitMetricOptions(common::Configuration *conf,
         ChunkServerMetricOptions *metricOptions);
 
+    void InitIOThrottleOptions(common::Configuration *conf,
+        IOThrottleOptions *ioThrottleOptions);
+
     void LoadConfigFromCmdline(common::Configuration *conf);
 
     int GetChunkServerMetaFromLocal(const std::string &storeUri,
@@ -23,6 +23,7 @@
 #include "src/chunkserver/chunkserver_metrics.h"
 #include <vector>
 #include <map>
+#include <sstream>
 
 #include "src/chunkserver/copyset_node_manager.h"
 #include "src/chunkserver/passive_getfn.h"
@@ -200,6 +201,13 @@ int CSCopysetMetric::Init(const LogicPoolID& logicPoolId,
                    << " metric failed.";
         return -1;
     }
+    ret = snapshotSaveLatency_.expose(Prefix(), "snapshot_save");
+    if (ret != 0) {
+        LOG(ERROR) << "Init Copyset ("
+                   << logicPoolId << "," << copysetId << ")"
+                   << " snapshot save metric failed.";
+        return -1;
+    }
     return 0;
 }
 
@@ -221,9 +229,17 @@ ChunkServerMetric::ChunkServerMetric()
     , chunkLeft_(nullptr)
     , walSegmentLeft_(nullptr)
     , chunkTrashed_(nullptr)
+    , chunkFdOpen_(nullptr)
+    , chunkFdMiss_(nullptr)
     , chunkCount_(nullptr)
     , snapshotCount_(nullptr)
-    , cloneChunkCount_(nullptr) {}
+    , cloneChunkCount_(nullptr)
+    , leaseReadRatio_(nullptr)
+    , proposeEntries_(nullptr)
+    , proposeEntryRate_(nullptr)
+    , proposeOps_(nullptr)
+    , proposeBytes_(nullptr)
+    , proposeBytesPerOp_(nullptr) {}
 
 ChunkServerMetric* ChunkServerMetric::self_ = nullptr;
 
@@ -272,6 +288,46 @@ int ChunkServerMetric::Init(const ChunkServerMetricOptions& option) {
     cloneChunkCount_ = std::make_shared<bvar::PassiveStatus<uint32_t>>(
         cloneChunkCountPrefix, GetTotalCloneChunkCountFunc, this);
 
+    // 读请求的处理方式统计
+    readCount_[static_cast<int>(ReadPathType::kAppliedIndex)] =
+        std::make_shared<bvar::Adder<uint64_t>>(
+            Prefix() + "_read_by_applied_index");
+    readCount_[static_cast<int>(ReadPathType::kLease)] =
+        std::make_shared<bvar::Adder<uint64_t>>(Prefix() + "_read_by_lease");
+    readCount_[static_cast<int>(ReadPathType::kPropose)] =
+        std::make_shared<bvar::Adder<uint64_t>>(
+            Prefix() + "_read_by_propose");
+    readCount_[static_cast<int>(ReadPathType::kFollower)] =
+        std::make_shared<bvar::Adder<uint64_t>>(
+            Prefix() + "_read_by_follower");
+    leaseReadRatio_ = std::make_shared<bvar::PassiveStatus<double>>(
+        Prefix() + "_lease_read_ratio", GetLeaseReadRatioFunc, this);
+
+    // propose的raft日志统计
+    proposeEntries_ = std::make_shared<bvar::Adder<uint64_t>>(
+        Prefix() + "_propose_log_entries");
+    proposeEntryRate_ =
+        std::make_shared<bvar::PerSecond<bvar::Adder<uint64_t>>>(
+            Prefix() + "_propose_log_entries_per_second",
+            proposeEntries_.get(), 1);
+    proposeOps_ = std::make_shared<bvar::Adder<uint64_t>>(
+        Prefix() + "_propose_ops");
+    proposeBytes_ = std::make_shared<bvar::Adder<uint64_t>>(
+        Prefix() + "_propose_bytes");
+    proposeBytesPerOp_ = std::make_shared<bvar::PassiveStatus<double>>(
+        Prefix() + "_propose_bytes_per_op", GetProposeBytesPerOpFunc, this);
+
+    // 被采样请求的各阶段耗时及慢请求
+    traceRaft_ = std::make_shared<bvar::LatencyRecorder>(
+        Prefix(), "trace_raft");
+    traceApplyQueue_ = std::make_shared<bvar::LatencyRecorder>(
+        Prefix(), "trace_apply_queue");
+    traceStorage_ = std::make_shared<bvar::LatencyRecorder>(
+        Prefix(), "trace_storage");
+    traceTotal_ = std::make_shared<bvar::LatencyRecorder>(
+        Prefix(), "trace_total");
+    slowOps_ = std::make_shared<SlowOpTracker>(Prefix(), "slow_ops");
+
     hasInited_ = true;
     LOG(INFO) << "Init chunkserver metric success.";
     return 0;
@@ -284,9 +340,25 @@ int ChunkServerMetric::Fini() {
     chunkLeft_ = nullptr;
     walSegmentLeft_ = nullptr;
     chunkTrashed_ = nullptr;
+    chunkFdOpen_ = nullptr;
+    chunkFdMiss_ = nullptr;
     chunkCount_ = nullptr;
     snapshotCount_ = nullptr;
     cloneChunkCount_ = nullptr;
+    leaseReadRatio_ = nullptr;
+    proposeBytesPerOp_ = nullptr;
+    proposeEntryRate_ = nullptr;
+    proposeEntries_ = nullptr;
+    proposeOps_ = nullptr;
+    proposeBytes_ = nullptr;
+    traceRaft_ = nullptr;
+    traceApplyQueue_ = nullptr;
+    traceStorage_ = nullptr;
+    traceTotal_ = nullptr;
+    slowOps_ = nullptr;
+    for (auto& count : readCount_) {
+        count = nullptr;
+    }
     copysetMetricMap_.Clear();
     hasInited_ = false;
     return 0;
@@ -401,6 +473,19 @@ void ChunkServerMetric::MonitorTrash(Trash* trash) {
         chunkTrashedPrefix, GetChunkTrashedFunc, trash);
 }
 
+void ChunkServerMetric::MonitorChunkFdCache(ChunkFdCache* fdCache) {
+    if (!option_.collectMetric || fdCache == nullptr) {
+        return;
+    }
+
+    std::string fdOpenPrefix = Prefix() + "_chunk_fd_open";
+    chunkFdOpen_ = std::make_shared<bvar::PassiveStatus<uint32_t>>(
+        fdOpenPrefix, GetChunkFdOpenFunc, fdCache);
+    std::string fdMissPrefix = Prefix() + "_chunk_fd_miss";
+    chunkFdMiss_ = std::make_shared<bvar::PassiveStatus<uint64_t>>(
+        fdMissPrefix, GetChunkFdMissFunc, fdCache);
+}
+
 void ChunkServerMetric::IncreaseLeaderCount() {
     if (!option_.collectMetric) {
         return;
@@ -417,6 +502,87 @@ void ChunkServerMetric::DecreaseLeaderCount() {
     *leaderCount_ << -1;
 }
 
+void ChunkServerMetric::OnRead(ReadPathType type) {
+    if (!option_.collectMetric) {
+        return;
+    }
+
+    const auto& count = readCount_[static_cast<int>(type)];
+    if (count != nullptr) {
+        *count << 1;
+    }
+}
+
+uint64_t ChunkServerMetric::GetReadCount(ReadPathType type) const {
+    const auto& count = readCount_[static_cast<int>(type)];
+    if (count == nullptr)
+        return 0;
+    return count->get_value();
+}
+
+void ChunkServerMetric::OnPropose(uint32_t opCount, uint64_t bytes) {
+    if (!option_.collectMetric || proposeEntries_ == nullptr) {
+        return;
+    }
+
+    *proposeEntries_ << 1;
+    *proposeOps_ << opCount;
+    *proposeBytes_ << bytes;
+}
+
+uint64_t ChunkServerMetric::GetProposeOpCount() const {
+    if (proposeOps_ == nullptr)
+        return 0;
+    return proposeOps_->get_value();
+}
+
+uint64_t ChunkServerMetric::GetProposeBytes() const {
+    if (proposeBytes_ == nullptr)
+        return 0;
+    return proposeBytes_->get_value();
+}
+
+void ChunkServerMetric::OnTrace(const ChunkRequest& request,
+                                const OpTrace& trace) {
+    if (!option_.collectMetric || slowOps_ == nullptr) {
+        return;
+    }
+
+    // 没有经过raft的读请求不统计raft阶段
+    if (trace.has_raftus()) {
+        *traceRaft_ << trace.raftus();
+    }
+    if (trace.has_applyqueueus()) {
+        *traceApplyQueue_ << trace.applyqueueus();
+    }
+    if (trace.has_storageus()) {
+        *traceStorage_ << trace.storageus();
+    }
+    *traceTotal_ << trace.totalus();
+
+    if (!slowOps_->Accept(trace.totalus())) {
+        return;
+    }
+    std::ostringstream desc;
+    desc << CHUNK_OP_TYPE_Name(request.optype())
+         << " copyset: " << request.logicpoolid() << ","
+         << request.copysetid()
+         << " chunk: " << request.chunkid()
+         << " offset: " << request.offset()
+         << " size: " << request.size()
+         << " raft: " << trace.raftus()
+         << "us apply_queue: " << trace.applyqueueus()
+         << "us storage: " << trace.storageus() << "us";
+    slowOps_->Add(trace.totalus(), desc.str());
+}
+
+std::string ChunkServerMetric::DumpSlowOps() {
+    if (slowOps_ == nullptr) {
+        return "";
+    }
+    return slowOps_->Dump();
+}
+
 void ChunkServerMetric::ExposeConfigMetric(common::Configuration* conf) {
     if (!option_.collectMetric) {
         return;
@@ -31,6 +31,8 @@
 #include <vector>
 
 #include "include/chunkserver/chunkserver_common.h"
+#include "proto/chunk.pb.h"
+#include "src/common/op_trace.h"
 #include "src/common/uncopyable.h"
 #include "src/common/concurrent/rw_lock.h"
 #include "src/common/configuration.h"
@@ -40,12 +42,14 @@ using curve::common::RWLock;
 using curve::common::ReadLockGuard;
 using curve::common::WriteLockGuard;
 using curve::common::Configuration;
+using curve::common::SlowOpTracker;
 
 namespace curve {
 namespace chunkserver {
 
 class CopysetNodeManager;
 class FilePool;
+class ChunkFdCache;
 class CSDataStore;
 class Trash;
 
@@ -233,6 +237,14 @@ class CSCopysetMetric {
         return ioMetrics_.GetIOMetric(type);
     }
 
+    /**
+     * 记录一次raft打快照的耗时
+     * @param latUs: on_snapshot_save的耗时，单位us
+     */
+    void OnSnapshotSave(int64_t latUs) {
+        snapshotSaveLatency_ << latUs;
+    }
+
     const uint32_t GetChunkCount() const {
         if (chunkCount_ == nullptr) {
             return 0;
@@ -275,6 +287,20 @@ class CSCopysetMetric {
     PassiveStatusPtr<uint32_t> cloneChunkCount_;
     // copyset上的IO类型的metric统计
     CSIOMetric ioMetrics_;
+    // copyset打raft快照的耗时
+    bvar::LatencyRecorder snapshotSaveLatency_;
+};
+
+// read请求的处理方式
+enum class ReadPathType {
+    // 请求携带的applied index已经apply，不走raft直接读
+    kAppliedIndex = 0,
+    // leader lease有效，不走raft直接读
+    kLease = 1,
+    // 通过raft propose读
+    kPropose = 2,
+    // follower读，applied index满足请求携带的read index
+    kFollower = 3,
 };
 
 struct ChunkServerMetricOptions {
@@ -438,6 +464,12 @@ class ChunkServerMetric : public Uncopyable {
      */
     void MonitorTrash(Trash* trash);
 
+    /**
+     * 监视chunk文件的fd缓存，主要监视打开的文件数和重新打开文件的次数
+     * @param fdCache: fd缓存的对象指针，为nullptr时表示未开启fd缓存
+     */
+    void MonitorChunkFdCache(ChunkFdCache* fdCache);
+
     /**
      * 增加 leader count 计数
      */
@@ -454,6 +486,48 @@ class ChunkServerMetric : public Uncopyable {
      */
     void ExposeConfigMetric(common::Configuration* conf);
 
+    /**
+     * 记录一次读请求的处理方式
+     * @param type: 读请求的处理方式
+     */
+    void OnRead(ReadPathType type);
+
+    /**
+     * 获取按指定方式处理的读请求数量
+     * @param type: 读请求的处理方式
+     */
+    uint64_t GetReadCount(ReadPathType type) const;
+
+    /**
+     * 记录一条propose的raft日志
+     * @param opCount: 日志中合并的请求个数
+     * @param bytes: 日志的大小
+     */
+    void OnPropose(uint32_t opCount, uint64_t bytes);
+
+    /**
+     * 获取propose的请求总数
+     */
+    uint64_t GetProposeOpCount() const;
+
+    /**
+     * 获取propose的日志总大小
+     */
+    uint64_t GetProposeBytes() const;
+
+    /**
+     * 记录一次被client采样的请求在chunkserver上各阶段的耗时，
+     * 并记录最近一段时间内最慢的请求
+     * @param request: 被采样的请求
+     * @param trace: 请求各阶段的耗时
+     */
+    void OnTrace(const ChunkRequest& request, const OpTrace& trace);
+
+    /**
+     * 获取最近一段时间内最慢的请求，按耗时从大到小排列
+     */
+    std::string DumpSlowOps();
+
     /**
      * 获取指定类型的IOMetric
      * @param type: 请求对应的metric类型
@@ -527,12 +601,33 @@ class ChunkServerMetric : public Uncopyable {
     PassiveStatusPtr<uint32_t> walSegmentLeft_;
     // trash 中的 chunk 的数量
     PassiveStatusPtr<uint32_t> chunkTrashed_;
+    // fd缓存中打开的文件数，以及fd被淘汰后重新打开文件的次数
+    PassiveStatusPtr<uint32_t> chunkFdOpen_;
+    PassiveStatusPtr<uint64_t> chunkFdMiss_;
     // chunkserver上的 chunk 的数量
     PassiveStatusPtr<uint32_t> chunkCount_;
     // chunkserver上的 快照文件 的数量
     PassiveStatusPtr<uint32_t> snapshotCount_;
     // chunkserver上的 clone chunk 的数量
     PassiveStatusPtr<uint32_t> cloneChunkCount_;
+    // 按处理方式统计的读请求数量，下标为ReadPathType
+    AdderPtr<uint64_t> readCount_[4];
+    // 通过leader lease处理的读请求的比例
+    PassiveStatusPtr<double> leaseReadRatio_;
+    // propose的raft日志条数、每秒的日志条数，以及日志中的请求个数和日志大小
+    AdderPtr<uint64_t> proposeEntries_;
+    std::shared_ptr<bvar::PerSecond<bvar::Adder<uint64_t>>> proposeEntryRate_;
+    AdderPtr<uint64_t> proposeOps_;
+    AdderPtr<uint64_t> proposeBytes_;
+    // 平均每个请求占用的日志大小
+    PassiveStatusPtr<double> proposeBytesPerOp_;
+    // 被采样请求在raft、并发apply模块排队、datastore读写各阶段的耗时以及总耗时
+    std::shared_ptr<bvar::LatencyRecorder> traceRaft_;
+    std::shared_ptr<bvar::LatencyRecorder> traceApplyQueue_;
+    std::shared_ptr<bvar::LatencyRecorder> traceStorage_;
+    std::shared_ptr<bvar::LatencyRecorder> traceTotal_;
+    // 最近一段时间内最慢的被采样请求
+    std::shared_ptr<SlowOpTracker> slowOps_;
     // 各复制组metric的映射表，用GroupId作为key
     CopysetMetricMap copysetMetricMap_;
     // chunkserver上的IO类型的metric统计
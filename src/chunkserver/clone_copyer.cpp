@@ -26,6 +26,14 @@
 namespace curve {
 namespace chunkserver {
 
+using curve::common::Compressor;
+using curve::common::NewCompressor;
+using curve::common::kCompressIndexSuffix;
+using curve::common::kCompressMetaKey;
+
+// 缓存的压缩对象块索引数量上限，每个索引只有几百字节
+const size_t kMaxCompressIndexCacheSize = 100000;
+
 std::ostream& operator<<(std::ostream& out, const AsyncDownloadContext& rhs) {
     out  << "{ location: " << rhs.location
         << ", offset: " << rhs.offset
@@ -137,13 +145,33 @@ void OriginCopyer::DownloadFromS3(const string& objectName,
         return;
     }
 
+    std::shared_ptr<CompressedBlockIndex> index =
+        GetCachedCompressIndex(objectName);
+    if (index != nullptr) {
+        DownloadCompressedFromS3(objectName, index, off, size, buf, done);
+        doneGuard.release();
+        return;
+    }
+
+    // 先按未压缩的对象读取，对象元数据标记为压缩时再获取块索引重新读取。
+    // 压缩对象比原始数据小，读取范围超出对象大小时也会失败，此时同样尝试
+    // 获取块索引，块索引不存在说明是真正的读取失败
     GetObjectAsyncCallBack cb =
         [=] (const S3Adapter* adapter,
              const std::shared_ptr<GetObjectAsyncContext>& context) {
             brpc::ClosureGuard doneGuard(done);
-            if (context->retCode != 0) {
+            if (context->retCode == 0 &&
+                context->metadata.count(kCompressMetaKey) == 0) {
+                return;
+            }
+            std::shared_ptr<CompressedBlockIndex> index;
+            if (LoadCompressIndex(objectName, &index) != 0) {
                 done->SetFailed();
+                return;
             }
+            DownloadCompressedFromS3(objectName, index, off, size, buf,
+                                     done);
+            doneGuard.release();
         };
 
     auto context = std::make_shared<GetObjectAsyncContext>();
@@ -157,6 +185,105 @@ void OriginCopyer::DownloadFromS3(const string& objectName,
     doneGuard.release();
 }
 
+void OriginCopyer::DownloadCompressedFromS3(const string& objectName,
+                                 std::shared_ptr<CompressedBlockIndex> index,
+                                 off_t off,
+                                 size_t size,
+                                 char* buf,
+                                 DownloadClosure* done) {
+    brpc::ClosureGuard doneGuard(done);
+    uint64_t storedOffset;
+    uint64_t storedLen;
+    if (!index->GetStoredRange(off, size, &storedOffset, &storedLen)) {
+        LOG(ERROR) << "Read range out of compressed object."
+                   << "object name: " << objectName
+                   << ", offset: " << off
+                   << ", size: " << size;
+        done->SetFailed();
+        return;
+    }
+    std::shared_ptr<Compressor> compressor =
+        NewCompressor(index->GetType(), 1);
+    std::shared_ptr<char> stored(new char[storedLen],
+                                 std::default_delete<char[]>());
+
+    GetObjectAsyncCallBack cb =
+        [=] (const S3Adapter* adapter,
+             const std::shared_ptr<GetObjectAsyncContext>& context) {
+            brpc::ClosureGuard doneGuard(done);
+            if (context->retCode != 0) {
+                done->SetFailed();
+                return;
+            }
+            if (!index->ReadRange(compressor.get(), stored.get(),
+                                  off, size, buf)) {
+                LOG(ERROR) << "Decompress s3 object failed."
+                           << "object name: " << objectName
+                           << ", offset: " << off
+                           << ", size: " << size;
+                done->SetFailed();
+            }
+        };
+
+    auto context = std::make_shared<GetObjectAsyncContext>();
+    context->key = objectName;
+    context->buf = stored.get();
+    context->offset = storedOffset;
+    context->len = storedLen;
+    context->cb = cb;
+
+    s3Client_->GetObjectAsync(context);
+    doneGuard.release();
+}
+
+std::shared_ptr<CompressedBlockIndex> OriginCopyer::GetCachedCompressIndex(
+    const string& objectName) {
+    std::unique_lock<std::mutex> lock(indexMtx_);
+    auto iter = indexMap_.find(objectName);
+    if (iter == indexMap_.end()) {
+        return nullptr;
+    }
+    indexLru_.splice(indexLru_.begin(), indexLru_, iter->second);
+    return iter->second->second;
+}
+
+int OriginCopyer::LoadCompressIndex(const string& objectName,
+    std::shared_ptr<CompressedBlockIndex>* index) {
+    std::string indexKey = objectName + kCompressIndexSuffix;
+    std::string data;
+    bool exist = false;
+    int ret = s3Client_->GetObjectIfExist(
+        Aws::String(indexKey.c_str(), indexKey.size()), &data, &exist);
+    if (ret != 0 || !exist) {
+        LOG(ERROR) << "Get compress index failed."
+                   << "object name: " << objectName
+                   << ", exist: " << exist;
+        return -1;
+    }
+    auto parsed = std::make_shared<CompressedBlockIndex>();
+    if (!parsed->Parse(data)) {
+        LOG(ERROR) << "Parse compress index failed."
+                   << "object name: " << objectName;
+        return -1;
+    }
+    *index = parsed;
+
+    std::unique_lock<std::mutex> lock(indexMtx_);
+    auto iter = indexMap_.find(objectName);
+    if (iter != indexMap_.end()) {
+        iter->second->second = parsed;
+        indexLru_.splice(indexLru_.begin(), indexLru_, iter->second);
+        return 0;
+    }
+    indexLru_.emplace_front(objectName, parsed);
+    indexMap_[objectName] = indexLru_.begin();
+    if (indexLru_.size() > kMaxCompressIndexCacheSize) {
+        indexMap_.erase(indexLru_.back().first);
+        indexLru_.pop_back();
+    }
+    return 0;
+}
+
 void OriginCopyer::DownloadFromCurve(const string& fileName,
                                     off_t off,
                                     size_t size,
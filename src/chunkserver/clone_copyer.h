@@ -24,8 +24,10 @@
 #define SRC_CHUNKSERVER_CLONE_COPYER_H_
 
 #include <glog/logging.h>
+#include <list>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <string>
 
 #include "include/chunkserver/chunkserver_common.h"
@@ -35,6 +37,7 @@
 #include "src/client/client_common.h"
 #include "include/client/libcurve.h"
 #include "src/common/s3_adapter.h"
+#include "src/common/compressor.h"
 
 namespace curve {
 namespace chunkserver {
@@ -46,6 +49,7 @@ using curve::common::LocationOperator;
 using curve::common::OriginType;
 using curve::common::GetObjectAsyncCallBack;
 using curve::common::GetObjectAsyncContext;
+using curve::common::CompressedBlockIndex;
 using std::string;
 
 class DownloadClosure;
@@ -107,6 +111,30 @@ class OriginCopyer {
                        size_t size,
                        char* buf,
                        DownloadClosure* done);
+    /**
+     * 从分块压缩的对象中读取数据，只下载覆盖请求范围的块并解压
+     */
+    void DownloadCompressedFromS3(const string& objectName,
+                       std::shared_ptr<CompressedBlockIndex> index,
+                       off_t off,
+                       size_t size,
+                       char* buf,
+                       DownloadClosure* done);
+    /**
+     * 从缓存中获取压缩对象的块索引
+     * @param objectName: 对象名
+     * @return: 块索引，没有缓存时为nullptr
+     */
+    std::shared_ptr<CompressedBlockIndex> GetCachedCompressIndex(
+        const string& objectName);
+    /**
+     * 从s3获取压缩对象的块索引并缓存，对象不会被修改
+     * @param objectName: 对象名
+     * @param[out] index: 块索引
+     * @return: 成功返回0，失败或块索引不存在返回-1
+     */
+    int LoadCompressIndex(const string& objectName,
+                          std::shared_ptr<CompressedBlockIndex>* index);
     void DownloadFromCurve(const string& fileName,
                           off_t off,
                           size_t size,
@@ -124,6 +152,15 @@ class OriginCopyer {
     std::mutex  mtx_;
     // 文件名->文件fd 的映射
     std::unordered_map<std::string, int> fdMap_;
+    using IndexEntry =
+        std::pair<std::string, std::shared_ptr<CompressedBlockIndex>>;
+    // 保护indexLru_和indexMap_的互斥锁
+    std::mutex  indexMtx_;
+    // 压缩对象的块索引，按最近使用的顺序排列，表头为最近使用的
+    std::list<IndexEntry> indexLru_;
+    // s3对象名->块索引在indexLru_中的位置
+    std::unordered_map<std::string,
+                       std::list<IndexEntry>::iterator> indexMap_;
 };
 
 }  // namespace chunkserver
@@ -23,6 +23,7 @@
 #include <glog/logging.h>
 
 #include <algorithm>
+#include <memory>
 #include <vector>
 #include "src/chunkserver/concurrent_apply/concurrent_apply.h"
 #include "src/common/concurrent/count_down_event.h"
@@ -72,6 +73,16 @@ bool ConcurrentApplyModule::checkOptAndInit(
     wqueuedepth_ = opt.wqueuedepth;
     rconcurrentsize_ = opt.rconcurrentsize;
     rqueuedepth_ = opt.rqueuedepth;
+    rstripesize_ = opt.rstripesize;
+    wstripesize_ = opt.wstripesize;
+    wstripequeues_ = opt.wstripequeues;
+    if (wstripequeues_ == 0 ||
+        wstripequeues_ > static_cast<uint32_t>(wconcurrentsize_)) {
+        wstripequeues_ = wconcurrentsize_;
+    }
+    if (wstripesize_ > 0) {
+        lastSn_.assign(kLastSnSlots, LastSn{false, 0, 0});
+    }
 
     return true;
 }
@@ -158,6 +169,96 @@ void ConcurrentApplyModule::Flush() {
     event.Wait();
 }
 
+void ConcurrentApplyModule::FlushAsync(std::function<void()> done) {
+    auto left = std::make_shared<std::atomic<int>>(wconcurrentsize_);
+    auto callback = std::make_shared<std::function<void()>>(std::move(done));
+    auto marker = [left, callback]() {
+        if (left->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            (*callback)();
+        }
+    };
+
+    for (int i = 0; i < wconcurrentsize_; i++) {
+        wapplyMap_[i]->tq.Push(marker);
+    }
+}
+
+std::vector<int> ConcurrentApplyModule::WriteQueues(uint64_t key,
+                                                   uint64_t offset,
+                                                   uint64_t length,
+                                                   uint64_t sn) {
+    // sn变化时chunk可能会创建快照或者拒绝旧版本的写，要和chunk的所有写排队
+    if (sn != kAnySn && !MatchLastSn(key, sn)) {
+        return ChunkWriteQueues(key);
+    }
+
+    uint64_t beginStripe = offset / wstripesize_;
+    uint64_t endStripe = (offset + std::max<uint64_t>(length, 1) - 1)
+                         / wstripesize_;
+    // 连续的条带hash到连续的队列，超过chunk的队列个数时覆盖chunk的所有队列
+    if (endStripe - beginStripe + 1 >= wstripequeues_) {
+        return ChunkWriteQueues(key);
+    }
+
+    std::vector<int> queues;
+    for (uint64_t stripe = beginStripe; stripe <= endStripe; ++stripe) {
+        queues.push_back(StripeQueue(key, stripe));
+    }
+    return queues;
+}
+
+std::vector<int> ConcurrentApplyModule::ChunkWriteQueues(uint64_t key) {
+    std::vector<int> queues;
+    for (uint32_t i = 0; i < wstripequeues_; i++) {
+        queues.push_back(StripeQueue(key, i));
+    }
+    return queues;
+}
+
+bool ConcurrentApplyModule::MatchLastSn(uint64_t key, uint64_t sn) {
+    int slot = key % kLastSnSlots;
+    std::lock_guard<std::mutex> lk(lastSnMtx_[slot % kLastSnLocks]);
+    LastSn &last = lastSn_[slot];
+    if (last.valid && last.key == key && last.sn == sn) {
+        return true;
+    }
+    last = LastSn{true, key, sn};
+    return false;
+}
+
+void ConcurrentApplyModule::PushBarrier(const std::vector<int> &queues,
+                                        TaskQueue::Task task) {
+    struct Barrier {
+        std::mutex mtx;
+        std::condition_variable cv;
+        size_t waiting;
+        bool done;
+        TaskQueue::Task task;
+    };
+    auto barrier = std::make_shared<Barrier>();
+    barrier->waiting = queues.size();
+    barrier->done = false;
+    barrier->task = std::move(task);
+
+    auto arrive = [barrier]() {
+        std::unique_lock<std::mutex> lk(barrier->mtx);
+        if (--barrier->waiting > 0) {
+            barrier->cv.wait(lk, [&barrier]() { return barrier->done; });
+            return;
+        }
+        lk.unlock();
+        barrier->task();
+        lk.lock();
+        barrier->done = true;
+        barrier->cv.notify_all();
+    };
+
+    std::lock_guard<std::mutex> lk(barrierMtx_);
+    for (int index : queues) {
+        wapplyMap_[index]->tq.Push(arrive);
+    }
+}
+
 ThreadPoolType ConcurrentApplyModule::Schedule(CHUNK_OP_TYPE optype) {
     switch (optype) {
     case CHUNK_OP_READ:
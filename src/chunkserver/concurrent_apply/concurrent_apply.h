@@ -27,9 +27,11 @@
 #include <unistd.h>
 #include <atomic>
 #include <mutex>    // NOLINT
+#include <functional>
 #include <thread>    // NOLINT
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include <condition_variable>    // NOLINT
 
 #include "src/common/concurrent/task_queue.h"
@@ -50,6 +52,15 @@ struct ConcurrentApplyOption {
     int wqueuedepth;
     int rconcurrentsize;
     int rqueuedepth;
+    // stripe size(bytes) used to spread reads of one chunk over read
+    // threads, 0 means reads are hashed by chunk only
+    uint32_t rstripesize;
+    // stripe size(bytes) used to spread writes of one chunk over write
+    // threads, 0 means writes are hashed by chunk only
+    uint32_t wstripesize;
+    // number of write threads the stripes of one chunk are spread over,
+    // ops of the whole chunk only block these threads. 0 means all
+    uint32_t wstripequeues;
 };
 
 enum class ThreadPoolType {READ, WRITE};
@@ -61,6 +72,9 @@ class CURVE_CACHELINE_ALIGNMENT ConcurrentApplyModule {
                              wconcurrentsize_(0),
                              rqueuedepth_(0),
                              wqueuedepth_(0),
+                             rstripesize_(0),
+                             wstripesize_(0),
+                             wstripequeues_(0),
                              cond_(0) {}
     ~ConcurrentApplyModule() {}
 
@@ -82,24 +96,110 @@ class CURVE_CACHELINE_ALIGNMENT ConcurrentApplyModule {
      */
     template<class F, class... Args>
     bool Push(uint64_t key, CHUNK_OP_TYPE optype, F&& f, Args&&... args) {
-        auto task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+        TaskQueue::Task task(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        return Push(key, optype, std::move(task));
+    }
+
+    /**
+     * Push: task without params is moved into the queue directly, without
+     * wrapping by std::bind again
+     * @param[in] key: used to hash task to specified queue
+     * @param[in] optype: operation type defined in proto
+     * @param[in] f: task
+     */
+    template<class F>
+    bool Push(uint64_t key, CHUNK_OP_TYPE optype, F&& f) {
         switch (Schedule(optype)) {
             case ThreadPoolType::READ:
-                rapplyMap_[Hash(key, rconcurrentsize_)]->tq.Push(task);
+                rapplyMap_[Hash(key, rconcurrentsize_)]->tq.Push(
+                    std::forward<F>(f));
                 break;
             case ThreadPoolType::WRITE:
-                wapplyMap_[Hash(key, wconcurrentsize_)]->tq.Push(task);
+                if (wstripesize_ > 0) {
+                    // writes of the chunk may be in any of its write queues
+                    PushBarrier(ChunkWriteQueues(key), std::forward<F>(f));
+                    break;
+                }
+                wapplyMap_[Hash(key, wconcurrentsize_)]->tq.Push(
+                    std::forward<F>(f));
                 break;
         }
 
         return true;
     }
 
+    // sn of ops that do not depend on sn, such as paste
+    static const uint64_t kAnySn = UINT64_MAX;
+
+    /**
+     * PushWrite: write task with its range in chunk will be push to
+     * ConcurrentApplyModule. if wstripesize is set, the stripes of a chunk
+     * are spread over wstripequeues write queues, a write in one stripe goes
+     * to the queue of its stripe. a write across stripes, or a write whose sn
+     * differs from the last write of the chunk, is pushed to all the queues
+     * it must be ordered with as a barrier, it runs after the former tasks of
+     * these queues and blocks the latter ones. so writes of overlapping
+     * ranges and writes of different sn keep raft apply order
+     * @param[in] key: chunk id
+     * @param[in] offset: offset of the write in chunk
+     * @param[in] length: length of the write
+     * @param[in] sn: sn of the write, kAnySn if the op does not depend on sn
+     * @param[in] f: task
+     */
+    template<class F>
+    bool PushWrite(uint64_t key, uint64_t offset, uint64_t length,
+                   uint64_t sn, F&& f) {
+        if (wstripesize_ == 0) {
+            wapplyMap_[Hash(key, wconcurrentsize_)]->tq.Push(
+                std::forward<F>(f));
+            return true;
+        }
+
+        std::vector<int> queues = WriteQueues(key, offset, length, sn);
+        if (queues.size() == 1) {
+            wapplyMap_[queues[0]]->tq.Push(std::forward<F>(f));
+        } else {
+            PushBarrier(queues, std::forward<F>(f));
+        }
+        return true;
+    }
+
+    /**
+     * Push: apply task with offset will be push to ConcurrentApplyModule
+     * read tasks are hashed by key and the stripe of offset if rstripesize
+     * is set, so reads of different ranges in a hot chunk run in parallel.
+     * write tasks are still hashed by key only, all the writes of one chunk
+     * are applied in raft order
+     * @param[in] key: used to hash task to specified queue
+     * @param[in] offset: offset of the request in chunk
+     * @param[in] optype: operation type defined in proto
+     * @param[in] f: task
+     * @param[in] args: param to excute task
+     */
+    template<class F, class... Args>
+    bool Push(uint64_t key, uint64_t offset, CHUNK_OP_TYPE optype,
+              F&& f, Args&&... args) {
+        if (rstripesize_ > 0 && Schedule(optype) == ThreadPoolType::READ) {
+            key += offset / rstripesize_;
+        }
+        return Push(key, optype, std::forward<F>(f),
+                    std::forward<Args>(args)...);
+    }
+
     /**
      * Flush: finish all task in write threads
      */
     void Flush();
 
+    /**
+     * FlushAsync: push a marker to all write threads without waiting,
+     * done runs in the write thread reaching the marker last, when all
+     * the tasks pushed before are finished
+     * @param[in] done: callback
+     */
+    void FlushAsync(std::function<void()> done);
+
     void Stop();
 
  private:
@@ -115,6 +215,36 @@ class CURVE_CACHELINE_ALIGNMENT ConcurrentApplyModule {
         return key % concurrent;
     }
 
+    // write queues a striped write must be pushed to
+    std::vector<int> WriteQueues(uint64_t key, uint64_t offset,
+                                 uint64_t length, uint64_t sn);
+
+    // write queues the stripes of the chunk are spread over
+    std::vector<int> ChunkWriteQueues(uint64_t key);
+
+    int StripeQueue(uint64_t key, uint64_t stripe) {
+        return Hash(key + stripe % wstripequeues_, wconcurrentsize_);
+    }
+
+    // returns true if sn is the same as the last write of the chunk
+    // recorded, otherwise records it and returns false
+    bool MatchLastSn(uint64_t key, uint64_t sn);
+
+    // push task to every queue, the last queue reaching it runs the task,
+    // then all the queues continue
+    void PushBarrier(const std::vector<int> &queues, TaskQueue::Task task);
+
+    // chunk id and sn of the last striped write, direct mapped by chunk id.
+    // a chunk evicted by another one is treated as sn changed
+    struct LastSn {
+        bool valid;
+        uint64_t key;
+        uint64_t sn;
+    };
+    static const int kLastSnSlots = 4096;
+    // slots are guarded by sharded locks, slot i by lock i % kLastSnLocks
+    static const int kLastSnLocks = 64;
+
  private:
     typedef uint8_t threadIndex;
     typedef struct taskthread {
@@ -129,7 +259,15 @@ class CURVE_CACHELINE_ALIGNMENT ConcurrentApplyModule {
     int rqueuedepth_;
     int wconcurrentsize_;
     int wqueuedepth_;
+    uint32_t rstripesize_;
+    uint32_t wstripesize_;
+    uint32_t wstripequeues_;
     CountDownEvent cond_;
+    // serialize barrier pushes, so barriers are in the same order in every
+    // queue and can not wait for each other
+    std::mutex barrierMtx_;
+    std::mutex lastSnMtx_[kLastSnLocks];
+    std::vector<LastSn> lastSn_;
     CURVE_CACHELINE_ALIGNMENT std::unordered_map<threadIndex, taskthread_t*> wapplyMap_; // NOLINT
     CURVE_CACHELINE_ALIGNMENT std::unordered_map<threadIndex, taskthread_t*> rapplyMap_;   // NOLINT
 };
@@ -29,6 +29,7 @@
 #include "src/fs/local_filesystem.h"
 #include "src/chunkserver/trash.h"
 #include "src/chunkserver/inflight_throttle.h"
+#include "src/chunkserver/io_throttle.h"
 #include "src/chunkserver/concurrent_apply/concurrent_apply.h"
 #include "include/chunkserver/chunkserver_common.h"
 
@@ -39,6 +40,7 @@ using curve::fs::LocalFileSystem;
 using curve::chunkserver::concurrent::ConcurrentApplyModule;
 
 class FilePool;
+class ChunkFdCache;
 class CopysetNodeManager;
 class CloneManager;
 
@@ -95,6 +97,8 @@ struct CopysetNodeOptions {
     ConcurrentApplyModule *concurrentapply;
     // Chunk file池子
     std::shared_ptr<FilePool> chunkFilePool;
+    // chunk文件和快照文件的fd缓存，为nullptr时不限制打开的文件数
+    std::shared_ptr<ChunkFdCache> chunkFdCache;
     // 文件系统适配层
     std::shared_ptr<LocalFileSystem> localFileSystem;
     // 回收站, 心跳模块判断该chunkserver不在copyset配置组时，
@@ -116,6 +120,21 @@ struct CopysetNodeOptions {
     uint32_t finishLoadMargin = 2000;
     // 循环判定copyset是否加载完成的内部睡眠时间
     uint32_t checkLoadMarginIntervalMs = 1000;
+    // 快照cow的粒度，为0时按pageSize处理
+    uint32_t cowUnitSize = 0;
+    // 是否开启leader lease读，开启后leader在lease有效期内的读请求不再走
+    // raft propose，直接在本地读取，依赖braft的raft_enable_leader_lease
+    bool enableLeaseRead = false;
+    // 同一copyset上并发到达的写请求合并为一条raft日志propose，一条日志最多
+    // 合并的请求个数，为0或1时不合并
+    uint32_t proposeBatchMaxOps = 0;
+    // 一条合并的日志最多包含的写数据量
+    uint32_t proposeBatchMaxBytes = 1024 * 1024;
+    // 合并前等待更多写请求到达的时间，为0时不等待
+    uint32_t proposeBatchWaitUs = 0;
+    // 集群中的chunkserver是否都能解析批量写日志，和ChunkServiceOptions中的
+    // 同名配置相同，没有开启时不合并propose
+    bool enableBatchRequest = false;
 
     CopysetNodeOptions();
 };
@@ -127,6 +146,11 @@ struct ChunkServiceOptions {
     CopysetNodeManager *copysetNodeManager;
     CloneManager *cloneManager;
     std::shared_ptr<InflightThrottle> inflightThrottle;
+    // 磁盘和卷级别的流控, 为nullptr时不做限制
+    std::shared_ptr<IOThrottle> ioThrottle;
+    // 是否处理ReadChunks/WriteChunks批量请求, 批量请求写入的raft日志需要
+    // copyset的所有副本都能解析
+    bool enableBatchRequest = false;
 };
 
 }  // namespace chunkserver
@@ -23,7 +23,9 @@
 #include "src/chunkserver/copyset_node.h"
 
 #include <glog/logging.h>
+#include <brpc/channel.h>
 #include <brpc/controller.h>
+#include <bthread/bthread.h>
 #include <butil/sys_byteorder.h>
 #include <braft/closure_helper.h>
 #include <braft/snapshot.h>
@@ -39,18 +41,38 @@
 #include "src/fs/fs_common.h"
 #include "src/chunkserver/copyset_node_manager.h"
 #include "src/chunkserver/datastore/define.h"
-#include "src/chunkserver/datastore/datastore_file_helper.h"
 #include "src/chunkserver/uri_paser.h"
 #include "src/common/crc32.h"
 #include "src/common/fs_util.h"
+#include "src/common/object_pool.h"
+#include "src/common/timeutility.h"
 
 namespace curve {
 namespace chunkserver {
 
 using curve::fs::FileSystemInfo;
+using curve::common::MakePooledShared;
+using curve::common::TimeUtility;
 
 const char *kCurveConfEpochFilename = "conf.epoch";
 
+namespace {
+
+// follower读向leader获取read index的超时时间
+const int kFetchReadIndexTimeoutMs = 500;
+// 等待applied watermark时的检查间隔
+const uint64_t kWaitWatermarkIntervalUs = 100;
+
+// 只在value更大时更新index
+void UpdateToLarger(std::atomic<uint64_t> *index, uint64_t value) {
+    uint64_t cur = index->load(std::memory_order_acquire);
+    while (cur < value && !index->compare_exchange_weak(
+                              cur, value, std::memory_order_acq_rel)) {
+    }
+}
+
+}  // namespace
+
 CopysetNode::CopysetNode(const LogicPoolID &logicPoolId,
                          const CopysetID &copysetId,
                          const Configuration &initConf) :
@@ -64,7 +86,12 @@ CopysetNode::CopysetNode(const LogicPoolID &logicPoolId,
     chunkDataApath_(),
     chunkDataRpath_(),
     appliedIndex_(0),
+    lastScheduledIndex_(0),
+    appliedWatermark_(std::make_shared<AppliedWatermark>()),
     leaderTerm_(-1),
+    enableLeaseRead_(false),
+    leaseReadTerm_(-1),
+    snapshotManifestVersion_(0),
     configChange_(std::make_shared<ConfigurationChange>()) {
 }
 
@@ -112,6 +139,8 @@ int CopysetNode::Init(const CopysetNodeOptions &options) {
     dsOptions.chunkSize = options.maxChunkSize;
     dsOptions.pageSize = options.pageSize;
     dsOptions.locationLimit = options.locationLimit;
+    dsOptions.cowUnitSize = options.cowUnitSize;
+    dsOptions.fdCache = options.chunkFdCache;
     dataStore_ = std::make_shared<CSDataStore>(options.localFileSystem,
                                                options.chunkFilePool,
                                                dsOptions);
@@ -124,6 +153,15 @@ int CopysetNode::Init(const CopysetNodeOptions &options) {
     }
 
     recyclerUri_ = options.recyclerUri;
+    enableLeaseRead_ = options.enableLeaseRead;
+    // 合并的日志老版本的chunkserver无法解析，集群升级完成前不合并
+    if (options.enableBatchRequest && options.proposeBatchMaxOps > 1) {
+        ProposeBatchOptions batchOptions;
+        batchOptions.maxOps = options.proposeBatchMaxOps;
+        batchOptions.maxBytes = options.proposeBatchMaxBytes;
+        batchOptions.waitUs = options.proposeBatchWaitUs;
+        proposeBatcher_.reset(new ProposeBatcher(this, batchOptions));
+    }
 
     // TODO(wudemiao): 放到nodeOptions的init中
     /**
@@ -238,12 +276,10 @@ void CopysetNode::on_apply(::braft::Iterator &iter) {
             CHECK(nullptr != chunkClosure)
                 << "ChunkClosure dynamic cast failed";
             std::shared_ptr<ChunkOpRequest> opRequest = chunkClosure->request_;
-            auto task = std::bind(&ChunkOpRequest::OnApply,
-                                  opRequest,
-                                  iter.index(),
-                                  doneGuard.release());
-            concurrentapply_->Push(
-                opRequest->ChunkId(), opRequest->OpType(), task);
+            opRequest->TraceRaftDone();
+            opRequest->ScheduleApply(iter.index(),
+                                     doneGuard.release(),
+                                     concurrentapply_);
         } else {
             // 获取log entry
             butil::IOBuf log = iter.data();
@@ -253,18 +289,18 @@ void CopysetNode::on_apply(::braft::Iterator &iter) {
              * 然后获取Op信息进行apply
              * 2.2. follower apply
              */
-            ChunkRequest request;
-            butil::IOBuf data;
-            auto opReq = ChunkOpRequest::Decode(log, &request, &data);
-            auto chunkId = request.chunkid();
-            auto task = std::bind(&ChunkOpRequest::OnApplyFromLog,
-                                  opReq,
-                                  dataStore_,
-                                  std::move(request),
-                                  data);
-            concurrentapply_->Push(chunkId, request.optype(), task);
+            auto entry = MakePooledShared<ChunkLogEntry>();
+            auto opReq = ChunkOpRequest::Decode(log,
+                                                entry->MutableRequest(),
+                                                entry->MutableData());
+            opReq->ScheduleApplyFromLog(dataStore_,
+                                        std::move(entry),
+                                        concurrentapply_);
         }
+        // 放入并发模块之后再更新，标记任务一定排在它之前的日志后面
+        lastScheduledIndex_.store(iter.index(), std::memory_order_release);
     }
+    AdvanceAppliedWatermark();
 }
 
 void CopysetNode::on_shutdown() {
@@ -274,6 +310,7 @@ void CopysetNode::on_shutdown() {
 void CopysetNode::on_snapshot_save(::braft::SnapshotWriter *writer,
                                    ::braft::Closure *done) {
     brpc::ClosureGuard doneGuard(done);
+    uint64_t startUs = TimeUtility::GetTimeofDayUs();
 
     /**
      * 1.flush I/O to disk，确保数据都落盘
@@ -281,7 +318,18 @@ void CopysetNode::on_snapshot_save(::braft::SnapshotWriter *writer,
     concurrentapply_->Flush();
 
     /**
-     * 2.保存配置版本: conf.epoch，注意conf.epoch是存放在data目录下
+     * 2.持久化clone chunk在内存中的bitmap，快照点之前的日志会被删除，
+     * 重启后无法再通过日志回放恢复这部分bitmap
+     */
+    if (CSErrorCode::Success != dataStore_->SyncMetaPages()) {
+        done->status().set_error(EIO, "sync chunk metapage failed");
+        LOG(ERROR) << "Sync chunk metapage failed. "
+                   << "Copyset: " << GroupIdString();
+        return;
+    }
+
+    /**
+     * 3.保存配置版本: conf.epoch，注意conf.epoch是存放在data目录下
      */
     std::string
         filePathTemp = writer->get_path() + "/" + kCurveConfEpochFilename;
@@ -295,37 +343,46 @@ void CopysetNode::on_snapshot_save(::braft::SnapshotWriter *writer,
     }
 
     /**
-     * 3.保存chunk文件名的列表到快照元数据文件中
+     * 4.保存chunk文件名的列表到快照元数据文件中
+     * 文件列表来自datastore内存中的chunk清单，不再list数据目录；
+     * 两次快照之间没有创建或删除chunk时，直接复用上次生成的列表
      */
-    std::vector<std::string> files;
-    if (0 == fs_->List(chunkDataApath_, &files)) {
-        for (const auto& fileName : files) {
-            // raft保存快照时，meta信息中不用保存快照文件列表
-            // raft下载快照的时候，在下载完chunk以后，会单独获取snapshot列表
-            bool isSnapshot = DatastoreFileHelper::IsSnapshotFile(fileName);
-            if (isSnapshot) {
-                continue;
-            }
-            std::string chunkApath;
-            // 通过绝对路径，算出相对于快照目录的路径
-            chunkApath.append(chunkDataApath_);
-            chunkApath.append("/").append(fileName);
-            std::string filePath = curve::common::CalcRelativePath(
-                                    writer->get_path(), chunkApath);
-            writer->add_file(filePath);
-        }
-    } else {
-        done->status().set_error(errno, "invalid: %s", strerror(errno));
-        LOG(ERROR) << "dir reader failed, maybe no exist or permission. "
-                   << "Copyset: " << GroupIdString()
-                   << ", path: " << chunkDataApath_;
-        return;
+    UpdateSnapshotFiles(writer->get_path());
+    for (const auto& filePath : snapshotFiles_) {
+        writer->add_file(filePath);
     }
 
     /**
-     * 4. 保存conf.epoch文件到快照元数据文件中
+     * 5. 保存conf.epoch文件到快照元数据文件中
      */
-     writer->add_file(kCurveConfEpochFilename);
+    writer->add_file(kCurveConfEpochFilename);
+
+    if (metric_ != nullptr) {
+        metric_->OnSnapshotSave(TimeUtility::GetTimeofDayUs() - startUs);
+    }
+}
+
+void CopysetNode::UpdateSnapshotFiles(const std::string& writerPath) {
+    uint64_t version = dataStore_->GetManifestVersion();
+    if (version == snapshotManifestVersion_
+        && writerPath == snapshotWriterPath_) {
+        return;
+    }
+
+    // raft保存快照时，meta信息中不用保存快照文件列表
+    // raft下载快照的时候，在下载完chunk以后，会单独获取snapshot列表
+    std::vector<std::string> chunkFiles;
+    dataStore_->ListChunkFiles(&chunkFiles, nullptr);
+    // 所有chunk文件都在同一目录下，相对快照目录的路径前缀只需计算一次
+    std::string dataRpath =
+        curve::common::CalcRelativePath(writerPath, chunkDataApath_);
+    snapshotFiles_.clear();
+    snapshotFiles_.reserve(chunkFiles.size());
+    for (const auto& fileName : chunkFiles) {
+        snapshotFiles_.emplace_back(dataRpath + "/" + fileName);
+    }
+    snapshotManifestVersion_ = version;
+    snapshotWriterPath_ = writerPath;
 }
 
 int CopysetNode::on_snapshot_load(::braft::SnapshotReader *reader) {
@@ -424,6 +481,9 @@ int CopysetNode::on_snapshot_load(::braft::SnapshotReader *reader) {
         }
     }
     lastSnapshotIndex_ = meta.last_included_index();
+    // 快照中的数据已经加载，之后的日志从last_included_index之后开始apply
+    UpdateToLarger(&lastScheduledIndex_, meta.last_included_index());
+    UpdateToLarger(&appliedWatermark_->index, meta.last_included_index());
     return 0;
 }
 
@@ -431,12 +491,15 @@ void CopysetNode::on_leader_start(int64_t term) {
     leaderTerm_.store(term, std::memory_order_release);
     ChunkServerMetric::GetInstance()->IncreaseLeaderCount();
     concurrentapply_->Flush();
+    // Flush之后之前任期的日志都已apply，此时才允许lease读
+    leaseReadTerm_.store(term, std::memory_order_release);
     LOG(INFO) << "Copyset: " << GroupIdString()
               << ", peer id: " << peerId_.to_string()
               << " become leader, term is: " << leaderTerm_;
 }
 
 void CopysetNode::on_leader_stop(const butil::Status &status) {
+    leaseReadTerm_.store(-1, std::memory_order_release);
     leaderTerm_.store(-1, std::memory_order_release);
     ChunkServerMetric::GetInstance()->DecreaseLeaderCount();
     LOG(INFO) << "Copyset: " << GroupIdString()
@@ -541,6 +604,8 @@ void CopysetNode::ListPeers(std::vector<Peer>* peers) {
 
 void CopysetNode::SetCSDateStore(std::shared_ptr<CSDataStore> datastore) {
     dataStore_ = datastore;
+    // 清单版本号只在同一个datastore内有意义
+    snapshotWriterPath_.clear();
 }
 
 void CopysetNode::SetLocalFileSystem(std::shared_ptr<LocalFileSystem> fs) {
@@ -565,6 +630,25 @@ bool CopysetNode::IsLeaderTerm() const {
     return false;
 }
 
+bool CopysetNode::IsLeaseLeader() const {
+    /**
+     * 读写请求分别进入并发模块的读队列和写队列，读不会等待已提交的写
+     * 执行完成，所以必须保证applied index已经追上committed index：
+     * braft在之前任期的日志都交给on_apply之后才回调on_leader_start，
+     * on_leader_start中Flush等待它们在写队列中执行完，之后才设置
+     * leaseReadTerm_；当前任期的写都是apply之后才返回client，所以已
+     * 应答的写一定可见。lease有效则保证此刻不存在更新任期的leader
+     */
+    if (!enableLeaseRead_) {
+        return false;
+    }
+    int64_t term = leaseReadTerm_.load(std::memory_order_acquire);
+    if (term <= 0 || term != leaderTerm_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    return raftNode_->is_leader_lease_valid();
+}
+
 PeerId CopysetNode::GetLeaderId() const {
     return raftNode_->leader_id();
 }
@@ -719,7 +803,95 @@ void CopysetNode::UpdateAppliedIndex(uint64_t index) {
 }
 
 uint64_t CopysetNode::GetAppliedIndex() const {
-    return appliedIndex_.load(std::memory_order_acquire);
+    // follower上只有applied watermark在推进
+    return std::max(appliedIndex_.load(std::memory_order_acquire),
+                    GetAppliedWatermark());
+}
+
+bool CopysetNode::GetReadIndex(uint64_t *index) const {
+    int64_t term = leaderTerm_.load(std::memory_order_acquire);
+    if (term <= 0 || term != leaseReadTerm_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    /**
+     * 开启lease读时确认lease有效，保证此刻不存在更新任期的leader；
+     * 否则和raft的选举超时相同，被隔离的旧leader在选出新leader之前
+     * 返回的read index仍然不早于所有已应答的写
+     */
+    if (enableLeaseRead_ && !raftNode_->is_leader_lease_valid()) {
+        return false;
+    }
+    *index = lastScheduledIndex_.load(std::memory_order_acquire);
+    return true;
+}
+
+int CopysetNode::FetchLeaderReadIndex(ChunkID chunkId, uint64_t *index) {
+    PeerId leader = GetLeaderId();
+    if (leader.is_empty()) {
+        return -1;
+    }
+    brpc::Channel channel;
+    if (channel.Init(leader.addr, NULL) != 0) {
+        LOG(WARNING) << "Fail to init channel to leader " << leader
+                     << ", Copyset: " << GroupIdString();
+        return -1;
+    }
+    ChunkService_Stub stub(&channel);
+    GetChunkInfoRequest request;
+    GetChunkInfoResponse response;
+    brpc::Controller cntl;
+    cntl.set_timeout_ms(kFetchReadIndexTimeoutMs);
+    request.set_logicpoolid(logicPoolId_);
+    request.set_copysetid(copysetId_);
+    request.set_chunkid(chunkId);
+    stub.GetChunkInfo(&cntl, &request, &response, NULL);
+    if (cntl.Failed()) {
+        LOG(WARNING) << "Fail to get read index from leader " << leader
+                     << ", Copyset: " << GroupIdString()
+                     << ", error: " << cntl.ErrorText();
+        return -1;
+    }
+    // 旧版本的leader不返回read index
+    if (response.status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS
+        || !response.has_readindex()) {
+        return -1;
+    }
+    *index = response.readindex();
+    return 0;
+}
+
+bool CopysetNode::WaitAppliedWatermark(uint64_t index, uint64_t timeoutUs) {
+    uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    while (GetAppliedWatermark() < index) {
+        AdvanceAppliedWatermark();
+        if (TimeUtility::GetTimeofDayUs() - startUs >= timeoutUs) {
+            return false;
+        }
+        bthread_usleep(kWaitWatermarkIntervalUs);
+    }
+    return true;
+}
+
+uint64_t CopysetNode::GetAppliedWatermark() const {
+    return appliedWatermark_->index.load(std::memory_order_acquire);
+}
+
+void CopysetNode::AdvanceAppliedWatermark() {
+    uint64_t target = lastScheduledIndex_.load(std::memory_order_acquire);
+    if (nullptr == concurrentapply_ || target <= GetAppliedWatermark()) {
+        return;
+    }
+    bool expected = false;
+    if (!appliedWatermark_->inflight.compare_exchange_strong(
+            expected, true, std::memory_order_acq_rel)) {
+        return;
+    }
+    std::shared_ptr<AppliedWatermark> watermark = appliedWatermark_;
+    concurrentapply_->FlushAsync([watermark, target]() {
+        // 加载快照可能已经把watermark推进到target之后
+        UpdateToLarger(&watermark->index, target);
+        watermark->inflight.store(false, std::memory_order_release);
+    });
 }
 
 std::shared_ptr<CSDataStore> CopysetNode::GetDataStore() const {
@@ -39,6 +39,7 @@
 #include "src/chunkserver/raftsnapshot/curve_snapshot_writer.h"
 #include "src/common/string_util.h"
 #include "src/chunkserver/raft_node.h"
+#include "src/chunkserver/propose_batcher.h"
 #include "proto/heartbeat.pb.h"
 #include "proto/chunk.pb.h"
 #include "proto/common.pb.h"
@@ -155,6 +156,13 @@ class CopysetNode : public braft::StateMachine,
      */
     virtual bool IsLeaderTerm() const;
 
+    /**
+     * 返回当前副本是否是持有有效lease的leader，只有开启了lease读时才可能
+     * 返回true，此时读请求可以不走raft propose直接在本地读取
+     * @return
+     */
+    virtual bool IsLeaseLeader() const;
+
     /**
      * 返回当前的任期
      * @return 当前的任期
@@ -213,6 +221,36 @@ class CopysetNode : public braft::StateMachine,
      */
     virtual uint64_t GetAppliedIndex() const;
 
+    /**
+     * 作为leader返回follower读的read index。之前任期的日志在
+     * on_leader_start中已经执行完，当前任期的写apply之后才应答client，
+     * 所以已经放入并发模块的最大log index不早于所有已应答的写
+     * @param index[out]: read index
+     * @return 不是leader或者on_leader_start还未完成时返回false
+     */
+    virtual bool GetReadIndex(uint64_t *index) const;
+
+    /**
+     * 作为follower通过GetChunkInfo向leader获取read index
+     * @param chunkId: 读请求的chunk id
+     * @param index[out]: read index
+     * @return 0成功，-1 leader未知、rpc失败或者leader未返回read index
+     */
+    virtual int FetchLeaderReadIndex(ChunkID chunkId, uint64_t *index);
+
+    /**
+     * 等待applied watermark追上index
+     * @param index: 需要等待的log index
+     * @param timeoutUs: 超时时间
+     * @return 超时前追上返回true
+     */
+    virtual bool WaitAppliedWatermark(uint64_t index, uint64_t timeoutUs);
+
+    /**
+     * 返回applied watermark，不大于它的日志都已经在并发模块中执行完
+     */
+    uint64_t GetAppliedWatermark() const;
+
     /**
      * @brief: 查询配置变更的状态
      * @param type[out]: 配置变更类型
@@ -261,6 +299,13 @@ class CopysetNode : public braft::StateMachine,
      */
     virtual void Propose(const braft::Task &task);
 
+    /**
+     * 返回合并propose写请求的batcher，没有开启时返回nullptr
+     */
+    ProposeBatcher *GetProposeBatcher() const {
+        return proposeBatcher_.get();
+    }
+
     /**
      * 获取复制组成员
      * @param peers:返回的成员列表(输出参数)
@@ -378,6 +423,20 @@ class CopysetNode : public braft::StateMachine,
     int SaveConfEpoch(const std::string &filePath);
 
  private:
+    /**
+     * 根据datastore的chunk清单更新snapshotFiles_
+     * 清单版本号和快照目录都没有变化时不做任何事
+     * @param writerPath: 本次打快照的快照目录
+     */
+    void UpdateSnapshotFiles(const std::string& writerPath);
+
+    /**
+     * 已放入并发模块的日志超过applied watermark时，向所有写队列放入
+     * 标记任务，标记任务都执行完后把watermark推进到放入时的最大log
+     * index。同一时刻只有一个标记任务在写队列中
+     */
+    void AdvanceAppliedWatermark();
+
     inline std::string GroupId() {
         return ToGroupId(logicPoolId_, copysetId_);
     }
@@ -419,12 +478,35 @@ class CopysetNode : public braft::StateMachine,
     std::unique_ptr<ConfEpochFile> epochFile_;
     // 复制组的apply index
     std::atomic<uint64_t> appliedIndex_;
+    // on_apply中已经放入并发模块的最大log index
+    std::atomic<uint64_t> lastScheduledIndex_;
+    // 连续的applied index，不大于它的日志都已经在并发模块中执行完。
+    // 由写队列中的标记任务推进，标记任务可能晚于copyset析构，所以共享持有
+    struct AppliedWatermark {
+        std::atomic<uint64_t> index;
+        // 是否有标记任务还在写队列中
+        std::atomic<bool> inflight;
+        AppliedWatermark() : index(0), inflight(false) {}
+    };
+    std::shared_ptr<AppliedWatermark> appliedWatermark_;
     // 复制组当前任期，如果<=0表明不是leader
     std::atomic<int64_t> leaderTerm_;
+    // 是否开启leader lease读
+    bool enableLeaseRead_;
+    // 允许lease读的任期，on_leader_start中之前任期的日志apply完成后才设置，
+    // 与leaderTerm_相等时lease读才生效
+    std::atomic<int64_t> leaseReadTerm_;
+    // 合并propose同一copyset上并发到达的写请求
+    std::unique_ptr<ProposeBatcher> proposeBatcher_;
     // 复制组数据回收站目录
     std::string recyclerUri_;
     // 复制组的metric信息
     CopysetMetricPtr metric_;
+    // 上次打快照时加入快照元数据的chunk文件列表(相对快照目录的路径)
+    std::vector<std::string> snapshotFiles_;
+    // snapshotFiles_对应的chunk清单版本号和快照目录
+    uint64_t snapshotManifestVersion_;
+    std::string snapshotWriterPath_;
     // 正在进行中的配置变更
     std::shared_ptr<ConfigurationChange> configChange_;
     // transfer leader的目标，状态为TRANSFERRING时有效
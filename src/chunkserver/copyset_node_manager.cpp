@@ -279,6 +279,31 @@ std::shared_ptr<CopysetNode> CopysetNodeManager::GetCopysetNode(
     return nullptr;
 }
 
+bool CopysetNodeManager::ListSnapshotFiles(
+    const std::string &raftBaseDir,
+    std::vector<std::string> *snapFiles) const {
+    // 基础目录的最后一级是copyset的group id
+    std::string::size_type end = raftBaseDir.find_last_not_of('/');
+    if (end == std::string::npos) {
+        return false;
+    }
+    std::string::size_type begin = raftBaseDir.rfind('/', end);
+    begin = (begin == std::string::npos) ? 0 : begin + 1;
+    uint64_t groupId;
+    if (!::curve::common::StringToUll(
+            raftBaseDir.substr(begin, end - begin + 1), &groupId)) {
+        return false;
+    }
+
+    CopysetNodePtr node =
+        GetCopysetNode(GetPoolID(groupId), GetCopysetID(groupId));
+    if (node == nullptr || node->GetDataStore() == nullptr) {
+        return false;
+    }
+    node->GetDataStore()->ListChunkFiles(nullptr, snapFiles);
+    return true;
+}
+
 void CopysetNodeManager::GetAllCopysetNodes(
     std::vector<CopysetNodePtr> *nodes) const {
     /* 加读锁 */
@@ -128,6 +128,17 @@ class CopysetNodeManager : public curve::common::Uncopyable {
      */
     void GetAllCopysetNodes(std::vector<CopysetNodePtr> *nodes) const;
 
+    /**
+     * 根据raft实例的基础目录找到对应的copyset，从其datastore的chunk清单
+     * 获取chunk快照文件名，用于leader返回下载快照需要的attachment文件
+     * @param raftBaseDir: raft实例的基础目录，
+     *        比如/data/chunkserver1/copysets/4294967812/
+     * @param snapFiles[out]: chunk快照文件名
+     * @return true成功，false目录无法解析或copyset不存在
+     */
+    bool ListSnapshotFiles(const std::string &raftBaseDir,
+                           std::vector<std::string> *snapFiles) const;
+
     /**
      * 添加RPC service
      * TODO(wudemiao): 目前仅仅用于测试，后期完善了会删除掉
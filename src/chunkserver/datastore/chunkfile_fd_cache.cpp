@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include <glog/logging.h>
+
+#include "src/chunkserver/datastore/chunkfile_fd_cache.h"
+
+namespace curve {
+namespace chunkserver {
+
+ChunkFdCache::ChunkFdCache(std::shared_ptr<LocalFileSystem> lfs,
+                           uint32_t capacity,
+                           uint32_t shardNum)
+    : lfs_(lfs),
+      shardNum_(shardNum == 0 ? 1 : shardNum),
+      openCount_(0),
+      missCount_(0),
+      evictCount_(0) {
+    CHECK(lfs_ != nullptr) << "Create chunk fd cache failed";
+    // 容量较小时减少分片，保证每个分片至少可以缓存一个fd
+    if (capacity < shardNum_) {
+        shardNum_ = capacity == 0 ? 1 : capacity;
+    }
+    shardCapacity_ = (capacity + shardNum_ - 1) / shardNum_;
+    if (shardCapacity_ == 0) {
+        shardCapacity_ = 1;
+    }
+    shards_.reset(new Shard[shardNum_]);
+}
+
+ChunkFdCache::~ChunkFdCache() {
+    for (uint32_t i = 0; i < shardNum_; ++i) {
+        for (auto& entry : shards_[i].lru) {
+            lfs_->Close(entry.fd);
+        }
+    }
+}
+
+void ChunkFdCache::Insert(const void* key, int fd) {
+    Put(GetShard(key), key, fd, 0);
+}
+
+void ChunkFdCache::Release(const void* key) {
+    Shard* shard = GetShard(key);
+    std::vector<int> fds;
+    {
+        LockGuard lockGuard(shard->mtx);
+        auto iter = shard->index.find(key);
+        if (iter == shard->index.end()) {
+            LOG(ERROR) << "Release fd not in cache.";
+            return;
+        }
+        Entry& entry = *iter->second;
+        CHECK(entry.ref > 0) << "Release fd without reference.";
+        --entry.ref;
+        // 所有fd都在使用时分片可能超过容量，在引用释放后淘汰
+        if (entry.ref == 0) {
+            EvictLocked(shard, &fds);
+        }
+    }
+    CloseFds(fds);
+}
+
+void ChunkFdCache::Erase(const void* key) {
+    Shard* shard = GetShard(key);
+    int fd = -1;
+    {
+        LockGuard lockGuard(shard->mtx);
+        auto iter = shard->index.find(key);
+        if (iter == shard->index.end()) {
+            return;
+        }
+        LOG_IF(ERROR, iter->second->ref != 0)
+            << "Erase fd in use, ref = " << iter->second->ref;
+        fd = iter->second->fd;
+        shard->lru.erase(iter->second);
+        shard->index.erase(iter);
+    }
+    lfs_->Close(fd);
+    openCount_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+ChunkFdCache::Shard* ChunkFdCache::GetShard(const void* key) {
+    // 文件对象的地址低位相同，打散后再取模
+    uint64_t hash = reinterpret_cast<uintptr_t>(key) >> 4;
+    hash *= 0x9E3779B97F4A7C15ULL;
+    return &shards_[(hash >> 32) % shardNum_];
+}
+
+int ChunkFdCache::Put(Shard* shard, const void* key, int fd, uint32_t ref) {
+    std::vector<int> fds;
+    int result = fd;
+    {
+        LockGuard lockGuard(shard->mtx);
+        auto iter = shard->index.find(key);
+        if (iter != shard->index.end()) {
+            // 其他线程已经重新打开了文件
+            fds.push_back(fd);
+            Entry& entry = *iter->second;
+            entry.ref += ref;
+            shard->lru.splice(shard->lru.begin(), shard->lru, iter->second);
+            result = entry.fd;
+        } else {
+            shard->lru.push_front(Entry{key, fd, ref});
+            shard->index[key] = shard->lru.begin();
+            openCount_.fetch_add(1, std::memory_order_relaxed);
+            EvictLocked(shard, &fds);
+        }
+    }
+    CloseFds(fds);
+    return result;
+}
+
+void ChunkFdCache::EvictLocked(Shard* shard, std::vector<int>* fds) {
+    auto iter = shard->lru.end();
+    while (shard->index.size() > shardCapacity_) {
+        --iter;
+        // 不淘汰最近访问的fd，避免刚打开的文件被立即关闭
+        if (iter == shard->lru.begin()) {
+            break;
+        }
+        if (iter->ref != 0) {
+            continue;
+        }
+        fds->push_back(iter->fd);
+        shard->index.erase(iter->key);
+        iter = shard->lru.erase(iter);
+        openCount_.fetch_sub(1, std::memory_order_relaxed);
+        evictCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ChunkFdCache::CloseFds(const std::vector<int>& fds) {
+    for (int fd : fds) {
+        lfs_->Close(fd);
+    }
+}
+
+}  // namespace chunkserver
+}  // namespace curve
@@ -0,0 +1,206 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#ifndef SRC_CHUNKSERVER_DATASTORE_CHUNKFILE_FD_CACHE_H_
+#define SRC_CHUNKSERVER_DATASTORE_CHUNKFILE_FD_CACHE_H_
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/uncopyable.h"
+#include "src/fs/local_filesystem.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::common::LockGuard;
+using curve::common::Mutex;
+using curve::fs::LocalFileSystem;
+
+/**
+ * chunk文件和快照文件fd的LRU缓存，限制chunkserver上同时打开的文件数
+ * 以文件对象的地址作为key，被淘汰的fd在下次访问时由文件对象重新打开
+ * 正在使用的fd持有引用，不会被淘汰，因此打开的文件数可能短暂超过容量
+ * 按key分片加锁，每个分片分别按容量淘汰
+ */
+class ChunkFdCache {
+ public:
+    static const uint32_t kDefaultShardNum = 16;
+
+    /**
+     * @param lfs: 用于关闭被淘汰的fd
+     * @param capacity: 最多同时打开的文件数
+     * @param shardNum: 分片个数
+     */
+    ChunkFdCache(std::shared_ptr<LocalFileSystem> lfs,
+                 uint32_t capacity,
+                 uint32_t shardNum = kDefaultShardNum);
+    virtual ~ChunkFdCache();
+
+    /**
+     * 获取key对应的fd并增加引用，不在缓存中时调用open重新打开文件
+     * @param key: 文件对象的地址
+     * @param open: 打开文件，成功返回fd，失败返回负数
+     * @return: 成功返回fd，失败返回open的错误码
+     */
+    template <typename Opener>
+    int Acquire(const void* key, const Opener& open) {
+        Shard* shard = GetShard(key);
+        {
+            LockGuard lockGuard(shard->mtx);
+            auto iter = shard->index.find(key);
+            if (iter != shard->index.end()) {
+                Entry& entry = *iter->second;
+                ++entry.ref;
+                shard->lru.splice(shard->lru.begin(), shard->lru,
+                                  iter->second);
+                return entry.fd;
+            }
+        }
+        // 在锁外打开文件，避免阻塞同一分片上其他文件的访问
+        int fd = open();
+        if (fd < 0) {
+            return fd;
+        }
+        missCount_.fetch_add(1, std::memory_order_relaxed);
+        return Put(shard, key, fd, 1);
+    }
+
+    /**
+     * 将文件对象打开的fd交给缓存管理，不增加引用
+     * @param key: 文件对象的地址
+     * @param fd: 已打开的fd
+     */
+    void Insert(const void* key, int fd);
+
+    /**
+     * 释放Acquire获取的引用，引用为0的fd可以被淘汰
+     */
+    void Release(const void* key);
+
+    /**
+     * 关闭key对应的fd并从缓存中删除，在文件删除或者文件对象析构时调用，
+     * 调用者需要保证没有其他引用
+     */
+    void Erase(const void* key);
+
+    // 当前打开的文件数
+    uint32_t GetOpenCount() const {
+        return openCount_.load(std::memory_order_relaxed);
+    }
+
+    // 因为fd被淘汰而重新打开文件的次数
+    uint64_t GetMissCount() const {
+        return missCount_.load(std::memory_order_relaxed);
+    }
+
+    // 被淘汰关闭的fd个数
+    uint64_t GetEvictCount() const {
+        return evictCount_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    struct Entry {
+        const void* key;
+        int fd;
+        uint32_t ref;
+    };
+    using EntryList = std::list<Entry>;
+
+    struct Shard {
+        Mutex mtx;
+        // 按访问时间排序，表头为最近访问的fd
+        EntryList lru;
+        std::unordered_map<const void*, EntryList::iterator> index;
+    };
+
+    Shard* GetShard(const void* key);
+
+    /**
+     * 插入fd，key已存在时(并发重新打开)关闭新打开的fd，使用已有的fd
+     * @param ref: 插入后增加的引用
+     * @return: 缓存中key对应的fd
+     */
+    int Put(Shard* shard, const void* key, int fd, uint32_t ref);
+
+    /**
+     * 从表尾开始淘汰没有引用的fd，直到分片内的fd数不超过容量
+     * @param fds: 需要在锁外关闭的fd
+     */
+    void EvictLocked(Shard* shard, std::vector<int>* fds);
+
+    void CloseFds(const std::vector<int>& fds);
+
+ private:
+    std::shared_ptr<LocalFileSystem> lfs_;
+    // 每个分片的容量
+    uint32_t shardCapacity_;
+    uint32_t shardNum_;
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic<uint32_t> openCount_;
+    std::atomic<uint64_t> missCount_;
+    std::atomic<uint64_t> evictCount_;
+};
+
+/**
+ * 在作用域内持有文件fd的引用，保证使用期间fd不会被淘汰
+ * 未开启fd缓存时直接使用文件对象自己打开的fd
+ */
+class ChunkFdGuard : public curve::common::Uncopyable {
+ public:
+    template <typename Opener>
+    ChunkFdGuard(ChunkFdCache* cache,
+                 const void* key,
+                 int fd,
+                 const Opener& open)
+        : cache_(cache), key_(key), fd_(fd) {
+        if (cache_ != nullptr) {
+            fd_ = cache_->Acquire(key_, open);
+        }
+    }
+
+    ~ChunkFdGuard() {
+        if (cache_ != nullptr && fd_ >= 0) {
+            cache_->Release(key_);
+        }
+    }
+
+    // 返回fd，重新打开文件失败时返回错误码
+    int Get() const {
+        return fd_;
+    }
+
+ private:
+    ChunkFdCache* cache_;
+    const void* key_;
+    int fd_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_DATASTORE_CHUNKFILE_FD_CACHE_H_
@@ -134,15 +134,22 @@ CSChunkFile::CSChunkFile(std::shared_ptr<LocalFileSystem> lfs,
     : fd_(-1),
       size_(options.chunkSize),
       pageSize_(options.pageSize),
+      cowUnitSize_(options.pageSize),
       chunkId_(options.id),
       baseDir_(options.baseDir),
       isCloneChunk_(false),
+      bitmapDirty_(false),
       snapshot_(nullptr),
       chunkFilePool_(chunkFilePool),
       lfs_(lfs),
-      metric_(options.metric) {
+      metric_(options.metric),
+      fdCache_(options.fdCache) {
     CHECK(!baseDir_.empty()) << "Create chunk file failed";
     CHECK(lfs_ != nullptr) << "Create chunk file failed";
+    // cow粒度按page对齐，且不超过chunk大小
+    if (options.cowUnitSize > pageSize_ && options.cowUnitSize <= size_) {
+        cowUnitSize_ = options.cowUnitSize / pageSize_ * pageSize_;
+    }
     metaPage_.sn = options.sn;
     metaPage_.correctedSn = options.correctedSn;
     metaPage_.location = options.location;
@@ -162,6 +169,9 @@ CSChunkFile::~CSChunkFile() {
         snapshot_ = nullptr;
     }
 
+    if (fdCache_ != nullptr) {
+        fdCache_->Erase(this);
+    }
     if (fd_ >= 0) {
         lfs_->Close(fd_);
     }
@@ -197,15 +207,25 @@ CSErrorCode CSChunkFile::Open(bool createFile) {
             return CSErrorCode::InternalError;
         }
     }
-    int rc = lfs_->Open(chunkFilePath, O_RDWR|O_NOATIME|O_DSYNC);
+    int rc = openFile();
     if (rc < 0) {
         LOG(ERROR) << "Error occured when opening file."
                    << " filepath = " << chunkFilePath;
         return CSErrorCode::InternalError;
     }
-    fd_ = rc;
+    // 开启fd缓存时，打开的fd交给缓存管理，可能被淘汰
+    if (fdCache_ != nullptr) {
+        fdCache_->Insert(this, rc);
+    } else {
+        fd_ = rc;
+    }
     struct stat fileInfo;
-    rc = lfs_->Fstat(fd_, &fileInfo);
+    {
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        rc = fd.Get() < 0 ? fd.Get() : lfs_->Fstat(fd.Get(), &fileInfo);
+    }
     if (rc < 0) {
         LOG(ERROR) << "Error occured when stating file."
                    << " filepath = " << chunkFilePath;
@@ -247,6 +267,7 @@ CSErrorCode CSChunkFile::LoadSnapshot(SequenceNum sn) {
     options.chunkSize = size_;
     options.pageSize = pageSize_;
     options.metric = metric_;
+    options.fdCache = fdCache_;
     snapshot_ = new(std::nothrow) CSSnapshot(lfs_,
                                             chunkFilePool_,
                                             options);
@@ -269,7 +290,6 @@ CSErrorCode CSChunkFile::Write(SequenceNum sn,
                                off_t offset,
                                size_t length,
                                uint32_t* cost) {
-    WriteLockGuard writeGuard(rwLock_);
     if (!CheckOffsetAndLength(offset, length)) {
         LOG(ERROR) << "Write chunk failed, invalid offset or length."
                    << "ChunkID: " << chunkId_
@@ -279,6 +299,30 @@ CSErrorCode CSChunkFile::Write(SequenceNum sn,
                    << ", chunk size: " << size_;
         return CSErrorCode::InvalidArgError;
     }
+    // 先对写入的page区间加互斥锁，重叠区域的读写互斥，不重叠的可以并发。
+    // 修改metapage、快照和bitmap的操作都持有整个chunk的区间锁，
+    // 只写数据时持有区间锁即可，不需要再加rwLock_
+    {
+        RangeLockGuard rangeGuard(&rangeLock_,
+                                  offset / pageSize_,
+                                  (offset + length - 1) / pageSize_,
+                                  true);
+        if (!needUpdateMeta(sn)) {
+            int rc = writeData(buf, offset, length);
+            if (rc < 0) {
+                LOG(ERROR) << "Write data to chunk file failed."
+                           << "ChunkID: " << chunkId_
+                           << ",request sn: " << sn
+                           << ",chunk sn: " << metaPage_.sn;
+                return CSErrorCode::InternalError;
+            }
+            return CSErrorCode::Success;
+        }
+    }
+    // 需要修改chunk状态时锁住整个chunk，释放区间锁期间状态可能已经改变，
+    // 以下逻辑重新判断
+    RangeLockGuard chunkGuard(&rangeLock_, 0, lastPageIndex(), true);
+    WriteLockGuard writeGuard(rwLock_);
     // 用户快照以后会保证之前的请求全部到达或者超时以后才会下发新的请求
     // 因此此处只可能是日志恢复的请求，且一定已经执行，此处可返回错误码
     if (sn < metaPage_.sn || sn < metaPage_.correctedSn) {
@@ -319,6 +363,7 @@ CSErrorCode CSChunkFile::Write(SequenceNum sn,
         options.chunkSize = size_;
         options.pageSize = pageSize_;
         options.metric = metric_;
+        options.fdCache = fdCache_;
         snapshot_ = new(std::nothrow) CSSnapshot(lfs_,
                                                  chunkFilePool_,
                                                  options);
@@ -367,7 +412,7 @@ CSErrorCode CSChunkFile::Write(SequenceNum sn,
                    << ",chunk sn: " << metaPage_.sn;
         return CSErrorCode::InternalError;
     }
-    // 如果是clone chunk会更新bitmap
+    // clone chunk的page全部被写过以后转为普通chunk
     CSErrorCode errorCode = flush();
     if (errorCode != CSErrorCode::Success) {
         LOG(ERROR) << "Write data to chunk file failed."
@@ -380,6 +425,7 @@ CSErrorCode CSChunkFile::Write(SequenceNum sn,
 }
 
 CSErrorCode CSChunkFile::Paste(const char * buf, off_t offset, size_t length) {
+    RangeLockGuard chunkGuard(&rangeLock_, 0, lastPageIndex(), true);
     WriteLockGuard writeGuard(rwLock_);
     if (!CheckOffsetAndLength(offset, length)) {
         LOG(ERROR) << "Paste chunk failed, invalid offset or length."
@@ -423,7 +469,7 @@ CSErrorCode CSChunkFile::Paste(const char * buf, off_t offset, size_t length) {
         }
     }
 
-    // 更新bitmap
+    // clone chunk的page全部被写过以后转为普通chunk
     CSErrorCode errorCode = flush();
     if (errorCode != CSErrorCode::Success) {
         LOG(ERROR) << "Paste data to chunk failed."
@@ -436,7 +482,6 @@ CSErrorCode CSChunkFile::Paste(const char * buf, off_t offset, size_t length) {
 }
 
 CSErrorCode CSChunkFile::Read(char * buf, off_t offset, size_t length) {
-    ReadLockGuard readGuard(rwLock_);
     if (!CheckOffsetAndLength(offset, length)) {
         LOG(ERROR) << "Read chunk failed, invalid offset or length."
                    << "ChunkID: " << chunkId_
@@ -446,6 +491,12 @@ CSErrorCode CSChunkFile::Read(char * buf, off_t offset, size_t length) {
                    << ", chunk size: " << size_;
         return CSErrorCode::InvalidArgError;
     }
+    // 避免读到同一区域正在进行的写
+    RangeLockGuard rangeGuard(&rangeLock_,
+                              offset / pageSize_,
+                              (offset + length - 1) / pageSize_,
+                              false);
+    ReadLockGuard readGuard(rwLock_);
 
     // 如果是 clonechunk ,要保证读取区域已经被写过，否则返回错误
     if (isCloneChunk_) {
@@ -478,7 +529,6 @@ CSErrorCode CSChunkFile::ReadSpecifiedChunk(SequenceNum sn,
                                             char * buf,
                                             off_t offset,
                                             size_t length)  {
-    ReadLockGuard readGuard(rwLock_);
     if (!CheckOffsetAndLength(offset, length)) {
         LOG(ERROR) << "Read specified chunk failed, invalid offset or length."
                    << "ChunkID: " << chunkId_
@@ -488,6 +538,11 @@ CSErrorCode CSChunkFile::ReadSpecifiedChunk(SequenceNum sn,
                    << ", chunk size: " << size_;
         return CSErrorCode::InvalidArgError;
     }
+    RangeLockGuard rangeGuard(&rangeLock_,
+                              offset / pageSize_,
+                              (offset + length - 1) / pageSize_,
+                              false);
+    ReadLockGuard readGuard(rwLock_);
     // 版本为当前chunk的版本，则读当前chunk文件
     if (sn == metaPage_.sn) {
         int rc = readData(buf, offset, length);
@@ -550,6 +605,7 @@ CSErrorCode CSChunkFile::ReadSpecifiedChunk(SequenceNum sn,
 }
 
 CSErrorCode CSChunkFile::Delete(SequenceNum sn)  {
+    RangeLockGuard chunkGuard(&rangeLock_, 0, lastPageIndex(), true);
     WriteLockGuard writeGuard(rwLock_);
     // 如果 sn 小于当前chunk的版本号，不允许删除
     if (sn < metaPage_.sn) {
@@ -578,6 +634,12 @@ CSErrorCode CSChunkFile::Delete(SequenceNum sn)  {
         snapshot_ = nullptr;
     }
 
+    // 文件回收后不能再通过缓存重新打开，也不需要再同步metapage
+    bitmapDirty_ = false;
+    if (fdCache_ != nullptr) {
+        fdCache_->Erase(this);
+        fdCache_ = nullptr;
+    }
     if (fd_ >= 0) {
         lfs_->Close(fd_);
         fd_ = -1;
@@ -594,6 +656,7 @@ CSErrorCode CSChunkFile::Delete(SequenceNum sn)  {
 }
 
 CSErrorCode CSChunkFile::DeleteSnapshotOrCorrectSn(SequenceNum correctedSn)  {
+    RangeLockGuard chunkGuard(&rangeLock_, 0, lastPageIndex(), true);
     WriteLockGuard writeGuard(rwLock_);
 
     // 如果是clone chunk， 理论上不应该会调这个接口，返回错误
@@ -683,6 +746,28 @@ void CSChunkFile::GetInfo(CSChunkInfo* info)  {
         info->bitmap = nullptr;
 }
 
+SequenceNum CSChunkFile::GetSnapshotSn() {
+    ReadLockGuard readGuard(rwLock_);
+    return snapshot_ == nullptr ? 0 : snapshot_->GetSn();
+}
+
+CSErrorCode CSChunkFile::SyncMetaPage() {
+    WriteLockGuard writeGuard(rwLock_);
+    if (!bitmapDirty_) {
+        return CSErrorCode::Success;
+    }
+    ChunkFileMetaPage tempMeta = metaPage_;
+    CSErrorCode errorCode = updateMetaPage(&tempMeta);
+    if (errorCode != CSErrorCode::Success) {
+        LOG(ERROR) << "Sync metapage failed."
+                   << "ChunkID: " << chunkId_
+                   << ",chunk sn: " << metaPage_.sn;
+        return errorCode;
+    }
+    bitmapDirty_ = false;
+    return CSErrorCode::Success;
+}
+
 CSErrorCode CSChunkFile::GetHash(off_t offset,
                                  size_t length,
                                  std::string* hash)  {
@@ -694,7 +779,11 @@ CSErrorCode CSChunkFile::GetHash(off_t offset,
         return CSErrorCode::InternalError;
     }
 
-    int rc = lfs_->Read(fd_, buf, offset, length);
+    ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+        return openFile();
+    });
+    int rc = fd.Get() < 0
+                 ? fd.Get() : lfs_->Read(fd.Get(), buf, offset, length);
     if (rc < 0) {
         LOG(ERROR) << "Read chunk file failed."
                    << "ChunkID: " << chunkId_
@@ -734,6 +823,19 @@ bool CSChunkFile::needCreateSnapshot(SequenceNum sn) {
     return true;
 }
 
+bool CSChunkFile::needUpdateMeta(SequenceNum sn) {
+    // clone chunk写数据以后需要更新bitmap
+    if (isCloneChunk_)
+        return true;
+    // 版本号不等于chunk版本号时，可能要拒绝请求、创建快照或者更新metapage
+    if (sn != metaPage_.sn || sn < metaPage_.correctedSn)
+        return true;
+    // 存在快照且当前chunk还未转储完成，需要cow
+    if (nullptr != snapshot_ && sn != metaPage_.correctedSn)
+        return true;
+    return false;
+}
+
 bool CSChunkFile::needCow(SequenceNum sn) {
     SequenceNum chunkSn = std::max(metaPage_.correctedSn, metaPage_.sn);
     // 对于小于chunkSn的请求，会直接拒绝
@@ -790,9 +892,17 @@ CSErrorCode CSChunkFile::loadMetaPage() {
 }
 
 CSErrorCode CSChunkFile::copy2Snapshot(off_t offset, size_t length) {
+    // 按cow粒度扩展拷贝区域，这样同一单元内后续的写不需要再cow，
+    // 减少快照期间写放大的次数(每次cow需要同步写快照数据和快照metapage)
+    uint32_t pagesPerUnit = cowUnitSize_ / pageSize_;
+    uint32_t pageBeginIndex = offset / cowUnitSize_ * pagesPerUnit;
+    uint32_t pageEndIndex =
+        ((offset + length - 1) / cowUnitSize_ + 1) * pagesPerUnit - 1;
+    uint32_t lastPageIndex = size_ / pageSize_ - 1;
+    if (pageEndIndex > lastPageIndex) {
+        pageEndIndex = lastPageIndex;
+    }
     // 获取快照文件中未被拷贝过的区域
-    uint32_t pageBeginIndex = offset / pageSize_;
-    uint32_t pageEndIndex = (offset + length - 1) / pageSize_;
     std::vector<BitRange> uncopiedRange;
     std::shared_ptr<const Bitmap> snapBitmap = snapshot_->GetPageStatus();
     snapBitmap->Divide(pageBeginIndex,
@@ -842,39 +952,28 @@ CSErrorCode CSChunkFile::copy2Snapshot(off_t offset, size_t length) {
 }
 
 CSErrorCode CSChunkFile::flush() {
-    ChunkFileMetaPage tempMeta = metaPage_;
-    bool needUpdateMeta = dirtyPages_.size() > 0;
-    bool clearClone = false;
-    for (auto pageIndex : dirtyPages_) {
-        tempMeta.bitmap->Set(pageIndex);
+    if (!isCloneChunk_
+        || metaPage_.bitmap->NextClearBit(0) != Bitmap::NO_POS) {
+        return CSErrorCode::Success;
     }
-    if (isCloneChunk_) {
-        // 如果所有的page都被写过,将Chunk标记为非clone chunk
-        if (tempMeta.bitmap->NextClearBit(0) == Bitmap::NO_POS) {
-            tempMeta.location = "";
-            tempMeta.bitmap = nullptr;
-            needUpdateMeta = true;
-            clearClone = true;
-        }
+    // 所有的page都被写过,将Chunk标记为非clone chunk
+    ChunkFileMetaPage tempMeta = metaPage_;
+    tempMeta.location = "";
+    tempMeta.bitmap = nullptr;
+    CSErrorCode errorCode = updateMetaPage(&tempMeta);
+    if (errorCode != CSErrorCode::Success) {
+        LOG(ERROR) << "Update metapage failed."
+                    << "ChunkID: " << chunkId_
+                    << ",chunk sn: " << metaPage_.sn;
+        return errorCode;
     }
-    if (needUpdateMeta) {
-        CSErrorCode errorCode = updateMetaPage(&tempMeta);
-        if (errorCode != CSErrorCode::Success) {
-            LOG(ERROR) << "Update metapage failed."
-                        << "ChunkID: " << chunkId_
-                        << ",chunk sn: " << metaPage_.sn;
-            return errorCode;
-        }
-        metaPage_.bitmap = tempMeta.bitmap;
-        metaPage_.location = tempMeta.location;
-        dirtyPages_.clear();
-        if (clearClone) {
-            if (metric_ != nullptr) {
-                metric_->cloneChunkCount << -1;
-            }
-            isCloneChunk_ = false;
-        }
+    metaPage_.bitmap = tempMeta.bitmap;
+    metaPage_.location = tempMeta.location;
+    bitmapDirty_ = false;
+    if (metric_ != nullptr) {
+        metric_->cloneChunkCount << -1;
     }
+    isCloneChunk_ = false;
     return CSErrorCode::Success;
 }
 
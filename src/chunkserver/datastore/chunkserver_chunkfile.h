@@ -34,10 +34,12 @@
 #include "include/curve_compiler_specific.h"
 #include "include/chunkserver/chunkserver_common.h"
 #include "src/common/concurrent/rw_lock.h"
+#include "src/common/concurrent/range_lock.h"
 #include "src/common/crc32.h"
 #include "src/fs/local_filesystem.h"
 #include "src/chunkserver/datastore/filename_operator.h"
 #include "src/chunkserver/datastore/chunkserver_snapshot.h"
+#include "src/chunkserver/datastore/chunkfile_fd_cache.h"
 #include "src/chunkserver/datastore/define.h"
 #include "src/chunkserver/datastore/file_pool.h"
 
@@ -48,6 +50,8 @@ using curve::fs::LocalFileSystem;
 using curve::common::RWLock;
 using curve::common::WriteLockGuard;
 using curve::common::ReadLockGuard;
+using curve::common::RangeLock;
+using curve::common::RangeLockGuard;
 using curve::common::BitRange;
 
 class FilePool;
@@ -101,8 +105,13 @@ struct ChunkOptions {
     ChunkSizeType   chunkSize;
     // page的大小，bitmap中每个bit表示1个page，metapage大小也是1个page
     PageSizeType    pageSize;
+    // 快照cow的粒度，第一次写某个page时会把它所在的整个cow单元拷贝到快照，
+    // 后续写同一单元内的其他page时不再cow，为0时按pageSize处理
+    uint32_t        cowUnitSize;
     // datastore内部统计指标
     std::shared_ptr<DataStoreMetric> metric;
+    // chunkserver共享的fd缓存，为nullptr时文件在整个生命周期内保持打开
+    std::shared_ptr<ChunkFdCache> fdCache;
 
     ChunkOptions() : id(0)
                    , sn(0)
@@ -111,7 +120,9 @@ struct ChunkOptions {
                    , location("")
                    , chunkSize(0)
                    , pageSize(0)
-                   , metric(nullptr) {}
+                   , cowUnitSize(0)
+                   , metric(nullptr)
+                   , fdCache(nullptr) {}
 };
 
 class CSChunkFile {
@@ -139,7 +150,9 @@ class CSChunkFile {
     /**
      * 写chunk文件
      * Write接口为raft apply时调用，Write之间不存多并发，
-     * 但可能与其他Read、Delete等操作存在并发，加写锁
+     * 但可能与其他Read、Delete等操作存在并发
+     * 只写数据时对写入的page区间加互斥区间锁，
+     * 需要修改metapage、快照或bitmap时对整个chunk加区间锁和写锁
      * @param sn: 当前写请求的文件版本号
      * @param buf: 请求写入的数据
      * @param offset: 请求写入的偏移位置
@@ -155,7 +168,7 @@ class CSChunkFile {
     /**
      * 将拷贝的数据写入Chunk中
      * 只会写入未写过的区域，不会覆盖已经写过的区域
-     * 可能存在并发，加写锁
+     * 可能存在并发，对整个chunk加区间锁和写锁
      * @param buf: 请求Paste的数据
      * @param offset: 请求Paste的数据起始偏移
      * @param length: 请求Paste的数据长度
@@ -164,7 +177,7 @@ class CSChunkFile {
     CSErrorCode Paste(const char * buf, off_t offset, size_t length);
     /**
      * 读chunk文件
-     * 可能存在并发，加读锁
+     * 可能存在并发，对读取的page区间加共享区间锁，并加读锁
      * @param buf: 读到的数据
      * @param offset: 请求读取的数据起始偏移
      * @param length: 请求读取的数据长度
@@ -173,7 +186,7 @@ class CSChunkFile {
     CSErrorCode Read(char * buf, off_t offset, size_t length);
     /**
      * 读指定版本的chunk
-     * 可能存在并发，加读锁
+     * 可能存在并发，对读取的page区间加共享区间锁，并加读锁
      * @param sn: 指定的chunk的数据
      * @param buf: 读到的快照数据
      * @param offset: 请求读取的快照数据起始偏移
@@ -186,7 +199,7 @@ class CSChunkFile {
                                    size_t length);
     /**
      * 删除chunk文件
-     * 正常不存在并发，与其他操作互斥，加写锁
+     * 正常不存在并发，与其他操作互斥，对整个chunk加区间锁和写锁
      * @param: 调用DeleteChunk接口时的文件版本号
      * @return: 返回错误码
      */
@@ -194,7 +207,7 @@ class CSChunkFile {
     /**
      * 删除此次转储时产生的或者历史遗留的快照
      * 如果转储过程中没有产生快照，则修改chunk的correctedSn
-     * 正常不存在并发，与其他操作互斥，加写锁
+     * 正常不存在并发，与其他操作互斥，对整个chunk加区间锁和写锁
      * @param correctedSn:chunk需要修正的版本号，本质上是快照后文件的版本号
      * chunk不存在快照时修正为此参数值
      * @return: 返回错误码
@@ -204,6 +217,25 @@ class CSChunkFile {
      * 调用fsync将snapshot文件在pagecache中的数据刷盘
      */
     void GetInfo(CSChunkInfo* info);
+    /**
+     * 获取chunk当前快照的版本号，不存在快照时返回0
+     * 与GetInfo不同，不会拷贝clone chunk的bitmap
+     */
+    SequenceNum GetSnapshotSn();
+    /**
+     * 将clone chunk内存中尚未持久化的bitmap写入metapage
+     * 在raft打快照时调用，快照之前的写请求对应的日志可能会被删除，
+     * 需要保证它们标记的page已经持久化；与其他操作互斥，加写锁
+     * @return: 返回错误码
+     */
+    CSErrorCode SyncMetaPage();
+    /**
+     * bitmap是否有还未持久化的修改，不加锁，
+     * 只用于挑选需要调用SyncMetaPage的chunk
+     */
+    bool IsMetaPageDirty() const {
+        return bitmapDirty_.load(std::memory_order_acquire);
+    }
     /**
      * 获取chunk的hash值，此接口一般用于测试调用
      * @param[out]: chunk hash值
@@ -226,6 +258,20 @@ class CSChunkFile {
      * @return: true 表示要cow；false 表示不需要cow
      */
     bool needCow(SequenceNum sn);
+    /**
+     * 判断写请求是否需要修改chunk的元数据，包括拒绝过期请求、创建快照、
+     * 更新metapage、cow以及更新clone chunk的bitmap
+     * 不需要时只写数据，可以与其他不重叠区域的读写并发
+     * @param sn:写请求的版本号
+     * @return: true 表示需要在写锁下处理；false 表示只需要写数据
+     */
+    bool needUpdateMeta(SequenceNum sn);
+    /**
+     * chunk最后一个page的索引，对[0, lastPageIndex()]加区间锁即锁住整个chunk
+     */
+    uint64_t lastPageIndex() const {
+        return size_ / pageSize_ - 1;
+    }
     /**
      * 将metapage持久化
      * @param metaPage:需要持久化到磁盘的metapage,
@@ -238,15 +284,15 @@ class CSChunkFile {
      */
     CSErrorCode loadMetaPage();
     /**
-     * 将指定区域中未拷贝过的数据从chunk文件拷贝到快照文件
+     * 将指定区域所在的cow单元中未拷贝过的数据从chunk文件拷贝到快照文件
      * @param offset: 写入数据区域的起始偏移
      * @param length: 写入数据区域的长度
      * @return: 返回错误码
      */
     CSErrorCode copy2Snapshot(off_t offset, size_t length);
     /**
-     * 更新clone chunk的bitmap
-     * 如果所有的page都已写过，则将clone chunk转成普通chunk
+     * 如果clone chunk所有的page都已写过，则将clone chunk转成普通chunk
+     * 并立即持久化metapage；其他情况bitmap的修改延迟到SyncMetaPage时持久化
      */
     CSErrorCode flush();
 
@@ -259,56 +305,93 @@ class CSChunkFile {
         return pageSize_ + size_;
     }
 
+    // 打开chunk文件，fd被缓存淘汰后也通过它重新打开
+    inline int openFile() {
+        return lfs_->Open(path(), O_RDWR|O_NOATIME|O_DSYNC);
+    }
+
     inline int readMetaPage(char* buf) {
-        return lfs_->Read(fd_, buf, 0, pageSize_);
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        if (fd.Get() < 0) {
+            return fd.Get();
+        }
+        return lfs_->Read(fd.Get(), buf, 0, pageSize_);
     }
 
     inline int writeMetaPage(const char* buf) {
-        return lfs_->Write(fd_, buf, 0, pageSize_);
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        if (fd.Get() < 0) {
+            return fd.Get();
+        }
+        return lfs_->Write(fd.Get(), buf, 0, pageSize_);
     }
 
     inline int readData(char* buf, off_t offset, size_t length) {
-        return lfs_->Read(fd_, buf, offset + pageSize_, length);
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        if (fd.Get() < 0) {
+            return fd.Get();
+        }
+        return lfs_->Read(fd.Get(), buf, offset + pageSize_, length);
     }
 
     inline int writeData(const char* buf, off_t offset, size_t length) {
-        int rc = lfs_->Write(fd_, buf, offset + pageSize_, length);
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        if (fd.Get() < 0) {
+            return fd.Get();
+        }
+        int rc = lfs_->Write(fd.Get(), buf, offset + pageSize_, length);
         if (rc < 0) {
             return rc;
         }
-        // 如果是clone chunk，需要判断是否需要更改bitmap并更新metapage
+        // 如果是clone chunk，需要在内存的bitmap中标记写过的page
         if (isCloneChunk_) {
-            uint32_t beginIndex = offset / pageSize_;
-            uint32_t endIndex = (offset + length - 1) / pageSize_;
-            for (uint32_t i = beginIndex; i <= endIndex; ++i) {
-                // 记录dirty page
-                if (!metaPage_.bitmap->Test(i)) {
-                    dirtyPages_.insert(i);
-                }
-            }
+            markPages(offset, length);
         }
         return rc;
     }
 
     inline int writeData(const butil::IOBuf& buf, off_t offset, size_t length) {
-        int rc = lfs_->Write(fd_, buf, offset + pageSize_, length);
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        if (fd.Get() < 0) {
+            return fd.Get();
+        }
+        int rc = lfs_->Write(fd.Get(), buf, offset + pageSize_, length);
         if (rc < 0) {
             return rc;
         }
-        // 如果是clone chunk，需要判断是否需要更改bitmap并更新metapage
+        // 如果是clone chunk，需要在内存的bitmap中标记写过的page
         if (isCloneChunk_) {
-            uint32_t beginIndex = offset / pageSize_;
-            uint32_t endIndex = (offset + length - 1) / pageSize_;
-            for (uint32_t i = beginIndex; i <= endIndex; ++i) {
-                // 记录dirty page
-                if (!metaPage_.bitmap->Test(i)) {
-                    dirtyPages_.insert(i);
-                }
-            }
+            markPages(offset, length);
         }
         return rc;
     }
 
+    /**
+     * 在clone chunk的bitmap中标记写过的page，只修改内存
+     * 写请求都经过raft日志，重启后日志回放会重新标记，
+     * 因此bitmap只在快照时或者metapage因其他原因更新时持久化
+     */
+    inline void markPages(off_t offset, size_t length) {
+        uint32_t beginIndex = offset / pageSize_;
+        uint32_t endIndex = (offset + length - 1) / pageSize_;
+        if (metaPage_.bitmap->NextClearBit(beginIndex, endIndex)
+            == Bitmap::NO_POS) {
+            return;
+        }
+        metaPage_.bitmap->Set(beginIndex, endIndex);
+        bitmapDirty_ = true;
+    }
+
     inline bool CheckOffsetAndLength(off_t offset, size_t len) {
         // 检查offset+len是否越界
         if (offset + len > size_) {
@@ -329,12 +412,14 @@ class CSChunkFile {
     }
 
  private:
-    // chunk文件的资源描述符
+    // chunk文件的资源描述符，开启fd缓存时由缓存管理，此处为-1
     int fd_;
     // chunk的逻辑大小，不包含metapage
     ChunkSizeType size_;
     // 最小原子读写单元
     PageSizeType pageSize_;
+    // 快照cow的粒度，为pageSize_的整数倍
+    uint32_t cowUnitSize_;
     // chunk id
     ChunkID chunkId_;
     // chunk所在目录
@@ -343,10 +428,14 @@ class CSChunkFile {
     bool isCloneChunk_;
     // chunk的metapage
     ChunkFileMetaPage metaPage_;
-    // 被写过但还未更新到metapage中的page索引
-    std::set<uint32_t> dirtyPages_;
-    // 读写锁
+    // clone chunk的bitmap是否有还未持久化到metapage中的修改
+    std::atomic<bool> bitmapDirty_;
+    // 读写锁，保护metapage、快照等chunk级别的状态
+    // 读请求加读锁，修改这些状态的请求加写锁
     RWLock rwLock_;
+    // page区间锁，保证重叠区域的读写互斥，须先于rwLock_获取。
+    // 修改chunk级别状态的请求锁住整个chunk，只写数据的请求只需区间锁
+    RangeLock rangeLock_;
     // 快照文件指针
     CSSnapshot* snapshot_;
     // 依赖FilePool创建删除文件
@@ -355,6 +444,8 @@ class CSChunkFile {
     std::shared_ptr<LocalFileSystem> lfs_;
     // datastore内部统计指标
     std::shared_ptr<DataStoreMetric> metric_;
+    // fd缓存，删除chunk后置为nullptr，不再重新打开文件
+    std::shared_ptr<ChunkFdCache> fdCache_;
 };
 }  // namespace chunkserver
 }  // namespace curve
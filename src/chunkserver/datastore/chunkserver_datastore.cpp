@@ -26,6 +26,8 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "src/chunkserver/datastore/chunkserver_datastore.h"
 #include "src/chunkserver/datastore/filename_operator.h"
@@ -41,8 +43,10 @@ CSDataStore::CSDataStore(std::shared_ptr<LocalFileSystem> lfs,
       pageSize_(options.pageSize),
       baseDir_(options.baseDir),
       locationLimit_(options.locationLimit),
+      cowUnitSize_(options.cowUnitSize),
       chunkFilePool_(chunkFilePool),
-      lfs_(lfs) {
+      lfs_(lfs),
+      fdCache_(options.fdCache) {
     CHECK(!baseDir_.empty()) << "Create datastore failed";
     CHECK(lfs_ != nullptr) << "Create datastore failed";
     CHECK(chunkFilePool_ != nullptr) << "Create datastore failed";
@@ -230,7 +234,9 @@ CSErrorCode CSDataStore::WriteChunk(ChunkID id,
         options.chunkSize = chunkSize_;
         options.location = cloneSourceLocation;
         options.pageSize = pageSize_;
+        options.cowUnitSize = cowUnitSize_;
         options.metric = metric_;
+        options.fdCache = fdCache_;
         CSErrorCode errorCode = CreateChunkFile(options, &chunkFile);
         if (errorCode != CSErrorCode::Success) {
             return errorCode;
@@ -278,7 +284,9 @@ CSErrorCode CSDataStore::CreateCloneChunk(ChunkID id,
         options.baseDir = baseDir_;
         options.chunkSize = chunkSize_;
         options.pageSize = pageSize_;
+        options.cowUnitSize = cowUnitSize_;
         options.metric = metric_;
+        options.fdCache = fdCache_;
         CSErrorCode errorCode = CreateChunkFile(options, &chunkFile);
         if (errorCode != CSErrorCode::Success) {
             return errorCode;
@@ -349,6 +357,53 @@ CSErrorCode CSDataStore::GetChunkHash(ChunkID id,
     return chunkFile->GetHash(offset, length, hash);
 }
 
+CSErrorCode CSDataStore::SyncMetaPages() {
+    // 只有bitmap有未持久化修改的clone chunk需要写盘；持有分片读锁时只挑出
+    // 这些chunk，释放锁之后再写盘，避免写盘期间阻塞创建和删除chunk
+    std::vector<std::pair<ChunkID, CSChunkFilePtr>> dirtyChunks;
+    metaCache_.ForEach([&dirtyChunks](ChunkID id,
+                                      const CSChunkFilePtr& chunkFile) {
+        if (chunkFile->IsMetaPageDirty()) {
+            dirtyChunks.emplace_back(id, chunkFile);
+        }
+        return true;
+    });
+
+    for (const auto& dirtyChunk : dirtyChunks) {
+        CSErrorCode errorCode = dirtyChunk.second->SyncMetaPage();
+        if (errorCode != CSErrorCode::Success) {
+            LOG(ERROR) << "Sync chunk metapage failed."
+                       << "ChunkID = " << dirtyChunk.first;
+            return errorCode;
+        }
+    }
+    return CSErrorCode::Success;
+}
+
+void CSDataStore::ListChunkFiles(std::vector<std::string>* chunkFiles,
+                                 std::vector<std::string>* snapFiles) {
+    auto listFunc = [chunkFiles, snapFiles](ChunkID id,
+                                            const CSChunkFilePtr& chunkFile) {
+        if (chunkFiles != nullptr) {
+            chunkFiles->emplace_back(
+                FileNameOperator::GenerateChunkFileName(id));
+        }
+        if (snapFiles != nullptr) {
+            SequenceNum snapSn = chunkFile->GetSnapshotSn();
+            if (snapSn > 0) {
+                snapFiles->emplace_back(
+                    FileNameOperator::GenerateSnapshotName(id, snapSn));
+            }
+        }
+        return true;
+    };
+    metaCache_.ForEach(listFunc);
+}
+
+uint64_t CSDataStore::GetManifestVersion() {
+    return metaCache_.GetVersion();
+}
+
 DataStoreStatus CSDataStore::GetStatus() {
     DataStoreStatus status;
     status.chunkFileCount = metric_->chunkFileCount.get_value();
@@ -366,7 +421,9 @@ CSErrorCode CSDataStore::loadChunkFile(ChunkID id) {
         options.baseDir = baseDir_;
         options.chunkSize = chunkSize_;
         options.pageSize = pageSize_;
+        options.cowUnitSize = cowUnitSize_;
         options.metric = metric_;
+        options.fdCache = fdCache_;
         CSChunkFilePtr chunkFilePtr =
             std::make_shared<CSChunkFile>(lfs_,
                                           chunkFilePool_,
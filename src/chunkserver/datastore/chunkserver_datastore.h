@@ -26,6 +26,7 @@
 #include <bvar/bvar.h>
 #include <glog/logging.h>
 #include <butil/iobuf.h>
+#include <atomic>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -37,6 +38,7 @@
 #include "src/common/concurrent/concurrent.h"
 #include "src/chunkserver/datastore/define.h"
 #include "src/chunkserver/datastore/chunkserver_chunkfile.h"
+#include "src/chunkserver/datastore/chunkfile_fd_cache.h"
 #include "src/chunkserver/datastore/file_pool.h"
 #include "src/fs/local_filesystem.h"
 
@@ -59,6 +61,10 @@ struct DataStoreOptions {
     ChunkSizeType                       chunkSize;
     PageSizeType                        pageSize;
     uint32_t                            locationLimit;
+    // 快照cow的粒度，必须是pageSize的整数倍，为0时按pageSize处理
+    uint32_t                            cowUnitSize = 0;
+    // chunkserver上所有datastore共享的fd缓存，为nullptr时不限制打开的文件数
+    std::shared_ptr<ChunkFdCache>       fdCache;
 };
 
 /**
@@ -90,49 +96,104 @@ struct DataStoreMetric {
 using DataStoreMetricPtr = std::shared_ptr<DataStoreMetric>;
 
 using ChunkMap = std::unordered_map<ChunkID, CSChunkFilePtr>;
-// 为chunkid到chunkfile的映射，使用读写锁对map的操作进行保护
+// 为chunkid到chunkfile的映射，按chunkid分片，每个分片使用读写锁保护
 class CSMetaCache {
  public:
-    CSMetaCache() {}
-    virtual ~CSMetaCache() {}
+    static const uint32_t kDefaultShardNum = 32;
 
-    ChunkMap GetMap() {
-        ReadLockGuard readGuard(rwLock_);
-        return chunkMap_;
-    }
+    explicit CSMetaCache(uint32_t shardNum = kDefaultShardNum)
+        : shardNum_(shardNum == 0 ? 1 : shardNum),
+          shards_(new Shard[shardNum_]),
+          version_(0) {}
+    virtual ~CSMetaCache() {}
 
     CSChunkFilePtr Get(ChunkID id) {
-        ReadLockGuard readGuard(rwLock_);
-        if (chunkMap_.find(id) == chunkMap_.end()) {
+        Shard& shard = GetShard(id);
+        ReadLockGuard readGuard(shard.rwLock);
+        auto iter = shard.chunkMap.find(id);
+        if (iter == shard.chunkMap.end()) {
             return nullptr;
         }
-        return chunkMap_[id];
+        return iter->second;
     }
 
     CSChunkFilePtr Set(ChunkID id, CSChunkFilePtr chunkFile) {
-        WriteLockGuard writeGuard(rwLock_);
+        Shard& shard = GetShard(id);
+        WriteLockGuard writeGuard(shard.rwLock);
         // 当两个写请求并发去创建chunk文件时，返回先Set的chunkFile
-        if (chunkMap_.find(id) == chunkMap_.end()) {
-            chunkMap_[id] = chunkFile;
+        auto ret = shard.chunkMap.emplace(id, chunkFile);
+        if (ret.second) {
+            version_.fetch_add(1, std::memory_order_relaxed);
         }
-        return chunkMap_[id];
+        return ret.first->second;
     }
 
     void Remove(ChunkID id) {
-        WriteLockGuard writeGuard(rwLock_);
-        if (chunkMap_.find(id) != chunkMap_.end()) {
-            chunkMap_.erase(id);
+        Shard& shard = GetShard(id);
+        WriteLockGuard writeGuard(shard.rwLock);
+        if (shard.chunkMap.erase(id) > 0) {
+            version_.fetch_add(1, std::memory_order_relaxed);
         }
     }
 
     void Clear() {
-        WriteLockGuard writeGuard(rwLock_);
-        chunkMap_.clear();
+        for (uint32_t i = 0; i < shardNum_; ++i) {
+            WriteLockGuard writeGuard(shards_[i].rwLock);
+            shards_[i].chunkMap.clear();
+        }
+        version_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t Size() {
+        uint64_t size = 0;
+        for (uint32_t i = 0; i < shardNum_; ++i) {
+            ReadLockGuard readGuard(shards_[i].rwLock);
+            size += shards_[i].chunkMap.size();
+        }
+        return size;
+    }
+
+    /**
+     * 获取chunk集合的版本号，每次增加或删除chunk时加1
+     * 版本号没有变化时，metacache中的chunk集合也没有变化
+     */
+    uint64_t GetVersion() const {
+        return version_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * 逐个分片遍历所有chunk，不拷贝map
+     * 遍历某个分片时持有该分片的读锁，func中不能再修改metacache
+     * @param func: 对每个chunk调用func(id, chunkFile)，返回false时停止遍历
+     * @return: 遍历完所有chunk返回true，被func中止返回false
+     */
+    template <typename Func>
+    bool ForEach(const Func& func) {
+        for (uint32_t i = 0; i < shardNum_; ++i) {
+            ReadLockGuard readGuard(shards_[i].rwLock);
+            for (auto& iter : shards_[i].chunkMap) {
+                if (!func(iter.first, iter.second)) {
+                    return false;
+                }
+            }
+        }
+        return true;
     }
 
  private:
-    RWLock      rwLock_;
-    ChunkMap    chunkMap_;
+    struct Shard {
+        RWLock      rwLock;
+        ChunkMap    chunkMap;
+    };
+
+    Shard& GetShard(ChunkID id) {
+        return shards_[id % shardNum_];
+    }
+
+ private:
+    uint32_t                    shardNum_;
+    std::unique_ptr<Shard[]>    shards_;
+    std::atomic<uint64_t>       version_;
 };
 
 class CSDataStore {
@@ -272,6 +333,26 @@ class CSDataStore {
                                      off_t offset,
                                      size_t length,
                                      std::string* hash);
+    /**
+     * 将所有clone chunk中延迟持久化的bitmap写入metapage
+     * raft打快照时调用，之后快照点之前的日志可以被安全删除
+     * @return: 返回错误码
+     */
+    virtual CSErrorCode SyncMetaPages();
+    /**
+     * 从内存中的chunk清单获取chunk文件名和快照文件名，不访问磁盘
+     * 清单即metacache，在chunk文件创建、删除以及datastore加载时更新
+     * raft打快照和下载快照时用来代替list数据目录
+     * @param chunkFiles[out]: chunk文件名，为nullptr时不获取
+     * @param snapFiles[out]: 快照文件名，为nullptr时不获取
+     */
+    virtual void ListChunkFiles(std::vector<std::string>* chunkFiles,
+                                std::vector<std::string>* snapFiles);
+    /**
+     * 获取chunk清单的版本号，chunk文件每次创建或删除时增加
+     * 版本号不变时ListChunkFiles返回的chunk文件列表也不变
+     */
+    virtual uint64_t GetManifestVersion();
     /** 获取DataStore的内部统计信息
      * @return：datastore的内部统计信息
      */
@@ -289,6 +370,8 @@ class CSDataStore {
     PageSizeType pageSize_;
     // clone chunk location长度限制
     uint32_t locationLimit_;
+    // 快照cow的粒度
+    uint32_t cowUnitSize_;
     // datastore的管理目录
     std::string baseDir_;
     // 为chunkid->chunkfile的映射
@@ -299,6 +382,8 @@ class CSDataStore {
     std::shared_ptr<LocalFileSystem>        lfs_;
     // datastore的内部统计信息
     DataStoreMetricPtr metric_;
+    // chunkserver共享的fd缓存
+    std::shared_ptr<ChunkFdCache> fdCache_;
 };
 
 }  // namespace chunkserver
@@ -114,7 +114,8 @@ CSSnapshot::CSSnapshot(std::shared_ptr<LocalFileSystem> lfs,
       baseDir_(options.baseDir),
       lfs_(lfs),
       chunkFilePool_(chunkFilePool),
-      metric_(options.metric) {
+      metric_(options.metric),
+      fdCache_(options.fdCache) {
     CHECK(!baseDir_.empty()) << "Create snapshot failed";
     CHECK(lfs_ != nullptr) << "Create snapshot failed";
     uint32_t bits = size_ / pageSize_;
@@ -126,6 +127,9 @@ CSSnapshot::CSSnapshot(std::shared_ptr<LocalFileSystem> lfs,
 }
 
 CSSnapshot::~CSSnapshot() {
+    if (fdCache_ != nullptr) {
+        fdCache_->Erase(this);
+    }
     if (fd_ >= 0) {
         lfs_->Close(fd_);
     }
@@ -153,15 +157,24 @@ CSErrorCode CSSnapshot::Open(bool createFile) {
             return CSErrorCode::InternalError;
         }
     }
-    int rc = lfs_->Open(snapshotPath, O_RDWR|O_NOATIME|O_DSYNC);
+    int rc = openFile();
     if (rc < 0) {
         LOG(ERROR) << "Error occured when opening file."
                    << " filepath = "<< snapshotPath;
         return CSErrorCode::InternalError;
     }
-    fd_ = rc;
+    if (fdCache_ != nullptr) {
+        fdCache_->Insert(this, rc);
+    } else {
+        fd_ = rc;
+    }
     struct stat fileInfo;
-    rc = lfs_->Fstat(fd_, &fileInfo);
+    {
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        rc = fd.Get() < 0 ? fd.Get() : lfs_->Fstat(fd.Get(), &fileInfo);
+    }
     if (rc < 0) {
         LOG(ERROR) << "Error occured when stating file."
                    << " filepath = " << snapshotPath;
@@ -188,6 +201,10 @@ CSErrorCode CSSnapshot::Read(char * buf, off_t offset, size_t length) {
 }
 
 CSErrorCode CSSnapshot::Delete() {
+    if (fdCache_ != nullptr) {
+        fdCache_->Erase(this);
+        fdCache_ = nullptr;
+    }
     if (fd_ >= 0) {
         lfs_->Close(fd_);
         fd_ = -1;
@@ -32,6 +32,7 @@
 #include "src/common/crc32.h"
 #include "src/chunkserver/datastore/filename_operator.h"
 #include "src/chunkserver/datastore/define.h"
+#include "src/chunkserver/datastore/chunkfile_fd_cache.h"
 #include "src/fs/local_filesystem.h"
 #include "src/chunkserver/datastore/file_pool.h"
 
@@ -148,24 +149,53 @@ class CSSnapshot {
         return pageSize_ + size_;
     }
 
+    // 打开快照文件，fd被缓存淘汰后也通过它重新打开
+    inline int openFile() {
+        return lfs_->Open(path(), O_RDWR|O_NOATIME|O_DSYNC);
+    }
+
     inline int readMetaPage(char* buf) {
-        return lfs_->Read(fd_, buf, 0, pageSize_);
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        if (fd.Get() < 0) {
+            return fd.Get();
+        }
+        return lfs_->Read(fd.Get(), buf, 0, pageSize_);
     }
 
     inline int writeMetaPage(const char* buf) {
-        return lfs_->Write(fd_, buf, 0, pageSize_);
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        if (fd.Get() < 0) {
+            return fd.Get();
+        }
+        return lfs_->Write(fd.Get(), buf, 0, pageSize_);
     }
 
     inline int readData(char* buf, off_t offset, size_t length) {
-        return lfs_->Read(fd_, buf, offset + pageSize_, length);
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        if (fd.Get() < 0) {
+            return fd.Get();
+        }
+        return lfs_->Read(fd.Get(), buf, offset + pageSize_, length);
     }
 
     inline int writeData(const char* buf, off_t offset, size_t length) {
-        return lfs_->Write(fd_, buf, offset + pageSize_, length);
+        ChunkFdGuard fd(fdCache_.get(), this, fd_, [this] {
+            return openFile();
+        });
+        if (fd.Get() < 0) {
+            return fd.Get();
+        }
+        return lfs_->Write(fd.Get(), buf, offset + pageSize_, length);
     }
 
  private:
-    // 快照文件资源描述符
+    // 快照文件资源描述符，开启fd缓存时由缓存管理，此处为-1
     int fd_;
     // 快照所属chunk的id
     ChunkID chunkId_;
@@ -185,6 +215,8 @@ class CSSnapshot {
     std::shared_ptr<FilePool> chunkFilePool_;
     // datastore内部统计指标
     std::shared_ptr<DataStoreMetric> metric_;
+    // fd缓存，删除快照后置为nullptr
+    std::shared_ptr<ChunkFdCache> fdCache_;
 };
 
 }  // namespace chunkserver
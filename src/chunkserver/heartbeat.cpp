@@ -40,6 +40,21 @@ using curve::fs::FileSystemInfo;
 
 namespace curve {
 namespace chunkserver {
+
+namespace {
+
+// 增量心跳用于比较的copyset信息: leader、epoch、成员和配置变更,
+// 统计信息每次心跳都会变, 不参与比较, 随全量心跳更新到mds
+std::string CopysetReportKey(const curve::mds::heartbeat::CopySetInfo &info) {
+    curve::mds::heartbeat::CopySetInfo key(info);
+    key.clear_stats();
+    std::string out;
+    key.SerializeToString(&out);
+    return out;
+}
+
+}  // namespace
+
 TaskStatus Heartbeat::PurgeCopyset(LogicPoolID poolId, CopysetID copysetId) {
     if (!copysetMan_->PurgeCopysetNodeData(poolId, copysetId)) {
         LOG(ERROR) << "Failed to clean copyset "
@@ -92,6 +107,16 @@ int Heartbeat::Init(const HeartbeatOptions &options) {
 
     // 获取当前unix时间戳
     startUpTime_ = ::curve::common::TimeUtility::GetTimeofDaySec();
+
+    // 首次心跳上报全量信息
+    sequence_ = 0;
+    ackedSequence_ = 0;
+    needFullReport_ = true;
+    beatsSinceFullReport_ = 0;
+    reportedCopysets_.clear();
+    pendingCopysets_.clear();
+    requestBytes_.expose_as("chunkserver_heartbeat", "request_bytes");
+    deltaCount_.expose_as("chunkserver_heartbeat", "delta_count");
     return 0;
 }
 
@@ -279,9 +304,71 @@ int Heartbeat::BuildRequest(HeartbeatRequest* req) {
     }
     req->set_leadercount(leaders);
 
+    BuildDeltaRequest(req);
+    requestBytes_ << req->ByteSize();
+
     return 0;
 }
 
+void Heartbeat::BuildDeltaRequest(HeartbeatRequest* req) {
+    pendingCopysets_.clear();
+    for (const auto& info : req->copysetinfos()) {
+        pendingCopysets_[ToGroupNid(info.logicalpoolid(), info.copysetid())]
+            = CopysetReportKey(info);
+    }
+    req->set_sequence(++sequence_);
+
+    bool fullReport = needFullReport_
+        || options_.fullReportInterval <= 1
+        || beatsSinceFullReport_ + 1 >= options_.fullReportInterval;
+    if (fullReport) {
+        return;
+    }
+
+    // 只保留相对mds已确认信息有变化的copyset(leader, epoch, 成员,
+    // 配置变更任一发生变化), 统计信息只随全量心跳上报
+    google::protobuf::RepeatedPtrField<curve::mds::heartbeat::CopySetInfo>
+        changed;
+    for (auto& info : *req->mutable_copysetinfos()) {
+        GroupNid nid = ToGroupNid(info.logicalpoolid(), info.copysetid());
+        auto it = reportedCopysets_.find(nid);
+        if (it == reportedCopysets_.end() ||
+            it->second != pendingCopysets_[nid]) {
+            changed.Add()->Swap(&info);
+        }
+    }
+    req->mutable_copysetinfos()->Swap(&changed);
+
+    for (const auto& item : reportedCopysets_) {
+        if (pendingCopysets_.count(item.first) == 0) {
+            auto key = req->add_removedcopysets();
+            key->set_logicalpoolid(GetPoolID(item.first));
+            key->set_copysetid(GetCopysetID(item.first));
+        }
+    }
+    req->set_basesequence(ackedSequence_);
+    deltaCount_ << 1;
+}
+
+void Heartbeat::UpdateReportBase(const HeartbeatRequest& request,
+                                 const HeartbeatResponse* response) {
+    // 心跳发送失败时mds可能已经切换, 下次上报全量信息
+    if (response == nullptr || response->needfullreport()) {
+        needFullReport_ = true;
+        return;
+    }
+
+    reportedCopysets_.swap(pendingCopysets_);
+    pendingCopysets_.clear();
+    ackedSequence_ = request.sequence();
+    needFullReport_ = false;
+    if (request.has_basesequence()) {
+        ++beatsSinceFullReport_;
+    } else {
+        beatsSinceFullReport_ = 0;
+    }
+}
+
 void Heartbeat::DumpHeartbeatRequest(const HeartbeatRequest& request) {
     DVLOG(6) << "Heartbeat request: Chunkserver ID: "
              << request.chunkserverid()
@@ -517,6 +604,7 @@ void Heartbeat::HeartbeatWorker() {
 
         LOG(INFO) << "sending heartbeat info";
         ret = SendHeartbeat(req, &resp);
+        UpdateReportBase(req, ret == 0 ? &resp : nullptr);
         if (ret != 0) {
             LOG(WARNING) << "Failed to send heartbeat to MDS";
             ::sleep(errorIntervalSec);
@@ -26,8 +26,10 @@
 
 #include <braft/node_manager.h>
 #include <braft/node.h>                  // NodeImpl
+#include <bvar/bvar.h>
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <atomic>
@@ -70,6 +72,9 @@ struct HeartbeatOptions {
     uint32_t                port;
     uint32_t                intervalSec;
     uint32_t                timeout;
+    // 每隔多少次心跳上报一次全量copyset信息, 其余心跳只上报有变化的copyset
+    // 为0或1时每次都上报全量信息
+    uint32_t                fullReportInterval;
     CopysetNodeManager*     copysetNodeManager;
 
     std::shared_ptr<LocalFileSystem> fs;
@@ -80,7 +85,8 @@ struct HeartbeatOptions {
  */
 class Heartbeat {
  public:
-    Heartbeat() {}
+    Heartbeat() : sequence_(0), ackedSequence_(0), needFullReport_(true),
+                  beatsSinceFullReport_(0) {}
     ~Heartbeat() {}
 
     /**
@@ -130,6 +136,17 @@ class Heartbeat {
      */
     int BuildRequest(HeartbeatRequest* request);
 
+    /*
+     * 把全量心跳请求裁剪为相对上一次mds确认的心跳的增量请求
+     */
+    void BuildDeltaRequest(HeartbeatRequest* request);
+
+    /*
+     * 根据心跳发送结果更新增量心跳的基准
+     */
+    void UpdateReportBase(const HeartbeatRequest& request,
+                          const HeartbeatResponse* response);
+
     /*
      * 发送心跳消息
      */
@@ -186,6 +203,30 @@ class Heartbeat {
 
     // 模块初始化时间, unix时间
     uint64_t startUpTime_;
+
+    // 最近一次发送的心跳序号
+    uint64_t sequence_;
+
+    // 最近一次被mds确认的心跳序号, 增量心跳基于该序号
+    uint64_t ackedSequence_;
+
+    // 下一次心跳是否必须上报全量信息
+    bool needFullReport_;
+
+    // 距离上一次全量心跳的心跳次数
+    uint32_t beatsSinceFullReport_;
+
+    // 被mds确认的各copyset上报信息(去掉统计信息后序列化的CopySetInfo)
+    std::unordered_map<GroupNid, std::string> reportedCopysets_;
+
+    // 本次心跳中各copyset的上报信息, mds确认后成为reportedCopysets_
+    std::unordered_map<GroupNid, std::string> pendingCopysets_;
+
+    // 心跳请求序列化后的大小
+    bvar::IntRecorder requestBytes_;
+
+    // 增量心跳次数
+    bvar::Adder<uint64_t> deltaCount_;
 };
 
 }  // namespace chunkserver
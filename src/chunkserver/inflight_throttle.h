@@ -29,41 +29,115 @@
 namespace curve {
 namespace chunkserver {
 
+/**
+ * chunkserver上请求的QoS类别
+ */
+enum QosClass {
+    // client的读写等前台请求
+    QOS_CLASS_CLIENT = 0,
+    // 克隆相关的请求: CreateCloneChunk, RecoverChunk
+    QOS_CLASS_CLONE = 1,
+    // 快照相关的请求: ReadChunkSnapshot, DeleteChunkSnapshotOrCorrectSn
+    QOS_CLASS_SNAPSHOT = 2,
+    // 数据校验请求: GetChunkHash
+    QOS_CLASS_SCRUB = 3,
+    QOS_CLASS_NUM = 4,
+};
+
 /**
  * 负责控制最大inflight request数量
+ * 所有类别共享同一个inflight上限, 总数超过上限时任何请求都不能下发
+ * 每个QoS类别按权重分到一部分inflight配额, 在总数没有超过上限时:
+ * client请求总是可以下发, 可以使用其他类别空闲的配额;
+ * 后台请求没有超过自己的配额时可以下发, 超过配额时只能使用空闲的配额,
+ * 并且要给client留出它还没有用满的配额, 这样后台请求不会挤占前台请求
  */
 class InflightThrottle {
  public:
+    /**
+     * @param maxInflight 最大的inflight request数量
+     *
+     * 所有配额都分给client请求, 其他类别的请求只能使用空闲的配额
+     */
     explicit InflightThrottle(uint64_t maxInflight)
         : inflightRequestCount_(0),
-          kMaxInflightRequest_(maxInflight) { }
+          kMaxInflightRequest_(maxInflight) {
+        uint32_t weights[QOS_CLASS_NUM] = {1, 0, 0, 0};
+        InitQuota(weights);
+    }
+
+    /**
+     * @param maxInflight 最大的inflight request数量
+     * @param weights 各QoS类别的权重
+     */
+    InflightThrottle(uint64_t maxInflight,
+                     const uint32_t (&weights)[QOS_CLASS_NUM])
+        : inflightRequestCount_(0),
+          kMaxInflightRequest_(maxInflight) {
+        InitQuota(weights);
+    }
+
     virtual ~InflightThrottle() = default;
 
     /**
-     * @brief: 判断是否过载
+     * @brief: 判断是否过载, 调用前请求已经计入inflight数量
+     * @param qosClass: 请求的QoS类别
      * @return true，过载，false没有过载
      */
-    inline bool IsOverLoad() {
-        if (kMaxInflightRequest_ >=
-            inflightRequestCount_.load(std::memory_order_relaxed)) {
-            return false;
-        } else {
+    inline bool IsOverLoad(QosClass qosClass = QOS_CLASS_CLIENT) {
+        uint64_t total = inflightRequestCount_.load(std::memory_order_relaxed);
+        if (total > kMaxInflightRequest_) {
             return true;
         }
+        if (qosClass == QOS_CLASS_CLIENT ||
+            classQuota_[qosClass] >=
+            classCount_[qosClass].load(std::memory_order_relaxed)) {
+            return false;
+        }
+        uint64_t clientCount =
+            classCount_[QOS_CLASS_CLIENT].load(std::memory_order_relaxed);
+        uint64_t clientIdle = classQuota_[QOS_CLASS_CLIENT] > clientCount
+                              ? classQuota_[QOS_CLASS_CLIENT] - clientCount
+                              : 0;
+        return total + clientIdle > kMaxInflightRequest_;
+    }
+
+    /**
+     * @brief: inflight request计数加count, 批量请求按子请求个数计数
+     */
+    inline void Increment(QosClass qosClass = QOS_CLASS_CLIENT,
+                          uint32_t count = 1) {
+        inflightRequestCount_.fetch_add(count, std::memory_order_relaxed);
+        classCount_[qosClass].fetch_add(count, std::memory_order_relaxed);
     }
 
     /**
-     * @brief: inflight request计数加1
+     * @brief: inflight request计数减count
      */
-    inline void Increment() {
-        inflightRequestCount_.fetch_add(1, std::memory_order_relaxed);
+    inline void Decrement(QosClass qosClass = QOS_CLASS_CLIENT,
+                          uint32_t count = 1) {
+        inflightRequestCount_.fetch_sub(count, std::memory_order_relaxed);
+        classCount_[qosClass].fetch_sub(count, std::memory_order_relaxed);
     }
 
     /**
-     * @brief: inflight request计数减1
+     * @brief: 获取某个QoS类别的inflight配额
      */
-    inline void Decrement() {
-        inflightRequestCount_.fetch_sub(1, std::memory_order_relaxed);
+    inline uint64_t GetQuota(QosClass qosClass) const {
+        return classQuota_[qosClass];
+    }
+
+ private:
+    void InitQuota(const uint32_t (&weights)[QOS_CLASS_NUM]) {
+        uint64_t totalWeight = 0;
+        for (int i = 0; i < QOS_CLASS_NUM; ++i) {
+            totalWeight += weights[i];
+            classCount_[i].store(0, std::memory_order_relaxed);
+        }
+        for (int i = 0; i < QOS_CLASS_NUM; ++i) {
+            classQuota_[i] = totalWeight == 0 ? 0 :
+                kMaxInflightRequest_ * weights[i] / totalWeight;
+        }
     }
 
  private:
@@ -71,6 +145,10 @@ class InflightThrottle {
     std::atomic<uint64_t> inflightRequestCount_;
     // 最大的inflight request数量
     const uint64_t kMaxInflightRequest_;
+    // 各QoS类别当前的inflight request数量
+    std::atomic<uint64_t> classCount_[QOS_CLASS_NUM];
+    // 各QoS类别按权重分到的inflight配额
+    uint64_t classQuota_[QOS_CLASS_NUM];
 };
 
 }  // namespace chunkserver
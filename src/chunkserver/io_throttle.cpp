@@ -0,0 +1,177 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+#include "src/chunkserver/io_throttle.h"
+
+#include <glog/logging.h>
+
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::ReadLockGuard;
+using ::curve::common::WriteLockGuard;
+using ::curve::common::TimeUtility;
+
+IOThrottleOptions::IOThrottleOptions()
+    : diskIopsLimit(0),
+      diskBpsLimit(0),
+      weights{8, 2, 1, 1},
+      volumeIdleSec(60) {}
+
+IOThrottle::IOThrottle(const IOThrottleOptions &options)
+    : options_(options),
+      diskIops_(options.diskIopsLimit, 0),
+      diskBps_(options.diskBpsLimit, 0),
+      iopsReserve_(0),
+      bpsReserve_(0),
+      diskThrottled_("chunkserver_io_throttle", "disk_throttled"),
+      volumeThrottled_("chunkserver_io_throttle", "volume_throttled") {
+    uint64_t totalWeight = 0;
+    for (int i = 0; i < QOS_CLASS_NUM; ++i) {
+        totalWeight += options.weights[i];
+    }
+    if (totalWeight != 0) {
+        uint64_t clientWeight = options.weights[QOS_CLASS_CLIENT];
+        iopsReserve_ = diskIops_.GetBurst() * clientWeight / totalWeight;
+        bpsReserve_ = diskBps_.GetBurst() * clientWeight / totalWeight;
+    }
+}
+
+bool IOThrottle::IsOverLoad(QosClass qosClass,
+                            const ChunkRequest *request,
+                            uint64_t bytes,
+                            uint32_t ops) {
+    std::shared_ptr<VolumeThrottle> volume;
+    if (request != nullptr && request->has_fileid() &&
+        (request->volumeiopslimit() != 0 || request->volumebpslimit() != 0)) {
+        volume = GetVolumeThrottle(*request,
+                                   TimeUtility::GetTimeofDaySec());
+        if (!HasTokens(&volume->iops, &volume->bps, 0, 0, bytes)) {
+            volumeThrottled_ << 1;
+            return true;
+        }
+    }
+
+    bool isClient = (qosClass == QOS_CLASS_CLIENT);
+    if (!HasTokens(&diskIops_, &diskBps_,
+                   isClient ? 0 : iopsReserve_,
+                   isClient ? 0 : bpsReserve_,
+                   bytes)) {
+        diskThrottled_ << 1;
+        return true;
+    }
+
+    // 所有令牌桶都有令牌以后再取, 被限制的请求不消耗任何令牌
+    if (volume != nullptr) {
+        TakeTokens(&volume->iops, &volume->bps, ops, bytes);
+    }
+    TakeTokens(&diskIops_, &diskBps_, ops, bytes);
+    return false;
+}
+
+bool IOThrottle::HasTokens(TokenBucket *iops, TokenBucket *bps,
+                           uint64_t iopsReserve, uint64_t bpsReserve,
+                           uint64_t bytes) {
+    if (!iops->Available(iopsReserve)) {
+        return false;
+    }
+    if (bytes != 0 && !bps->Available(bpsReserve)) {
+        return false;
+    }
+    return true;
+}
+
+void IOThrottle::TakeTokens(TokenBucket *iops, TokenBucket *bps,
+                            uint32_t ops, uint64_t bytes) {
+    // 检查和取令牌之间并发的请求可能透支, 透支的部分由后续产生的令牌偿还
+    iops->Reserve(ops);
+    if (bytes != 0) {
+        bps->Reserve(bytes);
+    }
+}
+
+std::shared_ptr<IOThrottle::VolumeThrottle> IOThrottle::GetVolumeThrottle(
+    const ChunkRequest &request, uint64_t nowSec) {
+    VolumeShard *shard = &volumeShards_[request.fileid() % kVolumeShardNum];
+    EvictIdleVolumes(shard, nowSec);
+
+    std::shared_ptr<VolumeThrottle> volume;
+    {
+        ReadLockGuard readGuard(shard->rwLock);
+        auto it = shard->volumes.find(request.fileid());
+        if (it != shard->volumes.end()) {
+            volume = it->second;
+        }
+    }
+    if (volume == nullptr) {
+        WriteLockGuard writeGuard(shard->rwLock);
+        auto it = shard->volumes.find(request.fileid());
+        if (it == shard->volumes.end()) {
+            volume = std::make_shared<VolumeThrottle>(
+                request.volumeiopslimit(), request.volumebpslimit());
+            shard->volumes.emplace(request.fileid(), volume);
+        } else {
+            volume = it->second;
+        }
+    }
+    volume->lastUseSec.store(nowSec, std::memory_order_relaxed);
+
+    // 卷的限制值可能被修改, 以请求中最新的值为准
+    volume->iops.SetRate(request.volumeiopslimit(), 0);
+    volume->bps.SetRate(request.volumebpslimit(), 0);
+    return volume;
+}
+
+void IOThrottle::EvictIdleVolumes(VolumeShard *shard, uint64_t nowSec) {
+    uint64_t lastEvict = shard->lastEvictSec.load(std::memory_order_relaxed);
+    if (nowSec < lastEvict + options_.volumeIdleSec) {
+        return;
+    }
+    // 同一时间只有一个请求做回收, 其他请求直接返回
+    if (!shard->lastEvictSec.compare_exchange_strong(lastEvict, nowSec)) {
+        return;
+    }
+
+    WriteLockGuard writeGuard(shard->rwLock);
+    for (auto it = shard->volumes.begin(); it != shard->volumes.end();) {
+        uint64_t lastUse = it->second->lastUseSec.load(
+            std::memory_order_relaxed);
+        if (lastUse + options_.volumeIdleSec <= nowSec) {
+            it = shard->volumes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t IOThrottle::VolumeCount() {
+    size_t count = 0;
+    for (uint32_t i = 0; i < kVolumeShardNum; ++i) {
+        ReadLockGuard readGuard(volumeShards_[i].rwLock);
+        count += volumeShards_[i].volumes.size();
+    }
+    return count;
+}
+
+}  // namespace chunkserver
+}  // namespace curve
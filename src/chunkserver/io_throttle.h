@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+#ifndef SRC_CHUNKSERVER_IO_THROTTLE_H_
+#define SRC_CHUNKSERVER_IO_THROTTLE_H_
+
+#include <bvar/bvar.h>
+
+#include <memory>
+#include <unordered_map>
+
+#include "proto/chunk.pb.h"
+#include "src/chunkserver/inflight_throttle.h"
+#include "src/common/token_bucket.h"
+#include "src/common/concurrent/rw_lock.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::TokenBucket;
+
+struct IOThrottleOptions {
+    // 磁盘的iops上限, 为0表示不限制
+    uint64_t diskIopsLimit;
+    // 磁盘的带宽上限, 单位bytes/s, 为0表示不限制
+    uint64_t diskBpsLimit;
+    // 各QoS类别的权重
+    uint32_t weights[QOS_CLASS_NUM];
+    // 卷级流控的令牌桶超过这个时间没有被使用就会被回收, 单位s
+    uint32_t volumeIdleSec;
+
+    IOThrottleOptions();
+};
+
+/**
+ * 磁盘和卷级别的流控
+ * 1. 每块盘(即每个chunkserver)有iops和带宽两个令牌桶, client请求只要
+ *    桶中有令牌就可以下发, 其他类别的请求需要给client请求按权重保留一部分
+ *    令牌, 重建、克隆等后台任务打满磁盘时client请求仍然能拿到令牌
+ * 2. client的读写请求如果带了卷的iops/带宽上限, 按卷(文件id)单独限制,
+ *    限制值以请求中最新的值为准
+ * 所有令牌桶都有令牌时才取出令牌, 被任意一个桶限制的请求不消耗令牌
+ * 被限制的请求返回OVERLOAD, 由client退避重试
+ */
+class IOThrottle {
+ public:
+    explicit IOThrottle(const IOThrottleOptions &options);
+    ~IOThrottle() = default;
+
+    /**
+     * @brief 判断请求是否被限流
+     *
+     * @param qosClass 请求的QoS类别
+     * @param request 请求, 可以为nullptr
+     * @param bytes 请求的数据量
+     * @param ops 请求消耗的iops令牌数, 批量请求为子请求个数
+     *
+     * @return true表示被限流, false表示可以下发
+     */
+    bool IsOverLoad(QosClass qosClass,
+                    const ChunkRequest *request,
+                    uint64_t bytes,
+                    uint32_t ops = 1);
+
+    /**
+     * @brief 当前有卷级流控的卷数量
+     */
+    size_t VolumeCount();
+
+ private:
+    struct VolumeThrottle {
+        VolumeThrottle(uint64_t iops, uint64_t bps)
+            : iops(iops, 0), bps(bps, 0), lastUseSec(0) {}
+        TokenBucket iops;
+        TokenBucket bps;
+        std::atomic<uint64_t> lastUseSec;
+    };
+
+    // 卷级令牌桶按文件id分片, 查找已有的卷只需要加分片的读锁
+    struct VolumeShard {
+        VolumeShard() : lastEvictSec(0) {}
+        curve::common::RWLock rwLock;
+        std::unordered_map<uint64_t, std::shared_ptr<VolumeThrottle>> volumes;
+        std::atomic<uint64_t> lastEvictSec;
+    };
+
+    static const uint32_t kVolumeShardNum = 16;
+
+    // iops和带宽两个令牌桶是否都有令牌
+    static bool HasTokens(TokenBucket *iops, TokenBucket *bps,
+                          uint64_t iopsReserve, uint64_t bpsReserve,
+                          uint64_t bytes);
+
+    // 从iops和带宽两个令牌桶中取出令牌
+    static void TakeTokens(TokenBucket *iops, TokenBucket *bps,
+                           uint32_t ops, uint64_t bytes);
+
+    std::shared_ptr<VolumeThrottle> GetVolumeThrottle(
+        const ChunkRequest &request, uint64_t nowSec);
+
+    // 回收分片中长时间没有使用的卷级令牌桶
+    void EvictIdleVolumes(VolumeShard *shard, uint64_t nowSec);
+
+ private:
+    IOThrottleOptions options_;
+
+    TokenBucket diskIops_;
+    TokenBucket diskBps_;
+
+    // 非client请求需要给client请求保留的令牌数
+    uint64_t iopsReserve_;
+    uint64_t bpsReserve_;
+
+    VolumeShard volumeShards_[kVolumeShardNum];
+
+    // 被磁盘级流控限制的请求数
+    bvar::Adder<uint64_t> diskThrottled_;
+    // 被卷级流控限制的请求数
+    bvar::Adder<uint64_t> volumeThrottled_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_IO_THROTTLE_H_
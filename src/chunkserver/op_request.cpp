@@ -27,24 +27,50 @@
 #include <butil/sys_byteorder.h>
 #include <brpc/closure_guard.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "src/chunkserver/copyset_node.h"
+#include "src/chunkserver/chunkserver_metrics.h"
 #include "src/chunkserver/chunk_closure.h"
 #include "src/chunkserver/clone_manager.h"
 #include "src/chunkserver/clone_task.h"
+#include "src/chunkserver/propose_batcher.h"
+#include "src/common/object_pool.h"
+#include "src/common/timeutility.h"
+
+using curve::common::TimeUtility;
+using curve::common::MakePooledShared;
 
 namespace curve {
 namespace chunkserver {
 
+// follower读等待apply到leader的read index的最长时间
+static const uint64_t kFollowerReadWaitUs = 10 * 1000;
+
+ChunkLogEntry::ChunkLogEntry() :
+    arena_(MakeArenaOptions(initialBlock_)),
+    request_(google::protobuf::Arena::CreateMessage<ChunkRequest>(&arena_)) {
+}
+
+google::protobuf::ArenaOptions ChunkLogEntry::MakeArenaOptions(char *block) {
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block;
+    options.initial_block_size = kInitialBlockSize;
+    return options;
+}
+
 ChunkOpRequest::ChunkOpRequest() :
     datastore_(nullptr),
     node_(nullptr),
     cntl_(nullptr),
     request_(nullptr),
     response_(nullptr),
-    done_(nullptr) {
+    done_(nullptr),
+    traceStageUs_(0) {
 }
 
 ChunkOpRequest::ChunkOpRequest(std::shared_ptr<CopysetNode> nodePtr,
@@ -57,7 +83,8 @@ ChunkOpRequest::ChunkOpRequest(std::shared_ptr<CopysetNode> nodePtr,
     cntl_(dynamic_cast<brpc::Controller *>(cntl)),
     request_(request),
     response_(response),
-    done_(done) {
+    done_(done),
+    traceStageUs_(0) {
 }
 
 void ChunkOpRequest::Process() {
@@ -79,6 +106,18 @@ int ChunkOpRequest::Propose(const ChunkRequest *request,
         RedirectChunkRequest();
         return -1;
     }
+    TraceStageBegin();
+    // 普通写请求交给batcher，和同一copyset上并发到达的写请求合并propose
+    ProposeBatcher *batcher = node_->GetProposeBatcher();
+    if (batcher != nullptr && data != nullptr &&
+        request->optype() == CHUNK_OP_TYPE::CHUNK_OP_WRITE &&
+        request->size() == data->size()) {
+        batcher->Propose(shared_from_this(),
+                         request,
+                         data,
+                         node_->LeaderTerm());
+        return 0;
+    }
     // 打包op request为task
     braft::Task task;
     butil::IOBuf log;
@@ -97,6 +136,7 @@ int ChunkOpRequest::Propose(const ChunkRequest *request,
      */
     task.expected_term = node_->LeaderTerm();
 
+    ChunkServerMetric::GetInstance()->OnPropose(1, log.size());
     node_->Propose(task);
 
     return 0;
@@ -112,6 +152,97 @@ void ChunkOpRequest::RedirectChunkRequest() {
     response_->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED);
 }
 
+void ChunkOpRequest::TraceStageBegin() {
+    if (IsTraced()) {
+        traceStageUs_ = TimeUtility::GetTimeofDayUs();
+    }
+}
+
+uint64_t ChunkOpRequest::TraceStageEnd() {
+    uint64_t now = TimeUtility::GetTimeofDayUs();
+    uint64_t cost = now > traceStageUs_ ? now - traceStageUs_ : 0;
+    traceStageUs_ = now;
+    return cost;
+}
+
+void ChunkOpRequest::TraceRaftDone() {
+    if (IsTraced()) {
+        response_->mutable_trace()->set_raftus(TraceStageEnd());
+    }
+}
+
+void ChunkOpRequest::TraceApplyBegin() {
+    if (IsTraced()) {
+        response_->mutable_trace()->set_applyqueueus(TraceStageEnd());
+    }
+}
+
+void ChunkOpRequest::TraceStorageDone() {
+    if (IsTraced()) {
+        response_->mutable_trace()->set_storageus(TraceStageEnd());
+    }
+}
+
+void ChunkOpRequest::ScheduleApply(uint64_t index,
+                                   ::google::protobuf::Closure *done,
+                                   ConcurrentApplyModule *applyModule) {
+    auto task = std::bind(&ChunkOpRequest::OnApply,
+                          shared_from_this(),
+                          index,
+                          done);
+    PushApplyTask(applyModule, *request_, std::move(task));
+}
+
+void ChunkOpRequest::PushApplyTask(ConcurrentApplyModule *applyModule,
+                                   const ChunkRequest &request,
+                                   std::function<void()> task) {
+    switch (request.optype()) {
+    case CHUNK_OP_TYPE::CHUNK_OP_WRITE:
+        applyModule->PushWrite(request.chunkid(), request.offset(),
+                               request.size(), request.sn(),
+                               std::move(task));
+        break;
+    case CHUNK_OP_TYPE::CHUNK_OP_PASTE:
+        // paste只写clone chunk未写过的page，和版本号无关
+        applyModule->PushWrite(request.chunkid(), request.offset(),
+                               request.size(), ConcurrentApplyModule::kAnySn,
+                               std::move(task));
+        break;
+    default:
+        applyModule->Push(request.chunkid(), request.optype(),
+                          std::move(task));
+        break;
+    }
+}
+
+void ChunkOpRequest::ScheduleApplyFromLog(
+    std::shared_ptr<CSDataStore> datastore,
+    std::shared_ptr<ChunkLogEntry> entry,
+    ConcurrentApplyModule *applyModule) {
+    auto thisPtr = shared_from_this();
+    auto task = [thisPtr, datastore, entry]() {
+        thisPtr->OnApplyFromLog(datastore, entry->Request(), entry->Data());
+    };
+    PushApplyTask(applyModule, entry->Request(), std::move(task));
+}
+
+bool ChunkOpRequest::CanReadOnFollower() const {
+    if (!request_->followerread()) {
+        return false;
+    }
+    if (request_->optype() != CHUNK_OP_TYPE::CHUNK_OP_READ &&
+        request_->optype() != CHUNK_OP_TYPE::CHUNK_OP_READ_SNAP &&
+        request_->optype() != CHUNK_OP_TYPE::CHUNK_OP_READ_BATCH) {
+        return false;
+    }
+    uint64_t readIndex = 0;
+    if (0 != node_->FetchLeaderReadIndex(request_->chunkid(), &readIndex)) {
+        return false;
+    }
+    // 落后太多时不等待，直接转发给leader
+    return node_->WaitAppliedWatermark(readIndex, kFollowerReadWaitUs);
+}
+
 int ChunkOpRequest::Encode(const ChunkRequest *request,
                            const butil::IOBuf *data,
                            butil::IOBuf *log) {
@@ -154,19 +285,22 @@ std::shared_ptr<ChunkOpRequest> ChunkOpRequest::Decode(butil::IOBuf log,
     switch (request->optype()) {
         case CHUNK_OP_TYPE::CHUNK_OP_READ:
         case CHUNK_OP_TYPE::CHUNK_OP_RECOVER:
-            return std::make_shared<ReadChunkRequest>();
+            return MakePooledShared<ReadChunkRequest>();
         case CHUNK_OP_TYPE::CHUNK_OP_WRITE:
-            return std::make_shared<WriteChunkRequest>();
+            return MakePooledShared<WriteChunkRequest>();
         case CHUNK_OP_TYPE::CHUNK_OP_DELETE:
-            return std::make_shared<DeleteChunkRequest>();
+            return MakePooledShared<DeleteChunkRequest>();
         case CHUNK_OP_TYPE::CHUNK_OP_READ_SNAP:
-            return std::make_shared<ReadSnapshotRequest>();
+            return MakePooledShared<ReadSnapshotRequest>();
         case CHUNK_OP_TYPE::CHUNK_OP_DELETE_SNAP:
-            return std::make_shared<DeleteSnapshotRequest>();
+            return MakePooledShared<DeleteSnapshotRequest>();
         case CHUNK_OP_TYPE::CHUNK_OP_PASTE:
-            return std::make_shared<PasteChunkInternalRequest>();
+            return MakePooledShared<PasteChunkInternalRequest>();
         case CHUNK_OP_TYPE::CHUNK_OP_CREATE_CLONE:
-            return std::make_shared<CreateCloneChunkRequest>();
+            return MakePooledShared<CreateCloneChunkRequest>();
+        case CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH:
+        case CHUNK_OP_TYPE::CHUNK_OP_READ_BATCH:
+            return MakePooledShared<ChunkBatchRequest>();
         default:LOG(ERROR) << "Unknown chunk op";
             return nullptr;
     }
@@ -240,19 +374,32 @@ ReadChunkRequest::ReadChunkRequest(std::shared_ptr<CopysetNode> nodePtr,
 void ReadChunkRequest::Process() {
     brpc::ClosureGuard doneGuard(done_);
 
-    if (!node_->IsLeaderTerm()) {
+    // follower只处理已经apply到leader read index的followerRead请求，
+    // 其余的转发给leader
+    bool followerRead = !node_->IsLeaderTerm();
+    if (followerRead && !CanReadOnFollower()) {
         RedirectChunkRequest();
         return;
     }
 
     /**
      * 如果携带了applied index，且小于当前copyset node
-     * 的最新applied index，或者 op类型为CHUNK_OP_RECOVER
-     * 那么不需要走一致性协议
+     * 的最新applied index，或者 op类型为CHUNK_OP_RECOVER，
+     * 或者当前leader持有有效的lease（之前任期的日志已apply完，
+     * 见CopysetNode::IsLeaseLeader），那么不需要走一致性协议；
+     * follower读时已经apply到了leader的read index
      */
-    if ((request_->has_appliedindex()
-        && node_->GetAppliedIndex() >= request_->appliedindex())
-        || request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_RECOVER) {
+    bool isRecover = request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_RECOVER;
+    bool appliedIndexOk = request_->has_appliedindex()
+        && node_->GetAppliedIndex() >= request_->appliedindex();
+    bool leaseOk = !isRecover && !appliedIndexOk && node_->IsLeaseLeader();
+    if (followerRead || appliedIndexOk || isRecover || leaseOk) {
+        if (followerRead) {
+            ChunkServerMetric::GetInstance()->OnRead(ReadPathType::kFollower);
+        } else if (!isRecover) {
+            ChunkServerMetric::GetInstance()->OnRead(
+                leaseOk ? ReadPathType::kLease : ReadPathType::kAppliedIndex);
+        }
         /**
          * 构造shared_ptr<ReadChunkRequest>，因为在ChunkOpRequest只指定了
          * std::enable_shared_from_this<ChunkOpRequest>，所以
@@ -278,19 +425,26 @@ void ReadChunkRequest::Process() {
          *  index=6的op的后面，也就是它们操作的是同一个chunk，并发层会将它们放在同一个
          *  队列中，这样就能保证index=6的op apply之后，read才会被执行，这样就不会出现
          *  stale read，保证了read的线性一致性
+         *  注：现在读写分别进入并发层的读队列和写队列（rapplyMap_和
+         *  wapplyMap_），read不再与同一chunk的write同队列排队；lease读的安全性由
+         *  CopysetNode::IsLeaseLeader保证
          */
         auto task = std::bind(&ReadChunkRequest::OnApply,
                               thisPtr,
                               node_->GetAppliedIndex(),
                               doneGuard.release());
-        concurrentApplyModule_->Push(
-            request_->chunkid(), request_->optype(), task);
+        TraceStageBegin();
+        concurrentApplyModule_->Push(request_->chunkid(),
+                                     request_->offset(),
+                                     request_->optype(),
+                                     std::move(task));
         return;
     }
 
     /**
-     * 如果没有携带applied index，那么走raft一致性协议read
+     * 如果没有携带applied index，且lease不可用，那么走raft一致性协议read
      */
+    ChunkServerMetric::GetInstance()->OnRead(ReadPathType::kPropose);
     if (0 == Propose(request_, nullptr)) {
         doneGuard.release();
     }
@@ -298,6 +452,7 @@ void ReadChunkRequest::Process() {
 
 void ReadChunkRequest::OnApply(uint64_t index,
                                ::google::protobuf::Closure *done) {
+    TraceApplyBegin();
     // 先清除response中的status，以保证CheckForward后的判断的正确性
     response_->clear_status();
 
@@ -326,6 +481,11 @@ void ReadChunkRequest::OnApply(uint64_t index,
         }
         // 如果需要从源端拷贝数据，需要将请求转发给clone manager处理
         if ( needLazyClone || NeedClone(chunkInfo) ) {
+            // 拷贝后的paste需要propose，follower上不处理，转发给leader
+            if (request_->followerread() && !node_->IsLeaderTerm()) {
+                RedirectChunkRequest();
+                break;
+            }
             applyIndex = index;
             std::shared_ptr<CloneTask> cloneTask =
             cloneMgr_->GenerateCloneTask(
@@ -348,6 +508,7 @@ void ReadChunkRequest::OnApply(uint64_t index,
         // 如果是ReadChunk请求还需要从本地读取数据
         if (request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_READ) {
             ReadChunk();
+            TraceStorageDone();
         }
         // 如果是recover请求，说明请求区域已经被写过了，可以直接返回成功
         if (request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_RECOVER) {
@@ -439,6 +600,7 @@ void WriteChunkRequest::OnApply(uint64_t index,
                                 ::google::protobuf::Closure *done) {
     brpc::ClosureGuard doneGuard(done);
     uint32_t cost;
+    TraceApplyBegin();
 
     std::string  cloneSourceLocation;
     if (existCloneInfo(request_)) {
@@ -454,6 +616,7 @@ void WriteChunkRequest::OnApply(uint64_t index,
                                       request_->size(),
                                       &cost,
                                       cloneSourceLocation);
+    TraceStorageDone();
 
     if (CSErrorCode::Success == ret) {
         response_->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
@@ -546,6 +709,515 @@ void WriteChunkRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
     }
 }
 
+void ChunkBatchRequest::Process() {
+    brpc::ClosureGuard doneGuard(done_);
+
+    if (IsWrite()) {
+        const butil::IOBuf& data = cntl_->request_attachment();
+        if (0 == Propose(request_, &data)) {
+            doneGuard.release();
+        }
+        return;
+    }
+
+    // 和ReadChunkRequest相同，follower只处理已经apply到read index的读请求
+    bool followerRead = !node_->IsLeaderTerm();
+    if (followerRead && !CanReadOnFollower()) {
+        RedirectChunkRequest();
+        return;
+    }
+
+    bool appliedIndexOk = request_->has_appliedindex()
+        && node_->GetAppliedIndex() >= request_->appliedindex();
+    bool leaseOk = !appliedIndexOk && node_->IsLeaseLeader();
+    ReadPathType pathType = ReadPathType::kPropose;
+    if (followerRead) {
+        pathType = ReadPathType::kFollower;
+    } else if (appliedIndexOk) {
+        pathType = ReadPathType::kAppliedIndex;
+    } else if (leaseOk) {
+        pathType = ReadPathType::kLease;
+    }
+    for (int i = 0; i < request_->subrequests_size(); ++i) {
+        ChunkServerMetric::GetInstance()->OnRead(pathType);
+    }
+
+    if (followerRead || appliedIndexOk || leaseOk) {
+        ScheduleApply(node_->GetAppliedIndex(),
+                      doneGuard.release(),
+                      node_->GetConcurrentApplyModule());
+        return;
+    }
+
+    if (0 == Propose(request_, nullptr)) {
+        doneGuard.release();
+    }
+}
+
+void ChunkBatchRequest::ScheduleApply(uint64_t index,
+                                      ::google::protobuf::Closure *done,
+                                      ConcurrentApplyModule *applyModule) {
+    PrepareSubOps();
+    std::vector<std::vector<int>> groups = GroupSubOps(*request_);
+    if (groups.empty()) {
+        brpc::ClosureGuard doneGuard(done);
+        Finish(index);
+        return;
+    }
+
+    /**
+     * 需要在raft apply线程中完成拆分，每组只放入对应chunk的队列，
+     * 不能在apply线程中再向其他队列提交任务，否则队列满时可能互相等待
+     */
+    pending_.store(groups.size());
+    auto thisPtr =
+        std::dynamic_pointer_cast<ChunkBatchRequest>(shared_from_this());
+    for (auto &group : groups) {
+        const ChunkRequest &first = request_->subrequests(group[0]);
+        auto task = std::bind(&ChunkBatchRequest::ApplySubOps,
+                              thisPtr,
+                              index,
+                              std::move(group),
+                              done);
+        if (IsWrite()) {
+            PushWriteGroup(applyModule, *request_, group, std::move(task));
+        } else {
+            applyModule->Push(first.chunkid(),
+                              first.offset(),
+                              CHUNK_OP_TYPE::CHUNK_OP_READ,
+                              std::move(task));
+        }
+    }
+}
+
+void ChunkBatchRequest::ScheduleApplyFromLog(
+    std::shared_ptr<CSDataStore> datastore,
+    std::shared_ptr<ChunkLogEntry> entry,
+    ConcurrentApplyModule *applyModule) {
+    const ChunkRequest &batch = entry->Request();
+    // read什么都不用做
+    if (batch.optype() != CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH) {
+        return;
+    }
+
+    auto subData = std::make_shared<std::vector<butil::IOBuf>>(
+        SplitData(batch, entry->Data()));
+    for (auto &group : GroupSubOps(batch)) {
+        auto task = [datastore, entry, subData, group]() {
+            for (int i : group) {
+                WriteSubChunk(datastore,
+                              entry->Request().subrequests(i),
+                              (*subData)[i]);
+            }
+        };
+        PushWriteGroup(applyModule, batch, group, std::move(task));
+    }
+}
+
+void ChunkBatchRequest::PushWriteGroup(ConcurrentApplyModule *applyModule,
+                                       const ChunkRequest &request,
+                                       const std::vector<int> &group,
+                                       std::function<void()> task) {
+    const ChunkRequest &first = request.subrequests(group[0]);
+    uint64_t begin = first.offset();
+    uint64_t end = first.offset() + first.size();
+    uint64_t sn = first.sn();
+    for (int i : group) {
+        const ChunkRequest &sub = request.subrequests(i);
+        begin = std::min<uint64_t>(begin, sub.offset());
+        end = std::max<uint64_t>(end, sub.offset() + sub.size());
+        // 组内版本号不一致时和chunk的所有写排队
+        if (sub.sn() != first.sn()) {
+            sn = ConcurrentApplyModule::kAnySn;
+            begin = 0;
+            end = UINT64_MAX;
+        }
+    }
+    applyModule->PushWrite(first.chunkid(), begin, end - begin, sn,
+                           std::move(task));
+}
+
+void ChunkBatchRequest::OnApply(uint64_t index,
+                                ::google::protobuf::Closure *done) {
+    // 不经过ScheduleApply时在当前线程中按顺序执行所有子请求
+    PrepareSubOps();
+    std::vector<int> subIndexes;
+    for (int i = 0; i < request_->subrequests_size(); ++i) {
+        subIndexes.push_back(i);
+    }
+    pending_.store(1);
+    ApplySubOps(index, subIndexes, done);
+}
+
+void ChunkBatchRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
+                                       const ChunkRequest &request,
+                                       const butil::IOBuf &data) {
+    // NOTE: 处理过程中优先使用参数传入的datastore/request
+    if (request.optype() != CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH) {
+        return;
+    }
+    std::vector<butil::IOBuf> subData = SplitData(request, data);
+    for (int i = 0; i < request.subrequests_size(); ++i) {
+        WriteSubChunk(datastore, request.subrequests(i), subData[i]);
+    }
+}
+
+void ChunkBatchRequest::PrepareSubOps() {
+    response_->clear_subresponses();
+    for (int i = 0; i < request_->subrequests_size(); ++i) {
+        response_->add_subresponses()->set_status(
+            CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN);
+    }
+    if (IsWrite()) {
+        subData_ = SplitData(*request_, cntl_->request_attachment());
+    } else {
+        subData_.clear();
+        subData_.resize(request_->subrequests_size());
+    }
+}
+
+class ChunkBatchRequest::SubCloneClosure : public ::google::protobuf::Closure {
+ public:
+    SubCloneClosure(std::shared_ptr<ChunkBatchRequest> request,
+                    uint64_t index,
+                    int subIndex,
+                    ::google::protobuf::Closure *done) :
+        request_(request),
+        index_(index),
+        subIndex_(subIndex),
+        done_(done) {}
+
+    void Run() override {
+        std::unique_ptr<SubCloneClosure> selfGuard(this);
+        // clone core把读到的数据放在controller的response attachment中
+        if (request_->response_->subresponses(subIndex_).status()
+            == CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            request_->subData_[subIndex_].swap(cntl_.response_attachment());
+        }
+        request_->SubOpsDone(index_, done_);
+    }
+
+    brpc::Controller *Controller() {
+        return &cntl_;
+    }
+
+ private:
+    std::shared_ptr<ChunkBatchRequest> request_;
+    uint64_t index_;
+    int subIndex_;
+    ::google::protobuf::Closure *done_;
+    brpc::Controller cntl_;
+};
+
+void ChunkBatchRequest::ApplySubOps(uint64_t index,
+                                    const std::vector<int> &subIndexes,
+                                    ::google::protobuf::Closure *done) {
+    for (int i : subIndexes) {
+        if (IsWrite()) {
+            CHUNK_OP_STATUS status = WriteSubChunk(datastore_,
+                                                   request_->subrequests(i),
+                                                   subData_[i]);
+            response_->mutable_subresponses(i)->set_status(status);
+        } else {
+            ReadSubChunk(index, i, done);
+        }
+    }
+    SubOpsDone(index, done);
+}
+
+void ChunkBatchRequest::SubOpsDone(uint64_t index,
+                                   ::google::protobuf::Closure *done) {
+    // 最后完成的负责返回
+    if (pending_.fetch_sub(1) == 1) {
+        brpc::ClosureGuard doneGuard(done);
+        Finish(index);
+    }
+}
+
+void ChunkBatchRequest::Finish(uint64_t index) {
+    bool allSuccess = true;
+    CHUNK_OP_STATUS status = CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS;
+    for (int i = 0; i < response_->subresponses_size(); ++i) {
+        CHUNK_OP_STATUS subStatus = response_->subresponses(i).status();
+        if (subStatus == CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            if (!IsWrite()) {
+                cntl_->response_attachment().append(subData_[i]);
+            }
+            continue;
+        }
+        allSuccess = false;
+        // 读不存在的chunk是正常的结果，client按全0处理
+        if (!IsWrite() &&
+            subStatus == CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_NOTEXIST) {
+            continue;
+        }
+        // 整个请求的状态取第一个失败的子请求的状态
+        if (status == CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            status = subStatus;
+        }
+    }
+
+    response_->set_status(status);
+    if (allSuccess) {
+        node_->UpdateAppliedIndex(index);
+    }
+    auto maxIndex =
+        (index > node_->GetAppliedIndex() ? index : node_->GetAppliedIndex());
+    response_->set_appliedindex(maxIndex);
+}
+
+void ChunkBatchRequest::ReadSubChunk(uint64_t index,
+                                     int subIndex,
+                                     ::google::protobuf::Closure *done) {
+    const ChunkRequest &sub = request_->subrequests(subIndex);
+    ChunkResponse *subResponse = response_->mutable_subresponses(subIndex);
+    CSChunkInfo chunkInfo;
+    CSErrorCode ret = datastore_->GetChunkInfo(sub.chunkid(), &chunkInfo);
+    bool needClone = false;
+    // 同ReadChunkRequest::OnApply，chunk不存在但是携带了clone源信息时
+    // 从clone源读取
+    if (CSErrorCode::ChunkNotExistError == ret) {
+        if (!existCloneInfo(&sub)) {
+            subResponse->set_status(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_NOTEXIST);
+            return;
+        }
+        needClone = true;
+    } else if (CSErrorCode::Success != ret) {
+        LOG(ERROR) << "get chunkinfo failed: "
+                   << " logic pool id: " << sub.logicpoolid()
+                   << " copyset id: " << sub.copysetid()
+                   << " chunkid: " << sub.chunkid();
+        subResponse->set_status(
+            CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN);
+        return;
+    } else if (chunkInfo.isClone) {
+        uint32_t beginIndex = sub.offset() / chunkInfo.pageSize;
+        uint32_t endIndex =
+            (sub.offset() + sub.size() - 1) / chunkInfo.pageSize;
+        needClone = chunkInfo.bitmap->NextClearBit(beginIndex, endIndex)
+                    != Bitmap::NO_POS;
+    }
+    if (needClone) {
+        CloneSubChunk(index, subIndex, done);
+        return;
+    }
+    subResponse->set_status(ReadLocalSubChunk(sub, &subData_[subIndex]));
+}
+
+void ChunkBatchRequest::CloneSubChunk(uint64_t index,
+                                      int subIndex,
+                                      ::google::protobuf::Closure *done) {
+    const ChunkRequest &sub = request_->subrequests(subIndex);
+    ChunkResponse *subResponse = response_->mutable_subresponses(subIndex);
+    // 拷贝后的paste需要propose，follower上不处理，由client转发给leader
+    if (!node_->IsLeaderTerm()) {
+        subResponse->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED);
+        return;
+    }
+
+    auto thisPtr =
+        std::dynamic_pointer_cast<ChunkBatchRequest>(shared_from_this());
+    SubCloneClosure *closure =
+        new SubCloneClosure(thisPtr, index, subIndex, done);
+    auto readRequest =
+        std::make_shared<ReadChunkRequest>(node_,
+                                           cloneMgr_,
+                                           closure->Controller(),
+                                           &sub,
+                                           subResponse,
+                                           closure);
+    readRequest->applyIndex = index;
+    // 子请求异步完成前整个请求不能返回
+    pending_.fetch_add(1);
+    bool issued = nullptr != cloneMgr_ && cloneMgr_->IssueCloneTask(
+        cloneMgr_->GenerateCloneTask(readRequest, closure));
+    if (!issued) {
+        LOG(ERROR) << "issue clone task failed: "
+                   << " logic pool id: " << sub.logicpoolid()
+                   << " copyset id: " << sub.copysetid()
+                   << " chunkid: " << sub.chunkid();
+        pending_.fetch_sub(1);
+        delete closure;
+        subResponse->set_status(
+            CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN);
+    }
+}
+
+CHUNK_OP_STATUS ChunkBatchRequest::ReadLocalSubChunk(const ChunkRequest &sub,
+                                                     butil::IOBuf *data) {
+    size_t size = sub.size();
+    char *readBuffer = new(std::nothrow)char[size];
+    CHECK(nullptr != readBuffer)
+        << "new readBuffer failed " << strerror(errno);
+    butil::IOBuf wrapper;
+    wrapper.append_user_data(readBuffer, size, ReadBufferDeleter);
+
+    CSErrorCode ret = datastore_->ReadChunk(sub.chunkid(),
+                                            sub.sn(),
+                                            readBuffer,
+                                            sub.offset(),
+                                            size);
+    if (CSErrorCode::Success == ret) {
+        data->swap(wrapper);
+        return CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS;
+    } else if (CSErrorCode::ChunkNotExistError == ret) {
+        return CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_NOTEXIST;
+    } else if (CSErrorCode::InternalError == ret) {
+        LOG(FATAL) << "read failed: "
+                   << " logic pool id: " << sub.logicpoolid()
+                   << " copyset id: " << sub.copysetid()
+                   << " chunkid: " << sub.chunkid()
+                   << " data size: " << sub.size()
+                   << " data store return: " << ret;
+    }
+    LOG(ERROR) << "read failed: "
+               << " logic pool id: " << sub.logicpoolid()
+               << " copyset id: " << sub.copysetid()
+               << " chunkid: " << sub.chunkid()
+               << " data size: " << sub.size()
+               << " data store return: " << ret;
+    return CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN;
+}
+
+CHUNK_OP_STATUS ChunkBatchRequest::WriteSubChunk(
+    std::shared_ptr<CSDataStore> datastore,
+    const ChunkRequest &sub,
+    const butil::IOBuf &data) {
+    uint32_t cost;
+    std::string cloneSourceLocation;
+    if (existCloneInfo(&sub)) {
+        auto func = ::curve::common::LocationOperator::GenerateCurveLocation;
+        cloneSourceLocation = func(sub.clonefilesource(),
+                                   sub.clonefileoffset());
+    }
+
+    auto ret = datastore->WriteChunk(sub.chunkid(),
+                                     sub.sn(),
+                                     data,
+                                     sub.offset(),
+                                     sub.size(),
+                                     &cost,
+                                     cloneSourceLocation);
+    if (CSErrorCode::Success == ret) {
+        return CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS;
+    } else if (CSErrorCode::BackwardRequestError == ret) {
+        LOG(WARNING) << "write failed: "
+                     << " logic pool id: " << sub.logicpoolid()
+                     << " copyset id: " << sub.copysetid()
+                     << " chunkid: " << sub.chunkid()
+                     << " data size: " << sub.size()
+                     << " data store return: " << ret;
+        return CHUNK_OP_STATUS::CHUNK_OP_STATUS_BACKWARD;
+    } else if (CSErrorCode::InternalError == ret ||
+               CSErrorCode::CrcCheckError == ret ||
+               CSErrorCode::FileFormatError == ret) {
+        // 和WriteChunkRequest相同，为了防止副本不一致，让进程退出
+        LOG(FATAL) << "write failed: "
+                   << " logic pool id: " << sub.logicpoolid()
+                   << " copyset id: " << sub.copysetid()
+                   << " chunkid: " << sub.chunkid()
+                   << " data size: " << sub.size()
+                   << " data store return: " << ret;
+    }
+    LOG(ERROR) << "write failed: "
+               << " logic pool id: " << sub.logicpoolid()
+               << " copyset id: " << sub.copysetid()
+               << " chunkid: " << sub.chunkid()
+               << " data size: " << sub.size()
+               << " data store return: " << ret;
+    return CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN;
+}
+
+std::vector<std::vector<int>> ChunkBatchRequest::GroupSubOps(
+    const ChunkRequest &request) {
+    std::vector<std::vector<int>> groups;
+    bool isWrite = request.optype() == CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH;
+    std::unordered_map<ChunkID, size_t> chunkGroup;
+    for (int i = 0; i < request.subrequests_size(); ++i) {
+        if (!isWrite) {
+            groups.push_back({i});
+            continue;
+        }
+        ChunkID chunkId = request.subrequests(i).chunkid();
+        auto iter = chunkGroup.find(chunkId);
+        if (iter == chunkGroup.end()) {
+            chunkGroup.emplace(chunkId, groups.size());
+            groups.push_back({i});
+        } else {
+            groups[iter->second].push_back(i);
+        }
+    }
+    return groups;
+}
+
+std::vector<butil::IOBuf> ChunkBatchRequest::SplitData(
+    const ChunkRequest &request, const butil::IOBuf &data) {
+    std::vector<butil::IOBuf> subData(request.subrequests_size());
+    butil::IOBuf left = data;
+    for (int i = 0; i < request.subrequests_size(); ++i) {
+        left.cutn(&subData[i], request.subrequests(i).size());
+    }
+    return subData;
+}
+
+void ProposeBatchRequest::ScheduleApply(uint64_t index,
+                                        ::google::protobuf::Closure *done,
+                                        ConcurrentApplyModule *applyModule) {
+    brpc::ClosureGuard doneGuard(done);
+    for (auto &op : ops_) {
+        op->TraceRaftDone();
+        op->ScheduleApply(index, new ChunkClosure(op), applyModule);
+    }
+}
+
+void ProposeBatchRequest::OnApply(uint64_t index,
+                                  ::google::protobuf::Closure *done) {
+    brpc::ClosureGuard doneGuard(done);
+    for (auto &op : ops_) {
+        op->OnApply(index, new ChunkClosure(op));
+    }
+}
+
+void ProposeBatchRequest::OnApplyFromLog(
+    std::shared_ptr<CSDataStore> datastore,
+    const ChunkRequest &request,
+    const butil::IOBuf &data) {
+    // 从日志反序列化得到的是ChunkBatchRequest，不会走到这里
+    LOG(ERROR) << "propose batch request should not apply from log";
+}
+
+void ProposeBatchRequest::RedirectChunkRequest() {
+    for (auto &op : ops_) {
+        brpc::ClosureGuard doneGuard(op->Closure());
+        op->RedirectChunkRequest();
+    }
+}
+
+void ReadSnapshotRequest::Process() {
+    // leader上仍然走raft一致性协议read
+    if (node_->IsLeaderTerm() || !CanReadOnFollower()) {
+        ChunkOpRequest::Process();
+        return;
+    }
+
+    brpc::ClosureGuard doneGuard(done_);
+    ChunkServerMetric::GetInstance()->OnRead(ReadPathType::kFollower);
+    /**
+     * 同ReadChunkRequest::Process，读快照也要进并发层和同一chunk的写排队，
+     * 保证applied index之前的写已经执行完成
+     */
+    auto thisPtr
+        = std::dynamic_pointer_cast<ReadSnapshotRequest>(shared_from_this());
+    auto task = std::bind(&ReadSnapshotRequest::OnApply,
+                          thisPtr,
+                          node_->GetAppliedIndex(),
+                          doneGuard.release());
+    node_->GetConcurrentApplyModule()->Push(request_->chunkid(),
+                                            request_->optype(),
+                                            std::move(task));
+}
+
 void ReadSnapshotRequest::OnApply(uint64_t index,
                                   ::google::protobuf::Closure *done) {
     brpc::ClosureGuard doneGuard(done);
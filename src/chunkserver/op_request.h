@@ -24,10 +24,14 @@
 #define SRC_CHUNKSERVER_OP_REQUEST_H_
 
 #include <google/protobuf/message.h>
+#include <google/protobuf/arena.h>
 #include <butil/iobuf.h>
 #include <brpc/controller.h>
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "proto/chunk.pb.h"
 #include "include/chunkserver/chunkserver_common.h"
@@ -57,7 +61,37 @@ inline bool existCloneInfo(const ChunkRequest *request) {
     return false;
 }
 
+/**
+ * 从一条op log entry反序列化得到的request和数据。ChunkRequest分配在自带
+ * 初始内存块的arena上，整个对象从对象池分配，apply任务只持有它的引用，
+ * 不再拷贝request和数据
+ */
+class ChunkLogEntry {
+ public:
+    ChunkLogEntry();
+
+    ChunkRequest *MutableRequest() { return request_; }
+    const ChunkRequest &Request() const { return *request_; }
+
+    butil::IOBuf *MutableData() { return &data_; }
+    const butil::IOBuf &Data() const { return data_; }
+
+ private:
+    static const size_t kInitialBlockSize = 512;
+
+    static google::protobuf::ArenaOptions MakeArenaOptions(char *block);
+
+ private:
+    // arena的第一块内存，单个请求的日志不需要再分配内存
+    char initialBlock_[kInitialBlockSize];
+    google::protobuf::Arena arena_;
+    ChunkRequest *request_;
+    butil::IOBuf data_;
+};
+
 class ChunkOpRequest : public std::enable_shared_from_this<ChunkOpRequest> {
+    friend class ProposeBatcher;
+
  public:
     ChunkOpRequest();
     ChunkOpRequest(std::shared_ptr<CopysetNode> nodePtr,
@@ -95,6 +129,39 @@ class ChunkOpRequest : public std::enable_shared_from_this<ChunkOpRequest> {
                                 const ChunkRequest &request,
                                 const butil::IOBuf &data) = 0;
 
+    /**
+     * 在raft apply线程中把op交给并发apply模块，默认按chunk id放入一个队列
+     * 执行OnApply，同时操作多个chunk的op需要重载，保证和同一chunk上其他op
+     * 的apply顺序一致
+     * @param index:此op log entry的index
+     * @param done:对应的ChunkClosure
+     * @param applyModule:copyset的并发apply模块
+     */
+    virtual void ScheduleApply(uint64_t index,
+                               ::google::protobuf::Closure *done,
+                               ConcurrentApplyModule *applyModule);
+
+    /**
+     * 同ScheduleApply，用于从log entry反序列化得到的op，默认执行OnApplyFromLog
+     * @param datastore:chunk数据持久化层
+     * @param entry:反序列化后得到的request和要处理的数据，apply任务持有它
+     * @param applyModule:copyset的并发apply模块
+     */
+    virtual void ScheduleApplyFromLog(std::shared_ptr<CSDataStore> datastore,
+                                      std::shared_ptr<ChunkLogEntry> entry,
+                                      ConcurrentApplyModule *applyModule);
+
+    /**
+     * 把request的apply任务放入并发apply模块，写和paste按chunk内的范围分配队列，
+     * 其他op和同一chunk的所有写排队
+     * @param applyModule:copyset的并发apply模块
+     * @param request:要apply的request
+     * @param task:apply任务
+     */
+    static void PushApplyTask(ConcurrentApplyModule *applyModule,
+                              const ChunkRequest &request,
+                              std::function<void()> task);
+
     /**
      * 返回request的done成员
      */
@@ -120,6 +187,16 @@ class ChunkOpRequest : public std::enable_shared_from_this<ChunkOpRequest> {
      */
     virtual void RedirectChunkRequest();
 
+    /**
+     * 被client采样的请求记录各阶段的耗时到response中，未采样时不做任何事
+     * TraceRaftDone: 请求被raft提交，进入并发apply模块排队
+     * TraceApplyBegin: 请求从并发apply模块中取出开始执行
+     * TraceStorageDone: datastore读写完成
+     */
+    void TraceRaftDone();
+    void TraceApplyBegin();
+    void TraceStorageDone();
+
  public:
     /**
      * Op序列化工具函数
@@ -162,6 +239,34 @@ class ChunkOpRequest : public std::enable_shared_from_this<ChunkOpRequest> {
     int Propose(const ChunkRequest *request,
                 const butil::IOBuf *data);
 
+    /**
+     * 判断读请求能否在follower上处理：请求开启了followerRead，向leader
+     * 获取read index(raft的ReadIndex)，并且本副本在等待时间内apply到了
+     * read index。client携带的appliedIndex只是它见过的applied index，
+     * 不能保证读到其他client已应答的写，所以不作为依据
+     * @return true可以在本地读，false需要转发给leader
+     */
+    bool CanReadOnFollower() const;
+
+    /**
+     * 请求是否被client采样，需要记录各阶段的耗时
+     */
+    bool IsTraced() const {
+        return request_ != nullptr && response_ != nullptr &&
+               request_->trace();
+    }
+
+    /**
+     * 开始记录下一个阶段的耗时
+     */
+    void TraceStageBegin();
+
+    /**
+     * 结束当前阶段
+     * @return 当前阶段的耗时
+     */
+    uint64_t TraceStageEnd();
+
  protected:
     // chunk持久化接口
     std::shared_ptr<CSDataStore> datastore_;
@@ -175,6 +280,8 @@ class ChunkOpRequest : public std::enable_shared_from_this<ChunkOpRequest> {
     ChunkResponse *response_;
     // rpc done closure
     ::google::protobuf::Closure *done_;
+    // 采样请求当前阶段的开始时间
+    uint64_t traceStageUs_;
 };
 
 class DeleteChunkRequest : public ChunkOpRequest {
@@ -202,6 +309,7 @@ class DeleteChunkRequest : public ChunkOpRequest {
 class ReadChunkRequest : public ChunkOpRequest {
     friend class CloneCore;
     friend class PasteChunkInternalRequest;
+    friend class ChunkBatchRequest;
 
  public:
     ReadChunkRequest() :
@@ -261,6 +369,184 @@ class WriteChunkRequest : public ChunkOpRequest {
                         const butil::IOBuf &data) override;
 };
 
+/**
+ * 批量读写同一copyset上的多个chunk，整个批量请求作为一条raft日志propose，
+ * 每个子请求的结果放在response的subResponses中。apply时按chunk拆分，同一
+ * chunk上的子请求按日志中的顺序放入该chunk的队列，保证和其他单个请求的apply
+ * 顺序一致，所有子请求完成后才返回
+ */
+class ChunkBatchRequest : public ChunkOpRequest {
+ public:
+    ChunkBatchRequest() :
+        ChunkOpRequest(),
+        cloneMgr_(nullptr),
+        pending_(0) {}
+    ChunkBatchRequest(std::shared_ptr<CopysetNode> nodePtr,
+                      CloneManager* cloneMgr,
+                      RpcController *cntl,
+                      const ChunkRequest *request,
+                      ChunkResponse *response,
+                      ::google::protobuf::Closure *done) :
+        ChunkOpRequest(nodePtr,
+                       cntl,
+                       request,
+                       response,
+                       done),
+        cloneMgr_(cloneMgr),
+        pending_(0) {}
+    virtual ~ChunkBatchRequest() = default;
+
+    void Process() override;
+    void OnApply(uint64_t index, ::google::protobuf::Closure *done) override;
+    void OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
+                        const ChunkRequest &request,
+                        const butil::IOBuf &data) override;
+    void ScheduleApply(uint64_t index,
+                       ::google::protobuf::Closure *done,
+                       ConcurrentApplyModule *applyModule) override;
+    void ScheduleApplyFromLog(std::shared_ptr<CSDataStore> datastore,
+                              std::shared_ptr<ChunkLogEntry> entry,
+                              ConcurrentApplyModule *applyModule) override;
+
+ private:
+    // 从clone源读取的子请求完成后把数据交回批量请求
+    class SubCloneClosure;
+
+    bool IsWrite() const {
+        return request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH;
+    }
+
+    /**
+     * 初始化子请求的response，并把写数据按子请求切分
+     */
+    void PrepareSubOps();
+
+    /**
+     * 按顺序执行一组子请求，最后一组完成时返回整个请求
+     * @param index:此op log entry的index
+     * @param subIndexes:子请求在subRequests中的下标
+     * @param done:对应的ChunkClosure
+     */
+    void ApplySubOps(uint64_t index,
+                     const std::vector<int> &subIndexes,
+                     ::google::protobuf::Closure *done);
+
+    /**
+     * 一组子请求完成，最后完成的负责返回整个请求
+     * @param index:此op log entry的index
+     * @param done:对应的ChunkClosure
+     */
+    void SubOpsDone(uint64_t index, ::google::protobuf::Closure *done);
+
+    /**
+     * 读一个子请求的数据，结果设置在对应的subResponse中。clone chunk上
+     * 未写过的区域和单个ReadChunk一样交给clone manager处理
+     * @param index:此op log entry的index
+     * @param subIndex:子请求在subRequests中的下标
+     * @param done:对应的ChunkClosure
+     */
+    void ReadSubChunk(uint64_t index,
+                      int subIndex,
+                      ::google::protobuf::Closure *done);
+
+    /**
+     * 从clone源读取一个子请求的数据，并把数据paste到chunk，子请求异步完成
+     * @param index:此op log entry的index
+     * @param subIndex:子请求在subRequests中的下标
+     * @param done:对应的ChunkClosure
+     */
+    void CloneSubChunk(uint64_t index,
+                       int subIndex,
+                       ::google::protobuf::Closure *done);
+
+    /**
+     * 从本地chunk读一个子请求的数据
+     * @param sub:子请求
+     * @param data:出参，读到的数据
+     * @return 子请求的状态
+     */
+    CHUNK_OP_STATUS ReadLocalSubChunk(const ChunkRequest &sub,
+                                      butil::IOBuf *data);
+
+    /**
+     * 写一个子请求，leader和follower/日志回放共用
+     * @param datastore:chunk数据持久化层
+     * @param sub:子请求
+     * @param data:子请求的数据
+     * @return 子请求的状态
+     */
+    static CHUNK_OP_STATUS WriteSubChunk(std::shared_ptr<CSDataStore> datastore,
+                                         const ChunkRequest &sub,
+                                         const butil::IOBuf &data);
+
+    /**
+     * 所有子请求完成，拼接读数据，根据子请求的结果设置整个请求的状态，
+     * 更新applied index
+     */
+    void Finish(uint64_t index);
+
+    /**
+     * 对子请求分组，每组作为一个任务放入并发apply模块。写请求按chunk分组，
+     * 组内保持日志中的顺序；读请求之间没有顺序要求，每个子请求单独一组
+     */
+    static std::vector<std::vector<int>> GroupSubOps(
+        const ChunkRequest &request);
+
+    /**
+     * 把同一chunk的一组写子请求作为一个任务放入并发apply模块，
+     * 按组内子请求覆盖的范围分配队列
+     */
+    static void PushWriteGroup(ConcurrentApplyModule *applyModule,
+                               const ChunkRequest &request,
+                               const std::vector<int> &group,
+                               std::function<void()> task);
+
+    /**
+     * 按子请求的size切分数据
+     */
+    static std::vector<butil::IOBuf> SplitData(const ChunkRequest &request,
+                                               const butil::IOBuf &data);
+
+ private:
+    CloneManager* cloneMgr_;
+    // 还未完成的子请求分组和从clone源读取的子请求个数
+    std::atomic<uint32_t> pending_;
+    // 每个子请求的写入数据或者读到的数据
+    std::vector<butil::IOBuf> subData_;
+};
+
+/**
+ * leader上由ProposeBatcher合并propose的多个写请求，对应一条
+ * CHUNK_OP_WRITE_BATCH日志，只存在于内存中，follower和日志回放时这条日志被
+ * 反序列化为ChunkBatchRequest。apply时每个写请求按原来的方式放入并发apply
+ * 模块，各自返回
+ */
+class ProposeBatchRequest : public ChunkOpRequest {
+ public:
+    explicit ProposeBatchRequest(
+        std::vector<std::shared_ptr<ChunkOpRequest>> ops) :
+        ChunkOpRequest(),
+        ops_(std::move(ops)) {}
+    virtual ~ProposeBatchRequest() = default;
+
+    void OnApply(uint64_t index, ::google::protobuf::Closure *done) override;
+    void OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
+                        const ChunkRequest &request,
+                        const butil::IOBuf &data) override;
+    void ScheduleApply(uint64_t index,
+                       ::google::protobuf::Closure *done,
+                       ConcurrentApplyModule *applyModule) override;
+
+    /**
+     * 日志没有被apply时转发所有的写请求并返回
+     */
+    void RedirectChunkRequest() override;
+
+ private:
+    // 合并在这条日志中的写请求，保持propose的顺序
+    std::vector<std::shared_ptr<ChunkOpRequest>> ops_;
+};
+
 class ReadSnapshotRequest : public ChunkOpRequest {
  public:
     ReadSnapshotRequest() :
@@ -277,6 +563,7 @@ class ReadSnapshotRequest : public ChunkOpRequest {
                        done) {}
     virtual ~ReadSnapshotRequest() = default;
 
+    void Process() override;
     void OnApply(uint64_t index, ::google::protobuf::Closure *done) override;
     void OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
                         const ChunkRequest &request,
@@ -87,6 +87,24 @@ uint32_t GetChunkTrashedFunc(void* arg) {
     return chunkTrashed;
 }
 
+uint32_t GetChunkFdOpenFunc(void* arg) {
+    ChunkFdCache* fdCache = reinterpret_cast<ChunkFdCache*>(arg);
+    uint32_t openCount = 0;
+    if (fdCache != nullptr) {
+        openCount = fdCache->GetOpenCount();
+    }
+    return openCount;
+}
+
+uint64_t GetChunkFdMissFunc(void* arg) {
+    ChunkFdCache* fdCache = reinterpret_cast<ChunkFdCache*>(arg);
+    uint64_t missCount = 0;
+    if (fdCache != nullptr) {
+        missCount = fdCache->GetMissCount();
+    }
+    return missCount;
+}
+
 uint32_t GetTotalChunkCountFunc(void* arg) {
     uint32_t chunkCount = 0;
     ChunkServerMetric* csMetric = reinterpret_cast<ChunkServerMetric*>(arg);
@@ -117,5 +135,27 @@ uint32_t GetTotalCloneChunkCountFunc(void* arg) {
     return cloneChunkCount;
 }
 
+double GetLeaseReadRatioFunc(void* arg) {
+    ChunkServerMetric* csMetric = reinterpret_cast<ChunkServerMetric*>(arg);
+    uint64_t leaseRead = csMetric->GetReadCount(ReadPathType::kLease);
+    uint64_t total = leaseRead +
+                     csMetric->GetReadCount(ReadPathType::kAppliedIndex) +
+                     csMetric->GetReadCount(ReadPathType::kPropose) +
+                     csMetric->GetReadCount(ReadPathType::kFollower);
+    if (total == 0) {
+        return 0;
+    }
+    return static_cast<double>(leaseRead) / total;
+}
+
+double GetProposeBytesPerOpFunc(void* arg) {
+    ChunkServerMetric* csMetric = reinterpret_cast<ChunkServerMetric*>(arg);
+    uint64_t ops = csMetric->GetProposeOpCount();
+    if (ops == 0) {
+        return 0;
+    }
+    return static_cast<double>(csMetric->GetProposeBytes()) / ops;
+}
+
 }  // namespace chunkserver
 }  // namespace curve
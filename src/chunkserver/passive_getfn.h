@@ -26,6 +26,7 @@
 #include "src/chunkserver/trash.h"
 #include "src/chunkserver/copyset_node_manager.h"
 #include "src/chunkserver/datastore/file_pool.h"
+#include "src/chunkserver/datastore/chunkfile_fd_cache.h"
 
 namespace curve {
 namespace chunkserver {
@@ -75,6 +76,26 @@ namespace chunkserver {
      * @param arg: trash的对象指针
      */
     uint32_t GetChunkTrashedFunc(void* arg);
+    /**
+     * 获取fd缓存中打开的chunk文件和快照文件的数量
+     * @param arg: fd缓存的对象指针
+     */
+    uint32_t GetChunkFdOpenFunc(void* arg);
+    /**
+     * 获取fd被淘汰后重新打开文件的次数
+     * @param arg: fd缓存的对象指针
+     */
+    uint64_t GetChunkFdMissFunc(void* arg);
+    /**
+     * 获取通过leader lease直接处理的读请求占所有读请求的比例
+     * @param arg: chunkserver metric的对象指针
+     */
+    double GetLeaseReadRatioFunc(void* arg);
+    /**
+     * 获取propose的raft日志中平均每个请求占用的大小
+     * @param arg: chunkserver metric的对象指针
+     */
+    double GetProposeBytesPerOpFunc(void* arg);
 
 }  // namespace chunkserver
 }  // namespace curve
@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include "src/chunkserver/propose_batcher.h"
+
+#include <glog/logging.h>
+#include <bthread/bthread.h>
+#include <brpc/closure_guard.h>
+#include <braft/raft.h>
+
+#include <mutex>
+
+#include "src/chunkserver/copyset_node.h"
+#include "src/chunkserver/chunk_closure.h"
+#include "src/chunkserver/chunkserver_metrics.h"
+#include "src/chunkserver/op_request.h"
+
+namespace curve {
+namespace chunkserver {
+
+void ProposeBatcher::Propose(std::shared_ptr<ChunkOpRequest> op,
+                             const ChunkRequest *request,
+                             const butil::IOBuf *data,
+                             int64_t term) {
+    {
+        std::lock_guard<bthread::Mutex> lk(mtx_);
+        pending_.push_back({std::move(op), request, data, term});
+        if (flushing_) {
+            return;
+        }
+        flushing_ = true;
+    }
+
+    if (options_.waitUs > 0) {
+        bthread_usleep(options_.waitUs);
+    }
+    FlushOnce();
+}
+
+void ProposeBatcher::FlushOnce() {
+    // 请求持有copyset node，ops在函数退出时才析构，保证返回前batcher有效
+    std::vector<PendingOp> ops;
+    {
+        std::lock_guard<bthread::Mutex> lk(mtx_);
+        TakeBatch(&ops);
+    }
+    ProposeOps(ops.cbegin(), ops.cend());
+
+    {
+        std::lock_guard<bthread::Mutex> lk(mtx_);
+        if (pending_.empty()) {
+            flushing_ = false;
+            return;
+        }
+    }
+    // 剩下的请求不占用当前rpc的bthread，队列不为空时batcher一定有效
+    StartBackgroundFlush();
+}
+
+void ProposeBatcher::StartBackgroundFlush() {
+    bthread_t tid;
+    if (bthread_start_background(&tid, nullptr, RunBackgroundFlush, this)
+        != 0) {
+        LOG(ERROR) << "start bthread for propose batch failed";
+        FlushOnce();
+    }
+}
+
+void* ProposeBatcher::RunBackgroundFlush(void *arg) {
+    static_cast<ProposeBatcher *>(arg)->FlushOnce();
+    return nullptr;
+}
+
+void ProposeBatcher::TakeBatch(std::vector<PendingOp> *ops) {
+    uint64_t bytes = 0;
+    while (!pending_.empty()) {
+        const PendingOp &next = pending_.front();
+        uint32_t size = next.request->size();
+        // 至少取一个请求，不同任期的请求不合并
+        if (!ops->empty() && (ops->size() >= options_.maxOps
+                              || bytes + size > options_.maxBytes
+                              || next.term != ops->front().term)) {
+            break;
+        }
+        bytes += size;
+        ops->push_back(std::move(pending_.front()));
+        pending_.pop_front();
+    }
+}
+
+void ProposeBatcher::ProposeOps(std::vector<PendingOp>::const_iterator begin,
+                                std::vector<PendingOp>::const_iterator end) {
+    braft::Task task;
+    butil::IOBuf log;
+    std::shared_ptr<ChunkOpRequest> opRequest;
+    int ret;
+    if (end - begin == 1) {
+        opRequest = begin->op;
+        ret = ChunkOpRequest::Encode(begin->request, begin->data, &log);
+    } else {
+        // 子请求保持到达的顺序，follower按日志中的顺序apply
+        ChunkRequest batch;
+        batch.set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH);
+        batch.set_logicpoolid(begin->request->logicpoolid());
+        batch.set_copysetid(begin->request->copysetid());
+        batch.set_chunkid(0);
+        butil::IOBuf data;
+        std::vector<std::shared_ptr<ChunkOpRequest>> ops;
+        for (auto iter = begin; iter != end; ++iter) {
+            batch.add_subrequests()->CopyFrom(*iter->request);
+            data.append(*iter->data);
+            ops.push_back(iter->op);
+        }
+        opRequest = std::make_shared<ProposeBatchRequest>(std::move(ops));
+        ret = ChunkOpRequest::Encode(&batch, &data, &log);
+    }
+
+    if (0 != ret) {
+        LOG(ERROR) << "chunk op request encode failure";
+        for (auto iter = begin; iter != end; ++iter) {
+            brpc::ClosureGuard doneGuard(iter->op->Closure());
+            iter->op->response_->set_status(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN);
+        }
+        return;
+    }
+
+    // propose之后log中的数据会被raft取走，需要提前记录日志大小
+    ChunkServerMetric::GetInstance()->OnPropose(end - begin, log.size());
+
+    task.data = &log;
+    task.done = new ChunkClosure(opRequest);
+    task.expected_term = begin->term;
+    node_->Propose(task);
+}
+
+}  // namespace chunkserver
+}  // namespace curve
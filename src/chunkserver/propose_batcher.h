@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#ifndef SRC_CHUNKSERVER_PROPOSE_BATCHER_H_
+#define SRC_CHUNKSERVER_PROPOSE_BATCHER_H_
+
+#include <butil/iobuf.h>
+#include <bthread/mutex.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "proto/chunk.pb.h"
+
+namespace curve {
+namespace chunkserver {
+
+class CopysetNode;
+class ChunkOpRequest;
+
+struct ProposeBatchOptions {
+    // 一条日志最多合并的请求个数，为0或1时不合并
+    uint32_t maxOps = 0;
+    // 一条日志最多合并的数据量
+    uint32_t maxBytes = 1024 * 1024;
+    // 开始propose前等待更多请求到达的时间，为0时不等待，只合并上一批
+    // propose期间到达的请求
+    uint32_t waitUs = 0;
+};
+
+/**
+ * 把同一copyset上并发到达的写请求合并为一条CHUNK_OP_WRITE_BATCH日志propose，
+ * 减少raft日志条数以及每条日志的header和checksum开销。
+ * 第一个到达的请求所在的bthread只propose一批，其间到达的请求只放入队列，
+ * 队列不为空时交给后台bthread每次propose一批，队列为空时退出
+ */
+class ProposeBatcher {
+ public:
+    ProposeBatcher(CopysetNode *node, const ProposeBatchOptions &options)
+        : node_(node),
+          options_(options),
+          flushing_(false) {}
+
+    /**
+     * 提交一个写请求，调用之后请求的done由batcher负责返回
+     * @param op: 写请求
+     * @param request: 请求的ChunkRequest
+     * @param data: 请求的写数据
+     * @param term: 请求到达时leader的任期，不同任期的请求不会合并
+     */
+    void Propose(std::shared_ptr<ChunkOpRequest> op,
+                 const ChunkRequest *request,
+                 const butil::IOBuf *data,
+                 int64_t term);
+
+ private:
+    struct PendingOp {
+        std::shared_ptr<ChunkOpRequest> op;
+        const ChunkRequest *request;
+        const butil::IOBuf *data;
+        int64_t term;
+    };
+
+    /**
+     * 从队列头部取出一批请求propose，队列中还有请求时启动后台bthread
+     * 继续propose，否则结束这一轮
+     */
+    void FlushOnce();
+
+    /**
+     * 启动后台bthread执行FlushOnce，失败时在当前bthread中执行
+     */
+    void StartBackgroundFlush();
+
+    static void* RunBackgroundFlush(void *arg);
+
+    /**
+     * 按个数、数据量和任期从队列头部取出一批请求，调用者需持有mtx_
+     * @param ops: 出参，取出的请求
+     */
+    void TakeBatch(std::vector<PendingOp> *ops);
+
+    /**
+     * 把[begin, end)中的请求作为一条日志propose，只有一个请求时按原来的
+     * 格式编码
+     */
+    void ProposeOps(std::vector<PendingOp>::const_iterator begin,
+                    std::vector<PendingOp>::const_iterator end);
+
+ private:
+    CopysetNode *node_;
+    ProposeBatchOptions options_;
+    // 保护pending_和flushing_，propose在bthread中执行，使用bthread锁
+    bthread::Mutex mtx_;
+    // 等待propose的请求
+    std::deque<PendingOp> pending_;
+    // 是否已经有bthread在负责propose
+    bool flushing_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_PROPOSE_BATCHER_H_
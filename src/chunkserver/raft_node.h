@@ -49,6 +49,10 @@ class RaftNode {
         return node_->is_leader();
     }
 
+    virtual bool is_leader_lease_valid() {
+        return node_->is_leader_lease_valid();
+    }
+
     virtual int init(const braft::NodeOptions& options) {
         return node_->init(options);
     }
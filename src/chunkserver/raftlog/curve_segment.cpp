@@ -39,12 +39,15 @@
 //          Xiong,Kai(xiongkai@baidu.com)
 
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <butil/fd_utility.h>
 #include <butil/raw_pack.h>
 #include <braft/local_storage.pb.h>
 #include <braft/fsync.h>
 #include "src/chunkserver/raftlog/curve_segment.h"
 #include "src/chunkserver/raftlog/define.h"
+#include "src/common/crc32.h"
 
 namespace curve {
 namespace chunkserver {
@@ -52,6 +55,8 @@ namespace chunkserver {
 DEFINE_bool(raftSyncSegments, true, "call fsync when a segment is closed");
 DEFINE_bool(enableWalDirectWrite, true, "enable wal direct write or not");
 DEFINE_uint32(walAlignSize, 4096, "wal align size to write");
+DEFINE_bool(enableWalSegmentIndex, true, "write an index file when a segment "
+            "is closed and use it to load the segment instead of scanning");
 
 std::shared_ptr<FilePool> kWalFilePool = nullptr;
 
@@ -146,6 +151,12 @@ int CurveSegment::load(braft::ConfigurationManager* configuration_manager) {
         return -1;
     }
 
+    // closed segment优先通过索引文件加载，不用读取每个entry
+    if (!_is_open && FLAGS_enableWalSegmentIndex &&
+        _load_index(configuration_manager) == 0) {
+        return 0;
+    }
+
     // load entry index
     int64_t load_size = _meta.bytes;
     int64_t entry_off = _meta_page_size;
@@ -185,6 +196,7 @@ int CurveSegment::load(braft::ConfigurationManager* configuration_manager) {
             if (status.ok()) {
                 braft::ConfigurationEntry conf_entry(*entry);
                 configuration_manager->add(conf_entry);
+                _configuration_indexes.insert(i);
             } else {
                 LOG(ERROR) << "fail to parse configuration meta, path: "
                            << _path << " entry_off " << entry_off;
@@ -225,9 +237,203 @@ int CurveSegment::load(braft::ConfigurationManager* configuration_manager) {
     ::lseek(_fd, entry_off, SEEK_SET);
 
     _meta.bytes = entry_off;
+
+    // 之前没有索引或者索引失效的closed segment，补写索引，下次直接加载
+    if (!_is_open && FLAGS_enableWalSegmentIndex) {
+        _save_index(false);
+    }
     return ret;
 }
 
+std::string CurveSegment::_index_path() const {
+    std::string path(_path);
+    butil::string_appendf(&path,
+                          "/" CURVE_SEGMENT_CLOSED_PATTERN
+                          CURVE_SEGMENT_INDEX_SUFFIX,
+                          _first_index, _last_index.load());
+    return path;
+}
+
+int CurveSegment::_save_index(bool will_sync) {
+    const size_t num = _offset_and_term.size();
+    const size_t records_size = num * kSegmentIndexRecordSize;
+    const size_t size = kSegmentIndexHeaderSize + records_size;
+    std::unique_ptr<char[]> buf(new char[size]);
+    char* records = buf.get() + kSegmentIndexHeaderSize;
+    for (size_t i = 0; i < num; ++i) {
+        uint32_t type = _configuration_indexes.count(_first_index + i) ?
+                braft::ENTRY_TYPE_CONFIGURATION : braft::ENTRY_TYPE_DATA;
+        butil::RawPacker packer(records + i * kSegmentIndexRecordSize);
+        packer.pack64(_offset_and_term[i].first)
+              .pack64(_offset_and_term[i].second)
+              .pack32(type);
+    }
+    butil::RawPacker packer(buf.get());
+    packer.pack32(kSegmentIndexMagic)
+          .pack32(kSegmentIndexVersion)
+          .pack64(_first_index)
+          .pack64(_last_index.load())
+          .pack64(_meta.bytes)
+          .pack32(curve::common::CRC32(records, records_size));
+    packer.pack32(
+        curve::common::CRC32(buf.get(), kSegmentIndexHeaderSize - 4));
+
+    // 先写临时文件再rename，避免留下写了一半的索引
+    std::string path = _index_path();
+    std::string tmp_path = path + ".tmp";
+    int fd = ::open(tmp_path.c_str(), O_RDWR|O_CREAT|O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG(WARNING) << "Fail to open " << tmp_path << ", " << berror();
+        return -1;
+    }
+    ssize_t written = 0;
+    while (written < (ssize_t)size) {
+        ssize_t n = ::pwrite(fd, buf.get() + written, size - written, written);
+        if (n < 0) {
+            LOG(WARNING) << "Fail to write " << tmp_path << ", " << berror();
+            ::close(fd);
+            ::unlink(tmp_path.c_str());
+            return -1;
+        }
+        written += n;
+    }
+    if (will_sync && braft::raft_fsync(fd) != 0) {
+        LOG(WARNING) << "Fail to sync " << tmp_path << ", " << berror();
+        ::close(fd);
+        ::unlink(tmp_path.c_str());
+        return -1;
+    }
+    ::close(fd);
+    if (::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        LOG(WARNING) << "Fail to rename `" << tmp_path << "' to `"
+                     << path << "', " << berror();
+        ::unlink(tmp_path.c_str());
+        return -1;
+    }
+    return 0;
+}
+
+int CurveSegment::_load_index(
+                braft::ConfigurationManager* configuration_manager) {
+    std::string path = _index_path();
+    int fd = ::open(path.c_str(), O_RDONLY|O_NOATIME);
+    if (fd < 0) {
+        LOG_IF(WARNING, errno != ENOENT) << "Fail to open " << path
+                                         << ", " << berror();
+        return -1;
+    }
+    const int64_t last_index = _last_index.load();
+    const size_t num = last_index - _first_index + 1;
+    const size_t records_size = num * kSegmentIndexRecordSize;
+    const size_t size = kSegmentIndexHeaderSize + records_size;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size != (off_t)size) {
+        LOG(WARNING) << "Segment index " << path << " has wrong size, "
+                     << "expect " << size << ", scan the segment";
+        ::close(fd);
+        return -1;
+    }
+    void* addr = ::mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        LOG(WARNING) << "Fail to mmap " << path << ", " << berror();
+        return -1;
+    }
+
+    const char* p = static_cast<const char*>(addr);
+    const char* records = p + kSegmentIndexHeaderSize;
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    int64_t first = 0;
+    int64_t last = 0;
+    int64_t bytes = 0;
+    uint32_t records_checksum = 0;
+    uint32_t header_checksum = 0;
+    butil::RawUnpacker(p).unpack32(magic)
+                         .unpack32(version)
+                         .unpack64((uint64_t&)first)
+                         .unpack64((uint64_t&)last)
+                         .unpack64((uint64_t&)bytes)
+                         .unpack32(records_checksum)
+                         .unpack32(header_checksum);
+    bool valid = magic == kSegmentIndexMagic &&
+                 version == kSegmentIndexVersion &&
+                 header_checksum ==
+                    curve::common::CRC32(p, kSegmentIndexHeaderSize - 4) &&
+                 first == _first_index && last == last_index &&
+                 bytes == _meta.bytes &&
+                 records_checksum ==
+                    curve::common::CRC32(records, records_size);
+
+    std::vector<std::pair<int64_t, int64_t> > offset_and_term;
+    std::vector<int64_t> conf_indexes;
+    offset_and_term.reserve(num);
+    int64_t prev_offset = _meta_page_size - 1;
+    for (size_t i = 0; valid && i < num; ++i) {
+        int64_t offset = 0;
+        int64_t term = 0;
+        uint32_t type = 0;
+        butil::RawUnpacker(records + i * kSegmentIndexRecordSize)
+                .unpack64((uint64_t&)offset)
+                .unpack64((uint64_t&)term)
+                .unpack32(type);
+        if (offset <= prev_offset || offset >= bytes) {
+            valid = false;
+            break;
+        }
+        if (type == braft::ENTRY_TYPE_CONFIGURATION) {
+            conf_indexes.push_back(_first_index + i);
+        }
+        offset_and_term.push_back(std::make_pair(offset, term));
+        prev_offset = offset;
+    }
+    ::munmap(addr, size);
+    if (!valid) {
+        LOG(WARNING) << "Segment index " << path
+                     << " mismatch with the segment, scan the segment";
+        return -1;
+    }
+
+    // 配置变更entry仍然需要读出来，先全部解析成功再加入configuration_manager，
+    // 失败时回退到扫描，避免重复添加
+    std::vector<braft::ConfigurationEntry> conf_entries;
+    for (int64_t index : conf_indexes) {
+        size_t i = index - _first_index;
+        int64_t next_offset = (i + 1 < num) ?
+                        offset_and_term[i + 1].first : _meta.bytes;
+        EntryHeader header;
+        butil::IOBuf data;
+        if (_load_entry(offset_and_term[i].first, &header, &data,
+                        next_offset - offset_and_term[i].first) != 0 ||
+            header.type != braft::ENTRY_TYPE_CONFIGURATION ||
+            header.term != offset_and_term[i].second) {
+            LOG(WARNING) << "Segment index " << path << " mismatch with "
+                         << "configuration entry " << index
+                         << ", scan the segment";
+            return -1;
+        }
+        scoped_refptr<braft::LogEntry> entry = new braft::LogEntry();
+        entry->id.index = index;
+        entry->id.term = header.term;
+        butil::Status status = parse_configuration_meta(data, entry);
+        if (!status.ok()) {
+            LOG(WARNING) << "fail to parse configuration meta, path: "
+                         << _path << " index: " << index
+                         << ", scan the segment";
+            return -1;
+        }
+        conf_entries.push_back(braft::ConfigurationEntry(*entry));
+    }
+    for (const auto& conf_entry : conf_entries) {
+        configuration_manager->add(conf_entry);
+    }
+    _configuration_indexes.insert(conf_indexes.begin(), conf_indexes.end());
+    _offset_and_term.swap(offset_and_term);
+    ::lseek(_fd, _meta.bytes, SEEK_SET);
+    BRAFT_VLOG << "Loaded segment " << path << " by index, entries: " << num;
+    return 0;
+}
+
 int CurveSegment::_load_meta() {
     char* metaPage = new char[_meta_page_size];
     int res = ::pread(_fd, metaPage, _meta_page_size, 0);
@@ -241,13 +447,26 @@ int CurveSegment::_load_meta() {
     return 0;
 }
 
+// 和braft::crc32结果相同，按IOBuf的block分别用交错的crc32指令计算
+inline uint32_t crc32c(const butil::IOBuf& data) {
+    uint32_t crc = 0;
+    const size_t block_num = data.backing_block_num();
+    for (size_t i = 0; i < block_num; ++i) {
+        butil::StringPiece sp = data.backing_block(i);
+        if (!sp.empty()) {
+            crc = curve::common::CRC32(crc, sp.data(), sp.size());
+        }
+    }
+    return crc;
+}
+
 inline bool verify_checksum(int checksum_type,
                             const char* data, size_t len, uint32_t value) {
     switch (checksum_type) {
     case CHECKSUM_MURMURHASH32:
         return (value == braft::murmurhash32(data, len));
     case CHECKSUM_CRC32:
-        return (value == braft::crc32(data, len));
+        return (value == curve::common::CRC32(data, len));
     default:
         LOG(ERROR) << "Unknown checksum_type=" << checksum_type;
         return false;
@@ -260,7 +479,7 @@ inline bool verify_checksum(int checksum_type,
     case CHECKSUM_MURMURHASH32:
         return (value == braft::murmurhash32(data));
     case CHECKSUM_CRC32:
-        return (value == braft::crc32(data));
+        return (value == crc32c(data));
     default:
         LOG(ERROR) << "Unknown checksum_type=" << checksum_type;
         return false;
@@ -272,7 +491,7 @@ inline uint32_t get_checksum(int checksum_type, const char* data, size_t len) {
     case CHECKSUM_MURMURHASH32:
         return braft::murmurhash32(data, len);
     case CHECKSUM_CRC32:
-        return braft::crc32(data, len);
+        return curve::common::CRC32(data, len);
     default:
         CHECK(false) << "Unknown checksum_type=" << checksum_type;
         abort();
@@ -285,7 +504,7 @@ inline uint32_t get_checksum(int checksum_type, const butil::IOBuf& data) {
     case CHECKSUM_MURMURHASH32:
         return braft::murmurhash32(data);
     case CHECKSUM_CRC32:
-        return braft::crc32(data);
+        return crc32c(data);
     default:
         CHECK(false) << "Unknown checksum_type=" << checksum_type;
         abort();
@@ -463,6 +682,9 @@ int CurveSegment::append(const braft::LogEntry* entry) {
     }
     {
         BAIDU_SCOPED_LOCK(_mutex);
+        if (entry->type == braft::ENTRY_TYPE_CONFIGURATION) {
+            _configuration_indexes.insert(entry->id.index);
+        }
         _offset_and_term.push_back(std::make_pair(_meta.bytes, entry->id.term));
         _last_index.fetch_add(1, butil::memory_order_relaxed);
         _meta.bytes += to_write;
@@ -617,6 +839,10 @@ int CurveSegment::close(bool will_sync) {
         LOG_IF(ERROR, rc != 0) << "Fail to rename `" << old_path
                                << "' to `" << new_path <<"\', "
                                << berror();
+        // 索引写失败不影响正确性，下次加载时扫描segment即可
+        if (rc == 0 && FLAGS_enableWalSegmentIndex) {
+            _save_index(FLAGS_raftSyncSegments && will_sync);
+        }
         return rc;
     }
     return ret;
@@ -658,6 +884,7 @@ int CurveSegment::unlink() {
     } else {
         butil::string_appendf(&path, "/" CURVE_SEGMENT_CLOSED_PATTERN,
                              _first_index, _last_index.load());
+        ::unlink(_index_path().c_str());
     }
     int res = kWalFilePool->RecycleFile(path);
     if (res != 0) {
@@ -685,6 +912,12 @@ int CurveSegment::truncate(const int64_t last_index_kept) {
     // Truncate on a full segment need to rename back to inprogess segment
     // again, because the node may crash before truncate.
     if (!_is_open) {
+        // 先删除索引，避免索引和truncate之后的segment不一致
+        std::string index_path = _index_path();
+        if (::unlink(index_path.c_str()) != 0 && errno != ENOENT) {
+            LOG(ERROR) << "Fail to unlink " << index_path << ", " << berror();
+            return -1;
+        }
         std::string old_path(_path);
         butil::string_appendf(&old_path, "/" CURVE_SEGMENT_CLOSED_PATTERN,
                               _first_index, _last_index.load());
@@ -719,6 +952,9 @@ int CurveSegment::truncate(const int64_t last_index_kept) {
     lck.lock();
     // update memory var
     _offset_and_term.resize(first_truncate_in_offset);
+    _configuration_indexes.erase(
+        _configuration_indexes.upper_bound(last_index_kept),
+        _configuration_indexes.end());
     _last_index.store(last_index_kept, butil::memory_order_relaxed);
     _meta.bytes = truncate_size;
     return 0;
@@ -48,6 +48,7 @@
 #include <braft/storage.h>
 #include <braft/util.h>
 #include <vector>
+#include <set>
 #include <memory>
 #include <algorithm>
 #include <utility>
@@ -159,6 +160,16 @@ class BAIDU_CACHELINE_ALIGNMENT CurveSegment:
 
     int _update_meta_page();
 
+    // closed segment的索引文件路径
+    std::string _index_path() const;
+
+    // 把每个entry的offset和term写入索引文件，在segment关闭时调用
+    int _save_index(bool will_sync);
+
+    // 通过mmap加载closed segment的索引文件，索引不存在或者和segment
+    // 不一致时返回-1，需要回退到扫描整个segment
+    int _load_index(braft::ConfigurationManager* configuration_manager);
+
     std::string _path;
     CurveSegmentMeta _meta;
     mutable braft::raft_mutex_t _mutex;
@@ -169,6 +180,8 @@ class BAIDU_CACHELINE_ALIGNMENT CurveSegment:
     butil::atomic<int64_t> _last_index;
     int _checksum_type;
     std::vector<std::pair<int64_t, int64_t> > _offset_and_term;
+    // 配置变更entry的index，写索引文件时需要记录entry类型
+    std::set<int64_t> _configuration_indexes;
     uint32_t _meta_page_size;
 };
 
@@ -88,7 +88,14 @@ int CurveSegmentLogStorage::init(
             break;
         }
 
+        butil::Timer timer;
+        timer.start();
         ret = load_segments(configuration_manager);
+        timer.stop();
+        LOG(INFO) << "log load_segments " << _path
+                  << " closed segments: " << _segments.size()
+                  << " ret: " << ret
+                  << " time: " << timer.u_elapsed();
         if (ret != 0) {
             break;
         }
@@ -152,6 +159,11 @@ int CurveSegmentLogStorage::list_segments(bool is_empty) {
             continue;
         }
 
+        // segment的索引文件随segment一起加载
+        if (IsSegmentIndexFile(dir_reader.name())) {
+            continue;
+        }
+
         // Is braft log pattern
         int match = 0;
         int64_t first_index = 0;
@@ -40,6 +40,9 @@
 
 #ifndef SRC_CHUNKSERVER_RAFTLOG_DEFINE_H_
 #define SRC_CHUNKSERVER_RAFTLOG_DEFINE_H_
+
+#include <string.h>
+
 namespace curve {
 namespace chunkserver {
 
@@ -58,6 +61,32 @@ namespace chunkserver {
 
 const size_t kEntryHeaderSize = 28;
 
+// closed segment的索引文件名为closed segment文件名加上该后缀
+#define CURVE_SEGMENT_INDEX_SUFFIX ".index"
+
+// Format of segment index file, all fields are in network order
+// | ------------------ magic (32bits) -------------------------  |
+// | ------------------ version (32bits) -----------------------  |
+// | ------------------ first_index (64bits) -------------------  |
+// | ------------------ last_index (64bits) --------------------  |
+// | ------------------ bytes (64bits) -------------------------  |
+// | records checksum (32bits) | header checksum (32bits)         |
+// Followed by one record for each entry:
+// | offset (64bits) | term (64bits) | entry-type (32bits)        |
+
+const size_t kSegmentIndexHeaderSize = 40;
+const size_t kSegmentIndexRecordSize = 20;
+const uint32_t kSegmentIndexMagic = 0x43534958;
+const uint32_t kSegmentIndexVersion = 1;
+
+// 索引文件名也能匹配CURVE_SEGMENT_CLOSED_PATTERN，解析segment文件名前先排除
+inline bool IsSegmentIndexFile(const char* name) {
+    size_t name_len = strlen(name);
+    size_t suffix_len = strlen(CURVE_SEGMENT_INDEX_SUFFIX);
+    return name_len > suffix_len &&
+        0 == strcmp(name + name_len - suffix_len, CURVE_SEGMENT_INDEX_SUFFIX);
+}
+
 enum CheckSumType {
     CHECKSUM_MURMURHASH32 = 0,
     CHECKSUM_CRC32 = 1,
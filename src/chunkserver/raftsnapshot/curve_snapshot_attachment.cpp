@@ -27,8 +27,8 @@ namespace curve {
 namespace chunkserver {
 
 CurveSnapshotAttachment::CurveSnapshotAttachment(
-    std::shared_ptr<LocalFileSystem> fs)
-    : fileHelper_(fs) {}
+    std::shared_ptr<LocalFileSystem> fs, SnapshotFileLister lister)
+    : fileHelper_(fs), lister_(lister) {}
 
 void CurveSnapshotAttachment::list_attach_files(
     std::vector<std::string> *files, const std::string& raftSnapshotPath) {
@@ -42,10 +42,14 @@ void CurveSnapshotAttachment::list_attach_files(
     }
 
     std::vector<std::string> snapFiles;
-    int rc = fileHelper_.ListFiles(dataDir, nullptr, &snapFiles);
-    // list出错一般认为就是磁盘出现问题了，这种情况直接让进程挂掉
-    // Attention: 这里还需要更仔细考虑
-    CHECK(rc == 0) << "List dir failed.";
+    // 优先从copyset的chunk清单获取，不访问磁盘
+    if (lister_ == nullptr || !lister_(raftBaseDir, &snapFiles)) {
+        snapFiles.clear();
+        int rc = fileHelper_.ListFiles(dataDir, nullptr, &snapFiles);
+        // list出错一般认为就是磁盘出现问题了，这种情况直接让进程挂掉
+        // Attention: 这里还需要更仔细考虑
+        CHECK(rc == 0) << "List dir failed.";
+    }
 
     files->clear();
     // 文件路径格式与snapshot_meta中的格式要相同
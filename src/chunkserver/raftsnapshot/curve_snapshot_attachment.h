@@ -23,6 +23,7 @@
 #define SRC_CHUNKSERVER_RAFTSNAPSHOT_CURVE_SNAPSHOT_ATTACHMENT_H_
 
 #include <braft/snapshot.h>
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
@@ -52,10 +53,22 @@ class SnapshotAttachment :
         const std::string& raftSnapshotPath) = 0;
 };
 
+/**
+ * 获取chunk快照文件名的回调，参数为raft实例的基础目录
+ * 返回false时改为list数据目录获取
+ */
+using SnapshotFileLister = std::function<bool(const std::string&,
+                                              std::vector<std::string>*)>;
+
 // SnapshotAttachment接口的实现，用于raft加载快照时，获取chunk快照文件列表
 class CurveSnapshotAttachment : public SnapshotAttachment {
  public:
-    explicit CurveSnapshotAttachment(std::shared_ptr<LocalFileSystem> fs);
+    /**
+     * @param fs: 本地文件系统，lister获取失败时用来list数据目录
+     * @param lister: 从内存中的chunk清单获取快照文件名，为空时总是list目录
+     */
+    explicit CurveSnapshotAttachment(std::shared_ptr<LocalFileSystem> fs,
+                                     SnapshotFileLister lister = nullptr);
     virtual ~CurveSnapshotAttachment() = default;
     /**
      * 获取raft snapshot的attachment，这里就是获取chunk的快照文件列表
@@ -67,6 +80,7 @@ class CurveSnapshotAttachment : public SnapshotAttachment {
                            const std::string& raftSnapshotPath) override;
  private:
     DatastoreFileHelper fileHelper_;
+    SnapshotFileLister lister_;
 };
 
 /*
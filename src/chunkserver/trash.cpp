@@ -277,6 +277,10 @@ bool Trash::RecycleWAL(
 }
 
 bool Trash::IsWALFile(const std::string &fileName) {
+    // segment的索引文件不是从walpool分配的，随copyset目录一起删除
+    if (IsSegmentIndexFile(fileName.c_str())) {
+        return false;
+    }
     int match = 0;
     int64_t first_index = 0;
     int64_t last_index = 0;
@@ -25,6 +25,8 @@
 #include <string>
 #include <memory>
 #include <algorithm>
+#include <sstream>
+#include <unordered_map>
 
 #include "src/client/client_common.h"
 #include "src/client/copyset_client.h"
@@ -172,6 +174,17 @@ void ClientClosure::Run() {
 
     bool needRetry = false;
 
+    if (cntl_->Failed() && cntlstatus_ == brpc::ENOMETHOD) {
+        // chunkserver版本较老，不支持该rpc，重试也不会成功，
+        // 直接返回由上层降级处理
+        LOG(WARNING) << OpTypeToString(reqCtx_->optype_)
+            << " not supported by chunkserver, " << *reqCtx_
+            << ", remote side = "
+            << butil::endpoint2str(cntl_->remote_side()).c_str();
+        reqDone_->SetFailed(cntlstatus_);
+        return;
+    }
+
     if (cntl_->Failed()) {
         needRetry = true;
         OnRpcFailed();
@@ -308,7 +321,10 @@ void ClientClosure::ProcessUnstableState() {
         break;
     }
     case UnstableState::NoUnstable: {
-        RefreshLeader();
+        // follower读失败不代表leader变了，重试时直接发往leader
+        if (!reqDone_->IsFollowerRead()) {
+            RefreshLeader();
+        }
         break;
     }
     default:
@@ -323,6 +339,56 @@ void ClientClosure::OnSuccess() {
     MetricHelper::LatencyRecord(fileMetric_, duration, reqCtx_->optype_);
     MetricHelper::IncremRPCQPSCount(
         fileMetric_, reqCtx_->rawlength_, reqCtx_->optype_);
+
+    if (reqCtx_->traced_) {
+        OnTrace();
+    }
+}
+
+void ClientClosure::OnTrace() {
+    if (fileMetric_ == nullptr) {
+        return;
+    }
+
+    OpTraceMetric* metric = &fileMetric_->trace;
+    uint64_t rpcUs = cntl_->latency_us();
+    metric->scheduleQueue << reqCtx_->scheduleQueueUs_;
+    metric->rpc << rpcUs;
+
+    // 老版本的chunkserver不会返回trace信息，此时rpc耗时全部算作网络耗时
+    curve::chunkserver::OpTrace trace;
+    if (response_->has_trace()) {
+        trace = response_->trace();
+        metric->server << trace.totalus();
+        if (trace.has_raftus()) {
+            metric->raft << trace.raftus();
+        }
+        if (trace.has_applyqueueus()) {
+            metric->applyQueue << trace.applyqueueus();
+        }
+        if (trace.has_storageus()) {
+            metric->storage << trace.storageus();
+        }
+    }
+    uint64_t networkUs = rpcUs > trace.totalus() ? rpcUs - trace.totalus() : 0;
+    metric->network << networkUs;
+
+    uint64_t totalUs = reqCtx_->scheduleQueueUs_ + rpcUs;
+    if (!metric->slowOps.Accept(totalUs)) {
+        return;
+    }
+    std::ostringstream desc;
+    desc << OpTypeToString(reqCtx_->optype_) << " " << *reqCtx_
+         << ", retried times = " << reqDone_->GetRetriedTimes()
+         << ", remote side = "
+         << butil::endpoint2str(cntl_->remote_side()).c_str()
+         << ", schedule_queue: " << reqCtx_->scheduleQueueUs_
+         << "us network: " << networkUs
+         << "us raft: " << trace.raftus()
+         << "us apply_queue: " << trace.applyqueueus()
+         << "us storage: " << trace.storageus()
+         << "us server: " << trace.totalus() << "us";
+    metric->slowOps.Add(totalUs, desc.str());
 }
 
 void ClientClosure::OnChunkNotExist() {
@@ -357,6 +423,12 @@ void ClientClosure::OnChunkExist() {
 }
 
 void ClientClosure::OnRedirected() {
+    // follower的applied index还没有追上，重试时直接发往leader，不需要刷新leader
+    if (reqDone_->IsFollowerRead()) {
+        retryDirectly_ = true;
+        return;
+    }
+
     LOG(WARNING) << OpTypeToString(reqCtx_->optype_) << " redirected, "
         << *reqCtx_
         << ", status = " << status_
@@ -541,10 +613,18 @@ void GetChunkInfoClosure::SendRetryRequest() {
 void GetChunkInfoClosure::OnSuccess() {
     ClientClosure::OnSuccess();
 
+    if (chunkinforesponse_->has_appliedindex()) {
+        metaCache_->UpdateAppliedIndex(chunkIdInfo_.lpid_, chunkIdInfo_.cpid_,
+                                       chunkinforesponse_->appliedindex());
+    }
+
     for (int i = 0; i < chunkinforesponse_->chunksn_size(); ++i) {
         reqCtx_->chunkinfodetail_->chunkSn.push_back(
             chunkinforesponse_->chunksn(i));
     }
+    if (chunkinforesponse_->has_isclone()) {
+        reqCtx_->chunkinfodetail_->isClone = chunkinforesponse_->isclone();
+    }
 }
 
 void GetChunkInfoClosure::OnRedirected() {
@@ -570,6 +650,68 @@ void GetChunkInfoClosure::OnRedirected() {
     RefreshLeader();
 }
 
+void GetChunksInfoClosure::SendRetryRequest() {
+    client_->GetChunksInfo(reqCtx_->idinfo_, reqCtx_->chunkIds_, done_);
+}
+
+void GetChunksInfoClosure::OnSuccess() {
+    ClientClosure::OnSuccess();
+
+    if (chunksinforesponse_->has_appliedindex()) {
+        metaCache_->UpdateAppliedIndex(chunkIdInfo_.lpid_, chunkIdInfo_.cpid_,
+                                       chunksinforesponse_->appliedindex());
+    }
+
+    auto *details = reqCtx_->chunkinfodetails_;
+    details->clear();
+    details->resize(reqCtx_->chunkIds_.size());
+    // 按chunkId匹配，不依赖返回的顺序
+    std::unordered_map<ChunkID, size_t> indexes;
+    for (size_t i = 0; i < reqCtx_->chunkIds_.size(); ++i) {
+        indexes[reqCtx_->chunkIds_[i]] = i;
+    }
+    for (int i = 0; i < chunksinforesponse_->chunkinfos_size(); ++i) {
+        const auto &summary = chunksinforesponse_->chunkinfos(i);
+        auto it = indexes.find(summary.chunkid());
+        if (it == indexes.end()) {
+            continue;
+        }
+        ChunkInfoDetail &detail = (*details)[it->second];
+        for (int j = 0; j < summary.chunksn_size(); ++j) {
+            detail.chunkSn.push_back(summary.chunksn(j));
+        }
+        if (summary.has_isclone()) {
+            detail.isClone = summary.isclone();
+        }
+        detail.correctedSn = summary.correctedsn();
+        detail.writtenPageNum = summary.writtenpagenum();
+    }
+}
+
+void GetChunksInfoClosure::OnRedirected() {
+    LOG(WARNING) << OpTypeToString(reqCtx_->optype_)
+        << " redirected, " << *reqCtx_
+        << ", status = " << status_
+        << ", retried times = " << reqDone_->GetRetriedTimes()
+        << ", IO id = " << reqDone_->GetIOTracker()->GetID()
+        << ", request id = " << reqCtx_->id_
+        << ", redirect leader is "
+        << (chunksinforesponse_->has_redirect() ?
+            chunksinforesponse_->redirect() : "empty")
+        << ", remote side = "
+        << butil::endpoint2str(cntl_->remote_side()).c_str();
+
+    if (chunksinforesponse_->has_redirect()) {
+        int ret = UpdateLeaderWithRedirectInfo(
+            chunksinforesponse_->redirect());
+        if (0 == ret) {
+            return;
+        }
+    }
+
+    RefreshLeader();
+}
+
 void CreateCloneChunkClosure::SendRetryRequest() {
     client_->CreateCloneChunk(reqCtx_->idinfo_,
                               reqCtx_->location_,
@@ -617,5 +759,110 @@ int ClientClosure::UpdateLeaderWithRedirectInfo(const std::string& leaderInfo) {
     return 0;
 }
 
+void BatchChunkClosure::Run() {
+    std::unique_ptr<BatchChunkClosure> selfGuard(this);
+    std::unique_ptr<brpc::Controller> cntlGuard(cntl_);
+
+    if (cntl_->Failed()) {
+        if (cntl_->ErrorCode() == brpc::ENOMETHOD) {
+            LOG(WARNING) << "chunkserver " << chunkserverID_
+                         << " does not support batch request, disable it";
+            client_->DisableBatch();
+        } else {
+            client_->ResetSenderIfNotHealth(chunkserverID_);
+        }
+        LOG_EVERY_SECOND(WARNING) << (isWrite_ ? "WriteChunks" : "ReadChunks")
+            << " failed, error code: " << cntl_->ErrorCode()
+            << ", error: " << cntl_->ErrorText()
+            << ", request num = " << reqs_.size()
+            << ", remote side = "
+            << butil::endpoint2str(cntl_->remote_side()).c_str();
+        if (isWrite_) {
+            const ChunkIDInfo& idinfo = reqs_.front()->idinfo_;
+            client_->GetMetaCache()->UpdateAppliedIndex(
+                idinfo.lpid_, idinfo.cpid_, 0);
+        }
+        OnFailed();
+        return;
+    }
+
+    client_->GetMetaCache()->GetUnstableHelper().ClearTimeout(
+        chunkserverID_, chunkserverEndPoint_);
+
+    // 整个请求的状态是第一个失败的子请求的状态，有子请求的结果时按子请求
+    // 分别处理，成功的子请求不需要重试
+    if (response_->status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS ||
+        response_->subresponses_size() != static_cast<int>(reqs_.size())) {
+        LOG_EVERY_SECOND(WARNING) << (isWrite_ ? "WriteChunks" : "ReadChunks")
+            << " failed, status = "
+            << curve::chunkserver::CHUNK_OP_STATUS_Name(response_->status())
+            << ", request num = " << reqs_.size()
+            << ", sub response num = " << response_->subresponses_size()
+            << ", remote side = "
+            << butil::endpoint2str(cntl_->remote_side()).c_str();
+    }
+    if (response_->subresponses_size() != static_cast<int>(reqs_.size())) {
+        OnFailed();
+        return;
+    }
+
+    butil::IOBuf data;
+    data.swap(cntl_->response_attachment());
+    for (size_t i = 0; i < reqs_.size(); ++i) {
+        CHUNK_OP_STATUS status = response_->subresponses(i).status();
+        if (status == CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            OnSubSuccess(reqs_[i], &data);
+        } else if (!isWrite_ &&
+                   status == CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_NOTEXIST) {
+            OnSubChunkNotExist(reqs_[i]);
+        } else {
+            client_->ResendChunkRequest(reqs_[i]);
+        }
+    }
+}
+
+void BatchChunkClosure::OnFailed() {
+    for (auto ctx : reqs_) {
+        client_->ResendChunkRequest(ctx);
+    }
+}
+
+void BatchChunkClosure::OnSubSuccess(RequestContext* ctx,
+                                     butil::IOBuf* data) {
+    RequestClosure* done = ctx->done_;
+    done->SetFailed(0);
+
+    MetricHelper::LatencyRecord(done->GetMetric(), cntl_->latency_us(),
+                                ctx->optype_);
+    MetricHelper::IncremRPCQPSCount(done->GetMetric(), ctx->rawlength_,
+                                    ctx->optype_);
+
+    if (!isWrite_) {
+        ctx->readData_.clear();
+        data->cutn(&ctx->readData_, ctx->rawlength_);
+    }
+    client_->GetMetaCache()->UpdateAppliedIndex(
+        ctx->idinfo_.lpid_, ctx->idinfo_.cpid_, response_->appliedindex());
+
+    done->Run();
+}
+
+void BatchChunkClosure::OnSubChunkNotExist(RequestContext* ctx) {
+    RequestClosure* done = ctx->done_;
+    done->SetFailed(0);
+
+    MetricHelper::LatencyRecord(done->GetMetric(), cntl_->latency_us(),
+                                ctx->optype_);
+    MetricHelper::IncremRPCQPSCount(done->GetMetric(), ctx->rawlength_,
+                                    ctx->optype_);
+
+    ctx->readData_.clear();
+    ctx->readData_.resize(ctx->rawlength_, 0);
+    client_->GetMetaCache()->UpdateAppliedIndex(
+        ctx->idinfo_.lpid_, ctx->idinfo_.cpid_, response_->appliedindex());
+
+    done->Run();
+}
+
 }   // namespace client
 }   // namespace curve
@@ -28,6 +28,7 @@
 #include <brpc/errno.pb.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "proto/chunk.pb.h"
 #include "src/client/client_config.h"
@@ -42,6 +43,7 @@ namespace client {
 using curve::chunkserver::CHUNK_OP_STATUS;
 using curve::chunkserver::ChunkResponse;
 using curve::chunkserver::GetChunkInfoResponse;
+using curve::chunkserver::GetChunksInfoResponse;
 using ::google::protobuf::Message;
 using ::google::protobuf::Closure;
 
@@ -200,6 +202,11 @@ class ClientClosure : public Closure {
  protected:
     int UpdateLeaderWithRedirectInfo(const std::string& leaderInfo);
 
+    /**
+     * 被采样的请求返回时记录其在client和chunkserver上各阶段的耗时
+     */
+    void OnTrace();
+
     void ProcessUnstableState();
 
     void RefreshLeader();
@@ -289,6 +296,27 @@ class GetChunkInfoClosure : public ClientClosure {
     std::unique_ptr<GetChunkInfoResponse> chunkinforesponse_;
 };
 
+class GetChunksInfoClosure : public ClientClosure {
+ public:
+    GetChunksInfoClosure(CopysetClient* client, Closure* done)
+        : ClientClosure(client, done) {}
+
+    void SetResponse(Message* message) override {
+        chunksinforesponse_.reset(static_cast<GetChunksInfoResponse*>(message));
+    }
+
+    CHUNK_OP_STATUS GetResponseStatus() const override {
+        return chunksinforesponse_->status();
+    }
+
+    void OnSuccess() override;
+    void OnRedirected() override;
+    void SendRetryRequest() override;
+
+ private:
+    std::unique_ptr<GetChunksInfoResponse> chunksinforesponse_;
+};
+
 class CreateCloneChunkClosure : public ClientClosure {
  public:
     CreateCloneChunkClosure(CopysetClient* client, Closure* done)
@@ -305,6 +333,58 @@ class RecoverChunkClosure : public ClientClosure {
     void SendRetryRequest() override;
 };
 
+/**
+ * 批量读写请求的closure，子请求成功时直接返回给对应的RequestClosure，
+ * 整个rpc失败或者子请求失败时，通过CopysetClient单独重新发送这些请求，
+ * 由单个请求的closure负责重试
+ */
+class BatchChunkClosure : public Closure {
+ public:
+    BatchChunkClosure(CopysetClient* client,
+                      const std::vector<RequestContext*>& reqs,
+                      bool isWrite)
+        : cntl_(nullptr), client_(client), reqs_(reqs), isWrite_(isWrite),
+          chunkserverID_(0) {}
+
+    virtual ~BatchChunkClosure() = default;
+
+    void SetCntl(brpc::Controller* cntl) {
+        cntl_ = cntl;
+    }
+
+    void SetResponse(Message* response) {
+        response_.reset(static_cast<ChunkResponse*>(response));
+    }
+
+    void SetChunkServerID(ChunkServerID csid) {
+        chunkserverID_ = csid;
+    }
+
+    void SetChunkServerEndPoint(const butil::EndPoint& endPoint) {
+        chunkserverEndPoint_ = endPoint;
+    }
+
+    void Run() override;
+
+ private:
+    // rpc失败或者返回失败，所有请求单独重新发送
+    void OnFailed();
+
+    // 子请求成功，读请求从data中取出自己的数据
+    void OnSubSuccess(RequestContext* ctx, butil::IOBuf* data);
+
+    // 读请求的chunk不存在，返回全0
+    void OnSubChunkNotExist(RequestContext* ctx);
+
+    brpc::Controller*                   cntl_;
+    std::unique_ptr<ChunkResponse>      response_;
+    CopysetClient*                      client_;
+    std::vector<RequestContext*>        reqs_;
+    bool                                isWrite_;
+    ChunkServerID                       chunkserverID_;
+    butil::EndPoint                     chunkserverEndPoint_;
+};
+
 }   // namespace client
 }   // namespace curve
 
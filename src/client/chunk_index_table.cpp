@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include "src/client/chunk_index_table.h"
+
+#include <algorithm>
+
+namespace curve {
+namespace client {
+
+ChunkIndexTable::ChunkIndexTable()
+    : table_(nullptr), size_(0), memoryBytes_(0) {
+    tables_.emplace_back(new Table(0));
+    table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+void ChunkIndexTable::Reserve(uint64_t chunkNum) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (chunkNum > table_.load(std::memory_order_relaxed)->capacity) {
+        GrowLocked(chunkNum);
+    }
+}
+
+bool ChunkIndexTable::Get(ChunkIndex index, ChunkIDInfo* info) const {
+    const Table* table = table_.load(std::memory_order_acquire);
+    if (index >= table->capacity) {
+        return false;
+    }
+
+    const Slot& slot = table->slots[index];
+    while (true) {
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq == 0) {
+            return false;
+        }
+        if (seq & 1) {
+            continue;
+        }
+
+        ChunkIDInfo tmp(slot.cid.load(std::memory_order_relaxed),
+                        slot.lpid.load(std::memory_order_relaxed),
+                        slot.cpid.load(std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == seq) {
+            *info = tmp;
+            return true;
+        }
+    }
+}
+
+void ChunkIndexTable::Set(ChunkIndex index, const ChunkIDInfo& info) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    Table* table = table_.load(std::memory_order_relaxed);
+    if (index >= table->capacity) {
+        GrowLocked(std::max<uint64_t>(index + 1ull, table->capacity * 2));
+        table = table_.load(std::memory_order_relaxed);
+    }
+
+    Slot& slot = table->slots[index];
+    uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+    if (seq == 0) {
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.cid.store(info.cid_, std::memory_order_relaxed);
+    slot.lpid.store(info.lpid_, std::memory_order_relaxed);
+    slot.cpid.store(info.cpid_, std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+}
+
+void ChunkIndexTable::GrowLocked(uint64_t capacity) {
+    const Table* old = table_.load(std::memory_order_relaxed);
+    std::unique_ptr<Table> table(new Table(capacity));
+
+    // 持有锁，没有并发的写，直接拷贝
+    for (uint64_t i = 0; i < old->capacity; ++i) {
+        const Slot& from = old->slots[i];
+        Slot& to = table->slots[i];
+        to.seq.store(from.seq.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+        to.cid.store(from.cid.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+        to.lpid.store(from.lpid.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+        to.cpid.store(from.cpid.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+    }
+
+    memoryBytes_.fetch_add(capacity * sizeof(Slot),
+                           std::memory_order_relaxed);
+    table_.store(table.get(), std::memory_order_release);
+    tables_.emplace_back(std::move(table));
+}
+
+}   // namespace client
+}   // namespace curve
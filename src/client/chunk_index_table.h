@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#ifndef SRC_CLIENT_CHUNK_INDEX_TABLE_H_
+#define SRC_CLIENT_CHUNK_INDEX_TABLE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <vector>
+
+#include "src/client/client_common.h"
+
+namespace curve {
+namespace client {
+
+// 文件内chunk index到chunkid信息的映射表
+// 文件的chunk index是从0开始的连续整数，所以直接用数组按index寻址，
+// 相比哈希表每个chunk一个堆上节点，内存占用更小也更紧凑。
+// 读不加锁：每个slot带一个版本号，写入前后各加1，读到奇数或者读前后
+// 版本号不一致时重读；写之间用互斥锁串行，写只发生在获取segment时，频率很低。
+// 容量不够时分配新的数组拷贝过去再原子替换，旧数组在析构时才释放，
+// 所以读者拿到旧数组也可以安全访问，最多读不到新写入的chunk，
+// 调用方会当作chunk不在cache中重新向mds获取。
+class ChunkIndexTable {
+ public:
+    ChunkIndexTable();
+
+    ChunkIndexTable(const ChunkIndexTable&) = delete;
+    ChunkIndexTable& operator=(const ChunkIndexTable&) = delete;
+
+    /**
+     * 预留至少chunkNum个slot，一般在获取到文件长度后调用
+     * @param: chunkNum为文件的chunk数量
+     */
+    void Reserve(uint64_t chunkNum);
+
+    /**
+     * 查询chunk index对应的chunkid信息
+     * @param: index为chunk index
+     * @param[out]: info为查到的chunkid信息
+     * @return: 存在返回true，否则返回false
+     */
+    bool Get(ChunkIndex index, ChunkIDInfo* info) const;
+
+    /**
+     * 更新chunk index对应的chunkid信息，容量不够时自动扩容
+     * @param: index为chunk index
+     * @param: info为chunkid信息
+     */
+    void Set(ChunkIndex index, const ChunkIDInfo& info);
+
+    // 已经填充的chunk数量
+    uint64_t Size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    // 当前数组的容量
+    uint64_t Capacity() const {
+        return table_.load(std::memory_order_acquire)->capacity;
+    }
+
+    // 所有数组占用的内存，包括扩容后保留的旧数组
+    uint64_t MemoryBytes() const {
+        return memoryBytes_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    struct Slot {
+        // 0表示slot为空，奇数表示正在写入
+        std::atomic<uint64_t> seq;
+        std::atomic<uint64_t> cid;
+        std::atomic<uint32_t> lpid;
+        std::atomic<uint32_t> cpid;
+    };
+
+    struct Table {
+        uint64_t capacity;
+        std::unique_ptr<Slot[]> slots;
+
+        explicit Table(uint64_t cap)
+            : capacity(cap), slots(new Slot[cap]()) {}
+    };
+
+    // 调用方需要持有mtx_
+    void GrowLocked(uint64_t capacity);
+
+ private:
+    std::atomic<Table*> table_;
+
+    // 所有分配过的数组，保证读者拿到的旧数组一直有效
+    std::vector<std::unique_ptr<Table>> tables_;
+
+    std::atomic<uint64_t> size_;
+    std::atomic<uint64_t> memoryBytes_;
+
+    // 串行化写和扩容
+    std::mutex mtx_;
+};
+
+}   // namespace client
+}   // namespace curve
+
+#endif  // SRC_CLIENT_CHUNK_INDEX_TABLE_H_
@@ -56,6 +56,7 @@ enum class OpType {
     CREATE_CLONE,
     RECOVER_CHUNK,
     GET_CHUNK_INFO,
+    GET_CHUNKS_INFO,
     UNKNOWN
 };
 
@@ -92,6 +93,12 @@ typedef struct ChunkIDInfo {
 // 保存每个chunk对应的版本信息
 typedef struct ChunkInfoDetail {
     std::vector<uint64_t> chunkSn;
+    // 是否为clone chunk，chunkserver未返回该信息时按clone chunk处理
+    bool isClone = true;
+    // 以下信息只有GetChunksInfo返回
+    uint64_t correctedSn = 0;
+    // clone chunk已写过的page数
+    uint32_t writtenPageNum = 0;
 } ChunkInfoDetail_t;
 
 typedef struct LeaseSession {
@@ -138,6 +145,9 @@ typedef struct FInfo {
     FileStatus      filestatus;
     std::string     cloneSource;
     uint64_t        cloneLength{0};
+    // 文件的iops和带宽(bytes/s)上限，0表示不限制
+    uint64_t        iopsLimit{0};
+    uint64_t        bpsLimit{0};
 
     FInfo() {
         id = 0;
@@ -214,6 +224,8 @@ inline const char* OpTypeToString(OpType optype) {
         return "RecoverChunk";
     case OpType::GET_CHUNK_INFO:
         return "GetChunkInfo";
+    case OpType::GET_CHUNKS_INFO:
+        return "GetChunksInfo";
     case OpType::UNKNOWN:
     default:
         return "Unknown";
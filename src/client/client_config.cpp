@@ -66,6 +66,12 @@ int ClientConfig::Init(const char* configpath) {
     LOG_IF(ERROR, ret == false) << "config no chunkserver.enableAppliedIndexRead info";     // NOLINT
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetBoolValue("chunkserver.enableFollowerRead",
+          &fileServiceOption_.ioOpt.ioSenderOpt.chunkserverEnableFollowerRead);    // NOLINT
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.enableFollowerRead info, using default value "
+        << fileServiceOption_.ioOpt.ioSenderOpt.chunkserverEnableFollowerRead;
+
     ret = conf_.GetUInt32Value("chunkserver.opMaxRetry",
           &fileServiceOption_.ioOpt.ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry);    // NOLINT
     LOG_IF(ERROR, ret == false) << "config no chunkserver.opMaxRetry info";
@@ -140,6 +146,18 @@ int ClientConfig::Init(const char* configpath) {
     LOG_IF(ERROR, ret == false) << "config no metacache.getLeaderTimeOutMS info";   // NOLINT
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetBoolValue("metacache.prefetchSegmentsOnOpen",
+        &fileServiceOption_.ioOpt.metaCacheOpt.metacachePrefetchSegmentsOnOpen);   // NOLINT
+    LOG_IF(WARNING, ret == false)
+        << "config no metacache.prefetchSegmentsOnOpen info, using default value "   // NOLINT
+        << fileServiceOption_.ioOpt.metaCacheOpt.metacachePrefetchSegmentsOnOpen;   // NOLINT
+
+    ret = conf_.GetUInt32Value("metacache.prefetchSegmentsPageSize",
+        &fileServiceOption_.ioOpt.metaCacheOpt.metacachePrefetchSegmentsPageSize);   // NOLINT
+    LOG_IF(WARNING, ret == false)
+        << "config no metacache.prefetchSegmentsPageSize info, using default value "   // NOLINT
+        << fileServiceOption_.ioOpt.metaCacheOpt.metacachePrefetchSegmentsPageSize;   // NOLINT
+
     ret = conf_.GetUInt32Value("schedule.queueCapacity",
         &fileServiceOption_.ioOpt.reqSchdulerOpt.scheduleQueueCapacity);
     LOG_IF(ERROR, ret == false) << "config no schedule.queueCapacity info";
@@ -150,6 +168,24 @@ int ClientConfig::Init(const char* configpath) {
     LOG_IF(ERROR, ret == false) << "config no schedule.threadpoolSize info";
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetUInt32Value("schedule.traceSampleRate",
+        &fileServiceOption_.ioOpt.reqSchdulerOpt.traceSampleRate);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.traceSampleRate info, using default value "
+        << fileServiceOption_.ioOpt.reqSchdulerOpt.traceSampleRate;
+
+    ret = conf_.GetUInt32Value("schedule.batchMaxRequests",
+        &fileServiceOption_.ioOpt.reqSchdulerOpt.batchMaxRequests);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.batchMaxRequests info, using default value "
+        << fileServiceOption_.ioOpt.reqSchdulerOpt.batchMaxRequests;
+
+    ret = conf_.GetUInt32Value("schedule.batchMaxRequestSize",
+        &fileServiceOption_.ioOpt.reqSchdulerOpt.batchMaxRequestSize);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.batchMaxRequestSize info, using default value "
+        << fileServiceOption_.ioOpt.reqSchdulerOpt.batchMaxRequestSize;
+
     ret = conf_.GetUInt32Value("mds.refreshTimesPerLease",
         &fileServiceOption_.leaseOpt.mdsRefreshTimesPerLease);
     LOG_IF(ERROR, ret == false) << "config no mds.refreshTimesPerLease info";
@@ -168,6 +204,12 @@ int ClientConfig::Init(const char* configpath) {
     LOG_IF(ERROR, ret == false) << "config no isolation.taskThreadPoolSize info";   // NOLINT
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetUInt32Value("throttle.burstSeconds",
+        &fileServiceOption_.ioOpt.throttleOpt.burstSeconds);
+    LOG_IF(WARNING, ret == false)
+        << "config no throttle.burstSeconds info, using default value "
+        << fileServiceOption_.ioOpt.throttleOpt.burstSeconds;
+
     std::string metaAddr;
     ret = conf_.GetStringValue("mds.listen.addr", &metaAddr);
     LOG_IF(ERROR, ret == false) << "config no mds.listen.addr info";
@@ -28,6 +28,7 @@
 #include <string>
 #include <vector>
 
+#include "src/common/op_trace.h"
 #include "src/common/timeutility.h"
 #include "src/client/client_common.h"
 
@@ -92,6 +93,36 @@ struct InterfaceMetric {
           latency(prefix, name + "_lat") {}
 };
 
+// 被采样的读写请求各阶段耗时统计，chunkserver上的阶段由response返回
+struct OpTraceMetric {
+    // 在调度队列中等待的时间
+    bvar::LatencyRecorder scheduleQueue;
+    // rpc的总耗时
+    bvar::LatencyRecorder rpc;
+    // rpc总耗时减去chunkserver处理的时间，即网络传输和brpc框架的耗时
+    bvar::LatencyRecorder network;
+    // chunkserver处理的总耗时
+    bvar::LatencyRecorder server;
+    // chunkserver上raft日志落盘、复制和提交的耗时
+    bvar::LatencyRecorder raft;
+    // chunkserver上在并发apply模块中排队的耗时
+    bvar::LatencyRecorder applyQueue;
+    // chunkserver上datastore读写的耗时
+    bvar::LatencyRecorder storage;
+    // 最近一段时间内最慢的被采样请求
+    curve::common::SlowOpTracker slowOps;
+
+    OpTraceMetric(const std::string& prefix, const std::string& name)
+        : scheduleQueue(prefix, name + "_schedule_queue"),
+          rpc(prefix, name + "_rpc"),
+          network(prefix, name + "_network"),
+          server(prefix, name + "_server"),
+          raft(prefix, name + "_raft"),
+          applyQueue(prefix, name + "_apply_queue"),
+          storage(prefix, name + "_storage"),
+          slowOps(prefix, name + "_slow_ops") {}
+};
+
 // 文件级别metric信息统计
 struct FileMetric {
     const std::string prefix = "curve_client";
@@ -120,6 +151,12 @@ struct FileMetric {
     // 当前文件上的悬挂IO数量
     IOSuspendMetric suspendRPCMetric;
 
+    // 用户IO因为文件的iops/带宽限制被限流的等待时间(us)，只统计需要等待的IO
+    bvar::LatencyRecorder throttleWait;
+
+    // 被采样请求的各阶段耗时
+    OpTraceMetric trace;
+
     explicit FileMetric(const std::string& name)
         : filename(name),
           inflightRPCNum(prefix, filename + "_inflight_rpc_num"),
@@ -130,7 +167,9 @@ struct FileMetric {
           userRead(prefix, filename + "_read"),
           userWrite(prefix, filename + "_write"),
           getLeaderRetryQPS(prefix, filename + "_get_leader_retry_rpc"),
-          suspendRPCMetric(prefix, filename + "_suspend_io_num") {}
+          suspendRPCMetric(prefix, filename + "_suspend_io_num"),
+          throttleWait(prefix, filename + "_throttle_wait"),
+          trace(prefix, filename + "_trace") {}
 };
 
 // 用于全局mds接口统计信息调用信息统计
@@ -155,6 +194,8 @@ struct MDSClientMetric {
     InterfaceMetric getServerList;
     // GetOrAllocateSegment接口统计信息
     InterfaceMetric getOrAllocateSegment;
+    // ListSegments接口统计信息
+    InterfaceMetric listSegments;
     // RenameFile接口统计信息
     InterfaceMetric renameFile;
     // Extend接口统计信息
@@ -185,6 +226,7 @@ struct MDSClientMetric {
           refreshSession(prefix, "refreshSession"),
           getServerList(prefix, "getServerList"),
           getOrAllocateSegment(prefix, "getOrAllocateSegment"),
+          listSegments(prefix, "listSegments"),
           renameFile(prefix, "renameFile"),
           extendFile(prefix, "extendFile"),
           deleteFile(prefix, "deleteFile"),
@@ -434,6 +476,12 @@ class MetricHelper {
         }
     }
 
+    static void ThrottleWaitRecord(FileMetric* fm, uint64_t waitUs) {
+        if (fm != nullptr) {
+            fm->throttleWait << waitUs;
+        }
+    }
+
     static void IncremInflightRPC(FileMetric* fm) {
         if (fm != nullptr) {
             fm->inflightRPCNum << 1;
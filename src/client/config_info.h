@@ -144,11 +144,14 @@ struct FailureRequestOption {
 /**
  * 发送rpc给chunkserver的配置
  * @chunkserverEnableAppliedIndexRead: 是否开启使用appliedindex read
+ * @chunkserverEnableFollowerRead: 是否允许携带appliedindex的读请求和读快照请求
+ *                  发往follower，用于分散快照、克隆等后台读流量
  * @inflightOpt: 一个文件向chunkserver发送请求时的inflight 请求控制配置
  * @failRequestOpt: rpc发送失败之后，需要进行rpc重试的相关配置
  */
 struct IOSenderOption {
     bool chunkserverEnableAppliedIndexRead;
+    bool chunkserverEnableFollowerRead = false;
     InFlightIOCntlInfo inflightOpt;
     FailureRequestOption failRequestOpt;
 };
@@ -158,10 +161,18 @@ struct IOSenderOption {
  * 线程池，线程池中的线程各自配置一个队列
  * @scheduleQueueCapacity: schedule模块配置的队列深度
  * @scheduleThreadpoolSize: schedule模块线程池大小
+ * @traceSampleRate: 每traceSampleRate个读写请求采样一个，记录其在client和
+ *                   chunkserver上各阶段的耗时，为0时关闭采样
+ * @batchMaxRequests: 调度线程每次最多从队列中取出的请求个数，同一copyset上的
+ *                    读或写请求合并为一个批量rpc，为0或1时不合并
+ * @batchMaxRequestSize: 只合并不大于该值(bytes)的读写请求
  */
 struct RequestScheduleOption {
     uint32_t scheduleQueueCapacity = 1024;
     uint32_t scheduleThreadpoolSize = 2;
+    uint32_t traceSampleRate = 0;
+    uint32_t batchMaxRequests = 0;
+    uint32_t batchMaxRequestSize = 16384;
     IOSenderOption ioSenderOpt;
 };
 
@@ -189,6 +200,11 @@ struct MetaCacheOption {
     uint32_t metacacheGetLeaderRPCTimeOutMS = 1000;
     uint32_t metacacheGetLeaderBackupRequestMS = 100;
     std::string metacacheGetLeaderBackupRequestLbName = "rr";
+    // 打开文件时是否分页从mds批量获取已分配的segment，避免第一次访问每个
+    // segment时都要同步请求mds
+    bool metacachePrefetchSegmentsOnOpen = false;
+    // 批量获取segment时每页的segment数量
+    uint32_t metacachePrefetchSegmentsPageSize = 256;
     ChunkServerUnstableOption chunkserverUnstableOption;
 };
 
@@ -213,6 +229,14 @@ struct TaskThreadOption {
     uint32_t isolationTaskThreadPoolSize = 1;
 };
 
+/**
+ * 文件级别限流配置信息，限流的iops和带宽由mds在文件信息中下发
+ * @burstSeconds: 令牌桶的容量，以限制值的秒数表示，空闲时最多可以积累这么多秒的令牌
+ */
+struct ThrottleOption {
+    uint32_t burstSeconds = 1;
+};
+
 /**
  * IOOption存储了当前io 操作所需要的所有配置信息
  */
@@ -222,6 +246,7 @@ struct IOOption {
     MetaCacheOption metaCacheOpt;
     TaskThreadOption taskThreadOpt;
     RequestScheduleOption reqSchdulerOpt;
+    ThrottleOption throttleOpt;
 };
 
 /**
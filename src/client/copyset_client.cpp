@@ -128,7 +128,10 @@ int CopysetClient::ReadChunk(const ChunkIDInfo& idinfo, uint64_t sn,
                              appliedindex, sourceInfo, readDone);
     };
 
-    return DoRPCTask(idinfo, task, doneGuard.release());
+    // 只有携带了appliedindex的读才能发往follower
+    return DoRPCTask(idinfo, task, doneGuard.release(),
+                     iosenderopt_.chunkserverEnableAppliedIndexRead &&
+                     appliedindex > 0);
 }
 
 int CopysetClient::WriteChunk(const ChunkIDInfo& idinfo, uint64_t sn,
@@ -180,15 +183,66 @@ int CopysetClient::WriteChunk(const ChunkIDInfo& idinfo, uint64_t sn,
     return DoRPCTask(idinfo, task, doneGuard.release());
 }
 
+int CopysetClient::ReadChunks(const std::vector<RequestContext*>& reqs) {
+    return DoBatchRPCTask(reqs, false);
+}
+
+int CopysetClient::WriteChunks(const std::vector<RequestContext*>& reqs) {
+    return DoBatchRPCTask(reqs, true);
+}
+
+int CopysetClient::ResendChunkRequest(RequestContext* ctx) {
+    if (ctx->optype_ == OpType::WRITE) {
+        return WriteChunk(ctx->idinfo_, ctx->seq_, ctx->writeData_,
+                          ctx->offset_, ctx->rawlength_, ctx->sourceInfo_,
+                          ctx->done_);
+    }
+    return ReadChunk(ctx->idinfo_, ctx->seq_, ctx->offset_, ctx->rawlength_,
+                     ctx->appliedindex_, ctx->sourceInfo_, ctx->done_);
+}
+
+int CopysetClient::DoBatchRPCTask(const std::vector<RequestContext*>& reqs,
+                                  bool isWrite) {
+    const ChunkIDInfo& idinfo = reqs.front()->idinfo_;
+    ChunkServerID leaderId;
+    butil::EndPoint leaderAddr;
+    std::shared_ptr<RequestSender> senderPtr = nullptr;
+
+    // session过期的处理和失败重试都交给单个请求的接口
+    if (!sessionNotValid_ &&
+        FetchLeader(idinfo.lpid_, idinfo.cpid_, &leaderId, &leaderAddr)) {
+        senderPtr = senderManager_->GetOrCreateSender(leaderId,
+                                        leaderAddr, iosenderopt_);
+    }
+    if (nullptr == senderPtr) {
+        for (auto ctx : reqs) {
+            ResendChunkRequest(ctx);
+        }
+        return 0;
+    }
+
+    BatchChunkClosure* done = new BatchChunkClosure(this, reqs, isWrite);
+    if (isWrite) {
+        senderPtr->WriteChunks(reqs, done);
+    } else {
+        senderPtr->ReadChunks(reqs, done);
+    }
+    return 0;
+}
+
 int CopysetClient::ReadChunkSnapshot(const ChunkIDInfo& idinfo,
     uint64_t sn, off_t offset, size_t length, Closure *done) {
+    // 拿到过applied index才发往follower，follower向leader获取read index
+    uint64_t appliedindex =
+        metaCache_->GetAppliedIndex(idinfo.lpid_, idinfo.cpid_);
 
     auto task = [&](Closure* done, std::shared_ptr<RequestSender> senderPtr) {
         ReadChunkSnapClosure *readDone = new ReadChunkSnapClosure(this, done);
-        senderPtr->ReadChunkSnapshot(idinfo, sn, offset, length, readDone);
+        senderPtr->ReadChunkSnapshot(idinfo, sn, offset, length,
+                                     appliedindex, readDone);
     };
 
-    return DoRPCTask(idinfo, task, done);
+    return DoRPCTask(idinfo, task, done, appliedindex > 0);
 }
 
 int CopysetClient::DeleteChunkSnapshotOrCorrectSn(const ChunkIDInfo& idinfo,
@@ -240,19 +294,43 @@ int CopysetClient::RecoverChunk(const ChunkIDInfo& idinfo,
     return DoRPCTask(idinfo, task, done);
 }
 
+int CopysetClient::GetChunksInfo(const ChunkIDInfo& idinfo,
+    const std::vector<ChunkID> &chunkIds, Closure *done) {
+    auto task = [&](Closure* done, std::shared_ptr<RequestSender> senderPtr) {
+        GetChunksInfoClosure *chunksInfoDone =
+            new GetChunksInfoClosure(this, done);
+        senderPtr->GetChunksInfo(idinfo, chunkIds, chunksInfoDone);
+    };
+
+    return DoRPCTask(idinfo, task, done);
+}
+
 int CopysetClient::DoRPCTask(const ChunkIDInfo& idinfo,
     std::function<void(Closure* done,
-    std::shared_ptr<RequestSender> senderptr)> task, Closure *done) {
+    std::shared_ptr<RequestSender> senderptr)> task, Closure *done,
+    bool followerRead) {
     RequestClosure* reqclosure = static_cast<RequestClosure*>(done);
 
     ChunkServerID leaderId;
     butil::EndPoint leaderAddr;
     brpc::ClosureGuard doneGuard(done);
 
+    // 只有第一次发送选择follower，follower返回redirect或者失败后都发往leader
+    followerRead = followerRead &&
+                   iosenderopt_.chunkserverEnableFollowerRead &&
+                   reqclosure->GetRetriedTimes() == 0;
+
     while (reqclosure->GetRetriedTimes() <
         iosenderopt_.failRequestOpt.chunkserverOPMaxRetry) {
         reqclosure->IncremRetriedTimes();
-        if (false == FetchLeader(idinfo.lpid_, idinfo.cpid_,
+        bool tryFollower = followerRead;
+        followerRead = false;
+        reqclosure->SetFollowerRead(false);
+        // follower读时leaderId/leaderAddr为选中的副本
+        if (tryFollower && 0 == metaCache_->GetFollowerReadPeer(
+            idinfo.lpid_, idinfo.cpid_, idinfo.cid_, &leaderId, &leaderAddr)) {
+            reqclosure->SetFollowerRead(true);
+        } else if (false == FetchLeader(idinfo.lpid_, idinfo.cpid_,
             &leaderId, &leaderAddr)) {
             bthread_usleep(
             iosenderopt_.failRequestOpt.chunkserverOPRetryIntervalUS);
@@ -27,6 +27,8 @@
 #include <butil/iobuf.h>
 
 #include <string>
+#include <atomic>
+#include <vector>
 #include <memory>
 
 #include "include/curve_compiler_specific.h"
@@ -57,7 +59,8 @@ class CopysetClient {
         metaCache_(nullptr),
         senderManager_(nullptr),
         scheduler_(nullptr),
-        exitFlag_(false) {}
+        exitFlag_(false),
+        batchEnabled_(true) {}
 
     CopysetClient(const CopysetClient&) = delete;
     CopysetClient& operator=(const CopysetClient&) = delete;
@@ -114,6 +117,31 @@ class CopysetClient {
                   const RequestSourceInfo& sourceInfo,
                   Closure *done);
 
+    /**
+     * 批量读写同一个copyset上的多个chunk，一次rpc发给leader。子请求
+     * 失败或者整个rpc失败时，各个请求通过ReadChunk/WriteChunk重新发送
+     * @param reqs:属于同一个copyset的读请求或者写请求
+     */
+    int ReadChunks(const std::vector<RequestContext*>& reqs);
+    int WriteChunks(const std::vector<RequestContext*>& reqs);
+
+    /**
+     * 重新单独发送批量请求中的一个请求
+     * @param ctx:读请求或者写请求
+     */
+    int ResendChunkRequest(RequestContext* ctx);
+
+    /**
+     * chunkserver不支持批量读写时关闭批量请求
+     */
+    void DisableBatch() {
+        batchEnabled_.store(false, std::memory_order_release);
+    }
+
+    bool IsBatchEnabled() const {
+        return batchEnabled_.load(std::memory_order_acquire);
+    }
+
     /**
      * 读Chunk快照文件
      * @param idinfo为chunk相关的id信息
@@ -147,6 +175,16 @@ class CopysetClient {
     int GetChunkInfo(const ChunkIDInfo& idinfo,
                   Closure *done);
 
+    /**
+     * 批量获取同一个copyset中多个chunk文件的信息
+     * @param idinfo为copyset相关的id信息
+     * @param chunkIds:需要查询的chunk
+     * @param done:上一层异步回调的closure
+     */
+    int GetChunksInfo(const ChunkIDInfo& idinfo,
+                  const std::vector<ChunkID> &chunkIds,
+                  Closure *done);
+
     /**
     * @brief lazy 创建clone chunk
     * @param idinfo为chunk相关的id信息
@@ -226,11 +264,23 @@ class CopysetClient {
      * @param[in]: idinfo为当前rpc task的id信息
      * @param[in]: task为本次要执行的rpc task
      * @param[in]: done是本次rpc 任务的异步回调
+     * @param[in]: followerRead为true时，第一次发送可以选择follower，
+     *             重试时发往leader
      * @return: 成功返回0， 否则-1
      */
     int DoRPCTask(const ChunkIDInfo& idinfo,
         std::function<void(Closure*, std::shared_ptr<RequestSender>)> task,
-        Closure *done);
+        Closure *done, bool followerRead = false);
+
+    /**
+     * 把批量请求发给copyset的leader，获取leader或者sender失败时
+     * 所有请求单独发送
+     * @param[in]: reqs为属于同一个copyset的请求
+     * @param[in]: isWrite为true时是批量写请求，否则是批量读请求
+     * @return: 成功返回0， 否则-1
+     */
+    int DoBatchRPCTask(const std::vector<RequestContext*>& reqs,
+                       bool isWrite);
 
  private:
     // 元数据缓存
@@ -253,6 +303,9 @@ class CopysetClient {
 
     // 是否在停止状态中，如果是在关闭过程中且session失效，需要将rpc直接返回不下发
     bool exitFlag_;
+
+    // chunkserver是否支持批量读写，老版本的chunkserver返回ENOMETHOD后关闭
+    std::atomic<bool> batchEnabled_;
 };
 
 }   // namespace client
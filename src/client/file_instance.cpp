@@ -152,6 +152,11 @@ int FileInstance::Open(const std::string& filename,
             sessionId->assign(lease.sessionID);
         }
     }
+
+    // 在后台预取，不增加open的耗时，未获取到的segment在IO时按需获取
+    if (ret == LIBCURVE_ERROR::OK) {
+        iomanager4file_.GetMetaCache()->StartPrefetchSegments();
+    }
     return -ret;
 }
 
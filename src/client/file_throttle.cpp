@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include <bthread/bthread.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#include "src/client/file_throttle.h"
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace client {
+
+using curve::common::TimeUtility;
+
+FileThrottle::FileThrottle()
+    : burstSeconds_(1),
+      enabled_(false),
+      iopsBucket_(0, 0),
+      bpsBucket_(0, 0) {}
+
+void FileThrottle::Init(const ThrottleOption& opt) {
+    burstSeconds_ = opt.burstSeconds == 0 ? 1 : opt.burstSeconds;
+}
+
+void FileThrottle::UpdateThrottleParams(uint64_t iopsLimit,
+                                        uint64_t bpsLimit) {
+    if (iopsLimit != iopsBucket_.GetRate()
+        || bpsLimit != bpsBucket_.GetRate()) {
+        LOG(INFO) << "update file throttle params, iopsLimit = " << iopsLimit
+                  << ", bpsLimit = " << bpsLimit;
+    }
+    iopsBucket_.SetRate(iopsLimit, iopsLimit * burstSeconds_);
+    bpsBucket_.SetRate(bpsLimit, bpsLimit * burstSeconds_);
+    enabled_.store(iopsLimit != 0 || bpsLimit != 0,
+                   std::memory_order_relaxed);
+}
+
+uint64_t FileThrottle::Add(uint64_t length) {
+    if (!Enabled()) {
+        return 0;
+    }
+
+    uint64_t waitUs = Reserve(length, TimeUtility::GetTimeofDayUs());
+    if (waitUs > 0) {
+        bthread_usleep(waitUs);
+    }
+    return waitUs;
+}
+
+uint64_t FileThrottle::Reserve(uint64_t length, uint64_t nowUs) {
+    uint64_t iopsWait = iopsBucket_.Reserve(1, nowUs);
+    uint64_t bpsWait = bpsBucket_.Reserve(length, nowUs);
+    return std::max(iopsWait, bpsWait);
+}
+
+}  // namespace client
+}  // namespace curve
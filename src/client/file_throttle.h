@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#ifndef SRC_CLIENT_FILE_THROTTLE_H_
+#define SRC_CLIENT_FILE_THROTTLE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "src/client/config_info.h"
+#include "src/common/token_bucket.h"
+#include "src/common/uncopyable.h"
+
+namespace curve {
+namespace client {
+
+using curve::common::TokenBucket;
+
+/**
+ * 文件级别的iops和带宽限流
+ * 限制值来自mds下发的文件信息(FInfo)，在打开文件和刷新session时更新，
+ * 不限制时只检查一个原子变量，不会引入额外的开销
+ */
+class FileThrottle : public curve::common::Uncopyable {
+ public:
+    FileThrottle();
+
+    /**
+     * @brief 初始化，需要在UpdateThrottleParams之前调用
+     * @param opt 限流配置，burstSeconds为令牌桶的容量，以限制值的秒数表示
+     */
+    void Init(const ThrottleOption& opt);
+
+    /**
+     * @brief 更新限流参数，0表示不限制
+     */
+    void UpdateThrottleParams(uint64_t iopsLimit, uint64_t bpsLimit);
+
+    /**
+     * @brief 为一个长度为length的IO取令牌，令牌不足时睡眠等待
+     * @return 等待的时间，单位us
+     */
+    uint64_t Add(uint64_t length);
+
+    /**
+     * @brief 为一个长度为length的IO取令牌，不等待
+     * @param nowUs 当前时间，单位us
+     * @return 需要等待的时间，单位us
+     */
+    uint64_t Reserve(uint64_t length, uint64_t nowUs);
+
+    bool Enabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    uint32_t burstSeconds_;
+    std::atomic<bool> enabled_;
+    TokenBucket iopsBucket_;
+    TokenBucket bpsBucket_;
+};
+
+}  // namespace client
+}  // namespace curve
+
+#endif  // SRC_CLIENT_FILE_THROTTLE_H_
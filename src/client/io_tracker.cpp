@@ -21,6 +21,7 @@
  */
 
 #include <glog/logging.h>
+#include <brpc/errno.pb.h>
 
 #include <algorithm>
 
@@ -262,6 +263,39 @@ void IOTracker::GetChunkInfo(const ChunkIDInfo &cinfo,
     }
 }
 
+void IOTracker::GetChunksInfo(const std::vector<ChunkIDInfo> &cinfos,
+    std::vector<ChunkInfoDetail> *chunkInfos) {
+    type_ = OpType::GET_CHUNKS_INFO;
+
+    int ret = -1;
+    do {
+        if (cinfos.empty()) {
+            break;
+        }
+        RequestContext* newreqNode = RequestContext::NewInitedRequestContext();
+        if (newreqNode == nullptr) {
+            break;
+        }
+
+        newreqNode->chunkinfodetails_ = chunkInfos;
+        for (const auto &cinfo : cinfos) {
+            newreqNode->chunkIds_.push_back(cinfo.cid_);
+        }
+        FillCommonFields(cinfos[0], newreqNode);
+
+        reqlist_.push_back(newreqNode);
+        reqcount_.store(reqlist_.size(), std::memory_order_release);
+
+        ret = scheduler_->ScheduleRequest(reqlist_);
+    } while (false);
+
+    if (ret == -1) {
+        LOG(ERROR) << "GetChunksInfo request schedule failed,"
+                   << " return and recycle resource!";
+        ReturnOnFail();
+    }
+}
+
 void IOTracker::CreateCloneChunk(const std::string& location,
                                  const ChunkIDInfo& cinfo, uint64_t sn,
                                  uint64_t correntSn, uint64_t chunkSize,
@@ -332,7 +366,9 @@ void IOTracker::FillCommonFields(ChunkIDInfo idinfo, RequestContext* req) {
 
 void IOTracker::HandleResponse(RequestContext* reqctx) {
     int errorcode = reqctx->done_->GetErrorCode();
-    if (errorcode != 0) {
+    if (errorcode == brpc::ENOMETHOD) {
+        errcode_ = LIBCURVE_ERROR::NOT_SUPPORT;
+    } else if (errorcode != 0) {
         ChunkServerErr2LibcurveErr(static_cast<CHUNK_OP_STATUS>(errorcode),
                                    &errcode_);
     }
@@ -131,6 +131,13 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
      */
     void GetChunkInfo(const ChunkIDInfo &cinfo,
                      ChunkInfoDetail *chunkInfo);
+    /**
+     * 批量获取同一个copyset中多个chunk的版本信息，chunkInfos是出参
+     * @param:cinfos 目标chunk，必须属于同一个copyset
+     * @param: chunkInfos与cinfos一一对应
+     */
+    void GetChunksInfo(const std::vector<ChunkIDInfo> &cinfos,
+                     std::vector<ChunkInfoDetail> *chunkInfos);
 
     /**
      * @brief lazy 创建clone chunk
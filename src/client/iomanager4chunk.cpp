@@ -19,6 +19,8 @@
  * File Created: Wednesday, 26th December 2018 3:48:08 pm
  * Author: tongguangxun
  */
+#include <glog/logging.h>
+
 #include "include/curve_compiler_specific.h"
 #include "src/client/client_config.h"
 #include "src/client/iomanager4chunk.h"
@@ -80,6 +82,36 @@ int IOManager4Chunk::GetChunkInfo(const ChunkIDInfo &chunkidinfo,
     return temp.Wait();
 }
 
+int IOManager4Chunk::GetChunksInfo(
+    const std::vector<ChunkIDInfo> &chunkidinfos,
+    std::vector<ChunkInfoDetail> *chunkInfos) {
+    int ret = 0;
+    {
+        IOTracker temp(this, &mc_, scheduler_);
+        temp.GetChunksInfo(chunkidinfos, chunkInfos);
+        ret = temp.Wait();
+    }
+    if (ret != -LIBCURVE_ERROR::NOT_SUPPORT) {
+        return ret;
+    }
+
+    // 老版本chunkserver不支持GetChunksInfo，降级为逐个GetChunkInfo，
+    // 此时拿不到correctedSn和writtenPageNum
+    LOG(WARNING) << "GetChunksInfo not supported, fall back to GetChunkInfo"
+                 << ", logicpool id = " << chunkidinfos[0].lpid_
+                 << ", copyset id = " << chunkidinfos[0].cpid_
+                 << ", chunk num = " << chunkidinfos.size();
+    chunkInfos->clear();
+    chunkInfos->resize(chunkidinfos.size());
+    for (size_t i = 0; i < chunkidinfos.size(); ++i) {
+        ret = GetChunkInfo(chunkidinfos[i], &(*chunkInfos)[i]);
+        if (ret != LIBCURVE_ERROR::OK) {
+            return ret;
+        }
+    }
+    return LIBCURVE_ERROR::OK;
+}
+
 int IOManager4Chunk::CreateCloneChunk(const std::string &location,
     const ChunkIDInfo &chunkidinfo, uint64_t sn, uint64_t correntSn,
     uint64_t chunkSize, SnapCloneClosure* scc) {
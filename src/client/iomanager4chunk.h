@@ -26,6 +26,7 @@
 #include <atomic>
 #include <mutex>    // NOLINT
 #include <string>
+#include <vector>
 #include <condition_variable>   // NOLINT
 
 #include "src/client/metacache.h"
@@ -74,6 +75,14 @@ class IOManager4Chunk : public IOManager {
     */
     int GetChunkInfo(const ChunkIDInfo &chunkidinfo,
                      ChunkInfoDetail *chunkInfo);
+   /**
+    * 批量获取同一个copyset中多个chunk的版本信息，chunkInfos是出参
+    * @param:chunkidinfos 目标chunk，必须属于同一个copyset
+    * @param: chunkInfos与chunkidinfos一一对应
+    * chunkserver不支持GetChunksInfo时降级为逐个调用GetChunkInfo
+    */
+    int GetChunksInfo(const std::vector<ChunkIDInfo> &chunkidinfos,
+                      std::vector<ChunkInfoDetail> *chunkInfos);
 
    /**
     * @brief lazy 创建clone chunk
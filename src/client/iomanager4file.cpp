@@ -21,17 +21,24 @@
  */
 
 #include <glog/logging.h>
+#include <bthread/bthread.h>
+#include <butil/time.h>
 
 #include <chrono>   // NOLINT
+#include <memory>
 
 #include "src/client/metacache.h"
 #include "src/client/iomanager4file.h"
 #include "src/client/file_instance.h"
 #include "src/client/io_tracker.h"
 #include "src/client/splitor.h"
+#include "src/common/timeutility.h"
 
 namespace curve {
 namespace client {
+
+using curve::common::TimeUtility;
+
 Atomic<uint64_t> IOManager::idRecorder_(1);
 IOManager4File::IOManager4File(): scheduler_(nullptr), exit_(false) {
 }
@@ -47,6 +54,8 @@ bool IOManager4File::Initialize(const std::string& filename,
     inflightRpcCntl_.SetMaxInflightNum(
         ioopt_.ioSenderOpt.inflightOpt.fileMaxInFlightRPCNum);
 
+    throttle_.Init(ioopt_.throttleOpt);
+
     fileMetric_ = new (std::nothrow) FileMetric(filename);
     if (fileMetric_ == nullptr) {
         LOG(ERROR) << "allocate client metric failed!";
@@ -87,6 +96,9 @@ bool IOManager4File::Initialize(const std::string& filename,
 }
 
 void IOManager4File::UnInitialize() {
+    // 预取线程会访问mds client和metacache，先于其他模块退出
+    mc_.StopPrefetchSegments();
+
     bool exitFlag = false;
     std::mutex exitMtx;
     std::condition_variable exitCv;
@@ -128,6 +140,7 @@ int IOManager4File::Read(char* buf, off_t offset,
     size_t length, MDSClient* mdsclient) {
     MetricHelper::IncremUserRPSCount(fileMetric_, OpType::READ);
     FlightIOGuard guard(this);
+    Throttle(length);
 
     butil::IOBuf data;
 
@@ -151,6 +164,7 @@ int IOManager4File::Write(const char* buf,
                           MDSClient* mdsclient) {
     MetricHelper::IncremUserRPSCount(fileMetric_, OpType::WRITE);
     FlightIOGuard guard(this);
+    Throttle(length);
 
     butil::IOBuf data;
     data.append_user_data(const_cast<char*>(buf), length, TrivialDeleter);
@@ -182,7 +196,7 @@ int IOManager4File::AioRead(CurveAioContext* ctx, MDSClient* mdsclient,
         temp->StartAioRead(ctx, mdsclient, this->GetFileInfo());
     };
 
-    taskPool_.Enqueue(task);
+    ThrottleAndEnqueue(ctx->length, task);
     return LIBCURVE_ERROR::OK;
 }
 
@@ -205,12 +219,71 @@ int IOManager4File::AioWrite(CurveAioContext* ctx, MDSClient* mdsclient,
         temp->StartAioWrite(ctx, mdsclient, this->GetFileInfo());
     };
 
-    taskPool_.Enqueue(task);
+    ThrottleAndEnqueue(ctx->length, task);
     return LIBCURVE_ERROR::OK;
 }
 
 void IOManager4File::UpdateFileInfo(const FInfo_t& fi) {
     mc_.UpdateFileInfo(fi);
+    throttle_.UpdateThrottleParams(fi.iopsLimit, fi.bpsLimit);
+}
+
+void IOManager4File::UpdateThrottleParams(uint64_t iopsLimit,
+                                          uint64_t bpsLimit) {
+    throttle_.UpdateThrottleParams(iopsLimit, bpsLimit);
+    mc_.UpdateThrottleParams(iopsLimit, bpsLimit);
+}
+
+void IOManager4File::Throttle(uint64_t length) {
+    uint64_t waitUs = throttle_.Add(length);
+    if (waitUs > 0) {
+        MetricHelper::ThrottleWaitRecord(fileMetric_, waitUs);
+    }
+}
+
+namespace {
+
+void* RunThrottledTask(void* arg) {
+    std::unique_ptr<std::function<void()>> task(
+        static_cast<std::function<void()>*>(arg));
+    (*task)();
+    return nullptr;
+}
+
+// 运行在bthread的定时器线程中，不能阻塞，另起bthread下发IO
+void OnThrottleTimer(void* arg) {
+    bthread_t tid;
+    if (bthread_start_background(&tid, nullptr, RunThrottledTask, arg) != 0) {
+        LOG(ERROR) << "start bthread for throttled io failed";
+        RunThrottledTask(arg);
+    }
+}
+
+}  // namespace
+
+void IOManager4File::ThrottleAndEnqueue(uint64_t length,
+                                        std::function<void()> task) {
+    uint64_t waitUs = 0;
+    if (throttle_.Enabled()) {
+        waitUs = throttle_.Reserve(length, TimeUtility::GetTimeofDayUs());
+    }
+    if (waitUs == 0) {
+        taskPool_.Enqueue(task);
+        return;
+    }
+
+    MetricHelper::ThrottleWaitRecord(fileMetric_, waitUs);
+    auto* arg = new std::function<void()>(std::move(task));
+    bthread_timer_t timer;
+    if (bthread_timer_add(&timer, butil::microseconds_from_now(waitUs),
+                          OnThrottleTimer, arg) != 0) {
+        LOG(ERROR) << "add throttle timer failed, wait in task pool";
+        auto sleepTask = [waitUs, arg]() {
+            bthread_usleep(waitUs);
+            RunThrottledTask(arg);
+        };
+        taskPool_.Enqueue(sleepTask);
+    }
 }
 
 void IOManager4File::HandleAsyncIOResponse(IOTracker* iotracker) {
@@ -28,11 +28,13 @@
 
 #include <atomic>
 #include <condition_variable>  // NOLINT
+#include <functional>
 #include <mutex>               // NOLINT
 #include <string>
 
 #include "include/curve_compiler_specific.h"
 #include "src/client/client_common.h"
+#include "src/client/file_throttle.h"
 #include "src/client/inflight_controller.h"
 #include "src/client/iomanager.h"
 #include "src/client/mds_client.h"
@@ -157,6 +159,12 @@ class IOManager4File : public IOManager {
      */
     void UpdateFileInfo(const FInfo_t& fi);
 
+    /**
+     * lease excutor刷新session成功后，用mds返回的文件信息更新限流参数
+     * @param: iopsLimit和bpsLimit为文件的iops和带宽上限，0表示不限制
+     */
+    void UpdateThrottleParams(uint64_t iopsLimit, uint64_t bpsLimit);
+
     const FInfo* GetFileInfo() const {
         return mc_.GetFileInfo();
     }
@@ -202,6 +210,20 @@ class IOManager4File : public IOManager {
      */
     void HandleAsyncIOResponse(IOTracker* iotracker) override;
 
+    /**
+     * 同步IO下发前按文件的限流参数取令牌，令牌不足时在用户线程中等待
+     * @param: length为用户IO的长度
+     */
+    void Throttle(uint64_t length);
+
+    /**
+     * 异步IO按文件的限流参数取令牌，令牌足够时直接放入隔离线程池，
+     * 否则由bthread定时器到期后再下发，不占用隔离线程池的线程
+     * @param: length为用户IO的长度
+     * @param: task为下发IO的任务
+     */
+    void ThrottleAndEnqueue(uint64_t length, std::function<void()> task);
+
     class FlightIOGuard {
      public:
         explicit FlightIOGuard(IOManager4File* iomana) {
@@ -240,6 +262,9 @@ class IOManager4File : public IOManager {
     // inflight rpc控制
     InflightControl inflightRpcCntl_;
 
+    // 文件级别的iops和带宽限流
+    FileThrottle throttle_;
+
     // 是否退出
     bool exit_;
 
@@ -105,6 +105,8 @@ bool LeaseExecutor::RefreshLease() {
 
     if (response.status == LeaseRefreshResult::Status::OK) {
         CheckNeedUpdateVersion(response.finfo.seqnum);
+        iomanager_->UpdateThrottleParams(response.finfo.iopsLimit,
+                                         response.finfo.bpsLimit);
         failedrefreshcount_.store(0);
         isleaseAvaliable_.store(true);
         iomanager_->RefeshSuccAndResumeIO();
@@ -283,5 +283,10 @@ int SnapshotClient::GetChunkInfo(ChunkIDInfo cidinfo,
                                         ChunkInfoDetail *chunkInfo) {
     return iomanager4chunk_.GetChunkInfo(cidinfo, chunkInfo);
 }
+
+int SnapshotClient::GetChunksInfo(const std::vector<ChunkIDInfo> &cidinfos,
+                                  std::vector<ChunkInfoDetail> *chunkInfos) {
+    return iomanager4chunk_.GetChunksInfo(cidinfos, chunkInfos);
+}
 }   // namespace client
 }   // namespace curve
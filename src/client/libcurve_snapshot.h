@@ -137,6 +137,13 @@ class SnapshotClient {
    * @param: chunkInfo是快照的详细信息
    */
   int GetChunkInfo(ChunkIDInfo cidinfo, ChunkInfoDetail *chunkInfo);
+  /**
+   * 批量获取同一个copyset中多个chunk的版本信息，chunkInfos是出参
+   * @param: cidinfos是chunk对应的id信息，必须属于同一个copyset
+   * @param: chunkInfos与cidinfos一一对应
+   */
+  int GetChunksInfo(const std::vector<ChunkIDInfo> &cidinfos,
+                    std::vector<ChunkInfoDetail> *chunkInfos);
   /**
    * 获取快照状态
    * @param: userinfo是用户信息
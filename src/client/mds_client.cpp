@@ -922,6 +922,68 @@ LIBCURVE_ERROR MDSClient::GetOrAllocateSegment(bool allocate,
     return rpcExcutor.DoRPCTask(task, IOPathMaxRetryMS);
 }
 
+LIBCURVE_ERROR MDSClient::ListSegments(const FInfo_t* fi,
+                                       uint64_t startOffset,
+                                       uint32_t limit,
+                                       std::vector<SegmentInfo>* segInfos,
+                                       uint64_t* nextOffset) {
+    auto task = RPCTaskDefine {
+        ListSegmentsResponse response;
+        mdsClientMetric_.listSegments.qps.count << 1;
+        LatencyGuard lg(&mdsClientMetric_.listSegments.latency);
+        mdsClientBase_.ListSegments(fi, startOffset, limit,
+                                    &response, cntl, channel);
+        if (cntl->Failed()) {
+            mdsClientMetric_.listSegments.eps.count << 1;
+            // 老版本的mds没有该接口，不需要重试
+            if (cntl->ErrorCode() == brpc::ENOMETHOD) {
+                LOG(WARNING) << "ListSegments not supported by mds";
+                return LIBCURVE_ERROR::NOT_SUPPORT;
+            }
+            LOG(WARNING) << "ListSegments invoke failed, errcorde = "
+                << cntl->ErrorCode() << ", error content:"
+                << cntl->ErrorText() << ", log id = " << cntl->log_id();
+            return -cntl->ErrorCode();
+        }
+
+        auto statuscode = response.statuscode();
+        switch (statuscode) {
+            case StatusCode::kOK:
+                break;
+            case StatusCode::kOwnerAuthFail:
+                LOG(WARNING) << "ListSegments Auth failed!";
+                return LIBCURVE_ERROR::AUTHFAIL;
+            default:
+                LOG(WARNING) << "ListSegments failed, filename = "
+                             << fi->fullPathName << ", errocde = "
+                             << statuscode << ", error msg = "
+                             << StatusCode_Name(statuscode);
+                return LIBCURVE_ERROR::FAILED;
+        }
+
+        segInfos->clear();
+        segInfos->reserve(response.pagefilesegment_size());
+        for (const auto& pfs : response.pagefilesegment()) {
+            SegmentInfo segInfo;
+            segInfo.chunksize = pfs.chunksize();
+            segInfo.segmentsize = pfs.segmentsize();
+            segInfo.startoffset = pfs.startoffset();
+            LogicPoolID logicpoolid = pfs.logicalpoolid();
+            segInfo.lpcpIDInfo.lpid = logicpoolid;
+            for (const auto& chunk : pfs.chunks()) {
+                segInfo.lpcpIDInfo.cpidVec.push_back(chunk.copysetid());
+                segInfo.chunkvec.emplace_back(chunk.chunkid(), logicpoolid,
+                                              chunk.copysetid());
+            }
+            segInfos->emplace_back(std::move(segInfo));
+        }
+        *nextOffset = response.has_nextoffset() ? response.nextoffset()
+                                                : fi->length;
+        return LIBCURVE_ERROR::OK;
+    };
+    return rpcExcutor.DoRPCTask(task, metaServerOpt_.mdsMaxRetryMS);
+}
+
 LIBCURVE_ERROR MDSClient::RenameFile(const UserInfo_t& userinfo,
                                      const std::string& origin,
                                      const std::string& destination,
@@ -127,6 +127,23 @@ class MDSClient {
                                         uint64_t offset,
                                         const FInfo_t* fi,
                                         SegmentInfo* segInfo);
+    /**
+     * 分页获取文件已经分配的segment的chunk信息
+     * @param: fi是当前文件的基本信息
+     * @param: startOffset为本次列出的起始segment偏移
+     * @param: limit为本次最多返回的segment数量
+     * @param[out]: segInfos保存本次获取到的segment信息
+     * @param[out]: nextOffset为下一页的起始偏移，列完时不小于文件长度
+     * @return: 成功返回LIBCURVE_ERROR::OK，
+     *          如果认证失败返回LIBCURVE_ERROR::AUTHFAIL，
+     *          mds不支持该接口时返回LIBCURVE_ERROR::NOT_SUPPORT，
+     *          否则返回LIBCURVE_ERROR::FAILED
+     */
+    LIBCURVE_ERROR ListSegments(const FInfo_t* fi,
+                                uint64_t startOffset,
+                                uint32_t limit,
+                                std::vector<SegmentInfo>* segInfos,
+                                uint64_t* nextOffset);
     /**
      * 获取文件信息，fi是出参
      * @param: filename是文件名
@@ -364,6 +364,28 @@ void MDSClientBase::GetOrAllocateSegment(bool allocate,
     stub.GetOrAllocateSegment(cntl, &request, response, NULL);
 }
 
+void MDSClientBase::ListSegments(const FInfo_t* fi,
+                                 uint64_t startOffset,
+                                 uint32_t limit,
+                                 ListSegmentsResponse* response,
+                                 brpc::Controller* cntl,
+                                 brpc::Channel* channel) {
+    ListSegmentsRequest request;
+    request.set_filename(fi->fullPathName);
+    request.set_startoffset(startOffset);
+    request.set_limit(limit);
+    FillUserInfo(&request, fi->userinfo);
+
+    LOG(INFO) << "ListSegments: filename = " << fi->fullPathName
+                << ", owner = " << fi->owner
+                << ", start offset = " << startOffset
+                << ", limit = " << limit
+                << ", log id = " << cntl->log_id();
+
+    curve::mds::CurveFSService_Stub stub(channel);
+    stub.ListSegments(cntl, &request, response, NULL);
+}
+
 void MDSClientBase::RenameFile(const UserInfo_t& userinfo,
                                const std::string& origin,
                                const std::string& destination,
@@ -76,6 +76,8 @@ using curve::mds::SetCloneFileStatusRequest;
 using curve::mds::SetCloneFileStatusResponse;
 using curve::mds::GetOrAllocateSegmentRequest;
 using curve::mds::GetOrAllocateSegmentResponse;
+using curve::mds::ListSegmentsRequest;
+using curve::mds::ListSegmentsResponse;
 using curve::mds::CheckSnapShotStatusRequest;
 using curve::mds::CheckSnapShotStatusResponse;
 using curve::mds::ListSnapShotFileInfoRequest;
@@ -330,6 +332,21 @@ class MDSClientBase {
                               GetOrAllocateSegmentResponse* response,
                               brpc::Controller* cntl,
                               brpc::Channel* channel);
+    /**
+     * 分页获取文件已经分配的segment信息
+     * @param: fi是当前文件的基本信息
+     * @param: startOffset为本次列出的起始segment偏移
+     * @param: limit为本次最多返回的segment数量
+     * @param[out]: response为该rpc的response，提供给外部处理
+     * @param[in|out]: cntl既是入参，也是出参，返回RPC状态
+     * @param[in]:channel是当前与mds建立的通道
+     */
+    void ListSegments(const FInfo_t* fi,
+                      uint64_t startOffset,
+                      uint32_t limit,
+                      ListSegmentsResponse* response,
+                      brpc::Controller* cntl,
+                      brpc::Channel* channel);
     /**
      * @brief 重名文件
      * @param:userinfo 用户信息
@@ -23,6 +23,8 @@
 
 #include <bthread/bthread.h>
 
+#include <map>
+#include <set>
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -33,6 +35,7 @@
 #include "src/client/mds_client.h"
 #include "src/client/client_common.h"
 #include "src/common/concurrent/concurrent.h"
+#include "src/common/timeutility.h"
 
 namespace curve {
 namespace client {
@@ -40,6 +43,7 @@ namespace client {
 using curve::common::WriteLockGuard;
 using curve::common::ReadLockGuard;
 using curve::client::ClientConfig;
+using curve::common::TimeUtility;
 
 void MetaCache::Init(const MetaCacheOption& metaCacheOpt,
                      MDSClient* mdsclient) {
@@ -58,10 +62,7 @@ void MetaCache::Init(const MetaCacheOption& metaCacheOpt,
 
 MetaCacheErrorType MetaCache::GetChunkInfoByIndex(ChunkIndex chunkidx,
                                                   ChunkIDInfo* chunxinfo) {
-    ReadLockGuard rdlk(rwlock4ChunkInfo_);
-    auto iter = chunkindex2idMap_.find(chunkidx);
-    if (iter != chunkindex2idMap_.end()) {
-        *chunxinfo = iter->second;
+    if (chunkIndexTable_.Get(chunkidx, chunxinfo)) {
         return MetaCacheErrorType::OK;
     }
     return MetaCacheErrorType::CHUNKINFO_NOT_FOUND;
@@ -69,16 +70,16 @@ MetaCacheErrorType MetaCache::GetChunkInfoByIndex(ChunkIndex chunkidx,
 
 bool MetaCache::IsLeaderMayChange(LogicPoolID logicPoolId,
                                   CopysetID copysetId) {
-    rwlock4ChunkInfo_.RDLock();
+    rwlock4CopysetInfo_.RDLock();
     auto iter = lpcsid2CopsetInfoMap_.find(
         CalcLogicPoolCopysetID(logicPoolId, copysetId));
     if (iter == lpcsid2CopsetInfoMap_.end()) {
-        rwlock4ChunkInfo_.Unlock();
+        rwlock4CopysetInfo_.Unlock();
         return false;
     }
 
     bool flag = iter->second.LeaderMayChange();
-    rwlock4ChunkInfo_.Unlock();
+    rwlock4CopysetInfo_.Unlock();
     return flag;
 }
 
@@ -138,6 +139,61 @@ int MetaCache::GetLeader(LogicPoolID logicPoolId,
     return targetInfo.GetLeaderInfo(serverId, serverAddr);
 }
 
+int MetaCache::GetFollowerReadPeer(LogicPoolID logicPoolId,
+                                   CopysetID copysetId,
+                                   uint64_t hint,
+                                   ChunkServerID* serverId,
+                                   EndPoint* serverAddr) {
+    const auto key = CalcLogicPoolCopysetID(logicPoolId, copysetId);
+
+    std::vector<CopysetPeerInfo> peers;
+    {
+        ReadLockGuard rdlk(rwlock4CopysetInfo_);
+        auto iter = lpcsid2CopsetInfoMap_.find(key);
+        // leader可能变更时peer信息也可能过期，走leader刷新的流程
+        if (iter == lpcsid2CopsetInfoMap_.end() ||
+            iter->second.LeaderMayChange()) {
+            return -1;
+        }
+        peers = iter->second.csinfos_;
+    }
+
+    const uint32_t maxTimeoutTimes =
+        metacacheopt_.chunkserverUnstableOption.maxStableChunkServerTimeoutTimes;  // NOLINT
+    const butil::ip_t localIp = butil::my_ip();
+    std::vector<const CopysetPeerInfo*> candidates;
+    uint32_t minTimeoutTimes = UINT32_MAX;
+    for (const auto& peer : peers) {
+        uint32_t timeoutTimes =
+            unstableHelper_.GetTimeoutTimes(peer.chunkserverID);
+        if (timeoutTimes > maxTimeoutTimes) {
+            continue;
+        }
+        // 本机上的副本不经过网络，直接选择
+        if (peer.externalAddr.addr_.ip == localIp) {
+            *serverId = peer.chunkserverID;
+            *serverAddr = peer.externalAddr.addr_;
+            return 0;
+        }
+        if (timeoutTimes < minTimeoutTimes) {
+            minTimeoutTimes = timeoutTimes;
+            candidates.clear();
+        }
+        if (timeoutTimes == minTimeoutTimes) {
+            candidates.push_back(&peer);
+        }
+    }
+
+    if (candidates.empty()) {
+        return -1;
+    }
+
+    const CopysetPeerInfo* target = candidates[hint % candidates.size()];
+    *serverId = target->chunkserverID;
+    *serverAddr = target->externalAddr.addr_;
+    return 0;
+}
+
 int MetaCache::UpdateLeaderInternal(LogicPoolID logicPoolId,
                                     CopysetID copysetId,
                                     CopysetInfo* toupdateCopyset,
@@ -264,8 +320,116 @@ int MetaCache::UpdateLeader(LogicPoolID logicPoolId,
 
 void MetaCache::UpdateChunkInfoByIndex(ChunkIndex cindex,
                                        const ChunkIDInfo& cinfo) {
-    WriteLockGuard wrlk(rwlock4ChunkInfo_);
-    chunkindex2idMap_[cindex] = cinfo;
+    chunkIndexTable_.Set(cindex, cinfo);
+}
+
+int MetaCache::PrefetchSegments() {
+    if (!metacacheopt_.metacachePrefetchSegmentsOnOpen) {
+        return 0;
+    }
+    return DoPrefetchSegments(fileInfo_);
+}
+
+void MetaCache::StartPrefetchSegments() {
+    if (!metacacheopt_.metacachePrefetchSegmentsOnOpen ||
+        prefetchThread_.joinable()) {
+        return;
+    }
+    // 文件信息在当前线程复制，预取线程不访问会被并发更新的fileInfo_
+    const FInfo fileInfo = fileInfo_;
+    prefetchStop_.store(false, std::memory_order_relaxed);
+    prefetchThread_ = std::thread([this, fileInfo]() {
+        DoPrefetchSegments(fileInfo);
+    });
+}
+
+void MetaCache::StopPrefetchSegments() {
+    prefetchStop_.store(true, std::memory_order_relaxed);
+    if (prefetchThread_.joinable()) {
+        prefetchThread_.join();
+    }
+}
+
+int MetaCache::DoPrefetchSegments(const FInfo& fileInfo) {
+    if (fileInfo.chunksize == 0 || fileInfo.segmentsize == 0) {
+        LOG(WARNING) << "invalid file info, skip prefetch segments, filename = "
+                     << fileInfo.fullPathName;
+        return -1;
+    }
+
+    const uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    uint64_t offset = 0;
+    uint64_t segmentNum = 0;
+    while (offset < fileInfo.length) {
+        if (prefetchStop_.load(std::memory_order_relaxed)) {
+            LOG(INFO) << "prefetch segments stopped, filename = "
+                      << fileInfo.fullPathName << ", offset = " << offset;
+            return -1;
+        }
+        std::vector<SegmentInfo> segInfos;
+        uint64_t nextOffset = 0;
+        LIBCURVE_ERROR ret = mdsclient_->ListSegments(
+            &fileInfo, offset, metacacheopt_.metacachePrefetchSegmentsPageSize,
+            &segInfos, &nextOffset);
+        if (ret != LIBCURVE_ERROR::OK) {
+            LOG(WARNING) << "ListSegments failed, filename = "
+                         << fileInfo.fullPathName << ", offset = " << offset
+                         << ", ret = " << ret;
+            return -1;
+        }
+
+        // 同一页的segment按逻辑池合并copyset，一次获取server list
+        std::map<LogicPoolID, std::set<CopysetID>> copysets;
+        for (const auto& segInfo : segInfos) {
+            uint64_t chunkIdx = segInfo.startoffset / fileInfo.chunksize;
+            for (const auto& chunkIdInfo : segInfo.chunkvec) {
+                UpdateChunkInfoByIndex(chunkIdx++, chunkIdInfo);
+            }
+            copysets[segInfo.lpcpIDInfo.lpid].insert(
+                segInfo.lpcpIDInfo.cpidVec.begin(),
+                segInfo.lpcpIDInfo.cpidVec.end());
+        }
+
+        for (const auto& item : copysets) {
+            std::vector<CopysetID> cpids(item.second.begin(),
+                                         item.second.end());
+            std::vector<CopysetInfo> copysetInfos;
+            ret = mdsclient_->GetServerList(item.first, cpids, &copysetInfos);
+            if (ret != LIBCURVE_ERROR::OK) {
+                LOG(WARNING) << "GetServerList failed, filename = "
+                             << fileInfo.fullPathName
+                             << ", logicpool id = " << item.first;
+                return -1;
+            }
+
+            for (const auto& copysetInfo : copysetInfos) {
+                for (const auto& peerInfo : copysetInfo.csinfos_) {
+                    AddCopysetIDInfo(peerInfo.chunkserverID,
+                        CopysetIDInfo(item.first, copysetInfo.cpid_));
+                }
+                // 预取与IO并发，不覆盖IO过程中已经更新过leader的copyset
+                const auto key =
+                    CalcLogicPoolCopysetID(item.first, copysetInfo.cpid_);
+                WriteLockGuard wrlk(rwlock4CopysetInfo_);
+                lpcsid2CopsetInfoMap_.emplace(key, copysetInfo);
+            }
+        }
+
+        segmentNum += segInfos.size();
+        if (nextOffset <= offset) {
+            break;
+        }
+        offset = nextOffset;
+    }
+
+    LOG(INFO) << "prefetch segments success, filename = "
+              << fileInfo.fullPathName
+              << ", segment num = " << segmentNum
+              << ", cached chunk num = " << chunkIndexTable_.Size()
+              << ", chunk table memory = "
+              << chunkIndexTable_.MemoryBytes() << " bytes"
+              << ", cost " << TimeUtility::GetTimeofDayUs() - startUs << " us";
+    return 0;
 }
 
 void MetaCache::UpdateCopysetInfo(LogicPoolID logicPoolid, CopysetID copysetid,
@@ -22,10 +22,13 @@
 #ifndef SRC_CLIENT_METACACHE_H_
 #define SRC_CLIENT_METACACHE_H_
 
+#include <atomic>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
+#include "src/client/chunk_index_table.h"
 #include "src/client/client_common.h"
 #include "src/client/client_config.h"
 #include "src/client/client_metric.h"
@@ -53,10 +56,11 @@ class MetaCache {
     using LogicPoolCopysetID = uint64_t;
     using ChunkInfoMap = std::unordered_map<ChunkID, ChunkIDInfo>;
     using CopysetInfoMap = std::unordered_map<LogicPoolCopysetID, CopysetInfo>;
-    using ChunkIndexInfoMap = std::unordered_map<ChunkIndex, ChunkIDInfo>;
 
     MetaCache() = default;
-    virtual ~MetaCache() = default;
+    virtual ~MetaCache() {
+        StopPrefetchSegments();
+    }
 
     /**
      * 初始化函数
@@ -102,6 +106,23 @@ class MetaCache {
                           butil::EndPoint* serverAddr,
                           bool refresh = false,
                           FileMetric* fm = nullptr);
+    /**
+     * follower读时选择一个副本：跳过连续超时次数超过阈值的chunkserver，
+     * 优先选择与client在同一台机器上的副本，否则在超时次数最少的副本中
+     * 按hint分散选择，leader也在候选范围内
+     * @param: logicPoolId逻辑池id
+     * @param: copysetId复制组id
+     * @param: hint用于在多个候选副本之间分散请求，一般为chunk id
+     * @param: serverId选中的chunkserver id，是出参
+     * @param: serverAddr选中的chunkserver地址，是出参
+     * @return: 成功返回0，没有可用副本或leader可能变更时返回-1
+     */
+    virtual int GetFollowerReadPeer(LogicPoolID logicPoolId,
+                                    CopysetID copysetId,
+                                    uint64_t hint,
+                                    ChunkServerID* serverId,
+                                    butil::EndPoint* serverAddr);
+
     /**
      * 更新某个copyset的leader信息
      * @param logicPoolId 逻辑池id
@@ -207,6 +228,38 @@ class MetaCache {
 
     void UpdateFileInfo(const FInfo& fileInfo) {
         fileInfo_ = fileInfo;
+        if (fileInfo.chunksize != 0) {
+            chunkIndexTable_.Reserve(fileInfo.length / fileInfo.chunksize);
+        }
+    }
+
+    /**
+     * 分页从mds获取文件所有已分配的segment，更新chunk信息和copyset信息，
+     * 只有开启metacachePrefetchSegmentsOnOpen时才会获取
+     * @return: 成功或者未开启返回0，否则返回-1，失败不影响IO，
+     *          未获取到的segment在IO时再按需获取
+     */
+    virtual int PrefetchSegments();
+
+    /**
+     * 在后台线程中执行PrefetchSegments，不阻塞open，
+     * 预取完成前的IO按需获取segment
+     */
+    void StartPrefetchSegments();
+
+    /**
+     * 停止后台预取并等待预取线程退出
+     */
+    void StopPrefetchSegments();
+
+    // 已经缓存的chunk数量
+    uint64_t GetCachedChunkNum() const {
+        return chunkIndexTable_.Size();
+    }
+
+    // chunk映射表占用的内存
+    uint64_t GetChunkTableMemoryBytes() const {
+        return chunkIndexTable_.MemoryBytes();
     }
 
     const FInfo* GetFileInfo() const {
@@ -221,6 +274,14 @@ class MetaCache {
         fileInfo_.seqnum = newSn;
     }
 
+    /**
+     * 更新文件的iops和带宽上限，随读写请求下发给chunkserver做卷级流控
+     */
+    void UpdateThrottleParams(uint64_t iopsLimit, uint64_t bpsLimit) {
+        fileInfo_.iopsLimit = iopsLimit;
+        fileInfo_.bpsLimit = bpsLimit;
+    }
+
     /**
      * 获取对应的copyset的LeaderMayChange标志
      */
@@ -269,22 +330,27 @@ class MetaCache {
         CopysetID copysetId,
         const ChunkServerAddr& leaderAddr);
 
+    /**
+     * 按给定的文件信息分页预取segment
+     */
+    int DoPrefetchSegments(const FInfo& fileInfo);
+
  private:
     MDSClient*          mdsclient_;
     MetaCacheOption   metacacheopt_;
 
-    // chunkindex到chunkidinfo的映射表
-    CURVE_CACHELINE_ALIGNMENT ChunkIndexInfoMap     chunkindex2idMap_;
+    // chunkindex到chunkidinfo的映射表，读不加锁
+    CURVE_CACHELINE_ALIGNMENT ChunkIndexTable       chunkIndexTable_;
 
     // logicalpoolid和copysetid到copysetinfo的映射表
     CURVE_CACHELINE_ALIGNMENT CopysetInfoMap        lpcsid2CopsetInfoMap_;
 
-    // chunkid到chunkidinfo的映射表
+    // chunkid到chunkidinfo的映射表，只有快照client使用，
+    // 它的metacache由所有快照文件共用，不能按chunk index寻址
     CURVE_CACHELINE_ALIGNMENT ChunkInfoMap          chunkid2chunkInfoMap_;
 
-    // 三个读写锁分别保护上述三个映射表
+    // 两个读写锁分别保护上述copyset和chunkid映射表
     CURVE_CACHELINE_ALIGNMENT RWLock    rwlock4chunkInfoMap_;
-    CURVE_CACHELINE_ALIGNMENT RWLock    rwlock4ChunkInfo_;
     CURVE_CACHELINE_ALIGNMENT RWLock    rwlock4CopysetInfo_;
 
     // chunkserverCopysetIDMap_存放当前chunkserver到copyset的映射
@@ -301,6 +367,10 @@ class MetaCache {
     FInfo fileInfo_;
 
     UnstableHelper unstableHelper_;
+
+    // 后台预取segment的线程及其退出标记
+    std::thread prefetchThread_;
+    std::atomic<bool> prefetchStop_{false};
 };
 
 }   // namespace client
@@ -149,10 +149,24 @@ class CURVE_CACHELINE_ALIGNMENT RequestClosure
         return suspendRPC_;
     }
 
+    /**
+     * 设置当前这次rpc是否发往follower读
+     */
+    void SetFollowerRead(bool followerRead) {
+        followerRead_ = followerRead;
+    }
+
+    bool IsFollowerRead() const {
+        return followerRead_;
+    }
+
  private:
     // suspend io标志
     bool suspendRPC_ = false;
 
+    // 当前这次rpc是否发往follower
+    bool followerRead_ = false;
+
     // 当前request的错误码
     int errcode_ = -1;
 
@@ -27,6 +27,7 @@
 
 #include <atomic>
 #include <string>
+#include <vector>
 
 #include "src/client/client_common.h"
 #include "src/client/request_closure.h"
@@ -100,6 +101,11 @@ struct CURVE_CACHELINE_ALIGNMENT RequestContext {
     // 这个对应的GetChunkInfo的出参
     ChunkInfoDetail*    chunkinfodetail_ = nullptr;
 
+    // GetChunksInfo查询的chunk，都属于idinfo_所在的copyset
+    std::vector<ChunkID> chunkIds_;
+    // GetChunksInfo的出参，与chunkIds_一一对应
+    std::vector<ChunkInfoDetail>* chunkinfodetails_ = nullptr;
+
     // clone chunk请求需要携带源chunk的location及所需要创建的chunk的大小
     uint32_t            chunksize_ = 0;
     std::string         location_;
@@ -110,6 +116,18 @@ struct CURVE_CACHELINE_ALIGNMENT RequestContext {
     // 当前request context id
     uint64_t            id_ = 0;
 
+    // 当前request是否被采样，被采样的request会记录各阶段的耗时
+    bool                traced_ = false;
+    // 被采样的request进入调度队列的时间
+    uint64_t            scheduleTimeUs_ = 0;
+    // 被采样的request在调度队列中等待的时间
+    uint64_t            scheduleQueueUs_ = 0;
+
+    // 请求所属文件的id及iops和带宽上限，chunkserver据此做卷级流控
+    uint64_t            fileId_ = 0;
+    uint64_t            volumeIopsLimit_ = 0;
+    uint64_t            volumeBpsLimit_ = 0;
+
     static RequestContext* NewInitedRequestContext() {
         RequestContext* ctx = new (std::nothrow) RequestContext();
         if (ctx && ctx->Init()) {
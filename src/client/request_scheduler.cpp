@@ -25,9 +25,14 @@
 #include <brpc/closure_guard.h>
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <map>
+#include <tuple>
+
 #include "src/client/request_context.h"
 #include "src/client/request_closure.h"
 #include "src/client/chunk_closure.h"
+#include "src/common/timeutility.h"
 
 namespace curve {
 namespace client {
@@ -39,6 +44,19 @@ int RequestScheduler::Init(const RequestScheduleOption& reqSchdulerOpt,
                            FileMetric* fm) {
     blockIO_.store(false);
     reqschopt_ = reqSchdulerOpt;
+    sampler_.SetSampleRate(reqschopt_.traceSampleRate);
+
+    // 批量请求中的所有请求在下发前都要拿到inflight token，限制批量大小，
+    // 避免调度线程各自持有一部分token而互相等待
+    uint64_t maxInflight =
+        reqschopt_.ioSenderOpt.inflightOpt.fileMaxInFlightRPCNum;
+    uint64_t maxBatch = maxInflight / std::max(1u,
+                                    reqschopt_.scheduleThreadpoolSize);
+    if (reqschopt_.batchMaxRequests > maxBatch) {
+        LOG(WARNING) << "batchMaxRequests " << reqschopt_.batchMaxRequests
+                     << " is too large, use " << maxBatch;
+        reqschopt_.batchMaxRequests = maxBatch;
+    }
 
     int rc = 0;
     rc = queue_.Init(reqschopt_.scheduleQueueCapacity);
@@ -61,7 +79,13 @@ int RequestScheduler::Init(const RequestScheduleOption& reqSchdulerOpt,
               << "scheduleQueueCapacity = "
               << reqschopt_.scheduleQueueCapacity
               << ", scheduleThreadpoolSize = "
-              << reqschopt_.scheduleThreadpoolSize;
+              << reqschopt_.scheduleThreadpoolSize
+              << ", traceSampleRate = "
+              << reqschopt_.traceSampleRate
+              << ", batchMaxRequests = "
+              << reqschopt_.batchMaxRequests
+              << ", batchMaxRequestSize = "
+              << reqschopt_.batchMaxRequestSize;
     return 0;
 }
 
@@ -91,6 +115,7 @@ int RequestScheduler::ScheduleRequest(
     if (running_.load(std::memory_order_acquire)) {
         /* TODO(wudemiao): 后期考虑 qos */
         for (auto it : requests) {
+            TraceSample(it);
             BBQItem<RequestContext *> req(it);
             queue_.PutBack(req);
         }
@@ -101,6 +126,7 @@ int RequestScheduler::ScheduleRequest(
 
 int RequestScheduler::ScheduleRequest(RequestContext *request) {
     if (running_.load(std::memory_order_acquire)) {
+        TraceSample(request);
         BBQItem<RequestContext *> req(request);
         queue_.PutBack(req);
         return 0;
@@ -140,7 +166,11 @@ void RequestScheduler::Process() {
         BBQItem<RequestContext*> item = queue_.TakeFront();
         if (!item.IsStop()) {
             RequestContext* req = item.Item();
-            ProcessOne(req);
+            if (CanBatch(req)) {
+                ProcessBatch(req);
+            } else {
+                ProcessOne(req);
+            }
         } else {
             /**
              * 一旦遇到stop item，所有线程都可以退出，因为此时
@@ -151,9 +181,77 @@ void RequestScheduler::Process() {
     }
 }
 
+void RequestScheduler::TraceSample(RequestContext* ctx) {
+    if (ctx->optype_ != OpType::READ && ctx->optype_ != OpType::WRITE) {
+        return;
+    }
+    if (sampler_.Sample()) {
+        ctx->traced_ = true;
+        ctx->scheduleTimeUs_ = TimeUtility::GetTimeofDayUs();
+    }
+}
+
+bool RequestScheduler::CanBatch(RequestContext* ctx) const {
+    // 被采样的请求和需要从克隆源读写的请求单独下发
+    return reqschopt_.batchMaxRequests > 1 &&
+           (ctx->optype_ == OpType::READ || ctx->optype_ == OpType::WRITE) &&
+           ctx->rawlength_ <= reqschopt_.batchMaxRequestSize &&
+           !ctx->traced_ &&
+           ctx->sourceInfo_.cloneFileSource.empty() &&
+           client_.IsBatchEnabled();
+}
+
+void RequestScheduler::ProcessBatch(RequestContext* ctx) {
+    using BatchKey = std::tuple<OpType, LogicPoolID, CopysetID>;
+    std::map<BatchKey, std::vector<RequestContext*>> batches;
+    batches[BatchKey(ctx->optype_, ctx->idinfo_.lpid_, ctx->idinfo_.cpid_)]
+        .push_back(ctx);
+
+    // 只取出队列中已有的请求，不等待新的请求
+    BBQItem<RequestContext*> item(nullptr);
+    for (uint32_t count = 1; count < reqschopt_.batchMaxRequests; ++count) {
+        if (!queue_.TryTakeFront(&item)) {
+            break;
+        }
+        if (item.IsStop()) {
+            // 留给Process处理
+            queue_.PutFront(item);
+            break;
+        }
+        RequestContext* req = item.Item();
+        if (!CanBatch(req)) {
+            ProcessOne(req);
+            continue;
+        }
+        batches[BatchKey(req->optype_, req->idinfo_.lpid_, req->idinfo_.cpid_)]
+            .push_back(req);
+    }
+
+    for (auto& batch : batches) {
+        std::vector<RequestContext*>& reqs = batch.second;
+        if (reqs.size() == 1) {
+            ProcessOne(reqs.front());
+            continue;
+        }
+        for (auto req : reqs) {
+            req->done_->GetInflightRPCToken();
+        }
+        if (std::get<0>(batch.first) == OpType::WRITE) {
+            client_.WriteChunks(reqs);
+        } else {
+            client_.ReadChunks(reqs);
+        }
+    }
+}
+
 void RequestScheduler::ProcessOne(RequestContext* ctx) {
     brpc::ClosureGuard guard(ctx->done_);
 
+    if (ctx->traced_) {
+        ctx->scheduleQueueUs_ =
+            TimeUtility::GetTimeofDayUs() - ctx->scheduleTimeUs_;
+    }
+
     switch (ctx->optype_) {
         case OpType::READ:
             ctx->done_->GetInflightRPCToken();
@@ -178,6 +276,10 @@ void RequestScheduler::ProcessOne(RequestContext* ctx) {
         case OpType::GET_CHUNK_INFO:
             client_.GetChunkInfo(ctx->idinfo_, guard.release());
             break;
+        case OpType::GET_CHUNKS_INFO:
+            client_.GetChunksInfo(ctx->idinfo_, ctx->chunkIds_,
+                                  guard.release());
+            break;
         case OpType::CREATE_CLONE:
             client_.CreateCloneChunk(ctx->idinfo_, ctx->location_, ctx->seq_,
                                      ctx->correctedSeq_, ctx->chunksize_,
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "src/common/uncopyable.h"
+#include "src/common/op_trace.h"
 #include "src/client/config_info.h"
 #include "src/common/concurrent/bounded_blocking_queue.h"
 #include "src/common/concurrent/thread_pool.h"
@@ -40,6 +41,7 @@ using curve::common::ThreadPool;
 using curve::common::BoundedBlockingDeque;
 using curve::common::BBQItem;
 using curve::common::Uncopyable;
+using curve::common::OpTraceSampler;
 
 class RequestContext;
 /**
@@ -140,6 +142,23 @@ class RequestScheduler : public Uncopyable {
 
     void ProcessOne(RequestContext* ctx);
 
+    /**
+     * 请求是否可以和同一个copyset上的其他请求合并成一个批量请求
+     */
+    bool CanBatch(RequestContext* ctx) const;
+
+    /**
+     * 从队列中非阻塞地取出更多的请求，和ctx一起按copyset分组下发，
+     * 同一copyset上的多个读或者写请求合并为一个批量请求
+     * @param ctx: 已经从队列中取出的可以合并的请求
+     */
+    void ProcessBatch(RequestContext* ctx);
+
+    /**
+     * 对读写请求采样，被采样的请求记录其进入调度队列的时间
+     */
+    void TraceSample(RequestContext* ctx);
+
     void WaitValidSession() {
         // lease续约失败的时候需要阻塞IO直到续约成功
         if (blockIO_.load(std::memory_order_acquire) && blockingQueue_) {
@@ -174,6 +193,8 @@ class RequestScheduler : public Uncopyable {
     std::condition_variable leaseRefreshcv_;
     // 阻塞队列
     bool blockingQueue_;
+    // 读写请求的采样器
+    OpTraceSampler sampler_;
 };
 
 }   // namespace client
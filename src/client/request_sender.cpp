@@ -35,6 +35,21 @@ namespace client {
 
 using curve::common::TimeUtility;
 
+namespace {
+
+// 文件设置了iops或带宽上限时，在请求中携带卷信息，chunkserver据此做卷级流控
+void SetVolumeThrottleParams(const RequestContext* ctx,
+                             ChunkRequest* request) {
+    if (ctx->volumeIopsLimit_ == 0 && ctx->volumeBpsLimit_ == 0) {
+        return;
+    }
+    request->set_fileid(ctx->fileId_);
+    request->set_volumeiopslimit(ctx->volumeIopsLimit_);
+    request->set_volumebpslimit(ctx->volumeBpsLimit_);
+}
+
+}  // namespace
+
 int RequestSender::Init(const IOSenderOption& ioSenderOpt) {
     if (0 != channel_.Init(serverEndPoint_, NULL)) {
         LOG(ERROR) << "failed to init channel to server, id: " << chunkServerId_
@@ -82,8 +97,16 @@ int RequestSender::ReadChunk(ChunkIDInfo idinfo,
         request.set_clonefileoffset(sourceInfo.cloneFileOffset);
     }
 
+    if (rc->GetReqCtx()->traced_) {
+        request.set_trace(true);
+    }
+    SetVolumeThrottleParams(rc->GetReqCtx(), &request);
+
     if (iosenderopt_.chunkserverEnableAppliedIndexRead && appliedindex > 0) {
         request.set_appliedindex(appliedindex);
+        if (iosenderopt_.chunkserverEnableFollowerRead) {
+            request.set_followerread(true);
+        }
     }
 
     ChunkService_Stub stub(&channel_);
@@ -130,6 +153,11 @@ int RequestSender::WriteChunk(ChunkIDInfo idinfo,
         request.set_clonefileoffset(sourceInfo.cloneFileOffset);
     }
 
+    if (rc->GetReqCtx()->traced_) {
+        request.set_trace(true);
+    }
+    SetVolumeThrottleParams(rc->GetReqCtx(), &request);
+
     cntl->request_attachment().append(data);
     ChunkService_Stub stub(&channel_);
     stub.WriteChunk(cntl, &request, response, doneGuard.release());
@@ -137,10 +165,105 @@ int RequestSender::WriteChunk(ChunkIDInfo idinfo,
     return 0;
 }
 
+int RequestSender::ReadChunks(const std::vector<RequestContext*>& reqs,
+                              BatchChunkClosure *done) {
+    brpc::ClosureGuard doneGuard(done);
+
+    brpc::Controller *cntl = new brpc::Controller();
+    cntl->set_timeout_ms(iosenderopt_.failRequestOpt.chunkserverRPCTimeoutMS);
+    done->SetCntl(cntl);
+    ChunkResponse *response = new ChunkResponse();
+    done->SetResponse(response);
+    done->SetChunkServerID(chunkServerId_);
+    done->SetChunkServerEndPoint(serverEndPoint_);
+
+    const ChunkIDInfo& idinfo = reqs.front()->idinfo_;
+    ChunkRequest request;
+    request.set_optype(
+        curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_READ_BATCH);
+    request.set_logicpoolid(idinfo.lpid_);
+    request.set_copysetid(idinfo.cpid_);
+    request.set_chunkid(0);
+    SetVolumeThrottleParams(reqs.front(), &request);
+
+    // 所有子请求的applied index都有效时才携带，取其中最大的一个
+    uint64_t appliedindex = 0;
+    for (auto ctx : reqs) {
+        if (ctx->appliedindex_ == 0) {
+            appliedindex = 0;
+            break;
+        }
+        appliedindex = std::max(appliedindex, ctx->appliedindex_);
+    }
+    if (iosenderopt_.chunkserverEnableAppliedIndexRead && appliedindex > 0) {
+        request.set_appliedindex(appliedindex);
+    }
+
+    for (auto ctx : reqs) {
+        MetricHelper::IncremRPCRPSCount(ctx->done_->GetMetric(),
+                                        OpType::READ);
+        ChunkRequest* sub = request.add_subrequests();
+        sub->set_optype(curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_READ);
+        sub->set_logicpoolid(ctx->idinfo_.lpid_);
+        sub->set_copysetid(ctx->idinfo_.cpid_);
+        sub->set_chunkid(ctx->idinfo_.cid_);
+        sub->set_offset(ctx->offset_);
+        sub->set_size(ctx->rawlength_);
+    }
+
+    ChunkService_Stub stub(&channel_);
+    stub.ReadChunks(cntl, &request, response, doneGuard.release());
+
+    return 0;
+}
+
+int RequestSender::WriteChunks(const std::vector<RequestContext*>& reqs,
+                               BatchChunkClosure *done) {
+    brpc::ClosureGuard doneGuard(done);
+
+    brpc::Controller *cntl = new brpc::Controller();
+    cntl->set_timeout_ms(iosenderopt_.failRequestOpt.chunkserverRPCTimeoutMS);
+    done->SetCntl(cntl);
+    ChunkResponse *response = new ChunkResponse();
+    done->SetResponse(response);
+    done->SetChunkServerID(chunkServerId_);
+    done->SetChunkServerEndPoint(serverEndPoint_);
+
+    const ChunkIDInfo& idinfo = reqs.front()->idinfo_;
+    ChunkRequest request;
+    request.set_optype(
+        curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH);
+    request.set_logicpoolid(idinfo.lpid_);
+    request.set_copysetid(idinfo.cpid_);
+    request.set_chunkid(0);
+    SetVolumeThrottleParams(reqs.front(), &request);
+
+    // 写数据按子请求的顺序拼接
+    for (auto ctx : reqs) {
+        MetricHelper::IncremRPCRPSCount(ctx->done_->GetMetric(),
+                                        OpType::WRITE);
+        ChunkRequest* sub = request.add_subrequests();
+        sub->set_optype(curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+        sub->set_logicpoolid(ctx->idinfo_.lpid_);
+        sub->set_copysetid(ctx->idinfo_.cpid_);
+        sub->set_chunkid(ctx->idinfo_.cid_);
+        sub->set_sn(ctx->seq_);
+        sub->set_offset(ctx->offset_);
+        sub->set_size(ctx->rawlength_);
+        cntl->request_attachment().append(ctx->writeData_);
+    }
+
+    ChunkService_Stub stub(&channel_);
+    stub.WriteChunks(cntl, &request, response, doneGuard.release());
+
+    return 0;
+}
+
 int RequestSender::ReadChunkSnapshot(ChunkIDInfo idinfo,
                                      uint64_t sn,
                                      off_t offset,
                                      size_t length,
+                                     uint64_t appliedindex,
                                      ClientClosure *done) {
     brpc::ClosureGuard doneGuard(done);
 
@@ -152,6 +275,8 @@ int RequestSender::ReadChunkSnapshot(ChunkIDInfo idinfo,
     done->SetCntl(cntl);
     ChunkResponse *response = new ChunkResponse();
     done->SetResponse(response);
+    done->SetChunkServerID(chunkServerId_);
+    done->SetChunkServerEndPoint(serverEndPoint_);
 
     ChunkRequest request;
     request.set_optype(curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_READ_SNAP);
@@ -161,6 +286,13 @@ int RequestSender::ReadChunkSnapshot(ChunkIDInfo idinfo,
     request.set_sn(sn);
     request.set_offset(offset);
     request.set_size(length);
+
+    // 允许follower读取，follower向leader获取read index判断是否可读
+    if (iosenderopt_.chunkserverEnableFollowerRead && appliedindex > 0) {
+        request.set_appliedindex(appliedindex);
+        request.set_followerread(true);
+    }
+
     ChunkService_Stub stub(&channel_);
     stub.ReadChunkSnapshot(cntl, &request, response, doneGuard.release());
 
@@ -217,6 +349,31 @@ int RequestSender::GetChunkInfo(ChunkIDInfo idinfo,
     return 0;
 }
 
+int RequestSender::GetChunksInfo(ChunkIDInfo idinfo,
+                                 const std::vector<ChunkID> &chunkIds,
+                                 ClientClosure *done) {
+    brpc::ClosureGuard doneGuard(done);
+
+    RequestClosure* rc = static_cast<RequestClosure*>(done->GetClosure());
+    brpc::Controller *cntl = new brpc::Controller();
+    cntl->set_timeout_ms(
+        std::max(rc->GetNextTimeoutMS(),
+                 iosenderopt_.failRequestOpt.chunkserverRPCTimeoutMS));
+    done->SetCntl(cntl);
+    GetChunksInfoResponse *response = new GetChunksInfoResponse();
+    done->SetResponse(response);
+
+    GetChunksInfoRequest request;
+    request.set_logicpoolid(idinfo.lpid_);
+    request.set_copysetid(idinfo.cpid_);
+    for (ChunkID chunkId : chunkIds) {
+        request.add_chunkids(chunkId);
+    }
+    ChunkService_Stub stub(&channel_);
+    stub.GetChunksInfo(cntl, &request, response, doneGuard.release());
+    return 0;
+}
+
 int RequestSender::CreateCloneChunk(ChunkIDInfo idinfo,
                                 ClientClosure *done,
                                 const std::string &location,
@@ -28,6 +28,7 @@
 #include <butil/iobuf.h>
 
 #include <string>
+#include <vector>
 
 #include "src/client/client_config.h"
 #include "src/client/client_common.h"
@@ -42,6 +43,8 @@ using curve::chunkserver::ChunkRequest;
 using curve::chunkserver::ChunkResponse;
 using curve::chunkserver::GetChunkInfoRequest;
 using curve::chunkserver::GetChunkInfoResponse;
+using curve::chunkserver::GetChunksInfoRequest;
+using curve::chunkserver::GetChunksInfoResponse;
 using curve::chunkserver::ChunkService_Stub;
 using ::google::protobuf::Closure;
 
@@ -96,18 +99,30 @@ class RequestSender {
                    const RequestSourceInfo& sourceInfo,
                    ClientClosure *done);
 
+    /**
+     * 批量读写同一个copyset上的多个chunk
+     * @param reqs:属于同一个copyset的读请求或者写请求
+     * @param done:批量请求的closure
+     */
+    int ReadChunks(const std::vector<RequestContext*>& reqs,
+                   BatchChunkClosure *done);
+    int WriteChunks(const std::vector<RequestContext*>& reqs,
+                    BatchChunkClosure *done);
+
     /**
      * 读Chunk快照文件
      * @param idinfo为chunk相关的id信息
      * @param sn:文件版本号
      * @param offset:读的偏移
      * @param length:读的长度
+     * @param appliedindex:需要读到>=appliedIndex的数据，follower读时使用
      * @param done:上一层异步回调的closure
      */
     int ReadChunkSnapshot(ChunkIDInfo idinfo,
                           uint64_t sn,
                           off_t offset,
                           size_t length,
+                          uint64_t appliedindex,
                           ClientClosure *done);
 
     /**
@@ -130,6 +145,16 @@ class RequestSender {
     int GetChunkInfo(ChunkIDInfo idinfo,
                      ClientClosure *done);
 
+    /**
+     * 批量获取同一个copyset中多个chunk文件的信息
+     * @param idinfo为copyset相关的id信息
+     * @param chunkIds:需要查询的chunk
+     * @param done:上一层异步回调的closure
+     */
+    int GetChunksInfo(ChunkIDInfo idinfo,
+                      const std::vector<ChunkID> &chunkIds,
+                      ClientClosure *done);
+
     /**
     * @brief lazy 创建clone chunk
     * @detail
@@ -78,6 +78,12 @@ void ServiceHelper::ProtoFileInfo2Local(const curve::mds::FileInfo* finfo,
     if (finfo->has_clonelength()) {
         fi->cloneLength = finfo->clonelength();
     }
+    if (finfo->has_iopslimit()) {
+        fi->iopsLimit = finfo->iopslimit();
+    }
+    if (finfo->has_bpslimit()) {
+        fi->bpsLimit = finfo->bpslimit();
+    }
 }
 
 class GetLeaderProxy : public std::enable_shared_from_this<GetLeaderProxy> {
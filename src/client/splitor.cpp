@@ -123,6 +123,7 @@ int Splitor::SingleChunkIO2ChunkRequests(
     }
 
     const auto maxSplitSizeBytes = 1024 * iosplitopt_.fileIOSplitMaxSizeKB;
+    const FInfo* fileInfo = metaCache->GetFileInfo();
 
     uint64_t dataOffset = 0;
     uint64_t currentOffset = offset;
@@ -149,6 +150,9 @@ int Splitor::SingleChunkIO2ChunkRequests(
         newreqNode->rawlength_   = requestLength;
         newreqNode->optype_      = iotracker->Optype();
         newreqNode->idinfo_      = idinfo;
+        newreqNode->fileId_      = fileInfo->id;
+        newreqNode->volumeIopsLimit_ = fileInfo->iopsLimit;
+        newreqNode->volumeBpsLimit_  = fileInfo->bpsLimit;
         newreqNode->done_->SetIOTracker(iotracker);
         targetlist->push_back(newreqNode);
 
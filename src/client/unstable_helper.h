@@ -65,6 +65,15 @@ class UnstableHelper {
         ++timeoutTimes_[csId];
     }
 
+    /**
+     * @brief 获取chunkserver连续超时请求的次数，follower读时用于选择副本
+     */
+    uint32_t GetTimeoutTimes(ChunkServerID csId) {
+        std::unique_lock<decltype(mtx_)> guard(mtx_);
+        auto iter = timeoutTimes_.find(csId);
+        return iter == timeoutTimes_.end() ? 0 : iter->second;
+    }
+
     UnstableState GetCurrentUnstableState(ChunkServerID csId,
                                           const butil::EndPoint& csEndPoint);
 
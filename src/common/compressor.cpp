@@ -0,0 +1,210 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include "src/common/compressor.h"
+
+#include <glog/logging.h>
+#include <zlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace curve {
+namespace common {
+
+bool StringToCompressType(const std::string &str, CompressType *type) {
+    if (str == "none") {
+        *type = CompressType::kNone;
+    } else if (str == "zlib") {
+        *type = CompressType::kZlib;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string CompressTypeToString(CompressType type) {
+    switch (type) {
+        case CompressType::kNone:
+            return "none";
+        case CompressType::kZlib:
+            return "zlib";
+        default:
+            return "unknown";
+    }
+}
+
+ZlibCompressor::ZlibCompressor(int level)
+    : level_(level) {
+    if (level_ < Z_BEST_SPEED || level_ > Z_BEST_COMPRESSION) {
+        LOG(WARNING) << "Invalid zlib level " << level_
+                     << ", use " << Z_BEST_SPEED;
+        level_ = Z_BEST_SPEED;
+    }
+}
+
+bool ZlibCompressor::Compress(const char *in, size_t len, std::string *out) {
+    uLongf outLen = compressBound(len);
+    out->resize(outLen);
+    int ret = compress2(reinterpret_cast<Bytef *>(&(*out)[0]), &outLen,
+                        reinterpret_cast<const Bytef *>(in), len, level_);
+    if (ret != Z_OK) {
+        LOG(ERROR) << "zlib compress failed, ret = " << ret
+                   << ", len = " << len;
+        return false;
+    }
+    if (outLen >= len) {
+        return false;
+    }
+    out->resize(outLen);
+    return true;
+}
+
+bool ZlibCompressor::Decompress(const char *in, size_t len,
+                                char *out, size_t outLen) {
+    uLongf destLen = outLen;
+    int ret = uncompress(reinterpret_cast<Bytef *>(out), &destLen,
+                         reinterpret_cast<const Bytef *>(in), len);
+    if (ret != Z_OK || destLen != outLen) {
+        LOG(ERROR) << "zlib uncompress failed, ret = " << ret
+                   << ", len = " << len
+                   << ", expect = " << outLen
+                   << ", actual = " << destLen;
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<Compressor> NewCompressor(CompressType type, int level) {
+    switch (type) {
+        case CompressType::kZlib:
+            return std::make_shared<ZlibCompressor>(level);
+        default:
+            return nullptr;
+    }
+}
+
+void CompressedBlockIndex::SetBlockLen(uint32_t index, uint64_t storedLen) {
+    if (index >= blockLens_.size()) {
+        blockLens_.resize(index + 1, 0);
+    }
+    blockLens_[index] = storedLen;
+}
+
+uint64_t CompressedBlockIndex::GetBlockOffset(uint32_t index) const {
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < index && i < blockLens_.size(); ++i) {
+        offset += blockLens_[i];
+    }
+    return offset;
+}
+
+std::string CompressedBlockIndex::Serialize() const {
+    std::ostringstream out;
+    out << CompressTypeToString(type_) << " " << blockSize_ << "\n";
+    for (auto len : blockLens_) {
+        out << len << "\n";
+    }
+    return out.str();
+}
+
+bool CompressedBlockIndex::Parse(const std::string &data) {
+    std::istringstream in(data);
+    std::string typeStr;
+    uint64_t blockSize = 0;
+    if (!(in >> typeStr >> blockSize) ||
+        !StringToCompressType(typeStr, &type_) ||
+        blockSize == 0) {
+        return false;
+    }
+    blockSize_ = blockSize;
+    blockLens_.clear();
+    uint64_t len;
+    while (in >> len) {
+        if (len == 0 || len > blockSize_) {
+            return false;
+        }
+        blockLens_.push_back(len);
+    }
+    return in.eof();
+}
+
+bool CompressedBlockIndex::GetStoredRange(uint64_t offset, uint64_t len,
+    uint64_t *storedOffset, uint64_t *storedLen) const {
+    if (len == 0 ||
+        offset + len > blockSize_ * blockLens_.size()) {
+        return false;
+    }
+    uint32_t first = offset / blockSize_;
+    uint32_t last = (offset + len - 1) / blockSize_;
+    *storedOffset = GetBlockOffset(first);
+    *storedLen = 0;
+    for (uint32_t i = first; i <= last; ++i) {
+        *storedLen += blockLens_[i];
+    }
+    return true;
+}
+
+bool CompressedBlockIndex::ReadRange(Compressor *compressor,
+    const char *stored, uint64_t offset, uint64_t len, char *buf) const {
+    uint32_t first = offset / blockSize_;
+    uint32_t last = (offset + len - 1) / blockSize_;
+    std::unique_ptr<char[]> block;
+    uint64_t end = offset + len;
+    for (uint32_t i = first; i <= last; ++i) {
+        uint64_t blockStart = i * blockSize_;
+        uint64_t from = std::max(offset, blockStart);
+        uint64_t to = std::min(end, blockStart + blockSize_);
+        char *dst = buf + (from - offset);
+        if (blockLens_[i] == blockSize_) {
+            // 未压缩的块
+            memcpy(dst, stored + (from - blockStart), to - from);
+        } else if (compressor == nullptr ||
+                   compressor->GetType() != type_) {
+            LOG(ERROR) << "Compressor mismatch, expect "
+                       << CompressTypeToString(type_);
+            return false;
+        } else if (to - from == blockSize_) {
+            // 整块都需要，直接解压到目标缓冲区
+            if (!compressor->Decompress(stored, blockLens_[i],
+                                        dst, blockSize_)) {
+                return false;
+            }
+        } else {
+            if (block == nullptr) {
+                block.reset(new char[blockSize_]);
+            }
+            if (!compressor->Decompress(stored, blockLens_[i],
+                                        block.get(), blockSize_)) {
+                return false;
+            }
+            memcpy(dst, block.get() + (from - blockStart), to - from);
+        }
+        stored += blockLens_[i];
+    }
+    return true;
+}
+
+}  // namespace common
+}  // namespace curve
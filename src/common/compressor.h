@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#ifndef SRC_COMMON_COMPRESSOR_H_
+#define SRC_COMMON_COMPRESSOR_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace curve {
+namespace common {
+
+// 分块压缩对象的块索引保存在对象名加该后缀的对象中，
+// 没有块索引的对象是未压缩的
+const char kCompressIndexSuffix[] = ".cidx";
+// 分块压缩的对象在对象存储的用户元数据中记录压缩算法，
+// 读取时根据该元数据判断是否需要获取块索引
+const char kCompressMetaKey[] = "curve-compress";
+
+enum class CompressType {
+    kNone = 0,
+    kZlib = 1,
+};
+
+/**
+ * 配置中的压缩算法名称与CompressType的转换，目前支持"none"和"zlib"
+ * @return 名称不合法时返回false
+ */
+bool StringToCompressType(const std::string &str, CompressType *type);
+std::string CompressTypeToString(CompressType type);
+
+/**
+ * 压缩算法接口，实现必须是无状态的，可以被多个线程同时使用
+ */
+class Compressor {
+ public:
+    virtual ~Compressor() = default;
+
+    virtual CompressType GetType() const = 0;
+
+    /**
+     * 压缩一段数据
+     * @param in: 原始数据
+     * @param len: 原始数据长度
+     * @param[out] out: 压缩后的数据
+     * @return: 压缩失败或压缩后不比原始数据小时返回false，
+     *          此时调用方应保存原始数据
+     */
+    virtual bool Compress(const char *in, size_t len, std::string *out) = 0;
+
+    /**
+     * 解压一段数据
+     * @param in: 压缩数据
+     * @param len: 压缩数据长度
+     * @param[out] out: 存放解压数据的缓冲区
+     * @param outLen: 解压后数据的长度，与实际长度不一致视为失败
+     * @return: 成功返回true
+     */
+    virtual bool Decompress(const char *in, size_t len,
+                            char *out, size_t outLen) = 0;
+};
+
+class ZlibCompressor : public Compressor {
+ public:
+    /**
+     * @param level: zlib压缩级别，1~9，越大压缩率越高、速度越慢
+     */
+    explicit ZlibCompressor(int level);
+
+    CompressType GetType() const override {
+        return CompressType::kZlib;
+    }
+
+    bool Compress(const char *in, size_t len, std::string *out) override;
+
+    bool Decompress(const char *in, size_t len,
+                    char *out, size_t outLen) override;
+
+ private:
+    int level_;
+};
+
+/**
+ * 根据压缩算法创建Compressor，kNone返回nullptr
+ */
+std::shared_ptr<Compressor> NewCompressor(CompressType type, int level);
+
+/**
+ * 分块压缩对象的块索引
+ * 对象按blockSize大小的原始数据分块，各块独立压缩后依次存放，
+ * 压缩后不比原始数据小的块直接存放原始数据(存储长度等于blockSize)。
+ * 根据索引可以只读取并解压覆盖某个范围的块，从而支持对象的范围读
+ */
+class CompressedBlockIndex {
+ public:
+    CompressedBlockIndex()
+        : type_(CompressType::kNone),
+          blockSize_(0) {}
+
+    CompressedBlockIndex(CompressType type, uint64_t blockSize)
+        : type_(type),
+          blockSize_(blockSize) {}
+
+    CompressType GetType() const {
+        return type_;
+    }
+
+    uint64_t GetBlockSize() const {
+        return blockSize_;
+    }
+
+    uint32_t GetBlockNum() const {
+        return blockLens_.size();
+    }
+
+    /**
+     * 设置第index个块在对象中的存储长度
+     */
+    void SetBlockLen(uint32_t index, uint64_t storedLen);
+
+    uint64_t GetBlockLen(uint32_t index) const {
+        return blockLens_[index];
+    }
+
+    /**
+     * 第index个块在对象中的起始偏移
+     */
+    uint64_t GetBlockOffset(uint32_t index) const;
+
+    /**
+     * 序列化格式：第一行为"压缩算法 块大小"，之后每行依次为各块的存储长度
+     */
+    std::string Serialize() const;
+    bool Parse(const std::string &data);
+
+    /**
+     * 计算原始数据[offset, offset + len)所在的块在对象中的存储范围
+     * @return: 范围超出对象时返回false
+     */
+    bool GetStoredRange(uint64_t offset, uint64_t len,
+                        uint64_t *storedOffset, uint64_t *storedLen) const;
+
+    /**
+     * 解压GetStoredRange读到的数据，并将原始数据[offset, offset + len)
+     * 拷贝到buf中
+     * @param compressor: 与索引的压缩算法一致的Compressor
+     * @param stored: 从对象中读到的存储数据
+     * @return: 成功返回true
+     */
+    bool ReadRange(Compressor *compressor, const char *stored,
+                   uint64_t offset, uint64_t len, char *buf) const;
+
+ private:
+    CompressType type_;
+    uint64_t blockSize_;
+    // 各块在对象中的存储长度
+    std::vector<uint64_t> blockLens_;
+};
+
+}  // namespace common
+}  // namespace curve
+
+#endif  // SRC_COMMON_COMPRESSOR_H_
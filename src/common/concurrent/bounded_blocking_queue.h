@@ -131,6 +131,22 @@ class BoundedBlockingDeque : public Uncopyable {
         return back;
     }
 
+    /**
+     * 非阻塞地取出队首元素
+     * @param x: 出参，取出的元素
+     * @return 队列为空时返回false
+     */
+    bool TryTakeFront(T *x) {
+        std::unique_lock<std::mutex> guard(mutex_);
+        if (deque_.empty()) {
+            return false;
+        }
+        *x = std::move(deque_.front());
+        deque_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+
     bool Empty() const {
         std::lock_guard<std::mutex> guard(mutex_);
         return deque_.empty();
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include "src/common/concurrent/range_lock.h"
+
+namespace curve {
+namespace common {
+
+void RangeLock::Lock(uint64_t begin, uint64_t end, bool exclusive) {
+    UniqueLock lk(mtx_);
+    if (IsConflict(begin, end, exclusive)) {
+        Waiter waiter;
+        waiter.begin = begin;
+        waiter.end = end;
+        auto it = waiters_.insert(waiters_.end(), &waiter);
+        waiter.cond.wait(lk, [&]() {
+            return !IsConflict(begin, end, exclusive);
+        });
+        waiters_.erase(it);
+    }
+    ranges_.push_back(Range{begin, end, exclusive});
+}
+
+bool RangeLock::TryLock(uint64_t begin, uint64_t end, bool exclusive) {
+    LockGuard lk(mtx_);
+    if (IsConflict(begin, end, exclusive)) {
+        return false;
+    }
+    ranges_.push_back(Range{begin, end, exclusive});
+    return true;
+}
+
+void RangeLock::Unlock(uint64_t begin, uint64_t end, bool exclusive) {
+    LockGuard lk(mtx_);
+    for (auto it = ranges_.begin(); it != ranges_.end(); ++it) {
+        if (it->begin == begin && it->end == end
+            && it->exclusive == exclusive) {
+            ranges_.erase(it);
+            break;
+        }
+    }
+    // 只有与释放区间重叠的等待者才可能因此加锁成功
+    for (Waiter *waiter : waiters_) {
+        if (waiter->begin <= end && waiter->end >= begin) {
+            waiter->cond.notify_one();
+        }
+    }
+}
+
+bool RangeLock::IsConflict(uint64_t begin,
+                           uint64_t end,
+                           bool exclusive) const {
+    for (const auto& range : ranges_) {
+        if (range.begin > end || range.end < begin) {
+            continue;
+        }
+        if (exclusive || range.exclusive) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}   // namespace common
+}   // namespace curve
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#ifndef SRC_COMMON_CONCURRENT_RANGE_LOCK_H_
+#define SRC_COMMON_CONCURRENT_RANGE_LOCK_H_
+
+#include <list>
+
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/uncopyable.h"
+
+namespace curve {
+namespace common {
+
+/**
+ * 区间锁，对[begin, end]闭区间加锁
+ * 不重叠的区间之间互不影响；重叠的区间中只要有一方是互斥锁就需要等待
+ * 持有的区间数量一般不超过并发度，因此用链表线性查找即可
+ */
+class RangeLock : public Uncopyable {
+ public:
+    RangeLock() {}
+
+    /**
+     * @brief 对指定区间加锁，与已持有的区间冲突时阻塞等待
+     *
+     * @param begin 区间起始位置
+     * @param end 区间结束位置(包含)
+     * @param exclusive true为互斥锁，false为共享锁
+     */
+    void Lock(uint64_t begin, uint64_t end, bool exclusive);
+
+    /**
+     * @brief 尝试对指定区间加锁
+     *
+     * @retval true 成功
+     * @retval false 与已持有的区间冲突
+     */
+    bool TryLock(uint64_t begin, uint64_t end, bool exclusive);
+
+    /**
+     * @brief 释放指定区间的锁，参数需要与加锁时一致
+     */
+    void Unlock(uint64_t begin, uint64_t end, bool exclusive);
+
+ private:
+    struct Range {
+        uint64_t begin;
+        uint64_t end;
+        bool exclusive;
+    };
+
+    // 等待加锁的区间，每个等待者有自己的条件变量，
+    // 释放区间时只唤醒与之重叠的等待者
+    struct Waiter {
+        uint64_t begin;
+        uint64_t end;
+        ConditionVariable cond;
+    };
+
+    bool IsConflict(uint64_t begin, uint64_t end, bool exclusive) const;
+
+ private:
+    Mutex mtx_;
+    // 当前已持有的区间
+    std::list<Range> ranges_;
+    // 当前等待加锁的区间
+    std::list<Waiter*> waiters_;
+};
+
+class RangeLockGuard : public Uncopyable {
+ public:
+    RangeLockGuard(RangeLock *lock,
+                   uint64_t begin,
+                   uint64_t end,
+                   bool exclusive) :
+        lock_(lock),
+        begin_(begin),
+        end_(end),
+        exclusive_(exclusive) {
+        lock_->Lock(begin_, end_, exclusive_);
+    }
+
+    ~RangeLockGuard() {
+        lock_->Unlock(begin_, end_, exclusive_);
+    }
+
+ private:
+    RangeLock *lock_;
+    uint64_t begin_;
+    uint64_t end_;
+    bool exclusive_;
+};
+
+}   // namespace common
+}   // namespace curve
+
+#endif  // SRC_COMMON_CONCURRENT_RANGE_LOCK_H_
@@ -42,17 +42,23 @@ class TaskQueue {
 
     template<class F, class... Args>
     void Push(F&& f, Args&&... args) {
-        auto task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+        Push(Task(std::bind(std::forward<F>(f), std::forward<Args>(args)...)));
+    };                                                                                          // NOLINT
+
+    // 不带参数的任务直接放入队列，不再经过一层std::bind，也不拷贝任务
+    template<class F>
+    void Push(F&& f) {
+        Task task(std::forward<F>(f));
         std::unique_lock<std::mutex> lk(mtx_);
         notfullcv_.wait(lk, [this]()->bool{return this->tasks_.size() < this->capacity_;});     // NOLINT
-        tasks_.push(task);
+        tasks_.push(std::move(task));
         notemptycv_.notify_one();
     };                                                                                          // NOLINT
 
     Task Pop() {
         std::unique_lock<std::mutex> lk(mtx_);
         notemptycv_.wait(lk, [this]()->bool{return this->tasks_.size() > 0;});                  // NOLINT
-        Task t = tasks_.front();
+        Task t = std::move(tasks_.front());
         tasks_.pop();
         notfullcv_.notify_one();
         return t;
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#include <nmmintrin.h>
+#include <butil/crc32c.h>
+
+#include "src/common/crc32.h"
+
+namespace curve {
+namespace common {
+
+namespace {
+
+// CRC32C多项式(反射形式)
+const uint32_t kCRC32CPoly = 0x82f63b78;
+// 交错计算时每一路的长度，长数据用kLongBlock，剩下的用kShortBlock
+const size_t kLongBlock = 2048;
+const size_t kShortBlock = 256;
+
+// GF(2)上32x32矩阵乘以向量
+uint32_t GF2MatrixTimes(const uint32_t *mat, uint32_t vec) {
+    uint32_t sum = 0;
+    while (vec) {
+        if (vec & 1) {
+            sum ^= *mat;
+        }
+        vec >>= 1;
+        mat++;
+    }
+    return sum;
+}
+
+void GF2MatrixSquare(uint32_t *square, const uint32_t *mat) {
+    for (int n = 0; n < 32; n++) {
+        square[n] = GF2MatrixTimes(mat, mat[n]);
+    }
+}
+
+// 构造在crc后面追加len个字节0的运算矩阵
+void ZerosOperator(uint32_t *even, size_t len) {
+    uint32_t odd[32];
+    // 追加1个bit 0的运算
+    odd[0] = kCRC32CPoly;
+    uint32_t row = 1;
+    for (int n = 1; n < 32; n++) {
+        odd[n] = row;
+        row <<= 1;
+    }
+    // 2个bit
+    GF2MatrixSquare(even, odd);
+    // 4个bit
+    GF2MatrixSquare(odd, even);
+    // 每次平方后长度翻倍，第一次平方后是1个字节
+    do {
+        GF2MatrixSquare(even, odd);
+        len >>= 1;
+        if (len == 0) {
+            return;
+        }
+        GF2MatrixSquare(odd, even);
+        len >>= 1;
+    } while (len);
+    for (int n = 0; n < 32; n++) {
+        even[n] = odd[n];
+    }
+}
+
+// 把追加len个字节0的运算展开成按字节查的表
+struct ShiftTable {
+    explicit ShiftTable(size_t len) {
+        uint32_t op[32];
+        ZerosOperator(op, len);
+        for (uint32_t n = 0; n < 256; n++) {
+            table[0][n] = GF2MatrixTimes(op, n);
+            table[1][n] = GF2MatrixTimes(op, n << 8);
+            table[2][n] = GF2MatrixTimes(op, n << 16);
+            table[3][n] = GF2MatrixTimes(op, n << 24);
+        }
+    }
+
+    uint32_t Shift(uint32_t crc) const {
+        return table[0][crc & 0xff] ^ table[1][(crc >> 8) & 0xff] ^
+               table[2][(crc >> 16) & 0xff] ^ table[3][crc >> 24];
+    }
+
+    uint32_t table[4][256];
+};
+
+// 3路交错计算blockSize*3的数据，再把3路的crc合并起来
+inline uint32_t CRC32C3Way(uint64_t crc0, const char **next, size_t *len,
+                           size_t blockSize, const ShiftTable &shift) {
+    while (*len >= blockSize * 3) {
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        const char *p = *next;
+        const char *end = p + blockSize;
+        do {
+            crc0 = _mm_crc32_u64(crc0,
+                    *reinterpret_cast<const uint64_t *>(p));
+            crc1 = _mm_crc32_u64(crc1,
+                    *reinterpret_cast<const uint64_t *>(p + blockSize));
+            crc2 = _mm_crc32_u64(crc2,
+                    *reinterpret_cast<const uint64_t *>(p + blockSize * 2));
+            p += 8;
+        } while (p < end);
+        crc0 = shift.Shift(static_cast<uint32_t>(crc0)) ^ crc1;
+        crc0 = shift.Shift(static_cast<uint32_t>(crc0)) ^ crc2;
+        *next += blockSize * 3;
+        *len -= blockSize * 3;
+    }
+    return static_cast<uint32_t>(crc0);
+}
+
+uint32_t CRC32CHardware(uint32_t crc, const char *data, size_t len) {
+    static const ShiftTable longShift(kLongBlock);
+    static const ShiftTable shortShift(kShortBlock);
+
+    uint64_t crc0 = crc ^ 0xffffffff;
+    const char *next = data;
+    // 先按8字节对齐
+    while (len && (reinterpret_cast<uintptr_t>(next) & 7) != 0) {
+        crc0 = _mm_crc32_u8(static_cast<uint32_t>(crc0), *next);
+        next++;
+        len--;
+    }
+    crc0 = CRC32C3Way(crc0, &next, &len, kLongBlock, longShift);
+    crc0 = CRC32C3Way(crc0, &next, &len, kShortBlock, shortShift);
+    while (len >= 8) {
+        crc0 = _mm_crc32_u64(crc0, *reinterpret_cast<const uint64_t *>(next));
+        next += 8;
+        len -= 8;
+    }
+    while (len) {
+        crc0 = _mm_crc32_u8(static_cast<uint32_t>(crc0), *next);
+        next++;
+        len--;
+    }
+    return static_cast<uint32_t>(crc0) ^ 0xffffffff;
+}
+
+bool IsSSE42Supported() {
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+}
+
+}  // namespace
+
+uint32_t CRC32CExtend(uint32_t crc, const char *pData, size_t iLen) {
+    if (IsSSE42Supported()) {
+        return CRC32CHardware(crc, pData, iLen);
+    }
+    return butil::crc32c::Extend(crc, pData, iLen);
+}
+
+}  // namespace common
+}  // namespace curve
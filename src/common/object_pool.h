@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#ifndef SRC_COMMON_OBJECT_POOL_H_
+#define SRC_COMMON_OBJECT_POOL_H_
+
+#include <butil/object_pool.h>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace curve {
+namespace common {
+
+// 对象池中的一块内存，大小和对齐方式与要分配的类型一致
+template <size_t Size, size_t Align>
+struct PoolBlock {
+    typename std::aligned_storage<Size, Align>::type data;
+};
+
+/**
+ * 从butil::ObjectPool分配内存的分配器，可用于std::allocate_shared。
+ * ObjectPool按线程缓存空闲的内存块，一个线程上释放的块攒满一批后交还给
+ * 全局，可以被其他线程复用，适合在rpc线程上分配、在apply线程上释放的对象。
+ * 池中的内存不会还给系统，只有单个对象的分配走对象池
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind {
+        typedef PoolAllocator<U> other;
+    };
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}  // NOLINT
+
+    T* allocate(size_t n) {
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        Block* block = butil::get_object<Block>();
+        if (block == nullptr) {
+            throw std::bad_alloc();
+        }
+        return reinterpret_cast<T*>(block);
+    }
+
+    void deallocate(T* p, size_t n) {
+        if (n != 1) {
+            ::operator delete(p);
+            return;
+        }
+        butil::return_object(reinterpret_cast<Block*>(p));
+    }
+
+ private:
+    typedef PoolBlock<sizeof(T), alignof(T)> Block;
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return false;
+}
+
+/**
+ * 和std::make_shared一样把对象和引用计数放在同一块内存中，内存从对象池分配
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> MakePooledShared(Args&&... args) {
+    return std::allocate_shared<T>(PoolAllocator<T>(),
+                                   std::forward<Args>(args)...);
+}
+
+/**
+ * 按类型T的大小从对象池分配内存，用于实现类的operator new/delete，
+ * 大小和T不一致(例如子类)时按普通方式分配
+ */
+template <typename T>
+void* PoolNew(size_t size) {
+    if (size != sizeof(T)) {
+        return ::operator new(size);
+    }
+    return PoolAllocator<T>().allocate(1);
+}
+
+template <typename T>
+void* PoolNew(size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return PoolNew<T>(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+template <typename T>
+void PoolDelete(void* p, size_t size) {
+    if (p == nullptr) {
+        return;
+    }
+    if (size != sizeof(T)) {
+        ::operator delete(p);
+        return;
+    }
+    PoolAllocator<T>().deallocate(static_cast<T*>(p), 1);
+}
+
+}  // namespace common
+}  // namespace curve
+
+#endif  // SRC_COMMON_OBJECT_POOL_H_
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include "src/common/op_trace.h"
+
+#include <algorithm>
+#include <ctime>
+#include <sstream>
+
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace common {
+
+SlowOpTracker::SlowOpTracker(const std::string& prefix,
+                             const std::string& name,
+                             uint32_t capacity,
+                             uint32_t windowS)
+    : capacity_(capacity),
+      windowUs_(windowS * 1000000ul) {
+    ops_.reserve(capacity_);
+    status_.reset(new bvar::PassiveStatus<std::string>(
+        prefix, name, DumpSlowOps, this));
+}
+
+void SlowOpTracker::Expire(uint64_t nowUs) {
+    auto it = std::remove_if(ops_.begin(), ops_.end(),
+        [this, nowUs](const SlowOp& op) {
+            return op.timeUs + windowUs_ < nowUs;
+        });
+    ops_.erase(it, ops_.end());
+}
+
+bool SlowOpTracker::Accept(uint64_t latencyUs) {
+    if (capacity_ == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lk(mtx_);
+    Expire(TimeUtility::GetTimeofDayUs());
+    if (ops_.size() < capacity_) {
+        return true;
+    }
+    for (const auto& op : ops_) {
+        if (op.latencyUs < latencyUs) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SlowOpTracker::Add(uint64_t latencyUs, const std::string& desc) {
+    if (capacity_ == 0) {
+        return;
+    }
+    uint64_t nowUs = TimeUtility::GetTimeofDayUs();
+    std::lock_guard<std::mutex> lk(mtx_);
+    Expire(nowUs);
+    if (ops_.size() < capacity_) {
+        ops_.push_back(SlowOp{nowUs, latencyUs, desc});
+        return;
+    }
+    auto fastest = std::min_element(ops_.begin(), ops_.end(),
+        [](const SlowOp& a, const SlowOp& b) {
+            return a.latencyUs < b.latencyUs;
+        });
+    if (fastest->latencyUs < latencyUs) {
+        *fastest = SlowOp{nowUs, latencyUs, desc};
+    }
+}
+
+std::vector<SlowOp> SlowOpTracker::GetSlowOps() {
+    std::vector<SlowOp> ops;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        Expire(TimeUtility::GetTimeofDayUs());
+        ops = ops_;
+    }
+    std::sort(ops.begin(), ops.end(), [](const SlowOp& a, const SlowOp& b) {
+        return a.latencyUs > b.latencyUs;
+    });
+    return ops;
+}
+
+std::string SlowOpTracker::Dump() {
+    std::ostringstream oss;
+    for (const auto& op : GetSlowOps()) {
+        oss << "latency=" << op.latencyUs << "us time="
+            << TimeUtility::TimeStampToStandard(op.timeUs / 1000000)
+            << " " << op.desc << "\n";
+    }
+    return oss.str();
+}
+
+void SlowOpTracker::DumpSlowOps(std::ostream& os, void* arg) {
+    os << static_cast<SlowOpTracker*>(arg)->Dump();
+}
+
+}  // namespace common
+}  // namespace curve
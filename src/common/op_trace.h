@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#ifndef SRC_COMMON_OP_TRACE_H_
+#define SRC_COMMON_OP_TRACE_H_
+
+#include <bvar/bvar.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+namespace curve {
+namespace common {
+
+// 请求采样器，每sampleRate个请求采样一个，sampleRate为0时关闭采样
+// 关闭时Sample只有一次分支判断，不会引入额外的开销
+class OpTraceSampler {
+ public:
+    explicit OpTraceSampler(uint32_t sampleRate = 0)
+        : sampleRate_(sampleRate), count_(0) {}
+
+    void SetSampleRate(uint32_t sampleRate) {
+        sampleRate_ = sampleRate;
+    }
+
+    bool Sample() {
+        if (sampleRate_ == 0) {
+            return false;
+        }
+        return count_.fetch_add(1, std::memory_order_relaxed)
+            % sampleRate_ == 0;
+    }
+
+ private:
+    uint32_t sampleRate_;
+    std::atomic<uint64_t> count_;
+};
+
+// 一个慢请求及其各阶段耗时
+struct SlowOp {
+    // 请求完成的时间
+    uint64_t timeUs;
+    // 请求总耗时
+    uint64_t latencyUs;
+    // 请求及各阶段耗时的描述
+    std::string desc;
+};
+
+// 记录最近一段时间内最慢的topN个请求，通过bvar导出，可以在
+// http://ip:port/vars/<prefix>_<name> 查看
+class SlowOpTracker {
+ public:
+    /**
+     * @param prefix,name: bvar的名字
+     * @param capacity: 保留的慢请求个数
+     * @param windowS: 只保留最近windowS秒内完成的请求
+     */
+    SlowOpTracker(const std::string& prefix, const std::string& name,
+                  uint32_t capacity = 20, uint32_t windowS = 60);
+
+    /**
+     * 判断一个请求是否会被记录，不会被记录的请求不需要构造描述信息
+     * @param latencyUs: 请求总耗时
+     */
+    bool Accept(uint64_t latencyUs);
+
+    /**
+     * 记录一个请求，如果已满则替换掉其中最快的一个
+     * @param latencyUs: 请求总耗时
+     * @param desc: 请求及各阶段耗时的描述
+     */
+    void Add(uint64_t latencyUs, const std::string& desc);
+
+    /**
+     * 按耗时从大到小获取当前记录的慢请求
+     */
+    std::vector<SlowOp> GetSlowOps();
+
+    /**
+     * 按耗时从大到小输出当前记录的慢请求，每行一个
+     */
+    std::string Dump();
+
+ private:
+    // 清理超过时间窗口的请求，调用者需要持有锁
+    void Expire(uint64_t nowUs);
+
+    static void DumpSlowOps(std::ostream& os, void* arg);
+
+ private:
+    const uint32_t capacity_;
+    const uint64_t windowUs_;
+    std::mutex mtx_;
+    std::vector<SlowOp> ops_;
+    std::unique_ptr<bvar::PassiveStatus<std::string>> status_;
+};
+
+}  // namespace common
+}  // namespace curve
+
+#endif  // SRC_COMMON_OP_TRACE_H_
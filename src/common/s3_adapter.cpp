@@ -24,6 +24,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <aws/core/utils/StringUtils.h>  //NOLINT
 
 namespace curve {
 namespace common {
@@ -216,6 +217,32 @@ int S3Adapter::GetObject(const Aws::String &key,
     }
 }
 
+int S3Adapter::GetObjectIfExist(const Aws::String &key,
+                                std::string *data,
+                                bool *exist) {
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(bucketName_);
+    request.SetKey(key);
+    std::stringstream ss;
+    auto response = s3Client_->GetObject(request);
+    if (response.IsSuccess()) {
+        ss << response.GetResult().GetBody().rdbuf();
+        *data = ss.str();
+        *exist = true;
+        return 0;
+    }
+    auto errorType = response.GetError().GetErrorType();
+    if (errorType == Aws::S3::S3Errors::NO_SUCH_KEY ||
+        errorType == Aws::S3::S3Errors::RESOURCE_NOT_FOUND) {
+        *exist = false;
+        return 0;
+    }
+    LOG(ERROR) << "GetObject error: "
+            << response.GetError().GetExceptionName()
+            << response.GetError().GetMessage();
+    return -1;
+}
+
 int S3Adapter::GetObject(const std::string &key,
                          char *buf,
                          off_t offset,
@@ -257,6 +284,11 @@ void S3Adapter::GetObjectAsync(std::shared_ptr<GetObjectAsyncContext> context) {
             Aws::S3::Model::GetObjectResult &ret =
                 const_cast<Aws::S3::Model::GetObjectResult&>(result);
             ret.GetBody().rdbuf()->sgetn(ctx->buf, ctx->len);  // NOLINT
+            for (const auto &kv : result.GetMetadata()) {
+                ctx->metadata.emplace(
+                    std::string(kv.first.c_str(), kv.first.size()),
+                    std::string(kv.second.c_str(), kv.second.size()));
+            }
             ctx->retCode = 0;
         } else {
             LOG(ERROR) << "GetObjectAsync error: "
@@ -347,9 +379,13 @@ int S3Adapter::GetObjectMeta(const Aws::String &key,
     }
 }
 */
-Aws::String S3Adapter::MultiUploadInit(const Aws::String &key) {
+Aws::String S3Adapter::MultiUploadInit(const Aws::String &key,
+    const Aws::Map<Aws::String, Aws::String> &metadata) {
     Aws::S3::Model::CreateMultipartUploadRequest request;
     request.WithBucket(bucketName_).WithKey(key);
+    if (!metadata.empty()) {
+        request.SetMetadata(metadata);
+    }
     auto response = s3Client_->CreateMultipartUpload(request);
     if (response.IsSuccess()) {
         return response.GetResult().GetUploadId();
@@ -387,6 +423,37 @@ Aws::S3::Model::CompletedPart S3Adapter:: UploadOnePart(
     }
 }
 
+Aws::S3::Model::CompletedPart S3Adapter::UploadPartCopy(
+    const Aws::String &key,
+    const Aws::String &uploadId,
+    int partNum,
+    const Aws::String &srcKey,
+    uint64_t srcOffset,
+    int partSize) {
+    Aws::S3::Model::UploadPartCopyRequest request;
+    request.SetBucket(bucketName_);
+    request.SetKey(key);
+    request.SetUploadId(uploadId);
+    request.SetPartNumber(partNum);
+    request.SetCopySource(bucketName_ + "/" +
+        Aws::Utils::StringUtils::URLEncode(srcKey.c_str()));
+    Aws::StringStream range;
+    range << "bytes=" << srcOffset << "-" << srcOffset + partSize - 1;
+    request.SetCopySourceRange(range.str());
+    auto result = s3Client_->UploadPartCopy(request);
+    if (result.IsSuccess()) {
+        return Aws::S3::Model::CompletedPart()
+            .WithETag(result.GetResult().GetCopyPartResult().GetETag())
+            .WithPartNumber(partNum);
+    } else {
+        LOG(ERROR) << "UploadPartCopy error: "
+                   << result.GetError().GetExceptionName()
+                   << result.GetError().GetMessage();
+        return Aws::S3::Model::CompletedPart()
+                .WithETag("errorTag").WithPartNumber(-1);
+    }
+}
+
 int S3Adapter::CompleteMultiUpload(const Aws::String &key,
                 const Aws::String &uploadId,
             const Aws::Vector<Aws::S3::Model::CompletedPart> &cp_v) {
@@ -39,6 +39,7 @@
 #include <aws/s3/model/DeleteObjectRequest.h>  //NOLINT
 #include <aws/s3/model/CreateMultipartUploadRequest.h>  //NOLINT
 #include <aws/s3/model/UploadPartRequest.h>  //NOLINT
+#include <aws/s3/model/UploadPartCopyRequest.h>  //NOLINT
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>  //NOLINT
 #include <aws/s3/model/AbortMultipartUploadRequest.h>   //NOLINT
 #include <aws/core/http/HttpRequest.h>  //NOLINT
@@ -68,6 +69,8 @@ struct GetObjectAsyncContext : public Aws::Client::AsyncCallerContext {
     size_t len;
     GetObjectAsyncCallBack cb;
     int retCode;
+    // 读取成功时返回对象的用户元数据
+    std::map<std::string, std::string> metadata;
 };
 
 class S3Adapter {
@@ -117,6 +120,16 @@ class S3Adapter {
      * @return 0 读取成功/ -1 读取失败
      */
     virtual int GetObject(const Aws::String &key, std::string *data);
+    /**
+     * 从对象存储读取数据，与GetObject的区别是对象不存在不视为失败
+     * @param 对象名
+     * @param 保存数据的指针
+     * @param[out] 对象是否存在
+     * @return 0 读取成功或对象不存在/ -1 读取失败
+     */
+    virtual int GetObjectIfExist(const Aws::String &key,
+                                 std::string *data,
+                                 bool *exist);
     /**
      * 从对象存储读取数据
      * @param 对象名
@@ -157,9 +170,11 @@ class S3Adapter {
     /**
      * 初始化对象的分片上传任务
      * @param 对象名
+     * @param 对象的用户元数据，可以为空
      * @return 任务名
      */
-    virtual Aws::String MultiUploadInit(const Aws::String &key);
+    virtual Aws::String MultiUploadInit(const Aws::String &key,
+        const Aws::Map<Aws::String, Aws::String> &metadata);
     /**
      * 增加一个分片到分片上传任务中
      * @param 对象名
@@ -174,6 +189,24 @@ class S3Adapter {
             int partNum,
             int partSize,
             const char* buf);
+    /**
+     * 从桶内已有对象的指定范围服务端拷贝一个分片到分片上传任务中，
+     * 数据不经过本地
+     * @param 对象名
+     * @param 任务名
+     * @param 第几个分片（从1开始）
+     * @param 源对象名
+     * @param 源对象中的起始偏移
+     * @param 分片大小
+     * @return: 分片任务管理对象
+     */
+    virtual Aws::S3::Model::CompletedPart UploadPartCopy(
+            const Aws::String &key,
+            const Aws::String &uploadId,
+            int partNum,
+            const Aws::String &srcKey,
+            uint64_t srcOffset,
+            int partSize);
     /**
      * 完成分片上传任务
      * @param 对象名
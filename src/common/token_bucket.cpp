@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#include "src/common/token_bucket.h"
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace common {
+
+TokenBucket::TokenBucket(uint64_t rate, uint64_t burst)
+    : rate_(rate),
+      burst_(burst == 0 ? rate : burst),
+      level_(burst_),
+      lastRefillUs_(TimeUtility::GetTimeofDayUs()) {}
+
+void TokenBucket::SetRate(uint64_t rate, uint64_t burst) {
+    LockGuard lk(mtx_);
+    if (burst == 0) {
+        burst = rate;
+    }
+    if (rate == rate_ && burst == burst_) {
+        return;
+    }
+    Refill(TimeUtility::GetTimeofDayUs());
+    // 从不限制切换为限制时, 桶是满的
+    if (rate_ == 0) {
+        level_ = burst;
+    }
+    rate_ = rate;
+    burst_ = burst;
+    if (level_ > burst_) {
+        level_ = burst_;
+    }
+}
+
+bool TokenBucket::Consume(uint64_t tokens, uint64_t reserve) {
+    return Consume(tokens, reserve, TimeUtility::GetTimeofDayUs());
+}
+
+bool TokenBucket::Consume(uint64_t tokens, uint64_t reserve, uint64_t nowUs) {
+    LockGuard lk(mtx_);
+    if (rate_ == 0) {
+        return true;
+    }
+
+    Refill(nowUs);
+    if (level_ <= 0 || level_ <= reserve) {
+        return false;
+    }
+    level_ -= tokens;
+    return true;
+}
+
+bool TokenBucket::Available(uint64_t reserve) {
+    return Available(reserve, TimeUtility::GetTimeofDayUs());
+}
+
+bool TokenBucket::Available(uint64_t reserve, uint64_t nowUs) {
+    LockGuard lk(mtx_);
+    if (rate_ == 0) {
+        return true;
+    }
+
+    Refill(nowUs);
+    return level_ > 0 && level_ > reserve;
+}
+
+uint64_t TokenBucket::Reserve(uint64_t tokens) {
+    return Reserve(tokens, TimeUtility::GetTimeofDayUs());
+}
+
+uint64_t TokenBucket::Reserve(uint64_t tokens, uint64_t nowUs) {
+    LockGuard lk(mtx_);
+    if (rate_ == 0) {
+        return 0;
+    }
+
+    Refill(nowUs);
+    level_ -= tokens;
+    if (level_ >= 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(-level_ * 1000000 / rate_);
+}
+
+void TokenBucket::Refill(uint64_t nowUs) {
+    if (nowUs <= lastRefillUs_) {
+        return;
+    }
+    level_ += static_cast<double>(nowUs - lastRefillUs_) * rate_ / 1000000;
+    if (level_ > burst_) {
+        level_ = burst_;
+    }
+    lastRefillUs_ = nowUs;
+}
+
+}  // namespace common
+}  // namespace curve
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#ifndef SRC_COMMON_TOKEN_BUCKET_H_
+#define SRC_COMMON_TOKEN_BUCKET_H_
+
+#include <stdint.h>
+
+#include "src/common/uncopyable.h"
+#include "src/common/concurrent/concurrent.h"
+
+namespace curve {
+namespace common {
+
+/**
+ * 令牌桶, 以固定速率产生令牌, 桶中最多存放burst个令牌
+ * 取令牌时只要桶中还有令牌就允许取出, 不足的部分记为透支,
+ * 由后续产生的令牌偿还, 这样大请求不会因为一次取不到足够的令牌而饿死
+ */
+class TokenBucket : public Uncopyable {
+ public:
+    /**
+     * @param rate 每秒产生的令牌数, 为0表示不限制
+     * @param burst 桶的容量, 为0时取rate
+     */
+    TokenBucket(uint64_t rate, uint64_t burst);
+
+    /**
+     * @brief 修改令牌产生速率和桶的容量, 参数含义同构造函数
+     */
+    void SetRate(uint64_t rate, uint64_t burst);
+
+    /**
+     * @brief 桶中令牌数大于reserve时取出tokens个令牌
+     *
+     * @param tokens 需要的令牌数
+     * @param reserve 需要为其他请求保留的令牌数
+     *
+     * @return 取到令牌或者不限制时返回true, 否则返回false
+     */
+    bool Consume(uint64_t tokens, uint64_t reserve = 0);
+
+    /**
+     * @brief 同上, nowUs为当前时间, 单位us
+     */
+    bool Consume(uint64_t tokens, uint64_t reserve, uint64_t nowUs);
+
+    /**
+     * @brief 桶中令牌数是否大于reserve, 不取出令牌
+     *        需要同时检查多个令牌桶时, 先检查都有令牌再用Reserve取出,
+     *        避免一个桶取到令牌后被另一个桶限制而白白消耗令牌
+     *
+     * @param reserve 需要为其他请求保留的令牌数
+     *
+     * @return 有令牌或者不限制时返回true, 否则返回false
+     */
+    bool Available(uint64_t reserve = 0);
+
+    /**
+     * @brief 同上, nowUs为当前时间, 单位us
+     */
+    bool Available(uint64_t reserve, uint64_t nowUs);
+
+    /**
+     * @brief 无条件取出tokens个令牌, 返回调用者需要等待的时间,
+     *        等待期间产生的令牌用于偿还本次透支的部分
+     *
+     * @param tokens 需要的令牌数
+     *
+     * @return 需要等待的时间, 单位us, 不限制时返回0
+     */
+    uint64_t Reserve(uint64_t tokens);
+
+    /**
+     * @brief 同上, nowUs为当前时间, 单位us
+     */
+    uint64_t Reserve(uint64_t tokens, uint64_t nowUs);
+
+    uint64_t GetRate() const {
+        return rate_;
+    }
+
+    uint64_t GetBurst() const {
+        return burst_;
+    }
+
+ private:
+    void Refill(uint64_t nowUs);
+
+ private:
+    Mutex mtx_;
+    uint64_t rate_;
+    uint64_t burst_;
+    // 当前令牌数, 透支时为负数
+    double level_;
+    // 上一次补充令牌的时间, 单位us
+    uint64_t lastRefillUs_;
+};
+
+}  // namespace common
+}  // namespace curve
+
+#endif  // SRC_COMMON_TOKEN_BUCKET_H_
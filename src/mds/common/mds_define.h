@@ -51,6 +51,10 @@ const int kCsClientCSOffline = -6;
 // to prevent the request from being intercepted and played back
 const uint64_t kStaledRequestTimeIntervalUs = 15 * 1000 * 1000u;
 
+// kMaxListSegmentsLimit indicates the max number of segments returned
+// by one ListSegments request
+const uint32_t kMaxListSegmentsLimit = 1024u;
+
 }  // namespace mds
 }  // namespace curve
 
@@ -46,6 +46,7 @@ struct HeartbeatOption {
         this->heartbeatIntervalMs = heartbeatInterval;
         this->heartbeatMissTimeOutMs = heartbeatMissTimeout;
         this->offLineTimeOutMs = offLineTimeout;
+        this->topoUpdateShardNum = 0;
     }
 
     // heartbeatIntervalMs: 正常心跳间隔.
@@ -68,6 +69,10 @@ struct HeartbeatOption {
 
     // mdsStartTime: mds启动时间
     steady_clock::time_point mdsStartTime;
+
+    // topoUpdateShardNum: 后台更新topology的shard数量
+    // 为0时在心跳rpc线程中直接更新topology
+    uint32_t topoUpdateShardNum;
 };
 
 struct HeartbeatInfo {
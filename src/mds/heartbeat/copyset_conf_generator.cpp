@@ -80,6 +80,23 @@ bool CopysetConfGenerator::GenCopysetConf(
     }
 }
 
+bool CopysetConfGenerator::NeedGenCopysetConf(ChunkServerIdType reportId,
+    const ::curve::mds::topology::CopySetKey &key,
+    bool isLeader, uint64_t reportEpoch) {
+    ::curve::mds::topology::CopySetInfo recordCopySetInfo;
+    if (!topo_->GetCopySet(key, &recordCopySetInfo)) {
+        return true;
+    }
+
+    if (isLeader) {
+        return coordinator_->HasOperator(key);
+    }
+
+    // follower在mds记录的配置中并且epoch一致时不会被清理
+    return recordCopySetInfo.GetEpoch() != reportEpoch ||
+        recordCopySetInfo.GetCopySetMembers().count(reportId) == 0;
+}
+
 ChunkServerIdType CopysetConfGenerator::LeaderGenCopysetConf(
     const ::curve::mds::topology::CopySetInfo &copySetInfo,
     const ::curve::mds::heartbeat::ConfigChangeInfo &configChInfo,
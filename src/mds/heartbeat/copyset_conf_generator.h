@@ -67,6 +67,22 @@ class CopysetConfGenerator {
         const ::curve::mds::heartbeat::ConfigChangeInfo &configChInfo,
         ::curve::mds::heartbeat::CopySetConf *copysetConf);
 
+    /*
+    * @brief NeedGenCopysetConf 增量心跳中上报信息没有变化的copyset是否需要
+    *        重新生成配置。上报信息不变时, 只有mds上有该copyset的operator,
+    *        或者mds记录的配置和follower上报的不一致时才可能有配置下发
+    *
+    * @param[in] reportId 上报心跳的chunkserverId
+    * @param[in] key 上报的copyset
+    * @param[in] isLeader 上报心跳的chunkserver是否为该copyset的leader
+    * @param[in] reportEpoch 上报的epoch
+    *
+    * @return 需要调用GenCopysetConf时为true
+    */
+    bool NeedGenCopysetConf(ChunkServerIdType reportId,
+        const ::curve::mds::topology::CopySetKey &key,
+        bool isLeader, uint64_t reportEpoch);
+
  private:
     /*
     * @brief LeaderGenCopysetConf 处理leader copyset信息，主要步骤是转发到调度模块
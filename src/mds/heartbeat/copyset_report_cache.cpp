@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#include <glog/logging.h>
+
+#include "src/mds/heartbeat/copyset_report_cache.h"
+
+using ::curve::common::LockGuard;
+
+namespace curve {
+namespace mds {
+namespace heartbeat {
+
+bool CopysetReportCache::Merge(const ChunkServerHeartbeatRequest &request,
+                               ChunkServerHeartbeatRequest *merged) {
+    auto entry = GetOrCreateEntry(request.chunkserverid());
+    LockGuard lk(entry->mtx);
+
+    // 全量心跳, 直接替换缓存
+    if (!request.has_basesequence()) {
+        entry->copysets.clear();
+        for (const auto &info : request.copysetinfos()) {
+            entry->copysets[CopysetKey(info.logicalpoolid(),
+                                       info.copysetid())] = info;
+        }
+        entry->sequence = request.sequence();
+        return true;
+    }
+
+    if (entry->sequence != request.basesequence()) {
+        LOG(WARNING) << "heartbeat from chunkserver "
+                     << request.chunkserverid()
+                     << " base on sequence " << request.basesequence()
+                     << ", but mds record sequence is " << entry->sequence
+                     << ", need full report";
+        // 序号为0的记录不会被任何增量心跳匹配
+        entry->sequence = 0;
+        entry->copysets.clear();
+        return false;
+    }
+
+    for (const auto &key : request.removedcopysets()) {
+        entry->copysets.erase(
+            CopysetKey(key.logicalpoolid(), key.copysetid()));
+    }
+    for (const auto &info : request.copysetinfos()) {
+        entry->copysets[CopysetKey(info.logicalpoolid(),
+                                   info.copysetid())] = info;
+    }
+    entry->sequence = request.sequence();
+
+    merged->CopyFrom(request);
+    merged->clear_basesequence();
+    merged->clear_removedcopysets();
+    merged->clear_copysetinfos();
+    for (const auto &item : entry->copysets) {
+        *merged->add_copysetinfos() = item.second;
+    }
+    return true;
+}
+
+void CopysetReportCache::Remove(ChunkServerIdType csId) {
+    LockGuard lk(mtx_);
+    entries_.erase(csId);
+}
+
+std::vector<ChunkServerIdType> CopysetReportCache::GetChunkServerIds() {
+    LockGuard lk(mtx_);
+    std::vector<ChunkServerIdType> ids;
+    ids.reserve(entries_.size());
+    for (auto &entry : entries_) {
+        ids.push_back(entry.first);
+    }
+    return ids;
+}
+
+std::shared_ptr<CopysetReportCache::Entry>
+    CopysetReportCache::GetOrCreateEntry(ChunkServerIdType csId) {
+    LockGuard lk(mtx_);
+    auto it = entries_.find(csId);
+    if (it != entries_.end()) {
+        return it->second;
+    }
+    auto entry = std::make_shared<Entry>();
+    entry->sequence = 0;
+    entries_.emplace(csId, entry);
+    return entry;
+}
+
+}  // namespace heartbeat
+}  // namespace mds
+}  // namespace curve
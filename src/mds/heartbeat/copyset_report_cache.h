@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#ifndef SRC_MDS_HEARTBEAT_COPYSET_REPORT_CACHE_H_
+#define SRC_MDS_HEARTBEAT_COPYSET_REPORT_CACHE_H_
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "proto/heartbeat.pb.h"
+#include "src/mds/common/mds_define.h"
+#include "src/common/concurrent/concurrent.h"
+
+using ::curve::mds::topology::ChunkServerIdType;
+
+namespace curve {
+namespace mds {
+namespace heartbeat {
+
+// CopysetReportCache: 缓存每个chunkserver最近一次上报的全部copyset信息,
+// 用于把chunkserver的增量心跳还原成全量心跳
+// - 全量心跳(不带baseSequence)直接替换缓存
+// - 增量心跳的baseSequence必须等于缓存的序号, 否则说明中间有心跳丢失或
+//   mds发生了切换, 需要chunkserver重新上报全量信息
+class CopysetReportCache {
+ public:
+    /**
+     * @brief Merge 用心跳请求更新缓存
+     *
+     * @param[in] request 心跳请求
+     * @param[out] merged 增量心跳时输出合并后的全量请求, 全量心跳时不修改
+     *
+     * @return 增量心跳无法合并时返回false
+     */
+    bool Merge(const ChunkServerHeartbeatRequest &request,
+               ChunkServerHeartbeatRequest *merged);
+
+    /**
+     * @brief Remove 删除chunkserver的缓存
+     *
+     * @param[in] csId chunkserver id
+     */
+    void Remove(ChunkServerIdType csId);
+
+    /**
+     * @brief GetChunkServerIds 获取有缓存的chunkserver列表
+     *
+     * @return chunkserver id列表
+     */
+    std::vector<ChunkServerIdType> GetChunkServerIds();
+
+ private:
+    using CopysetKey = std::pair<uint32_t, uint32_t>;
+
+    struct Entry {
+        curve::common::Mutex mtx;
+        // 最近一次合并成功的心跳序号
+        uint64_t sequence;
+        std::map<CopysetKey, CopySetInfo> copysets;
+    };
+
+    std::shared_ptr<Entry> GetOrCreateEntry(ChunkServerIdType csId);
+
+ private:
+    curve::common::Mutex mtx_;
+    std::unordered_map<ChunkServerIdType, std::shared_ptr<Entry>> entries_;
+};
+
+}  // namespace heartbeat
+}  // namespace mds
+}  // namespace curve
+
+#endif  // SRC_MDS_HEARTBEAT_COPYSET_REPORT_CACHE_H_
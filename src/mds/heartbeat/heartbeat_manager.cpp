@@ -25,6 +25,7 @@
 #include <set>
 #include "src/mds/heartbeat/heartbeat_manager.h"
 #include "src/common/string_util.h"
+#include "src/common/timeutility.h"
 #include "src/mds/topology/topology_stat.h"
 
 using ::curve::mds::topology::ChunkServer;
@@ -37,6 +38,7 @@ using ::curve::mds::topology::ChunkServerStatus;
 using ::curve::mds::topology::ChunkServerStat;
 using ::curve::mds::topology::CopysetStat;
 using ::curve::mds::topology::SplitPeerId;
+using ::curve::common::TimeUtility;
 
 namespace curve {
 namespace mds {
@@ -46,11 +48,18 @@ HeartbeatManager::HeartbeatManager(HeartbeatOption option,
     std::shared_ptr<TopologyStat> topologyStat,
     std::shared_ptr<Coordinator> coordinator)
     : topology_(topology),
-      topologyStat_(topologyStat) {
+      topologyStat_(topologyStat),
+      heartbeatLatency_("mds_heartbeat", "process"),
+      deltaHeartbeatCount_("mds_heartbeat", "delta_count"),
+      needFullReportCount_("mds_heartbeat", "need_full_report_count") {
     healthyChecker_ =
         std::make_shared<ChunkserverHealthyChecker>(option, topology);
 
     topoUpdater_ = std::make_shared<TopoUpdater>(topology);
+    if (option.topoUpdateShardNum > 0) {
+        topoUpdateDispatcher_ = std::make_shared<TopoUpdateDispatcher>(
+            topoUpdater_, option.topoUpdateShardNum);
+    }
 
     copysetConfGenerator_ =
         std::make_shared<CopysetConfGenerator>(topology, coordinator,
@@ -75,6 +84,9 @@ void HeartbeatManager::Run() {
     if (isStop_.exchange(false)) {
         backEndThread_ =
             Thread(&HeartbeatManager::ChunkServerHealthyChecker, this);
+        if (topoUpdateDispatcher_ != nullptr) {
+            topoUpdateDispatcher_->Start();
+        }
     }
 }
 
@@ -83,6 +95,9 @@ void HeartbeatManager::Stop() {
         LOG(INFO) << "stop heartbeatManager...";
         sleeper_.interrupt();
         backEndThread_.join();
+        if (topoUpdateDispatcher_ != nullptr) {
+            topoUpdateDispatcher_->Stop();
+        }
         LOG(INFO) << "stop heartbeatManager ok.";
     } else {
         LOG(INFO) << "heartbeatManager not running.";
@@ -93,6 +108,19 @@ void HeartbeatManager::ChunkServerHealthyChecker() {
     while (sleeper_.wait_for(
         std::chrono::milliseconds(chunkserverHealthyCheckerRunInter_))) {
         healthyChecker_->CheckHeartBeatInterval();
+        CleanReportCache();
+    }
+}
+
+void HeartbeatManager::CleanReportCache() {
+    for (auto csId : reportCache_.GetChunkServerIds()) {
+        HeartbeatInfo info;
+        if (!healthyChecker_->GetHeartBeatInfo(csId, &info) ||
+            info.state == OnlineState::OFFLINE) {
+            LOG(INFO) << "chunkserver " << csId
+                      << " is offline or removed, clean its report cache";
+            reportCache_.Remove(csId);
+        }
     }
 }
 
@@ -182,34 +210,83 @@ void HeartbeatManager::UpdateChunkServerStatistics(
 void HeartbeatManager::ChunkServerHeartbeat(
     const ChunkServerHeartbeatRequest &request,
     ChunkServerHeartbeatResponse *response) {
+    uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    ProcessHeartbeat(request, response);
+    heartbeatLatency_ << TimeUtility::GetTimeofDayUs() - startUs;
+}
+
+void HeartbeatManager::ProcessHeartbeat(
+    const ChunkServerHeartbeatRequest &originRequest,
+    ChunkServerHeartbeatResponse *response) {
     response->set_statuscode(HeartbeatStatusCode::hbOK);
     // 检查request的合法性
-    HeartbeatStatusCode ret = CheckRequest(request);
+    HeartbeatStatusCode ret = CheckRequest(originRequest);
     if (ret != HeartbeatStatusCode::hbOK) {
         LOG(ERROR) << "heartbeatManager get error request";
+        // 已经移除或者退役的chunkserver不再需要缓存的copyset信息
+        if (ret == HeartbeatStatusCode::hbChunkserverUnknown ||
+            ret == HeartbeatStatusCode::hbChunkserverRetired) {
+            reportCache_.Remove(originRequest.chunkserverid());
+        }
         response->set_statuscode(ret);
         return;
     }
 
+    // 先更新心跳时间, 避免后台线程把刚建立的缓存当作offline的chunkserver清理
+    healthyChecker_->UpdateLastReceivedHeartbeatTime(
+        originRequest.chunkserverid(), steady_clock::now());
+
+    // 带序号的心跳需要记录到缓存中, 增量心跳合并为全量心跳用于统计
+    ChunkServerHeartbeatRequest mergedRequest;
+    bool merged = true;
+    if (originRequest.has_sequence()) {
+        merged = reportCache_.Merge(originRequest, &mergedRequest);
+        if (originRequest.has_basesequence()) {
+            deltaHeartbeatCount_ << 1;
+        }
+    }
+    const ChunkServerHeartbeatRequest &request =
+        originRequest.has_basesequence() ? mergedRequest : originRequest;
+
     // 将chunksever中记录的startUpTime记录到到topology中
-    if (request.has_starttime()) {
+    if (originRequest.has_starttime()) {
         topology_->UpdateChunkServerStartUpTime(
-            request.starttime(), request.chunkserverid());
+            originRequest.starttime(), originRequest.chunkserverid());
     }
 
-    // 将心跳上报时间点pass到chunkserver健康检查模块
-    healthyChecker_->UpdateLastReceivedHeartbeatTime(request.chunkserverid(),
-                                    steady_clock::now());
+    UpdateChunkServerDiskStatus(originRequest);
 
-    UpdateChunkServerDiskStatus(request);
+    // 增量心跳无法合并时缺少copyset信息, 只更新chunkserver状态
+    if (!merged) {
+        needFullReportCount_ << 1;
+        response->set_needfullreport(true);
+        return;
+    }
 
     UpdateChunkServerStatistics(request);
     // request里面没有copyset信息
     if (request.copysetinfos_size() == 0) {
         response->set_statuscode(HeartbeatStatusCode::hbRequestNoCopyset);
     }
+    // 增量心跳中只处理有变化的copyset, 没有变化的copyset上报信息和上次相同,
+    // 不需要再转换和更新topology, 只在mds可能有新的配置下发时处理
+    bool isDelta = originRequest.has_basesequence();
+    std::set<::curve::mds::topology::CopySetKey> changedCopysets;
+    if (isDelta) {
+        for (auto &value : originRequest.copysetinfos()) {
+            changedCopysets.emplace(value.logicalpoolid(), value.copysetid());
+        }
+    }
+
     // 处理心跳中的copyset
     for (auto &value : request.copysetinfos()) {
+        ::curve::mds::topology::CopySetKey key(
+            value.logicalpoolid(), value.copysetid());
+        if (isDelta && changedCopysets.count(key) == 0 &&
+            !UnchangedCopySetNeedProcess(request, value)) {
+            continue;
+        }
+
         // 逻辑池不可用时，不处理该逻辑池的copyset信息
         ::curve::mds::topology::LogicalPool lPool;
         if (topology_->GetLogicalPool(value.logicalpoolid(), &lPool)) {
@@ -230,6 +307,14 @@ void HeartbeatManager::ChunkServerHeartbeat(
             continue;
         }
 
+        bool isLeader =
+            request.chunkserverid() == reportCopySetInfo.GetLeader();
+        // 生成配置时会读写topology中的copyset, 先把之前的上报更新进去,
+        // 避免后台的旧上报覆盖本次生成配置时记录的candidate
+        if (isLeader && topoUpdateDispatcher_ != nullptr) {
+            topoUpdateDispatcher_->Flush(reportCopySetInfo.GetCopySetKey());
+        }
+
         // 把上报的copyset的信息转发到CopysetConfGenerator模块处理
         CopySetConf conf;
         ConfigChangeInfo configChInfo;
@@ -241,12 +326,31 @@ void HeartbeatManager::ChunkServerHeartbeat(
         }
 
         // 如果是leader, 根据leader上报的信息
-        if (request.chunkserverid() == reportCopySetInfo.GetLeader()) {
-            topoUpdater_->UpdateTopo(reportCopySetInfo);
+        // 配置了shard时交由后台批量更新，不阻塞心跳rpc，
+        // 后台已停止时同步更新
+        if (isLeader) {
+            if (topoUpdateDispatcher_ == nullptr ||
+                !topoUpdateDispatcher_->Submit(reportCopySetInfo)) {
+                topoUpdater_->UpdateTopo(reportCopySetInfo);
+            }
         }
     }
 }
 
+bool HeartbeatManager::UnchangedCopySetNeedProcess(
+    const ChunkServerHeartbeatRequest &request,
+    const ::curve::mds::heartbeat::CopySetInfo &info) {
+    std::string leaderIp;
+    uint32_t leaderPort;
+    bool isLeader = SplitPeerId(info.leaderpeer().address(),
+                                &leaderIp, &leaderPort) &&
+                    leaderIp == request.ip() && leaderPort == request.port();
+    ::curve::mds::topology::CopySetKey key(
+        info.logicalpoolid(), info.copysetid());
+    return copysetConfGenerator_->NeedGenCopysetConf(
+        request.chunkserverid(), key, isLeader, info.epoch());
+}
+
 HeartbeatStatusCode HeartbeatManager::CheckRequest(
     const ChunkServerHeartbeatRequest &request) {
     ChunkServer chunkServer;
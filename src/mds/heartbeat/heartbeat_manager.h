@@ -23,6 +23,8 @@
 #ifndef SRC_MDS_HEARTBEAT_HEARTBEAT_MANAGER_H_
 #define SRC_MDS_HEARTBEAT_HEARTBEAT_MANAGER_H_
 
+#include <bvar/bvar.h>
+
 #include <vector>
 #include <map>
 #include <atomic>
@@ -32,6 +34,8 @@
 #include "src/mds/topology/topology.h"
 #include "src/mds/common/mds_define.h"
 #include "src/mds/heartbeat/topo_updater.h"
+#include "src/mds/heartbeat/topo_update_dispatcher.h"
+#include "src/mds/heartbeat/copyset_report_cache.h"
 #include "src/mds/heartbeat/copyset_conf_generator.h"
 #include "src/mds/heartbeat/chunkserver_healthy_checker.h"
 #include "src/mds/schedule/coordinator.h"
@@ -157,6 +161,35 @@ class HeartbeatManager {
      */
     ChunkServerIdType GetChunkserverIdByPeerStr(std::string peer);
 
+    /**
+     * @brief UnchangedCopySetNeedProcess 增量心跳中没有变化的copyset
+     *        是否需要处理. 上报信息与上次相同, 只有mds可能有新的配置
+     *        下发时才需要处理
+     *
+     * @param[in] request 合并后的心跳请求
+     * @param[in] info 没有变化的copyset信息
+     *
+     * @return 需要处理返回true
+     */
+    bool UnchangedCopySetNeedProcess(
+        const ChunkServerHeartbeatRequest &request,
+        const ::curve::mds::heartbeat::CopySetInfo &info);
+
+    /**
+     * @brief CleanReportCache 清理已经offline或者从topology中移除的chunkserver
+     *        缓存的copyset信息, 这些chunkserver的下一次心跳需要全量上报
+     */
+    void CleanReportCache();
+
+    /**
+     * @brief ProcessHeartbeat 处理心跳请求, ChunkServerHeartbeat在此基础上统计耗时
+     *
+     * @param[in] originRequest 心跳rpc请求, 可能为增量心跳
+     * @param[out] response 心跳处理结果
+     */
+    void ProcessHeartbeat(const ChunkServerHeartbeatRequest &originRequest,
+                          ChunkServerHeartbeatResponse *response);
+
  private:
     // heartbeat相关依赖
     std::shared_ptr<Topology> topology_;
@@ -167,6 +200,10 @@ class HeartbeatManager {
     std::shared_ptr<ChunkserverHealthyChecker> healthyChecker_;
     // topoUpdater_ 更新topo中copyset的epoch, 复制组关系等信息
     std::shared_ptr<TopoUpdater> topoUpdater_;
+    // topoUpdateDispatcher_ 分片批量更新topology, 未配置shard时为nullptr
+    std::shared_ptr<TopoUpdateDispatcher> topoUpdateDispatcher_;
+    // reportCache_ 缓存chunkserver上报的copyset信息, 用于合并增量心跳
+    CopysetReportCache reportCache_;
     // CopysetConfGenerator 根据新旧copyset的信息确认是否需要生成命令下发给chunkserver //NOLINT
     // 处理如下几种情况:
     // 1. chunkserver上报的copyset在mds中不存在
@@ -179,6 +216,13 @@ class HeartbeatManager {
     Atomic<bool> isStop_;
     InterruptibleSleeper sleeper_;
     int chunkserverHealthyCheckerRunInter_;
+
+    // 单次心跳处理耗时
+    bvar::LatencyRecorder heartbeatLatency_;
+    // 收到的增量心跳数量
+    bvar::Adder<uint64_t> deltaHeartbeatCount_;
+    // 增量心跳无法合并, 要求chunkserver全量上报的次数
+    bvar::Adder<uint64_t> needFullReportCount_;
 };
 
 }  // namespace heartbeat
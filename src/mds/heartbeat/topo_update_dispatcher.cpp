@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#include <glog/logging.h>
+#include <utility>
+
+#include "src/mds/heartbeat/topo_update_dispatcher.h"
+#include "src/common/timeutility.h"
+
+using ::curve::common::TimeUtility;
+using ::curve::common::LockGuard;
+using ::curve::common::UniqueLock;
+
+namespace curve {
+namespace mds {
+namespace heartbeat {
+
+TopoUpdateDispatcher::TopoUpdateDispatcher(
+    std::shared_ptr<TopoUpdater> topoUpdater, uint32_t shardNum)
+    : topoUpdater_(topoUpdater),
+      isStop_(true),
+      rejectSubmit_(false),
+      queueDepth_("mds_heartbeat_topo_update", "queue_depth"),
+      batchLatency_("mds_heartbeat_topo_update", "batch") {
+    batchSize_.expose_as("mds_heartbeat_topo_update", "batch_size");
+    for (uint32_t i = 0; i < shardNum; i++) {
+        shards_.emplace_back(new Shard());
+    }
+}
+
+void TopoUpdateDispatcher::Start() {
+    if (isStop_.exchange(false)) {
+        for (auto &shard : shards_) {
+            shard->worker = curve::common::Thread(
+                &TopoUpdateDispatcher::ShardFunc, this, shard.get());
+        }
+        LOG(INFO) << "topo update dispatcher start, shard num: "
+                  << shards_.size();
+    }
+}
+
+void TopoUpdateDispatcher::Stop() {
+    rejectSubmit_.store(true);
+    if (!isStop_.exchange(true)) {
+        for (auto &shard : shards_) {
+            LockGuard lk(shard->mtx);
+            shard->cond.notify_all();
+        }
+        for (auto &shard : shards_) {
+            shard->worker.join();
+        }
+    }
+    // 把剩余的上报更新到topology, 包括未启动时提交的
+    for (auto &shard : shards_) {
+        while (ApplyPending(shard.get(), nullptr)) {}
+    }
+    LOG(INFO) << "topo update dispatcher stopped";
+}
+
+bool TopoUpdateDispatcher::Submit(const CopySetInfo &reportCopySetInfo) {
+    CopySetKey key = reportCopySetInfo.GetCopySetKey();
+    Shard *shard = shards_[GetShardIndex(key)].get();
+    LockGuard lk(shard->mtx);
+    // 在shard锁内检查, Stop通知shard之后不会再有上报入队
+    if (rejectSubmit_.load()) {
+        return false;
+    }
+    auto it = shard->pending.find(key);
+    if (it != shard->pending.end()) {
+        it->second = reportCopySetInfo;
+        return true;
+    }
+    shard->pending.emplace(key, reportCopySetInfo);
+    queueDepth_ << 1;
+    shard->cond.notify_one();
+    return true;
+}
+
+void TopoUpdateDispatcher::Flush(const CopySetKey &key) {
+    ApplyPending(shards_[GetShardIndex(key)].get(), &key);
+}
+
+void TopoUpdateDispatcher::ShardFunc(Shard *shard) {
+    while (true) {
+        {
+            UniqueLock lk(shard->mtx);
+            shard->cond.wait(lk, [&] {
+                return isStop_.load() || !shard->pending.empty();
+            });
+            if (isStop_.load()) {
+                // 剩余的上报由Stop处理
+                return;
+            }
+        }
+
+        uint64_t startUs = TimeUtility::GetTimeofDayUs();
+        uint64_t count = 0;
+        while (!isStop_.load() && ApplyPending(shard, nullptr)) {
+            count++;
+        }
+        batchSize_ << count;
+        batchLatency_ << TimeUtility::GetTimeofDayUs() - startUs;
+    }
+}
+
+bool TopoUpdateDispatcher::ApplyPending(Shard *shard, const CopySetKey *key) {
+    // 持有updateMtx直到更新完成, Flush据此等待正在更新的上报
+    LockGuard updateLk(shard->updateMtx);
+    CopySetInfo reportCopySetInfo;
+    {
+        LockGuard lk(shard->mtx);
+        auto it = key == nullptr ? shard->pending.begin()
+                                 : shard->pending.find(*key);
+        if (it == shard->pending.end()) {
+            return false;
+        }
+        reportCopySetInfo = it->second;
+        shard->pending.erase(it);
+    }
+    queueDepth_ << -1;
+    topoUpdater_->UpdateTopo(reportCopySetInfo);
+    return true;
+}
+
+uint32_t TopoUpdateDispatcher::GetShardIndex(const CopySetKey &key) const {
+    uint64_t hash = (static_cast<uint64_t>(key.first) << 32) | key.second;
+    return hash % shards_.size();
+}
+
+}  // namespace heartbeat
+}  // namespace mds
+}  // namespace curve
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#ifndef SRC_MDS_HEARTBEAT_TOPO_UPDATE_DISPATCHER_H_
+#define SRC_MDS_HEARTBEAT_TOPO_UPDATE_DISPATCHER_H_
+
+#include <bvar/bvar.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "src/mds/heartbeat/topo_updater.h"
+#include "src/common/concurrent/concurrent.h"
+
+using ::curve::mds::topology::CopySetKey;
+
+namespace curve {
+namespace mds {
+namespace heartbeat {
+
+// TopoUpdateDispatcher: 把leader上报的copyset信息分发到多个后台shard批量更新
+// - 按copyset分片，同一copyset的上报总是由同一个shard串行处理
+// - shard中同一copyset尚未处理的上报只保留最新的一份，避免重复更新topology
+// - 同步生成copyset配置前先调用Flush，保证之前的上报已经更新到topology
+class TopoUpdateDispatcher {
+ public:
+    TopoUpdateDispatcher(std::shared_ptr<TopoUpdater> topoUpdater,
+                         uint32_t shardNum);
+
+    ~TopoUpdateDispatcher() {
+        Stop();
+    }
+
+    /*
+    * @brief Start 启动各shard的后台线程
+    */
+    void Start();
+
+    /*
+    * @brief Stop 停止各shard的后台线程, 并把未处理的上报更新到topology,
+    *             停止后不再接受新的上报
+    */
+    void Stop();
+
+    /*
+    * @brief Submit 提交leader上报的copyset信息, 不阻塞心跳处理
+    *
+    * @param[in] reportCopySetInfo chunkserver上报的copyset信息
+    *
+    * @return 已经停止时返回false, 由调用方同步更新
+    */
+    bool Submit(const CopySetInfo &reportCopySetInfo);
+
+    /*
+    * @brief Flush 把该copyset之前提交的上报同步更新到topology,
+    *              正在更新的上报会等待其完成
+    *
+    * @param[in] key copyset的key
+    */
+    void Flush(const CopySetKey &key);
+
+    /*
+    * @brief QueueDepth 获取所有shard中等待处理的copyset数量
+    */
+    int64_t QueueDepth() const {
+        return queueDepth_.get_value();
+    }
+
+ private:
+    struct Shard {
+        // 串行化对topology的更新, 先于mtx获取
+        curve::common::Mutex updateMtx;
+        curve::common::Mutex mtx;
+        curve::common::ConditionVariable cond;
+        // 等待处理的上报, 同一copyset只保留最新的一份
+        std::map<CopySetKey, CopySetInfo> pending;
+        curve::common::Thread worker;
+    };
+
+    void ShardFunc(Shard *shard);
+
+    /*
+    * @brief ApplyPending 从shard中取出一份上报并更新到topology
+    *
+    * @param[in] shard 所属shard
+    * @param[in] key 不为nullptr时只取该copyset的上报
+    *
+    * @return 取到上报时返回true
+    */
+    bool ApplyPending(Shard *shard, const CopySetKey *key);
+
+    uint32_t GetShardIndex(const CopySetKey &key) const;
+
+ private:
+    std::shared_ptr<TopoUpdater> topoUpdater_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    curve::common::Atomic<bool> isStop_;
+    // Stop之后拒绝新的上报
+    curve::common::Atomic<bool> rejectSubmit_;
+
+    // 等待处理的copyset数量
+    bvar::Adder<int64_t> queueDepth_;
+    // 单批次更新的copyset数量
+    bvar::IntRecorder batchSize_;
+    // 单批次更新topology的耗时
+    bvar::LatencyRecorder batchLatency_;
+};
+
+}  // namespace heartbeat
+}  // namespace mds
+}  // namespace curve
+
+#endif  // SRC_MDS_HEARTBEAT_TOPO_UPDATE_DISPATCHER_H_
@@ -22,6 +22,7 @@
 
 #include "src/mds/nameserver2/curvefs.h"
 #include <glog/logging.h>
+#include <algorithm>
 #include <memory>
 #include <chrono>
 #include <set>
@@ -935,6 +936,33 @@ StatusCode CurveFS::ChangeOwner(const std::string &filename,
     return PutFile(fileInfo);
 }
 
+StatusCode CurveFS::UpdateFileThrottleParams(const std::string &filename,
+                                             uint64_t iopsLimit,
+                                             uint64_t bpsLimit) {
+    FileInfo  fileInfo;
+    StatusCode ret = GetFileInfo(filename, &fileInfo);
+    if (ret != StatusCode::kOK) {
+        LOG(INFO) << "get source file error, errCode = " << ret;
+        return  ret;
+    }
+
+    // only INODE_PAGEFILE is opened and throttled by client
+    if (fileInfo.filetype() != FileType::INODE_PAGEFILE) {
+        LOG(ERROR) << "file type not support throttle"
+                   << ", filename = " << filename;
+        return StatusCode::kNotSupported;
+    }
+
+    if (fileInfo.iopslimit() == iopsLimit
+        && fileInfo.bpslimit() == bpsLimit) {
+        return StatusCode::kOK;
+    }
+
+    fileInfo.set_iopslimit(iopsLimit);
+    fileInfo.set_bpslimit(bpsLimit);
+    return PutFile(fileInfo);
+}
+
 StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
         offset_t offset, bool allocateIfNoExist,
         PageFileSegment *segment) {
@@ -1002,6 +1030,54 @@ StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
     }
 }
 
+StatusCode CurveFS::ListSegments(const std::string &filename,
+                                 offset_t startOffset,
+                                 uint32_t limit,
+                                 std::vector<PageFileSegment> *segments,
+                                 offset_t *nextOffset) {
+    assert(segments != nullptr);
+    assert(nextOffset != nullptr);
+
+    FileInfo  fileInfo;
+    auto ret = GetFileInfo(filename, &fileInfo);
+    if (ret != StatusCode::kOK) {
+        LOG(INFO) << "get source file error, errCode = " << ret;
+        return  ret;
+    }
+
+    if (fileInfo.filetype() != FileType::INODE_PAGEFILE) {
+        LOG(INFO) << "not pageFile, can't do this";
+        return StatusCode::kParaError;
+    }
+
+    if (startOffset % fileInfo.segmentsize() != 0) {
+        LOG(INFO) << "offset not align with segment";
+        return StatusCode::kParaError;
+    }
+
+    // 每页只扫描[startOffset, startOffset + limit * segmentsize)范围内的key，
+    // 未分配的segment不占用名额，因此一页返回的segment可能少于limit
+    offset_t endOffset = fileInfo.length();
+    if (limit != 0 && startOffset < endOffset &&
+        (endOffset - startOffset) / fileInfo.segmentsize() > limit) {
+        endOffset = startOffset +
+                    static_cast<offset_t>(limit) * fileInfo.segmentsize();
+    }
+    *nextOffset = endOffset;
+    if (startOffset >= endOffset) {
+        return StatusCode::kOK;
+    }
+
+    auto storeRet = storage_->ListSegment(fileInfo.id(), startOffset,
+                                          endOffset, segments);
+    if (storeRet != StoreStatus::OK) {
+        LOG(ERROR) << "list segment fail, fileInfo.id() = " << fileInfo.id();
+        return StatusCode::kStorageError;
+    }
+
+    return StatusCode::kOK;
+}
+
 StatusCode CurveFS::CreateSnapShotFile(const std::string &fileName,
                                     FileInfo *snapshotFileInfo) {
     FileInfo  parentFileInfo;
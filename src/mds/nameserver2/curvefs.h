@@ -208,6 +208,18 @@ class CurveFS {
     StatusCode ChangeOwner(const std::string &filename,
                            const std::string &newOwner);
 
+    /**
+     *  @brief modify file throttle params, take effect when client refresh
+     *         session next time
+     *  @param fileName
+     *  @param iopsLimit: 0 means unlimited
+     *  @param bpsLimit: 0 means unlimited
+     *  @return StatusCode::kOK if succeeded
+     */
+    StatusCode UpdateFileThrottleParams(const std::string &filename,
+                                        uint64_t iopsLimit,
+                                        uint64_t bpsLimit);
+
     // segment(chunk) ops
 
     /**
@@ -226,6 +238,26 @@ class CurveFS {
         offset_t offset,
         bool allocateIfNoExist, PageFileSegment *segment);
 
+    /**
+     *  @brief list the allocated segments of a file by page, in offset order
+     *
+     *  @param filename
+     *  @param startOffset: list segments whose offset >= startOffset,
+     *                      must be aligned with segment size
+     *  @param limit: max number of segment ranges scanned in one page,
+     *               0 means no limit, unallocated segments are skipped so
+     *               a page may return fewer than limit segments
+     *  @param segments: Return the listed segments
+     *  @param nextOffset: return the startOffset of the next page, or file
+     *                     length if the whole file has been scanned
+     *  @return StatusCode::kOK if succeeded
+     */
+    StatusCode ListSegments(const std::string &filename,
+                            offset_t startOffset,
+                            uint32_t limit,
+                            std::vector<PageFileSegment> *segments,
+                            offset_t *nextOffset);
+
     /**
      *  @brief get the root file info
      *  @param
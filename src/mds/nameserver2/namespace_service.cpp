@@ -355,6 +355,99 @@ void NameSpaceService::GetOrAllocateSegment(
     return;
 }
 
+void NameSpaceService::ListSegments(
+                    ::google::protobuf::RpcController* controller,
+                    const ::curve::mds::ListSegmentsRequest* request,
+                    ::curve::mds::ListSegmentsResponse* response,
+                    ::google::protobuf::Closure* done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(controller);
+    ExpiredTime expiredTime;
+
+    if (!isPathValid(request->filename())) {
+        response->set_statuscode(StatusCode::kParaError);
+        LOG(ERROR) << "logid = " << cntl->log_id()
+            << ", ListSegments request path is invalid, filename = "
+            << request->filename();
+        return;
+    }
+
+    // 单次返回的segment数量有上限，避免大文件的一次响应过大
+    uint32_t limit = request->limit();
+    if (limit == 0 || limit > kMaxListSegmentsLimit) {
+        limit = kMaxListSegmentsLimit;
+    }
+
+    LOG(INFO) << "logid = " << cntl->log_id()
+        << ", ListSegments request, filename = " << request->filename()
+        << ", startOffset = " << request->startoffset()
+        << ", limit = " << limit;
+
+    FileReadLockGuard guard(fileLockManager_, request->filename());
+
+    std::string signature;
+    if (request->has_signature()) {
+        signature = request->signature();
+    }
+
+    StatusCode retCode;
+    retCode = kCurveFS.CheckFileOwner(request->filename(), request->owner(),
+                                      signature, request->date());
+    if (retCode != StatusCode::kOK) {
+        response->set_statuscode(retCode);
+        if (google::ERROR != GetMdsLogLevel(retCode)) {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                << ", CheckFileOwner fail, filename = " <<  request->filename()
+                << ", owner = " << request->owner()
+                << ", statusCode = " << retCode;
+        } else {
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", CheckFileOwner fail, filename = " <<  request->filename()
+                << ", owner = " << request->owner()
+                << ", statusCode = " << retCode;
+        }
+        return;
+    }
+
+    std::vector<PageFileSegment> segments;
+    offset_t nextOffset = 0;
+    retCode = kCurveFS.ListSegments(request->filename(),
+                request->startoffset(), limit, &segments, &nextOffset);
+
+    if (retCode != StatusCode::kOK)  {
+        response->set_statuscode(retCode);
+        if (google::ERROR != GetMdsLogLevel(retCode)) {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                << ", ListSegments fail, filename = " <<  request->filename()
+                << ", startOffset = " << request->startoffset()
+                << ", statusCode = " << retCode
+                << ", StatusCode_Name = " << StatusCode_Name(retCode)
+                << ", cost " << expiredTime.ExpiredMs() << " ms";
+        } else {
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", ListSegments fail, filename = " <<  request->filename()
+                << ", startOffset = " << request->startoffset()
+                << ", statusCode = " << retCode
+                << ", StatusCode_Name = " << StatusCode_Name(retCode)
+                << ", cost " << expiredTime.ExpiredMs() << " ms";
+        }
+        return;
+    }
+
+    for (auto& segment : segments) {
+        response->add_pagefilesegment()->Swap(&segment);
+    }
+    response->set_nextoffset(nextOffset);
+    response->set_statuscode(StatusCode::kOK);
+    LOG(INFO) << "logid = " << cntl->log_id()
+              << ", ListSegments ok, filename = " << request->filename()
+              << ", startOffset = " << request->startoffset()
+              << ", segment num = " << response->pagefilesegment_size()
+              << ", nextOffset = " << nextOffset
+              << ", cost " << expiredTime.ExpiredMs() << " ms";
+    return;
+}
+
 void NameSpaceService::RenameFile(::google::protobuf::RpcController* controller,
                          const ::curve::mds::RenameFileRequest* request,
                          ::curve::mds::RenameFileResponse* response,
@@ -625,6 +718,84 @@ void NameSpaceService::ChangeOwner(
     return;
 }
 
+void NameSpaceService::UpdateFileThrottleParams(
+                ::google::protobuf::RpcController* controller,
+                const ::curve::mds::UpdateFileThrottleParamsRequest* request,
+                ::curve::mds::UpdateFileThrottleParamsResponse* response,
+                ::google::protobuf::Closure* done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(controller);
+    ExpiredTime expiredTime;
+
+    if (!isPathValid(request->filename())) {
+        response->set_statuscode(StatusCode::kParaError);
+        LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", UpdateFileThrottleParams request path is invalid"
+                << ", filename = " << request->filename();
+        return;
+    }
+
+    LOG(INFO) << "logid = " << cntl->log_id()
+              << ", UpdateFileThrottleParams request, filename = "
+              << request->filename()
+              << ", iopsLimit = " << request->iopslimit()
+              << ", bpsLimit = " << request->bpslimit();
+
+    FileWriteLockGuard guard(fileLockManager_, request->filename());
+
+    StatusCode retCode;
+    // interface UpdateFileThrottleParams() is only capable for root user
+    retCode = kCurveFS.CheckRootOwner(request->filename(), request->rootowner(),
+                                      request->signature(), request->date());
+    if (retCode != StatusCode::kOK) {
+        response->set_statuscode(retCode);
+        if (google::ERROR != GetMdsLogLevel(retCode)) {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                << ", CheckFileOwner fail, filename = " <<  request->filename()
+                << ", owner = " << request->rootowner()
+                << ", statusCode = " << retCode;
+        } else {
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", CheckFileOwner fail, filename = " <<  request->filename()
+                << ", owner = " << request->rootowner()
+                << ", statusCode = " << retCode;
+        }
+        return;
+    }
+
+    retCode = kCurveFS.UpdateFileThrottleParams(request->filename(),
+                                                request->iopslimit(),
+                                                request->bpslimit());
+    if (retCode != StatusCode::kOK)  {
+        response->set_statuscode(retCode);
+        if (google::ERROR != GetMdsLogLevel(retCode)) {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                         << ", UpdateFileThrottleParams fail, filename = "
+                         << request->filename()
+                         << ", statusCode = " << retCode
+                         << ", StatusCode_Name = " << StatusCode_Name(retCode)
+                         << ", cost " << expiredTime.ExpiredMs() << " ms";
+        } else {
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                       << ", UpdateFileThrottleParams fail, filename = "
+                       << request->filename()
+                       << ", statusCode = " << retCode
+                       << ", StatusCode_Name = " << StatusCode_Name(retCode)
+                       << ", cost " << expiredTime.ExpiredMs() << " ms";
+        }
+    } else {
+        response->set_statuscode(StatusCode::kOK);
+        LOG(INFO) << "logid = " << cntl->log_id()
+                  << ", UpdateFileThrottleParams ok, filename = "
+                  << request->filename()
+                  << ", iopsLimit = " << request->iopslimit()
+                  << ", bpsLimit = " << request->bpslimit()
+                  << ", cost " << expiredTime.ExpiredMs() << " ms";
+    }
+
+    return;
+}
+
 void NameSpaceService::ListDir(::google::protobuf::RpcController* controller,
                        const ::curve::mds::ListDirRequest* request,
                        ::curve::mds::ListDirResponse* response,
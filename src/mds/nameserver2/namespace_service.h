@@ -91,6 +91,11 @@ class NameSpaceService: public CurveFSService {
                        ::curve::mds::GetOrAllocateSegmentResponse* response,
                        ::google::protobuf::Closure* done) override;
 
+    void ListSegments(::google::protobuf::RpcController* controller,
+                       const ::curve::mds::ListSegmentsRequest* request,
+                       ::curve::mds::ListSegmentsResponse* response,
+                       ::google::protobuf::Closure* done) override;
+
     void RenameFile(::google::protobuf::RpcController* controller,
                        const ::curve::mds::RenameFileRequest* request,
                        ::curve::mds::RenameFileResponse* response,
@@ -106,6 +111,12 @@ class NameSpaceService: public CurveFSService {
                        ::curve::mds::ChangeOwnerResponse* response,
                        ::google::protobuf::Closure* done) override;
 
+    void UpdateFileThrottleParams(
+                ::google::protobuf::RpcController* controller,
+                const ::curve::mds::UpdateFileThrottleParamsRequest* request,
+                ::curve::mds::UpdateFileThrottleParamsResponse* response,
+                ::google::protobuf::Closure* done) override;
+
     void ListDir(::google::protobuf::RpcController* controller,
                        const ::curve::mds::ListDirRequest* request,
                        ::curve::mds::ListDirResponse* response,
@@ -388,6 +388,25 @@ StoreStatus NameServerStorageImp::ListSegment(InodeID id,
     std::string endStoreKey =
                 NameSpaceStorageCodec::EncodeSegmentStoreKey(id + 1, 0);
 
+    return ListSegmentInternal(startStoreKey, endStoreKey, segments);
+}
+
+StoreStatus NameServerStorageImp::ListSegment(InodeID id,
+                                    offset_t startOffset,
+                                    offset_t endOffset,
+                                    std::vector<PageFileSegment> *segments) {
+    // segment key中offset按大端编码，key的顺序与offset顺序一致
+    std::string startStoreKey =
+        NameSpaceStorageCodec::EncodeSegmentStoreKey(id, startOffset);
+    std::string endStoreKey =
+        NameSpaceStorageCodec::EncodeSegmentStoreKey(id, endOffset);
+
+    return ListSegmentInternal(startStoreKey, endStoreKey, segments);
+}
+
+StoreStatus NameServerStorageImp::ListSegmentInternal(
+    const std::string& startStoreKey, const std::string& endStoreKey,
+    std::vector<PageFileSegment> *segments) {
     std::vector<std::string> out;
     int errCode = client_->List(
         startStoreKey, endStoreKey, &out);
@@ -167,6 +167,22 @@ class NameServerStorage {
     virtual StoreStatus ListSegment(InodeID id,
                                     std::vector<PageFileSegment> *segments) = 0;
 
+    /**
+     * @brief ListSegment: Get the segments of file whose start offset is
+     *                     between [startOffset, endOffset), ordered by offset
+     *
+     * @param[in] id: Inode ID of the file
+     * @param[in] startOffset: start offset of the range
+     * @param[in] endOffset: end offset of the range
+     * @param[out] segments: Segment list
+     *
+     * @return StoreStatus: error code
+     */
+    virtual StoreStatus ListSegment(InodeID id,
+                                    offset_t startOffset,
+                                    offset_t endOffset,
+                                    std::vector<PageFileSegment> *segments) = 0;
+
     /**
      * @brief ListSnapshotFile: Get all snapshot files between [startid, endid)
      *
@@ -279,6 +295,11 @@ class NameServerStorageImp : public NameServerStorage {
     StoreStatus ListSegment(InodeID id,
                             std::vector<PageFileSegment> *segments) override;
 
+    StoreStatus ListSegment(InodeID id,
+                            offset_t startOffset,
+                            offset_t endOffset,
+                            std::vector<PageFileSegment> *segments) override;
+
     StoreStatus ListSnapshotFile(InodeID startid,
                         InodeID endid,
                         std::vector<FileInfo> * files) override;
@@ -304,6 +325,9 @@ class NameServerStorageImp : public NameServerStorage {
     StoreStatus ListFileInternal(const std::string& startStoreKey,
                                  const std::string& endStoreKey,
                                  std::vector<FileInfo> *files);
+    StoreStatus ListSegmentInternal(const std::string& startStoreKey,
+                                    const std::string& endStoreKey,
+                                    std::vector<PageFileSegment> *segments);
     StoreStatus GetStoreKey(FileType filetype,
                             InodeID id,
                             const std::string& filename,
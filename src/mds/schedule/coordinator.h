@@ -87,6 +87,13 @@ class Coordinator {
      */
     virtual bool ChunkserverGoingToAdd(ChunkServerIdType csId, CopySetKey key);
 
+    /**
+     * @brief 判断指定copyset上是否有operator
+     *
+     * @param[in] key 指定copyset
+     */
+    virtual bool HasOperator(CopySetKey key);
+
     /**
      * @brief 根据配置初始化scheduler
      *
@@ -570,6 +570,12 @@ void MDS::InitHeartbeatOption(HeartbeatOption* heartbeatOption) {
                         &heartbeatOption->offLineTimeOutMs);
     conf_->GetValueFatalIfFail("mds.heartbeat.clean_follower_afterMs",
                         &heartbeatOption->cleanFollowerAfterMs);
+    if (!conf_->GetUInt32Value("mds.heartbeat.topoUpdateShardNum",
+                        &heartbeatOption->topoUpdateShardNum)) {
+        LOG(WARNING) << "mds.heartbeat.topoUpdateShardNum not found, "
+                     << "update topology in heartbeat rpc thread";
+        heartbeatOption->topoUpdateShardNum = 0;
+    }
 }
 }  // namespace mds
 }  // namespace curve
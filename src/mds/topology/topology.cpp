@@ -23,6 +23,7 @@
 
 #include <glog/logging.h>
 #include <chrono>  //NOLINT
+#include <atomic>
 
 #include "src/common/uuid.h"
 
@@ -32,6 +33,75 @@ namespace curve {
 namespace mds {
 namespace topology {
 
+namespace {
+
+/**
+ * @brief 心跳上报的磁盘状态是否与之前不同
+ *
+ * @param oldState 之前的磁盘状态
+ * @param newState 新上报的磁盘状态
+ *
+ * @return 磁盘状态、容量或使用量任一变化时返回true
+ */
+bool DiskStatusChanged(const ChunkServerState &oldState,
+                       const ChunkServerState &newState) {
+    return oldState.GetDiskState() != newState.GetDiskState() ||
+           oldState.GetDiskCapacity() != newState.GetDiskCapacity() ||
+           oldState.GetDiskUsed() != newState.GetDiskUsed();
+}
+
+/**
+ * @brief 获取map快照，快照过期时在map读锁下重新拷贝一份
+ *
+ * @param cache 缓存的快照
+ * @param version map当前版本号
+ * @param rebuildMutex 重建快照的互斥锁
+ * @param mapMutex map的读写锁
+ * @param map 被快照的map
+ * @param stateVersion 心跳磁盘状态序号，没有时为nullptr
+ *
+ * @return 与version一致或更新的快照
+ */
+template <typename MapType>
+std::shared_ptr<const TopoMapSnapshot<MapType>> LoadOrRebuildSnapshot(
+    std::shared_ptr<const TopoMapSnapshot<MapType>> *cache,
+    const curve::common::Atomic<uint64_t> &version,
+    curve::common::Mutex *rebuildMutex,
+    curve::common::RWLock *mapMutex,
+    const MapType &map,
+    const curve::common::Atomic<uint64_t> *stateVersion = nullptr) {
+    auto snapshot = std::atomic_load(cache);
+    if (snapshot != nullptr && snapshot->version == version.load()) {
+        return snapshot;
+    }
+
+    curve::common::LockGuard guard(*rebuildMutex);
+    // 等锁期间可能已经被其他读者重建
+    snapshot = std::atomic_load(cache);
+    if (snapshot != nullptr && snapshot->version == version.load()) {
+        return snapshot;
+    }
+
+    auto fresh = std::make_shared<TopoMapSnapshot<MapType>>();
+    {
+        ReadLockGuard rlockMap(*mapMutex);
+        // 先取版本号再拷贝，保证快照内容不旧于其版本号
+        fresh->version = version.load();
+        if (stateVersion != nullptr) {
+            fresh->stateVersion = stateVersion->load();
+        }
+        for (const auto &pair : map) {
+            ReadLockGuard rlockItem(pair.second.GetRWLockRef());
+            fresh->items[pair.first] = pair.second;
+        }
+    }
+    snapshot = fresh;
+    std::atomic_store(cache, snapshot);
+    return snapshot;
+}
+
+}  // namespace
+
 PoolIdType TopologyImpl::AllocateLogicalPoolId() {
     return idGenerator_->GenLogicalPoolId();
 }
@@ -150,6 +220,7 @@ int TopologyImpl::AddChunkServer(const ChunkServer &data) {
                 }
                 it->second.AddChunkServer(data.GetId());
                 chunkServerMap_[data.GetId()] = data;
+                chunkServerVersion_++;
                 csCapacity = data.GetChunkServerState().GetDiskCapacity();
             } else {
                 return kTopoErrCodeIdDuplicated;
@@ -261,6 +332,11 @@ int TopologyImpl::RemoveChunkServer(ChunkServerIdType id) {
             ix->second.RemoveChunkServer(id);
         }
         chunkServerMap_.erase(it);
+        chunkServerVersion_++;
+        {
+            curve::common::LockGuard guard(pendingDiskStateMutex_);
+            pendingDiskStates_.erase(id);
+        }
         return kTopoErrCodeSuccess;
     } else {
         return kTopoErrCodeChunkServerNotFound;
@@ -338,6 +414,7 @@ int TopologyImpl::UpdateChunkServerTopo(const ChunkServer &data) {
         }
         it->second = temp;
         it->second.SetDirtyFlag(false);
+        chunkServerVersion_++;
         return kTopoErrCodeSuccess;
     } else {
         return kTopoErrCodeChunkServerNotFound;
@@ -368,6 +445,7 @@ int TopologyImpl::UpdateChunkServerRwState(const ChunkServerStatus &rwState,
             csCapacity = it->second.GetChunkServerState().GetDiskCapacity();
             it->second.SetStatus(rwState);
             it->second.SetDirtyFlag(true);
+            chunkServerVersion_++;
         }
     }
     // 更新物理池
@@ -446,7 +524,10 @@ int TopologyImpl::UpdateChunkServerOnlineState(const OnlineState &onlineState,
     auto it = chunkServerMap_.find(id);
     if (it != chunkServerMap_.end()) {
         WriteLockGuard wlockChunkServer(it->second.GetRWLockRef());
-        it->second.SetOnlineState(onlineState);
+        if (it->second.GetOnlineState() != onlineState) {
+            it->second.SetOnlineState(onlineState);
+            chunkServerVersion_++;
+        }
         it->second.SetDirtyFlag(true);
         return kTopoErrCodeSuccess;
     } else {
@@ -473,9 +554,16 @@ int TopologyImpl::UpdateChunkServerDiskStatus(const ChunkServerState &state,
             WriteLockGuard wlockChunkServer(it->second.GetRWLockRef());
             diff = state.GetDiskCapacity() -
                 it->second.GetChunkServerState().GetDiskCapacity();
-            // 心跳数据，只更新内存，后台定期刷入数据库
-            it->second.SetChunkServerState(state);
-            it->second.SetDirtyFlag(true);
+            if (DiskStatusChanged(
+                    it->second.GetChunkServerState(), state)) {
+                // 心跳数据，只更新内存并置脏，后台定期批量刷入数据库
+                it->second.SetChunkServerState(state);
+                it->second.SetDirtyFlag(true);
+                // 不重建快照，暂存起来由读者批量合入
+                curve::common::LockGuard guard(pendingDiskStateMutex_);
+                uint64_t seq = ++chunkServerStateVersion_;
+                pendingDiskStates_[id] = PendingDiskState{seq, state};
+            }
         } else {
             return kTopoErrCodeChunkServerNotFound;
         }
@@ -499,6 +587,7 @@ int TopologyImpl::UpdateChunkServerStartUpTime(uint64_t time,
     if (it != chunkServerMap_.end()) {
         WriteLockGuard wlockChunkServer(it->second.GetRWLockRef());
         it->second.SetStartUpTime(time);
+        chunkServerVersion_++;
         return kTopoErrCodeSuccess;
     } else {
         return kTopoErrCodeChunkServerNotFound;
@@ -662,13 +751,10 @@ bool TopologyImpl::GetChunkServer(ChunkServerIdType chunkserverId,
 std::vector<ChunkServerIdType> TopologyImpl::GetChunkServerInCluster(
     ChunkServerFilter filter) const {
     std::vector<ChunkServerIdType> ret;
-    ReadLockGuard rlockChunkServerMap(chunkServerMutex_);
-    for (auto it = chunkServerMap_.begin();
-         it != chunkServerMap_.end();
-         it++) {
-        ReadLockGuard rlockChunkServer(it->second.GetRWLockRef());
-        if (filter(it->second)) {
-            ret.push_back(it->first);
+    auto snapshot = GetChunkServerSnapshot();
+    for (const auto &pair : snapshot->items) {
+        if (filter(pair.second)) {
+            ret.push_back(pair.first);
         }
     }
     return ret;
@@ -730,13 +816,10 @@ std::list<ChunkServerIdType> TopologyImpl::GetChunkServerInServer(
     ServerIdType id,
     ChunkServerFilter filter) const {
     std::list<ChunkServerIdType> ret;
-    ReadLockGuard rlockChunkServerMap(chunkServerMutex_);
-    for (auto it = chunkServerMap_.begin();
-         it != chunkServerMap_.end();
-         it++) {
-        ReadLockGuard rlockChunkServer(it->second.GetRWLockRef());
-        if (filter(it->second) && it->second.GetServerId() == id) {
-            ret.push_back(it->first);
+    auto snapshot = GetChunkServerSnapshot();
+    for (const auto &pair : snapshot->items) {
+        if (filter(pair.second) && pair.second.GetServerId() == id) {
+            ret.push_back(pair.first);
         }
     }
     return ret;
@@ -973,6 +1056,9 @@ int TopologyImpl::Init(const TopologyOption &option) {
     }
     LOG(INFO) << "Clean Invalid LogicalPool and copyset success.";
 
+    chunkServerVersion_++;
+    copySetVersion_++;
+
     return kTopoErrCodeSuccess;
 }
 
@@ -1023,6 +1109,7 @@ int TopologyImpl::AddCopySet(const CopySetInfo &data) {
                 return kTopoErrCodeStorgeFail;
             }
             copySetMap_[key] = data;
+            copySetVersion_++;
             return kTopoErrCodeSuccess;
         } else {
             return kTopoErrCodeIdDuplicated;
@@ -1040,6 +1127,7 @@ int TopologyImpl::RemoveCopySet(CopySetKey key) {
             return kTopoErrCodeStorgeFail;
         }
         copySetMap_.erase(key);
+        copySetVersion_++;
         return kTopoErrCodeSuccess;
     } else {
         return kTopoErrCodeCopySetNotFound;
@@ -1061,6 +1149,7 @@ int TopologyImpl::UpdateCopySetTopo(const CopySetInfo &data) {
             it->second.ClearCandidate();
         }
         it->second.SetDirtyFlag(true);
+        copySetVersion_++;
         return kTopoErrCodeSuccess;
     } else {
         LOG(WARNING) << "UpdateCopySetTopo can not find copyset, "
@@ -1086,8 +1175,8 @@ std::vector<CopySetIdType> TopologyImpl::GetCopySetsInLogicalPool(
     PoolIdType logicalPoolId,
     CopySetFilter filter) const {
     std::vector<CopySetIdType> ret;
-    ReadLockGuard rlockCopySet(copySetMutex_);
-    for (auto it : copySetMap_) {
+    auto snapshot = GetCopySetSnapshot();
+    for (const auto &it : snapshot->items) {
         if (filter(it.second) && it.first.first == logicalPoolId) {
             ret.push_back(it.first.second);
         }
@@ -1099,8 +1188,8 @@ std::vector<CopySetInfo> TopologyImpl::GetCopySetInfosInLogicalPool(
     PoolIdType logicalPoolId,
     CopySetFilter filter) const {
     std::vector<CopySetInfo> ret;
-    ReadLockGuard rlockCopySet(copySetMutex_);
-    for (auto it : copySetMap_) {
+    auto snapshot = GetCopySetSnapshot();
+    for (const auto &it : snapshot->items) {
         if (filter(it.second) && it.first.first == logicalPoolId) {
             ret.push_back(it.second);
         }
@@ -1111,8 +1200,8 @@ std::vector<CopySetInfo> TopologyImpl::GetCopySetInfosInLogicalPool(
 std::vector<CopySetKey> TopologyImpl::GetCopySetsInCluster(
     CopySetFilter filter) const {
     std::vector<CopySetKey> ret;
-    ReadLockGuard rlockCopySet(copySetMutex_);
-    for (auto it : copySetMap_) {
+    auto snapshot = GetCopySetSnapshot();
+    for (const auto &it : snapshot->items) {
         if (filter(it.second)) {
             ret.push_back(it.first);
         }
@@ -1124,8 +1213,8 @@ std::vector<CopySetKey> TopologyImpl::GetCopySetsInChunkServer(
     ChunkServerIdType id,
     CopySetFilter filter) const {
     std::vector<CopySetKey> ret;
-    ReadLockGuard rlockCopySet(copySetMutex_);
-    for (auto it : copySetMap_) {
+    auto snapshot = GetCopySetSnapshot();
+    for (const auto &it : snapshot->items) {
         if (filter(it.second) && it.second.GetCopySetMembers().count(id) > 0) {
             ret.push_back(it.first);
         }
@@ -1133,6 +1222,63 @@ std::vector<CopySetKey> TopologyImpl::GetCopySetsInChunkServer(
     return ret;
 }
 
+std::shared_ptr<const ChunkServerMapSnapshot>
+    TopologyImpl::GetChunkServerSnapshot() const {
+    auto snapshot = LoadOrRebuildSnapshot(&chunkServerSnapshot_,
+                                          chunkServerVersion_,
+                                          &chunkServerSnapshotMutex_,
+                                          &chunkServerMutex_,
+                                          chunkServerMap_,
+                                          &chunkServerStateVersion_);
+    if (snapshot->stateVersion == chunkServerStateVersion_.load()) {
+        return snapshot;
+    }
+    return MergePendingDiskStates(snapshot);
+}
+
+std::shared_ptr<const ChunkServerMapSnapshot>
+    TopologyImpl::MergePendingDiskStates(
+    std::shared_ptr<const ChunkServerMapSnapshot> snapshot) const {
+    curve::common::LockGuard guard(chunkServerSnapshotMutex_);
+    // 等锁期间可能已经被其他读者合入或重建
+    auto current = std::atomic_load(&chunkServerSnapshot_);
+    if (current->version >= snapshot->version) {
+        snapshot = current;
+    }
+    if (snapshot->stateVersion == chunkServerStateVersion_.load()) {
+        return snapshot;
+    }
+
+    // 只拷贝快照，不加map锁和chunkserver锁，
+    // 两次读取之间的所有心跳磁盘状态一次合入
+    auto fresh = std::make_shared<ChunkServerMapSnapshot>(*snapshot);
+    {
+        curve::common::LockGuard pendingGuard(pendingDiskStateMutex_);
+        fresh->stateVersion = chunkServerStateVersion_.load();
+        for (const auto &pair : pendingDiskStates_) {
+            if (pair.second.seq <= snapshot->stateVersion) {
+                continue;
+            }
+            auto it = fresh->items.find(pair.first);
+            if (it != fresh->items.end()) {
+                it->second.SetChunkServerState(pair.second.state);
+            }
+        }
+    }
+    std::shared_ptr<const ChunkServerMapSnapshot> merged = fresh;
+    std::atomic_store(&chunkServerSnapshot_, merged);
+    return merged;
+}
+
+std::shared_ptr<const CopySetMapSnapshot>
+    TopologyImpl::GetCopySetSnapshot() const {
+    return LoadOrRebuildSnapshot(&copySetSnapshot_,
+                                 copySetVersion_,
+                                 &copySetSnapshotMutex_,
+                                 &copySetMutex_,
+                                 copySetMap_);
+}
+
 int TopologyImpl::Run() {
     if (isStop_.exchange(false)) {
         backEndThread_ = curve::common::Thread(
@@ -55,6 +55,26 @@ using PhysicalPoolFilter = std::function<bool (const PhysicalPool&)>;
 using LogicalPoolFilter = std::function<bool(const LogicalPool&)>;
 using CopySetFilter = std::function<bool (const CopySetInfo&)>;
 
+/**
+ * @brief topology map的只读快照
+ * @detail
+ * - 快照生成后不再修改，读者持有shared_ptr即可无锁遍历
+ * - version为生成快照时map的版本号，map每次变更版本号加一，
+ *   读者发现版本号不一致时重新生成快照
+ * - stateVersion为已合入的心跳磁盘状态序号，仅chunkserver快照使用
+ */
+template <typename MapType>
+struct TopoMapSnapshot {
+    uint64_t version = 0;
+    uint64_t stateVersion = 0;
+    MapType items;
+};
+
+using ChunkServerMap = std::unordered_map<ChunkServerIdType, ChunkServer>;
+using CopySetMap = std::map<CopySetKey, CopySetInfo>;
+using ChunkServerMapSnapshot = TopoMapSnapshot<ChunkServerMap>;
+using CopySetMapSnapshot = TopoMapSnapshot<CopySetMap>;
+
 class Topology {
  public:
     Topology() {}
@@ -315,6 +335,9 @@ class TopologyImpl : public Topology {
         : idGenerator_(idGenerator),
           tokenGenerator_(tokenGenerator),
           storage_(storage),
+          chunkServerVersion_(1),
+          copySetVersion_(1),
+          chunkServerStateVersion_(0),
           isStop_(true) {
     }
 
@@ -538,6 +561,26 @@ class TopologyImpl : public Topology {
     int GetBelongPhysicalPoolIdByServerId(ServerIdType serverId,
         PoolIdType *physicalPoolIdOut);
 
+    /**
+     * @brief 获取chunkserver map的只读快照
+     * @detail
+     * - 快照与当前map版本一致时直接返回，不加map锁
+     * - 版本不一致时重新生成，并发读者共享同一次重建
+     * - 心跳上报的磁盘状态不触发重建，而是在读取时批量合入快照，
+     *   保证快照中的磁盘状态与内存一致
+     *
+     * @return chunkserver快照
+     */
+    std::shared_ptr<const ChunkServerMapSnapshot>
+        GetChunkServerSnapshot() const;
+
+    /**
+     * @brief 获取copyset map的只读快照
+     *
+     * @return copyset快照
+     */
+    std::shared_ptr<const CopySetMapSnapshot> GetCopySetSnapshot() const;
+
  private:
     int LoadClusterInfo();
 
@@ -551,14 +594,49 @@ class TopologyImpl : public Topology {
 
     void SetChunkServerExternalIp();
 
+    /**
+     * @brief 将暂存的心跳磁盘状态合入chunkserver快照
+     *
+     * @param snapshot 当前版本的chunkserver快照
+     *
+     * @return 已合入全部磁盘状态的快照
+     */
+    std::shared_ptr<const ChunkServerMapSnapshot> MergePendingDiskStates(
+        std::shared_ptr<const ChunkServerMapSnapshot> snapshot) const;
+
  private:
+    // 心跳上报的磁盘状态，seq为写入时的chunkServerStateVersion_
+    struct PendingDiskState {
+        uint64_t seq;
+        ChunkServerState state;
+    };
+
     std::unordered_map<PoolIdType, LogicalPool> logicalPoolMap_;
     std::unordered_map<PoolIdType, PhysicalPool> physicalPoolMap_;
     std::unordered_map<ZoneIdType, Zone> zoneMap_;
     std::unordered_map<ServerIdType, Server> serverMap_;
-    std::unordered_map<ChunkServerIdType, ChunkServer> chunkServerMap_;
+    ChunkServerMap chunkServerMap_;
+
+    CopySetMap copySetMap_;
+
+    // map版本号，map或其中元素变更后加一，用于判断快照是否过期
+    curve::common::Atomic<uint64_t> chunkServerVersion_;
+    curve::common::Atomic<uint64_t> copySetVersion_;
+
+    // 心跳磁盘状态序号及暂存的磁盘状态，每个chunkserver只保留最新一份，
+    // 读快照时合入序号大于快照stateVersion的部分
+    curve::common::Atomic<uint64_t> chunkServerStateVersion_;
+    std::unordered_map<ChunkServerIdType, PendingDiskState>
+        pendingDiskStates_;
+    mutable curve::common::Mutex pendingDiskStateMutex_;
+
+    // 最近一次生成的快照，通过std::atomic_load/atomic_store访问
+    mutable std::shared_ptr<const ChunkServerMapSnapshot> chunkServerSnapshot_;
+    mutable std::shared_ptr<const CopySetMapSnapshot> copySetSnapshot_;
 
-    std::map<CopySetKey, CopySetInfo> copySetMap_;
+    // 串行化快照重建，避免并发读者重复拷贝map
+    mutable curve::common::Mutex chunkServerSnapshotMutex_;
+    mutable curve::common::Mutex copySetSnapshotMutex_;
 
     // 集群信息
     ClusterInformation clusterInfo;
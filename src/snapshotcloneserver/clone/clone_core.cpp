@@ -26,6 +26,8 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <map>
+#include <algorithm>
 
 #include "src/snapshotcloneserver/clone/clone_task.h"
 #include "src/common/location_operator.h"
@@ -866,12 +868,6 @@ int CloneCoreImpl::RecoverChunk(
     int ret = kErrCodeSuccess;
     uint32_t chunkSize = fInfo.chunksize;
 
-    uint32_t totalProgress =
-        kProgressRecoverChunkEnd - kProgressRecoverChunkBegin;
-    uint32_t segNum = segInfos.size();
-    double progressPerData = static_cast<double>(totalProgress) / segNum;
-    uint32_t index = 0;
-
     if (0 == cloneChunkSplitSize_ ||
         chunkSize % cloneChunkSplitSize_ != 0) {
         LOG(ERROR) << "chunk is not align to cloneChunkSplitSize"
@@ -879,29 +875,67 @@ int CloneCoreImpl::RecoverChunk(
         return kErrCodeChunkSizeNotAligned;
     }
 
-    auto tracker = std::make_shared<RecoverChunkTaskTracker>();
-    uint64_t workingChunkNum = 0;
-    // 为避免发往同一个chunk碰撞，异步请求不同的chunk
+    RecoverChunkSchedulerOption schedulerOption;
+    schedulerOption.initConcurrency = recoverChunkConcurrency_;
+    schedulerOption.maxConcurrency = recoverChunkMaxConcurrency_;
+    schedulerOption.concurrencyPerCopyset = recoverChunkConcurrencyPerCopyset_;
+    schedulerOption.latencyTargetMs = recoverChunkLatencyTargetMs_;
+    RecoverChunkScheduler scheduler(schedulerOption);
+
+    RecoverChunkStat stat;
+    // 需要跳过已写完的chunk时，按copyset分组批量查询chunk状态
+    std::map<uint64_t, std::vector<ChunkIDInfo>> copysetChunks;
     for (auto & cloneSegmentInfo : segInfos) {
         for (auto & cloneChunkInfo : cloneSegmentInfo.second) {
             if (!cloneChunkInfo.second.needRecover) {
                 continue;
             }
-            // 当前并发工作的chunk数已大于要求的并发数时，先消化一部分
-            while (workingChunkNum >= recoverChunkConcurrency_) {
-                uint64_t completeChunkNum = 0;
-                ret = ContinueAsyncRecoverChunkPartAndWaitSomeChunkEnd(task,
-                    tracker,
-                    &completeChunkNum);
-                if (ret < 0) {
-                    return kErrCodeInternalError;
+            const ChunkIDInfo &cidInfo = cloneChunkInfo.second.chunkIdInfo;
+            if (recoverSkipWrittenChunk_) {
+                uint64_t copysetKey =
+                    (static_cast<uint64_t>(cidInfo.lpid_) << 32) |
+                    cidInfo.cpid_;
+                copysetChunks[copysetKey].push_back(cidInfo);
+            } else {
+                scheduler.AddChunk(cidInfo);
+            }
+            stat.totalChunkNum++;
+        }
+    }
+    for (auto &copysetChunk : copysetChunks) {
+        auto &chunks = copysetChunk.second;
+        for (size_t begin = 0; begin < chunks.size();
+            begin += kGetChunksInfoBatchSize) {
+            size_t end = std::min(chunks.size(),
+                begin + kGetChunksInfoBatchSize);
+            std::vector<ChunkIDInfo> cidInfos(chunks.begin() + begin,
+                                              chunks.begin() + end);
+            std::vector<bool> written;
+            GetChunksWritten(cidInfos, &written);
+            for (size_t k = 0; k < cidInfos.size(); k++) {
+                if (written[k]) {
+                    stat.skippedChunkNum++;
+                } else {
+                    scheduler.AddChunk(cidInfos[k]);
                 }
-                workingChunkNum -= completeChunkNum;
             }
-            // 加入新的工作的chunk
-            workingChunkNum++;
+        }
+    }
+    if (stat.skippedChunkNum > 0) {
+        LOG(INFO) << "RecoverChunk skip written chunks"
+                  << ", num = " << stat.skippedChunkNum
+                  << ", taskid = " << task->GetTaskId();
+    }
+
+    auto tracker = std::make_shared<RecoverChunkTaskTracker>();
+    uint64_t beginTime = TimeUtility::GetTimeofDaySec();
+    // 待恢复的chunk按copyset轮询下发，使请求分散到不同的chunkserver上，
+    // 并发数由scheduler根据分片延迟调整
+    while (scheduler.GetPendingNum() > 0 || scheduler.GetWorkingNum() > 0) {
+        ChunkIDInfo cidInfo;
+        while (scheduler.PopChunk(&cidInfo)) {
             auto context = std::make_shared<RecoverChunkContext>();
-            context->cidInfo = cloneChunkInfo.second.chunkIdInfo;
+            context->cidInfo = cidInfo;
             context->totalPartNum = chunkSize / cloneChunkSplitSize_;
             context->partIndex = 0;
             context->partSize = cloneChunkSplitSize_;
@@ -923,23 +957,44 @@ int CloneCoreImpl::RecoverChunk(
                 return kErrCodeInternalError;
             }
         }
-        task->SetProgress(static_cast<uint32_t>(
-            kProgressRecoverChunkBegin + index * progressPerData));
-        task->UpdateMetric();
-        index++;
-    }
 
-    while (workingChunkNum > 0) {
-        uint64_t completeChunkNum = 0;
-        ret = ContinueAsyncRecoverChunkPartAndWaitSomeChunkEnd(task,
-            tracker,
-            &completeChunkNum);
-        if (ret < 0) {
-            return kErrCodeInternalError;
+        if (scheduler.GetWorkingNum() > 0) {
+            uint64_t completeChunkNum = 0;
+            ret = ContinueAsyncRecoverChunkPartAndWaitSomeChunkEnd(task,
+                tracker,
+                &scheduler,
+                &completeChunkNum);
+            if (ret < 0) {
+                return kErrCodeInternalError;
+            }
+            stat.recoveredChunkNum += completeChunkNum;
+        }
+
+        stat.recoveredBytes = stat.recoveredChunkNum * chunkSize;
+        stat.concurrency = scheduler.GetConcurrency();
+        uint64_t elapsed = TimeUtility::GetTimeofDaySec() - beginTime;
+        if (elapsed > 0) {
+            stat.throughputBps = stat.recoveredBytes / elapsed;
+        }
+        uint64_t remainChunkNum =
+            scheduler.GetPendingNum() + scheduler.GetWorkingNum();
+        if (stat.throughputBps > 0) {
+            stat.etaSec = remainChunkNum * chunkSize / stat.throughputBps;
         }
-        workingChunkNum -= completeChunkNum;
+        task->SetRecoverStat(stat);
+        uint64_t doneChunkNum = stat.recoveredChunkNum + stat.skippedChunkNum;
+        task->SetProgress(static_cast<uint32_t>(kProgressRecoverChunkBegin +
+            (kProgressRecoverChunkEnd - kProgressRecoverChunkBegin) *
+            doneChunkNum / stat.totalChunkNum));
+        task->UpdateMetric();
     }
 
+    LOG(INFO) << "RecoverChunk finish"
+              << ", total = " << stat.totalChunkNum
+              << ", recovered = " << stat.recoveredChunkNum
+              << ", skipped = " << stat.skippedChunkNum
+              << ", taskid = " << task->GetTaskId();
+
     task->GetCloneInfo().SetNextStep(CloneStep::kCompleteCloneFile);
     ret = metaStore_->UpdateCloneInfo(task->GetCloneInfo());
     if (ret < 0) {
@@ -951,6 +1006,27 @@ int CloneCoreImpl::RecoverChunk(
     return kErrCodeSuccess;
 }
 
+void CloneCoreImpl::GetChunksWritten(
+    const std::vector<ChunkIDInfo> &cidInfos,
+    std::vector<bool> *written) {
+    // chunk的数据全部写入后chunkserver会将其转为普通chunk，
+    // 查询失败时不跳过，按正常流程恢复
+    written->assign(cidInfos.size(), false);
+    std::vector<ChunkInfoDetail> chunkInfos;
+    int ret = client_->GetChunksInfo(cidInfos, &chunkInfos);
+    if (ret != LIBCURVE_ERROR::OK || chunkInfos.size() != cidInfos.size()) {
+        LOG(WARNING) << "GetChunksInfo fail, ret = " << ret
+                     << ", logicalPoolId = " << cidInfos[0].lpid_
+                     << ", copysetId = " << cidInfos[0].cpid_
+                     << ", chunk num = " << cidInfos.size();
+        return;
+    }
+    for (size_t i = 0; i < chunkInfos.size(); i++) {
+        (*written)[i] =
+            !chunkInfos[i].chunkSn.empty() && !chunkInfos[i].isClone;
+    }
+}
+
 int CloneCoreImpl::StartAsyncRecoverChunkPart(
     std::shared_ptr<CloneTaskInfo> task,
     std::shared_ptr<RecoverChunkTaskTracker> tracker,
@@ -958,6 +1034,7 @@ int CloneCoreImpl::StartAsyncRecoverChunkPart(
     RecoverChunkClosure *cb = new RecoverChunkClosure(tracker, context);
     tracker->AddOneTrace();
     uint64_t offset = context->partIndex * context->partSize;
+    context->partStartTimeUs = TimeUtility::GetTimeofDayUs();
     LOG_EVERY_SECOND(INFO) << "Doing RecoverChunk"
                << ", logicalPoolId = "
                << context->cidInfo.lpid_
@@ -988,12 +1065,16 @@ int CloneCoreImpl::StartAsyncRecoverChunkPart(
 int CloneCoreImpl::ContinueAsyncRecoverChunkPartAndWaitSomeChunkEnd(
     std::shared_ptr<CloneTaskInfo> task,
     std::shared_ptr<RecoverChunkTaskTracker> tracker,
+    RecoverChunkScheduler *scheduler,
     uint64_t *completeChunkNum) {
     *completeChunkNum = 0;
     tracker->WaitSome(1);
     std::list<RecoverChunkContextPtr> results =
         tracker->PopResultContexts();
     for (auto context : results) {
+        scheduler->OnPartDone(
+            TimeUtility::GetTimeofDayUs() - context->partStartTimeUs,
+            context->retCode == LIBCURVE_ERROR::OK);
         if (context->retCode != LIBCURVE_ERROR::OK) {
             uint64_t nowTime = TimeUtility::GetTimeofDaySec();
             if (nowTime - context->startTime <
@@ -1029,6 +1110,7 @@ int CloneCoreImpl::ContinueAsyncRecoverChunkPartAndWaitSomeChunkEnd(
                            << ", chunkId = " << context->cidInfo.cid_
                            << ", len = " << context->partSize
                            << ", taskid = " << task->GetTaskId();
+                scheduler->OnChunkDone(context->cidInfo);
                 (*completeChunkNum)++;
             }
         }
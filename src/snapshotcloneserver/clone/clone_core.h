@@ -35,6 +35,7 @@
 #include "src/snapshotcloneserver/snapshot/snapshot_data_store.h"
 #include "src/snapshotcloneserver/common/snapshot_reference.h"
 #include "src/snapshotcloneserver/clone/clone_reference.h"
+#include "src/snapshotcloneserver/clone/recover_chunk_scheduler.h"
 #include "src/snapshotcloneserver/common/thread_pool.h"
 #include "src/common/concurrent/name_lock.h"
 
@@ -216,6 +217,11 @@ class CloneCoreImpl : public CloneCore {
         mdsRootUser_(option.mdsRootUser),
         createCloneChunkConcurrency_(option.createCloneChunkConcurrency),
         recoverChunkConcurrency_(option.recoverChunkConcurrency),
+        recoverChunkMaxConcurrency_(option.recoverChunkMaxConcurrency),
+        recoverChunkConcurrencyPerCopyset_(
+            option.recoverChunkConcurrencyPerCopyset),
+        recoverChunkLatencyTargetMs_(option.recoverChunkLatencyTargetMs),
+        recoverSkipWrittenChunk_(option.recoverSkipWrittenChunk),
         clientAsyncMethodRetryTimeSec_(option.clientAsyncMethodRetryTimeSec),
         clientAsyncMethodRetryIntervalMs_(
             option.clientAsyncMethodRetryIntervalMs) {}
@@ -445,6 +451,7 @@ class CloneCoreImpl : public CloneCore {
      *
      * @param task 任务信息
      * @param tracker RecoverChunk异步任务跟踪者
+     * @param scheduler RecoverChunk调度器，用于反馈分片延迟和释放并发
      * @param[out] completeChunkNum 完成的chunk数
      *
      * @return 错误码
@@ -452,8 +459,19 @@ class CloneCoreImpl : public CloneCore {
     int ContinueAsyncRecoverChunkPartAndWaitSomeChunkEnd(
         std::shared_ptr<CloneTaskInfo> task,
         std::shared_ptr<RecoverChunkTaskTracker> tracker,
+        RecoverChunkScheduler *scheduler,
         uint64_t *completeChunkNum);
 
+    /**
+     * @brief 批量查询chunk的数据是否已全部写入，即chunk已不是clone chunk
+     *
+     * @param cidInfos chunk信息，必须属于同一个copyset
+     * @param[out] written 与cidInfos一一对应，true表示已全部写入，
+     *             无需RecoverChunk；查询失败时均为false
+     */
+    void GetChunksWritten(const std::vector<ChunkIDInfo> &cidInfos,
+        std::vector<bool> *written);
+
     /**
      * @brief 修改克隆文件的owner
      *
@@ -571,6 +589,14 @@ class CloneCoreImpl : public CloneCore {
     uint32_t createCloneChunkConcurrency_;
     // RecoverChunk同时进行的异步请求数量
     uint32_t recoverChunkConcurrency_;
+    // RecoverChunk并发数自适应调整的上限
+    uint32_t recoverChunkMaxConcurrency_;
+    // 每个copyset上同时进行RecoverChunk的chunk数上限
+    uint32_t recoverChunkConcurrencyPerCopyset_;
+    // RecoverChunk分片的目标延迟
+    uint32_t recoverChunkLatencyTargetMs_;
+    // RecoverChunk前是否跳过数据已全部写入的chunk
+    bool recoverSkipWrittenChunk_;
     // client异步请求重试时间
     uint64_t clientAsyncMethodRetryTimeSec_;
     // 调用client异步方法重试时间间隔
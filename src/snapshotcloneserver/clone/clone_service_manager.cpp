@@ -327,6 +327,8 @@ int CloneServiceManager::GetCloneTaskInfoInner(
                     if (task != nullptr) {
                         info->emplace_back(cloneInfo,
                             task->GetTaskInfo()->GetProgress());
+                        info->back().SetRecoverStat(
+                            task->GetTaskInfo()->GetRecoverStat());
                     } else {
                         TaskCloneInfo tcInfo;
                         ret = GetFinishedCloneTask(taskId, &tcInfo);
@@ -378,6 +380,8 @@ int CloneServiceManager::GetCloneTaskInfoInner(
                     if (task != nullptr) {
                         info->emplace_back(cloneInfo,
                             task->GetTaskInfo()->GetProgress());
+                        info->back().SetRecoverStat(
+                            task->GetTaskInfo()->GetRecoverStat());
                     } else {
                         TaskCloneInfo tcInfo;
                         ret = GetFinishedCloneTask(taskId, &tcInfo);
@@ -61,6 +61,14 @@ class TaskCloneInfo {
         return cloneProgress_;
     }
 
+    void SetRecoverStat(const RecoverChunkStat &stat) {
+        recoverStat_ = stat;
+    }
+
+    RecoverChunkStat GetRecoverStat() const {
+        return recoverStat_;
+    }
+
     Json::Value ToJsonObj() const {
         Json::Value cloneTaskObj;
         CloneInfo info = GetCloneInfo();
@@ -77,6 +85,17 @@ class TaskCloneInfo {
         cloneTaskObj["Time"] = info.GetTime();
         cloneTaskObj["Progress"] = GetCloneProgress();
         cloneTaskObj["FileType"] = static_cast<int> (info.GetFileType());
+        // 仅在RecoverChunk阶段有统计信息
+        if (recoverStat_.totalChunkNum > 0) {
+            Json::Value statObj;
+            statObj["TotalChunk"] = recoverStat_.totalChunkNum;
+            statObj["RecoveredChunk"] = recoverStat_.recoveredChunkNum;
+            statObj["SkippedChunk"] = recoverStat_.skippedChunkNum;
+            statObj["ThroughputBps"] = recoverStat_.throughputBps;
+            statObj["EtaSec"] = recoverStat_.etaSec;
+            statObj["Concurrency"] = recoverStat_.concurrency;
+            cloneTaskObj["RecoverStat"] = statObj;
+        }
         return cloneTaskObj;
     }
 
@@ -96,11 +115,23 @@ class TaskCloneInfo {
         info.SetFileType(static_cast<CloneFileType>(
             jsonObj["FileType"].asInt()));
         SetCloneInfo(info);
+        if (jsonObj.isMember("RecoverStat")) {
+            const Json::Value &statObj = jsonObj["RecoverStat"];
+            RecoverChunkStat stat;
+            stat.totalChunkNum = statObj["TotalChunk"].asUInt64();
+            stat.recoveredChunkNum = statObj["RecoveredChunk"].asUInt64();
+            stat.skippedChunkNum = statObj["SkippedChunk"].asUInt64();
+            stat.throughputBps = statObj["ThroughputBps"].asUInt64();
+            stat.etaSec = statObj["EtaSec"].asUInt64();
+            stat.concurrency = statObj["Concurrency"].asUInt();
+            SetRecoverStat(stat);
+        }
     }
 
  private:
      CloneInfo cloneInfo_;
      uint32_t cloneProgress_;
+     RecoverChunkStat recoverStat_;
 };
 
 class CloneFilterCondition {
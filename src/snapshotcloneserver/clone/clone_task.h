@@ -25,6 +25,7 @@
 
 #include <string>
 #include <memory>
+#include <mutex>  // NOLINT
 
 #include "src/snapshotcloneserver/clone/clone_core.h"
 #include "src/snapshotcloneserver/common/define.h"
@@ -37,6 +38,26 @@
 namespace curve {
 namespace snapshotcloneserver {
 
+/**
+ * @brief RecoverChunk阶段的进度统计
+ */
+struct RecoverChunkStat {
+    // 需要恢复的chunk总数
+    uint64_t totalChunkNum = 0;
+    // 已恢复的chunk数
+    uint64_t recoveredChunkNum = 0;
+    // 数据已全部写入、无需恢复而跳过的chunk数
+    uint64_t skippedChunkNum = 0;
+    // 已恢复的数据量
+    uint64_t recoveredBytes = 0;
+    // 恢复速度，单位bytes/s
+    uint64_t throughputBps = 0;
+    // 预计剩余时间，单位s
+    uint64_t etaSec = 0;
+    // 当前的并发chunk数
+    uint32_t concurrency = 0;
+};
+
 class CloneTaskInfo : public TaskInfo {
  public:
     CloneTaskInfo(const CloneInfo &cloneInfo,
@@ -67,10 +88,23 @@ class CloneTaskInfo : public TaskInfo {
         return closure_;
     }
 
+    void SetRecoverStat(const RecoverChunkStat &stat) {
+        std::lock_guard<std::mutex> guard(statLock_);
+        recoverStat_ = stat;
+    }
+
+    RecoverChunkStat GetRecoverStat() const {
+        std::lock_guard<std::mutex> guard(statLock_);
+        return recoverStat_;
+    }
+
  private:
     CloneInfo cloneInfo_;
     std::shared_ptr<CloneInfoMetric> metric_;
     std::shared_ptr<CloneClosure> closure_;
+    // 任务线程更新，查询线程读取
+    RecoverChunkStat recoverStat_;
+    mutable std::mutex statLock_;
 };
 
 std::ostream& operator<<(std::ostream& os, const CloneTaskInfo &taskInfo);
@@ -197,6 +231,8 @@ struct RecoverChunkContext {
     uint64_t startTime;
     // 异步请求重试总时间
     uint64_t clientAsyncMethodRetryTimeSec;
+    // 当前分片请求的下发时间，单位us，用于统计分片延迟
+    uint64_t partStartTimeUs;
 };
 
 using RecoverChunkContextPtr = std::shared_ptr<RecoverChunkContext>;
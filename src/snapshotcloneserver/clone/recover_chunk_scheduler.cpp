@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include "src/snapshotcloneserver/clone/recover_chunk_scheduler.h"
+
+#include <algorithm>
+
+namespace curve {
+namespace snapshotcloneserver {
+
+RecoverChunkScheduler::RecoverChunkScheduler(
+    const RecoverChunkSchedulerOption &option)
+    : option_(option),
+      nextKey_(0),
+      pendingNum_(0),
+      workingNum_(0),
+      sampleNum_(0),
+      sampleLatencyUs_(0),
+      sampleFailed_(false) {
+    if (option_.initConcurrency == 0) {
+        option_.initConcurrency = 1;
+    }
+    if (option_.maxConcurrency < option_.initConcurrency) {
+        option_.maxConcurrency = option_.initConcurrency;
+    }
+    concurrency_ = option_.initConcurrency;
+}
+
+void RecoverChunkScheduler::AddChunk(const ChunkIDInfo &cidInfo) {
+    pending_[CopysetKey(cidInfo)].push_back(cidInfo);
+    pendingNum_++;
+}
+
+bool RecoverChunkScheduler::PopChunk(ChunkIDInfo *cidInfo) {
+    if (workingNum_ >= concurrency_ || pending_.empty()) {
+        return false;
+    }
+    // 从上次的位置开始轮询，跳过已达到并发上限的copyset
+    auto it = pending_.lower_bound(nextKey_);
+    for (size_t i = 0; i < pending_.size(); i++, it++) {
+        if (it == pending_.end()) {
+            it = pending_.begin();
+        }
+        uint32_t &working = working_[it->first];
+        if (option_.concurrencyPerCopyset > 0 &&
+            working >= option_.concurrencyPerCopyset) {
+            continue;
+        }
+        *cidInfo = it->second.front();
+        it->second.pop_front();
+        working++;
+        workingNum_++;
+        pendingNum_--;
+        nextKey_ = it->first + 1;
+        if (it->second.empty()) {
+            pending_.erase(it);
+        }
+        return true;
+    }
+    return false;
+}
+
+void RecoverChunkScheduler::OnChunkDone(const ChunkIDInfo &cidInfo) {
+    auto it = working_.find(CopysetKey(cidInfo));
+    if (it == working_.end() || it->second == 0) {
+        return;
+    }
+    if (--it->second == 0) {
+        working_.erase(it);
+    }
+    workingNum_--;
+}
+
+void RecoverChunkScheduler::OnPartDone(uint64_t latencyUs, bool success) {
+    if (option_.latencyTargetMs == 0) {
+        return;
+    }
+    sampleNum_++;
+    sampleLatencyUs_ += latencyUs;
+    sampleFailed_ = sampleFailed_ || !success;
+    // 每完成一轮(当前并发数个)分片调整一次
+    if (sampleNum_ < concurrency_) {
+        return;
+    }
+    uint64_t avgLatencyUs = sampleLatencyUs_ / sampleNum_;
+    if (sampleFailed_ || avgLatencyUs > option_.latencyTargetMs * 1000) {
+        concurrency_ = std::max(1u, concurrency_ * 3 / 4);
+    } else if (concurrency_ < option_.maxConcurrency) {
+        concurrency_++;
+    }
+    sampleNum_ = 0;
+    sampleLatencyUs_ = 0;
+    sampleFailed_ = false;
+}
+
+}  // namespace snapshotcloneserver
+}  // namespace curve
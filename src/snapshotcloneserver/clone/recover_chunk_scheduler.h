@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#ifndef SRC_SNAPSHOTCLONESERVER_CLONE_RECOVER_CHUNK_SCHEDULER_H_
+#define SRC_SNAPSHOTCLONESERVER_CLONE_RECOVER_CHUNK_SCHEDULER_H_
+
+#include <deque>
+#include <map>
+
+#include "src/client/client_common.h"
+
+using ::curve::client::ChunkIDInfo;
+
+namespace curve {
+namespace snapshotcloneserver {
+
+struct RecoverChunkSchedulerOption {
+    // 初始的并发恢复chunk数
+    uint32_t initConcurrency;
+    // 并发恢复chunk数的上限
+    uint32_t maxConcurrency;
+    // 每个copyset上同时恢复的chunk数上限，0表示不限制
+    uint32_t concurrencyPerCopyset;
+    // 分片恢复的目标延迟，超过时降低并发，否则逐步提高并发，0表示不调整
+    uint32_t latencyTargetMs;
+};
+
+/**
+ * @brief RecoverChunk的调度器
+ *
+ *  待恢复的chunk按copyset分组，取chunk时在copyset之间轮询，
+ *  并限制每个copyset上同时恢复的chunk数，使请求分散到不同的chunkserver；
+ *  总并发数根据分片的恢复延迟加性增、乘性减地调整。
+ *  调度器只在clone任务线程中使用，不加锁
+ */
+class RecoverChunkScheduler {
+ public:
+    explicit RecoverChunkScheduler(const RecoverChunkSchedulerOption &option);
+
+    /**
+     * @brief 加入一个待恢复的chunk
+     */
+    void AddChunk(const ChunkIDInfo &cidInfo);
+
+    /**
+     * @brief 取出一个可以开始恢复的chunk
+     *
+     * @param[out] cidInfo chunk信息
+     *
+     * @retval true 成功
+     * @retval false 已达到并发上限或者没有可以恢复的chunk
+     */
+    bool PopChunk(ChunkIDInfo *cidInfo);
+
+    /**
+     * @brief 一个chunk恢复结束，释放其占用的并发
+     */
+    void OnChunkDone(const ChunkIDInfo &cidInfo);
+
+    /**
+     * @brief 反馈一个分片的恢复结果，用于调整并发数
+     *
+     * @param latencyUs 分片恢复的耗时
+     * @param success 分片是否恢复成功
+     */
+    void OnPartDone(uint64_t latencyUs, bool success);
+
+    uint32_t GetConcurrency() const {
+        return concurrency_;
+    }
+
+    uint64_t GetWorkingNum() const {
+        return workingNum_;
+    }
+
+    uint64_t GetPendingNum() const {
+        return pendingNum_;
+    }
+
+ private:
+    static uint64_t CopysetKey(const ChunkIDInfo &cidInfo) {
+        return (static_cast<uint64_t>(cidInfo.lpid_) << 32) | cidInfo.cpid_;
+    }
+
+ private:
+    RecoverChunkSchedulerOption option_;
+    // 当前的并发chunk数
+    uint32_t concurrency_;
+    // copyset -> 待恢复的chunk
+    std::map<uint64_t, std::deque<ChunkIDInfo>> pending_;
+    // copyset -> 正在恢复的chunk数
+    std::map<uint64_t, uint32_t> working_;
+    // 下次轮询开始的copyset
+    uint64_t nextKey_;
+    uint64_t pendingNum_;
+    uint64_t workingNum_;
+    // 当前统计周期内完成的分片数、总耗时以及是否有失败
+    uint32_t sampleNum_;
+    uint64_t sampleLatencyUs_;
+    bool sampleFailed_;
+};
+
+}  // namespace snapshotcloneserver
+}  // namespace curve
+
+#endif  // SRC_SNAPSHOTCLONESERVER_CLONE_RECOVER_CHUNK_SCHEDULER_H_
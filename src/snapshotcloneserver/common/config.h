@@ -67,6 +67,10 @@ struct SnapshotCloneServerOptions {
     uint32_t mdsSessionTimeUs;
     // ReadChunkSnapshot同时进行的异步请求数量
     uint32_t readChunkSnapshotConcurrency;
+    // 转储chunk的压缩算法，none或zlib，按分片压缩
+    std::string snapshotCompressType;
+    // 压缩级别
+    int snapshotCompressLevel;
 
     // 用于Lazy克隆元数据部分的线程池线程数
     int stage1PoolThreadNum;
@@ -86,6 +90,14 @@ struct SnapshotCloneServerOptions {
     uint32_t createCloneChunkConcurrency;
     // RecoverChunk同时进行的异步请求数量
     uint32_t recoverChunkConcurrency;
+    // RecoverChunk并发数自适应调整的上限
+    uint32_t recoverChunkMaxConcurrency;
+    // 每个copyset上同时进行RecoverChunk的chunk数上限，0表示不限制
+    uint32_t recoverChunkConcurrencyPerCopyset;
+    // RecoverChunk分片的目标延迟，0表示不自适应调整并发数
+    uint32_t recoverChunkLatencyTargetMs;
+    // RecoverChunk前是否跳过数据已全部写入的chunk
+    bool recoverSkipWrittenChunk;
 };
 
 }  // namespace snapshotcloneserver
@@ -173,6 +173,20 @@ int CurveFsClientImpl::GetChunkInfo(
         clientMethodRetryIntervalMs_);
 }
 
+int CurveFsClientImpl::GetChunksInfo(
+    const std::vector<ChunkIDInfo> &cidinfos,
+    std::vector<ChunkInfoDetail> *chunkInfos) {
+    RetryMethod method = [this, &cidinfos, &chunkInfos] () {
+        return snapClient_->GetChunksInfo(cidinfos, chunkInfos);
+    };
+    RetryCondition condition = [] (int ret) {
+        return ret != LIBCURVE_ERROR::OK;
+    };
+    RetryHelper retryHelper(method, condition);
+    return retryHelper.RetryTimeSecAndReturn(clientMethodRetryTimeSec_,
+        clientMethodRetryIntervalMs_);
+}
+
 int CurveFsClientImpl::CreateCloneFile(
     const std::string &source,
     const std::string &filename,
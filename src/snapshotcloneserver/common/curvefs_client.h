@@ -207,6 +207,17 @@ class CurveFsClient {
     virtual int GetChunkInfo(const ChunkIDInfo &cidinfo,
         ChunkInfoDetail *chunkInfo) = 0;
 
+    /**
+     * @brief 批量获取同一个copyset中多个chunk的版本号信息
+     *
+     * @param cidinfos chunk ID 信息，必须属于同一个copyset
+     * @param[out] chunkInfos chunk详细信息，与cidinfos一一对应
+     *
+     * @return 错误码
+     */
+    virtual int GetChunksInfo(const std::vector<ChunkIDInfo> &cidinfos,
+        std::vector<ChunkInfoDetail> *chunkInfos) = 0;
+
     /**
      * @brief 创建clone文件
      * @detail
@@ -445,6 +456,9 @@ class CurveFsClientImpl : public CurveFsClient {
     int GetChunkInfo(const ChunkIDInfo &cidinfo,
         ChunkInfoDetail *chunkInfo) override;
 
+    int GetChunksInfo(const std::vector<ChunkIDInfo> &cidinfos,
+        std::vector<ChunkInfoDetail> *chunkInfos) override;
+
     int CreateCloneFile(
         const std::string &source,
         const std::string &filename,
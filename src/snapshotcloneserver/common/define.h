@@ -144,6 +144,9 @@ constexpr uint32_t kProgressRecoverChunkBegin = kProgressMetaInstalled;
 constexpr uint32_t kProgressRecoverChunkEnd = 95;
 constexpr uint32_t kProgressCloneComplete = 100;
 
+// GetChunksInfo一次查询的最大chunk数
+constexpr uint32_t kGetChunksInfoBatchSize = 256;
+
 
 
 }  // namespace snapshotcloneserver
@@ -125,6 +125,15 @@ void CloneInfoMetric::Update(CloneTaskInfo *taskInfo) {
 
     metric.Set("Progress", std::to_string(taskInfo->GetProgress()));
 
+    RecoverChunkStat stat = taskInfo->GetRecoverStat();
+    metric.Set("RecoverTotalChunk", std::to_string(stat.totalChunkNum));
+    metric.Set("RecoverRecoveredChunk",
+        std::to_string(stat.recoveredChunkNum));
+    metric.Set("RecoverSkippedChunk", std::to_string(stat.skippedChunkNum));
+    metric.Set("RecoverThroughputBps", std::to_string(stat.throughputBps));
+    metric.Set("RecoverEtaSec", std::to_string(stat.etaSec));
+    metric.Set("RecoverConcurrency", std::to_string(stat.concurrency));
+
     metric.Update();
 }
 
@@ -299,6 +299,7 @@ void SnapshotCoreImpl::HandleCreateSnapshotTask(
             [this] (const ChunkDataName &chunkDataName) {
                 return dataStore_->ChunkDataExist(chunkDataName);
             },
+            fileSnapshotMap,
             task);
     } else {
         ret = TransferSnapshotData(indexData,
@@ -307,6 +308,7 @@ void SnapshotCoreImpl::HandleCreateSnapshotTask(
             [&fileSnapshotMap] (const ChunkDataName &chunkDataName) {
                 return fileSnapshotMap.IsExistChunk(chunkDataName);
             },
+            fileSnapshotMap,
             task);
     }
     if (ret < 0) {
@@ -659,7 +661,9 @@ int SnapshotCoreImpl::BuildChunkIndexData(
 
     indexData->SetFileName(fileName);
 
-    uint64_t chunkIndex = 0;
+    // 先获取所有segment，再将chunk按copyset分组，批量查询chunk的版本号
+    std::map<uint64_t, std::vector<std::pair<ChunkIndexType, ChunkIDInfo>>>
+        copysetChunks;
     for (uint64_t i = 0; i < fileLength/segmentSize; i++) {
         uint64_t offset = i * segmentSize;
         SegmentInfo segInfo;
@@ -675,19 +679,52 @@ int SnapshotCoreImpl::BuildChunkIndexData(
             for (std::vector<uint64_t>::size_type j = 0;
                 j < segInfo.chunkvec.size();
                 j++) {
-                ChunkInfoDetail chunkInfo;
                 ChunkIDInfo cidInfo = segInfo.chunkvec[j];
-                ret = client_->GetChunkInfo(cidInfo,
-                    &chunkInfo);
-                if (ret != LIBCURVE_ERROR::OK) {
-                    LOG(ERROR) << "GetChunkInfo error, "
-                               << " ret = " << ret
-                               << ", logicalPoolId = " << cidInfo.lpid_
-                               << ", copysetId = " << cidInfo.cpid_
-                               << ", chunkId = " << cidInfo.cid_
-                               << ", uuid = " << task->GetUuid();
-                    return kErrCodeInternalError;
-                }
+                uint64_t copysetKey =
+                    (static_cast<uint64_t>(cidInfo.lpid_) << 32) |
+                    cidInfo.cpid_;
+                copysetChunks[copysetKey].emplace_back(
+                    i * (segmentSize / chunkSize) + j, cidInfo);
+            }
+        } else if (-LIBCURVE_ERROR::NOT_ALLOCATE == ret) {
+            // nothing
+        } else {
+            LOG(ERROR) << "GetSnapshotSegmentInfo error,"
+                       << " ret = " << ret
+                       << ", fileName = " << fileName
+                       << ", user = " << user
+                       << ", seq = " << seqNum
+                       << ", offset = " << offset
+                       << ", uuid = " << task->GetUuid();
+            return kErrCodeInternalError;
+        }
+    }
+
+    for (auto &copysetChunk : copysetChunks) {
+        auto &chunks = copysetChunk.second;
+        for (size_t begin = 0; begin < chunks.size();
+            begin += kGetChunksInfoBatchSize) {
+            size_t end = std::min(chunks.size(),
+                begin + kGetChunksInfoBatchSize);
+            std::vector<ChunkIDInfo> cidInfos;
+            for (size_t k = begin; k < end; k++) {
+                cidInfos.push_back(chunks[k].second);
+            }
+            std::vector<ChunkInfoDetail> chunkInfos;
+            int ret = client_->GetChunksInfo(cidInfos, &chunkInfos);
+            if (ret != LIBCURVE_ERROR::OK ||
+                chunkInfos.size() != cidInfos.size()) {
+                LOG(ERROR) << "GetChunksInfo error, "
+                           << " ret = " << ret
+                           << ", logicalPoolId = " << cidInfos[0].lpid_
+                           << ", copysetId = " << cidInfos[0].cpid_
+                           << ", chunk num = " << cidInfos.size()
+                           << ", uuid = " << task->GetUuid();
+                return kErrCodeInternalError;
+            }
+            for (size_t k = begin; k < end; k++) {
+                ChunkIndexType chunkIndex = chunks[k].first;
+                const ChunkInfoDetail &chunkInfo = chunkInfos[k - begin];
                 // 2个sn，小的是snap sn，大的是快照之后的写
                 // 1个sn，有两种情况：
                 //    小于等于seqNum时为snap sn, 且快照之后未写过;
@@ -698,13 +735,11 @@ int SnapshotCoreImpl::BuildChunkIndexData(
                     uint64_t seq =
                         std::min(chunkInfo.chunkSn[0],
                                 chunkInfo.chunkSn[1]);
-                    chunkIndex = i * (segmentSize / chunkSize) + j;
                     ChunkDataName chunkDataName(fileName, seq, chunkIndex);
                     indexData->PutChunkDataName(chunkDataName);
                 } else if (chunkInfo.chunkSn.size() == 1) {
                     uint64_t seq = chunkInfo.chunkSn[0];
                     if (seq <= seqNum) {
-                        chunkIndex = i * (segmentSize / chunkSize) + j;
                         ChunkDataName chunkDataName(fileName, seq, chunkIndex);
                         indexData->PutChunkDataName(chunkDataName);
                     }
@@ -712,27 +747,16 @@ int SnapshotCoreImpl::BuildChunkIndexData(
                     // nothing
                 } else {
                     // should not reach here
-                    LOG(ERROR) << "GetChunkInfo return chunkInfo.chunkSn.size()"
-                               << " invalid, size = "
+                    LOG(ERROR) << "GetChunksInfo return "
+                               << "chunkInfo.chunkSn.size() invalid, size = "
                                << chunkInfo.chunkSn.size()
                                << ", uuid = " << task->GetUuid();
                     return kErrCodeInternalError;
                 }
-                if (task->IsCanceled()) {
-                    return kErrCodeSuccess;
-                }
             }
-        } else if (-LIBCURVE_ERROR::NOT_ALLOCATE == ret) {
-            // nothing
-        } else {
-            LOG(ERROR) << "GetSnapshotSegmentInfo error,"
-                       << " ret = " << ret
-                       << ", fileName = " << fileName
-                       << ", user = " << user
-                       << ", seq = " << seqNum
-                       << ", offset = " << offset
-                       << ", uuid = " << task->GetUuid();
-            return kErrCodeInternalError;
+            if (task->IsCanceled()) {
+                return kErrCodeSuccess;
+            }
         }
     }
 
@@ -783,6 +807,7 @@ int SnapshotCoreImpl::TransferSnapshotData(
     const SnapshotInfo &info,
     const std::map<uint64_t, SegmentInfo> &segInfos,
     const ChunkDataExistFilter &filter,
+    const FileSnapMap &fileSnapshotMap,
     std::shared_ptr<SnapshotTaskInfo> task) {
     int ret = 0;
     uint64_t segmentSize = info.GetSegmentSize();
@@ -849,6 +874,11 @@ int SnapshotCoreImpl::TransferSnapshotData(
                         clientAsyncMethodRetryTimeSec_,
                         clientAsyncMethodRetryIntervalMs_,
                         readChunkSnapshotConcurrency_);
+                ChunkDataName baseName;
+                if (fileSnapshotMap.GetLatestChunkDataName(
+                    chunkIndex, &baseName)) {
+                    taskInfo->SetBaseName(baseName);
+                }
                 UUID taskId = UUIDGenerator().GenerateUUID();
                 auto task = new TransferSnapshotDataChunkTask(
                     taskId,
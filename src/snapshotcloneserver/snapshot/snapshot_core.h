@@ -68,6 +68,30 @@ struct FileSnapMap {
         }
         return find;
     }
+
+    /**
+     * @brief 获取映射表中某个chunk版本号最大的chunk数据，
+     *        作为该chunk增量转储的基准
+     *
+     * @param index chunk索引
+     * @param[out] name chunk数据对象
+     *
+     * @retval true 存在
+     * @retval false 不存在
+     */
+    bool GetLatestChunkDataName(ChunkIndexType index,
+        ChunkDataName *name) const {
+        bool find = false;
+        for (auto &v : maps) {
+            ChunkDataName tmp;
+            if (v.GetChunkDataName(index, &tmp) &&
+                (!find || tmp.chunkSeqNum_ > name->chunkSeqNum_)) {
+                *name = tmp;
+                find = true;
+            }
+        }
+        return find;
+    }
 };
 
 /**
@@ -299,6 +323,7 @@ class SnapshotCoreImpl : public SnapshotCore {
      * @param info 快照信息
      * @param segInfos Segment信息
      * @param filter 转储数据块过滤器
+     * @param fileSnapshotMap 快照文件映射表，用于查找增量转储的基准
      * @param task 快照任务信息
      *
      * @return  错误码
@@ -308,6 +333,7 @@ class SnapshotCoreImpl : public SnapshotCore {
         const SnapshotInfo &info,
         const std::map<uint64_t, SegmentInfo> &segInfos,
         const ChunkDataExistFilter &filter,
+        const FileSnapMap &fileSnapshotMap,
         std::shared_ptr<SnapshotTaskInfo> task);
 
     /**
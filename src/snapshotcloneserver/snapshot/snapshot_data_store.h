@@ -33,9 +33,12 @@
 #include <memory>
 
 #include "src/common/concurrent/concurrent.h"
+#include "src/common/compressor.h"
 
 using ::curve::common::SpinLock;
 using ::curve::common::LockGuard;
+using ::curve::common::CompressType;
+using ::curve::common::CompressedBlockIndex;
 
 namespace curve {
 namespace snapshotcloneserver {
@@ -44,6 +47,7 @@ using ChunkIndexType = uint32_t;
 using SnapshotSeqType = uint64_t;
 
 const char kChunkDataNameSeprator[] = "-";
+const char kChunkDataDigestSuffix[] = ".digest";
 
 class ChunkDataName {
  public:
@@ -68,6 +72,22 @@ class ChunkDataName {
             + std::to_string(this->chunkSeqNum_);
     }
 
+    /**
+     * 构建datachunk对象各分片摘要的对象名称，用于增量转储
+     * @return: 对象名称字符串
+     */
+    std::string ToDataChunkDigestKey() const {
+        return ToDataChunkKey() + kChunkDataDigestSuffix;
+    }
+
+    /**
+     * 构建分块压缩的datachunk对象的块索引对象名称
+     * @return: 对象名称字符串
+     */
+    std::string ToDataChunkCompressIndexKey() const {
+        return ToDataChunkKey() + curve::common::kCompressIndexSuffix;
+    }
+
     std::string fileName_;
     SnapshotSeqType chunkSeqNum_;
     ChunkIndexType chunkIndex_;
@@ -166,9 +186,24 @@ class ChunkData{
 
 class TransferTask {
  public:
-     TransferTask() {}
+     TransferTask()
+         : hasBase_(false),
+           basePartSize_(0),
+           baseCompressType_(CompressType::kNone),
+           partSize_(0) {}
      std::string uploadId_;
 
+     // 增量转储的基准对象，即该chunk上一个版本的datachunk对象。
+     // 内容与基准对象相同的分片在对象存储内部拷贝，不再上传
+     bool hasBase_;
+     ChunkDataName baseName_;
+     // 基准对象的分片大小和各分片摘要，由DataChunkTranferInit加载
+     uint64_t basePartSize_;
+     std::vector<std::string> baseDigests_;
+     // 基准对象的压缩算法，压缩时还需要加载其块索引以定位各分片
+     CompressType baseCompressType_;
+     CompressedBlockIndex baseIndex_;
+
      void AddPartInfo(int partNum, std::string etag) {
          m_.Lock();
          partInfo_.emplace(partNum, etag);
@@ -179,10 +214,41 @@ class TransferTask {
          return partInfo_;
      }
 
+     void AddPartDigest(int partNum, uint64_t partSize, std::string digest) {
+         m_.Lock();
+         partSize_ = partSize;
+         partDigest_.emplace(partNum, digest);
+         m_.UnLock();
+     }
+
+     std::map<int, std::string> GetPartDigest() {
+         return partDigest_;
+     }
+
+     uint64_t GetPartSize() const {
+         return partSize_;
+     }
+
+     void AddPartStoredLen(int partNum, uint64_t storedLen) {
+         m_.Lock();
+         partStoredLen_.emplace(partNum, storedLen);
+         m_.UnLock();
+     }
+
+     std::map<int, uint64_t> GetPartStoredLen() {
+         return partStoredLen_;
+     }
+
  private:
      mutable SpinLock m_;
      // partnumber <=> etag
      std::map<int, std::string> partInfo_;
+     // 分片大小
+     uint64_t partSize_;
+     // partnumber <=> 分片数据摘要
+     std::map<int, std::string> partDigest_;
+     // partnumber <=> 分片压缩后在对象中的存储长度
+     std::map<int, uint64_t> partStoredLen_;
 };
 
 class SnapshotDataStore {
@@ -252,7 +318,9 @@ class SnapshotDataStore {
     virtual int GetSnapshotFlag(const ChunkIndexDataName &name) = 0;
 */
     /**
-     * 初始化数据库chunk的分片转储任务
+     * 初始化数据库chunk的分片转储任务，若task指定了基准对象，
+     * 同时加载基准对象的分片摘要，加载失败或基准对象的压缩算法
+     * 与当前不一致则退化为全量转储
      * @param 数据chunk名称
      * @param 管理转储任务的指针
      * @return 0 任务初始化成功/ -1 任务初始化失败
@@ -260,7 +328,8 @@ class SnapshotDataStore {
     virtual int DataChunkTranferInit(const ChunkDataName &name,
                                     std::shared_ptr<TransferTask> task) = 0;
     /**
-     * 添加数据chunk的一个分片到转储任务中
+     * 添加数据chunk的一个分片到转储任务中，与基准对象对应分片
+     * 内容相同时从基准对象拷贝而不上传数据，开启压缩时分片压缩后上传
      * @param 数据chunk名
      * @转储任务
      * @第几个分片
@@ -274,7 +343,8 @@ class SnapshotDataStore {
                                        int partSize,
                                        const char* buf) = 0;
     /**
-     * 完成数据chunk的转储任务
+     * 完成数据chunk的转储任务，并保存各分片摘要供下一版本增量转储。
+     * 开启压缩时先保存块索引，再完成上传，保证可见的压缩对象都有索引
      * @param 数据chunk名
      * @param 转储任务管理结构
      * @return: 0 转储任务完成/ 转储任务失败 -1
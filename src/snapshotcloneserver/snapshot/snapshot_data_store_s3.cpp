@@ -27,9 +27,20 @@
 #include <aws/core/utils/memory/stl/AWSString.h>  //NOLINT
 #include <aws/core/utils/memory/stl/AWSMap.h>  //NOLINT
 #include <aws/core/utils/StringUtils.h>   //NOLINT
+#include <aws/core/utils/HashingUtils.h>   //NOLINT
+#include <sstream>
 namespace curve {
 namespace snapshotcloneserver {
 
+namespace {
+std::string CalcPartDigest(const char *buf, int partSize) {
+    Aws::String data(buf, partSize);
+    Aws::String digest = Aws::Utils::HashingUtils::HexEncode(
+        Aws::Utils::HashingUtils::CalculateMD5(data));
+    return std::string(digest.c_str(), digest.size());
+}
+}  // namespace
+
 // nos conf
 int S3SnapshotDataStore::Init(const std::string &path) {
     // Init server conf
@@ -112,7 +123,18 @@ int S3SnapshotDataStore::DeleteChunkIndexData(const ChunkIndexDataName &name) {
 int S3SnapshotDataStore::DeleteChunkData(const ChunkDataName &name) {
     std::string key = name.ToDataChunkKey();
     const Aws::String aws_key(key.c_str(), key.size());
-    return s3Adapter4Meta_->DeleteObject(aws_key);
+    int ret = s3Adapter4Meta_->DeleteObject(aws_key);
+    if (ret == 0) {
+        // 摘要和块索引对象不一定存在(如旧版本转储或未压缩的对象)，
+        // 删除失败不影响结果
+        std::string digestKey = name.ToDataChunkDigestKey();
+        s3Adapter4Data_->DeleteObject(
+            Aws::String(digestKey.c_str(), digestKey.size()));
+        std::string indexKey = name.ToDataChunkCompressIndexKey();
+        s3Adapter4Data_->DeleteObject(
+            Aws::String(indexKey.c_str(), indexKey.size()));
+    }
+    return ret;
 }
 /*
 int S3SnapshotDataStore::SetSnapshotFlag(const ChunkIndexDataName &name,
@@ -142,11 +164,83 @@ int S3SnapshotDataStore::GetSnapshotFlag(const ChunkIndexDataName &name) {
     }
 }
 */
+bool S3SnapshotDataStore::LoadBaseDigest(
+    std::shared_ptr<TransferTask> task) {
+    std::string key = task->baseName_.ToDataChunkDigestKey();
+    const Aws::String aws_key(key.c_str(), key.size());
+    std::string data;
+    if (s3Adapter4Data_->GetObject(aws_key, &data) < 0) {
+        return false;
+    }
+    // 格式：第一行为"分片大小 压缩算法"，之后每行依次为各分片的摘要，
+    // 没有压缩算法的为未压缩的对象
+    std::istringstream in(data);
+    uint64_t partSize = 0;
+    if (!(in >> partSize) || partSize == 0) {
+        return false;
+    }
+    CompressType type = CompressType::kNone;
+    std::vector<std::string> digests;
+    std::string digest;
+    if (in >> digest &&
+        !curve::common::StringToCompressType(digest, &type)) {
+        digests.push_back(digest);
+    }
+    while (in >> digest) {
+        digests.push_back(digest);
+    }
+    task->basePartSize_ = partSize;
+    task->baseCompressType_ = type;
+    task->baseDigests_.swap(digests);
+    return true;
+}
+
+bool S3SnapshotDataStore::LoadBaseIndex(
+    std::shared_ptr<TransferTask> task) {
+    std::string key = task->baseName_.ToDataChunkCompressIndexKey();
+    const Aws::String aws_key(key.c_str(), key.size());
+    std::string data;
+    if (s3Adapter4Data_->GetObject(aws_key, &data) < 0 ||
+        !task->baseIndex_.Parse(data)) {
+        return false;
+    }
+    return task->baseIndex_.GetType() == task->baseCompressType_ &&
+           task->baseIndex_.GetBlockSize() == task->basePartSize_;
+}
+
 int S3SnapshotDataStore::DataChunkTranferInit(const ChunkDataName &name,
                                     std::shared_ptr<TransferTask> task) {
+    if (task->hasBase_ && !LoadBaseDigest(task)) {
+        LOG(WARNING) << "Load base digest fail, transfer whole chunk"
+                     << ", chunkDataName = " << name.ToDataChunkKey()
+                     << ", baseName = " << task->baseName_.ToDataChunkKey();
+        task->hasBase_ = false;
+    }
+    // 压缩算法不同时分片的存储格式不同，无法从基准对象拷贝
+    if (task->hasBase_ && task->baseCompressType_ != GetCompressType()) {
+        LOG(INFO) << "Base compress type mismatch, transfer whole chunk"
+                  << ", chunkDataName = " << name.ToDataChunkKey()
+                  << ", baseName = " << task->baseName_.ToDataChunkKey();
+        task->hasBase_ = false;
+    }
+    if (task->hasBase_ && compressor_ != nullptr && !LoadBaseIndex(task)) {
+        LOG(WARNING) << "Load base compress index fail, transfer whole chunk"
+                     << ", chunkDataName = " << name.ToDataChunkKey()
+                     << ", baseName = " << task->baseName_.ToDataChunkKey();
+        task->hasBase_ = false;
+    }
     std::string key = name.ToDataChunkKey();
     const Aws::String aws_key(key.c_str(), key.size());
-    Aws::String aws_uploadId = s3Adapter4Data_->MultiUploadInit(aws_key);
+    // 压缩的对象在元数据中记录压缩算法，读取时据此判断是否需要块索引
+    Aws::Map<Aws::String, Aws::String> metadata;
+    if (compressor_ != nullptr) {
+        std::string type =
+            curve::common::CompressTypeToString(compressor_->GetType());
+        metadata[curve::common::kCompressMetaKey] =
+            Aws::String(type.c_str(), type.size());
+    }
+    Aws::String aws_uploadId =
+        s3Adapter4Data_->MultiUploadInit(aws_key, metadata);
     if (aws_uploadId == "") {
         LOG(ERROR) << "Init multiupload failed";
         return -1;
@@ -164,9 +258,56 @@ int S3SnapshotDataStore::DataChunkTranferAddPart(const ChunkDataName &name,
     std::string key = name.ToDataChunkKey();
     const Aws::String aws_key(key.c_str(), key.size());
     const Aws::String uploadId(task->uploadId_.c_str(), task->uploadId_.size());
-    Aws::S3::Model::CompletedPart cp =
-        s3Adapter4Data_->UploadOnePart(
-            aws_key, uploadId, partNum + 1, partSize, buf);
+    std::string digest = CalcPartDigest(buf, partSize);
+    task->AddPartDigest(partNum, partSize, digest);
+
+    Aws::S3::Model::CompletedPart cp;
+    bool copied = false;
+    if (task->hasBase_ &&
+        task->basePartSize_ == static_cast<uint64_t>(partSize) &&
+        partNum >= 0 &&
+        static_cast<size_t>(partNum) < task->baseDigests_.size() &&
+        task->baseDigests_[partNum] == digest &&
+        (compressor_ == nullptr ||
+         static_cast<uint32_t>(partNum) < task->baseIndex_.GetBlockNum())) {
+        std::string baseKey = task->baseName_.ToDataChunkKey();
+        uint64_t srcOffset = static_cast<uint64_t>(partNum) * partSize;
+        uint64_t storedLen = partSize;
+        if (compressor_ != nullptr) {
+            srcOffset = task->baseIndex_.GetBlockOffset(partNum);
+            storedLen = task->baseIndex_.GetBlockLen(partNum);
+        }
+        cp = s3Adapter4Data_->UploadPartCopy(
+            aws_key, uploadId, partNum + 1,
+            Aws::String(baseKey.c_str(), baseKey.size()),
+            srcOffset, storedLen);
+        copied = (cp.GetPartNumber() != -1);
+        if (copied) {
+            task->AddPartStoredLen(partNum, storedLen);
+        }
+        if (!copied) {
+            // 基准对象可能已被删除，直接上传该分片
+            LOG(WARNING) << "UploadPartCopy from base fail, upload part"
+                         << ", chunkDataName = " << key
+                         << ", baseName = " << baseKey
+                         << ", partNum = " << partNum;
+        }
+    }
+    if (!copied) {
+        // 压缩后不比原始数据小的分片保存原始数据
+        std::string compressed;
+        if (compressor_ != nullptr &&
+            compressor_->Compress(buf, partSize, &compressed)) {
+            cp = s3Adapter4Data_->UploadOnePart(
+                aws_key, uploadId, partNum + 1,
+                compressed.size(), compressed.data());
+            task->AddPartStoredLen(partNum, compressed.size());
+        } else {
+            cp = s3Adapter4Data_->UploadOnePart(
+                aws_key, uploadId, partNum + 1, partSize, buf);
+            task->AddPartStoredLen(partNum, partSize);
+        }
+    }
     std::string etag(cp.GetETag().c_str(), cp.GetETag().size());
     int tmp_partnum = cp.GetPartNumber();
     if (etag == "errorTag" && tmp_partnum == -1) {
@@ -189,7 +330,50 @@ int S3SnapshotDataStore::DataChunkTranferComplete(const ChunkDataName &name,
                        .WithETag(str)
                        .WithPartNumber(v.first));
     }
-    return s3Adapter4Data_->CompleteMultiUpload(aws_key, uploadId, cp_v);
+    int ret = s3Adapter4Data_->CompleteMultiUpload(aws_key, uploadId, cp_v);
+    if (ret < 0) {
+        return ret;
+    }
+
+    // 块索引在对象上传完成后写入，读取方在对象元数据标记为压缩而块索引
+    // 还不存在时返回失败，不会把压缩数据当作原始数据读取
+    std::string indexKey = name.ToDataChunkCompressIndexKey();
+    const Aws::String aws_indexKey(indexKey.c_str(), indexKey.size());
+    if (compressor_ != nullptr) {
+        CompressedBlockIndex index(compressor_->GetType(),
+                                   task->GetPartSize());
+        for (auto &v : task->GetPartStoredLen()) {
+            index.SetBlockLen(v.first, v.second);
+        }
+        if (s3Adapter4Data_->PutObject(aws_indexKey, index.Serialize()) < 0) {
+            LOG(ERROR) << "Put chunk data compress index fail"
+                       << ", chunkDataName = " << key;
+            // 没有块索引的压缩对象无法读取，删除后由上层重新转储
+            s3Adapter4Data_->DeleteObject(aws_key);
+            return -1;
+        }
+    } else if (s3Adapter4Data_->DeleteObject(aws_indexKey) < 0) {
+        // 之前以压缩方式转储失败时可能留下块索引
+        LOG(WARNING) << "Delete stale chunk data compress index fail"
+                     << ", chunkDataName = " << key;
+    }
+
+    auto digests = task->GetPartDigest();
+    if (!digests.empty()) {
+        std::string data = std::to_string(task->GetPartSize()) + " "
+            + curve::common::CompressTypeToString(GetCompressType()) + "\n";
+        for (auto &v : digests) {
+            data += v.second + "\n";
+        }
+        std::string digestKey = name.ToDataChunkDigestKey();
+        // 摘要只用于下一版本的增量转储，保存失败时下一版本全量转储即可
+        if (s3Adapter4Data_->PutObject(
+            Aws::String(digestKey.c_str(), digestKey.size()), data) < 0) {
+            LOG(WARNING) << "Put chunk data digest fail"
+                         << ", chunkDataName = " << key;
+        }
+    }
+    return 0;
 }
 
 int S3SnapshotDataStore::DataChunkTranferAbort(const ChunkDataName &name,
@@ -197,7 +381,15 @@ int S3SnapshotDataStore::DataChunkTranferAbort(const ChunkDataName &name,
     std::string key = name.ToDataChunkKey();
     const Aws::String aws_key(key.c_str(), key.size());
     const Aws::String uploadId(task->uploadId_.c_str(), task->uploadId_.size());
-    return s3Adapter4Data_->AbortMultiUpload(aws_key, uploadId);
+    int ret = s3Adapter4Data_->AbortMultiUpload(aws_key, uploadId);
+    // 转储中止时块索引可能已经写入，一并删除
+    std::string indexKey = name.ToDataChunkCompressIndexKey();
+    if (s3Adapter4Data_->DeleteObject(
+        Aws::String(indexKey.c_str(), indexKey.size())) < 0) {
+        LOG(WARNING) << "Delete chunk data compress index fail"
+                     << ", chunkDataName = " << key;
+    }
+    return ret;
 }
 }  // namespace snapshotcloneserver
 }  // namespace curve
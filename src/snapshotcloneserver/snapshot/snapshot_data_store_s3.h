@@ -32,6 +32,7 @@
 #include "src/common/s3_adapter.h"
 
 using ::curve::common::S3Adapter;
+using ::curve::common::Compressor;
 namespace curve {
 namespace snapshotcloneserver {
 
@@ -83,10 +84,37 @@ class S3SnapshotDataStore : public SnapshotDataStore {
      std::shared_ptr<S3Adapter> GetDataAdapter(void) {
          return s3Adapter4Data_;
      }
+     /**
+      * 设置转储数据使用的压缩算法，nullptr表示不压缩
+      */
+     void SetCompressor(std::shared_ptr<Compressor> compressor) {
+         compressor_ = compressor;
+     }
 
  private:
+    /**
+     * 加载基准对象的分片摘要到task中
+     * @param 转储任务
+     * @return true 加载成功/ false 基准对象摘要不存在或无法解析
+     */
+    bool LoadBaseDigest(std::shared_ptr<TransferTask> task);
+
+    /**
+     * 加载基准对象的块索引到task中
+     * @param 转储任务
+     * @return true 加载成功/ false 块索引不存在或与基准对象不匹配
+     */
+    bool LoadBaseIndex(std::shared_ptr<TransferTask> task);
+
+    CompressType GetCompressType() const {
+        return compressor_ == nullptr ? CompressType::kNone
+                                      : compressor_->GetType();
+    }
+
     std::shared_ptr<curve::common::S3Adapter> s3Adapter4Data_;
     std::shared_ptr<curve::common::S3Adapter> s3Adapter4Meta_;
+    // 转储数据的压缩算法，为空时不压缩
+    std::shared_ptr<Compressor> compressor_;
 };
 
 }   // namespace snapshotcloneserver
@@ -50,7 +50,9 @@ void ReadChunkSnapshotClosure::Run() {
  * @detail
  *  由于单个chunk过大，chunk转储分片进行，分片大小为chunkSplitSize_，
  *  步骤如下：
- *  1. 创建一个转储任务transferTask，并调用DataChunkTranferInit初始化
+ *  1. 创建一个转储任务transferTask，并调用DataChunkTranferInit初始化，
+ *     若存在该chunk上一版本的转储对象，则以其为基准，内容未变化的分片
+ *     在对象存储内部拷贝，只上传变化的分片
  *  2. 调用ReadChunkSnapshot从curvefs读取chunk的一个分片
  *  3. 调用DataChunkTranferAddPart转储一个分片
  *  4. 重复2、3直到所有分片转储完成，调用DataChunkTranferComplete结束转储任务
@@ -67,6 +69,8 @@ int TransferSnapshotDataChunkTask::TransferSnapshotDataChunk() {
 
     std::shared_ptr<TransferTask> transferTask =
         std::make_shared<TransferTask>();
+    transferTask->hasBase_ = taskInfo_->hasBase_;
+    transferTask->baseName_ = taskInfo_->baseName_;
     int ret = dataStore_->DataChunkTranferInit(name,
             transferTask);
     if (ret < 0) {
@@ -215,6 +215,9 @@ struct TransferSnapshotDataChunkTaskInfo : public TaskInfo {
     uint64_t clientAsyncMethodRetryTimeSec_;
     uint64_t clientAsyncMethodRetryIntervalMs_;
     uint32_t readChunkSnapshotConcurrency_;
+    // 是否存在该chunk上一版本的转储对象，存在时以其为基准增量转储
+    bool hasBase_;
+    ChunkDataName baseName_;
 
     TransferSnapshotDataChunkTaskInfo(const ChunkDataName &name,
         uint64_t chunkSize,
@@ -229,7 +232,13 @@ struct TransferSnapshotDataChunkTaskInfo : public TaskInfo {
           chunkSplitSize_(chunkSplitSize),
           clientAsyncMethodRetryTimeSec_(clientAsyncMethodRetryTimeSec),
           clientAsyncMethodRetryIntervalMs_(clientAsyncMethodRetryIntervalMs),
-          readChunkSnapshotConcurrency_(readChunkSnapshotConcurrency) {}
+          readChunkSnapshotConcurrency_(readChunkSnapshotConcurrency),
+          hasBase_(false) {}
+
+    void SetBaseName(const ChunkDataName &baseName) {
+        hasBase_ = true;
+        baseName_ = baseName;
+    }
 };
 
 class TransferSnapshotDataChunkTask : public TrackerTask {
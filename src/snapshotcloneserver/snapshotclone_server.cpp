@@ -28,8 +28,12 @@
 #include "src/snapshotcloneserver/common/define.h"
 #include "src/snapshotcloneserver/snapshotclone_server.h"
 #include "src/common/curve_version.h"
+#include "src/common/compressor.h"
 
 using LeaderElectionOptions = ::curve::election::LeaderElectionOptions;
+using ::curve::common::CompressType;
+using ::curve::common::StringToCompressType;
+using ::curve::common::NewCompressor;
 
 namespace curve {
 namespace snapshotcloneserver {
@@ -81,6 +85,18 @@ void InitSnapshotCloneServerOptions(std::shared_ptr<Configuration> conf,
                                         &serverOption->mdsSessionTimeUs);
     conf->GetValueFatalIfFail("server.readChunkSnapshotConcurrency",
             &serverOption->readChunkSnapshotConcurrency);
+    if (!conf->GetStringValue("server.snapshotCompressType",
+            &serverOption->snapshotCompressType)) {
+        serverOption->snapshotCompressType = "none";
+        LOG(WARNING) << "server.snapshotCompressType not set, use default "
+                     << serverOption->snapshotCompressType;
+    }
+    if (!conf->GetIntValue("server.snapshotCompressLevel",
+            &serverOption->snapshotCompressLevel)) {
+        serverOption->snapshotCompressLevel = 1;
+        LOG(WARNING) << "server.snapshotCompressLevel not set, use default "
+                     << serverOption->snapshotCompressLevel;
+    }
 
     conf->GetValueFatalIfFail("server.stage1PoolThreadNum",
                                      &serverOption->stage1PoolThreadNum);
@@ -102,6 +118,35 @@ void InitSnapshotCloneServerOptions(std::shared_ptr<Configuration> conf,
                             &serverOption->createCloneChunkConcurrency);
     conf->GetValueFatalIfFail("server.recoverChunkConcurrency",
                             &serverOption->recoverChunkConcurrency);
+    if (!conf->GetUInt32Value("server.recoverChunkMaxConcurrency",
+            &serverOption->recoverChunkMaxConcurrency)) {
+        serverOption->recoverChunkMaxConcurrency =
+            serverOption->recoverChunkConcurrency;
+        LOG(WARNING) << "server.recoverChunkMaxConcurrency not set, "
+                     << "use default "
+                     << serverOption->recoverChunkMaxConcurrency;
+    }
+    if (!conf->GetUInt32Value("server.recoverChunkConcurrencyPerCopyset",
+            &serverOption->recoverChunkConcurrencyPerCopyset)) {
+        serverOption->recoverChunkConcurrencyPerCopyset = 0;
+        LOG(WARNING) << "server.recoverChunkConcurrencyPerCopyset not set, "
+                     << "use default "
+                     << serverOption->recoverChunkConcurrencyPerCopyset;
+    }
+    if (!conf->GetUInt32Value("server.recoverChunkLatencyTargetMs",
+            &serverOption->recoverChunkLatencyTargetMs)) {
+        serverOption->recoverChunkLatencyTargetMs = 0;
+        LOG(WARNING) << "server.recoverChunkLatencyTargetMs not set, "
+                     << "use default "
+                     << serverOption->recoverChunkLatencyTargetMs;
+    }
+    if (!conf->GetBoolValue("server.recoverSkipWrittenChunk",
+            &serverOption->recoverSkipWrittenChunk)) {
+        serverOption->recoverSkipWrittenChunk = false;
+        LOG(WARNING) << "server.recoverSkipWrittenChunk not set, "
+                     << "use default "
+                     << serverOption->recoverSkipWrittenChunk;
+    }
 }
 
 void InitEtcdConf(std::shared_ptr<Configuration> conf, EtcdConf* etcdConf) {
@@ -238,7 +283,18 @@ bool SnapShotCloneServer::Init() {
         return false;
     }
 
-    dataStore_ = std::make_shared<S3SnapshotDataStore>();
+    auto s3DataStore = std::make_shared<S3SnapshotDataStore>();
+    const auto &serverOption = snapshotCloneServerOptions_.serverOption;
+    CompressType compressType;
+    if (!StringToCompressType(serverOption.snapshotCompressType,
+            &compressType)) {
+        LOG(ERROR) << "Invalid server.snapshotCompressType: "
+                   << serverOption.snapshotCompressType;
+        return false;
+    }
+    s3DataStore->SetCompressor(
+        NewCompressor(compressType, serverOption.snapshotCompressLevel));
+    dataStore_ = s3DataStore;
     if (dataStore_->Init(snapshotCloneServerOptions_.s3ConfPath) < 0) {
         LOG(ERROR) << "dataStore init fail.";
         return false;
@@ -21,6 +21,8 @@
  */
 #include "src/tools/chunkserver_client.h"
 
+#include <bthread/bthread.h>
+
 DECLARE_uint64(rpcTimeout);
 DECLARE_uint64(rpcRetryTimes);
 
@@ -148,6 +150,12 @@ int ChunkServerClient::GetChunkHash(const Chunk& chunk,
             retryTimes++;
             continue;
         }
+        // chunkserver对数据校验请求做了流控, 过载时等待一段时间后重试
+        if (response.status() == CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD) {
+            retryTimes++;
+            bthread_usleep(FLAGS_rpcTimeout * 1000);
+            continue;
+        }
         if (response.status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
             std::cout << "GetCopysetStatus fail, request: "
                       << request.DebugString()
@@ -393,6 +393,17 @@ int CopysetCheckCore::CheckCopysetsInCluster() {
         std::cout << "ListServersInCluster fail!" << std::endl;
         return -1;
     }
+    if (FLAGS_fanOutConcurrency > 1) {
+        std::vector<ChunkServerInfo> chunkservers;
+        if (mdsClient_->ListChunkServersInCluster(&chunkservers) == 0) {
+            std::vector<std::string> csAddrs;
+            for (const auto& csInfo : chunkservers) {
+                csAddrs.emplace_back(csInfo.hostip() + ":" +
+                                     std::to_string(csInfo.port()));
+            }
+            PrefetchRaftStatus(csAddrs);
+        }
+    }
     for (const auto& serverInfo : servers) {
         const auto& serverId = serverInfo.serverid();
         int res = CheckCopysetsOnServer(serverId, "", false);
@@ -530,8 +541,55 @@ void CopysetCheckCore::ParseResponseAttachment(
     }
 }
 
+void CopysetCheckCore::PrefetchRaftStatus(
+                        const std::vector<std::string>& csAddrs) {
+    FanOutOption option;
+    option.concurrency = FLAGS_fanOutConcurrency;
+    option.deadlineMs = FLAGS_fanOutDeadlineMs;
+    FanOut fanOut(option);
+    std::mutex mtx;
+    std::map<std::string, butil::IOBuf> iobufs;
+    // csClient_不能被多个线程同时使用，每个host用单独的client
+    auto task = [&](const std::string& csAddr) {
+        auto client = csClientFactory_();
+        butil::IOBuf iobuf;
+        if (client->Init(csAddr) != 0 ||
+            client->GetRaftStatus(&iobuf) != 0) {
+            return -1;
+        }
+        std::lock_guard<std::mutex> lk(mtx);
+        iobufs[csAddr].swap(iobuf);
+        return 0;
+    };
+    auto cb = [&](const std::string& csAddr, int ret) {
+        if (ret == kFanOutDeadlineExceeded) {
+            std::cout << "Query chunkserver " << csAddr
+                      << " skipped, deadline exceeded" << std::endl;
+        } else if (ret != 0) {
+            std::cout << "Query chunkserver " << csAddr << " fail"
+                      << std::endl;
+        }
+        auto& item = raftStatusCache_[csAddr];
+        item.first = ret;
+        if (ret == 0) {
+            std::lock_guard<std::mutex> lk(mtx);
+            item.second.swap(iobufs[csAddr]);
+        }
+    };
+    fanOut.Run(csAddrs, task, cb);
+}
+
 int CopysetCheckCore::QueryChunkServer(const std::string& chunkserverAddr,
                                    butil::IOBuf* iobuf) {
+    auto iter = raftStatusCache_.find(chunkserverAddr);
+    if (iter != raftStatusCache_.end()) {
+        if (iter->second.first != 0) {
+            return -1;
+        }
+        iobuf->clear();
+        iobuf->append(iter->second.second);
+        return 0;
+    }
     int res = csClient_->Init(chunkserverAddr);
     if (res != 0) {
         std::cout << "Init chunkserverClient fail!" << std::endl;
@@ -566,6 +624,36 @@ bool CopysetCheckCore::CheckChunkServerOnline(
     return online;
 }
 
+void CopysetCheckCore::CheckChunkServersOnline(
+                        const std::vector<std::string>& csAddrs,
+                        std::map<std::string, bool>* result) {
+    result->clear();
+    if (FLAGS_fanOutConcurrency <= 1) {
+        for (const auto& csAddr : csAddrs) {
+            (*result)[csAddr] = CheckChunkServerOnline(csAddr);
+        }
+        return;
+    }
+    FanOutOption option;
+    option.concurrency = FLAGS_fanOutConcurrency;
+    option.deadlineMs = FLAGS_fanOutDeadlineMs;
+    FanOut fanOut(option);
+    auto task = [this](const std::string& csAddr) {
+        auto client = csClientFactory_();
+        if (client->Init(csAddr) != 0 || !client->CheckChunkServerOnline()) {
+            return -1;
+        }
+        return 0;
+    };
+    auto cb = [&](const std::string& csAddr, int ret) {
+        (*result)[csAddr] = (ret == 0);
+        if (ret != 0) {
+            chunkserverCopysets_[csAddr] = {};
+        }
+    };
+    fanOut.Run(csAddrs, task, cb);
+}
+
 bool CopysetCheckCore::CheckCopySetOnline(const std::string& csAddr,
                                           const std::string& groupId) {
     if (chunkserverCopysets_.count(csAddr) != 0) {
@@ -767,6 +855,7 @@ void CopysetCheckCore::Clear() {
     copysets_.clear();
     serviceExceptionChunkServers_.clear();
     chunkserverCopysets_.clear();
+    raftStatusCache_.clear();
     copysetsDetail_.clear();
 }
 }  // namespace tool
@@ -32,6 +32,8 @@
 #include <algorithm>
 #include <set>
 #include <memory>
+#include <functional>
+#include <mutex>  // NOLINT
 #include <iterator>
 #include <utility>
 
@@ -42,6 +44,7 @@
 #include "src/tools/chunkserver_client.h"
 #include "src/tools/metric_name.h"
 #include "src/tools/curve_tool_define.h"
+#include "src/tools/fan_out.h"
 
 using curve::mds::topology::PoolIdType;
 using curve::mds::topology::CopySetIdType;
@@ -97,11 +100,23 @@ const char kPeersNoSufficient[] = "peers not sufficient";
 const char kMinorityPeerNotOnline[] = "minority peer not online";
 const char kMajorityPeerNotOnline[] = "majority peer not online";
 
+// 并发访问chunkserver时，为每个chunkserver创建单独的client
+using ChunkServerClientFactory =
+                std::function<std::shared_ptr<ChunkServerClient>()>;
+
 class CopysetCheckCore {
  public:
     CopysetCheckCore(std::shared_ptr<MDSClient> mdsClient,
-                     std::shared_ptr<ChunkServerClient> csClient) :
-                        mdsClient_(mdsClient), csClient_(csClient) {}
+                     std::shared_ptr<ChunkServerClient> csClient,
+                     ChunkServerClientFactory csClientFactory = nullptr) :
+                        mdsClient_(mdsClient), csClient_(csClient),
+                        csClientFactory_(csClientFactory) {
+        if (!csClientFactory_) {
+            csClientFactory_ = []() {
+                return std::make_shared<ChunkServerClient>();
+            };
+        }
+    }
     virtual ~CopysetCheckCore() = default;
 
     /**
@@ -229,7 +244,26 @@ class CopysetCheckCore {
     */
     virtual bool CheckChunkServerOnline(const std::string& chunkserverAddr);
 
+    /**
+    * @brief 检查一批chunkserver是否在线，按FLAGS_fanOutConcurrency并发检查，
+    *        超过FLAGS_fanOutDeadlineMs还没有检查的chunkserver按不在线处理
+    *
+    * @param csAddrs chunkserver的地址列表
+    * @param[out] result 每个chunkserver是否在线
+    */
+    virtual void CheckChunkServersOnline(
+                        const std::vector<std::string>& csAddrs,
+                        std::map<std::string, bool>* result);
+
  private:
+    /**
+    * @brief 并发向一批chunkserver发起raft state rpc，结果缓存起来供
+    *        QueryChunkServer使用，避免检查集群时逐个chunkserver串行等待
+    *
+    * @param csAddrs chunkserver的地址列表
+    */
+    void PrefetchRaftStatus(const std::vector<std::string>& csAddrs);
+
     /**
     * @brief 将逻辑池Id和copyset Id转换成groupId
     *
@@ -398,6 +432,9 @@ class CopysetCheckCore {
     // 向chunkserver发送RPC的client
     std::shared_ptr<ChunkServerClient> csClient_;
 
+    // 并发访问chunkserver时创建client，csClient_不能被多个线程同时使用
+    ChunkServerClientFactory csClientFactory_;
+
     // 保存copyset的信息
     std::map<std::string, std::set<std::string>> copysets_;
 
@@ -407,6 +444,8 @@ class CopysetCheckCore {
     std::set<std::string> copysetLoacExceptionChunkServers_;
     // 用来存放访问过的chunkserver上的copyset列表，避免重复RPC
     std::map<std::string, std::set<std::string>> chunkserverCopysets_;
+    // 预先并发获取的chunkserver的raft state，first为rpc的返回值
+    std::map<std::string, std::pair<int, butil::IOBuf>> raftStatusCache_;
 
     // 查询单个copyset的时候，保存复制组的详细信息
     std::string copysetsDetail_;
@@ -37,3 +37,8 @@ DEFINE_string(snapshotCloneDummyPort, "8081", "dummy port of snapshot clone, "
                                     "if specify several, the order should "
                                     "be the same as snapshot clone addr");
 DEFINE_uint64(chunkSize, 16777216, "chunk size");
+DEFINE_uint32(fanOutConcurrency, 32, "max number of chunkservers accessed "
+                                     "concurrently in cluster checks");
+DEFINE_uint64(fanOutDeadlineMs, 0, "deadline in millisecond of accessing all "
+                                   "chunkservers in cluster checks, "
+                                   "0 means no limit");
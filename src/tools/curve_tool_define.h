@@ -33,6 +33,8 @@ DECLARE_uint64(rpcRetryTimes);
 DECLARE_string(snapshotCloneAddr);
 DECLARE_string(snapshotCloneDummyPort);
 DECLARE_uint64(chunkSize);
+DECLARE_uint32(fanOutConcurrency);
+DECLARE_uint64(fanOutDeadlineMs);
 
 namespace curve {
 namespace tool {
@@ -61,6 +63,7 @@ const char kDeleteCmd[] = "delete";
 const char kCreateCmd[] = "create";
 const char kCleanRecycleCmd[] = "clean-recycle";
 const char kChunkLocatitonCmd[] = "chunk-location";
+const char kUpdateThrottleCmd[] = "update-throttle";
 
 // CopysetCheck相关命令
 const char kCheckCopysetCmd[] = "check-copyset";
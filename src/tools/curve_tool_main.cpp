@@ -42,6 +42,7 @@ const char* kHelpStr = "Usage: curve_ops_tool [Command] [OPTIONS...]\n"
         "clean-recycle : clean the RecycleBin\n"
         "create : create file, file length unit is GB\n"
         "chunk-location : query the location of the chunk corresponding to the offset\n"  //NOLINT
+        "update-throttle : update the iops and bps limit of the file, 0 means unlimited\n"  //NOLINT
         "check-consistency : check the consistency of three copies\n"
         "remove-peer : remove the peer from the copyset\n"
         "transfer-leader : transfer the leader of the copyset to the peer\n"  //NOLINT
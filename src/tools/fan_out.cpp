@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#include "src/tools/fan_out.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace tool {
+
+uint32_t FanOut::Run(const std::vector<std::string>& addrs,
+                     const Task& task,
+                     const Callback& cb) {
+    uint64_t startMs = curve::common::TimeUtility::GetTimeofDayMs();
+    auto deadlineExceeded = [&]() {
+        return option_.deadlineMs != 0 &&
+            curve::common::TimeUtility::GetTimeofDayMs() - startMs >=
+                                                        option_.deadlineMs;
+    };
+
+    std::mutex mtx;
+    size_t next = 0;
+    uint32_t finished = 0;
+    auto worker = [&]() {
+        while (true) {
+            size_t index;
+            {
+                std::lock_guard<std::mutex> lk(mtx);
+                if (next >= addrs.size() || deadlineExceeded()) {
+                    return;
+                }
+                index = next++;
+            }
+            int ret = task(addrs[index]);
+            std::lock_guard<std::mutex> lk(mtx);
+            finished++;
+            cb(addrs[index], ret);
+        }
+    };
+
+    uint32_t threadNum = std::min<size_t>(
+                std::max<uint32_t>(option_.concurrency, 1), addrs.size());
+    if (threadNum <= 1) {
+        worker();
+    } else {
+        std::vector<std::unique_ptr<std::thread>> threads;
+        threads.reserve(threadNum);
+        for (uint32_t i = 0; i < threadNum; ++i) {
+            threads.emplace_back(new std::thread(worker));
+        }
+        for (auto& thr : threads) {
+            thr->join();
+        }
+    }
+
+    // 剩下的host没有来得及访问，作为部分结果返回给调用方
+    for (size_t i = next; i < addrs.size(); ++i) {
+        cb(addrs[i], kFanOutDeadlineExceeded);
+    }
+    return finished;
+}
+
+}  // namespace tool
+}  // namespace curve
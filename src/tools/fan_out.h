@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#ifndef SRC_TOOLS_FAN_OUT_H_
+#define SRC_TOOLS_FAN_OUT_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace curve {
+namespace tool {
+
+// 由于超过deadline而没有发起请求的host的返回值
+const int kFanOutDeadlineExceeded = -2;
+
+struct FanOutOption {
+    // 同时访问的host数量，为0或1时在调用线程内串行访问
+    uint32_t concurrency = 1;
+    // 所有host的总超时时间(ms)，超时后不再访问新的host，为0表示不限制。
+    // 单个host的超时由各client自己的rpc超时控制
+    uint64_t deadlineMs = 0;
+};
+
+/**
+ * 对一批host并发执行同一个请求，并发度有上限。每个host的请求完成后立即
+ * 回调，回调之间是串行的，调用方可以直接在回调里输出结果。
+ * 超过deadline后不再访问剩余的host，这些host以kFanOutDeadlineExceeded回调，
+ * 已经发出的请求在各自的rpc超时内结束，所以Run返回时所有回调都已经执行完
+ */
+class FanOut {
+ public:
+    // 访问单个host，返回0表示成功，task会在多个线程中同时执行
+    using Task = std::function<int(const std::string& addr)>;
+    // 单个host的结果
+    using Callback = std::function<void(const std::string& addr, int ret)>;
+
+    explicit FanOut(const FanOutOption& option) : option_(option) {}
+
+    /**
+     * @brief 访问所有的host
+     * @param addrs 要访问的host列表
+     * @param task 访问单个host的请求
+     * @param cb 每个host结束后的回调
+     * @return 在deadline之前访问过的host数量
+     */
+    uint32_t Run(const std::vector<std::string>& addrs,
+                 const Task& task,
+                 const Callback& cb);
+
+ private:
+    FanOutOption option_;
+};
+
+}  // namespace tool
+}  // namespace curve
+
+#endif  // SRC_TOOLS_FAN_OUT_H_
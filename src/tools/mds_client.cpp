@@ -327,6 +327,44 @@ int MDSClient::CreateFile(const std::string& fileName, uint64_t length) {
     return -1;
 }
 
+int MDSClient::UpdateFileThrottleParams(const std::string& fileName,
+                                        uint64_t iopsLimit,
+                                        uint64_t bpsLimit) {
+    curve::mds::UpdateFileThrottleParamsRequest request;
+    curve::mds::UpdateFileThrottleParamsResponse response;
+    request.set_filename(fileName);
+    request.set_iopslimit(iopsLimit);
+    request.set_bpslimit(bpsLimit);
+    // 该接口只能通过root权限调用
+    uint64_t date = curve::common::TimeUtility::GetTimeofDayUs();
+    std::string str2sig = Authenticator::GetString2Signature(date, userName_);
+    std::string sig = Authenticator::CalcString2Signature(str2sig, password_);
+    request.set_rootowner(userName_);
+    request.set_signature(sig);
+    request.set_date(date);
+    curve::mds::CurveFSService_Stub stub(&channel_);
+
+    void (curve::mds::CurveFSService_Stub::*fp)(
+                    google::protobuf::RpcController*,
+                    const curve::mds::UpdateFileThrottleParamsRequest*,
+                    curve::mds::UpdateFileThrottleParamsResponse*,
+                    google::protobuf::Closure*);
+    fp = &curve::mds::CurveFSService_Stub::UpdateFileThrottleParams;
+    if (SendRpcToMds(&request, &response, &stub, fp) != 0) {
+        std::cout << "UpdateFileThrottleParams from all mds fail!"
+                  << std::endl;
+        return -1;
+    }
+
+    if (response.has_statuscode() &&
+                response.statuscode() == StatusCode::kOK) {
+        return 0;
+    }
+    std::cout << "UpdateFileThrottleParams fail with errCode: "
+              << response.statuscode() << std::endl;
+    return -1;
+}
+
 int MDSClient::ListClient(std::vector<std::string>* clientAddrs,
                           bool listClientsInRepo) {
     if (!clientAddrs) {
@@ -27,6 +27,8 @@ DEFINE_bool(forcedelete, false, "force delete file or not");
 DEFINE_uint64(fileLength, 20, "file length (GB)");
 DEFINE_bool(isTest, false, "is unit test or not");
 DEFINE_uint64(offset, 0, "offset to query chunk location");
+DEFINE_uint64(iopsLimit, 0, "iops limit of the file, 0 means unlimited");
+DEFINE_uint64(bpsLimit, 0, "bps limit of the file, 0 means unlimited");
 DEFINE_uint64(rpc_timeout, 3000, "millisecond for rpc timeout");
 DEFINE_bool(showAllocSize, true, "If specified, the allocated size will not be computed");  // NOLINT
 DEFINE_bool(showFileSize, true, "If specified, the file size will not be computed");  // NOLINT
@@ -55,7 +57,8 @@ bool NameSpaceTool::SupportCommand(const std::string& command) {
                                || command == kDeleteCmd
                                || command == kCreateCmd
                                || command == kCleanRecycleCmd
-                               || command == kChunkLocatitonCmd);
+                               || command == kChunkLocatitonCmd
+                               || command == kUpdateThrottleCmd);
 }
 
 // 根据命令行参数选择对应的操作
@@ -105,6 +108,9 @@ int NameSpaceTool::RunCommand(const std::string &cmd) {
         return core_->CreateFile(fileName, FLAGS_fileLength * mds::kGB);
     } else if (cmd == kChunkLocatitonCmd) {
         return PrintChunkLocation(fileName, FLAGS_offset);
+    } else if (cmd == kUpdateThrottleCmd) {
+        return core_->UpdateFileThrottleParams(fileName, FLAGS_iopsLimit,
+                                               FLAGS_bpsLimit);
     } else {
         std::cout << "Command not support!" << std::endl;
         return -1;
@@ -127,6 +133,9 @@ void NameSpaceTool::PrintHelp(const std::string &cmd) {
         std::cout << "curve_ops_tool " << cmd << " -fileName=/test -userName=test -password=123 -forcedelete=true  [-mdsAddr=127.0.0.1:6666] [-confPath=/etc/curve/tools.conf]" << std::endl;  // NOLINT
     } else if (cmd == kChunkLocatitonCmd) {
         std::cout << "curve_ops_tool " << cmd << " -fileName=/test -offset=16777216 [-mdsAddr=127.0.0.1:6666] [-confPath=/etc/curve/tools.conf]" << std::endl;  // NOLINT
+    } else if (cmd == kUpdateThrottleCmd) {
+        std::cout << "curve_ops_tool " << cmd << " -fileName=/test -userName=root -password=123 -iopsLimit=1000 -bpsLimit=104857600 [-mdsAddr=127.0.0.1:6666] [-confPath=/etc/curve/tools.conf]" << std::endl;  // NOLINT
+        std::cout << "0 means unlimited, the new limits take effect after the client refresh session" << std::endl;  // NOLINT
     } else {
         std::cout << "command not found!" << std::endl;
     }
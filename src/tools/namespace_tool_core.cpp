@@ -65,6 +65,12 @@ int NameSpaceToolCore::CreateFile(const std::string& fileName,
     return client_->CreateFile(fileName, length);
 }
 
+int NameSpaceToolCore::UpdateFileThrottleParams(const std::string& fileName,
+                                                uint64_t iopsLimit,
+                                                uint64_t bpsLimit) {
+    return client_->UpdateFileThrottleParams(fileName, iopsLimit, bpsLimit);
+}
+
 int NameSpaceToolCore::GetAllocatedSize(const std::string& fileName,
                                         uint64_t* allocSize,
                                         AllocMap* allocMap) {
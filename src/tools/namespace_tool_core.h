@@ -107,6 +107,17 @@ class NameSpaceToolCore {
      */
     virtual int CreateFile(const std::string& fileName, uint64_t length);
 
+    /**
+     *  @brief 修改文件的iops和带宽限制，需要root权限，client刷新session后生效
+     *  @param fileName 文件名
+     *  @param iopsLimit iops上限，0表示不限制
+     *  @param bpsLimit 带宽上限(bytes/s)，0表示不限制
+     *  @return 成功返回0，失败返回-1
+     */
+    virtual int UpdateFileThrottleParams(const std::string& fileName,
+                                         uint64_t iopsLimit,
+                                         uint64_t bpsLimit);
+
     /**
      *  @brief 计算文件或目录实际分配的空间
      *  @param fileName 文件名
@@ -211,14 +211,23 @@ int StatusTool::ChunkServerListCmd() {
     uint64_t online = 0;
     uint64_t offline = 0;
     uint64_t unstable = 0;
+    std::map<std::string, bool> onlineStatus;
+    if (FLAGS_checkCSAlive) {
+        // 发RPC重置online状态，多个chunkserver并发检查
+        std::vector<std::string> csAddrs;
+        for (const auto& chunkserver : chunkservers) {
+            csAddrs.emplace_back(chunkserver.hostip()
+                        + ":" + std::to_string(chunkserver.port()));
+        }
+        copysetCheckCore_->CheckChunkServersOnline(csAddrs, &onlineStatus);
+    }
     for (auto& chunkserver : chunkservers) {
         auto csId = chunkserver.chunkserverid();
         double unhealthyRatio;
         if (FLAGS_checkCSAlive) {
-            // 发RPC重置online状态
             std::string csAddr = chunkserver.hostip()
                         + ":" + std::to_string(chunkserver.port());
-            bool isOnline = copysetCheckCore_->CheckChunkServerOnline(csAddr);
+            bool isOnline = onlineStatus[csAddr];
             if (isOnline) {
                 chunkserver.set_onlinestate(OnlineState::ONLINE);
             } else {
@@ -666,6 +675,54 @@ int StatusTool::ClientListCmd() {
     return 0;
 }
 
+int StatusTool::GetChunkserverLeftSize(
+                    const std::vector<std::string>& csAddrs,
+                    std::vector<uint64_t>* chunkLeftSize,
+                    std::vector<uint64_t>* walSegmentLeftSize) {
+    FanOutOption option;
+    option.concurrency = FLAGS_fanOutConcurrency;
+    option.deadlineMs = FLAGS_fanOutDeadlineMs;
+    FanOut fanOut(option);
+    std::mutex mtx;
+    // 单位为GB，first为chunkfilepool剩余大小，second为walfilepool剩余大小
+    std::map<std::string, std::pair<uint64_t, uint64_t>> leftSize;
+    auto task = [&](const std::string& csAddr) {
+        std::string metricName = GetCSLeftChunkName(csAddr);
+        uint64_t chunkNum;
+        MetricRet res = metricClient_->GetMetricUint(csAddr,
+                                                     metricName, &chunkNum);
+        if (res != MetricRet::kOK) {
+            return -1;
+        }
+        // walfilepool left size
+        metricName = GetCSLeftWalSegmentName(csAddr);
+        uint64_t walSegmentNum;
+        res = metricClient_->GetMetricUint(csAddr, metricName, &walSegmentNum);
+        if (res != MetricRet::kOK) {
+            return -1;
+        }
+        std::lock_guard<std::mutex> lk(mtx);
+        leftSize[csAddr] = std::make_pair(
+                            chunkNum * FLAGS_chunkSize / mds::kGB,
+                            walSegmentNum * FLAGS_walSegmentSize / mds::kGB);
+        return 0;
+    };
+    int ret = 0;
+    auto cb = [&](const std::string& csAddr, int res) {
+        if (res != 0) {
+            std::cout << "Get left size of chunkserver " << csAddr
+                      << " fail!" << std::endl;
+            ret = -1;
+            return;
+        }
+        std::lock_guard<std::mutex> lk(mtx);
+        chunkLeftSize->emplace_back(leftSize[csAddr].first);
+        walSegmentLeftSize->emplace_back(leftSize[csAddr].second);
+    };
+    fanOut.Run(csAddrs, task, cb);
+    return ret;
+}
+
 int StatusTool::PrintChunkserverStatus(bool checkLeftSize) {
     std::cout << "ChunkServer status:" << std::endl;
     std::string version;
@@ -695,44 +752,29 @@ int StatusTool::PrintChunkserverStatus(bool checkLeftSize) {
     std::vector<uint64_t> chunkLeftSize;
     std::vector<uint64_t> walSegmentLeftSize;
     std::vector<ChunkServerIdType> offlineCs;
-    // 获取chunkserver的online状态
+    std::vector<std::string> csAddrs;
     for (const auto& chunkserver : chunkservers) {
+        csAddrs.emplace_back(chunkserver.hostip()
+                        + ":" + std::to_string(chunkserver.port()));
+    }
+    // 获取chunkserver的online状态
+    std::map<std::string, bool> onlineStatus;
+    copysetCheckCore_->CheckChunkServersOnline(csAddrs, &onlineStatus);
+    for (uint64_t i = 0; i < chunkservers.size(); ++i) {
         total++;
-        std::string csAddr = chunkserver.hostip()
-                        + ":" + std::to_string(chunkserver.port());
-        if (copysetCheckCore_->CheckChunkServerOnline(csAddr)) {
+        if (onlineStatus[csAddrs[i]]) {
             online++;
         } else {
             offline++;
-            offlineCs.emplace_back(chunkserver.chunkserverid());
-        }
-        if (!checkLeftSize) {
-            continue;
-        }
-        std::string metricName = GetCSLeftChunkName(csAddr);
-        uint64_t chunkNum;
-        MetricRet res = metricClient_->GetMetricUint(csAddr,
-                                                     metricName, &chunkNum);
-        if (res != MetricRet::kOK) {
-            std::cout << "Get left chunk size of chunkserver " << csAddr
-                      << " fail!" << std::endl;
-            ret = -1;
-            continue;
+            offlineCs.emplace_back(chunkservers[i].chunkserverid());
         }
-        uint64_t size = chunkNum * FLAGS_chunkSize;
-        chunkLeftSize.emplace_back(size / mds::kGB);
-        // walfilepool left size
-        metricName = GetCSLeftWalSegmentName(csAddr);
-        uint64_t walSegmentNum;
-        res = metricClient_->GetMetricUint(csAddr, metricName, &walSegmentNum);
-        if (res != MetricRet::kOK) {
-            std::cout << "Get left wal segment size of chunkserver " << csAddr
-                      << " fail!" << std::endl;
+    }
+    if (checkLeftSize) {
+        int res = GetChunkserverLeftSize(csAddrs, &chunkLeftSize,
+                                         &walSegmentLeftSize);
+        if (res != 0) {
             ret = -1;
-            continue;
         }
-        size = walSegmentNum * FLAGS_walSegmentSize;
-        walSegmentLeftSize.emplace_back(size / mds::kGB);
     }
     // 获取offline chunkserver的恢复状态
     std::vector<ChunkServerIdType> offlineRecover;
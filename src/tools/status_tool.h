@@ -32,6 +32,8 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <mutex>  // NOLINT
+#include <utility>
 #include "proto/topology.pb.h"
 #include "src/common/timeutility.h"
 #include "src/mds/common/mds_define.h"
@@ -40,6 +42,7 @@
 #include "src/tools/namespace_tool_core.h"
 #include "src/tools/copyset_check_core.h"
 #include "src/tools/etcd_client.h"
+#include "src/tools/fan_out.h"
 #include "src/tools/version_tool.h"
 #include "src/tools/curve_tool.h"
 #include "src/tools/curve_tool_define.h"
@@ -136,6 +139,10 @@ class StatusTool : public CurveTool {
     int PrintMdsStatus();
     int PrintEtcdStatus();
     int PrintChunkserverStatus(bool checkLeftSize = true);
+    // 并发获取chunkserver的chunkfilepool和walfilepool剩余大小，单位GB
+    int GetChunkserverLeftSize(const std::vector<std::string>& csAddrs,
+                               std::vector<uint64_t>* chunkLeftSize,
+                               std::vector<uint64_t>* walSegmentLeftSize);
     int PrintClientStatus();
     int ClientListCmd();
     void PrintCsLeftSizeStatistics(const std::string& name,
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include "test/benchmark/bench_common.h"
+
+#include <glog/logging.h>
+#include <json/json.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#include "src/common/curve_version.h"
+
+DEFINE_string(bench_output, "",
+              "path of the json result, print to stdout if empty");
+DEFINE_string(bench_dir, "/dev/shm/curve_bench",
+              "working directory, tmpfs is recommended to exclude disk noise");
+
+namespace curve {
+namespace benchmark {
+
+namespace {
+const int kSubBucketBits = 4;
+const int kSubBuckets = 1 << kSubBucketBits;
+const int kBucketNum = 64 * kSubBuckets;
+}  // namespace
+
+LatencyHistogram::LatencyHistogram()
+    : buckets_(kBucketNum, 0),
+      count_(0),
+      sum_(0),
+      min_(std::numeric_limits<uint64_t>::max()),
+      max_(0) {}
+
+int LatencyHistogram::BucketIndex(uint64_t us) {
+    if (us < kSubBuckets) {
+        return static_cast<int>(us);
+    }
+    int exp = 63 - __builtin_clzll(us);
+    int sub = (us >> (exp - kSubBucketBits)) & (kSubBuckets - 1);
+    return (exp - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::BucketLowerBound(int index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    int exp = index / kSubBuckets + kSubBucketBits - 1;
+    uint64_t sub = index % kSubBuckets;
+    return (kSubBuckets + sub) << (exp - kSubBucketBits);
+}
+
+void LatencyHistogram::Add(uint64_t us) {
+    ++buckets_[BucketIndex(us)];
+    ++count_;
+    sum_ += us;
+    min_ = std::min(min_, us);
+    max_ = std::max(max_, us);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+    for (int i = 0; i < kBucketNum; ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+uint64_t LatencyHistogram::Percentile(double p) const {
+    if (count_ == 0) {
+        return 0;
+    }
+
+    uint64_t target = static_cast<uint64_t>(count_ * p / 100.0);
+    target = std::max<uint64_t>(target, 1);
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketNum; ++i) {
+        seen += buckets_[i];
+        if (seen >= target) {
+            // 延时统计偏保守，取桶的上界
+            uint64_t upper = i + 1 < kBucketNum
+                                 ? BucketLowerBound(i + 1) - 1
+                                 : max_;
+            return std::min(upper, max_);
+        }
+    }
+    return max_;
+}
+
+void BenchReporter::AddCase(const BenchCase& benchCase) {
+    LOG(INFO) << suite_ << "." << benchCase.name
+              << ": ops = " << benchCase.ops
+              << ", errors = " << benchCase.errors
+              << ", seconds = " << benchCase.seconds
+              << ", avg latency = " << benchCase.latency.Mean() << " us"
+              << ", p99 latency = " << benchCase.latency.Percentile(99)
+              << " us";
+    cases_.push_back(benchCase);
+}
+
+std::string BenchReporter::ToJson() const {
+    Json::Value root;
+    root["suite"] = suite_;
+    root["version"] = curve::common::CurveVersion();
+    root["timestamp"] = Json::UInt64(TimeUtility::GetTimeofDaySec());
+
+    Json::Value cases(Json::arrayValue);
+    for (const auto& c : cases_) {
+        Json::Value item;
+        item["name"] = c.name;
+        Json::Value params(Json::objectValue);
+        for (const auto& param : c.params) {
+            params[param.first] = param.second;
+        }
+        item["params"] = params;
+        item["ops"] = Json::UInt64(c.ops);
+        item["errors"] = Json::UInt64(c.errors);
+        item["bytes"] = Json::UInt64(c.bytes);
+        item["seconds"] = c.seconds;
+        item["iops"] = c.seconds > 0 ? c.ops / c.seconds : 0;
+        item["bandwidth_mbps"] =
+            c.seconds > 0 ? c.bytes / c.seconds / 1024 / 1024 : 0;
+
+        Json::Value latency;
+        latency["min"] = Json::UInt64(c.latency.Min());
+        latency["mean"] = c.latency.Mean();
+        latency["p50"] = Json::UInt64(c.latency.Percentile(50));
+        latency["p90"] = Json::UInt64(c.latency.Percentile(90));
+        latency["p99"] = Json::UInt64(c.latency.Percentile(99));
+        latency["p999"] = Json::UInt64(c.latency.Percentile(99.9));
+        latency["max"] = Json::UInt64(c.latency.Max());
+        item["latency_us"] = latency;
+        cases.append(item);
+    }
+    root["cases"] = cases;
+    return root.toStyledString();
+}
+
+int BenchReporter::Dump(const std::string& path) const {
+    std::string json = ToJson();
+    if (path.empty()) {
+        std::cout << json;
+        return 0;
+    }
+
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        LOG(ERROR) << "open bench output failed, path = " << path;
+        return -1;
+    }
+    out << json;
+    out.close();
+    return out.good() ? 0 : -1;
+}
+
+}  // namespace benchmark
+}  // namespace curve
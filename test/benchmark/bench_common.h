@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#ifndef TEST_BENCHMARK_BENCH_COMMON_H_
+#define TEST_BENCHMARK_BENCH_COMMON_H_
+
+#include <gflags/gflags.h>
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "src/common/timeutility.h"
+
+DECLARE_string(bench_output);
+DECLARE_string(bench_dir);
+
+namespace curve {
+namespace benchmark {
+
+using curve::common::TimeUtility;
+
+// 延时直方图，单位us
+// 每个2的幂区间再等分为16个桶，相对误差不超过1/16，
+// 可以按线程分别统计后合并，合并和分位数计算的结果与样本顺序无关
+class LatencyHistogram {
+ public:
+    LatencyHistogram();
+
+    void Add(uint64_t us);
+
+    void Merge(const LatencyHistogram& other);
+
+    uint64_t Count() const {
+        return count_;
+    }
+
+    uint64_t Min() const {
+        return count_ == 0 ? 0 : min_;
+    }
+
+    uint64_t Max() const {
+        return max_;
+    }
+
+    double Mean() const {
+        return count_ == 0 ? 0 : static_cast<double>(sum_) / count_;
+    }
+
+    /**
+     * 获取分位数
+     * @param: p为分位，取值(0, 100]
+     * @return: 样本所在桶的上界，不超过最大值
+     */
+    uint64_t Percentile(double p) const;
+
+ private:
+    static int BucketIndex(uint64_t us);
+    static uint64_t BucketLowerBound(int index);
+
+ private:
+    std::vector<uint64_t> buckets_;
+    uint64_t count_;
+    uint64_t sum_;
+    uint64_t min_;
+    uint64_t max_;
+};
+
+// 一个测试用例的结果
+struct BenchCase {
+    std::string name;
+    // 用例参数，原样输出到json中
+    std::map<std::string, std::string> params;
+    uint64_t ops = 0;
+    uint64_t bytes = 0;
+    uint64_t errors = 0;
+    double seconds = 0;
+    LatencyHistogram latency;
+};
+
+// 汇总一组用例的结果，输出为json，方便在不同提交之间对比
+class BenchReporter {
+ public:
+    explicit BenchReporter(const std::string& suite) : suite_(suite) {}
+
+    void AddCase(const BenchCase& benchCase);
+
+    std::string ToJson() const;
+
+    /**
+     * 输出结果
+     * @param: path为输出文件路径，为空时输出到标准输出
+     * @return: 成功返回0，否则返回-1
+     */
+    int Dump(const std::string& path) const;
+
+ private:
+    std::string suite_;
+    std::vector<BenchCase> cases_;
+};
+
+/**
+ * 单线程循环执行ops次操作，记录每次操作的延时
+ * @param: ops为执行次数
+ * @param: fn为单次操作，返回处理的字节数，小于0表示失败
+ * @param[out]: benchCase记录结果
+ */
+template <typename Fn>
+void RunLoop(uint64_t ops, Fn fn, BenchCase* benchCase) {
+    const uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    for (uint64_t i = 0; i < ops; ++i) {
+        const uint64_t opStartUs = TimeUtility::GetTimeofDayUs();
+        int64_t ret = fn(i);
+        benchCase->latency.Add(TimeUtility::GetTimeofDayUs() - opStartUs);
+        if (ret < 0) {
+            ++benchCase->errors;
+            continue;
+        }
+        ++benchCase->ops;
+        benchCase->bytes += ret;
+    }
+    benchCase->seconds =
+        (TimeUtility::GetTimeofDayUs() - startUs) / 1000000.0;
+}
+
+}  // namespace benchmark
+}  // namespace curve
+
+#endif  // TEST_BENCHMARK_BENCH_COMMON_H_
@@ -0,0 +1,413 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+/*
+ * client端到端的性能测试，类似fio。默认在进程内启动fake mds提供元数据，
+ * 与test/integration中的PeerCluster一样以独立进程启动3个真实的chunkserver，
+ * 需要在代码根目录下先编译出bazel-bin/src/chunkserver/chunkserver再运行；
+ * 也可以通过--cluster=remote对真实集群进行测试，例如：
+ *   client_bench --rw=randwrite --io_size=4096 --iodepth=32 --runtime_s=30
+ *   client_bench --cluster=remote --conf=conf/client.conf \
+ *       --filename=/bench --rw=randrw --rwmixread=70
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <condition_variable>  // NOLINT
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "include/client/libcurve.h"
+#include "test/benchmark/bench_common.h"
+#include "test/client/fake/fakeMDS.h"
+#include "test/integration/common/config_generator.h"
+#include "test/integration/common/peer_cluster.h"
+
+DECLARE_uint64(test_disk_size);
+DECLARE_bool(fake_chunkserver);
+DECLARE_string(chunkserver_list);
+DECLARE_uint32(copyset_num);
+DECLARE_uint32(logic_pool_id);
+
+DEFINE_string(cluster, "local",
+              "local: fake mds in process and chunkserver processes, "
+              "remote: an existing cluster specified by --conf");
+DEFINE_string(conf, "./conf/client.conf",
+              "client config path of the remote cluster");
+DEFINE_string(filename, "/1_userinfo_", "file to test, must be full path");
+DEFINE_string(owner, "userinfo", "owner of the file");
+DEFINE_uint64(file_size, 10 * 1024 * 1024 * 1024ul, "size of the file");
+DEFINE_uint32(io_size, 4096, "size of each io");
+DEFINE_uint32(iodepth, 32, "inflight ios of each thread");
+DEFINE_uint32(threads, 1, "number of io threads");
+DEFINE_string(rw, "randwrite",
+              "io pattern: read/write/randread/randwrite/randrw");
+DEFINE_uint32(rwmixread, 50, "percentage of reads in randrw");
+DEFINE_uint32(runtime_s, 10, "duration of the test");
+
+// fake mds使用的全局配置
+std::string mdsMetaServerAddr = "127.0.0.1:9180";  // NOLINT
+uint32_t chunk_size = 16 * 1024 * 1024;            // NOLINT
+uint32_t segment_size = 1 * 1024 * 1024 * 1024;    // NOLINT
+
+using curve::benchmark::BenchCase;
+using curve::benchmark::BenchReporter;
+using curve::benchmark::LatencyHistogram;
+using curve::chunkserver::PeerCluster;
+using curve::common::Peer;
+using curve::common::TimeUtility;
+
+namespace {
+
+const char kLocalLogDir[] = "./runlog/client_bench";
+const char kLocalClientConf[] = "./runlog/client_bench/client.conf";
+
+/**
+ * 本地集群：进程内的fake mds只负责元数据，读写请求发到chunkserver进程，
+ * chunkserver的数据目录与PeerCluster一样为当前目录下以端口命名的目录
+ */
+class LocalCluster {
+ public:
+    ~LocalCluster() {
+        Stop();
+    }
+
+    bool Start() {
+        braft::Configuration conf;
+        if (conf.parse_from(FLAGS_chunkserver_list) != 0) {
+            LOG(ERROR) << "parse chunkserver list failed, list = "
+                       << FLAGS_chunkserver_list;
+            return false;
+        }
+        std::vector<braft::PeerId> peerIds;
+        conf.list_peers(&peerIds);
+
+        ::system((std::string("mkdir -p ") + kLocalLogDir).c_str());
+        std::map<int, int> paramsIndexs;
+        for (size_t i = 0; i < peerIds.size(); ++i) {
+            std::string ip = butil::ip2str(peerIds[i].addr.ip).c_str();
+            std::string port = std::to_string(peerIds[i].addr.port);
+            ::system(("rm -rf " + port + " && mkdir " + port).c_str());
+
+            curve::CSTConfigGenerator cg;
+            if (!cg.Init(port)) {
+                LOG(ERROR) << "load chunkserver config template failed";
+                return false;
+            }
+            cg.SetKV("mds.listen.addr", mdsMetaServerAddr);
+            cg.SetKV("chunkserver.common.logDir", kLocalLogDir);
+            if (!cg.Generate()) {
+                LOG(ERROR) << "generate chunkserver config failed";
+                return false;
+            }
+
+            std::string dir = "./" + port + "/";
+            args_.push_back({
+                "chunkserver",
+                "-chunkServerIp=" + ip,
+                "-chunkServerPort=" + port,
+                "-chunkServerStoreUri=local://" + dir,
+                "-chunkServerMetaUri=local://" + dir + "chunkserver.dat",
+                "-copySetUri=local://" + dir + "copysets",
+                "-raftSnapshotUri=curve://" + dir + "copysets",
+                "-raftLogUri=curve://" + dir + "copysets",
+                "-recycleUri=local://" + dir + "recycler",
+                "-chunkFilePoolDir=" + dir + "chunkfilepool/",
+                "-chunkFilePoolMetaPath=" + dir + "chunkfilepool.meta",
+                "-walFilePoolDir=" + dir + "walfilepool/",
+                "-walFilePoolMetaPath=" + dir + "walfilepool.meta",
+                "-conf=" + dir + "chunkserver.conf",
+                "-mdsListenAddr=" + mdsMetaServerAddr,
+                "-enableChunkfilepool=false",
+                "-enableWalfilepool=false",
+                "-raft_sync_segments=true",
+            });
+            Peer peer;
+            peer.set_address(peerIds[i].to_string());
+            peers_.push_back(peer);
+            paramsIndexs[PeerCluster::PeerToId(peer)] = i;
+        }
+        // args_不再修改后再取参数的地址
+        std::vector<char**> params;
+        argvs_.resize(args_.size());
+        for (size_t i = 0; i < args_.size(); ++i) {
+            for (auto& arg : args_[i]) {
+                argvs_[i].push_back(&arg[0]);
+            }
+            argvs_[i].push_back(nullptr);
+            params.push_back(argvs_[i].data());
+        }
+
+        // mds需要先于chunkserver启动，chunkserver启动后即开始发送心跳
+        FLAGS_fake_chunkserver = false;
+        FLAGS_test_disk_size = FLAGS_file_size;
+        mds_.reset(new FakeMDS(FLAGS_filename));
+        mds_->Initialize();
+        mds_->StartService();
+
+        cluster_.reset(new PeerCluster("client_bench", FLAGS_logic_pool_id,
+                                       0, peers_, params, paramsIndexs));
+        for (auto& peer : peers_) {
+            if (cluster_->StartPeer(peer, PeerCluster::PeerToId(peer)) != 0) {
+                LOG(ERROR) << "start chunkserver " << peer.address()
+                           << " failed";
+                return false;
+            }
+        }
+
+        // 按fake mds返回的拓扑在chunkserver上创建全部复制组，并等待选出leader
+        mds_->CreateCopysetNode();
+        for (uint32_t i = 0; i < FLAGS_copyset_num; ++i) {
+            Peer leader;
+            cluster_->SetWorkingCopyset(i);
+            if (cluster_->WaitLeader(&leader) != 0) {
+                LOG(ERROR) << "copyset " << i << " has no leader";
+                return false;
+            }
+        }
+
+        curve::ClientConfigGenerator cg(kLocalClientConf);
+        cg.SetKV("mds.listen.addr", mdsMetaServerAddr);
+        cg.SetKV("global.logPath", kLocalLogDir);
+        if (!cg.Generate()) {
+            LOG(ERROR) << "generate client config failed";
+            return false;
+        }
+        return true;
+    }
+
+    void Stop() {
+        if (cluster_) {
+            cluster_->StopAllPeers();
+            cluster_.reset();
+        }
+        if (mds_) {
+            mds_->UnInitialize();
+            mds_.reset();
+        }
+        for (auto& peer : peers_) {
+            std::string port = std::to_string(PeerCluster::PeerToId(peer));
+            ::system(("rm -rf " + port).c_str());
+        }
+        peers_.clear();
+    }
+
+ private:
+    std::vector<Peer> peers_;
+    // chunkserver进程的启动参数，execv要求以nullptr结尾的char*数组
+    std::vector<std::vector<std::string>> args_;
+    std::vector<std::vector<char*>> argvs_;
+    std::unique_ptr<FakeMDS> mds_;
+    std::unique_ptr<PeerCluster> cluster_;
+};
+
+struct Worker;
+
+// ctx必须是第一个成员，回调中由CurveAioContext*转换回BenchIo*
+struct BenchIo {
+    CurveAioContext ctx;
+    uint64_t startUs;
+    Worker* worker;
+};
+
+struct Worker {
+    std::mutex mtx;
+    std::condition_variable cv;
+    // 空闲的请求槽位，请求可能乱序完成，完成后放回
+    std::vector<BenchIo*> freeIos;
+    uint64_t ops = 0;
+    uint64_t bytes = 0;
+    uint64_t errors = 0;
+    LatencyHistogram latency;
+};
+
+void BenchCallback(CurveAioContext* context) {
+    BenchIo* io = reinterpret_cast<BenchIo*>(context);
+    Worker* worker = io->worker;
+    uint64_t latencyUs = TimeUtility::GetTimeofDayUs() - io->startUs;
+    {
+        std::lock_guard<std::mutex> lk(worker->mtx);
+        worker->latency.Add(latencyUs);
+        if (context->ret < 0) {
+            ++worker->errors;
+        } else {
+            ++worker->ops;
+            worker->bytes += context->length;
+        }
+        worker->freeIos.push_back(io);
+    }
+    worker->cv.notify_one();
+}
+
+/**
+ * 单个io线程，保持iodepth个请求在途直到运行时间结束
+ * @param: fd为打开的文件
+ * @param: index为线程编号，顺序读写时每个线程负责文件的一段
+ * @param: worker记录结果
+ */
+void RunWorker(int fd, uint32_t index, Worker* worker) {
+    const bool random = FLAGS_rw.compare(0, 4, "rand") == 0;
+    const uint64_t blocks = FLAGS_file_size / FLAGS_io_size;
+    const uint64_t blocksPerThread = blocks / FLAGS_threads;
+    uint32_t readPercent = 0;
+    if (FLAGS_rw == "read" || FLAGS_rw == "randread") {
+        readPercent = 100;
+    } else if (FLAGS_rw == "randrw") {
+        readPercent = FLAGS_rwmixread;
+    }
+
+    std::mt19937_64 rand(index);
+    std::vector<std::unique_ptr<BenchIo>> ios(FLAGS_iodepth);
+    std::vector<std::unique_ptr<char[]>> bufs(FLAGS_iodepth);
+    for (uint32_t i = 0; i < FLAGS_iodepth; ++i) {
+        bufs[i].reset(new char[FLAGS_io_size]);
+        memset(bufs[i].get(), 'a' + i % 26, FLAGS_io_size);
+        ios[i].reset(new BenchIo());
+        ios[i]->worker = worker;
+        ios[i]->ctx.buf = bufs[i].get();
+        ios[i]->ctx.length = FLAGS_io_size;
+        ios[i]->ctx.cb = BenchCallback;
+        worker->freeIos.push_back(ios[i].get());
+    }
+
+    const uint64_t endUs =
+        TimeUtility::GetTimeofDayUs() + FLAGS_runtime_s * 1000000ul;
+    uint64_t seq = 0;
+    while (TimeUtility::GetTimeofDayUs() < endUs) {
+        BenchIo* io = nullptr;
+        {
+            std::unique_lock<std::mutex> lk(worker->mtx);
+            worker->cv.wait(lk, [&]() { return !worker->freeIos.empty(); });
+            io = worker->freeIos.back();
+            worker->freeIos.pop_back();
+        }
+        uint64_t block = random ? rand() % blocks
+            : index * blocksPerThread + seq++ % blocksPerThread;
+        io->ctx.offset = block * FLAGS_io_size;
+        io->startUs = TimeUtility::GetTimeofDayUs();
+
+        int ret;
+        if (rand() % 100 < readPercent) {
+            io->ctx.op = LIBCURVE_OP_READ;
+            ret = AioRead(fd, &io->ctx);
+        } else {
+            io->ctx.op = LIBCURVE_OP_WRITE;
+            ret = AioWrite(fd, &io->ctx);
+        }
+        if (ret < 0) {
+            std::lock_guard<std::mutex> lk(worker->mtx);
+            ++worker->errors;
+            worker->freeIos.push_back(io);
+        }
+    }
+
+    // 等待在途请求完成
+    std::unique_lock<std::mutex> lk(worker->mtx);
+    worker->cv.wait(lk, [&]() {
+        return worker->freeIos.size() == FLAGS_iodepth;
+    });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+
+    if (FLAGS_io_size == 0 || FLAGS_iodepth == 0 || FLAGS_threads == 0 ||
+        FLAGS_file_size / FLAGS_io_size < FLAGS_threads) {
+        LOG(ERROR) << "invalid io_size/iodepth/threads/file_size";
+        return -1;
+    }
+
+    std::string confPath = FLAGS_conf;
+    std::unique_ptr<LocalCluster> localCluster;
+    if (FLAGS_cluster == "local") {
+        localCluster.reset(new LocalCluster());
+        if (!localCluster->Start()) {
+            LOG(ERROR) << "start local cluster failed";
+            return -1;
+        }
+        confPath = kLocalClientConf;
+    } else if (FLAGS_cluster != "remote") {
+        LOG(ERROR) << "invalid cluster " << FLAGS_cluster;
+        return -1;
+    }
+
+    if (Init(confPath.c_str()) != 0) {
+        LOG(ERROR) << "init client failed, conf = " << confPath;
+        return -1;
+    }
+
+    C_UserInfo_t userinfo;
+    memset(&userinfo, 0, sizeof(userinfo));
+    snprintf(userinfo.owner, sizeof(userinfo.owner), "%s",
+             FLAGS_owner.c_str());
+    // 文件可能已经存在，由后面的Open判断是否可用
+    Create(FLAGS_filename.c_str(), &userinfo, FLAGS_file_size);
+    int fd = Open(FLAGS_filename.c_str(), &userinfo);
+    if (fd < 0) {
+        LOG(ERROR) << "open " << FLAGS_filename << " failed";
+        UnInit();
+        return -1;
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    const uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    for (uint32_t i = 0; i < FLAGS_threads; ++i) {
+        workers.emplace_back(new Worker());
+        threads.emplace_back(RunWorker, fd, i, workers.back().get());
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    BenchCase c;
+    c.name = FLAGS_rw;
+    c.seconds = (TimeUtility::GetTimeofDayUs() - startUs) / 1000000.0;
+    for (auto& worker : workers) {
+        c.ops += worker->ops;
+        c.bytes += worker->bytes;
+        c.errors += worker->errors;
+        c.latency.Merge(worker->latency);
+    }
+    c.params["cluster"] = FLAGS_cluster;
+    c.params["file_size"] = std::to_string(FLAGS_file_size);
+    c.params["io_size"] = std::to_string(FLAGS_io_size);
+    c.params["iodepth"] = std::to_string(FLAGS_iodepth);
+    c.params["threads"] = std::to_string(FLAGS_threads);
+    c.params["rwmixread"] = std::to_string(FLAGS_rwmixread);
+
+    BenchReporter reporter("client");
+    reporter.AddCase(c);
+
+    Close(fd);
+    UnInit();
+    return reporter.Dump(FLAGS_bench_output);
+}
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+/*
+ * 并发apply模块的吞吐测试：按chunk把读写任务分发到apply线程，统计
+ * 任务从push到执行完成的延时，例如：
+ *   concurrent_apply_bench --tasks=1000000 --task_us=0
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "proto/chunk.pb.h"
+#include "src/chunkserver/concurrent_apply/concurrent_apply.h"
+#include "src/common/concurrent/count_down_event.h"
+#include "test/benchmark/bench_common.h"
+
+DEFINE_uint64(tasks, 1000000, "number of tasks pushed by each case");
+DEFINE_uint32(chunk_num, 1024, "number of distinct chunks");
+DEFINE_uint32(task_us, 0, "busy time of each task, simulate the io cost");
+DEFINE_int32(wconcurrentsize, 10, "number of write apply threads");
+DEFINE_int32(wqueuedepth, 1, "queue depth of each write apply thread");
+DEFINE_int32(rconcurrentsize, 5, "number of read apply threads");
+DEFINE_int32(rqueuedepth, 1, "queue depth of each read apply thread");
+DEFINE_uint32(rstripesize, 1048576, "stripe size to spread reads");
+
+using curve::benchmark::BenchCase;
+using curve::benchmark::BenchReporter;
+using curve::chunkserver::CHUNK_OP_TYPE;
+using curve::chunkserver::concurrent::ConcurrentApplyModule;
+using curve::chunkserver::concurrent::ConcurrentApplyOption;
+using curve::common::CountDownEvent;
+using curve::common::TimeUtility;
+
+namespace {
+
+void Busy(uint32_t us) {
+    if (us == 0) {
+        return;
+    }
+    uint64_t end = TimeUtility::GetTimeofDayUs() + us;
+    while (TimeUtility::GetTimeofDayUs() < end) {}
+}
+
+/**
+ * 执行一个用例
+ * @param: name为用例名称
+ * @param: readPercent为读任务的比例
+ * @param: reporter记录结果
+ */
+bool RunCase(const std::string& name, uint32_t readPercent,
+             BenchReporter* reporter) {
+    ConcurrentApplyOption opt{FLAGS_wconcurrentsize, FLAGS_wqueuedepth,
+                              FLAGS_rconcurrentsize, FLAGS_rqueuedepth,
+                              FLAGS_rstripesize};
+    ConcurrentApplyModule module;
+    if (!module.Init(opt)) {
+        LOG(ERROR) << "init concurrent apply module failed";
+        return false;
+    }
+
+    // 每个任务写自己的槽位，避免统计本身引入竞争
+    std::vector<uint32_t> latencies(FLAGS_tasks, 0);
+    CountDownEvent done(FLAGS_tasks);
+    std::mt19937_64 rand(0);
+
+    const uint64_t chunkSize = 16 * 1024 * 1024;
+    const uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    for (uint64_t i = 0; i < FLAGS_tasks; ++i) {
+        bool isRead = rand() % 100 < readPercent;
+        uint64_t chunkId = rand() % FLAGS_chunk_num;
+        uint64_t offset = rand() % chunkSize;
+        uint64_t pushUs = TimeUtility::GetTimeofDayUs();
+        auto task = [&latencies, &done, i, pushUs]() {
+            Busy(FLAGS_task_us);
+            latencies[i] = TimeUtility::GetTimeofDayUs() - pushUs;
+            done.Signal();
+        };
+        module.Push(chunkId, offset,
+                    isRead ? CHUNK_OP_TYPE::CHUNK_OP_READ
+                           : CHUNK_OP_TYPE::CHUNK_OP_WRITE,
+                    task);
+    }
+    done.Wait();
+
+    BenchCase c;
+    c.name = name;
+    c.seconds = (TimeUtility::GetTimeofDayUs() - startUs) / 1000000.0;
+    c.ops = FLAGS_tasks;
+    for (auto latency : latencies) {
+        c.latency.Add(latency);
+    }
+    c.params["read_percent"] = std::to_string(readPercent);
+    c.params["chunk_num"] = std::to_string(FLAGS_chunk_num);
+    c.params["task_us"] = std::to_string(FLAGS_task_us);
+    c.params["wconcurrentsize"] = std::to_string(FLAGS_wconcurrentsize);
+    c.params["wqueuedepth"] = std::to_string(FLAGS_wqueuedepth);
+    c.params["rconcurrentsize"] = std::to_string(FLAGS_rconcurrentsize);
+    c.params["rqueuedepth"] = std::to_string(FLAGS_rqueuedepth);
+    c.params["rstripesize"] = std::to_string(FLAGS_rstripesize);
+    reporter->AddCase(c);
+
+    module.Stop();
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+    google::InitGoogleLogging(argv[0]);
+
+    BenchReporter reporter("concurrent_apply");
+    if (!RunCase("write", 0, &reporter) ||
+        !RunCase("read", 100, &reporter) ||
+        !RunCase("mixed", 30, &reporter)) {
+        return -1;
+    }
+    return reporter.Dump(FLAGS_bench_output);
+}
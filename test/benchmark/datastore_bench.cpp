@@ -0,0 +1,393 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+/*
+ * datastore的微基准测试，覆盖chunk文件的写、读、快照cow和clone chunk
+ * 的写入路径，结果以json输出，例如：
+ *   datastore_bench --bench_dir=/dev/shm/curve_bench \
+ *                   --bench_output=datastore.json
+ * 指定max_open_files小于chunk_num时，随机读写会因fd被淘汰而重新打开文件
+ * meta_lookup用例统计每个chunk的元数据内存(换算为每TB数据的内存)和并发
+ * 查找CSMetaCache的延时
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <butil/iobuf.h>
+
+#include <unistd.h>
+
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/chunkserver/datastore/chunkserver_datastore.h"
+#include "src/chunkserver/datastore/chunkfile_fd_cache.h"
+#include "src/chunkserver/datastore/file_pool.h"
+#include "src/fs/local_filesystem.h"
+#include "test/benchmark/bench_common.h"
+
+DEFINE_uint32(chunk_num, 16, "number of chunks used by each case");
+DEFINE_uint32(io_size, 4096, "size of each read/write");
+DEFINE_uint64(ops, 20000, "number of operations of each case");
+DEFINE_uint32(cow_unit_size, 65536, "cow unit size of snapshot");
+DEFINE_uint32(chunk_size, 16 * 1024 * 1024, "chunk size");
+DEFINE_uint32(page_size, 4096, "page size");
+DEFINE_uint32(max_open_files, 0,
+              "capacity of chunk fd cache, 0 means unlimited");
+DEFINE_uint32(meta_chunk_num, 65536,
+              "number of chunks in metacache of meta_lookup case");
+DEFINE_uint32(meta_shard_num, 32, "shard number of metacache");
+DEFINE_uint32(meta_threads, 8, "number of lookup threads");
+
+using curve::benchmark::BenchCase;
+using curve::benchmark::BenchReporter;
+using curve::benchmark::LatencyHistogram;
+using curve::benchmark::RunLoop;
+using curve::chunkserver::ChunkFdCache;
+using curve::chunkserver::ChunkID;
+using curve::chunkserver::ChunkOptions;
+using curve::chunkserver::CSChunkFile;
+using curve::chunkserver::CSDataStore;
+using curve::chunkserver::CSErrorCode;
+using curve::chunkserver::CSMetaCache;
+using curve::chunkserver::DataStoreOptions;
+using curve::chunkserver::FilePool;
+using curve::chunkserver::FilePoolOptions;
+using curve::common::TimeUtility;
+using curve::fs::FileSystemType;
+using curve::fs::LocalFileSystem;
+using curve::fs::LocalFsFactory;
+
+namespace {
+
+// 不同用例使用不同范围的chunk id，互不影响
+const ChunkID kDataChunkBase = 1;
+const ChunkID kCloneChunkBase = 100000;
+
+BenchCase NewCase(const std::string& name) {
+    BenchCase benchCase;
+    benchCase.name = name;
+    benchCase.params["chunk_num"] = std::to_string(FLAGS_chunk_num);
+    benchCase.params["io_size"] = std::to_string(FLAGS_io_size);
+    benchCase.params["chunk_size"] = std::to_string(FLAGS_chunk_size);
+    benchCase.params["page_size"] = std::to_string(FLAGS_page_size);
+    benchCase.params["max_open_files"] = std::to_string(FLAGS_max_open_files);
+    return benchCase;
+}
+
+// 进程当前的常驻内存，单位字节
+uint64_t GetRssBytes() {
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+class DataStoreBench {
+ public:
+    DataStoreBench() : rand_(0), reporter_("datastore") {}
+
+    bool Init() {
+        lfs_ = LocalFsFactory::CreateFs(FileSystemType::EXT4, "");
+        lfs_->Delete(FLAGS_bench_dir);
+        if (lfs_->Mkdir(FLAGS_bench_dir) != 0) {
+            LOG(ERROR) << "mkdir failed, dir = " << FLAGS_bench_dir;
+            return false;
+        }
+
+        // 不预先分配chunk，创建chunk时直接分配文件
+        FilePoolOptions poolOpt;
+        poolOpt.getFileFromPool = false;
+        poolOpt.fileSize = FLAGS_chunk_size;
+        poolOpt.metaPageSize = FLAGS_page_size;
+        std::string poolDir = FLAGS_bench_dir + "/pool";
+        snprintf(poolOpt.filePoolDir, sizeof(poolOpt.filePoolDir), "%s",
+                 poolDir.c_str());
+        filePool_ = std::make_shared<FilePool>(lfs_);
+        if (!filePool_->Initialize(poolOpt)) {
+            LOG(ERROR) << "init file pool failed";
+            return false;
+        }
+
+        DataStoreOptions options;
+        options.baseDir = FLAGS_bench_dir + "/data";
+        options.chunkSize = FLAGS_chunk_size;
+        options.pageSize = FLAGS_page_size;
+        options.locationLimit = 3000;
+        options.cowUnitSize = FLAGS_cow_unit_size;
+        if (FLAGS_max_open_files > 0) {
+            fdCache_ = std::make_shared<ChunkFdCache>(lfs_,
+                                                      FLAGS_max_open_files);
+            options.fdCache = fdCache_;
+        }
+        dataStore_ = std::make_shared<CSDataStore>(lfs_, filePool_, options);
+        if (!dataStore_->Initialize()) {
+            LOG(ERROR) << "init datastore failed";
+            return false;
+        }
+
+        buf_.assign(FLAGS_io_size, 'a');
+        return true;
+    }
+
+    void UnInit() {
+        dataStore_ = nullptr;
+        filePool_->UnInitialize();
+        lfs_->Delete(FLAGS_bench_dir);
+    }
+
+    void Run() {
+        const uint64_t chunkSize = FLAGS_chunk_size;
+        const uint64_t ioPerChunk = chunkSize / FLAGS_io_size;
+
+        // 第一次写chunk，包括从filepool获取文件和写metapage
+        {
+            BenchCase c = NewCase("create_chunk");
+            RunLoop(FLAGS_chunk_num, [&](uint64_t i) {
+                return Write(kDataChunkBase + i, 1, 0);
+            }, &c);
+            reporter_.AddCase(c);
+        }
+
+        {
+            BenchCase c = NewCase("write_seq");
+            RunLoop(FLAGS_ops, [&](uint64_t i) {
+                uint64_t n = i % (ioPerChunk * FLAGS_chunk_num);
+                return Write(kDataChunkBase + n / ioPerChunk, 1,
+                             n % ioPerChunk * FLAGS_io_size);
+            }, &c);
+            reporter_.AddCase(c);
+        }
+
+        {
+            BenchCase c = NewCase("write_rand");
+            RunLoop(FLAGS_ops, [&](uint64_t) {
+                return Write(RandChunk(kDataChunkBase), 1, RandOffset());
+            }, &c);
+            reporter_.AddCase(c);
+        }
+
+        {
+            BenchCase c = NewCase("read_seq");
+            RunLoop(FLAGS_ops, [&](uint64_t i) {
+                uint64_t n = i % (ioPerChunk * FLAGS_chunk_num);
+                return Read(kDataChunkBase + n / ioPerChunk,
+                            n % ioPerChunk * FLAGS_io_size);
+            }, &c);
+            reporter_.AddCase(c);
+        }
+
+        {
+            BenchCase c = NewCase("read_rand");
+            RunLoop(FLAGS_ops, [&](uint64_t) {
+                return Read(RandChunk(kDataChunkBase), RandOffset());
+            }, &c);
+            reporter_.AddCase(c);
+        }
+
+        // 用更大的版本号写，第一次写会创建快照，每个cow单元第一次写需要拷贝
+        {
+            BenchCase c = NewCase("write_cow");
+            c.params["cow_unit_size"] = std::to_string(FLAGS_cow_unit_size);
+            RunLoop(FLAGS_ops, [&](uint64_t) {
+                return Write(RandChunk(kDataChunkBase), 2, RandOffset());
+            }, &c);
+            reporter_.AddCase(c);
+
+            for (uint32_t i = 0; i < FLAGS_chunk_num; ++i) {
+                dataStore_->DeleteSnapshotChunkOrCorrectSn(
+                    kDataChunkBase + i, 2);
+            }
+        }
+
+        {
+            BenchCase c = NewCase("create_clone_chunk");
+            RunLoop(FLAGS_chunk_num, [&](uint64_t i) {
+                CSErrorCode ret = dataStore_->CreateCloneChunk(
+                    kCloneChunkBase + i, 1, 0, FLAGS_chunk_size,
+                    "/bench/clonesource@cs");
+                return ret == CSErrorCode::Success ? 0 : -1;
+            }, &c);
+            reporter_.AddCase(c);
+        }
+
+        // clone chunk的写需要更新bitmap
+        {
+            BenchCase c = NewCase("write_clone");
+            RunLoop(FLAGS_ops, [&](uint64_t) {
+                return Write(RandChunk(kCloneChunkBase), 1, RandOffset());
+            }, &c);
+            reporter_.AddCase(c);
+        }
+
+        {
+            BenchCase c = NewCase("paste_clone");
+            RunLoop(FLAGS_ops, [&](uint64_t) {
+                CSErrorCode ret = dataStore_->PasteChunk(
+                    RandChunk(kCloneChunkBase), buf_.data(), RandOffset(),
+                    FLAGS_io_size);
+                return ret == CSErrorCode::Success
+                           ? static_cast<int64_t>(FLAGS_io_size) : -1;
+            }, &c);
+            reporter_.AddCase(c);
+        }
+
+        RunMetaLookup();
+    }
+
+    int Dump() {
+        return reporter_.Dump(FLAGS_bench_output);
+    }
+
+ private:
+    /**
+     * 在metacache中放入meta_chunk_num个未打开文件的chunk，统计每个chunk
+     * 的元数据内存，然后多个线程并发随机查找
+     * 单次查找远小于1us，按每1000次查找计时，latency的单位为ns/次
+     */
+    void RunMetaLookup() {
+        const uint64_t kBatch = 1000;
+        BenchCase c = NewCase("meta_lookup");
+        c.params["meta_chunk_num"] = std::to_string(FLAGS_meta_chunk_num);
+        c.params["meta_shard_num"] = std::to_string(FLAGS_meta_shard_num);
+        c.params["meta_threads"] = std::to_string(FLAGS_meta_threads);
+        c.params["latency_unit"] = "ns";
+
+        const uint64_t rssBefore = GetRssBytes();
+        CSMetaCache metaCache(FLAGS_meta_shard_num);
+        ChunkOptions options;
+        options.baseDir = FLAGS_bench_dir + "/data";
+        options.chunkSize = FLAGS_chunk_size;
+        options.pageSize = FLAGS_page_size;
+        options.sn = 1;
+        for (uint32_t i = 0; i < FLAGS_meta_chunk_num; ++i) {
+            options.id = kDataChunkBase + i;
+            metaCache.Set(options.id, std::make_shared<CSChunkFile>(
+                lfs_, filePool_, options));
+        }
+        const uint64_t rssAfter = GetRssBytes();
+        const uint64_t bytesPerChunk = rssAfter > rssBefore
+            ? (rssAfter - rssBefore) / FLAGS_meta_chunk_num : 0;
+        const uint64_t chunksPerTB = (1ULL << 40) / FLAGS_chunk_size;
+        c.params["meta_bytes_per_chunk"] = std::to_string(bytesPerChunk);
+        c.params["meta_mb_per_tb"] =
+            std::to_string(bytesPerChunk * chunksPerTB >> 20);
+
+        const uint64_t batches =
+            FLAGS_ops / kBatch / FLAGS_meta_threads + 1;
+        std::vector<LatencyHistogram> latencies(FLAGS_meta_threads);
+        std::vector<std::thread> threads;
+        const uint64_t startUs = TimeUtility::GetTimeofDayUs();
+        for (uint32_t t = 0; t < FLAGS_meta_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                std::mt19937_64 rand(t);
+                for (uint64_t b = 0; b < batches; ++b) {
+                    uint64_t batchStartUs = TimeUtility::GetTimeofDayUs();
+                    for (uint64_t i = 0; i < kBatch; ++i) {
+                        ChunkID id = kDataChunkBase +
+                                     rand() % FLAGS_meta_chunk_num;
+                        CHECK(metaCache.Get(id) != nullptr);
+                    }
+                    latencies[t].Add(TimeUtility::GetTimeofDayUs() -
+                                     batchStartUs);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        c.seconds = (TimeUtility::GetTimeofDayUs() - startUs) / 1000000.0;
+        c.ops = batches * kBatch * FLAGS_meta_threads;
+        for (auto& latency : latencies) {
+            c.latency.Merge(latency);
+        }
+        reporter_.AddCase(c);
+    }
+
+    int64_t Write(ChunkID id, uint64_t sn, off_t offset) {
+        butil::IOBuf data;
+        data.append(buf_);
+        uint32_t cost;
+        CSErrorCode ret = dataStore_->WriteChunk(id, sn, data, offset,
+                                                 FLAGS_io_size, &cost);
+        return ret == CSErrorCode::Success
+                   ? static_cast<int64_t>(FLAGS_io_size) : -1;
+    }
+
+    int64_t Read(ChunkID id, off_t offset) {
+        CSErrorCode ret = dataStore_->ReadChunk(id, 1, &readBuf_[0], offset,
+                                                FLAGS_io_size);
+        return ret == CSErrorCode::Success
+                   ? static_cast<int64_t>(FLAGS_io_size) : -1;
+    }
+
+    ChunkID RandChunk(ChunkID base) {
+        return base + rand_() % FLAGS_chunk_num;
+    }
+
+    off_t RandOffset() {
+        return rand_() % (FLAGS_chunk_size / FLAGS_io_size) * FLAGS_io_size;
+    }
+
+ private:
+    std::shared_ptr<LocalFileSystem> lfs_;
+    std::shared_ptr<FilePool> filePool_;
+    std::shared_ptr<ChunkFdCache> fdCache_;
+    std::shared_ptr<CSDataStore> dataStore_;
+    std::string buf_;
+    std::string readBuf_ = std::string(FLAGS_io_size, '\0');
+    // 固定种子，保证每次运行的访问序列相同
+    std::mt19937_64 rand_;
+    BenchReporter reporter_;
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_io_size == 0 || FLAGS_chunk_size % FLAGS_io_size != 0 ||
+        FLAGS_io_size % FLAGS_page_size != 0) {
+        LOG(ERROR) << "io_size must be a multiple of page_size and a divisor"
+                   << " of chunk_size";
+        return -1;
+    }
+    if (FLAGS_meta_chunk_num == 0 || FLAGS_meta_threads == 0) {
+        LOG(ERROR) << "meta_chunk_num and meta_threads must be positive";
+        return -1;
+    }
+
+    DataStoreBench bench;
+    if (!bench.Init()) {
+        return -1;
+    }
+    bench.Run();
+    bench.UnInit();
+    return bench.Dump();
+}
@@ -0,0 +1,182 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+/*
+ * 心跳上报开销测试：对比全量心跳和增量心跳的序列化、反序列化耗时和大小,
+ * 以及mds把心跳合并到CopysetReportCache的耗时，例如：
+ *   heartbeat_bench --copysets=1000 --changed_percent=1
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <string>
+
+#include "proto/heartbeat.pb.h"
+#include "src/mds/heartbeat/copyset_report_cache.h"
+#include "test/benchmark/bench_common.h"
+
+DEFINE_uint64(ops, 10000, "number of operations of each case");
+DEFINE_uint32(copysets, 1000, "number of copysets on the chunkserver");
+DEFINE_uint32(changed_percent, 1,
+              "percent of copysets reported by delta heartbeat");
+
+using curve::benchmark::BenchCase;
+using curve::benchmark::BenchReporter;
+using curve::benchmark::RunLoop;
+using curve::mds::heartbeat::ChunkServerHeartbeatRequest;
+using curve::mds::heartbeat::CopysetReportCache;
+
+namespace {
+
+void AddCopySet(ChunkServerHeartbeatRequest* request, uint32_t copysetId,
+                uint64_t epoch) {
+    auto info = request->add_copysetinfos();
+    info->set_logicalpoolid(1);
+    info->set_copysetid(copysetId);
+    info->set_epoch(epoch);
+    for (int i = 1; i <= 3; ++i) {
+        std::string addr = "192.168.10." + std::to_string(i) + ":8200:0";
+        info->add_peers()->set_address(addr);
+        if (i == 1) {
+            info->mutable_leaderpeer()->set_address(addr);
+        }
+    }
+    auto stats = info->mutable_stats();
+    stats->set_readrate(1);
+    stats->set_writerate(1);
+    stats->set_readiops(1);
+    stats->set_writeiops(1);
+}
+
+ChunkServerHeartbeatRequest BuildRequest(uint32_t copysets, uint64_t sequence,
+                                         uint64_t baseSequence) {
+    ChunkServerHeartbeatRequest request;
+    request.set_chunkserverid(1);
+    request.set_token("token");
+    request.set_ip("192.168.10.1");
+    request.set_port(8200);
+    request.mutable_diskstate()->set_errtype(0);
+    request.mutable_diskstate()->set_errmsg("");
+    request.set_diskcapacity(1UL << 40);
+    request.set_diskused(1UL << 30);
+    request.set_leadercount(FLAGS_copysets / 3);
+    request.set_copysetcount(FLAGS_copysets);
+    request.set_sequence(sequence);
+    if (baseSequence != 0) {
+        request.set_basesequence(baseSequence);
+    }
+    for (uint32_t i = 1; i <= copysets; ++i) {
+        AddCopySet(&request, i, sequence);
+    }
+    return request;
+}
+
+void AddParams(BenchCase* c, uint64_t size) {
+    c->params["copysets"] = std::to_string(FLAGS_copysets);
+    c->params["changed_percent"] = std::to_string(FLAGS_changed_percent);
+    c->params["request_bytes"] = std::to_string(size);
+}
+
+// 序列化心跳请求
+void RunSerialize(const std::string& name,
+                  const ChunkServerHeartbeatRequest& request,
+                  BenchReporter* reporter) {
+    BenchCase c;
+    c.name = name;
+    std::string buf;
+    RunLoop(FLAGS_ops, [&](uint64_t) -> int64_t {
+        buf.clear();
+        if (!request.SerializeToString(&buf)) {
+            return -1;
+        }
+        return buf.size();
+    }, &c);
+    AddParams(&c, buf.size());
+    reporter->AddCase(c);
+}
+
+// 反序列化心跳请求
+void RunParse(const std::string& name,
+              const ChunkServerHeartbeatRequest& request,
+              BenchReporter* reporter) {
+    BenchCase c;
+    c.name = name;
+    std::string buf;
+    request.SerializeToString(&buf);
+    ChunkServerHeartbeatRequest parsed;
+    RunLoop(FLAGS_ops, [&](uint64_t) -> int64_t {
+        if (!parsed.ParseFromString(buf)) {
+            return -1;
+        }
+        return buf.size();
+    }, &c);
+    AddParams(&c, buf.size());
+    reporter->AddCase(c);
+}
+
+// mds合并心跳到缓存, 增量心跳每次基于上一次的序号合并
+void RunMerge(const std::string& name, bool delta,
+              BenchReporter* reporter) {
+    CopysetReportCache cache;
+    ChunkServerHeartbeatRequest merged;
+    auto full = BuildRequest(FLAGS_copysets, 1, 0);
+    cache.Merge(full, &merged);
+
+    uint32_t changed = delta ? FLAGS_copysets * FLAGS_changed_percent / 100
+                             : FLAGS_copysets;
+    auto request = BuildRequest(changed, 1, 0);
+    BenchCase c;
+    c.name = name;
+    RunLoop(FLAGS_ops, [&](uint64_t i) -> int64_t {
+        request.set_sequence(i + 2);
+        if (delta) {
+            request.set_basesequence(i + 1);
+        }
+        if (!cache.Merge(request, &merged)) {
+            return -1;
+        }
+        return request.ByteSize();
+    }, &c);
+    AddParams(&c, request.ByteSize());
+    reporter->AddCase(c);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+    google::InitGoogleLogging(argv[0]);
+
+    auto full = BuildRequest(FLAGS_copysets, 1, 0);
+    auto delta = BuildRequest(
+        FLAGS_copysets * FLAGS_changed_percent / 100, 2, 1);
+
+    BenchReporter reporter("heartbeat");
+    RunSerialize("full_serialize", full, &reporter);
+    RunSerialize("delta_serialize", delta, &reporter);
+    RunParse("full_parse", full, &reporter);
+    RunParse("delta_parse", delta, &reporter);
+    RunMerge("full_merge", false, &reporter);
+    RunMerge("delta_merge", true, &reporter);
+    return reporter.Dump(FLAGS_bench_output);
+}
@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+/*
+ * MakePooledShared和std::make_shared的开销对比：
+ * *_same_thread: 同一个线程上分配后立即释放
+ * *_cross_thread: 分配线程每攒一批对象交给释放线程，和rpc线程分配、
+ *                 apply线程释放的场景一致
+ * 例如：
+ *   object_pool_bench --ops=10000000 --threads=4
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/common/object_pool.h"
+#include "test/benchmark/bench_common.h"
+
+DEFINE_uint64(ops, 10000000, "number of objects of each case");
+DEFINE_uint32(threads, 1, "number of allocating threads");
+DEFINE_uint32(batch, 128, "objects handed to the releasing thread at once");
+
+using curve::benchmark::BenchCase;
+using curve::benchmark::BenchReporter;
+using curve::common::MakePooledShared;
+using curve::common::TimeUtility;
+
+namespace {
+
+// 大小和chunkserver上的op request相当
+struct Object {
+    uint64_t id = 0;
+    char payload[248];
+};
+
+typedef std::shared_ptr<Object> ObjectPtr;
+
+ObjectPtr HeapAlloc(uint64_t id) {
+    auto obj = std::make_shared<Object>();
+    obj->id = id;
+    return obj;
+}
+
+ObjectPtr PoolAlloc(uint64_t id) {
+    auto obj = MakePooledShared<Object>();
+    obj->id = id;
+    return obj;
+}
+
+// 分配线程和释放线程之间传递对象的队列
+class BatchQueue {
+ public:
+    void Push(std::vector<ObjectPtr>* batch) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        batches_.emplace_back();
+        batches_.back().swap(*batch);
+        cv_.notify_one();
+    }
+
+    void Close() {
+        std::lock_guard<std::mutex> lk(mtx_);
+        closed_ = true;
+        cv_.notify_one();
+    }
+
+    bool Pop(std::vector<ObjectPtr>* batch) {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cv_.wait(lk, [this]() { return closed_ || !batches_.empty(); });
+        if (batches_.empty()) {
+            return false;
+        }
+        batch->swap(batches_.front());
+        batches_.pop_front();
+        return true;
+    }
+
+ private:
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::vector<ObjectPtr>> batches_;
+    bool closed_ = false;
+};
+
+void AddResult(const std::string& name, uint64_t ops, uint64_t startUs,
+               BenchReporter* reporter) {
+    BenchCase c;
+    c.name = name;
+    c.seconds = (TimeUtility::GetTimeofDayUs() - startUs) / 1000000.0;
+    c.ops = ops;
+    double nsPerOp = ops == 0 ? 0 :
+        c.seconds * 1000000000.0 * FLAGS_threads / ops;
+    c.params["threads"] = std::to_string(FLAGS_threads);
+    c.params["object_size"] = std::to_string(sizeof(Object));
+    c.params["batch"] = std::to_string(FLAGS_batch);
+    c.params["ns_per_op"] = std::to_string(nsPerOp);
+    reporter->AddCase(c);
+}
+
+template <typename AllocFn>
+void RunSameThread(const std::string& name, AllocFn alloc,
+                   BenchReporter* reporter) {
+    const uint64_t opsPerThread = FLAGS_ops / FLAGS_threads;
+    std::vector<std::thread> threads;
+    const uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    for (uint32_t t = 0; t < FLAGS_threads; ++t) {
+        threads.emplace_back([alloc, opsPerThread]() {
+            for (uint64_t i = 0; i < opsPerThread; ++i) {
+                ObjectPtr obj = alloc(i);
+                // 防止编译器把分配和释放优化掉
+                asm volatile("" : : "r"(obj.get()) : "memory");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    AddResult(name, opsPerThread * FLAGS_threads, startUs, reporter);
+}
+
+template <typename AllocFn>
+void RunCrossThread(const std::string& name, AllocFn alloc,
+                    BenchReporter* reporter) {
+    const uint64_t opsPerThread = FLAGS_ops / FLAGS_threads;
+    std::vector<std::unique_ptr<BatchQueue>> queues;
+    std::vector<std::thread> threads;
+    const uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    for (uint32_t t = 0; t < FLAGS_threads; ++t) {
+        queues.emplace_back(new BatchQueue());
+        BatchQueue* queue = queues.back().get();
+        threads.emplace_back([queue]() {
+            std::vector<ObjectPtr> batch;
+            while (queue->Pop(&batch)) {
+                batch.clear();
+            }
+        });
+        threads.emplace_back([alloc, queue, opsPerThread]() {
+            std::vector<ObjectPtr> batch;
+            batch.reserve(FLAGS_batch);
+            for (uint64_t i = 0; i < opsPerThread; ++i) {
+                batch.emplace_back(alloc(i));
+                if (batch.size() >= FLAGS_batch) {
+                    queue->Push(&batch);
+                    batch.reserve(FLAGS_batch);
+                }
+            }
+            queue->Push(&batch);
+            queue->Close();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    AddResult(name, opsPerThread * FLAGS_threads, startUs, reporter);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_threads == 0 || FLAGS_batch == 0) {
+        LOG(ERROR) << "threads and batch must be greater than 0";
+        return -1;
+    }
+
+    BenchReporter reporter("object_pool");
+    RunSameThread("heap_same_thread", HeapAlloc, &reporter);
+    RunSameThread("pool_same_thread", PoolAlloc, &reporter);
+    RunCrossThread("heap_cross_thread", HeapAlloc, &reporter);
+    RunCrossThread("pool_cross_thread", PoolAlloc, &reporter);
+    return reporter.Dump(FLAGS_bench_output);
+}
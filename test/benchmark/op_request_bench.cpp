@@ -0,0 +1,217 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+
+/*
+ * chunkserver上每个请求都要创建的对象的开销测试，对比普通分配和对象池/arena：
+ * rpc_alloc_*: rpc线程创建op request和closure，在apply线程中释放
+ * replay_*: 反序列化一条写日志，把request和数据交给apply线程
+ * 统计从创建到apply线程释放完成的延时，例如：
+ *   op_request_bench --ops=1000000 --io_size=4096
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <braft/raft.h>
+#include <butil/iobuf.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "proto/chunk.pb.h"
+#include "src/chunkserver/chunk_closure.h"
+#include "src/chunkserver/concurrent_apply/concurrent_apply.h"
+#include "src/chunkserver/op_request.h"
+#include "src/common/concurrent/count_down_event.h"
+#include "src/common/object_pool.h"
+#include "test/benchmark/bench_common.h"
+
+DEFINE_uint64(ops, 1000000, "number of ops of each case");
+DEFINE_uint32(io_size, 4096, "data size of each write request");
+DEFINE_uint32(chunk_num, 1024, "number of distinct chunks");
+DEFINE_int32(wconcurrentsize, 10, "number of write apply threads");
+DEFINE_int32(wqueuedepth, 1, "queue depth of each write apply thread");
+
+using curve::benchmark::BenchCase;
+using curve::benchmark::BenchReporter;
+using curve::chunkserver::CHUNK_OP_TYPE;
+using curve::chunkserver::ChunkClosure;
+using curve::chunkserver::ChunkLogEntry;
+using curve::chunkserver::ChunkOpRequest;
+using curve::chunkserver::ChunkRequest;
+using curve::chunkserver::WriteChunkRequest;
+using curve::chunkserver::concurrent::ConcurrentApplyModule;
+using curve::chunkserver::concurrent::ConcurrentApplyOption;
+using curve::common::CountDownEvent;
+using curve::common::MakePooledShared;
+using curve::common::TimeUtility;
+
+namespace {
+
+// 不走对象池的closure，作为ChunkClosure的对比
+class HeapClosure : public braft::Closure {
+ public:
+    explicit HeapClosure(std::shared_ptr<ChunkOpRequest> request)
+        : request_(request) {}
+
+    void Run() override {
+        delete this;
+    }
+
+ private:
+    std::shared_ptr<ChunkOpRequest> request_;
+};
+
+// 在apply线程中记录一个op的延时
+struct Finisher {
+    std::vector<uint32_t>* latencies;
+    CountDownEvent* done;
+    uint64_t index;
+    uint64_t pushUs;
+
+    void operator()() const {
+        (*latencies)[index] = TimeUtility::GetTimeofDayUs() - pushUs;
+        done->Signal();
+    }
+};
+
+/**
+ * 执行一个用例
+ * @param: name为用例名称
+ * @param: push为每个op创建对象，并把释放对象和finish的任务放入apply模块
+ * @param: reporter记录结果
+ */
+template <typename PushFn>
+bool RunCase(const std::string& name, PushFn push, BenchReporter* reporter) {
+    ConcurrentApplyOption opt{FLAGS_wconcurrentsize, FLAGS_wqueuedepth,
+                              1, 1, 0};
+    ConcurrentApplyModule module;
+    if (!module.Init(opt)) {
+        LOG(ERROR) << "init concurrent apply module failed";
+        return false;
+    }
+
+    std::vector<uint32_t> latencies(FLAGS_ops, 0);
+    CountDownEvent done(FLAGS_ops);
+
+    const uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    for (uint64_t i = 0; i < FLAGS_ops; ++i) {
+        Finisher finish{&latencies, &done, i, TimeUtility::GetTimeofDayUs()};
+        push(&module, i % FLAGS_chunk_num, finish);
+    }
+    done.Wait();
+
+    BenchCase c;
+    c.name = name;
+    c.seconds = (TimeUtility::GetTimeofDayUs() - startUs) / 1000000.0;
+    c.ops = FLAGS_ops;
+    for (auto latency : latencies) {
+        c.latency.Add(latency);
+    }
+    c.params["io_size"] = std::to_string(FLAGS_io_size);
+    c.params["chunk_num"] = std::to_string(FLAGS_chunk_num);
+    c.params["wconcurrentsize"] = std::to_string(FLAGS_wconcurrentsize);
+    c.params["wqueuedepth"] = std::to_string(FLAGS_wqueuedepth);
+    reporter->AddCase(c);
+
+    module.Stop();
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+    google::InitGoogleLogging(argv[0]);
+
+    // 回放用例使用的写日志
+    ChunkRequest request;
+    request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+    request.set_logicpoolid(1);
+    request.set_copysetid(1);
+    request.set_chunkid(1);
+    request.set_offset(0);
+    request.set_size(FLAGS_io_size);
+    request.set_sn(1);
+    butil::IOBuf data;
+    data.append(std::string(FLAGS_io_size, 'a'));
+    butil::IOBuf log;
+    if (0 != ChunkOpRequest::Encode(&request, &data, &log)) {
+        LOG(ERROR) << "encode write request failed";
+        return -1;
+    }
+
+    const CHUNK_OP_TYPE write = CHUNK_OP_TYPE::CHUNK_OP_WRITE;
+    auto rpcAllocHeap = [write](ConcurrentApplyModule* module,
+                                uint64_t key, const Finisher& finish) {
+        auto op = std::make_shared<WriteChunkRequest>();
+        auto closure = new HeapClosure(op);
+        module->Push(key, write, [closure, finish]() {
+            closure->Run();
+            finish();
+        });
+    };
+    auto rpcAllocPool = [write](ConcurrentApplyModule* module,
+                                uint64_t key, const Finisher& finish) {
+        auto op = MakePooledShared<WriteChunkRequest>();
+        auto closure = new ChunkClosure(op);
+        module->Push(key, write, [closure, finish]() {
+            closure->Run();
+            finish();
+        });
+    };
+    // 反序列化到栈上的request，再拷贝到apply任务中
+    auto replayCopy = [write, &log](ConcurrentApplyModule* module,
+                                    uint64_t key, const Finisher& finish) {
+        ChunkRequest request;
+        butil::IOBuf data;
+        auto op = ChunkOpRequest::Decode(log, &request, &data);
+        auto apply = [finish](std::shared_ptr<ChunkOpRequest> op,
+                              const ChunkRequest& request,
+                              const butil::IOBuf& data) {
+            finish();
+        };
+        module->Push(key, write, apply, op, request, data);
+    };
+    // 反序列化到对象池分配的ChunkLogEntry中，apply任务只持有引用
+    auto replayArena = [write, &log](ConcurrentApplyModule* module,
+                                     uint64_t key, const Finisher& finish) {
+        auto entry = MakePooledShared<ChunkLogEntry>();
+        auto op = ChunkOpRequest::Decode(log,
+                                         entry->MutableRequest(),
+                                         entry->MutableData());
+        module->Push(key, write, [op, entry, finish]() {
+            finish();
+        });
+    };
+
+    BenchReporter reporter("op_request");
+    if (!RunCase("rpc_alloc_heap", rpcAllocHeap, &reporter) ||
+        !RunCase("rpc_alloc_pool", rpcAllocPool, &reporter) ||
+        !RunCase("replay_copy", replayCopy, &reporter) ||
+        !RunCase("replay_arena", replayArena, &reporter)) {
+        return -1;
+    }
+    return reporter.Dump(FLAGS_bench_output);
+}
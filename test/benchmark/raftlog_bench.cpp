@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+/*
+ * raft log的基准测试：批量追加日志、重启时加载已有日志以及顺序读日志，
+ * 日志文件从walfilepool获取，例如：
+ *   raftlog_bench --bench_dir=/dev/shm/curve_bench --entries=100000
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <braft/log.h>
+#include <braft/log_entry.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/chunkserver/datastore/file_pool.h"
+#include "src/chunkserver/raftlog/curve_segment.h"
+#include "src/chunkserver/raftlog/curve_segment_log_storage.h"
+#include "src/fs/local_filesystem.h"
+#include "test/benchmark/bench_common.h"
+
+DEFINE_uint64(entries, 100000, "number of log entries to append");
+DEFINE_uint32(entry_size, 4096, "data size of each log entry");
+DEFINE_uint32(batch_size, 8, "number of entries of each append");
+DEFINE_uint32(segment_size, 8 * 1024 * 1024, "wal segment size");
+DEFINE_uint32(meta_page_size, 4096, "wal segment meta page size");
+DEFINE_bool(sync, true, "whether to sync after each append");
+
+using curve::benchmark::BenchCase;
+using curve::benchmark::BenchReporter;
+using curve::benchmark::RunLoop;
+using curve::chunkserver::CurveSegmentLogStorage;
+using curve::chunkserver::FilePool;
+using curve::chunkserver::FilePoolOptions;
+using curve::chunkserver::kWalFilePool;
+using curve::fs::FileSystemType;
+using curve::fs::LocalFileSystem;
+using curve::fs::LocalFsFactory;
+
+namespace {
+
+BenchCase NewCase(const std::string& name) {
+    BenchCase benchCase;
+    benchCase.name = name;
+    benchCase.params["entries"] = std::to_string(FLAGS_entries);
+    benchCase.params["entry_size"] = std::to_string(FLAGS_entry_size);
+    benchCase.params["batch_size"] = std::to_string(FLAGS_batch_size);
+    benchCase.params["segment_size"] = std::to_string(FLAGS_segment_size);
+    benchCase.params["sync"] = FLAGS_sync ? "true" : "false";
+    return benchCase;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_batch_size == 0) {
+        LOG(ERROR) << "batch_size must be greater than 0";
+        return -1;
+    }
+
+    auto lfs = LocalFsFactory::CreateFs(FileSystemType::EXT4, "");
+    lfs->Delete(FLAGS_bench_dir);
+    if (lfs->Mkdir(FLAGS_bench_dir) != 0) {
+        LOG(ERROR) << "mkdir failed, dir = " << FLAGS_bench_dir;
+        return -1;
+    }
+
+    FilePoolOptions poolOpt;
+    poolOpt.getFileFromPool = false;
+    poolOpt.fileSize = FLAGS_segment_size;
+    poolOpt.metaPageSize = FLAGS_meta_page_size;
+    std::string poolDir = FLAGS_bench_dir + "/walpool";
+    snprintf(poolOpt.filePoolDir, sizeof(poolOpt.filePoolDir), "%s",
+             poolDir.c_str());
+    kWalFilePool = std::make_shared<FilePool>(lfs);
+    if (!kWalFilePool->Initialize(poolOpt)) {
+        LOG(ERROR) << "init wal file pool failed";
+        return -1;
+    }
+
+    BenchReporter reporter("raftlog");
+    const std::string logDir = FLAGS_bench_dir + "/log";
+    const std::string data(FLAGS_entry_size, 'a');
+    const uint64_t batches =
+        (FLAGS_entries + FLAGS_batch_size - 1) / FLAGS_batch_size;
+
+    {
+        braft::ConfigurationManager configManager;
+        auto storage = std::make_shared<CurveSegmentLogStorage>(logDir,
+                                                                FLAGS_sync);
+        if (storage->init(&configManager) != 0) {
+            LOG(ERROR) << "init log storage failed";
+            return -1;
+        }
+
+        BenchCase c = NewCase("append");
+        int64_t index = 0;
+        RunLoop(batches, [&](uint64_t) -> int64_t {
+            std::vector<braft::LogEntry*> entries;
+            for (uint32_t i = 0; i < FLAGS_batch_size &&
+                    index < static_cast<int64_t>(FLAGS_entries); ++i) {
+                braft::LogEntry* entry = new braft::LogEntry();
+                entry->AddRef();
+                entry->type = braft::ENTRY_TYPE_DATA;
+                entry->id.term = 1;
+                entry->id.index = ++index;
+                entry->data.append(data);
+                entries.push_back(entry);
+            }
+            int ret = storage->append_entries(entries);
+            int64_t bytes = 0;
+            for (auto entry : entries) {
+                bytes += entry->data.size();
+                entry->Release();
+            }
+            return ret == static_cast<int>(entries.size()) ? bytes : -1;
+        }, &c);
+        reporter.AddCase(c);
+    }
+
+    // 重新打开，加载已有的日志段
+    braft::ConfigurationManager configManager;
+    auto storage = std::make_shared<CurveSegmentLogStorage>(logDir,
+                                                            FLAGS_sync);
+    {
+        BenchCase c = NewCase("replay");
+        RunLoop(1, [&](uint64_t) -> int64_t {
+            if (storage->init(&configManager) != 0) {
+                return -1;
+            }
+            return storage->last_log_index() ==
+                   static_cast<int64_t>(FLAGS_entries)
+                       ? FLAGS_entries * FLAGS_entry_size : -1;
+        }, &c);
+        reporter.AddCase(c);
+    }
+
+    {
+        BenchCase c = NewCase("read");
+        RunLoop(FLAGS_entries, [&](uint64_t i) -> int64_t {
+            braft::LogEntry* entry = storage->get_entry(i + 1);
+            if (entry == nullptr) {
+                return -1;
+            }
+            int64_t bytes = entry->data.size();
+            entry->Release();
+            return bytes;
+        }, &c);
+        reporter.AddCase(c);
+    }
+
+    storage.reset();
+    kWalFilePool->UnInitialize();
+    kWalFilePool = nullptr;
+    lfs->Delete(FLAGS_bench_dir);
+    return reporter.Dump(FLAGS_bench_output);
+}
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+/*
+ * 文件限流的开销测试：对比没有限流、不限制(默认)和限制值足够大不需要等待
+ * 三种情况下每个IO经过FileThrottle的耗时，例如：
+ *   throttle_bench --ops=10000000 --threads=4
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/client/file_throttle.h"
+#include "test/benchmark/bench_common.h"
+
+DEFINE_uint64(ops, 10000000, "number of ios of each case");
+DEFINE_uint32(threads, 1, "number of threads issuing ios");
+DEFINE_uint32(io_size, 4096, "size of each io");
+
+using curve::benchmark::BenchCase;
+using curve::benchmark::BenchReporter;
+using curve::client::FileThrottle;
+using curve::client::ThrottleOption;
+using curve::common::TimeUtility;
+
+namespace {
+
+// 限制值远大于测试能达到的速率，只统计取令牌本身的开销
+const uint64_t kLargeIopsLimit = 1000000000ul;
+const uint64_t kLargeBpsLimit = kLargeIopsLimit * 1024 * 1024;
+
+/**
+ * 执行一个用例，单个IO的耗时在ns级别，按整个循环计时
+ * @param: name为用例名称
+ * @param: throttle为nullptr时不经过限流，作为对比的基准
+ * @param: reporter记录结果
+ */
+void RunCase(const std::string& name, FileThrottle* throttle,
+             BenchReporter* reporter) {
+    const uint64_t opsPerThread = FLAGS_ops / FLAGS_threads;
+    std::vector<uint64_t> waitUs(FLAGS_threads, 0);
+    std::vector<std::thread> threads;
+
+    const uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    for (uint32_t t = 0; t < FLAGS_threads; ++t) {
+        threads.emplace_back([throttle, opsPerThread, &waitUs, t]() {
+            uint64_t wait = 0;
+            for (uint64_t i = 0; i < opsPerThread; ++i) {
+                if (throttle != nullptr) {
+                    wait += throttle->Add(FLAGS_io_size);
+                }
+                // 防止编译器把空循环优化掉
+                asm volatile("" ::: "memory");
+            }
+            waitUs[t] = wait;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    BenchCase c;
+    c.name = name;
+    c.seconds = (TimeUtility::GetTimeofDayUs() - startUs) / 1000000.0;
+    c.ops = opsPerThread * FLAGS_threads;
+    c.bytes = c.ops * FLAGS_io_size;
+    uint64_t totalWaitUs = 0;
+    for (auto wait : waitUs) {
+        totalWaitUs += wait;
+    }
+    double nsPerOp = c.ops == 0 ? 0 :
+        c.seconds * 1000000000.0 * FLAGS_threads / c.ops;
+    c.params["threads"] = std::to_string(FLAGS_threads);
+    c.params["io_size"] = std::to_string(FLAGS_io_size);
+    c.params["ns_per_op"] = std::to_string(nsPerOp);
+    c.params["throttle_wait_us"] = std::to_string(totalWaitUs);
+    reporter->AddCase(c);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_threads == 0) {
+        LOG(ERROR) << "threads must be greater than 0";
+        return -1;
+    }
+
+    BenchReporter reporter("throttle");
+    RunCase("baseline", nullptr, &reporter);
+
+    FileThrottle unlimited;
+    unlimited.Init(ThrottleOption());
+    unlimited.UpdateThrottleParams(0, 0);
+    RunCase("unlimited", &unlimited, &reporter);
+
+    FileThrottle limited;
+    limited.Init(ThrottleOption());
+    limited.UpdateThrottleParams(kLargeIopsLimit, kLargeBpsLimit);
+    RunCase("limited_no_wait", &limited, &reporter);
+
+    return reporter.Dump(FLAGS_bench_output);
+}
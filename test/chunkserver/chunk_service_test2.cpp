@@ -455,6 +455,19 @@ TEST_F(ChunkService2Test, illegial_parameters_test) {
         ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_COPYSET_NOTEXIST,
                   response.status());
     }
+    {
+        brpc::Controller cntl;
+        cntl.set_timeout_ms(rpcTimeoutMs);
+        GetChunksInfoRequest request;
+        GetChunksInfoResponse response;
+        request.set_logicpoolid(logicPoolId + 1);
+        request.set_copysetid(copysetId + 1);
+        request.add_chunkids(chunkId);
+        stub.GetChunksInfo(&cntl, &request, &response, nullptr);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_COPYSET_NOTEXIST,
+                  response.status());
+    }
     /* 不是 leader */
     {
         PeerId peer1;
@@ -722,6 +735,20 @@ TEST_F(ChunkService2Test, overload_test) {
 
         ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD, response.status());
     }
+
+    // get chunks info
+    {
+        brpc::Controller cntl;
+        GetChunksInfoRequest request;
+        GetChunksInfoResponse response;
+        ChunkServiceTestClosure done;
+        request.set_logicpoolid(logicPoolId);
+        request.set_copysetid(copysetId);
+        request.add_chunkids(chunkId);
+        chunkService.GetChunksInfo(&cntl, &request, &response, &done);
+
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD, response.status());
+    }
 }
 
 TEST_F(ChunkService2Test, overload_concurrency_test) {
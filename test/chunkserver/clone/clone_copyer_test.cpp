@@ -36,6 +36,8 @@ namespace chunkserver {
 
 using curve::client::MockFileClient;
 using curve::common::MockS3Adapter;
+using curve::common::CompressType;
+using curve::common::kCompressMetaKey;
 
 const char CURVE_CONF[] = "client.conf";
 const char S3_CONF[] = "s3.conf";
@@ -195,9 +197,11 @@ TEST_F(CloneCopyerTest, BasicTest) {
 
 
         /* 用例:读s3上的数据，读取成功
-         * 预期:返回0
+         * 预期:对象元数据没有压缩标记，不获取块索引，返回0
          */
         context.location = "test@s3";
+        EXPECT_CALL(*s3Client_, GetObjectIfExist(_, _, _))
+            .Times(0);
         EXPECT_CALL(*s3Client_, GetObjectAsync(_))
             .WillOnce(Invoke(
                 [&] (const std::shared_ptr<GetObjectAsyncContext>& context) {
@@ -210,9 +214,12 @@ TEST_F(CloneCopyerTest, BasicTest) {
         closure.Reset();
 
         /* 用例:读s3上的数据，读取失败
-         * 预期:返回-1
+         * 预期:块索引不存在，返回-1
          */
         context.location = "test@s3";
+        EXPECT_CALL(*s3Client_,
+                    GetObjectIfExist(Aws::String("test.cidx"), _, _))
+            .WillOnce(DoAll(SetArgPointee<2>(false), Return(0)));
         EXPECT_CALL(*s3Client_, GetObjectAsync(_))
             .WillOnce(Invoke(
                 [&] (const std::shared_ptr<GetObjectAsyncContext>& context) {
@@ -224,6 +231,93 @@ TEST_F(CloneCopyerTest, BasicTest) {
         ASSERT_TRUE(closure.IsFailed());
         closure.Reset();
 
+        /* 用例:读s3上压缩的对象，获取块索引失败
+         * 预期:不把压缩数据当作原始数据返回，返回-1
+         */
+        context.location = "test2@s3";
+        EXPECT_CALL(*s3Client_,
+                    GetObjectIfExist(Aws::String("test2.cidx"), _, _))
+            .WillOnce(Return(-1));
+        EXPECT_CALL(*s3Client_, GetObjectAsync(_))
+            .WillOnce(Invoke(
+                [&] (const std::shared_ptr<GetObjectAsyncContext>& context) {
+                    context->metadata[kCompressMetaKey] = "zlib";
+                    context->retCode = 0;
+                    context->cb(s3Client_.get(), context);
+                }));
+        copyer.DownloadAsync(&closure);
+        ASSERT_TRUE(closure.IsRun());
+        ASSERT_TRUE(closure.IsFailed());
+        closure.Reset();
+
+        /* 用例:读s3上分块压缩的对象，读取范围跨两个块
+         * 预期:根据对象元数据获取块索引，只下载覆盖读取范围的块，
+         *      解压后返回原始数据
+         */
+        const uint64_t blockSize = 4096;
+        std::string origin(blockSize * 3, 'a');
+        for (uint64_t i = 0; i < origin.size(); ++i) {
+            origin[i] = 'a' + (i / 512) % 26;
+        }
+        curve::common::ZlibCompressor compressor(1);
+        CompressedBlockIndex index(CompressType::kZlib, blockSize);
+        std::string object;
+        for (int i = 0; i < 3; ++i) {
+            std::string compressed;
+            ASSERT_TRUE(compressor.Compress(origin.data() + i * blockSize,
+                                            blockSize, &compressed));
+            index.SetBlockLen(i, compressed.size());
+            object += compressed;
+        }
+        auto readCompressed =
+            [&] (const std::shared_ptr<GetObjectAsyncContext>& context) {
+                ASSERT_EQ(index.GetBlockOffset(1), context->offset);
+                ASSERT_EQ(index.GetBlockLen(1) + index.GetBlockLen(2),
+                          context->len);
+                memcpy(context->buf, object.data() + context->offset,
+                       context->len);
+                context->metadata[kCompressMetaKey] = "zlib";
+                context->retCode = 0;
+                context->cb(s3Client_.get(), context);
+            };
+        context.location = "test3@s3";
+        context.offset = blockSize + 100;
+        context.size = blockSize;
+        EXPECT_CALL(*s3Client_,
+                    GetObjectIfExist(Aws::String("test3.cidx"), _, _))
+            .WillOnce(DoAll(SetArgPointee<1>(index.Serialize()),
+                            SetArgPointee<2>(true),
+                            Return(0)));
+        EXPECT_CALL(*s3Client_, GetObjectAsync(_))
+            .WillOnce(Invoke(
+                [&] (const std::shared_ptr<GetObjectAsyncContext>& context) {
+                    context->metadata[kCompressMetaKey] = "zlib";
+                    context->retCode = 0;
+                    context->cb(s3Client_.get(), context);
+                }))
+            .WillOnce(Invoke(readCompressed));
+        copyer.DownloadAsync(&closure);
+        ASSERT_TRUE(closure.IsRun());
+        ASSERT_FALSE(closure.IsFailed());
+        ASSERT_EQ(0, memcmp(origin.data() + context.offset, buf,
+                            context.size));
+        closure.Reset();
+
+        /* 用例:再次读取压缩的对象
+         * 预期:块索引已缓存，直接下载覆盖读取范围的块
+         */
+        memset(buf, 0, context.size);
+        EXPECT_CALL(*s3Client_, GetObjectIfExist(_, _, _))
+            .Times(0);
+        EXPECT_CALL(*s3Client_, GetObjectAsync(_))
+            .WillOnce(Invoke(readCompressed));
+        copyer.DownloadAsync(&closure);
+        ASSERT_TRUE(closure.IsRun());
+        ASSERT_FALSE(closure.IsFailed());
+        ASSERT_EQ(0, memcmp(origin.data() + context.offset, buf,
+                            context.size));
+        closure.Reset();
+
         delete [] buf;
     }
     // fini test
@@ -622,6 +622,8 @@ TEST_F(OpRequestTest, ReadChunkTest) {
         // 设置预期
         EXPECT_CALL(*node_, IsLeaderTerm())
             .WillRepeatedly(Return(true));
+        EXPECT_CALL(*node_, IsLeaseLeader())
+            .WillOnce(Return(false));
         braft::Task task;
         EXPECT_CALL(*node_, Propose(_))
             .WillOnce(SaveArg<0>(&task));
@@ -637,6 +639,126 @@ TEST_F(OpRequestTest, ReadChunkTest) {
         task.done->Run();
         ASSERT_TRUE(closure->isDone_);
     }
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == true,
+     *       请求的 apply index 大于 node的 apply index，但leader lease有效
+     * 预期： 不会走一致性协议，请求提交给concurrentApplyModule_处理
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        request->set_appliedindex(LAST_INDEX + 1);
+
+        // 设置预期
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(true));
+        EXPECT_CALL(*node_, IsLeaseLeader())
+            .WillOnce(Return(true));
+        EXPECT_CALL(*node_, Propose(_))
+            .Times(0);
+
+        opReq->Process();
+
+        // 验证结果
+        ASSERT_FALSE(closure->isDone_);
+        ASSERT_FALSE(response->has_appliedindex());
+        ASSERT_FALSE(closure->response_->has_status());
+
+        closure->Run();
+        ASSERT_TRUE(closure->isDone_);
+    }
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == false, 请求开启followerRead,
+     *       node在等待时间内apply到了leader的read index
+     * 预期： follower直接处理，请求提交给concurrentApplyModule_处理
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        request->set_followerread(true);
+        request->set_appliedindex(3);
+
+        // 设置预期
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(false));
+        EXPECT_CALL(*node_, FetchLeaderReadIndex(request->chunkid(), _))
+            .WillOnce(DoAll(SetArgPointee<1>(LAST_INDEX), Return(0)));
+        EXPECT_CALL(*node_, WaitAppliedWatermark(LAST_INDEX, _))
+            .WillOnce(Return(true));
+        EXPECT_CALL(*node_, Propose(_))
+            .Times(0);
+
+        opReq->Process();
+
+        // 验证结果
+        ASSERT_FALSE(closure->isDone_);
+        ASSERT_FALSE(response->has_appliedindex());
+        ASSERT_FALSE(closure->response_->has_status());
+
+        closure->Run();
+        ASSERT_TRUE(closure->isDone_);
+    }
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == false, 请求开启followerRead,
+     *       请求的 apply index 小于等于 node的 apply index，
+     *       但是node在等待时间内没有apply到leader的read index
+     * 预期： 返回CHUNK_OP_STATUS_REDIRECTED，由client转发给leader
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        // 设置预期
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(false));
+        EXPECT_CALL(*node_, FetchLeaderReadIndex(request->chunkid(), _))
+            .WillOnce(DoAll(SetArgPointee<1>(LAST_INDEX + 1), Return(0)));
+        EXPECT_CALL(*node_, WaitAppliedWatermark(LAST_INDEX + 1, _))
+            .WillOnce(Return(false));
+        EXPECT_CALL(*node_, Propose(_))
+            .Times(0);
+
+        opReq->Process();
+
+        // 验证结果
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED,
+                  closure->response_->status());
+    }
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == false, 请求开启followerRead,
+     *       从leader获取read index失败
+     * 预期： 返回CHUNK_OP_STATUS_REDIRECTED，由client转发给leader
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        // 设置预期
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(false));
+        EXPECT_CALL(*node_, FetchLeaderReadIndex(request->chunkid(), _))
+            .WillOnce(Return(-1));
+        EXPECT_CALL(*node_, WaitAppliedWatermark(_, _))
+            .Times(0);
+        EXPECT_CALL(*node_, Propose(_))
+            .Times(0);
+
+        opReq->Process();
+
+        // 验证结果
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED,
+                  closure->response_->status());
+
+        request->clear_followerread();
+    }
     /**
      * 测试Process
      * 用例： node_->IsLeaderTerm() == true,
@@ -1302,5 +1424,124 @@ TEST_F(OpRequestTest, RecoverChunkTest) {
     closure->Release();
 }
 
+TEST_F(OpRequestTest, BatchReadCloneTest) {
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 10001;
+    uint64_t localChunkId = 12345;
+    uint64_t cloneChunkId = 12346;
+    uint32_t length = PAGE_SIZE;
+    ChunkRequest* request = new ChunkRequest();
+    request->set_logicpoolid(logicPoolId);
+    request->set_copysetid(copysetId);
+    request->set_chunkid(0);
+    request->set_optype(CHUNK_OP_READ_BATCH);
+    for (uint64_t chunkId : {localChunkId, cloneChunkId}) {
+        ChunkRequest *sub = request->add_subrequests();
+        sub->set_logicpoolid(logicPoolId);
+        sub->set_copysetid(copysetId);
+        sub->set_chunkid(chunkId);
+        sub->set_optype(CHUNK_OP_READ);
+        sub->set_offset(0);
+        sub->set_size(length);
+    }
+    brpc::Controller *cntl = new brpc::Controller();
+    ChunkResponse *response = new ChunkResponse();
+    UnitTestClosure *closure = new UnitTestClosure();
+    closure->SetCntl(cntl);
+    closure->SetRequest(request);
+    closure->SetResponse(response);
+    std::shared_ptr<ChunkBatchRequest> opReq =
+        std::make_shared<ChunkBatchRequest>(node_,
+                                            cloneMgr_.get(),
+                                            cntl,
+                                            request,
+                                            response,
+                                            closure);
+
+    CSChunkInfo localInfo;
+    localInfo.isClone = false;
+    CSChunkInfo cloneInfo;
+    cloneInfo.isClone = true;
+    cloneInfo.pageSize = PAGE_SIZE;
+    cloneInfo.chunkSize = CHUNK_SIZE;
+    cloneInfo.bitmap = std::make_shared<Bitmap>(CHUNK_SIZE / PAGE_SIZE);
+    char chunkData[length];  // NOLINT
+    memset(chunkData, 'a', length);
+    /**
+     * 用例：一个子请求读本地chunk，一个子请求读clone chunk上未写过的区域
+     * 预期：clone的子请求交给clone manager，完成后整个请求才返回
+     */
+    {
+        EXPECT_CALL(*datastore_, GetChunkInfo(localChunkId, _))
+            .WillOnce(DoAll(SetArgPointee<1>(localInfo),
+                            Return(CSErrorCode::Success)));
+        EXPECT_CALL(*datastore_, GetChunkInfo(cloneChunkId, _))
+            .WillOnce(DoAll(SetArgPointee<1>(cloneInfo),
+                            Return(CSErrorCode::Success)));
+        EXPECT_CALL(*datastore_, ReadChunk(localChunkId, _, _, 0, length))
+            .WillOnce(DoAll(SetArrayArgument<2>(chunkData,
+                                                chunkData + length),
+                            Return(CSErrorCode::Success)));
+        Closure *cloneDone = nullptr;
+        EXPECT_CALL(*cloneMgr_, GenerateCloneTask(_, _))
+            .WillOnce(DoAll(SaveArg<1>(&cloneDone), Return(nullptr)));
+        EXPECT_CALL(*cloneMgr_, IssueCloneTask(_))
+            .WillOnce(Return(true));
+        EXPECT_CALL(*node_, UpdateAppliedIndex(_))
+            .Times(1);
+
+        opReq->OnApply(3, closure);
+        ASSERT_FALSE(closure->isDone_);
+        ASSERT_TRUE(cloneDone != nullptr);
+
+        // clone core处理完成
+        response->mutable_subresponses(1)->set_status(
+            CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+        cloneDone->Run();
+
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  response->status());
+        ASSERT_EQ(std::string(chunkData, length),
+                  cntl->response_attachment().to_string());
+    }
+    /**
+     * 用例：clone任务提交失败
+     * 预期：对应子请求失败，整个请求的状态为失败子请求的状态
+     */
+    {
+        closure->Reset();
+        EXPECT_CALL(*datastore_, GetChunkInfo(localChunkId, _))
+            .WillOnce(DoAll(SetArgPointee<1>(localInfo),
+                            Return(CSErrorCode::Success)));
+        EXPECT_CALL(*datastore_, GetChunkInfo(cloneChunkId, _))
+            .WillOnce(DoAll(SetArgPointee<1>(cloneInfo),
+                            Return(CSErrorCode::Success)));
+        EXPECT_CALL(*datastore_, ReadChunk(localChunkId, _, _, 0, length))
+            .WillOnce(DoAll(SetArrayArgument<2>(chunkData,
+                                                chunkData + length),
+                            Return(CSErrorCode::Success)));
+        EXPECT_CALL(*cloneMgr_, GenerateCloneTask(_, _))
+            .WillOnce(Return(nullptr));
+        EXPECT_CALL(*cloneMgr_, IssueCloneTask(_))
+            .WillOnce(Return(false));
+        EXPECT_CALL(*node_, UpdateAppliedIndex(_))
+            .Times(0);
+
+        opReq->OnApply(3, closure);
+
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN,
+                  response->status());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  response->subresponses(0).status());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN,
+                  response->subresponses(1).status());
+        ASSERT_EQ(std::string(chunkData, length),
+                  cntl->response_attachment().to_string());
+    }
+    closure->Release();
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -24,6 +24,9 @@
 
 #include <atomic>
 #include <functional>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
 
 #include "proto/chunk.pb.h"
 #include "src/common/timeutility.h"
@@ -122,6 +125,205 @@ TEST(ConcurrentApplyModule, FlushTest) {
     concurrentapply.Stop();
 }
 
+TEST(ConcurrentApplyModule, FlushAsyncTest) {
+    ConcurrentApplyModule concurrentapply;
+    ConcurrentApplyOption opt{2, 5000, 1, 1};
+    ASSERT_TRUE(concurrentapply.Init(opt));
+
+    std::atomic<uint32_t> testnum(0);
+    auto task = [&testnum]() {
+        testnum.fetch_add(1);
+    };
+
+    for (int i = 0; i < 5000; i++) {
+        concurrentapply.Push(i, CHUNK_OP_TYPE::CHUNK_OP_WRITE, task);
+    }
+
+    // 回调执行时之前放入的写都已经执行完
+    std::atomic<uint32_t> numAtDone(0);
+    CountDownEvent event(1);
+    concurrentapply.FlushAsync([&testnum, &numAtDone, &event]() {
+        numAtDone.store(testnum.load());
+        event.Signal();
+    });
+    event.Wait();
+    ASSERT_EQ(5000, numAtDone);
+
+    concurrentapply.Stop();
+}
+
+TEST(ConcurrentApplyModule, StripeTest) {
+    ConcurrentApplyModule concurrentapply;
+    ConcurrentApplyOption opt{2, 10, 2, 10, 4096};
+    ASSERT_TRUE(concurrentapply.Init(opt));
+
+    // reads of different stripes in one chunk run in different threads
+    std::atomic<bool> secondDone(false);
+    std::atomic<int> result(-1);
+    auto rtask1 = [&]() {
+        for (int i = 0; i < 100 && !secondDone.load(); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        result.store(secondDone.load() ? 1 : 0);
+    };
+    auto rtask2 = [&]() {
+        secondDone.store(true);
+    };
+    ASSERT_TRUE(concurrentapply.Push(
+        1, 0, CHUNK_OP_TYPE::CHUNK_OP_READ, rtask1));
+    ASSERT_TRUE(concurrentapply.Push(
+        1, 4096, CHUNK_OP_TYPE::CHUNK_OP_READ, rtask2));
+    while (result.load() == -1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(1, result.load());
+
+    // writes of one chunk are always in one thread and keep push order
+    std::vector<int> order;
+    for (int i = 0; i < 10; i++) {
+        auto wtask = [&order, i]() {
+            order.push_back(i);
+        };
+        ASSERT_TRUE(concurrentapply.Push(
+            1, i * 4096, CHUNK_OP_TYPE::CHUNK_OP_WRITE, wtask));
+    }
+    concurrentapply.Flush();
+    ASSERT_EQ(10, order.size());
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(i, order[i]);
+    }
+
+    concurrentapply.Stop();
+}
+
+TEST(ConcurrentApplyModule, WriteStripeTest) {
+    ConcurrentApplyModule concurrentapply;
+    ConcurrentApplyOption opt{4, 10, 2, 10, 0, 4096};
+    ASSERT_TRUE(concurrentapply.Init(opt));
+
+    std::mutex mtx;
+    std::vector<int> order;
+    auto record = [&mtx, &order](int i) {
+        std::lock_guard<std::mutex> lk(mtx);
+        order.push_back(i);
+    };
+
+    // the first write of a chunk records its sn
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 0, 4096, 1, []() {}));
+
+    // writes of different stripes with the same sn run in parallel
+    std::atomic<bool> secondDone(false);
+    std::atomic<int> result(-1);
+    auto wtask1 = [&]() {
+        for (int i = 0; i < 100 && !secondDone.load(); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        result.store(secondDone.load() ? 1 : 0);
+    };
+    auto wtask2 = [&]() {
+        secondDone.store(true);
+    };
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 0, 4096, 1, wtask1));
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 4096, 4096, 1, wtask2));
+    concurrentapply.Flush();
+    ASSERT_EQ(1, result.load());
+
+    // a write across stripes is ordered with writes of both stripes
+    auto slow = [&record](int i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        record(i);
+    };
+    order.clear();
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 0, 4096, 1,
+                                          std::bind(slow, 0)));
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 2048, 4096, 1,
+                                          std::bind(slow, 1)));
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 4096, 4096, 1,
+                                          std::bind(record, 2)));
+    concurrentapply.Flush();
+    ASSERT_EQ((std::vector<int>{0, 1, 2}), order);
+
+    // a write with new sn is ordered with all the writes of the chunk
+    order.clear();
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 0, 4096, 1,
+                                          std::bind(slow, 0)));
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 4096, 4096, 2,
+                                          std::bind(record, 1)));
+    concurrentapply.Flush();
+    ASSERT_EQ((std::vector<int>{0, 1}), order);
+
+    // paste does not depend on sn
+    result.store(-1);
+    secondDone.store(false);
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 0, 4096,
+        ConcurrentApplyModule::kAnySn, wtask1));
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 4096, 4096,
+        ConcurrentApplyModule::kAnySn, wtask2));
+    concurrentapply.Flush();
+    ASSERT_EQ(1, result.load());
+
+    // other ops of the chunk are ordered with all the writes
+    order.clear();
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 0, 4096, 2,
+                                          std::bind(slow, 0)));
+    ASSERT_TRUE(concurrentapply.Push(1, CHUNK_OP_TYPE::CHUNK_OP_DELETE,
+                                     std::bind(record, 1)));
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 4096, 4096, 2,
+                                          std::bind(record, 2)));
+    concurrentapply.Flush();
+    ASSERT_EQ((std::vector<int>{0, 1, 2}), order);
+
+    concurrentapply.Stop();
+}
+
+TEST(ConcurrentApplyModule, ChunkBarrierTest) {
+    // stripes of a chunk are spread over 2 of the 4 write queues
+    ConcurrentApplyModule concurrentapply;
+    ConcurrentApplyOption opt{4, 10, 2, 10, 0, 4096, 2};
+    ASSERT_TRUE(concurrentapply.Init(opt));
+
+    // an op of chunk 1 blocks queue 1 and 2 only, writes of chunk 3 in
+    // queue 3 and 0 still run
+    std::atomic<bool> otherDone(false);
+    std::atomic<int> result(-1);
+    auto slowop = [&]() {
+        for (int i = 0; i < 100 && !otherDone.load(); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        result.store(otherDone.load() ? 1 : 0);
+    };
+    ASSERT_TRUE(concurrentapply.Push(1, CHUNK_OP_TYPE::CHUNK_OP_DELETE,
+                                     slowop));
+    ASSERT_TRUE(concurrentapply.PushWrite(3, 0, 4096, 1, []() {}));
+    ASSERT_TRUE(concurrentapply.PushWrite(3, 4096, 4096, 1, [&]() {
+        otherDone.store(true);
+    }));
+    concurrentapply.Flush();
+    ASSERT_EQ(1, result.load());
+
+    // stripe 2 of chunk 1 shares the queue with stripe 0
+    std::mutex mtx;
+    std::vector<int> order;
+    auto record = [&mtx, &order](int i) {
+        std::lock_guard<std::mutex> lk(mtx);
+        order.push_back(i);
+    };
+    auto slow = [&record](int i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        record(i);
+    };
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 0, 4096, 1,
+                                          std::bind(slow, 0)));
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 0, 4096, 1,
+                                          std::bind(slow, 1)));
+    ASSERT_TRUE(concurrentapply.PushWrite(1, 8192, 4096, 1,
+                                          std::bind(record, 2)));
+    concurrentapply.Flush();
+    ASSERT_EQ((std::vector<int>{0, 1, 2}), order);
+
+    concurrentapply.Stop();
+}
+
 TEST(ConcurrentApplyModule, ConcurrentTest) {
     // interval flush when push
     std::atomic<bool> stop(false);
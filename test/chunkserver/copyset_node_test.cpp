@@ -90,13 +90,14 @@ class FakeSnapshotWriter : public braft::SnapshotWriter {
         return std::string(".");
     }
     void list_files(std::vector<std::string> *files) {
-        return;
+        *files = files_;
     }
     virtual int save_meta(const braft::SnapshotMeta &meta) {
         return 0;
     }
 
     virtual int add_file(const std::string &filename) {
+        files_.push_back(filename);
         return 0;
     }
 
@@ -108,6 +109,9 @@ class FakeSnapshotWriter : public braft::SnapshotWriter {
     virtual int remove_file(const std::string &filename) {
         return 0;
     }
+
+ private:
+    std::vector<std::string> files_;
 };
 
 class FakeClosure : public braft::Closure {
@@ -162,39 +166,76 @@ TEST_F(CopysetNodeTest, error_test) {
     std::string rmCmd("rm -f ");
     rmCmd += kCurveConfEpochFilename;
 
-    // on_snapshot_save: List failed
+    // on_snapshot_save: 文件列表来自datastore的chunk清单，不list数据目录
     {
         LogicPoolID logicPoolID = 123;
         CopysetID copysetID = 1345;
         Configuration conf;
-        std::vector<std::string> files;
-        files.push_back("test-1.txt");
-        files.push_back("test-2.txt");
 
         char *json = "{\"logicPoolId\":123,\"copysetId\":1345,\"epoch\":0,\"checksum\":774340440}";  // NOLINT
         std::string jsonStr(json);
 
         CopysetNode copysetNode(logicPoolID, copysetID, conf);
         ASSERT_EQ(0, copysetNode.Init(defaultOptions_));
-        FakeClosure closure;
-        FakeSnapshotWriter writer;
         std::shared_ptr<MockLocalFileSystem>
             mockfs = std::make_shared<MockLocalFileSystem>();
         std::unique_ptr<ConfEpochFile>
             epochFile(new ConfEpochFile(mockfs));
-
-
         copysetNode.SetLocalFileSystem(mockfs);
         copysetNode.SetConfEpochFile(std::move(epochFile));
-        EXPECT_CALL(*mockfs, Open(_, _)).Times(1).WillOnce(Return(10));
-        EXPECT_CALL(*mockfs, Write(_, Matcher<const char*>(_), _, _)).Times(1)
-            .WillOnce(Return(jsonStr.size()));
-        EXPECT_CALL(*mockfs, Fsync(_)).Times(1).WillOnce(Return(0));
-        EXPECT_CALL(*mockfs, Close(_)).Times(1).WillOnce(Return(0));
-        EXPECT_CALL(*mockfs, List(_, _)).Times(1).WillOnce(Return(-1));
-
-        copysetNode.on_snapshot_save(&writer, &closure);
-        LOG(INFO) << closure.status().error_cstr();
+        DataStoreOptions options;
+        options.baseDir = "./test-temp";
+        options.chunkSize = 16 * 1024 * 1024;
+        options.pageSize = 4 * 1024;
+        std::shared_ptr<FakeCSDataStore> dataStore =
+            std::make_shared<FakeCSDataStore>(options, fs);
+        copysetNode.SetCSDateStore(dataStore);
+        ASSERT_EQ(CSErrorCode::Success,
+                  dataStore->CreateCloneChunk(1, 1, 0, kMaxChunkSize, ""));
+
+        EXPECT_CALL(*mockfs, Open(_, _)).Times(3).WillRepeatedly(Return(10));
+        EXPECT_CALL(*mockfs, Write(_, Matcher<const char*>(_), _, _)).Times(3)
+            .WillRepeatedly(Return(jsonStr.size()));
+        EXPECT_CALL(*mockfs, Fsync(_)).Times(3).WillRepeatedly(Return(0));
+        EXPECT_CALL(*mockfs, Close(_)).Times(3).WillRepeatedly(Return(0));
+        EXPECT_CALL(*mockfs, List(_, _)).Times(0);
+
+        auto checkFiles = [](FakeSnapshotWriter* writer, ChunkID id) {
+            std::vector<std::string> files;
+            writer->list_files(&files);
+            ASSERT_EQ(2, files.size());
+            std::string chunkName = "/chunk_" + std::to_string(id);
+            ASSERT_EQ(chunkName, files[0].substr(
+                files[0].size() - chunkName.size()));
+            ASSERT_EQ(kCurveConfEpochFilename, files[1]);
+        };
+        // 第一次打快照，从清单生成文件列表
+        {
+            FakeClosure closure;
+            FakeSnapshotWriter writer;
+            copysetNode.on_snapshot_save(&writer, &closure);
+            ASSERT_TRUE(closure.status().ok());
+            checkFiles(&writer, 1);
+        }
+        // 清单没有变化，复用上次的文件列表
+        {
+            FakeClosure closure;
+            FakeSnapshotWriter writer;
+            copysetNode.on_snapshot_save(&writer, &closure);
+            ASSERT_TRUE(closure.status().ok());
+            checkFiles(&writer, 1);
+        }
+        // 删除和创建chunk以后，文件列表随清单更新
+        ASSERT_EQ(CSErrorCode::Success, dataStore->DeleteChunk(1, 1));
+        ASSERT_EQ(CSErrorCode::Success,
+                  dataStore->CreateCloneChunk(2, 1, 0, kMaxChunkSize, ""));
+        {
+            FakeClosure closure;
+            FakeSnapshotWriter writer;
+            copysetNode.on_snapshot_save(&writer, &closure);
+            ASSERT_TRUE(closure.status().ok());
+            checkFiles(&writer, 2);
+        }
     }
 
     // on_snapshot_save: save conf open failed
@@ -250,8 +291,6 @@ TEST_F(CopysetNodeTest, error_test) {
             .WillOnce(Return(jsonStr.size()));
         EXPECT_CALL(*mockfs, Fsync(_)).Times(1).WillOnce(Return(0));
         EXPECT_CALL(*mockfs, Close(_)).Times(1).WillOnce(Return(0));
-        EXPECT_CALL(*mockfs, List(_, _)).Times(1)
-            .WillOnce(DoAll(SetArgPointee<1>(files), Return(0)));
 
         copysetNode.on_snapshot_save(&writer, &closure);
     }
@@ -935,6 +974,104 @@ TEST_F(CopysetNodeTest, get_hash) {
     }
 }
 
+TEST_F(CopysetNodeTest, is_lease_leader) {
+    LogicPoolID logicPoolID = 1;
+    CopysetID copysetID = 1;
+    Configuration conf;
+
+    // 未开启lease读
+    {
+        CopysetNode copysetNode(logicPoolID, copysetID, conf);
+        std::shared_ptr<MockNode> mockNode
+            = std::make_shared<MockNode>(logicPoolID,
+                                         copysetID);
+        ASSERT_EQ(0, copysetNode.Init(defaultOptions_));
+        copysetNode.SetCopysetNode(mockNode);
+        copysetNode.on_leader_start(8);
+        EXPECT_CALL(*mockNode, is_leader_lease_valid()).Times(0);
+        ASSERT_FALSE(copysetNode.IsLeaseLeader());
+    }
+    // 开启lease读
+    {
+        CopysetNodeOptions options = defaultOptions_;
+        options.enableLeaseRead = true;
+        CopysetNode copysetNode(logicPoolID, copysetID, conf);
+        std::shared_ptr<MockNode> mockNode
+            = std::make_shared<MockNode>(logicPoolID,
+                                         copysetID);
+        ASSERT_EQ(0, copysetNode.Init(options));
+        copysetNode.SetCopysetNode(mockNode);
+
+        // on_leader_start之前，之前任期的日志可能还没有apply完
+        ASSERT_FALSE(copysetNode.IsLeaseLeader());
+
+        copysetNode.on_leader_start(8);
+        EXPECT_CALL(*mockNode, is_leader_lease_valid())
+            .WillOnce(Return(true))
+            .WillOnce(Return(false));
+        ASSERT_TRUE(copysetNode.IsLeaseLeader());
+        // lease失效
+        ASSERT_FALSE(copysetNode.IsLeaseLeader());
+
+        butil::Status status;
+        copysetNode.on_leader_stop(status);
+        ASSERT_FALSE(copysetNode.IsLeaseLeader());
+    }
+}
+
+TEST_F(CopysetNodeTest, propose_batcher) {
+    LogicPoolID logicPoolID = 1;
+    CopysetID copysetID = 1;
+    Configuration conf;
+
+    // 没有开启批量请求时，老版本的副本无法解析合并的日志，不合并propose
+    {
+        CopysetNodeOptions options = defaultOptions_;
+        options.proposeBatchMaxOps = 16;
+        options.enableBatchRequest = false;
+        CopysetNode copysetNode(logicPoolID, copysetID, conf);
+        ASSERT_EQ(0, copysetNode.Init(options));
+        ASSERT_EQ(nullptr, copysetNode.GetProposeBatcher());
+    }
+    {
+        CopysetNodeOptions options = defaultOptions_;
+        options.proposeBatchMaxOps = 16;
+        options.enableBatchRequest = true;
+        CopysetNode copysetNode(logicPoolID, copysetID, conf);
+        ASSERT_EQ(0, copysetNode.Init(options));
+        ASSERT_NE(nullptr, copysetNode.GetProposeBatcher());
+    }
+}
+
+TEST_F(CopysetNodeTest, get_read_index) {
+    LogicPoolID logicPoolID = 1;
+    CopysetID copysetID = 1;
+    Configuration conf;
+
+    CopysetNode copysetNode(logicPoolID, copysetID, conf);
+    std::shared_ptr<MockNode> mockNode
+        = std::make_shared<MockNode>(logicPoolID,
+                                     copysetID);
+    ASSERT_EQ(0, copysetNode.Init(defaultOptions_));
+    copysetNode.SetCopysetNode(mockNode);
+
+    // 不是leader时不能提供read index
+    uint64_t readIndex = 1;
+    ASSERT_FALSE(copysetNode.GetReadIndex(&readIndex));
+
+    copysetNode.on_leader_start(8);
+    ASSERT_TRUE(copysetNode.GetReadIndex(&readIndex));
+    ASSERT_EQ(0, readIndex);
+
+    // 没有apply任何日志，applied watermark追不上更大的index
+    ASSERT_TRUE(copysetNode.WaitAppliedWatermark(0, 1000));
+    ASSERT_FALSE(copysetNode.WaitAppliedWatermark(1, 1000));
+
+    butil::Status status;
+    copysetNode.on_leader_stop(status);
+    ASSERT_FALSE(copysetNode.GetReadIndex(&readIndex));
+}
+
 TEST_F(CopysetNodeTest, get_leader_status) {
     LogicPoolID logicPoolID = 1;
     CopysetID copysetID = 1;
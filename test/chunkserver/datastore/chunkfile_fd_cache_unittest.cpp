@@ -0,0 +1,234 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "src/chunkserver/datastore/chunkfile_fd_cache.h"
+#include "src/chunkserver/datastore/chunkserver_datastore.h"
+#include "test/fs/mock_local_filesystem.h"
+
+using curve::fs::MockLocalFileSystem;
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Mock;
+using ::testing::NotNull;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+using ::testing::SetArrayArgument;
+
+namespace curve {
+namespace chunkserver {
+
+namespace {
+const ChunkSizeType kChunkSize = 16 * 1024 * 1024;
+const PageSizeType kPageSize = 4096;
+const char kBaseDir[] = "/home/chunkserver/copyset/data";
+const char kChunk1Path[] = "/home/chunkserver/copyset/data/chunk_1";
+const char kChunk2Path[] = "/home/chunkserver/copyset/data/chunk_2";
+}  // namespace
+
+class ChunkFdCacheTest : public testing::Test {
+ public:
+    void SetUp() {
+        lfs_ = std::make_shared<MockLocalFileSystem>();
+    }
+
+ protected:
+    std::shared_ptr<MockLocalFileSystem> lfs_;
+    // 以下地址只作为缓存的key使用
+    int file1_;
+    int file2_;
+    int file3_;
+};
+
+TEST_F(ChunkFdCacheTest, EvictLeastRecentlyUsed) {
+    ChunkFdCache cache(lfs_, 2, 1);
+    cache.Insert(&file1_, 1);
+    cache.Insert(&file2_, 2);
+    ASSERT_EQ(2, cache.GetOpenCount());
+
+    // 命中时不需要打开文件，并且file1变为最近访问
+    int fd = cache.Acquire(&file1_, [] { return -1; });
+    ASSERT_EQ(1, fd);
+    cache.Release(&file1_);
+    ASSERT_EQ(0, cache.GetMissCount());
+
+    // 超过容量，淘汰最久未访问的file2
+    EXPECT_CALL(*lfs_, Close(2)).WillOnce(Return(0));
+    cache.Insert(&file3_, 3);
+    Mock::VerifyAndClearExpectations(lfs_.get());
+    ASSERT_EQ(2, cache.GetOpenCount());
+    ASSERT_EQ(1, cache.GetEvictCount());
+
+    // 被淘汰的file2重新打开，淘汰file1
+    EXPECT_CALL(*lfs_, Close(1)).WillOnce(Return(0));
+    fd = cache.Acquire(&file2_, [] { return 4; });
+    ASSERT_EQ(4, fd);
+    ASSERT_EQ(1, cache.GetMissCount());
+    cache.Release(&file2_);
+    Mock::VerifyAndClearExpectations(lfs_.get());
+
+    // 打开文件失败时返回错误码，不加入缓存
+    fd = cache.Acquire(&file1_, [] { return -ENOENT; });
+    ASSERT_EQ(-ENOENT, fd);
+    ASSERT_EQ(2, cache.GetOpenCount());
+
+    EXPECT_CALL(*lfs_, Close(3)).WillOnce(Return(0));
+    EXPECT_CALL(*lfs_, Close(4)).WillOnce(Return(0));
+}
+
+TEST_F(ChunkFdCacheTest, InUseNotEvicted) {
+    ChunkFdCache cache(lfs_, 1, 1);
+    cache.Insert(&file1_, 1);
+    ASSERT_EQ(1, cache.Acquire(&file1_, [] { return -1; }));
+
+    // file1正在使用，刚打开的file2也不会被淘汰，暂时超过容量
+    EXPECT_CALL(*lfs_, Close(_)).Times(0);
+    cache.Insert(&file2_, 2);
+    Mock::VerifyAndClearExpectations(lfs_.get());
+    ASSERT_EQ(2, cache.GetOpenCount());
+
+    // 释放引用后淘汰到容量以内
+    EXPECT_CALL(*lfs_, Close(1)).WillOnce(Return(0));
+    cache.Release(&file1_);
+    Mock::VerifyAndClearExpectations(lfs_.get());
+    ASSERT_EQ(1, cache.GetOpenCount());
+
+    // 删除文件时关闭fd
+    EXPECT_CALL(*lfs_, Close(2)).WillOnce(Return(0));
+    cache.Erase(&file2_);
+    Mock::VerifyAndClearExpectations(lfs_.get());
+    ASSERT_EQ(0, cache.GetOpenCount());
+    cache.Erase(&file2_);
+}
+
+TEST_F(ChunkFdCacheTest, ChunkFileReopen) {
+    auto cache = std::make_shared<ChunkFdCache>(lfs_, 1, 1);
+    ChunkOptions options;
+    options.baseDir = kBaseDir;
+    options.chunkSize = kChunkSize;
+    options.pageSize = kPageSize;
+    options.fdCache = cache;
+
+    char metaPage[kPageSize] = {0};
+    ChunkFileMetaPage meta;
+    meta.sn = 1;
+    meta.encode(metaPage);
+    struct stat fileInfo;
+    fileInfo.st_size = kChunkSize + kPageSize;
+    EXPECT_CALL(*lfs_, Fstat(_, NotNull()))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(fileInfo), Return(0)));
+    EXPECT_CALL(*lfs_, Read(_, NotNull(), 0, kPageSize))
+        .WillRepeatedly(DoAll(
+            SetArrayArgument<1>(metaPage, metaPage + kPageSize),
+            Return(kPageSize)));
+
+    options.id = 1;
+    CSChunkFile chunk1(lfs_, nullptr, options);
+    EXPECT_CALL(*lfs_, Open(kChunk1Path, _)).WillOnce(Return(1));
+    ASSERT_EQ(CSErrorCode::Success, chunk1.Open(false));
+
+    // 打开chunk2时淘汰chunk1的fd
+    options.id = 2;
+    CSChunkFile chunk2(lfs_, nullptr, options);
+    EXPECT_CALL(*lfs_, Open(kChunk2Path, _)).WillOnce(Return(2));
+    EXPECT_CALL(*lfs_, Close(1)).WillOnce(Return(0));
+    ASSERT_EQ(CSErrorCode::Success, chunk2.Open(false));
+    Mock::VerifyAndClearExpectations(lfs_.get());
+    ASSERT_EQ(1, cache->GetOpenCount());
+
+    // 读chunk1时重新打开文件
+    char buf[kPageSize];
+    EXPECT_CALL(*lfs_, Open(kChunk1Path, _)).WillOnce(Return(3));
+    EXPECT_CALL(*lfs_, Close(2)).WillOnce(Return(0));
+    EXPECT_CALL(*lfs_, Read(3, buf, kPageSize, kPageSize))
+        .WillOnce(Return(kPageSize));
+    ASSERT_EQ(CSErrorCode::Success, chunk1.Read(buf, 0, kPageSize));
+    Mock::VerifyAndClearExpectations(lfs_.get());
+    ASSERT_EQ(1, cache->GetMissCount());
+
+    // 重新打开失败时返回错误
+    EXPECT_CALL(*lfs_, Open(kChunk2Path, _)).WillOnce(Return(-EMFILE));
+    ASSERT_EQ(CSErrorCode::InternalError, chunk2.Read(buf, 0, kPageSize));
+    Mock::VerifyAndClearExpectations(lfs_.get());
+
+    EXPECT_CALL(*lfs_, Close(3)).WillOnce(Return(0));
+}
+
+TEST(CSMetaCacheTest, ShardedMap) {
+    std::shared_ptr<MockLocalFileSystem> lfs =
+        std::make_shared<MockLocalFileSystem>();
+    ChunkOptions options;
+    options.baseDir = kBaseDir;
+    options.chunkSize = kChunkSize;
+    options.pageSize = kPageSize;
+
+    CSMetaCache metaCache(4);
+    for (ChunkID id = 1; id <= 10; ++id) {
+        options.id = id;
+        auto chunkFile = std::make_shared<CSChunkFile>(lfs, nullptr, options);
+        ASSERT_EQ(chunkFile, metaCache.Set(id, chunkFile));
+    }
+    ASSERT_EQ(10, metaCache.Size());
+
+    // 并发创建同一个chunk时返回先Set的chunkFile
+    auto first = metaCache.Get(1);
+    ASSERT_NE(nullptr, first);
+    options.id = 1;
+    auto second = std::make_shared<CSChunkFile>(lfs, nullptr, options);
+    ASSERT_EQ(first, metaCache.Set(1, second));
+
+    metaCache.Remove(2);
+    ASSERT_EQ(nullptr, metaCache.Get(2));
+    ASSERT_EQ(9, metaCache.Size());
+
+    // 遍历所有chunk，返回false时中止
+    std::set<ChunkID> ids;
+    ASSERT_TRUE(metaCache.ForEach(
+        [&ids](ChunkID id, const CSChunkFilePtr&) {
+            ids.insert(id);
+            return true;
+        }));
+    ASSERT_EQ(9, ids.size());
+    ASSERT_EQ(0, ids.count(2));
+    int visited = 0;
+    ASSERT_FALSE(metaCache.ForEach(
+        [&visited](ChunkID, const CSChunkFilePtr&) {
+            return ++visited < 3;
+        }));
+    ASSERT_EQ(3, visited);
+
+    metaCache.Clear();
+    ASSERT_EQ(0, metaCache.Size());
+}
+
+}  // namespace chunkserver
+}  // namespace curve
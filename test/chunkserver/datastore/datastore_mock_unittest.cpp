@@ -22,8 +22,10 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <algorithm>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "include/chunkserver/chunkserver_common.h"
 #include "src/common/bitmap.h"
@@ -1068,6 +1070,113 @@ TEST_F(CSDataStore_test, WriteChunkTest7) {
         .Times(1);
 }
 
+/**
+ * WriteChunkTest
+ * case:chunk存在,请求sn大于chunk的sn以及correctSn,
+ *      chunk不存在快照，cow粒度为4个page
+ * 预期结果:会创建快照文件，第一次写某个page时将所在的4个page都cow到snapshot，
+ * 同一cow单元内后续的写不再cow
+ */
+TEST_F(CSDataStore_test, WriteChunkTestWithCowUnit) {
+    DataStoreOptions options;
+    options.baseDir = baseDir;
+    options.chunkSize = CHUNK_SIZE;
+    options.pageSize = PAGE_SIZE;
+    options.locationLimit = kLocationLimit;
+    options.cowUnitSize = 4 * PAGE_SIZE;
+    dataStore = std::make_shared<CSDataStore>(lfs_, fpool_, options);
+    // initialize
+    FakeEnv();
+    EXPECT_TRUE(dataStore->Initialize());
+
+    ChunkID id = 2;
+    SequenceNum sn = 3;
+    off_t offset = PAGE_SIZE;
+    size_t length = PAGE_SIZE;
+    size_t cowUnit = 4 * PAGE_SIZE;
+    char buf[length];  // NOLINT
+    memset(buf, 0, sizeof(buf));
+    // will Open snapshot file, snap sn equals 2
+    string snapPath = string(baseDir) + "/" +
+        FileNameOperator::GenerateSnapshotName(id, 2);
+    EXPECT_CALL(*lfs_, FileExists(snapPath))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*fpool_, GetFile(snapPath, NotNull()))
+                .WillOnce(Return(0));
+    EXPECT_CALL(*lfs_, Open(snapPath, _))
+        .WillOnce(Return(4));
+    char metapage[PAGE_SIZE];
+    memset(metapage, 0, sizeof(metapage));
+    FakeEncodeSnapshot(metapage, 2);
+    EXPECT_CALL(*lfs_, Read(4, NotNull(), 0, PAGE_SIZE))
+        .WillOnce(DoAll(SetArrayArgument<1>(metapage,
+                        metapage + PAGE_SIZE),
+                        Return(PAGE_SIZE)));
+    // will update metapage
+    EXPECT_CALL(*lfs_, Write(3, Matcher<const char*>(NotNull()), 0, PAGE_SIZE))
+        .Times(1);
+    // will copy the whole cow unit [0, 4 * PAGE_SIZE)
+    EXPECT_CALL(*lfs_, Read(3, NotNull(), PAGE_SIZE, cowUnit))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Write(4, Matcher<const char*>(NotNull()),
+                             PAGE_SIZE, cowUnit))
+        .Times(1);
+    // will update snapshot metapage
+    EXPECT_CALL(*lfs_, Write(4, Matcher<const char*>(NotNull()), 0, PAGE_SIZE))
+        .Times(2);
+    // will write data
+    EXPECT_CALL(*lfs_, Write(3, Matcher<butil::IOBuf>(_),
+                             PAGE_SIZE + offset, length))
+        .Times(1);
+    EXPECT_EQ(CSErrorCode::Success,
+              dataStore->WriteChunk(id,
+                                    sn,
+                                    buf,
+                                    offset,
+                                    length,
+                                    nullptr));
+
+    // 同一cow单元内的其他page不再cow
+    offset = 3 * PAGE_SIZE;
+    EXPECT_CALL(*lfs_, Write(3, Matcher<butil::IOBuf>(_),
+                             PAGE_SIZE + offset, length))
+        .Times(1);
+    EXPECT_EQ(CSErrorCode::Success,
+              dataStore->WriteChunk(id,
+                                    sn,
+                                    buf,
+                                    offset,
+                                    length,
+                                    nullptr));
+
+    // 下一个cow单元需要cow
+    offset = 4 * PAGE_SIZE;
+    EXPECT_CALL(*lfs_, Read(3, NotNull(), PAGE_SIZE + offset, cowUnit))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Write(4, Matcher<const char*>(NotNull()),
+                             PAGE_SIZE + offset, cowUnit))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Write(3, Matcher<butil::IOBuf>(_),
+                             PAGE_SIZE + offset, length))
+        .Times(1);
+    EXPECT_EQ(CSErrorCode::Success,
+              dataStore->WriteChunk(id,
+                                    sn,
+                                    buf,
+                                    offset,
+                                    length,
+                                    nullptr));
+
+    EXPECT_CALL(*lfs_, Close(1))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(2))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(3))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(4))
+        .Times(1);
+}
+
 /**
  * WriteChunkTest
  * case:chunk存在,请求sn等于chunk的sn且不小于correctSn
@@ -1286,10 +1395,10 @@ TEST_F(CSDataStore_test, WriteChunkTest13) {
         EXPECT_CALL(*lfs_, Write(4, Matcher<butil::IOBuf>(_),
                                  PAGE_SIZE + offset, length))
             .Times(1);
-        // update metapage
+        // bitmap只在内存中更新，不会写metapage
         EXPECT_CALL(*lfs_,
                     Write(4, Matcher<const char*>(NotNull()), 0, PAGE_SIZE))
-            .Times(1);
+            .Times(0);
 
         ASSERT_EQ(CSErrorCode::Success,
                   dataStore->WriteChunk(id,
@@ -1347,9 +1456,10 @@ TEST_F(CSDataStore_test, WriteChunkTest13) {
         EXPECT_CALL(*lfs_, Write(4, Matcher<butil::IOBuf>(_),
                                  offset + PAGE_SIZE, length))
             .Times(1);
+        // bitmap只在内存中更新，不会写metapage
         EXPECT_CALL(*lfs_,
                     Write(4, Matcher<const char*>(NotNull()), 0, PAGE_SIZE))
-            .Times(1);
+            .Times(0);
 
         ASSERT_EQ(CSErrorCode::Success,
                   dataStore->WriteChunk(id,
@@ -1504,10 +1614,10 @@ TEST_F(CSDataStore_test, WriteChunkTest14) {
         EXPECT_CALL(*lfs_, Write(4, Matcher<butil::IOBuf>(_),
                                  PAGE_SIZE + offset, length))
             .Times(1);
-        // update metapage
+        // 更新sn时写一次metapage，bitmap只在内存中更新
         EXPECT_CALL(*lfs_,
                     Write(4, Matcher<const char*>(NotNull()), 0, PAGE_SIZE))
-            .Times(2);
+            .Times(1);
 
         ASSERT_EQ(CSErrorCode::Success,
                   dataStore->WriteChunk(id,
@@ -1540,9 +1650,10 @@ TEST_F(CSDataStore_test, WriteChunkTest14) {
         EXPECT_CALL(*lfs_, Write(4, Matcher<butil::IOBuf>(_),
                                  offset + PAGE_SIZE, length))
             .Times(1);
+        // bitmap只在内存中更新，不会写metapage
         EXPECT_CALL(*lfs_,
                     Write(4, Matcher<const char*>(NotNull()), 0, PAGE_SIZE))
-            .Times(1);
+            .Times(0);
 
         ASSERT_EQ(CSErrorCode::Success,
                   dataStore->WriteChunk(id,
@@ -2287,7 +2398,7 @@ TEST_F(CSDataStore_test, WriteChunkErrorTest6) {
         ASSERT_EQ(true, info.isClone);
         ASSERT_EQ(Bitmap::NO_POS, info.bitmap->NextSetBit(0));
     }
-    // case2:更新metapage时失败
+    // case2:写入后持久化bitmap时更新metapage失败
     {
         id = 3;  // not exist
         offset = PAGE_SIZE;
@@ -2295,21 +2406,31 @@ TEST_F(CSDataStore_test, WriteChunkErrorTest6) {
         EXPECT_CALL(*lfs_, Write(4, Matcher<butil::IOBuf>(_),
                                  PAGE_SIZE + offset, length))
             .Times(1);
-        // update metapage
+        // bitmap只在内存中更新，不会写metapage
         EXPECT_CALL(*lfs_,
                     Write(4, Matcher<const char*>(NotNull()), 0, PAGE_SIZE))
-            .WillOnce(Return(-UT_ERRNO));
-        ASSERT_EQ(CSErrorCode::InternalError,
+            .Times(0);
+        ASSERT_EQ(CSErrorCode::Success,
                   dataStore->WriteChunk(id,
                                         sn,
                                         buf,
                                         offset,
                                         length,
                                         nullptr));
-        // 检查paste后chunk的状态
         ASSERT_EQ(CSErrorCode::Success, dataStore->GetChunkInfo(id, &info));
         ASSERT_EQ(true, info.isClone);
-        ASSERT_EQ(Bitmap::NO_POS, info.bitmap->NextSetBit(0));
+        ASSERT_EQ(1, info.bitmap->NextSetBit(0));
+        ASSERT_EQ(3, info.bitmap->NextClearBit(1));
+
+        // 持久化metapage失败，之后可以重试
+        EXPECT_CALL(*lfs_,
+                    Write(4, Matcher<const char*>(NotNull()), 0, PAGE_SIZE))
+            .WillOnce(Return(-UT_ERRNO))
+            .WillOnce(Return(PAGE_SIZE));
+        ASSERT_EQ(CSErrorCode::InternalError, dataStore->SyncMetaPages());
+        ASSERT_EQ(CSErrorCode::Success, dataStore->SyncMetaPages());
+        // bitmap已经持久化，不会再写metapage
+        ASSERT_EQ(CSErrorCode::Success, dataStore->SyncMetaPages());
     }
 
     EXPECT_CALL(*lfs_, Close(1))
@@ -3845,10 +3966,10 @@ TEST_F(CSDataStore_test, PasteChunkTest1) {
         EXPECT_CALL(*lfs_, Write(4, Matcher<const char*>(NotNull()),
                                  PAGE_SIZE + offset, length))
             .Times(1);
-        // update metapage
+        // bitmap只在内存中更新，不会写metapage
         EXPECT_CALL(*lfs_,
                     Write(4, Matcher<const char*>(NotNull()), 0, PAGE_SIZE))
-            .Times(1);
+            .Times(0);
         ASSERT_EQ(CSErrorCode::Success,
                   dataStore->PasteChunk(id,
                                         buf,
@@ -3897,9 +4018,10 @@ TEST_F(CSDataStore_test, PasteChunkTest1) {
         EXPECT_CALL(*lfs_, Write(4, Matcher<const char*>(NotNull()),
                                  4 * PAGE_SIZE, PAGE_SIZE))
             .Times(1);
+        // bitmap只在内存中更新，不会写metapage
         EXPECT_CALL(*lfs_,
                     Write(4, Matcher<const char*>(NotNull()), 0, PAGE_SIZE))
-            .Times(1);
+            .Times(0);
         ASSERT_EQ(CSErrorCode::Success,
                   dataStore->PasteChunk(id,
                                         buf,
@@ -4019,11 +4141,12 @@ TEST_F(CSDataStore_test, PasteChunkErrorTest1) {
         ASSERT_EQ(true, info.isClone);
         ASSERT_EQ(Bitmap::NO_POS, info.bitmap->NextSetBit(0));
     }
-    // case2:更新metapage时失败
+    // case2:paste整个chunk，转为普通chunk时更新metapage失败
     {
         id = 3;  // not exist
-        offset = PAGE_SIZE;
-        length = 2 * PAGE_SIZE;
+        offset = 0;
+        length = CHUNK_SIZE;
+        std::unique_ptr<char[]> buf(new char[length]);
         EXPECT_CALL(*lfs_, Write(4, Matcher<const char*>(NotNull()),
                                  PAGE_SIZE + offset, length))
             .Times(1);
@@ -4033,13 +4156,13 @@ TEST_F(CSDataStore_test, PasteChunkErrorTest1) {
             .WillOnce(Return(-UT_ERRNO));
         ASSERT_EQ(CSErrorCode::InternalError,
                   dataStore->PasteChunk(id,
-                                        buf,
+                                        buf.get(),
                                         offset,
                                         length));
-        // 检查paste后chunk的状态
+        // 检查paste后chunk的状态，仍然是clone chunk
         ASSERT_EQ(CSErrorCode::Success, dataStore->GetChunkInfo(id, &info));
         ASSERT_EQ(true, info.isClone);
-        ASSERT_EQ(Bitmap::NO_POS, info.bitmap->NextSetBit(0));
+        ASSERT_EQ(Bitmap::NO_POS, info.bitmap->NextClearBit(0));
     }
 
     EXPECT_CALL(*lfs_, Close(1))
@@ -4106,6 +4229,48 @@ TEST_F(CSDataStore_test, GetHashErrorTest2) {
         .Times(1);
 }
 
+/*
+ * 从内存中的chunk清单获取文件列表测试
+ * 预期结果: 与数据目录下的文件一致，删除chunk后清单版本号增加
+ */
+TEST_F(CSDataStore_test, ListChunkFilesTest) {
+    // initialize
+    FakeEnv();
+    EXPECT_TRUE(dataStore->Initialize());
+
+    std::vector<std::string> chunkFiles;
+    std::vector<std::string> snapFiles;
+    dataStore->ListChunkFiles(&chunkFiles, &snapFiles);
+    std::sort(chunkFiles.begin(), chunkFiles.end());
+    ASSERT_EQ(2, chunkFiles.size());
+    ASSERT_EQ(chunk1, chunkFiles[0]);
+    ASSERT_EQ(chunk2, chunkFiles[1]);
+    ASSERT_EQ(1, snapFiles.size());
+    ASSERT_EQ(chunk1snap1, snapFiles[0]);
+
+    // chunk没有创建或删除时版本号不变
+    uint64_t version = dataStore->GetManifestVersion();
+    ASSERT_EQ(version, dataStore->GetManifestVersion());
+
+    // 删除chunk2以后，清单中不再包含chunk2
+    EXPECT_CALL(*lfs_, Close(3))
+        .Times(1);
+    EXPECT_CALL(*fpool_, RecycleFile(chunk2Path))
+        .WillOnce(Return(0));
+    EXPECT_EQ(CSErrorCode::Success,
+              dataStore->DeleteChunk(2, 2));
+    ASSERT_GT(dataStore->GetManifestVersion(), version);
+    chunkFiles.clear();
+    dataStore->ListChunkFiles(&chunkFiles, nullptr);
+    ASSERT_EQ(1, chunkFiles.size());
+    ASSERT_EQ(chunk1, chunkFiles[0]);
+
+    EXPECT_CALL(*lfs_, Close(1))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(2))
+        .Times(1);
+}
+
 /*
  * 获取datastore状态测试
  */
@@ -25,6 +25,7 @@
 
 #include <gmock/gmock.h>
 #include <string>
+#include <vector>
 
 #include "src/chunkserver/datastore/chunkserver_datastore.h"
 
@@ -66,6 +67,10 @@ class MockDataStore : public CSDataStore {
                                          off_t,
                                          size_t));
     MOCK_METHOD2(GetChunkInfo, CSErrorCode(ChunkID, CSChunkInfo*));
+    MOCK_METHOD0(SyncMetaPages, CSErrorCode());
+    MOCK_METHOD2(ListChunkFiles, void(std::vector<std::string>*,
+                                      std::vector<std::string>*));
+    MOCK_METHOD0(GetManifestVersion, uint64_t());
     MOCK_METHOD0(GetStatus, DataStoreStatus());
 };
 
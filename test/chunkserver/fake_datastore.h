@@ -51,6 +51,7 @@ class FakeCSDataStore : public CSDataStore {
         snapDeleteFlag_ = false;
         error_ = CSErrorCode::Success;
         chunkSize_ = options.chunkSize;
+        manifestVersion_ = 0;
     }
     virtual ~FakeCSDataStore() {
         delete chunk_;
@@ -72,6 +73,7 @@ class FakeCSDataStore : public CSDataStore {
         }
         if (chunkIds_.find(id) != chunkIds_.end()) {
             chunkIds_.erase(id);
+            ++manifestVersion_;
             return CSErrorCode::Success;
         } else {
             return CSErrorCode::ChunkNotExistError;
@@ -141,7 +143,9 @@ class FakeCSDataStore : public CSDataStore {
         }
         ::memcpy(chunk_+offset, buf.to_string().c_str(), length);
         *cost = length;
-        chunkIds_.insert(id);
+        if (chunkIds_.insert(id).second) {
+            ++manifestVersion_;
+        }
         sn_ = sn;
         return CSErrorCode::Success;
     }
@@ -155,7 +159,9 @@ class FakeCSDataStore : public CSDataStore {
         if (errorCode != CSErrorCode::Success) {
             return errorCode;
         }
-        chunkIds_.insert(id);
+        if (chunkIds_.insert(id).second) {
+            ++manifestVersion_;
+        }
         sn_ = sn;
         return CSErrorCode::Success;
     }
@@ -204,6 +210,20 @@ class FakeCSDataStore : public CSDataStore {
         }
     }
 
+    void ListChunkFiles(std::vector<std::string>* chunkFiles,
+                        std::vector<std::string>* snapFiles) override {
+        if (chunkFiles == nullptr) {
+            return;
+        }
+        for (const auto& id : chunkIds_) {
+            chunkFiles->emplace_back("chunk_" + std::to_string(id));
+        }
+    }
+
+    uint64_t GetManifestVersion() override {
+        return manifestVersion_;
+    }
+
     void InjectError(CSErrorCode errorCode = CSErrorCode::InternalError) {
         error_ = errorCode;
     }
@@ -226,6 +246,7 @@ class FakeCSDataStore : public CSDataStore {
     SequenceNum sn_;
     CSErrorCode error_;
     uint32_t chunkSize_;
+    uint64_t manifestVersion_;
 };
 
 class FakeFilePool : public FilePool {
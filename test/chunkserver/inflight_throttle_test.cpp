@@ -45,6 +45,18 @@ TEST(InflightThrottleTest, basic) {
         ASSERT_FALSE(inflightThrottle.IsOverLoad());
     }
 
+    // 批量请求按子请求个数计数
+    {
+        uint64_t maxInflight = 8;
+        InflightThrottle inflightThrottle(maxInflight);
+        inflightThrottle.Increment(QOS_CLASS_CLIENT, 8);
+        ASSERT_FALSE(inflightThrottle.IsOverLoad());
+        inflightThrottle.Increment(QOS_CLASS_CLIENT, 2);
+        ASSERT_TRUE(inflightThrottle.IsOverLoad());
+        inflightThrottle.Decrement(QOS_CLASS_CLIENT, 2);
+        ASSERT_FALSE(inflightThrottle.IsOverLoad());
+    }
+
     // 并发加
     {
         uint64_t maxInflight = 10000;
@@ -116,5 +128,67 @@ TEST(InflightThrottleTest, basic) {
     }
 }
 
+TEST(InflightThrottleTest, qos_class) {
+    // client:clone:snapshot:scrub = 2:1:1:0, 配额分别为4, 2, 2, 0
+    uint64_t maxInflight = 8;
+    uint32_t weights[QOS_CLASS_NUM] = {2, 1, 1, 0};
+    InflightThrottle inflightThrottle(maxInflight, weights);
+    ASSERT_EQ(4, inflightThrottle.GetQuota(QOS_CLASS_CLIENT));
+    ASSERT_EQ(2, inflightThrottle.GetQuota(QOS_CLASS_CLONE));
+    ASSERT_EQ(2, inflightThrottle.GetQuota(QOS_CLASS_SNAPSHOT));
+    ASSERT_EQ(0, inflightThrottle.GetQuota(QOS_CLASS_SCRUB));
+
+    // 1. 其他类别空闲时, clone请求可以使用snapshot空闲的配额,
+    //    但不能使用给client保留的配额
+    for (int i = 0; i < 4; ++i) {
+        inflightThrottle.Increment(QOS_CLASS_CLONE);
+        ASSERT_FALSE(inflightThrottle.IsOverLoad(QOS_CLASS_CLONE));
+    }
+    inflightThrottle.Increment(QOS_CLASS_CLONE);
+    ASSERT_TRUE(inflightThrottle.IsOverLoad(QOS_CLASS_CLONE));
+    inflightThrottle.Decrement(QOS_CLASS_CLONE);
+
+    // 2. clone请求占满空闲配额时, client请求仍然可以使用自己的配额,
+    //    之后总数达到上限
+    for (int i = 0; i < 4; ++i) {
+        inflightThrottle.Increment(QOS_CLASS_CLIENT);
+        ASSERT_FALSE(inflightThrottle.IsOverLoad(QOS_CLASS_CLIENT));
+    }
+    inflightThrottle.Increment(QOS_CLASS_CLIENT);
+    ASSERT_TRUE(inflightThrottle.IsOverLoad(QOS_CLASS_CLIENT));
+    inflightThrottle.Decrement(QOS_CLASS_CLIENT);
+
+    // 3. 总数达到上限时所有类别都被限制, 包括没有超过自己配额的类别
+    inflightThrottle.Increment(QOS_CLASS_CLONE);
+    ASSERT_TRUE(inflightThrottle.IsOverLoad(QOS_CLASS_CLONE));
+    inflightThrottle.Decrement(QOS_CLASS_CLONE);
+    inflightThrottle.Increment(QOS_CLASS_SNAPSHOT);
+    ASSERT_TRUE(inflightThrottle.IsOverLoad(QOS_CLASS_SNAPSHOT));
+    inflightThrottle.Decrement(QOS_CLASS_SNAPSHOT);
+
+    // 4. client请求减少后, snapshot请求可以使用自己的配额,
+    //    没有配额的scrub请求不能使用给client保留的配额
+    inflightThrottle.Decrement(QOS_CLASS_CLIENT);
+    inflightThrottle.Decrement(QOS_CLASS_CLIENT);
+    inflightThrottle.Increment(QOS_CLASS_SNAPSHOT);
+    ASSERT_FALSE(inflightThrottle.IsOverLoad(QOS_CLASS_SNAPSHOT));
+    inflightThrottle.Decrement(QOS_CLASS_SNAPSHOT);
+    inflightThrottle.Increment(QOS_CLASS_SCRUB);
+    ASSERT_TRUE(inflightThrottle.IsOverLoad(QOS_CLASS_SCRUB));
+    inflightThrottle.Decrement(QOS_CLASS_SCRUB);
+
+    // 5. clone请求结束后, client请求可以使用其他类别空闲的配额,
+    //    但总数不能超过上限
+    for (int i = 0; i < 4; ++i) {
+        inflightThrottle.Decrement(QOS_CLASS_CLONE);
+    }
+    for (int i = 0; i < 6; ++i) {
+        inflightThrottle.Increment(QOS_CLASS_CLIENT);
+        ASSERT_FALSE(inflightThrottle.IsOverLoad(QOS_CLASS_CLIENT));
+    }
+    inflightThrottle.Increment(QOS_CLASS_CLIENT);
+    ASSERT_TRUE(inflightThrottle.IsOverLoad(QOS_CLASS_CLIENT));
+}
+
 }  // namespace chunkserver
 }  // namespace curve
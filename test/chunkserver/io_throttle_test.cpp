@@ -0,0 +1,177 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+#include <gtest/gtest.h>
+
+#include "src/chunkserver/io_throttle.h"
+
+namespace curve {
+namespace chunkserver {
+
+TEST(IOThrottleTest, unlimited) {
+    IOThrottleOptions options;
+    IOThrottle throttle(options);
+    ChunkRequest request;
+    request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+    request.set_logicpoolid(1);
+    request.set_copysetid(1);
+    request.set_chunkid(1);
+    request.set_fileid(1);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_FALSE(throttle.IsOverLoad(QOS_CLASS_CLIENT, &request, 4096));
+        ASSERT_FALSE(throttle.IsOverLoad(QOS_CLASS_CLONE, nullptr, 4096));
+    }
+    ASSERT_EQ(0, throttle.VolumeCount());
+}
+
+TEST(IOThrottleTest, disk_reserve_for_client) {
+    // 令牌桶容量为100, client权重占一半, 其他类别需要保留50个令牌
+    IOThrottleOptions options;
+    options.diskIopsLimit = 100;
+    options.weights[QOS_CLASS_CLIENT] = 1;
+    options.weights[QOS_CLASS_CLONE] = 1;
+    options.weights[QOS_CLASS_SNAPSHOT] = 0;
+    options.weights[QOS_CLASS_SCRUB] = 0;
+    IOThrottle throttle(options);
+
+    // 1. clone请求最多取走50个令牌
+    int admitted = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (!throttle.IsOverLoad(QOS_CLASS_CLONE, nullptr, 0)) {
+            ++admitted;
+        }
+    }
+    ASSERT_LE(50, admitted);
+    ASSERT_GT(60, admitted);
+
+    // 2. client请求可以继续使用保留的令牌
+    admitted = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (!throttle.IsOverLoad(QOS_CLASS_CLIENT, nullptr, 0)) {
+            ++admitted;
+        }
+    }
+    ASSERT_LE(40, admitted);
+    ASSERT_GT(60, admitted);
+}
+
+TEST(IOThrottleTest, batch_request_takes_token_per_op) {
+    IOThrottleOptions options;
+    options.diskIopsLimit = 100;
+    IOThrottle throttle(options);
+
+    // 包含50个子请求的批量请求消耗50个iops令牌, 之后只剩下一半的令牌
+    ASSERT_FALSE(throttle.IsOverLoad(QOS_CLASS_CLIENT, nullptr, 0, 50));
+    int admitted = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (!throttle.IsOverLoad(QOS_CLASS_CLIENT, nullptr, 0)) {
+            ++admitted;
+        }
+    }
+    ASSERT_LE(50, admitted);
+    ASSERT_GT(60, admitted);
+}
+
+TEST(IOThrottleTest, volume_limit) {
+    IOThrottleOptions options;
+    IOThrottle throttle(options);
+    ChunkRequest request;
+    request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+    request.set_logicpoolid(1);
+    request.set_copysetid(1);
+    request.set_chunkid(1);
+    request.set_fileid(1);
+    request.set_volumeiopslimit(10);
+
+    // 1. 卷1的iops限制为10
+    int admitted = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (!throttle.IsOverLoad(QOS_CLASS_CLIENT, &request, 4096)) {
+            ++admitted;
+        }
+    }
+    ASSERT_LE(10, admitted);
+    ASSERT_GT(20, admitted);
+
+    // 2. 卷2不受卷1的影响
+    request.set_fileid(2);
+    ASSERT_FALSE(throttle.IsOverLoad(QOS_CLASS_CLIENT, &request, 4096));
+    ASSERT_EQ(2, throttle.VolumeCount());
+
+    // 3. 带宽限制
+    request.set_fileid(3);
+    request.set_volumeiopslimit(0);
+    request.set_volumebpslimit(8192);
+    // 透支一秒的带宽, 之后一秒内的请求都被限制
+    ASSERT_FALSE(throttle.IsOverLoad(QOS_CLASS_CLIENT, &request, 16384));
+    ASSERT_TRUE(throttle.IsOverLoad(QOS_CLASS_CLIENT, &request, 8192));
+}
+
+TEST(IOThrottleTest, throttled_request_takes_no_token) {
+    IOThrottleOptions options;
+    options.diskIopsLimit = 100;
+    IOThrottle throttle(options);
+    ChunkRequest request;
+    request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+    request.set_logicpoolid(1);
+    request.set_copysetid(1);
+    request.set_chunkid(1);
+    request.set_fileid(1);
+    request.set_volumeiopslimit(10);
+    request.set_volumebpslimit(8192);
+
+    // 1. 带宽透支以后, 后续请求都被卷的带宽限制
+    ASSERT_FALSE(throttle.IsOverLoad(QOS_CLASS_CLIENT, &request, 16384));
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(throttle.IsOverLoad(QOS_CLASS_CLIENT, &request, 8192));
+    }
+
+    // 2. 被限制的请求没有消耗卷和磁盘的iops令牌
+    int admitted = 0;
+    for (int i = 0; i < 20; ++i) {
+        if (!throttle.IsOverLoad(QOS_CLASS_CLIENT, &request, 0)) {
+            ++admitted;
+        }
+    }
+    ASSERT_LE(9, admitted);
+    ASSERT_GT(12, admitted);
+
+    // 3. 磁盘的带宽限制也不会消耗磁盘的iops令牌
+    IOThrottleOptions diskOptions;
+    diskOptions.diskIopsLimit = 100;
+    diskOptions.diskBpsLimit = 8192;
+    IOThrottle diskThrottle(diskOptions);
+    ASSERT_FALSE(diskThrottle.IsOverLoad(QOS_CLASS_CLIENT, nullptr, 16384));
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(diskThrottle.IsOverLoad(QOS_CLASS_CLIENT, nullptr, 8192));
+    }
+    admitted = 0;
+    for (int i = 0; i < 200; ++i) {
+        if (!diskThrottle.IsOverLoad(QOS_CLASS_CLIENT, nullptr, 0)) {
+            ++admitted;
+        }
+    }
+    ASSERT_LE(99, admitted);
+    ASSERT_GT(110, admitted);
+}
+
+}  // namespace chunkserver
+}  // namespace curve
@@ -575,6 +575,40 @@ TEST_F(CSMetricTest, ConfigTest) {
                  "{\"conf_name\":\"port\",\"conf_value\":\"9999\"}");
 }
 
+TEST_F(CSMetricTest, TraceTest) {
+    ChunkRequest request;
+    request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+    request.set_logicpoolid(logicId);
+    request.set_copysetid(1);
+    request.set_chunkid(2);
+    request.set_offset(0);
+    request.set_size(PAGE_SIZE);
+    request.set_trace(true);
+
+    OpTrace fast;
+    fast.set_raftus(10);
+    fast.set_applyqueueus(10);
+    fast.set_storageus(10);
+    fast.set_totalus(50);
+    metric_->OnTrace(request, fast);
+
+    OpTrace slow;
+    slow.set_raftus(9000);
+    slow.set_applyqueueus(500);
+    slow.set_storageus(400);
+    slow.set_totalus(10000);
+    request.set_chunkid(3);
+    metric_->OnTrace(request, slow);
+
+    // 慢请求按耗时从大到小输出，并带有各阶段耗时
+    std::string dump = metric_->DumpSlowOps();
+    ASSERT_NE(std::string::npos, dump.find("latency=10000us"));
+    ASSERT_NE(std::string::npos, dump.find("raft: 9000us"));
+    ASSERT_LT(dump.find("chunk: 3"), dump.find("chunk: 2"));
+    ASSERT_EQ(dump, bvar::Variable::describe_exposed(
+        "chunkserver_127_0_0_1_9401_slow_ops"));
+}
+
 TEST_F(CSMetricTest, OnOffTest) {
     ASSERT_EQ(0, metric_->Fini());
     ChunkServerMetricOptions metricOptions;
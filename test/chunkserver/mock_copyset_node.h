@@ -41,10 +41,14 @@ class MockCopysetNode : public CopysetNode {
     MOCK_METHOD0(Run, int());
     MOCK_METHOD0(Fini, void());
     MOCK_CONST_METHOD0(IsLeaderTerm, bool());
+    MOCK_CONST_METHOD0(IsLeaseLeader, bool());
     MOCK_CONST_METHOD0(GetLeaderId, PeerId());
     MOCK_CONST_METHOD0(GetConfEpoch, uint64_t());
     MOCK_METHOD1(UpdateAppliedIndex, void(uint64_t));
     MOCK_CONST_METHOD0(GetAppliedIndex, uint64_t());
+    MOCK_CONST_METHOD1(GetReadIndex, bool(uint64_t*));
+    MOCK_METHOD2(FetchLeaderReadIndex, int(ChunkID, uint64_t*));
+    MOCK_METHOD2(WaitAppliedWatermark, bool(uint64_t, uint64_t));
     MOCK_METHOD3(GetConfChange, int(ConfigChangeType*, Configuration*, Peer*));
     MOCK_METHOD1(GetHash, int(std::string*));
     MOCK_METHOD1(GetStatus, void(NodeStatus*));
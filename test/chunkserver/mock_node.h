@@ -70,6 +70,7 @@ class MockNode : public RaftNode {
     MOCK_METHOD0(enter_readonly_mode, void(void));
     MOCK_METHOD0(leave_readonly_mode, void(void));
     MOCK_METHOD0(readonly, bool());
+    MOCK_METHOD0(is_leader_lease_valid, bool());
 };
 
 }  // namespace chunkserver
@@ -690,5 +690,121 @@ TEST(ChunkOpRequestTest, OnApplyFromLogTest) {
     }
 }
 
+TEST(ChunkOpRequestTest, BatchTest) {
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 10001;
+    uint32_t size = 16;
+    uint64_t sn = 1;
+    uint64_t appliedIndex = 12;
+
+    Configuration conf;
+    std::shared_ptr<CopysetNode> nodePtr =
+        std::make_shared<CopysetNode>(logicPoolId, copysetId, conf);
+    std::shared_ptr<LocalFileSystem>
+        fs(LocalFsFactory::CreateFs(FileSystemType::EXT4, ""));    //NOLINT
+    DataStoreOptions options;
+    options.baseDir = "./test-temp";
+    options.chunkSize = 16 * 1024 * 1024;
+    options.pageSize = 4 * 1024;
+    std::shared_ptr<FakeCSDataStore> dataStore =
+        std::make_shared<FakeCSDataStore>(options, fs);
+    nodePtr->SetCSDateStore(dataStore);
+
+    auto addSub = [&](ChunkRequest *batch, CHUNK_OP_TYPE opType,
+                      uint64_t chunkId, uint32_t offset) {
+        ChunkRequest *sub = batch->add_subrequests();
+        sub->set_optype(opType);
+        sub->set_logicpoolid(logicPoolId);
+        sub->set_copysetid(copysetId);
+        sub->set_chunkid(chunkId);
+        sub->set_offset(offset);
+        sub->set_size(size);
+        sub->set_sn(sn);
+    };
+
+    // write batch: 两个chunk上的三个写请求，编码后作为一条日志
+    ChunkRequest writeRequest;
+    writeRequest.set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH);
+    writeRequest.set_logicpoolid(logicPoolId);
+    writeRequest.set_copysetid(copysetId);
+    writeRequest.set_chunkid(0);
+    addSub(&writeRequest, CHUNK_OP_TYPE::CHUNK_OP_WRITE, 1, 0);
+    addSub(&writeRequest, CHUNK_OP_TYPE::CHUNK_OP_WRITE, 2, size);
+    addSub(&writeRequest, CHUNK_OP_TYPE::CHUNK_OP_WRITE, 1, 2 * size);
+    std::string data = std::string(size, 'a') + std::string(size, 'b')
+                     + std::string(size, 'c');
+    {
+        brpc::Controller cntl;
+        cntl.request_attachment().append(data);
+        butil::IOBuf log;
+        ASSERT_EQ(0, ChunkOpRequest::Encode(&writeRequest,
+                                            &cntl.request_attachment(),
+                                            &log));
+        ChunkRequest request;
+        butil::IOBuf logData;
+        auto req = ChunkOpRequest::Decode(log, &request, &logData);
+        ASSERT_TRUE(dynamic_cast<ChunkBatchRequest*>(req.get()) != nullptr);
+        ASSERT_EQ(3, request.subrequests_size());
+        ASSERT_EQ(data, logData.to_string());
+
+        // follower或者重启回放日志
+        req->OnApplyFromLog(dataStore, request, logData);
+        ASSERT_FALSE(dataStore->HasInjectError());
+    }
+    {
+        ChunkResponse response;
+        brpc::Controller cntl;
+        cntl.request_attachment().append(data);
+        auto opReq = std::make_shared<ChunkBatchRequest>(nodePtr,
+                                                         nullptr,
+                                                         &cntl,
+                                                         &writeRequest,
+                                                         &response,
+                                                         nullptr);
+        OpFakeClosure done;
+        opReq->OnApply(appliedIndex, &done);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS, response.status());
+        ASSERT_EQ(3, response.subresponses_size());
+        for (int i = 0; i < response.subresponses_size(); ++i) {
+            ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                      response.subresponses(i).status());
+        }
+        ASSERT_EQ(appliedIndex, response.appliedindex());
+    }
+
+    // read batch: chunk 3不存在，其余子请求的数据按顺序拼接
+    {
+        ChunkRequest readRequest;
+        readRequest.set_optype(CHUNK_OP_TYPE::CHUNK_OP_READ_BATCH);
+        readRequest.set_logicpoolid(logicPoolId);
+        readRequest.set_copysetid(copysetId);
+        readRequest.set_chunkid(0);
+        addSub(&readRequest, CHUNK_OP_TYPE::CHUNK_OP_READ, 1, 2 * size);
+        addSub(&readRequest, CHUNK_OP_TYPE::CHUNK_OP_READ, 3, 0);
+        addSub(&readRequest, CHUNK_OP_TYPE::CHUNK_OP_READ, 2, size);
+
+        ChunkResponse response;
+        brpc::Controller cntl;
+        auto opReq = std::make_shared<ChunkBatchRequest>(nodePtr,
+                                                         nullptr,
+                                                         &cntl,
+                                                         &readRequest,
+                                                         &response,
+                                                         nullptr);
+        OpFakeClosure done;
+        opReq->OnApply(appliedIndex, &done);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS, response.status());
+        ASSERT_EQ(3, response.subresponses_size());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  response.subresponses(0).status());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_NOTEXIST,
+                  response.subresponses(1).status());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  response.subresponses(2).status());
+        ASSERT_EQ(std::string(size, 'c') + std::string(size, 'b'),
+                  cntl.response_attachment().to_string());
+    }
+}
+
 }  // namespace chunkserver
 }  // namespace curve
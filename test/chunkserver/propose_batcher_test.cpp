@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <butil/iobuf.h>
+#include <brpc/controller.h>
+#include <bthread/bthread.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "proto/chunk.pb.h"
+#include "src/chunkserver/chunk_closure.h"
+#include "src/chunkserver/op_request.h"
+#include "src/chunkserver/propose_batcher.h"
+#include "test/chunkserver/mock_copyset_node.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::testing::_;
+using ::testing::Invoke;
+
+class FakeDoneClosure : public ::google::protobuf::Closure {
+ public:
+    void Run() override {
+        ++runCount;
+    }
+    int runCount = 0;
+};
+
+TEST(ProposeBatcherTest, BatchTest) {
+    auto node = std::make_shared<MockCopysetNode>();
+    ProposeBatchOptions options;
+    options.maxOps = 2;
+    options.maxBytes = 1024 * 1024;
+    ProposeBatcher batcher(node.get(), options);
+
+    const int opNum = 5;
+    const uint32_t size = 4096;
+    // 最后一个请求在新的任期到达
+    int64_t terms[opNum] = {1, 1, 1, 1, 2};
+    ChunkRequest requests[opNum];
+    ChunkResponse responses[opNum];
+    brpc::Controller cntls[opNum];
+    FakeDoneClosure dones[opNum];
+    std::vector<std::shared_ptr<ChunkOpRequest>> ops;
+    for (int i = 0; i < opNum; ++i) {
+        requests[i].set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+        requests[i].set_logicpoolid(1);
+        requests[i].set_copysetid(100);
+        requests[i].set_chunkid(i % 2 + 1);
+        requests[i].set_offset(i * size);
+        requests[i].set_size(size);
+        cntls[i].request_attachment().append(std::string(size, 'a' + i));
+        ops.push_back(std::make_shared<WriteChunkRequest>(node,
+                                                          &cntls[i],
+                                                          &requests[i],
+                                                          &responses[i],
+                                                          &dones[i]));
+    }
+
+    std::vector<ChunkRequest> logs;
+    std::vector<std::string> logData;
+    std::vector<int64_t> logTerms;
+    std::vector<braft::Closure *> closures;
+    std::atomic<int> proposed(0);
+    EXPECT_CALL(*node, Propose(_))
+        .Times(4)
+        .WillRepeatedly(Invoke([&](const braft::Task &task) {
+            ChunkRequest request;
+            butil::IOBuf data;
+            ASSERT_NE(nullptr,
+                      ChunkOpRequest::Decode(*task.data, &request, &data));
+            logs.push_back(request);
+            logData.push_back(data.to_string());
+            logTerms.push_back(task.expected_term);
+            closures.push_back(task.done);
+            // 第一条日志propose期间到达的请求由后台bthread每次propose一批
+            if (logs.size() == 1) {
+                for (int i = 1; i < opNum; ++i) {
+                    batcher.Propose(ops[i],
+                                    &requests[i],
+                                    &cntls[i].request_attachment(),
+                                    terms[i]);
+                }
+            }
+            proposed.fetch_add(1);
+        }));
+    batcher.Propose(ops[0],
+                    &requests[0],
+                    &cntls[0].request_attachment(),
+                    terms[0]);
+    for (int i = 0; i < 1000 && proposed.load() < 4; ++i) {
+        bthread_usleep(1000);
+    }
+
+    // 按个数和任期切分为: [0], [1, 2], [3], [4]
+    ASSERT_EQ(4, logs.size());
+    ASSERT_EQ(CHUNK_OP_TYPE::CHUNK_OP_WRITE, logs[0].optype());
+    ASSERT_EQ(std::string(size, 'a'), logData[0]);
+    ASSERT_EQ(CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH, logs[1].optype());
+    ASSERT_EQ(2, logs[1].subrequests_size());
+    ASSERT_EQ(2, logs[1].subrequests(0).chunkid());
+    ASSERT_EQ(size, logs[1].subrequests(0).offset());
+    ASSERT_EQ(1, logs[1].subrequests(1).chunkid());
+    ASSERT_EQ(2 * size, logs[1].subrequests(1).offset());
+    ASSERT_EQ(std::string(size, 'b') + std::string(size, 'c'), logData[1]);
+    ASSERT_EQ(CHUNK_OP_TYPE::CHUNK_OP_WRITE, logs[2].optype());
+    ASSERT_EQ(CHUNK_OP_TYPE::CHUNK_OP_WRITE, logs[3].optype());
+    ASSERT_EQ(1, logTerms[2]);
+    ASSERT_EQ(2, logTerms[3]);
+
+    // 合并的日志对应ProposeBatchRequest，没有apply时转发其中所有的请求
+    auto chunkClosure = dynamic_cast<ChunkClosure *>(closures[1]);
+    ASSERT_NE(nullptr, chunkClosure);
+    ASSERT_NE(nullptr, std::dynamic_pointer_cast<ProposeBatchRequest>(
+        chunkClosure->request_));
+    closures[1]->status().set_error(EPERM, "leader stepped down");
+    closures[1]->Run();
+    for (int i = 1; i <= 2; ++i) {
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED,
+                  responses[i].status());
+        ASSERT_EQ(1, dones[i].runCount);
+    }
+
+    // 单个请求的日志和原来一样返回
+    for (int i : {0, 2, 3}) {
+        closures[i]->Run();
+    }
+    for (int i : {0, 3, 4}) {
+        ASSERT_EQ(1, dones[i].runCount);
+        ASSERT_FALSE(responses[i].has_status());
+    }
+}
+
+}  // namespace chunkserver
+}  // namespace curve
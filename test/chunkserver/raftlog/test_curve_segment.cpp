@@ -236,5 +236,72 @@ TEST_F(CurveSegmentTest, closed_segment) {
     delete configuration_manager;
 }
 
+TEST_F(CurveSegmentTest, closed_segment_with_index) {
+    EXPECT_CALL(*file_pool, GetFilePoolOpt())
+        .WillRepeatedly(Return(fp_option));
+    EXPECT_CALL(*file_pool, GetFile(_, _))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*file_pool, RecycleFile(_))
+        .WillOnce(Return(0));
+    scoped_refptr<CurveSegment> seg1 =
+                new CurveSegment(kRaftLogDataDir, 1, 0);
+
+    std::string path = kRaftLogDataDir;
+    butil::string_appendf(&path, "/" CURVE_SEGMENT_OPEN_PATTERN, 1);
+    ASSERT_EQ(0, prepare_segment(path));
+    ASSERT_EQ(0, seg1->create());
+    append_entries_curve_segment(seg1);
+    // 追加一个配置变更entry
+    braft::LogEntry* entry = new braft::LogEntry();
+    entry->AddRef();
+    entry->type = braft::ENTRY_TYPE_CONFIGURATION;
+    entry->id.term = 1;
+    entry->id.index = 11;
+    entry->peers = new std::vector<braft::PeerId>;
+    entry->peers->push_back(braft::PeerId("127.0.0.1:8200:0"));
+    ASSERT_EQ(0, seg1->append(entry));
+    entry->Release();
+    ASSERT_EQ(0, seg1->close());
+
+    // close之后生成索引文件
+    std::string index_path = kRaftLogDataDir;
+    butil::string_appendf(&index_path, "/" CURVE_SEGMENT_CLOSED_PATTERN
+                          CURVE_SEGMENT_INDEX_SUFFIX, 1, 11);
+    ASSERT_EQ(0, ::access(index_path.c_str(), F_OK));
+
+    // 通过索引加载
+    {
+        braft::ConfigurationManager configuration_manager;
+        scoped_refptr<CurveSegment> seg2 =
+                            new CurveSegment(kRaftLogDataDir, 1, 11, 0);
+        ASSERT_EQ(0, seg2->load(&configuration_manager));
+        read_entries_curve_segment(seg2);
+        ASSERT_EQ(11, configuration_manager.last_configuration().id.index);
+        ASSERT_EQ(1, seg2->get_term(11));
+    }
+
+    // 索引损坏时扫描segment加载，并重新生成索引
+    {
+        int fd = ::open(index_path.c_str(), O_RDWR);
+        ASSERT_GE(fd, 0);
+        char garbage[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+        ASSERT_EQ(sizeof(garbage),
+                  ::pwrite(fd, garbage, sizeof(garbage), 0));
+        ::close(fd);
+        braft::ConfigurationManager configuration_manager;
+        scoped_refptr<CurveSegment> seg3 =
+                            new CurveSegment(kRaftLogDataDir, 1, 11, 0);
+        ASSERT_EQ(0, seg3->load(&configuration_manager));
+        read_entries_curve_segment(seg3);
+        ASSERT_EQ(11, configuration_manager.last_configuration().id.index);
+        ASSERT_EQ(0, ::access(index_path.c_str(), F_OK));
+    }
+
+    // truncate之后segment变成open状态，索引被删除
+    ASSERT_EQ(0, seg1->truncate(5));
+    ASSERT_NE(0, ::access(index_path.c_str(), F_OK));
+    ASSERT_EQ(0, seg1->unlink());
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -24,6 +24,7 @@
 #include <gmock/gmock.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "src/chunkserver/raftsnapshot/curve_snapshot_attachment.h"
 #include "test/fs/mock_local_filesystem.h"
@@ -88,5 +89,46 @@ TEST_F(CurveSnapshotAttachmentMockTest, ListTest) {
     ASSERT_DEATH(attachment_->list_attach_files(&snapFiles, kRaftSnapDir), "");
 }
 
+TEST_F(CurveSnapshotAttachmentMockTest, ListerTest) {
+    std::string snapPath1 =
+        "../../data/chunk_1_snap_1";
+    std::string snapPath2 =
+        "../../data/chunk_2_snap_1";
+    bool found = true;
+    std::string listedDir;
+    auto lister = [&](const std::string& raftBaseDir,
+                      std::vector<std::string>* files) {
+        listedDir = raftBaseDir;
+        if (!found) {
+            return false;
+        }
+        files->emplace_back("chunk_1_snap_1");
+        files->emplace_back("chunk_2_snap_1");
+        return true;
+    };
+    scoped_refptr<CurveSnapshotAttachment> attachment(
+        new CurveSnapshotAttachment(fs_, lister));
+
+    // 从chunk清单获取，不list数据目录
+    EXPECT_CALL(*fs_, List(_, _))
+        .Times(0);
+    vector<std::string> snapFiles;
+    attachment->list_attach_files(&snapFiles, kRaftSnapDir);
+    ASSERT_EQ("./attachcp/", listedDir);
+    EXPECT_THAT(snapFiles, UnorderedElementsAre(snapPath1.c_str(),
+                                                snapPath2.c_str()));
+    Mock::VerifyAndClearExpectations(fs_.get());
+
+    // 找不到copyset时，改为list数据目录
+    found = false;
+    vector<std::string> fileNames;
+    fileNames.emplace_back("chunk_1");
+    fileNames.emplace_back("chunk_1_snap_1");
+    EXPECT_CALL(*fs_, List(kDataDir, _))
+        .WillOnce(DoAll(SetArgPointee<1>(fileNames), Return(0)));
+    attachment->list_attach_files(&snapFiles, kRaftSnapDir);
+    EXPECT_THAT(snapFiles, UnorderedElementsAre(snapPath1.c_str()));
+}
+
 }   // namespace chunkserver
 }   // namespace curve
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/client/chunk_index_table.h"
+
+namespace curve {
+namespace client {
+
+TEST(ChunkIndexTableTest, GetAndSet) {
+    ChunkIndexTable table;
+    ChunkIDInfo info;
+    ASSERT_EQ(0, table.Capacity());
+    ASSERT_FALSE(table.Get(0, &info));
+
+    table.Reserve(16);
+    ASSERT_EQ(16, table.Capacity());
+    const uint64_t slotBytes = table.MemoryBytes() / 16;
+    ASSERT_GT(slotBytes, 0);
+    ASSERT_FALSE(table.Get(3, &info));
+
+    table.Set(3, ChunkIDInfo(100, 1, 2));
+    ASSERT_TRUE(table.Get(3, &info));
+    ASSERT_EQ(100, info.cid_);
+    ASSERT_EQ(1, info.lpid_);
+    ASSERT_EQ(2, info.cpid_);
+    ASSERT_EQ(1, table.Size());
+
+    // 覆盖写不增加数量
+    table.Set(3, ChunkIDInfo(101, 1, 3));
+    ASSERT_TRUE(table.Get(3, &info));
+    ASSERT_EQ(101, info.cid_);
+    ASSERT_EQ(3, info.cpid_);
+    ASSERT_EQ(1, table.Size());
+
+    // 更小的预留不会缩容
+    table.Reserve(4);
+    ASSERT_EQ(16, table.Capacity());
+
+    // 超出容量时自动扩容，已有的数据保留
+    table.Set(100, ChunkIDInfo(200, 1, 4));
+    ASSERT_EQ(101, table.Capacity());
+    ASSERT_TRUE(table.Get(100, &info));
+    ASSERT_EQ(200, info.cid_);
+    ASSERT_TRUE(table.Get(3, &info));
+    ASSERT_EQ(101, info.cid_);
+    ASSERT_FALSE(table.Get(99, &info));
+    ASSERT_EQ(2, table.Size());
+    // 扩容前的旧数组仍然保留
+    ASSERT_EQ((16 + 101) * slotBytes, table.MemoryBytes());
+}
+
+TEST(ChunkIndexTableTest, ConcurrentReadWrite) {
+    ChunkIndexTable table;
+    const ChunkIndex chunkNum = 10000;
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> mismatch(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&]() {
+            ChunkIDInfo info;
+            while (!stop.load()) {
+                for (ChunkIndex idx = 0; idx < chunkNum; ++idx) {
+                    if (table.Get(idx, &info) &&
+                        (info.cid_ != idx + 1 || info.cpid_ != idx % 100 + 1)) {
+                        mismatch.fetch_add(1);
+                    }
+                }
+            }
+        });
+    }
+
+    // 写线程从小到大写，期间多次扩容
+    for (ChunkIndex idx = 0; idx < chunkNum; ++idx) {
+        table.Set(idx, ChunkIDInfo(idx + 1, 1, idx % 100 + 1));
+    }
+    stop.store(true);
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    ASSERT_EQ(0, mismatch.load());
+    ASSERT_EQ(chunkNum, table.Size());
+    ChunkIDInfo info;
+    for (ChunkIndex idx = 0; idx < chunkNum; ++idx) {
+        ASSERT_TRUE(table.Get(idx, &info));
+        ASSERT_EQ(idx + 1, info.cid_);
+    }
+}
+
+}   // namespace client
+}   // namespace curve
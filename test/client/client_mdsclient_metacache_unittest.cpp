@@ -29,6 +29,7 @@
 #include <brpc/channel.h>
 #include <brpc/errno.pb.h>
 
+#include <set>
 #include <string>
 #include <thread>   //NOLINT
 #include <chrono>   //NOLINT
@@ -1346,6 +1347,72 @@ TEST_F(MDSClientTest, GetLeaderTest) {
 }
 
 
+TEST_F(MDSClientTest, GetFollowerReadPeerTest) {
+    curve::client::MetaCache mc;
+    MetaCacheOption mcOpt;
+    mcOpt.chunkserverUnstableOption.maxStableChunkServerTimeoutTimes = 2;
+    mc.Init(mcOpt, &mdsclient_);
+
+    curve::client::CopysetInfo cslist;
+    for (int i = 1; i <= 3; ++i) {
+        curve::client::ChunkServerAddr addr;
+        addr.Parse("10.182.26." + std::to_string(i) + ":9120:0");
+        cslist.AddCopysetPeerInfo(
+            curve::client::CopysetPeerInfo(i, addr, addr));
+    }
+    mc.UpdateCopysetInfo(1234, 1234, cslist);
+
+    curve::client::ChunkServerID csid;
+    curve::client::EndPoint ep;
+
+    // copyset不存在
+    ASSERT_EQ(-1, mc.GetFollowerReadPeer(1234, 1235, 0, &csid, &ep));
+
+    // 没有超时，按hint分散到所有副本
+    std::set<curve::client::ChunkServerID> selected;
+    for (uint64_t hint = 0; hint < 3; ++hint) {
+        ASSERT_EQ(0, mc.GetFollowerReadPeer(1234, 1234, hint, &csid, &ep));
+        selected.insert(csid);
+    }
+    ASSERT_EQ(3, selected.size());
+
+    // 优先选择超时次数少的副本
+    mc.GetUnstableHelper().IncreTimeout(1);
+    mc.GetUnstableHelper().IncreTimeout(2);
+    for (uint64_t hint = 0; hint < 3; ++hint) {
+        ASSERT_EQ(0, mc.GetFollowerReadPeer(1234, 1234, hint, &csid, &ep));
+        ASSERT_EQ(3, csid);
+    }
+
+    // 超时次数超过阈值的副本不选择
+    for (int i = 0; i < 3; ++i) {
+        mc.GetUnstableHelper().IncreTimeout(3);
+    }
+    mc.GetUnstableHelper().IncreTimeout(2);
+    ASSERT_EQ(0, mc.GetFollowerReadPeer(1234, 1234, 1, &csid, &ep));
+    ASSERT_EQ(1, csid);
+    mc.GetUnstableHelper().IncreTimeout(1);
+    mc.GetUnstableHelper().IncreTimeout(1);
+    ASSERT_EQ(-1, mc.GetFollowerReadPeer(1234, 1234, 0, &csid, &ep));
+
+    // 优先选择本机上的副本
+    curve::client::CopysetInfo localList = cslist;
+    curve::client::ChunkServerAddr localAddr;
+    localAddr.addr_ = butil::EndPoint(butil::my_ip(), 9120);
+    localList.AddCopysetPeerInfo(
+        curve::client::CopysetPeerInfo(4, localAddr, localAddr));
+    mc.UpdateCopysetInfo(1234, 1236, localList);
+    for (uint64_t hint = 0; hint < 4; ++hint) {
+        ASSERT_EQ(0, mc.GetFollowerReadPeer(1234, 1236, hint, &csid, &ep));
+        ASSERT_EQ(4, csid);
+    }
+
+    // leader可能变更时不选择follower
+    localList.SetLeaderUnstableFlag();
+    mc.UpdateCopysetInfo(1234, 1236, localList);
+    ASSERT_EQ(-1, mc.GetFollowerReadPeer(1234, 1236, 0, &csid, &ep));
+}
+
 TEST_F(MDSClientTest, GetFileInfoException) {
     std::string filename = "/1_userinfo_";
     FakeReturn* fakeret = nullptr;
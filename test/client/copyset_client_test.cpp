@@ -3537,6 +3537,167 @@ TEST_F(CopysetClientTest, get_chunk_info_test) {
     }
 }
 
+static void GetChunksInfoFunc(::google::protobuf::RpcController *controller,
+                              const ::curve::chunkserver::GetChunksInfoRequest *request,  //NOLINT
+                              ::curve::chunkserver::GetChunksInfoResponse *response,      //NOLINT
+                              google::protobuf::Closure *done) {
+    brpc::ClosureGuard doneGuard(done);
+    if (0 != gReadCntlFailedCode) {
+        brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
+        cntl->SetFailed(-1, "get chunks info controller error");
+    }
+}
+
+static void GetChunksInfoNoMethodFunc(::google::protobuf::RpcController *controller,  //NOLINT
+                                      const ::curve::chunkserver::GetChunksInfoRequest *request,  //NOLINT
+                                      ::curve::chunkserver::GetChunksInfoResponse *response,      //NOLINT
+                                      google::protobuf::Closure *done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
+    cntl->SetFailed(brpc::ENOMETHOD, "method not found");
+}
+
+/**
+ * get chunks info testing
+ */
+TEST_F(CopysetClientTest, get_chunks_info_test) {
+    MockChunkServiceImpl mockChunkService;
+    ASSERT_EQ(server_->AddService(&mockChunkService,
+                                  brpc::SERVER_DOESNT_OWN_SERVICE), 0);
+    ASSERT_EQ(server_->Start(listenAddr_.c_str(), nullptr), 0);
+
+    IOSenderOption ioSenderOpt;
+    ioSenderOpt.failRequestOpt.chunkserverRPCTimeoutMS = 5000;
+    ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry = 3;
+    ioSenderOpt.failRequestOpt.chunkserverOPRetryIntervalUS = 500;
+    ioSenderOpt.chunkserverEnableAppliedIndexRead = 1;
+
+    CopysetClient copysetClient;
+    MockMetaCache mockMetaCache;
+    mockMetaCache.DelegateToFake();
+    RequestScheduler scheduler;
+    copysetClient.Init(&mockMetaCache, ioSenderOpt, &scheduler);
+
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 100001;
+    std::vector<ChunkID> chunkIds = {1, 2, 3};
+
+    ChunkServerID leaderId = 10000;
+    butil::EndPoint leaderAddr;
+    std::string leaderStr = "127.0.0.1:9109";
+    butil::str2endpoint(leaderStr.c_str(), &leaderAddr);
+
+    FileMetric fm("test");
+    IOTracker iot(nullptr, nullptr, nullptr, &fm);
+
+    /* 成功，返回的chunk顺序与请求不一致，chunk 2不存在 */
+    {
+        std::vector<ChunkInfoDetail> details;
+        RequestContext *reqCtx = new FakeRequestContext();
+        reqCtx->optype_ = OpType::GET_CHUNKS_INFO;
+        reqCtx->idinfo_ = ChunkIDInfo(chunkIds[0], logicPoolId, copysetId);
+        reqCtx->chunkIds_ = chunkIds;
+        reqCtx->chunkinfodetails_ = &details;
+
+        curve::common::CountDownEvent cond(1);
+        RequestClosure *reqDone = new FakeRequestClosure(&cond, reqCtx);
+        reqDone->SetFileMetric(&fm);
+        reqDone->SetIOTracker(&iot);
+        reqCtx->done_ = reqDone;
+        GetChunksInfoResponse response;
+        response.set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+        auto summary3 = response.add_chunkinfos();
+        summary3->set_chunkid(3);
+        summary3->add_chunksn(5);
+        summary3->set_correctedsn(6);
+        summary3->set_isclone(true);
+        summary3->set_writtenpagenum(10);
+        auto summary2 = response.add_chunkinfos();
+        summary2->set_chunkid(2);
+        auto summary1 = response.add_chunkinfos();
+        summary1->set_chunkid(1);
+        summary1->add_chunksn(2);
+        summary1->add_chunksn(1);
+        summary1->set_isclone(false);
+        EXPECT_CALL(mockMetaCache, GetLeader(_, _, _, _, _, _))
+            .Times(AtLeast(1)).WillOnce(DoAll(SetArgPointee<2>(leaderId),
+                                              SetArgPointee<3>(leaderAddr),
+                                              Return(0)));
+        EXPECT_CALL(mockChunkService, GetChunksInfo(_, _, _, _)).Times(1)
+            .WillOnce(DoAll(SetArgPointee<2>(response),
+                            Invoke(GetChunksInfoFunc)));
+        copysetClient.GetChunksInfo(reqCtx->idinfo_, chunkIds, reqDone);
+        cond.Wait();
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  reqDone->GetErrorCode());
+        ASSERT_EQ(3, details.size());
+        ASSERT_EQ(2, details[0].chunkSn.size());
+        ASSERT_FALSE(details[0].isClone);
+        ASSERT_EQ(0, details[1].chunkSn.size());
+        ASSERT_EQ(1, details[2].chunkSn.size());
+        ASSERT_EQ(5, details[2].chunkSn[0]);
+        ASSERT_EQ(6, details[2].correctedSn);
+        ASSERT_TRUE(details[2].isClone);
+        ASSERT_EQ(10, details[2].writtenPageNum);
+    }
+    /* 不是 leader，重定向后成功 */
+    {
+        std::vector<ChunkInfoDetail> details;
+        RequestContext *reqCtx = new FakeRequestContext();
+        reqCtx->optype_ = OpType::GET_CHUNKS_INFO;
+        reqCtx->idinfo_ = ChunkIDInfo(chunkIds[0], logicPoolId, copysetId);
+        reqCtx->chunkIds_ = chunkIds;
+        reqCtx->chunkinfodetails_ = &details;
+
+        curve::common::CountDownEvent cond(1);
+        RequestClosure *reqDone = new FakeRequestClosure(&cond, reqCtx);
+        reqDone->SetFileMetric(&fm);
+        reqDone->SetIOTracker(&iot);
+        reqCtx->done_ = reqDone;
+        GetChunksInfoResponse response1;
+        response1.set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED);
+        response1.set_redirect(leaderStr);
+        GetChunksInfoResponse response2;
+        response2.set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+        EXPECT_CALL(mockMetaCache, GetLeader(_, _, _, _, _, _))
+            .Times(AtLeast(1))
+            .WillRepeatedly(DoAll(SetArgPointee<2>(leaderId),
+                                  SetArgPointee<3>(leaderAddr),
+                                  Return(0)));
+        EXPECT_CALL(mockChunkService, GetChunksInfo(_, _, _, _)).Times(2)
+            .WillOnce(DoAll(SetArgPointee<2>(response1),
+                            Invoke(GetChunksInfoFunc)))
+            .WillOnce(DoAll(SetArgPointee<2>(response2),
+                            Invoke(GetChunksInfoFunc)));
+        copysetClient.GetChunksInfo(reqCtx->idinfo_, chunkIds, reqDone);
+        cond.Wait();
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  reqDone->GetErrorCode());
+        ASSERT_EQ(3, details.size());
+    }
+    /* 老版本chunkserver不支持GetChunksInfo，不重试直接返回ENOMETHOD */
+    {
+        std::vector<ChunkInfoDetail> details;
+        RequestContext *reqCtx = new FakeRequestContext();
+        reqCtx->optype_ = OpType::GET_CHUNKS_INFO;
+        reqCtx->idinfo_ = ChunkIDInfo(chunkIds[0], logicPoolId, copysetId);
+        reqCtx->chunkIds_ = chunkIds;
+        reqCtx->chunkinfodetails_ = &details;
+
+        curve::common::CountDownEvent cond(1);
+        RequestClosure *reqDone = new FakeRequestClosure(&cond, reqCtx);
+        reqDone->SetFileMetric(&fm);
+        reqDone->SetIOTracker(&iot);
+        reqCtx->done_ = reqDone;
+        EXPECT_CALL(mockChunkService, GetChunksInfo(_, _, _, _)).Times(1)
+            .WillOnce(Invoke(GetChunksInfoNoMethodFunc));
+        copysetClient.GetChunksInfo(reqCtx->idinfo_, chunkIds, reqDone);
+        cond.Wait();
+        ASSERT_EQ(brpc::ENOMETHOD, reqDone->GetErrorCode());
+        ASSERT_TRUE(details.empty());
+    }
+}
+
 bool gWriteSuccessFlag = false;
 
 void WriteCallBack(CurveAioContext* aioctx) {
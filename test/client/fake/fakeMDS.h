@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <limits>
 #include <utility>
 #include <map>
 #include "src/client/client_common.h"
@@ -196,6 +197,16 @@ class FakeMDSCurveFSService : public curve::mds::CurveFSService {
         response->CopyFrom(*resp);
     }
 
+    // 不返回已分配的segment，IO时仍然通过GetOrAllocateSegment获取
+    void ListSegments(::google::protobuf::RpcController* controller,
+                      const ::curve::mds::ListSegmentsRequest* request,
+                      ::curve::mds::ListSegmentsResponse* response,
+                      ::google::protobuf::Closure* done) {
+        brpc::ClosureGuard done_guard(done);
+        response->set_statuscode(::curve::mds::StatusCode::kOK);
+        response->set_nextoffset(std::numeric_limits<uint64_t>::max());
+    }
+
     void OpenFile(::google::protobuf::RpcController* controller,
                 const ::curve::mds::OpenFileRequest* request,
                 ::curve::mds::OpenFileResponse* response,
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "src/client/file_throttle.h"
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace client {
+
+using curve::common::TimeUtility;
+
+TEST(FileThrottleTest, DisabledByDefault) {
+    FileThrottle throttle;
+    ThrottleOption opt;
+    throttle.Init(opt);
+
+    ASSERT_FALSE(throttle.Enabled());
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(0, throttle.Add(4096));
+    }
+
+    // 限制值都为0时关闭限流
+    throttle.UpdateThrottleParams(100, 0);
+    ASSERT_TRUE(throttle.Enabled());
+    throttle.UpdateThrottleParams(0, 0);
+    ASSERT_FALSE(throttle.Enabled());
+}
+
+TEST(FileThrottleTest, IopsAndBpsLimit) {
+    FileThrottle throttle;
+    ThrottleOption opt;
+    opt.burstSeconds = 2;
+    throttle.Init(opt);
+
+    // 1. iops限制，桶中可以积累2s的令牌
+    throttle.UpdateThrottleParams(100, 0);
+    uint64_t now = TimeUtility::GetTimeofDayUs();
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_EQ(0, throttle.Reserve(4096, now));
+    }
+    ASSERT_EQ(10000, throttle.Reserve(4096, now));
+    ASSERT_EQ(20000, throttle.Reserve(4096, now));
+
+    // 2. 同时限制iops和带宽时，等待时间取两者中较大的
+    throttle.UpdateThrottleParams(1000, 1024 * 1024);
+    now += 10 * 1000000;
+    ASSERT_EQ(0, throttle.Reserve(2 * 1024 * 1024, now));
+    ASSERT_EQ(1000000, throttle.Reserve(1024 * 1024, now));
+    ASSERT_EQ(1000000, throttle.Reserve(0, now));
+
+}
+
+TEST(FileThrottleTest, WaitForTokens) {
+    FileThrottle throttle;
+    ThrottleOption opt;
+    throttle.Init(opt);
+
+    // 桶中的1000个令牌用完后，每个IO需要等待1ms
+    throttle.UpdateThrottleParams(1000, 0);
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    uint64_t waitUs = 0;
+    for (int i = 0; i < 1100; ++i) {
+        waitUs += throttle.Add(4096);
+    }
+    ASSERT_GT(waitUs, 0);
+    ASSERT_GE(TimeUtility::GetTimeofDayUs() - start, 50000);
+}
+
+}  // namespace client
+}  // namespace curve
@@ -28,7 +28,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <atomic>
 #include <set>
+#include <string>
 
 #include "proto/chunk.pb.h"
 #include "src/client/client_common.h"
@@ -74,6 +76,47 @@ class FakeChunkServiceImpl : public ChunkService {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
     }
 
+    void WriteChunks(::google::protobuf::RpcController *controller,
+                     const ::curve::chunkserver::ChunkRequest *request,
+                     ::curve::chunkserver::ChunkResponse *response,
+                     google::protobuf::Closure *done) {
+        brpc::ClosureGuard doneGuard(done);
+
+        batchCount_.fetch_add(1);
+        brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
+        butil::IOBuf data = cntl->request_attachment();
+        for (const auto &sub : request->subrequests()) {
+            chunkIds_.insert(sub.chunkid());
+            std::string buf;
+            data.cutn(&buf, sub.size());
+            ::memcpy(chunk_ + sub.offset(), buf.c_str(), sub.size());
+            response->add_subresponses()->set_status(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+        }
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+    }
+
+    void ReadChunks(::google::protobuf::RpcController *controller,
+                    const ::curve::chunkserver::ChunkRequest *request,
+                    ::curve::chunkserver::ChunkResponse *response,
+                    google::protobuf::Closure *done) {
+        brpc::ClosureGuard doneGuard(done);
+
+        batchCount_.fetch_add(1);
+        brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
+        for (const auto &sub : request->subrequests()) {
+            cntl->response_attachment().append(chunk_ + sub.offset(),
+                                               sub.size());
+            response->add_subresponses()->set_status(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+        }
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+    }
+
+    uint32_t GetBatchCount() const {
+        return batchCount_.load();
+    }
+
     void ReadChunkSnapshot(::google::protobuf::RpcController *controller,
                            const ::curve::chunkserver::ChunkRequest *request,
                            ::curve::chunkserver::ChunkResponse *response,
@@ -132,6 +175,7 @@ class FakeChunkServiceImpl : public ChunkService {
 
  private:
     std::set<ChunkID> chunkIds_;
+    std::atomic<uint32_t> batchCount_{0};
     /* 由于 bthread 栈空间的限制，这里不会开很大的空间，如果测试需要更大的空间
      * 请在堆上申请 */
     char chunk_[4096] = {0};
@@ -165,6 +209,11 @@ class MockChunkServiceImpl : public ChunkService {
         const ::curve::chunkserver::GetChunkInfoRequest *request,
         ::curve::chunkserver::GetChunkInfoResponse *response,
         google::protobuf::Closure *done));
+    MOCK_METHOD4(GetChunksInfo, void(::google::protobuf::RpcController
+        *controller,
+        const ::curve::chunkserver::GetChunksInfoRequest *request,
+        ::curve::chunkserver::GetChunksInfoResponse *response,
+        google::protobuf::Closure *done));
     MOCK_METHOD4(CreateCloneChunk,
                  void(::google::protobuf::RpcController* controller,
                       const ::curve::chunkserver::ChunkRequest* request,
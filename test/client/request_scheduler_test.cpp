@@ -567,6 +567,92 @@ TEST(RequestSchedulerTest, fake_server_test) {
     ASSERT_EQ(0, server.Join());
 }
 
+TEST(RequestSchedulerTest, BatchTest) {
+    RequestScheduleOption opt;
+    opt.scheduleQueueCapacity = 4096;
+    opt.scheduleThreadpoolSize = 1;
+    opt.batchMaxRequests = 8;
+    opt.ioSenderOpt.failRequestOpt.chunkserverRPCTimeoutMS = 200;
+    opt.ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry = 5;
+    opt.ioSenderOpt.failRequestOpt.chunkserverOPRetryIntervalUS = 5000;
+    opt.ioSenderOpt.chunkserverEnableAppliedIndexRead = 1;
+
+    brpc::Server server;
+    std::string listenAddr = "127.0.0.1:9109";
+    FakeChunkServiceImpl fakeChunkService;
+    ASSERT_EQ(server.AddService(&fakeChunkService,
+                                brpc::SERVER_DOESNT_OWN_SERVICE), 0);
+    brpc::ServerOptions option;
+    option.idle_timeout_sec = -1;
+    ASSERT_EQ(server.Start(listenAddr.c_str(), &option), 0);
+
+    MockMetaCache mockMetaCache;
+    mockMetaCache.DelegateToFake();
+    EXPECT_CALL(mockMetaCache, GetLeader(_, _, _, _, _, _)).Times(AnyNumber());
+
+    FileMetric fm("test");
+    IOTracker iot(nullptr, nullptr, nullptr, &fm);
+    const int reqNum = 4;
+    const size_t len = 16;
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 100001;
+
+    // 在scheduler启动前放入队列，调度线程一次取出
+    // 并合并为一个批量请求
+    auto schedule = [&](OpType opType,
+                        std::vector<RequestContext*>* reqCtxs) {
+        RequestScheduler scheduler;
+        ASSERT_EQ(0, scheduler.Init(opt, &mockMetaCache, &fm));
+        curve::common::CountDownEvent cond(reqNum);
+        for (int i = 0; i < reqNum; ++i) {
+            RequestContext *reqCtx = new FakeRequestContext();
+            reqCtx->optype_ = opType;
+            reqCtx->idinfo_ = ChunkIDInfo(i % 2 + 1, logicPoolId, copysetId);
+            reqCtx->offset_ = i * len;
+            reqCtx->rawlength_ = len;
+            if (opType == OpType::WRITE) {
+                reqCtx->writeData_.append(std::string(len, 'a' + i));
+            }
+            RequestClosure *reqDone = new FakeRequestClosure(&cond, reqCtx);
+            reqDone->SetFileMetric(&fm);
+            reqDone->SetIOTracker(&iot);
+            reqCtx->done_ = reqDone;
+            scheduler.GetQueue()->PutBack(BBQItem<RequestContext*>(reqCtx));
+            reqCtxs->push_back(reqCtx);
+        }
+        ASSERT_EQ(0, scheduler.Run());
+        cond.Wait();
+        scheduler.Fini();
+    };
+
+    std::vector<RequestContext*> writeCtxs;
+    schedule(OpType::WRITE, &writeCtxs);
+    ASSERT_EQ(1, fakeChunkService.GetBatchCount());
+    for (auto ctx : writeCtxs) {
+        ASSERT_EQ(0, ctx->done_->GetErrorCode());
+    }
+
+    std::vector<RequestContext*> readCtxs;
+    schedule(OpType::READ, &readCtxs);
+    ASSERT_EQ(2, fakeChunkService.GetBatchCount());
+    for (int i = 0; i < reqNum; ++i) {
+        ASSERT_EQ(0, readCtxs[i]->done_->GetErrorCode());
+        ASSERT_EQ(std::string(len, 'a' + i),
+                  readCtxs[i]->readData_.to_string());
+    }
+
+    for (auto ctx : writeCtxs) {
+        delete ctx->done_;
+        delete ctx;
+    }
+    for (auto ctx : readCtxs) {
+        delete ctx->done_;
+        delete ctx;
+    }
+    ASSERT_EQ(0, server.Stop(0));
+    ASSERT_EQ(0, server.Join());
+}
+
 TEST(RequestSchedulerTest, CommonTest) {
     RequestScheduleOption opt;
     opt.scheduleQueueCapacity = 4096;
@@ -0,0 +1,215 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+#include <gtest/gtest.h>
+#include <glog/logging.h>
+
+#include <string>
+#include <cstring>
+#include <memory>
+
+#include "src/common/compressor.h"
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace common {
+
+namespace {
+// 构造一段可压缩的数据：一半是0，一半是重复的文本
+void FillCompressibleData(char *buf, size_t len) {
+    const char text[] = "2026-10-19 10:00:00 INFO write chunk success\n";
+    memset(buf, 0, len / 2);
+    for (size_t i = len / 2; i < len; ++i) {
+        buf[i] = text[i % (sizeof(text) - 1)];
+    }
+}
+
+// 构造一段不可压缩的数据
+void FillRandomData(char *buf, size_t len) {
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < len; ++i) {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = static_cast<char>(seed >> 16);
+    }
+}
+}  // namespace
+
+TEST(CompressorTest, CompressType) {
+    CompressType type;
+    ASSERT_TRUE(StringToCompressType("none", &type));
+    ASSERT_EQ(CompressType::kNone, type);
+    ASSERT_TRUE(StringToCompressType("zlib", &type));
+    ASSERT_EQ(CompressType::kZlib, type);
+    ASSERT_FALSE(StringToCompressType("lz4", &type));
+    ASSERT_EQ("zlib", CompressTypeToString(CompressType::kZlib));
+
+    ASSERT_EQ(nullptr, NewCompressor(CompressType::kNone, 1));
+    auto compressor = NewCompressor(CompressType::kZlib, 1);
+    ASSERT_NE(nullptr, compressor);
+    ASSERT_EQ(CompressType::kZlib, compressor->GetType());
+}
+
+TEST(CompressorTest, ZlibCompressAndDecompress) {
+    const size_t len = 64 * 1024;
+    std::unique_ptr<char[]> data(new char[len]);
+    std::unique_ptr<char[]> out(new char[len]);
+    ZlibCompressor compressor(1);
+
+    // 1. 可压缩的数据
+    FillCompressibleData(data.get(), len);
+    std::string compressed;
+    ASSERT_TRUE(compressor.Compress(data.get(), len, &compressed));
+    ASSERT_LT(compressed.size(), len);
+    ASSERT_TRUE(compressor.Decompress(compressed.data(), compressed.size(),
+                                      out.get(), len));
+    ASSERT_EQ(0, memcmp(data.get(), out.get(), len));
+
+    // 2. 解压长度不一致或数据损坏
+    ASSERT_FALSE(compressor.Decompress(compressed.data(), compressed.size(),
+                                       out.get(), len / 2));
+    compressed[compressed.size() / 2] ^= 0xff;
+    ASSERT_FALSE(compressor.Decompress(compressed.data(), compressed.size(),
+                                       out.get(), len));
+
+    // 3. 不可压缩的数据
+    FillRandomData(data.get(), len);
+    ASSERT_FALSE(compressor.Compress(data.get(), len, &compressed));
+}
+
+TEST(CompressorTest, BlockIndexSerialize) {
+    CompressedBlockIndex index(CompressType::kZlib, 4096);
+    index.SetBlockLen(0, 100);
+    index.SetBlockLen(1, 4096);
+    index.SetBlockLen(2, 200);
+    ASSERT_EQ(3, index.GetBlockNum());
+    ASSERT_EQ(0, index.GetBlockOffset(0));
+    ASSERT_EQ(4196, index.GetBlockOffset(2));
+
+    std::string data = index.Serialize();
+    ASSERT_EQ("zlib 4096\n100\n4096\n200\n", data);
+    CompressedBlockIndex index2;
+    ASSERT_TRUE(index2.Parse(data));
+    ASSERT_EQ(CompressType::kZlib, index2.GetType());
+    ASSERT_EQ(4096, index2.GetBlockSize());
+    ASSERT_EQ(3, index2.GetBlockNum());
+    ASSERT_EQ(200, index2.GetBlockLen(2));
+
+    ASSERT_FALSE(index2.Parse(""));
+    ASSERT_FALSE(index2.Parse("lz4 4096\n100\n"));
+    ASSERT_FALSE(index2.Parse("zlib 4096\n5000\n"));
+    ASSERT_FALSE(index2.Parse("zlib 4096\nabc\n"));
+
+    uint64_t storedOffset, storedLen;
+    ASSERT_TRUE(index.GetStoredRange(4096, 8192, &storedOffset, &storedLen));
+    ASSERT_EQ(100, storedOffset);
+    ASSERT_EQ(4296, storedLen);
+    ASSERT_TRUE(index.GetStoredRange(10, 1, &storedOffset, &storedLen));
+    ASSERT_EQ(0, storedOffset);
+    ASSERT_EQ(100, storedLen);
+    ASSERT_FALSE(index.GetStoredRange(8192, 4097, &storedOffset, &storedLen));
+    ASSERT_FALSE(index.GetStoredRange(0, 0, &storedOffset, &storedLen));
+}
+
+TEST(CompressorTest, BlockIndexReadRange) {
+    const uint64_t blockSize = 4096;
+    const uint32_t blockNum = 4;
+    const uint64_t len = blockSize * blockNum;
+    std::unique_ptr<char[]> data(new char[len]);
+    FillCompressibleData(data.get(), len);
+    // 第2个块不可压缩
+    FillRandomData(data.get() + blockSize, blockSize);
+
+    // 按块压缩，组织成对象
+    auto compressor = NewCompressor(CompressType::kZlib, 1);
+    CompressedBlockIndex index(CompressType::kZlib, blockSize);
+    std::string object;
+    for (uint32_t i = 0; i < blockNum; ++i) {
+        std::string compressed;
+        const char *block = data.get() + i * blockSize;
+        if (compressor->Compress(block, blockSize, &compressed)) {
+            object.append(compressed);
+            index.SetBlockLen(i, compressed.size());
+        } else {
+            object.append(block, blockSize);
+            index.SetBlockLen(i, blockSize);
+        }
+    }
+    ASSERT_EQ(blockSize, index.GetBlockLen(1));
+    ASSERT_LT(object.size(), len);
+
+    // 任意范围读出的数据与原始数据一致
+    std::unique_ptr<char[]> buf(new char[len]);
+    std::vector<std::pair<uint64_t, uint64_t>> ranges = {
+        {0, len}, {0, 1}, {100, 5000}, {blockSize, blockSize},
+        {blockSize - 1, 2}, {len - 10, 10}, {blockSize * 2 + 7, 3000}};
+    for (auto &range : ranges) {
+        uint64_t storedOffset, storedLen;
+        ASSERT_TRUE(index.GetStoredRange(range.first, range.second,
+                                         &storedOffset, &storedLen));
+        ASSERT_TRUE(index.ReadRange(compressor.get(),
+                                    object.data() + storedOffset,
+                                    range.first, range.second, buf.get()));
+        ASSERT_EQ(0, memcmp(data.get() + range.first, buf.get(),
+                            range.second))
+            << "offset = " << range.first << ", len = " << range.second;
+    }
+
+    // 没有对应的Compressor时读取失败
+    ASSERT_FALSE(index.ReadRange(nullptr, object.data(), 0, len, buf.get()));
+}
+
+// 压缩算法吞吐的基准测试，只输出结果，不做断言
+TEST(CompressorTest, ZlibThroughput) {
+    const size_t blockSize = 1024 * 1024;
+    const int loops = 16;
+    std::unique_ptr<char[]> data(new char[blockSize]);
+    std::unique_ptr<char[]> out(new char[blockSize]);
+    FillCompressibleData(data.get(), blockSize);
+
+    for (int level : {1, 6, 9}) {
+        ZlibCompressor compressor(level);
+        std::string compressed;
+        uint64_t start = TimeUtility::GetTimeofDayUs();
+        for (int i = 0; i < loops; ++i) {
+            ASSERT_TRUE(compressor.Compress(data.get(), blockSize,
+                                            &compressed));
+        }
+        uint64_t compressUs = TimeUtility::GetTimeofDayUs() - start + 1;
+
+        start = TimeUtility::GetTimeofDayUs();
+        for (int i = 0; i < loops; ++i) {
+            ASSERT_TRUE(compressor.Decompress(compressed.data(),
+                compressed.size(), out.get(), blockSize));
+        }
+        uint64_t decompressUs = TimeUtility::GetTimeofDayUs() - start + 1;
+
+        LOG(INFO) << "zlib level " << level
+                  << ", ratio = "
+                  << static_cast<double>(blockSize) / compressed.size()
+                  << ", compress = "
+                  << blockSize * loops / compressUs << " MB/s"
+                  << ", decompress = "
+                  << blockSize * loops / decompressUs << " MB/s";
+    }
+}
+
+}  // namespace common
+}  // namespace curve
@@ -21,6 +21,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <stdlib.h>
+#include <vector>
 
 #include "src/common/crc32.h"
 
@@ -92,5 +94,38 @@ TEST(Crc32TEST, Extend) {
             CRC32(CRC32("hello ", 6), "world", 5));
 }
 
+// 按bit计算的CRC32C，用于校验交错计算的结果
+static uint32_t BitwiseCRC32C(uint32_t crc, const char* buf, size_t len) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= static_cast<unsigned char>(buf[i]);
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0x82f63b78 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+TEST(Crc32TEST, Interleaved) {
+    std::vector<char> buf(64 * 1024 + 16);
+    unsigned int seed = 1;
+    for (auto& c : buf) {
+        c = static_cast<char>(rand_r(&seed));
+    }
+    // 覆盖不对齐的起始地址，以及长短两种交错长度的边界
+    std::vector<size_t> lens = {0, 1, 7, 8, 9, 767, 768, 769, 6143, 6144,
+                                6145, 8192, 10000, 64 * 1024};
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t len : lens) {
+            const char* data = buf.data() + offset;
+            ASSERT_EQ(BitwiseCRC32C(0, data, len), CRC32(data, len))
+                << "offset: " << offset << ", len: " << len;
+            ASSERT_EQ(BitwiseCRC32C(0x12345678, data, len),
+                      CRC32(0x12345678, data, len))
+                << "offset: " << offset << ", len: " << len;
+        }
+    }
+}
+
 }  // namespace common
 }  // namespace curve
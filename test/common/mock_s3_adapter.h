@@ -48,6 +48,9 @@ class MockS3Adapter : public S3Adapter {
                                 const std::string &));
     MOCK_METHOD2(GetObject, int(const Aws::String &,
                                 std::string *));
+    MOCK_METHOD3(GetObjectIfExist, int(const Aws::String &,
+                                       std::string *,
+                                       bool *));
     MOCK_METHOD4(GetObject, int(const std::string &,
                                 char *,
                                 off_t,
@@ -61,13 +64,21 @@ class MockS3Adapter : public S3Adapter {
     MOCK_METHOD2(GetObjectMeta, int(const Aws::String &key,
                          Aws::Map<Aws::String, Aws::String> *));
 */
-    MOCK_METHOD1(MultiUploadInit, Aws::String(const Aws::String &));
+    MOCK_METHOD2(MultiUploadInit, Aws::String(const Aws::String &,
+        const Aws::Map<Aws::String, Aws::String> &));
     MOCK_METHOD5(UploadOnePart,
             Aws::S3::Model::CompletedPart(const Aws::String &,
             const Aws::String,
             int,
             int,
             const char*));
+    MOCK_METHOD6(UploadPartCopy,
+            Aws::S3::Model::CompletedPart(const Aws::String &,
+            const Aws::String &,
+            int,
+            const Aws::String &,
+            uint64_t,
+            int));
     MOCK_METHOD3(CompleteMultiUpload,
                 int(const Aws::String &,
                 const Aws::String &,
@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/common/object_pool.h"
+
+namespace curve {
+namespace common {
+
+namespace {
+
+std::atomic<int> gConstructed(0);
+std::atomic<int> gDestructed(0);
+
+struct PooledItem {
+    PooledItem() : value(0) {
+        gConstructed.fetch_add(1);
+    }
+
+    explicit PooledItem(int v) : value(v) {
+        gConstructed.fetch_add(1);
+    }
+
+    ~PooledItem() {
+        gDestructed.fetch_add(1);
+    }
+
+    int value;
+    char payload[200];
+};
+
+// 通过PoolNew/PoolDelete重载operator new/delete的类
+class PooledObject {
+ public:
+    PooledObject() : value_(0) {}
+    virtual ~PooledObject() = default;
+
+    static void* operator new(size_t size) {
+        return PoolNew<PooledObject>(size);
+    }
+
+    static void operator delete(void* p, size_t size) {
+        PoolDelete<PooledObject>(p, size);
+    }
+
+    int value_;
+};
+
+// 大小和父类不一致，按普通方式分配
+class LargerObject : public PooledObject {
+ public:
+    char payload[512];
+};
+
+}  // namespace
+
+class ObjectPoolTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        gConstructed.store(0);
+        gDestructed.store(0);
+    }
+};
+
+TEST_F(ObjectPoolTest, make_pooled_shared_reuse) {
+    auto item = MakePooledShared<PooledItem>(1);
+    ASSERT_EQ(1, item->value);
+    void* addr = item.get();
+    item.reset();
+
+    // 同一个线程上释放的内存块马上被复用
+    item = MakePooledShared<PooledItem>(2);
+    ASSERT_EQ(addr, item.get());
+    ASSERT_EQ(2, item->value);
+    item.reset();
+
+    ASSERT_EQ(2, gConstructed.load());
+    ASSERT_EQ(2, gDestructed.load());
+}
+
+TEST_F(ObjectPoolTest, make_pooled_shared_deleter) {
+    auto item = MakePooledShared<PooledItem>(1);
+    void* addr = item.get();
+    std::weak_ptr<PooledItem> weak = item;
+    {
+        // 拷贝不会重新分配，最后一个引用释放时才析构
+        std::shared_ptr<PooledItem> copy = item;
+        item.reset();
+        ASSERT_EQ(0, gDestructed.load());
+        ASSERT_EQ(1, copy->value);
+    }
+    ASSERT_EQ(1, gDestructed.load());
+    ASSERT_TRUE(weak.expired());
+
+    // weak_ptr还持有控制块，内存块此时还不能被复用
+    auto other = MakePooledShared<PooledItem>(2);
+    ASSERT_NE(addr, other.get());
+    other.reset();
+
+    // weak_ptr释放后，控制块和对象所在的内存块还给对象池
+    weak.reset();
+    auto reused = MakePooledShared<PooledItem>(3);
+    ASSERT_EQ(addr, reused.get());
+}
+
+TEST_F(ObjectPoolTest, make_pooled_shared_reset_state) {
+    auto item = MakePooledShared<PooledItem>();
+    void* addr = item.get();
+    item->value = 42;
+    item->payload[0] = 'a';
+    item.reset();
+
+    // 复用的内存块上重新构造对象，不会看到上一个对象的状态
+    item = MakePooledShared<PooledItem>();
+    ASSERT_EQ(addr, item.get());
+    ASSERT_EQ(0, item->value);
+    ASSERT_EQ(2, gConstructed.load());
+    ASSERT_EQ(1, gDestructed.load());
+}
+
+TEST_F(ObjectPoolTest, make_pooled_shared_cross_thread) {
+    const int kNum = 10000;
+    std::vector<std::shared_ptr<PooledItem>> items;
+    for (int i = 0; i < kNum; ++i) {
+        items.emplace_back(MakePooledShared<PooledItem>(i));
+    }
+    // 在其他线程上释放，和rpc线程分配、apply线程释放的场景一致
+    std::thread releaser([&items]() {
+        for (int i = 0; i < kNum; ++i) {
+            ASSERT_EQ(i, items[i]->value);
+            items[i].reset();
+        }
+    });
+    releaser.join();
+    ASSERT_EQ(kNum, gConstructed.load());
+    ASSERT_EQ(kNum, gDestructed.load());
+
+    for (int i = 0; i < kNum; ++i) {
+        items[i] = MakePooledShared<PooledItem>(i);
+    }
+    items.clear();
+    ASSERT_EQ(2 * kNum, gDestructed.load());
+}
+
+TEST_F(ObjectPoolTest, pool_new_and_delete) {
+    PooledObject* obj = new PooledObject();
+    void* addr = obj;
+    obj->value_ = 42;
+    delete obj;
+
+    obj = new PooledObject();
+    ASSERT_EQ(addr, obj);
+    ASSERT_EQ(0, obj->value_);
+    delete obj;
+
+    // 子类大小不一致，走普通的分配
+    PooledObject* larger = new LargerObject();
+    ASSERT_NE(addr, larger);
+    delete larger;
+
+    void* p = PoolNew<PooledObject>(sizeof(PooledObject), std::nothrow);
+    ASSERT_NE(nullptr, p);
+    PoolDelete<PooledObject>(p, sizeof(PooledObject));
+    PoolDelete<PooledObject>(nullptr, sizeof(PooledObject));
+}
+
+}  // namespace common
+}  // namespace curve
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "src/common/op_trace.h"
+
+namespace curve {
+namespace common {
+
+TEST(OpTraceTest, SamplerTest) {
+    OpTraceSampler off;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_FALSE(off.Sample());
+    }
+
+    OpTraceSampler sampler(10);
+    int sampled = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (sampler.Sample()) {
+            ++sampled;
+        }
+    }
+    ASSERT_EQ(10, sampled);
+
+    sampler.SetSampleRate(0);
+    ASSERT_FALSE(sampler.Sample());
+}
+
+TEST(OpTraceTest, SlowOpTrackerTest) {
+    SlowOpTracker tracker("op_trace_test", "slow_ops", 3, 60);
+    ASSERT_TRUE(tracker.Accept(1));
+    tracker.Add(10, "op10");
+    tracker.Add(30, "op30");
+    tracker.Add(20, "op20");
+
+    // 已满时只接受比最快的请求更慢的请求
+    ASSERT_FALSE(tracker.Accept(5));
+    ASSERT_TRUE(tracker.Accept(15));
+    tracker.Add(5, "op5");
+    tracker.Add(40, "op40");
+
+    auto ops = tracker.GetSlowOps();
+    ASSERT_EQ(3, ops.size());
+    ASSERT_EQ(40, ops[0].latencyUs);
+    ASSERT_EQ("op40", ops[0].desc);
+    ASSERT_EQ(30, ops[1].latencyUs);
+    ASSERT_EQ(20, ops[2].latencyUs);
+
+    std::string dump = tracker.Dump();
+    ASSERT_NE(std::string::npos, dump.find("latency=40us"));
+    ASSERT_LT(dump.find("op40"), dump.find("op20"));
+
+    std::string value =
+        bvar::Variable::describe_exposed("op_trace_test_slow_ops");
+    ASSERT_NE(std::string::npos, value.find("op30"));
+
+    SlowOpTracker disabled("op_trace_test", "disabled", 0, 60);
+    ASSERT_FALSE(disabled.Accept(100));
+    disabled.Add(100, "op100");
+    ASSERT_TRUE(disabled.GetSlowOps().empty());
+}
+
+}  // namespace common
+}  // namespace curve
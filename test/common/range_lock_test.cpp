@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>   // NOLINT
+#include <vector>
+
+#include "src/common/concurrent/range_lock.h"
+
+namespace curve {
+namespace common {
+
+TEST(RangeLockTest, BasicTest) {
+    RangeLock lock;
+    {
+        RangeLockGuard guard(&lock, 0, 9, true);
+        // 不重叠的区间可以加锁
+        ASSERT_TRUE(lock.TryLock(10, 19, true));
+        lock.Unlock(10, 19, true);
+        // 重叠的区间不能加锁
+        ASSERT_FALSE(lock.TryLock(9, 19, true));
+        ASSERT_FALSE(lock.TryLock(5, 5, false));
+    }
+    {
+        RangeLockGuard guard(&lock, 0, 9, false);
+        // 共享锁之间不冲突
+        ASSERT_TRUE(lock.TryLock(5, 15, false));
+        ASSERT_FALSE(lock.TryLock(9, 9, true));
+        lock.Unlock(5, 15, false);
+        ASSERT_TRUE(lock.TryLock(10, 15, true));
+        lock.Unlock(10, 15, true);
+    }
+    ASSERT_TRUE(lock.TryLock(0, 100, true));
+    lock.Unlock(0, 100, true);
+}
+
+TEST(RangeLockTest, ConcurrentTest) {
+    RangeLock lock;
+    const int kThreadNum = 8;
+    const int kLoop = 10000;
+    // 每个线程写自己的区间，同时都会写一个公共区间
+    std::vector<uint64_t> counters(kThreadNum + 1, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreadNum; ++i) {
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < kLoop; ++j) {
+                {
+                    RangeLockGuard guard(&lock, i, i, true);
+                    ++counters[i];
+                }
+                {
+                    RangeLockGuard guard(&lock, 0, kThreadNum, true);
+                    ++counters[kThreadNum];
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (int i = 0; i < kThreadNum; ++i) {
+        ASSERT_EQ(kLoop, counters[i]);
+    }
+    ASSERT_EQ(kThreadNum * kLoop, counters[kThreadNum]);
+}
+
+TEST(RangeLockTest, WaitTest) {
+    RangeLock lock;
+    std::atomic<bool> acquired(false);
+    lock.Lock(0, 9, true);
+    std::thread t([&]() {
+        RangeLockGuard guard(&lock, 5, 15, false);
+        acquired.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(acquired.load());
+    lock.Unlock(0, 9, true);
+    t.join();
+    ASSERT_TRUE(acquired.load());
+}
+
+TEST(RangeLockTest, WakeOverlappedWaiterTest) {
+    RangeLock lock;
+    std::atomic<bool> acquired1(false);
+    std::atomic<bool> acquired2(false);
+    lock.Lock(0, 9, true);
+    lock.Lock(20, 29, true);
+    std::thread t1([&]() {
+        RangeLockGuard guard(&lock, 5, 5, true);
+        acquired1.store(true);
+    });
+    std::thread t2([&]() {
+        RangeLockGuard guard(&lock, 25, 25, true);
+        acquired2.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // 释放的区间只与第一个等待者重叠
+    lock.Unlock(0, 9, true);
+    t1.join();
+    ASSERT_TRUE(acquired1.load());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(acquired2.load());
+    lock.Unlock(20, 29, true);
+    t2.join();
+    ASSERT_TRUE(acquired2.load());
+}
+
+}   // namespace common
+}   // namespace curve
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+#include <gtest/gtest.h>
+
+#include "src/common/token_bucket.h"
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace common {
+
+TEST(TokenBucketTest, test_unlimited) {
+    TokenBucket bucket(0, 0);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(bucket.Consume(1024 * 1024));
+    }
+}
+
+TEST(TokenBucketTest, test_consume_and_refill) {
+    TokenBucket bucket(100, 10);
+    uint64_t now = TimeUtility::GetTimeofDayUs();
+
+    // 1. 桶初始是满的, 可以连续取10个令牌
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(bucket.Consume(1, 0, now));
+    }
+    ASSERT_FALSE(bucket.Consume(1, 0, now));
+
+    // 2. 100个/s, 10ms产生1个令牌
+    ASSERT_TRUE(bucket.Consume(1, 0, now + 10000));
+    ASSERT_FALSE(bucket.Consume(1, 0, now + 10000));
+
+    // 3. 补充的令牌不超过桶的容量
+    now += 10 * 1000000;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(bucket.Consume(1, 0, now));
+    }
+    ASSERT_FALSE(bucket.Consume(1, 0, now));
+}
+
+TEST(TokenBucketTest, test_overdraft_and_reserve) {
+    TokenBucket bucket(100, 10);
+    uint64_t now = TimeUtility::GetTimeofDayUs();
+
+    // 1. 大请求可以透支, 透支的部分需要后续的令牌偿还
+    ASSERT_TRUE(bucket.Consume(30, 0, now));
+    ASSERT_FALSE(bucket.Consume(1, 0, now + 100000));
+    ASSERT_TRUE(bucket.Consume(1, 0, now + 210000));
+
+    // 2. 令牌数不超过reserve时不能取
+    now += 10 * 1000000;
+    ASSERT_TRUE(bucket.Consume(5, 5, now));
+    ASSERT_FALSE(bucket.Consume(1, 5, now));
+    ASSERT_TRUE(bucket.Consume(1, 0, now));
+
+    // 3. 调整速率
+    bucket.SetRate(1000, 0);
+    ASSERT_EQ(1000, bucket.GetRate());
+    ASSERT_EQ(1000, bucket.GetBurst());
+}
+
+TEST(TokenBucketTest, test_reserve) {
+    TokenBucket unlimited(0, 0);
+    ASSERT_EQ(0, unlimited.Reserve(100));
+
+    TokenBucket bucket(100, 10);
+    uint64_t now = TimeUtility::GetTimeofDayUs();
+
+    // 1. 桶中令牌足够时不需要等待
+    ASSERT_EQ(0, bucket.Reserve(10, now));
+
+    // 2. 透支的部分需要按速率等待
+    ASSERT_EQ(100000, bucket.Reserve(10, now));
+    ASSERT_EQ(200000, bucket.Reserve(10, now));
+
+    // 3. 等待结束后透支已偿还
+    now += 200000;
+    ASSERT_EQ(10000, bucket.Reserve(1, now));
+}
+
+TEST(TokenBucketTest, test_available) {
+    TokenBucket unlimited(0, 0);
+    ASSERT_TRUE(unlimited.Available(100));
+
+    TokenBucket bucket(100, 10);
+    uint64_t now = TimeUtility::GetTimeofDayUs();
+
+    // 1. 检查令牌不会取出令牌
+    ASSERT_TRUE(bucket.Available(0, now));
+    ASSERT_TRUE(bucket.Available(9, now));
+    ASSERT_FALSE(bucket.Available(10, now));
+    ASSERT_EQ(0, bucket.Reserve(10, now));
+
+    // 2. 令牌取完后没有令牌, 补充以后又有令牌
+    ASSERT_FALSE(bucket.Available(0, now));
+    ASSERT_TRUE(bucket.Available(0, now + 20000));
+}
+
+}  // namespace common
+}  // namespace curve
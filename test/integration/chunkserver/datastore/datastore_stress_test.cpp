@@ -20,6 +20,8 @@
  * Author: yangyaokai
  */
 
+#include <vector>
+
 #include "test/integration/chunkserver/datastore/datastore_integration_base.h"
 
 namespace curve {
@@ -116,5 +118,67 @@ TEST_F(StressTestSuit, StressTest) {
     RunStress(50, 50, 100000);
 }
 
+/**
+ * 多个线程同时读写同一个chunk的不同区域，
+ * 用于衡量chunk内区间锁带来的并发收益
+ */
+TEST_F(StressTestSuit, HotChunkStressTest) {
+    InitChunkPool(10);
+    const ChunkID id = 1;
+    const SequenceNum sn = 1;
+    const uint32_t pageNum = CHUNK_SIZE / PAGE_SIZE;
+    char buf[PAGE_SIZE] = {0};
+    ASSERT_EQ(CSErrorCode::Success,
+              dataStore_->WriteChunk(id, sn, buf, 0, PAGE_SIZE, nullptr));
+
+    auto RunHot = [&](int threadNum, int rwPercent, int ioNum) {
+        uint64_t beginTime = TimeUtility::GetTimeofDayUs();
+        std::vector<Thread> threads;
+        int readThreadNum = threadNum * rwPercent / 100;
+        int ioNumAvg = ioNum / threadNum;
+        for (int i = 0; i < threadNum; ++i) {
+            bool isRead = i < readThreadNum;
+            threads.emplace_back([&, i, isRead]() {
+                char data[PAGE_SIZE] = {0};
+                // 每个线程只访问自己的page，互相之间没有重叠
+                uint32_t pagesPerThread = pageNum / threadNum;
+                for (int j = 0; j < ioNumAvg; ++j) {
+                    uint64_t pageIndex =
+                        i * pagesPerThread + j % pagesPerThread;
+                    off_t offset = pageIndex * PAGE_SIZE;
+                    if (isRead) {
+                        dataStore_->ReadChunk(
+                            id, sn, data, offset, PAGE_SIZE);
+                    } else {
+                        dataStore_->WriteChunk(
+                            id, sn, data, offset, PAGE_SIZE, nullptr);
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        uint64_t endTime = TimeUtility::GetTimeofDayUs();
+        uint64_t iops = ioNum * 1000000L / (endTime - beginTime);
+        printf("Total time used: %llu us\n", endTime - beginTime);
+        printf("Thread number: %d\n", threadNum);
+        printf("read write percent: %d\n", rwPercent);
+        printf("io num: %d\n", ioNum);
+        printf("iops: %llu\n", iops);
+    };
+
+    printf("===============TEST HOT CHUNK WRITE==================\n");
+    RunHot(1, 0, 10000);
+    RunHot(16, 0, 50000);
+    RunHot(64, 0, 100000);
+
+    printf("===============TEST HOT CHUNK READWRITE==================\n");
+    RunHot(1, 50, 10000);
+    RunHot(16, 50, 50000);
+    RunHot(64, 50, 100000);
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -164,6 +164,18 @@ int FakeCurveFsClient::GetChunkInfo(const ChunkIDInfo &cidinfo,
     return LIBCURVE_ERROR::OK;
 }
 
+int FakeCurveFsClient::GetChunksInfo(const std::vector<ChunkIDInfo> &cidinfos,
+                                     std::vector<ChunkInfoDetail> *chunkInfos) {
+    fiu_return_on(
+        "test/integration/snapshotcloneserver/FakeCurveFsClient.GetChunksInfo", -LIBCURVE_ERROR::FAILED);  // NOLINT
+    chunkInfos->clear();
+    chunkInfos->resize(cidinfos.size());
+    for (auto &chunkInfo : *chunkInfos) {
+        chunkInfo.chunkSn.push_back(1);
+    }
+    return LIBCURVE_ERROR::OK;
+}
+
 int FakeCurveFsClient::CreateCloneFile(
     const std::string &source,
     const std::string &filename,
@@ -85,6 +85,9 @@ class FakeCurveFsClient : public CurveFsClient {
     int GetChunkInfo(const ChunkIDInfo &cidinfo,
         ChunkInfoDetail *chunkInfo) override;
 
+    int GetChunksInfo(const std::vector<ChunkIDInfo> &cidinfos,
+        std::vector<ChunkInfoDetail> *chunkInfos) override;
+
     int CreateCloneFile(
         const std::string &source,
         const std::string &filename,
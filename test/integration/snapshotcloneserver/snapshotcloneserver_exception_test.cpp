@@ -365,12 +365,12 @@ TEST_F(SnapshotCloneServerTest, TestCreateSnapshotFailOnReadChunkSnapshot) {
                 user, file, uuid));
 }
 
-TEST_F(SnapshotCloneServerTest, TestCreateSnapshotFailOnGetChunkInfo) {
+TEST_F(SnapshotCloneServerTest, TestCreateSnapshotFailOnGetChunksInfo) {
     std::string uuid;
     std::string user = testUser1;
     std::string file = testFile1;
 
-    fiu_enable("test/integration/snapshotcloneserver/FakeCurveFsClient.GetChunkInfo", // NOLINT
+    fiu_enable("test/integration/snapshotcloneserver/FakeCurveFsClient.GetChunksInfo", // NOLINT
         1, NULL, 0);
 
     int ret = MakeSnapshot(user, file , "snap7", &uuid);
@@ -378,7 +378,7 @@ TEST_F(SnapshotCloneServerTest, TestCreateSnapshotFailOnGetChunkInfo) {
 
     std::this_thread::sleep_for(std::chrono::milliseconds(3000));
 
-    fiu_disable("test/integration/snapshotcloneserver/FakeCurveFsClient.GetChunkInfo");  // NOLINT
+    fiu_disable("test/integration/snapshotcloneserver/FakeCurveFsClient.GetChunksInfo");  // NOLINT
 
     ASSERT_TRUE(JudgeSnapTaskFailCleanEnvAndCheck(
                 user, file, uuid));
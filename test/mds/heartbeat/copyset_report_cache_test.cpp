@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "src/mds/heartbeat/copyset_report_cache.h"
+
+namespace curve {
+namespace mds {
+namespace heartbeat {
+
+namespace {
+void AddCopySet(ChunkServerHeartbeatRequest *request, uint32_t poolId,
+                uint32_t copysetId, uint64_t epoch) {
+    auto info = request->add_copysetinfos();
+    info->set_logicalpoolid(poolId);
+    info->set_copysetid(copysetId);
+    info->set_epoch(epoch);
+}
+}  // namespace
+
+TEST(TestCopysetReportCache, test_full_and_delta_report) {
+    CopysetReportCache cache;
+    ChunkServerHeartbeatRequest merged;
+
+    // 1. 全量心跳直接替换缓存, 不修改merged
+    ChunkServerHeartbeatRequest full;
+    full.set_chunkserverid(1);
+    full.set_sequence(1);
+    AddCopySet(&full, 1, 1, 1);
+    AddCopySet(&full, 1, 2, 1);
+    AddCopySet(&full, 1, 3, 1);
+    ASSERT_TRUE(cache.Merge(full, &merged));
+    ASSERT_EQ(0, merged.copysetinfos_size());
+
+    // 2. 增量心跳: 更新copyset 2, 删除copyset 3, 新增copyset 4
+    ChunkServerHeartbeatRequest delta;
+    delta.set_chunkserverid(1);
+    delta.set_sequence(2);
+    delta.set_basesequence(1);
+    AddCopySet(&delta, 1, 2, 2);
+    AddCopySet(&delta, 1, 4, 1);
+    auto removed = delta.add_removedcopysets();
+    removed->set_logicalpoolid(1);
+    removed->set_copysetid(3);
+    ASSERT_TRUE(cache.Merge(delta, &merged));
+    ASSERT_EQ(1, merged.chunkserverid());
+    ASSERT_FALSE(merged.has_basesequence());
+    ASSERT_EQ(0, merged.removedcopysets_size());
+    ASSERT_EQ(3, merged.copysetinfos_size());
+    ASSERT_EQ(1, merged.copysetinfos(0).copysetid());
+    ASSERT_EQ(1, merged.copysetinfos(0).epoch());
+    ASSERT_EQ(2, merged.copysetinfos(1).copysetid());
+    ASSERT_EQ(2, merged.copysetinfos(1).epoch());
+    ASSERT_EQ(4, merged.copysetinfos(2).copysetid());
+
+    // 3. 没有变化的增量心跳还原出同样的全量信息
+    ChunkServerHeartbeatRequest empty;
+    empty.set_chunkserverid(1);
+    empty.set_sequence(3);
+    empty.set_basesequence(2);
+    merged.Clear();
+    ASSERT_TRUE(cache.Merge(empty, &merged));
+    ASSERT_EQ(3, merged.copysetinfos_size());
+}
+
+TEST(TestCopysetReportCache, test_base_sequence_mismatch) {
+    CopysetReportCache cache;
+    ChunkServerHeartbeatRequest merged;
+
+    // 1. mds没有该chunkserver的记录(例如mds刚切换), 增量心跳无法合并
+    ChunkServerHeartbeatRequest delta;
+    delta.set_chunkserverid(1);
+    delta.set_sequence(5);
+    delta.set_basesequence(4);
+    AddCopySet(&delta, 1, 1, 1);
+    ASSERT_FALSE(cache.Merge(delta, &merged));
+
+    // 2. 全量心跳之后, 基于错误序号的增量心跳无法合并, 且记录被清空
+    ChunkServerHeartbeatRequest full;
+    full.set_chunkserverid(1);
+    full.set_sequence(6);
+    AddCopySet(&full, 1, 1, 1);
+    ASSERT_TRUE(cache.Merge(full, &merged));
+    delta.set_sequence(8);
+    delta.set_basesequence(7);
+    ASSERT_FALSE(cache.Merge(delta, &merged));
+    delta.set_basesequence(6);
+    ASSERT_FALSE(cache.Merge(delta, &merged));
+
+    // 3. 删除记录后需要重新全量上报
+    ASSERT_TRUE(cache.Merge(full, &merged));
+    cache.Remove(1);
+    delta.set_sequence(7);
+    ASSERT_FALSE(cache.Merge(delta, &merged));
+}
+
+TEST(TestCopysetReportCache, test_get_chunkserver_ids) {
+    CopysetReportCache cache;
+    ChunkServerHeartbeatRequest merged;
+    ASSERT_TRUE(cache.GetChunkServerIds().empty());
+
+    for (ChunkServerIdType id = 1; id <= 3; id++) {
+        ChunkServerHeartbeatRequest full;
+        full.set_chunkserverid(id);
+        full.set_sequence(1);
+        AddCopySet(&full, 1, id, 1);
+        ASSERT_TRUE(cache.Merge(full, &merged));
+    }
+    auto ids = cache.GetChunkServerIds();
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(std::vector<ChunkServerIdType>({1, 2, 3}), ids);
+
+    cache.Remove(2);
+    ids = cache.GetChunkServerIds();
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(std::vector<ChunkServerIdType>({1, 3}), ids);
+}
+
+}  // namespace heartbeat
+}  // namespace mds
+}  // namespace curve
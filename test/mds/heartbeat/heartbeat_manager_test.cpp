@@ -915,6 +915,74 @@ TEST_F(TestHeartbeatManager, test_patrol_copySetInfo_return_order) {
     ASSERT_EQ(TRANSFER_LEADER, response.needupdatecopysets(0).type());
     ASSERT_EQ(3, response.needupdatecopysets(0).peers_size());
 }
+
+TEST_F(TestHeartbeatManager, test_delta_heartbeat_only_process_changed) {
+    ::curve::mds::topology::ChunkServer chunkServer1(
+        1, "hello", "", 1, "192.168.10.1", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+    ::curve::mds::topology::ChunkServer chunkServer2(
+        2, "hello", "", 1, "192.168.10.2", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+    ::curve::mds::topology::ChunkServer chunkServer3(
+        3, "hello", "", 1, "192.168.10.3", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+    ON_CALL(*topology_, GetChunkServer(1, _))
+        .WillByDefault(DoAll(SetArgPointee<1>(chunkServer1), Return(true)));
+    ON_CALL(*topology_, GetChunkServerNotRetired("192.168.10.1", _, _))
+        .WillByDefault(DoAll(SetArgPointee<2>(chunkServer1), Return(true)));
+    ON_CALL(*topology_, GetChunkServerNotRetired("192.168.10.2", _, _))
+        .WillByDefault(DoAll(SetArgPointee<2>(chunkServer2), Return(true)));
+    ON_CALL(*topology_, GetChunkServerNotRetired("192.168.10.3", _, _))
+        .WillByDefault(DoAll(SetArgPointee<2>(chunkServer3), Return(true)));
+    ::curve::mds::topology::CopySetInfo recordCopySetInfo(1, 1);
+    recordCopySetInfo.SetEpoch(10);
+    recordCopySetInfo.SetLeader(1);
+    ON_CALL(*topology_, GetCopySet(_, _))
+        .WillByDefault(
+            DoAll(SetArgPointee<1>(recordCopySetInfo), Return(true)));
+
+    // 1. 全量心跳, 两个copyset都需要处理
+    auto full = GetChunkServerHeartbeatRequestForTest();
+    full.set_sequence(1);
+    auto info = full.add_copysetinfos();
+    *info = full.copysetinfos(0);
+    info->set_copysetid(2);
+    ChunkServerHeartbeatResponse response;
+    EXPECT_CALL(*coordinator_, CopySetHeartbeat(_, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(false));
+    heartbeatManager_->ChunkServerHeartbeat(full, &response);
+    ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+    ASSERT_FALSE(response.needfullreport());
+
+    // 2. 增量心跳只上报了copyset(1,2),
+    //    copyset(1,1)没有变化并且leader上没有operator, 不需要处理
+    auto delta = GetChunkServerHeartbeatRequestForTest();
+    delta.set_sequence(2);
+    delta.set_basesequence(1);
+    delta.mutable_copysetinfos(0)->set_copysetid(2);
+    delta.mutable_copysetinfos(0)->set_epoch(11);
+    EXPECT_CALL(*coordinator_, HasOperator(_))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*coordinator_, CopySetHeartbeat(_, _, _))
+        .WillOnce(Return(false));
+    response.Clear();
+    heartbeatManager_->ChunkServerHeartbeat(delta, &response);
+    ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+    ASSERT_FALSE(response.needfullreport());
+
+    // 3. copyset(1,1)的leader上有operator时需要处理
+    delta.set_sequence(3);
+    delta.set_basesequence(2);
+    EXPECT_CALL(*coordinator_, HasOperator(_))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*coordinator_, CopySetHeartbeat(_, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(false));
+    response.Clear();
+    heartbeatManager_->ChunkServerHeartbeat(delta, &response);
+    ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+}
 }  // namespace heartbeat
 }  // namespace mds
 }  // namespace curve
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <unistd.h>
+
+#include "src/mds/heartbeat/topo_update_dispatcher.h"
+#include "test/mds/mock/mock_topology.h"
+
+using ::testing::Return;
+using ::testing::SetArgPointee;
+using ::testing::DoAll;
+using ::testing::_;
+using ::curve::mds::topology::MockTopology;
+
+namespace curve {
+namespace mds {
+namespace heartbeat {
+
+TEST(TestTopoUpdateDispatcher, test_submit_and_update) {
+    auto topology = std::make_shared<MockTopology>();
+    auto topoUpdater = std::make_shared<TopoUpdater>(topology);
+    TopoUpdateDispatcher dispatcher(topoUpdater, 4);
+
+    ::curve::mds::topology::CopySetInfo recordInfo(1, 1);
+    recordInfo.SetEpoch(1);
+    ::curve::mds::topology::CopySetInfo reportInfo(1, 1);
+    reportInfo.SetEpoch(2);
+
+    // 未启动时提交的上报排队等待
+    dispatcher.Submit(reportInfo);
+    // 同一copyset的重复上报合并为一份
+    dispatcher.Submit(reportInfo);
+    ASSERT_EQ(1, dispatcher.QueueDepth());
+
+    EXPECT_CALL(*topology, GetCopySet(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(recordInfo), Return(true)));
+    EXPECT_CALL(*topology, UpdateCopySetTopo(_))
+        .WillOnce(Return(::curve::mds::topology::kTopoErrCodeSuccess));
+    dispatcher.Start();
+    for (int i = 0; i < 100 && dispatcher.QueueDepth() != 0; i++) {
+        usleep(10 * 1000);
+    }
+    ASSERT_EQ(0, dispatcher.QueueDepth());
+    dispatcher.Stop();
+}
+
+TEST(TestTopoUpdateDispatcher, test_stop_flush_pending) {
+    auto topology = std::make_shared<MockTopology>();
+    auto topoUpdater = std::make_shared<TopoUpdater>(topology);
+    TopoUpdateDispatcher dispatcher(topoUpdater, 2);
+
+    for (int i = 1; i <= 10; i++) {
+        ASSERT_TRUE(dispatcher.Submit(
+            ::curve::mds::topology::CopySetInfo(1, i)));
+    }
+    ASSERT_EQ(10, dispatcher.QueueDepth());
+
+    // 停止时未处理的上报全部更新到topology
+    EXPECT_CALL(*topology, GetCopySet(_, _))
+        .Times(10)
+        .WillRepeatedly(Return(false));
+    dispatcher.Start();
+    dispatcher.Stop();
+    ASSERT_EQ(0, dispatcher.QueueDepth());
+
+    // 停止后拒绝新的上报
+    ASSERT_FALSE(dispatcher.Submit(
+        ::curve::mds::topology::CopySetInfo(1, 1)));
+    ASSERT_EQ(0, dispatcher.QueueDepth());
+}
+
+TEST(TestTopoUpdateDispatcher, test_flush) {
+    auto topology = std::make_shared<MockTopology>();
+    auto topoUpdater = std::make_shared<TopoUpdater>(topology);
+    TopoUpdateDispatcher dispatcher(topoUpdater, 2);
+
+    ASSERT_TRUE(dispatcher.Submit(::curve::mds::topology::CopySetInfo(1, 1)));
+    ASSERT_TRUE(dispatcher.Submit(::curve::mds::topology::CopySetInfo(1, 2)));
+
+    // 只同步更新指定copyset的上报
+    EXPECT_CALL(*topology, GetCopySet(
+            ::curve::mds::topology::CopySetKey(1, 1), _))
+        .WillOnce(Return(false));
+    dispatcher.Flush(::curve::mds::topology::CopySetKey(1, 1));
+    ASSERT_EQ(1, dispatcher.QueueDepth());
+
+    // 没有该copyset的上报时不更新
+    dispatcher.Flush(::curve::mds::topology::CopySetKey(1, 1));
+    ASSERT_EQ(1, dispatcher.QueueDepth());
+
+    EXPECT_CALL(*topology, GetCopySet(
+            ::curve::mds::topology::CopySetKey(1, 2), _))
+        .WillOnce(Return(false));
+    dispatcher.Stop();
+    ASSERT_EQ(0, dispatcher.QueueDepth());
+}
+
+}  // namespace heartbeat
+}  // namespace mds
+}  // namespace curve
@@ -43,6 +43,7 @@ using ::testing::Return;
 using ::testing::ReturnArg;
 using ::testing::DoAll;
 using ::testing::SetArgPointee;
+using ::testing::SaveArg;
 using curve::common::Authenticator;
 
 using curve::common::TimeUtility;
@@ -1464,6 +1465,69 @@ TEST_F(CurveFSTest, testChangeOwner) {
     }
 }
 
+TEST_F(CurveFSTest, testUpdateFileThrottleParams) {
+    // update ok
+    {
+        FileInfo fileInfo1;
+        fileInfo1.set_filetype(FileType::INODE_PAGEFILE);
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)));
+
+        FileInfo putInfo;
+        EXPECT_CALL(*storage_, PutFile(_))
+        .Times(1)
+        .WillOnce(DoAll(SaveArg<0>(&putInfo),
+                        Return(StoreStatus::OK)));
+
+        ASSERT_EQ(curvefs_->UpdateFileThrottleParams("/file1", 1000, 4096),
+                  StatusCode::kOK);
+        ASSERT_EQ(1000, putInfo.iopslimit());
+        ASSERT_EQ(4096, putInfo.bpslimit());
+    }
+
+    // params not changed, do not put file
+    {
+        FileInfo fileInfo1;
+        fileInfo1.set_filetype(FileType::INODE_PAGEFILE);
+        fileInfo1.set_iopslimit(1000);
+        fileInfo1.set_bpslimit(4096);
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, PutFile(_))
+        .Times(0);
+
+        ASSERT_EQ(curvefs_->UpdateFileThrottleParams("/file1", 1000, 4096),
+                  StatusCode::kOK);
+    }
+
+    // file not exist
+    {
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(1)
+        .WillOnce(Return(StoreStatus::KeyNotExist));
+
+        ASSERT_EQ(curvefs_->UpdateFileThrottleParams("/file1", 1000, 4096),
+                  StatusCode::kFileNotExists);
+    }
+
+    // directory not support
+    {
+        FileInfo fileInfo1;
+        fileInfo1.set_filetype(FileType::INODE_DIRECTORY);
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)));
+
+        ASSERT_EQ(curvefs_->UpdateFileThrottleParams("/file1", 1000, 4096),
+                  StatusCode::kNotSupported);
+    }
+}
+
 TEST_F(CurveFSTest, testGetOrAllocateSegment) {
     // test normal get exist segment
     {
@@ -1666,6 +1730,132 @@ TEST_F(CurveFSTest, testGetOrAllocateSegment) {
     }
 }
 
+TEST_F(CurveFSTest, testListSegments) {
+    FileInfo fileInfo1;
+    fileInfo1.set_filetype(FileType::INODE_DIRECTORY);
+
+    FileInfo fileInfo2;
+    fileInfo2.set_filetype(FileType::INODE_PAGEFILE);
+    fileInfo2.set_length(4 * DefaultSegmentSize);
+    fileInfo2.set_segmentsize(DefaultSegmentSize);
+
+    // 第1个segment未分配
+    std::vector<PageFileSegment> firstPage;
+    std::vector<PageFileSegment> lastPage;
+    for (uint64_t i : {0, 2, 3}) {
+        PageFileSegment segment;
+        segment.set_logicalpoolid(1);
+        segment.set_segmentsize(DefaultSegmentSize);
+        segment.set_chunksize(curvefs_->GetDefaultChunkSize());
+        segment.set_startoffset(i * DefaultSegmentSize);
+        if (i < 2) {
+            firstPage.emplace_back(segment);
+        } else {
+            lastPage.emplace_back(segment);
+        }
+    }
+
+    // list first page
+    {
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                        Return(StoreStatus::OK)));
+        // 只扫描本页范围内的segment
+        EXPECT_CALL(*storage_, ListSegment(_, 0, 2 * DefaultSegmentSize, _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<3>(firstPage),
+                        Return(StoreStatus::OK)));
+
+        std::vector<PageFileSegment> segments;
+        offset_t nextOffset = 0;
+        ASSERT_EQ(StatusCode::kOK, curvefs_->ListSegments("/user1/file2",
+                  0, 2, &segments, &nextOffset));
+        ASSERT_EQ(1, segments.size());
+        ASSERT_EQ(0, segments[0].startoffset());
+        ASSERT_EQ(2 * DefaultSegmentSize, nextOffset);
+    }
+
+    // list last page
+    {
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                        Return(StoreStatus::OK)));
+        // 最后一页不超过文件长度
+        EXPECT_CALL(*storage_, ListSegment(_, 2 * DefaultSegmentSize,
+                                           fileInfo2.length(), _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<3>(lastPage),
+                        Return(StoreStatus::OK)));
+
+        std::vector<PageFileSegment> segments;
+        offset_t nextOffset = 0;
+        ASSERT_EQ(StatusCode::kOK, curvefs_->ListSegments("/user1/file2",
+                  2 * DefaultSegmentSize, 3, &segments, &nextOffset));
+        ASSERT_EQ(2, segments.size());
+        ASSERT_EQ(2 * DefaultSegmentSize, segments[0].startoffset());
+        ASSERT_EQ(3 * DefaultSegmentSize, segments[1].startoffset());
+        ASSERT_EQ(fileInfo2.length(), nextOffset);
+    }
+
+    // startOffset超过文件长度，不访问存储
+    {
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                        Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSegment(_, _, _, _))
+        .Times(0);
+
+        std::vector<PageFileSegment> segments;
+        offset_t nextOffset = 0;
+        ASSERT_EQ(StatusCode::kOK, curvefs_->ListSegments("/user1/file2",
+                  fileInfo2.length(), 2, &segments, &nextOffset));
+        ASSERT_TRUE(segments.empty());
+        ASSERT_EQ(fileInfo2.length(), nextOffset);
+    }
+
+    // offset not aligned
+    {
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                        Return(StoreStatus::OK)));
+
+        std::vector<PageFileSegment> segments;
+        offset_t nextOffset = 0;
+        ASSERT_EQ(StatusCode::kParaError, curvefs_->ListSegments(
+                  "/user1/file2", 1, 2, &segments, &nextOffset));
+    }
+
+    // list segment fail
+    {
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                        Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSegment(_, _, _, _))
+        .Times(1)
+        .WillOnce(Return(StoreStatus::InternalError));
+
+        std::vector<PageFileSegment> segments;
+        offset_t nextOffset = 0;
+        ASSERT_EQ(StatusCode::kStorageError, curvefs_->ListSegments(
+                  "/user1/file2", 0, 2, &segments, &nextOffset));
+    }
+}
+
 TEST_F(CurveFSTest, testCreateSnapshotFile) {
     {
         // test client time not expired
@@ -289,12 +289,26 @@ class FakeNameServerStorage : public NameServerStorage {
 
     StoreStatus ListSegment(InodeID id,
                             std::vector<PageFileSegment> *segments) {
-        std::lock_guard<std::mutex> guard(lock_);
-        std::string startStoreKey =
-                NameSpaceStorageCodec::EncodeSegmentStoreKey(id, 0);
-        std::string endStoreKey =
-                NameSpaceStorageCodec::EncodeSegmentStoreKey(id + 1, 0);
+        return ListSegmentInternal(
+            NameSpaceStorageCodec::EncodeSegmentStoreKey(id, 0),
+            NameSpaceStorageCodec::EncodeSegmentStoreKey(id + 1, 0),
+            segments);
+    }
 
+    StoreStatus ListSegment(InodeID id,
+                            offset_t startOffset,
+                            offset_t endOffset,
+                            std::vector<PageFileSegment> *segments) override {
+        return ListSegmentInternal(
+            NameSpaceStorageCodec::EncodeSegmentStoreKey(id, startOffset),
+            NameSpaceStorageCodec::EncodeSegmentStoreKey(id, endOffset),
+            segments);
+    }
+
+    StoreStatus ListSegmentInternal(const std::string& startStoreKey,
+                                    const std::string& endStoreKey,
+                                    std::vector<PageFileSegment> *segments) {
+        std::lock_guard<std::mutex> guard(lock_);
         for (auto iter = memKvMap_.begin(); iter != memKvMap_.end(); iter++) {
             if (iter->first.compare(startStoreKey) >= 0) {
                 if (iter->first.compare(endStoreKey) < 0) {
@@ -84,6 +84,9 @@ class MockNameServerStorage : public NameServerStorage {
         StoreStatus(std::vector<FileInfo> *snapShotFiles));
     MOCK_METHOD2(ListSegment,
         StoreStatus(InodeID, std::vector<PageFileSegment>*));
+    MOCK_METHOD4(ListSegment,
+        StoreStatus(InodeID, offset_t, offset_t,
+                    std::vector<PageFileSegment>*));
 };
 
 }  // namespace mds
@@ -437,6 +437,21 @@ TEST_F(TestNameServerStorageImp, test_ListSegment) {
     ASSERT_EQ(StoreStatus::OK, storage_->ListSegment(0, &segments));
     ASSERT_EQ(1, segments.size());
     ASSERT_EQ(segment.DebugString(), segments[0].DebugString());
+
+    // 3. list by offset range
+    segments.clear();
+    uint64_t segmentSize = segment.segmentsize();
+    EXPECT_CALL(*client_, List(
+            NameSpaceStorageCodec::EncodeSegmentStoreKey(1, segmentSize),
+            NameSpaceStorageCodec::EncodeSegmentStoreKey(1, 3 * segmentSize),
+            _))
+        .WillOnce(DoAll(
+            SetArgPointee<2>(std::vector<std::string>{encodeSegment}),
+            Return(EtcdErrCode::EtcdOK)));
+    ASSERT_EQ(StoreStatus::OK, storage_->ListSegment(
+        1, segmentSize, 3 * segmentSize, &segments));
+    ASSERT_EQ(1, segments.size());
+    ASSERT_EQ(segment.DebugString(), segments[0].DebugString());
 }
 
 }  // namespace mds
@@ -2655,6 +2655,114 @@ TEST_F(TestTopology, GetCopySetsInChunkServer_success) {
     ASSERT_EQ(1, csList.size());
 }
 
+TEST_F(TestTopology, GetCopySetSnapshot_RefreshAfterUpdate) {
+    PoolIdType logicalPoolId = 0x01;
+    PoolIdType physicalPoolId = 0x11;
+    CopySetIdType copysetId = 0x51;
+
+    PrepareAddPhysicalPool(physicalPoolId);
+    PrepareAddZone(0x21, "zone1", physicalPoolId);
+    PrepareAddZone(0x22, "zone2", physicalPoolId);
+    PrepareAddZone(0x23, "zone3", physicalPoolId);
+    PrepareAddServer(
+        0x31, "server1", "127.0.0.1" , 0, "127.0.0.1" , 0, 0x21, 0x11);
+    PrepareAddServer(
+        0x32, "server2", "127.0.0.1" , 0, "127.0.0.1" , 0, 0x22, 0x11);
+    PrepareAddServer(
+        0x33, "server3", "127.0.0.1" , 0, "127.0.0.1" , 0, 0x23, 0x11);
+    PrepareAddChunkServer(0x41, "token1", "nvme", 0x31, "127.0.0.1", 8200);
+    PrepareAddChunkServer(0x42, "token2", "nvme", 0x32, "127.0.0.1", 8200);
+    PrepareAddChunkServer(0x43, "token3", "nvme", 0x33, "127.0.0.1", 8200);
+    PrepareAddChunkServer(0x44, "token4", "nvme", 0x33, "127.0.0.1", 8200);
+    PrepareAddLogicalPool(logicalPoolId, "logicalPool1", physicalPoolId);
+    std::set<ChunkServerIdType> replicas;
+    replicas.insert(0x41);
+    replicas.insert(0x42);
+    replicas.insert(0x43);
+    PrepareAddCopySet(copysetId, logicalPoolId, replicas);
+
+    // 无变更时重复获取同一份快照
+    auto snapshot1 = topology_->GetCopySetSnapshot();
+    auto snapshot2 = topology_->GetCopySetSnapshot();
+    ASSERT_EQ(snapshot1.get(), snapshot2.get());
+    ASSERT_EQ(1, snapshot1->items.size());
+    ASSERT_EQ(0, topology_->GetCopySetsInChunkServer(0x44).size());
+
+    // 变更后生成新快照，旧快照内容不变
+    std::set<ChunkServerIdType> replicas2;
+    replicas2.insert(0x41);
+    replicas2.insert(0x42);
+    replicas2.insert(0x44);
+    CopySetInfo csInfo(logicalPoolId, copysetId);
+    csInfo.SetEpoch(1);
+    csInfo.SetCopySetMembers(replicas2);
+    ASSERT_EQ(kTopoErrCodeSuccess, topology_->UpdateCopySetTopo(csInfo));
+
+    auto snapshot3 = topology_->GetCopySetSnapshot();
+    ASSERT_NE(snapshot1.get(), snapshot3.get());
+    ASSERT_EQ(0, snapshot1->items.begin()->second.GetEpoch());
+    ASSERT_EQ(1, snapshot3->items.begin()->second.GetEpoch());
+    ASSERT_EQ(1, topology_->GetCopySetsInChunkServer(0x44).size());
+    ASSERT_EQ(0, topology_->GetCopySetsInChunkServer(0x43).size());
+
+    // chunkserver快照同理
+    auto csSnapshot1 = topology_->GetChunkServerSnapshot();
+    ASSERT_EQ(4, csSnapshot1->items.size());
+    ASSERT_EQ(kTopoErrCodeSuccess,
+        topology_->UpdateChunkServerStartUpTime(1000, 0x41));
+    auto csSnapshot2 = topology_->GetChunkServerSnapshot();
+    ASSERT_NE(csSnapshot1.get(), csSnapshot2.get());
+    ASSERT_EQ(1000, csSnapshot2->items.at(0x41).GetStartUpTime());
+
+    // 心跳磁盘状态每次都合入快照，快照中的使用量与内存一致
+    uint64_t oldUsed = csSnapshot2->items.at(0x41).GetChunkServerState()
+                                                  .GetDiskUsed();
+    ChunkServerState csState;
+    csState.SetDiskCapacity(1000);
+    csState.SetDiskUsed(oldUsed + 100);
+    ASSERT_EQ(kTopoErrCodeSuccess,
+        topology_->UpdateChunkServerDiskStatus(csState, 0x41));
+    auto csSnapshot3 = topology_->GetChunkServerSnapshot();
+    ASSERT_NE(csSnapshot2.get(), csSnapshot3.get());
+    ASSERT_EQ(csSnapshot2->version, csSnapshot3->version);
+    ASSERT_EQ(oldUsed + 100, csSnapshot3->items.at(0x41)
+                                 .GetChunkServerState().GetDiskUsed());
+    // 之前取得的快照不变
+    ASSERT_EQ(oldUsed, csSnapshot2->items.at(0x41).GetChunkServerState()
+                                                     .GetDiskUsed());
+
+    // 状态未变化时不生成新快照
+    ASSERT_EQ(kTopoErrCodeSuccess,
+        topology_->UpdateChunkServerDiskStatus(csState, 0x41));
+    ASSERT_EQ(csSnapshot3.get(), topology_->GetChunkServerSnapshot().get());
+
+    // 两次读取之间的多次心跳一次合入
+    csState.SetDiskUsed(101);
+    ASSERT_EQ(kTopoErrCodeSuccess,
+        topology_->UpdateChunkServerDiskStatus(csState, 0x41));
+    csState.SetDiskUsed(102);
+    ASSERT_EQ(kTopoErrCodeSuccess,
+        topology_->UpdateChunkServerDiskStatus(csState, 0x41));
+    auto csSnapshot4 = topology_->GetChunkServerSnapshot();
+    ASSERT_EQ(102, csSnapshot4->items.at(0x41).GetChunkServerState()
+                                               .GetDiskUsed());
+    ASSERT_EQ(csSnapshot4.get(), topology_->GetChunkServerSnapshot().get());
+
+    // 重建快照后仍然保持最新的磁盘状态
+    ASSERT_EQ(kTopoErrCodeSuccess,
+        topology_->UpdateChunkServerStartUpTime(2000, 0x41));
+    csState.SetDiskState(DISKERROR);
+    ASSERT_EQ(kTopoErrCodeSuccess,
+        topology_->UpdateChunkServerDiskStatus(csState, 0x41));
+    auto csSnapshot5 = topology_->GetChunkServerSnapshot();
+    ASSERT_NE(csSnapshot4->version, csSnapshot5->version);
+    ASSERT_EQ(2000, csSnapshot5->items.at(0x41).GetStartUpTime());
+    ASSERT_EQ(DISKERROR, csSnapshot5->items.at(0x41).GetChunkServerState()
+                                                    .GetDiskState());
+    ASSERT_EQ(102, csSnapshot5->items.at(0x41).GetChunkServerState()
+                                               .GetDiskUsed());
+}
+
 
 
 
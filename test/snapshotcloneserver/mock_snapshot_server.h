@@ -189,6 +189,10 @@ class MockCurveFsClient : public CurveFsClient {
         int(const ChunkIDInfo &cidinfo,
         ChunkInfoDetail *chunkInfo));
 
+    MOCK_METHOD2(GetChunksInfo,
+        int(const std::vector<ChunkIDInfo> &cidinfos,
+        std::vector<ChunkInfoDetail> *chunkInfos));
+
     MOCK_METHOD7(CreateCloneFile,
         int(const std::string &source,
         const std::string &filename,
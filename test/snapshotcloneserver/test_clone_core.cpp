@@ -61,6 +61,10 @@ class TestCloneCoreImpl : public ::testing::Test {
         option.mdsRootUser = "root";
         option.createCloneChunkConcurrency = 2;
         option.recoverChunkConcurrency = 2;
+        option.recoverChunkMaxConcurrency = 2;
+        option.recoverChunkConcurrencyPerCopyset = 0;
+        option.recoverChunkLatencyTargetMs = 0;
+        option.recoverSkipWrittenChunk = false;
         option.clientAsyncMethodRetryTimeSec = 1;
         option.clientAsyncMethodRetryIntervalMs = 500;
         core_ = std::make_shared<CloneCoreImpl>(client_,
@@ -609,6 +613,69 @@ TEST_F(TestCloneCoreImpl,
     core_->HandleCloneOrRecoverTask(task);
 }
 
+TEST_F(TestCloneCoreImpl,
+    HandleCloneOrRecoverTaskStage2SkipWrittenChunk) {
+    option.recoverSkipWrittenChunk = true;
+    option.recoverChunkConcurrencyPerCopyset = 1;
+    core_ = std::make_shared<CloneCoreImpl>(client_,
+        metaStore_,
+        dataStore_,
+        snapshotRef_,
+        cloneRef_,
+        option);
+
+    CloneInfo info("id1", "user1", CloneTaskType::kClone,
+    "snapid1", "file1", 1, 2, 100, CloneFileType::kSnapshot, true,
+    CloneStep::kRecoverChunk, CloneStatus::cloning);
+    info.SetStatus(CloneStatus::cloning);
+    auto cloneMetric = std::make_shared<CloneInfoMetric>("id1");
+    auto cloneClosure = std::make_shared<CloneClosure>();
+    std::shared_ptr<CloneTaskInfo> task =
+        std::make_shared<CloneTaskInfo>(info, cloneMetric, cloneClosure);
+
+    EXPECT_CALL(*metaStore_, UpdateCloneInfo(_))
+        .WillRepeatedly(Return(kErrCodeSuccess));
+
+    MockBuildFileInfoFromSnapshotSuccess(task);
+    MockCloneMetaSuccess(task);
+
+    // chunk 1已全部写入，跳过；chunk 2仍是clone chunk，需要恢复
+    ChunkInfoDetail written;
+    written.chunkSn.push_back(1);
+    written.isClone = false;
+    ChunkInfoDetail notWritten;
+    notWritten.chunkSn.push_back(1);
+    notWritten.isClone = true;
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
+        .WillRepeatedly(Invoke([&](const std::vector<ChunkIDInfo> &cidinfos,
+                                   std::vector<ChunkInfoDetail> *chunkInfos) {
+            chunkInfos->clear();
+            for (auto &cidinfo : cidinfos) {
+                chunkInfos->push_back(
+                    (cidinfo.cid_ == 1) ? written : notWritten);
+            }
+            return LIBCURVE_ERROR::OK;
+        }));
+    EXPECT_CALL(*client_, RecoverChunk(_, _, _, _))
+        .WillRepeatedly(DoAll(
+                    Invoke([](const ChunkIDInfo &chunkidinfo,
+                              uint64_t offset,
+                              uint64_t len,
+                              SnapCloneClosure* scc){
+                        ASSERT_EQ(2, chunkidinfo.cid_);
+                        scc->SetRetCode(LIBCURVE_ERROR::OK),
+                        scc->Run();
+                        }),
+                    Return(LIBCURVE_ERROR::OK)));
+    MockCompleteCloneFileSuccess(task);
+    core_->HandleCloneOrRecoverTask(task);
+
+    RecoverChunkStat stat = task->GetRecoverStat();
+    ASSERT_EQ(2, stat.totalChunkNum);
+    ASSERT_EQ(1, stat.recoveredChunkNum);
+    ASSERT_EQ(1, stat.skippedChunkNum);
+}
+
 TEST_F(TestCloneCoreImpl,
     HandleCloneOrRecoverTaskSuccessForCloneBySnapshotNotLazy) {
     CloneInfo info("id1", "user1", CloneTaskType::kClone,
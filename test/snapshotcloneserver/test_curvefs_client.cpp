@@ -127,6 +127,10 @@ TEST_F(TestCurveFsClientImpl, TestClientInterfaceFail) {
     ret = client_->GetChunkInfo(cidinfo, &chunkInfo);
     ASSERT_LT(ret, 0);
 
+    std::vector<ChunkInfoDetail> chunkInfos;
+    ret = client_->GetChunksInfo({cidinfo}, &chunkInfos);
+    ASSERT_LT(ret, 0);
+
     ret = client_->CreateCloneFile(
         "source1", "file1", "user1", 1024, 1, 1024, &fInfo);
     ASSERT_LT(ret, 0);
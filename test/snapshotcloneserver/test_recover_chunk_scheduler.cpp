@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "src/snapshotcloneserver/clone/recover_chunk_scheduler.h"
+
+namespace curve {
+namespace snapshotcloneserver {
+
+static ChunkIDInfo MakeChunk(uint64_t cid, uint32_t lpid, uint32_t cpid) {
+    return ChunkIDInfo(cid, lpid, cpid);
+}
+
+TEST(RecoverChunkSchedulerTest, RoundRobinAcrossCopysets) {
+    RecoverChunkSchedulerOption option;
+    option.initConcurrency = 4;
+    option.maxConcurrency = 4;
+    option.concurrencyPerCopyset = 0;
+    option.latencyTargetMs = 0;
+    RecoverChunkScheduler scheduler(option);
+
+    // copyset 1上有3个chunk，copyset 2上有1个chunk
+    scheduler.AddChunk(MakeChunk(1, 1, 1));
+    scheduler.AddChunk(MakeChunk(2, 1, 1));
+    scheduler.AddChunk(MakeChunk(3, 1, 1));
+    scheduler.AddChunk(MakeChunk(4, 1, 2));
+    ASSERT_EQ(4, scheduler.GetPendingNum());
+
+    ChunkIDInfo cidInfo;
+    ASSERT_TRUE(scheduler.PopChunk(&cidInfo));
+    ASSERT_EQ(1, cidInfo.cid_);
+    ASSERT_TRUE(scheduler.PopChunk(&cidInfo));
+    ASSERT_EQ(4, cidInfo.cid_);
+    ASSERT_TRUE(scheduler.PopChunk(&cidInfo));
+    ASSERT_EQ(2, cidInfo.cid_);
+    ASSERT_TRUE(scheduler.PopChunk(&cidInfo));
+    ASSERT_EQ(3, cidInfo.cid_);
+    ASSERT_FALSE(scheduler.PopChunk(&cidInfo));
+    ASSERT_EQ(0, scheduler.GetPendingNum());
+    ASSERT_EQ(4, scheduler.GetWorkingNum());
+}
+
+TEST(RecoverChunkSchedulerTest, ConcurrencyLimit) {
+    RecoverChunkSchedulerOption option;
+    option.initConcurrency = 2;
+    option.maxConcurrency = 2;
+    option.concurrencyPerCopyset = 1;
+    option.latencyTargetMs = 0;
+    RecoverChunkScheduler scheduler(option);
+
+    scheduler.AddChunk(MakeChunk(1, 1, 1));
+    scheduler.AddChunk(MakeChunk(2, 1, 1));
+    scheduler.AddChunk(MakeChunk(3, 1, 2));
+    scheduler.AddChunk(MakeChunk(4, 1, 3));
+
+    // 总并发为2
+    ChunkIDInfo c1, c2, c3;
+    ASSERT_TRUE(scheduler.PopChunk(&c1));
+    ASSERT_TRUE(scheduler.PopChunk(&c2));
+    ASSERT_FALSE(scheduler.PopChunk(&c3));
+    ASSERT_EQ(1, c1.cid_);
+    ASSERT_EQ(3, c2.cid_);
+
+    // copyset 1上已有一个chunk在恢复，只能取copyset 3上的
+    scheduler.OnChunkDone(c2);
+    ASSERT_TRUE(scheduler.PopChunk(&c3));
+    ASSERT_EQ(4, c3.cid_);
+    ASSERT_FALSE(scheduler.PopChunk(&c3));
+
+    // copyset 1上的chunk结束后才能继续取copyset 1上的chunk
+    scheduler.OnChunkDone(c1);
+    ASSERT_TRUE(scheduler.PopChunk(&c3));
+    ASSERT_EQ(2, c3.cid_);
+    ASSERT_EQ(0, scheduler.GetPendingNum());
+}
+
+TEST(RecoverChunkSchedulerTest, AdaptiveConcurrency) {
+    RecoverChunkSchedulerOption option;
+    option.initConcurrency = 4;
+    option.maxConcurrency = 6;
+    option.concurrencyPerCopyset = 0;
+    option.latencyTargetMs = 10;
+    RecoverChunkScheduler scheduler(option);
+    ASSERT_EQ(4, scheduler.GetConcurrency());
+
+    // 延迟低于目标，每轮加1，直到上限
+    for (int i = 0; i < 4; i++) {
+        scheduler.OnPartDone(1000, true);
+    }
+    ASSERT_EQ(5, scheduler.GetConcurrency());
+    for (int i = 0; i < 5; i++) {
+        scheduler.OnPartDone(1000, true);
+    }
+    ASSERT_EQ(6, scheduler.GetConcurrency());
+    for (int i = 0; i < 6; i++) {
+        scheduler.OnPartDone(1000, true);
+    }
+    ASSERT_EQ(6, scheduler.GetConcurrency());
+
+    // 延迟高于目标，降低并发
+    for (int i = 0; i < 6; i++) {
+        scheduler.OnPartDone(20000, true);
+    }
+    ASSERT_EQ(4, scheduler.GetConcurrency());
+
+    // 有失败，降低并发
+    for (int i = 0; i < 3; i++) {
+        scheduler.OnPartDone(1000, true);
+    }
+    scheduler.OnPartDone(1000, false);
+    ASSERT_EQ(3, scheduler.GetConcurrency());
+
+    // 最低为1
+    for (int i = 0; i < 10; i++) {
+        scheduler.OnPartDone(20000, true);
+    }
+    ASSERT_EQ(1, scheduler.GetConcurrency());
+}
+
+TEST(RecoverChunkSchedulerTest, FixedConcurrencyWithoutLatencyTarget) {
+    RecoverChunkSchedulerOption option;
+    option.initConcurrency = 2;
+    option.maxConcurrency = 8;
+    option.concurrencyPerCopyset = 0;
+    option.latencyTargetMs = 0;
+    RecoverChunkScheduler scheduler(option);
+
+    for (int i = 0; i < 10; i++) {
+        scheduler.OnPartDone(1000, true);
+    }
+    ASSERT_EQ(2, scheduler.GetConcurrency());
+}
+
+}  // namespace snapshotcloneserver
+}  // namespace curve
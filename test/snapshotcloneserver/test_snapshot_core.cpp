@@ -438,9 +438,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -719,7 +720,7 @@ TEST_F(TestSnapshotCoreImpl,
 }
 
 TEST_F(TestSnapshotCoreImpl,
-    TestHandleCreateSnapshotTask_GetChunkInfoFail) {
+    TestHandleCreateSnapshotTask_GetChunksInfoFail) {
     UUID uuid = "uuid1";
     std::string user = "user1";
     std::string fileName = "file1";
@@ -791,8 +792,9 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
-        .WillOnce(DoAll(SetArgPointee<1>(chunkInfo),
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(-LIBCURVE_ERROR::FAILED)));
 
     core_->HandleCreateSnapshotTask(task);
@@ -878,9 +880,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -968,9 +971,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -1084,9 +1088,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -1215,9 +1220,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -1353,9 +1359,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -1496,9 +1503,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -1641,9 +1649,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -1789,9 +1798,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -2503,9 +2513,10 @@ TEST_F(TestSnapshotCoreImpl, TestHandleCreateSnapshotTaskCancelSuccess) {
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -2729,9 +2740,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     // 此处捕获task，设置cancel
@@ -2837,9 +2849,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -2996,9 +3009,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -3160,9 +3174,10 @@ TEST_F(TestSnapshotCoreImpl,
     uint64_t chunkSn = 100;
     ChunkInfoDetail chunkInfo;
     chunkInfo.chunkSn.push_back(chunkSn);
-    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+    EXPECT_CALL(*client_, GetChunksInfo(_, _))
         .Times(4)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+        .WillRepeatedly(DoAll(SetArgPointee<1>(
+                        std::vector<ChunkInfoDetail>{chunkInfo}),
                     Return(LIBCURVE_ERROR::OK)));
 
     EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
@@ -27,6 +27,15 @@
 #include "src/snapshotcloneserver/snapshot/snapshot_data_store.h"
 #include "test/snapshotcloneserver/mock_s3_adapter.h"
 using ::testing::_;
+using ::testing::DoAll;
+using ::testing::SetArgPointee;
+using ::testing::Lt;
+using ::testing::InSequence;
+using ::testing::IsEmpty;
+using ::testing::Contains;
+using ::testing::Pair;
+using ::curve::common::ZlibCompressor;
+using ::curve::common::kCompressMetaKey;
 namespace curve {
 namespace snapshotcloneserver {
 
@@ -135,7 +144,8 @@ TEST_F(TestS3SnapshotDataStore, testDataChunkTransferInit) {
     Aws::String uploadID = "test-uploadID";
     Aws::String null_uploadID = "";
     std::shared_ptr<TransferTask> task = std::make_shared<TransferTask>();
-    EXPECT_CALL(*adapter4Data_, MultiUploadInit(_))
+    // 未压缩的对象不设置元数据
+    EXPECT_CALL(*adapter4Data_, MultiUploadInit(_, IsEmpty()))
         .Times(2)
         .WillOnce(Return(uploadID))
         .WillOnce(Return(null_uploadID));
@@ -164,6 +174,184 @@ TEST_F(TestS3SnapshotDataStore, testDataChunkTransferAddPart) {
               DataChunkTranferAddPart(cdName, task, 2, 1024*1024, buf));
     delete [] buf;
 }
+TEST_F(TestS3SnapshotDataStore, testDataChunkTransferWithBase) {
+    ChunkDataName baseName("test", 1, 1);
+    ChunkDataName cdName("test", 2, 1);
+    const int partSize = 4096;
+    std::unique_ptr<char[]> buf1(new char[partSize]);
+    std::unique_ptr<char[]> buf2(new char[partSize]);
+    std::unique_ptr<char[]> buf3(new char[partSize]);
+    memset(buf1.get(), 'a', partSize);
+    memset(buf2.get(), 'b', partSize);
+    memset(buf3.get(), 'c', partSize);
+    Aws::S3::Model::CompletedPart cp =
+        Aws::S3::Model::CompletedPart().WithETag("mytest").WithPartNumber(1);
+    Aws::S3::Model::CompletedPart cp_err =
+        Aws::S3::Model::CompletedPart().WithETag("errorTag").WithPartNumber(-1);
+
+    // 1. 全量转储基准对象，完成时保存各分片摘要
+    auto baseTask = std::make_shared<TransferTask>();
+    EXPECT_CALL(*adapter4Data_, UploadOnePart(_, _, _, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(cp));
+    ASSERT_EQ(0, store_->DataChunkTranferAddPart(
+        baseName, baseTask, 0, partSize, buf1.get()));
+    ASSERT_EQ(0, store_->DataChunkTranferAddPart(
+        baseName, baseTask, 1, partSize, buf2.get()));
+    auto digests = baseTask->GetPartDigest();
+    ASSERT_EQ(2, digests.size());
+    ASSERT_NE(digests[0], digests[1]);
+    std::string digestData = std::to_string(partSize) + " none\n"
+        + digests[0] + "\n" + digests[1] + "\n";
+    EXPECT_CALL(*adapter4Data_, CompleteMultiUpload(_, _, _))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*adapter4Data_,
+        PutObject(Aws::String("test-1-1.digest"), digestData))
+        .WillOnce(Return(0));
+    // 未压缩的对象删除之前转储可能留下的块索引
+    EXPECT_CALL(*adapter4Data_, DeleteObject(Aws::String("test-1-1.cidx")))
+        .WillOnce(Return(0));
+    ASSERT_EQ(0, store_->DataChunkTranferComplete(baseName, baseTask));
+
+    // 2. 以基准对象增量转储，未变化的分片拷贝，变化的分片上传
+    auto task = std::make_shared<TransferTask>();
+    task->hasBase_ = true;
+    task->baseName_ = baseName;
+    EXPECT_CALL(*adapter4Data_,
+        GetObject(Aws::String("test-1-1.digest"), _))
+        .WillOnce(DoAll(SetArgPointee<1>(digestData), Return(0)));
+    EXPECT_CALL(*adapter4Data_, MultiUploadInit(_, _))
+        .WillOnce(Return(Aws::String("test-uploadID")));
+    ASSERT_EQ(0, store_->DataChunkTranferInit(cdName, task));
+    ASSERT_TRUE(task->hasBase_);
+    ASSERT_EQ(partSize, task->basePartSize_);
+
+    EXPECT_CALL(*adapter4Data_, UploadPartCopy(Aws::String("test-1-2"), _,
+        1, Aws::String("test-1-1"), 0, partSize))
+        .WillOnce(Return(cp));
+    EXPECT_CALL(*adapter4Data_, UploadOnePart(_, _, 2, partSize, _))
+        .WillOnce(Return(cp));
+    ASSERT_EQ(0, store_->DataChunkTranferAddPart(
+        cdName, task, 0, partSize, buf1.get()));
+    ASSERT_EQ(0, store_->DataChunkTranferAddPart(
+        cdName, task, 1, partSize, buf3.get()));
+
+    // 3. 从基准对象拷贝失败时，退化为上传该分片
+    EXPECT_CALL(*adapter4Data_, UploadPartCopy(_, _, 1, _, 0, partSize))
+        .WillOnce(Return(cp_err));
+    EXPECT_CALL(*adapter4Data_, UploadOnePart(_, _, 1, partSize, _))
+        .WillOnce(Return(cp));
+    ASSERT_EQ(0, store_->DataChunkTranferAddPart(
+        cdName, task, 0, partSize, buf1.get()));
+
+    // 4. 基准对象的摘要不存在时全量转储
+    auto task2 = std::make_shared<TransferTask>();
+    task2->hasBase_ = true;
+    task2->baseName_ = baseName;
+    EXPECT_CALL(*adapter4Data_, GetObject(_, _))
+        .WillOnce(Return(-1));
+    EXPECT_CALL(*adapter4Data_, MultiUploadInit(_, _))
+        .WillOnce(Return(Aws::String("test-uploadID")));
+    ASSERT_EQ(0, store_->DataChunkTranferInit(cdName, task2));
+    ASSERT_FALSE(task2->hasBase_);
+}
+
+TEST_F(TestS3SnapshotDataStore, testDataChunkTransferCompressed) {
+    store_->SetCompressor(std::make_shared<ZlibCompressor>(1));
+    ChunkDataName baseName("test", 1, 1);
+    ChunkDataName cdName("test", 2, 1);
+    const int partSize = 4096;
+    std::unique_ptr<char[]> zero(new char[partSize]);
+    std::unique_ptr<char[]> random(new char[partSize]);
+    memset(zero.get(), 0, partSize);
+    uint32_t seed = 1;
+    for (int i = 0; i < partSize; ++i) {
+        seed = seed * 1103515245 + 12345;
+        random[i] = static_cast<char>(seed >> 16);
+    }
+    Aws::S3::Model::CompletedPart cp =
+        Aws::S3::Model::CompletedPart().WithETag("mytest").WithPartNumber(1);
+
+    // 1. 可压缩的分片压缩后上传，不可压缩的分片上传原始数据
+    auto baseTask = std::make_shared<TransferTask>();
+    EXPECT_CALL(*adapter4Data_, UploadOnePart(_, _, 1, Lt(partSize), _))
+        .WillOnce(Return(cp));
+    EXPECT_CALL(*adapter4Data_, UploadOnePart(_, _, 2, partSize, _))
+        .WillOnce(Return(cp));
+    ASSERT_EQ(0, store_->DataChunkTranferAddPart(
+        baseName, baseTask, 0, partSize, zero.get()));
+    ASSERT_EQ(0, store_->DataChunkTranferAddPart(
+        baseName, baseTask, 1, partSize, random.get()));
+    auto storedLens = baseTask->GetPartStoredLen();
+    ASSERT_LT(storedLens[0], partSize);
+    ASSERT_EQ(partSize, storedLens[1]);
+
+    // 2. 对象完成上传后保存块索引，保存失败则删除对象，转储失败
+    CompressedBlockIndex index(CompressType::kZlib, partSize);
+    index.SetBlockLen(0, storedLens[0]);
+    index.SetBlockLen(1, partSize);
+    std::string indexData = index.Serialize();
+    {
+        InSequence s;
+        EXPECT_CALL(*adapter4Data_, CompleteMultiUpload(_, _, _))
+            .WillOnce(Return(0));
+        EXPECT_CALL(*adapter4Data_,
+            PutObject(Aws::String("test-1-1.cidx"), indexData))
+            .WillOnce(Return(-1));
+        EXPECT_CALL(*adapter4Data_, DeleteObject(Aws::String("test-1-1")))
+            .WillOnce(Return(0));
+        EXPECT_CALL(*adapter4Data_, CompleteMultiUpload(_, _, _))
+            .WillOnce(Return(0));
+        EXPECT_CALL(*adapter4Data_,
+            PutObject(Aws::String("test-1-1.cidx"), indexData))
+            .WillOnce(Return(0));
+    }
+    auto digests = baseTask->GetPartDigest();
+    std::string digestData = std::to_string(partSize) + " zlib\n"
+        + digests[0] + "\n" + digests[1] + "\n";
+    EXPECT_CALL(*adapter4Data_,
+        PutObject(Aws::String("test-1-1.digest"), digestData))
+        .WillOnce(Return(0));
+    ASSERT_EQ(-1, store_->DataChunkTranferComplete(baseName, baseTask));
+    ASSERT_EQ(0, store_->DataChunkTranferComplete(baseName, baseTask));
+
+    // 3. 增量转储时按基准对象的块索引拷贝压缩后的分片
+    auto task = std::make_shared<TransferTask>();
+    task->hasBase_ = true;
+    task->baseName_ = baseName;
+    EXPECT_CALL(*adapter4Data_,
+        GetObject(Aws::String("test-1-1.digest"), _))
+        .WillOnce(DoAll(SetArgPointee<1>(digestData), Return(0)));
+    EXPECT_CALL(*adapter4Data_,
+        GetObject(Aws::String("test-1-1.cidx"), _))
+        .WillOnce(DoAll(SetArgPointee<1>(indexData), Return(0)));
+    // 压缩的对象在元数据中记录压缩算法
+    EXPECT_CALL(*adapter4Data_, MultiUploadInit(_,
+        Contains(Pair(Aws::String(kCompressMetaKey), Aws::String("zlib")))))
+        .WillOnce(Return(Aws::String("test-uploadID")));
+    ASSERT_EQ(0, store_->DataChunkTranferInit(cdName, task));
+    ASSERT_TRUE(task->hasBase_);
+    EXPECT_CALL(*adapter4Data_, UploadPartCopy(_, _, 2,
+        Aws::String("test-1-1"), storedLens[0], partSize))
+        .WillOnce(Return(cp));
+    ASSERT_EQ(0, store_->DataChunkTranferAddPart(
+        cdName, task, 1, partSize, random.get()));
+
+    // 4. 基准对象未压缩时全量转储
+    auto task2 = std::make_shared<TransferTask>();
+    task2->hasBase_ = true;
+    task2->baseName_ = baseName;
+    std::string rawDigest = std::to_string(partSize) + "\n"
+        + digests[0] + "\n" + digests[1] + "\n";
+    EXPECT_CALL(*adapter4Data_,
+        GetObject(Aws::String("test-1-1.digest"), _))
+        .WillOnce(DoAll(SetArgPointee<1>(rawDigest), Return(0)));
+    EXPECT_CALL(*adapter4Data_, MultiUploadInit(_, _))
+        .WillOnce(Return(Aws::String("test-uploadID")));
+    ASSERT_EQ(0, store_->DataChunkTranferInit(cdName, task2));
+    ASSERT_FALSE(task2->hasBase_);
+}
+
 TEST_F(TestS3SnapshotDataStore, testDataChunkTransferComplete) {
     ChunkDataName cdName("test", 1, 1);
     std::shared_ptr<TransferTask> task = std::make_shared<TransferTask>();
@@ -171,6 +359,9 @@ TEST_F(TestS3SnapshotDataStore, testDataChunkTransferComplete) {
         .Times(2)
         .WillOnce(Return(0))
         .WillOnce(Return(-1));
+    // 删除遗留的块索引失败不影响转储结果
+    EXPECT_CALL(*adapter4Data_, DeleteObject(Aws::String("test-1-1.cidx")))
+        .WillOnce(Return(-1));
     ASSERT_EQ(0, store_->DataChunkTranferComplete(cdName, task));
     ASSERT_EQ(-1, store_->DataChunkTranferComplete(cdName, task));
 }
@@ -181,6 +372,10 @@ TEST_F(TestS3SnapshotDataStore, testDataChunkTransferAbort) {
         .Times(2)
         .WillOnce(Return(0))
         .WillOnce(Return(-1));
+    // 中止转储时删除可能已经写入的块索引
+    EXPECT_CALL(*adapter4Data_, DeleteObject(Aws::String("test-1-1.cidx")))
+        .Times(2)
+        .WillRepeatedly(Return(0));
     ASSERT_EQ(0, store_->DataChunkTranferAbort(cdName, task));
     ASSERT_EQ(-1, store_->DataChunkTranferAbort(cdName, task));
 }
@@ -191,6 +386,11 @@ TEST_F(TestS3SnapshotDataStore, testDeleteDataChunk) {
         .Times(2)
         .WillOnce(Return(0))
         .WillOnce(Return(-1));
+    // 数据对象删除成功后删除摘要和块索引对象
+    EXPECT_CALL(*adapter4Data_, DeleteObject(Aws::String("test-1-1.digest")))
+        .WillOnce(Return(-1));
+    EXPECT_CALL(*adapter4Data_, DeleteObject(Aws::String("test-1-1.cidx")))
+        .WillOnce(Return(-1));
     ASSERT_EQ(0, store_->DeleteChunkData(cdName));
     ASSERT_EQ(-1, store_->DeleteChunkData(cdName));
 }
@@ -21,6 +21,8 @@
  */
 
 #include <gtest/gtest.h>
+
+#include <atomic>
 #include "src/tools/copyset_check_core.h"
 #include "test/tools/mock/mock_mds_client.h"
 #include "test/tools/mock/mock_chunkserver_client.h"
@@ -29,6 +31,8 @@ using ::testing::_;
 using ::testing::Return;
 using ::testing::DoAll;
 using ::testing::SetArgPointee;
+using ::testing::SaveArg;
+using ::testing::Invoke;
 using curve::mds::topology::ChunkServerStatus;
 using curve::mds::topology::DiskState;
 using curve::mds::topology::OnlineState;
@@ -47,6 +51,8 @@ class CopysetCheckCoreTest : public ::testing::Test {
         csClient_ = std::make_shared<MockChunkServerClient>();
         FLAGS_operatorMaxPeriod = 3;
         FLAGS_checkOperator = true;
+        // 用mock的client，串行访问chunkserver
+        FLAGS_fanOutConcurrency = 1;
     }
     void TearDown() {
         mdsClient_ = nullptr;
@@ -871,6 +877,88 @@ TEST_F(CopysetCheckCoreTest, CheckCopysetsInClusterError) {
     ASSERT_EQ(expectedRes, copysetCheck4.GetCopysetsRes());
 }
 
+TEST_F(CopysetCheckCoreTest, CheckCopysetsInClusterConcurrent) {
+    FLAGS_fanOutConcurrency = 4;
+    FLAGS_checkOperator = false;
+    butil::IOBuf iobuf;
+    GetIoBufForTest(&iobuf, "4294967396", "LEADER");
+    std::map<std::string, std::set<std::string>> expectedRes;
+    expectedRes[kTotal] = {"4294967396"};
+    ServerInfo server;
+    GetServerInfoForTest(&server);
+    std::vector<ServerInfo> servers = {server};
+    std::vector<ChunkServerInfo> chunkservers;
+    for (uint64_t i = 1; i <= 3; ++i) {
+        ChunkServerInfo chunkserver;
+        GetCsInfoForTest(&chunkserver, i);
+        chunkservers.emplace_back(chunkserver);
+    }
+
+    EXPECT_CALL(*mdsClient_, ListServersInCluster(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<0>(servers),
+                        Return(0)));
+    EXPECT_CALL(*mdsClient_, ListChunkServersInCluster(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<0>(chunkservers),
+                        Return(0)));
+    EXPECT_CALL(*mdsClient_, ListChunkServersOnServer(1, _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<1>(
+                            std::vector<ChunkServerInfo>{chunkservers[0]}),
+                        Return(0)));
+    // raft状态都已经并发获取，不再使用共享的csClient_
+    EXPECT_CALL(*csClient_, Init(_))
+        .Times(0);
+    std::atomic<int> created(0);
+    auto factory = [&]() {
+        auto client = std::make_shared<MockChunkServerClient>();
+        EXPECT_CALL(*client, Init(_))
+            .Times(1)
+            .WillOnce(Return(0));
+        EXPECT_CALL(*client, GetRaftStatus(_))
+            .Times(1)
+            .WillOnce(DoAll(SetArgPointee<0>(iobuf),
+                            Return(0)));
+        created.fetch_add(1);
+        return client;
+    };
+    CopysetCheckCore copysetCheck(mdsClient_, csClient_, factory);
+    ASSERT_EQ(0, copysetCheck.CheckCopysetsInCluster());
+    ASSERT_EQ(3, created.load());
+    ASSERT_EQ(0, copysetCheck.GetCopysetStatistics().unhealthyRatio);
+    ASSERT_EQ(expectedRes, copysetCheck.GetCopysetsRes());
+}
+
+TEST_F(CopysetCheckCoreTest, CheckChunkServersOnlineConcurrent) {
+    FLAGS_fanOutConcurrency = 4;
+    std::vector<std::string> csAddrs = {"127.0.0.1:9191",
+                                        "127.0.0.1:9192",
+                                        "127.0.0.1:9193"};
+    EXPECT_CALL(*csClient_, Init(_))
+        .Times(0);
+    auto factory = []() {
+        auto client = std::make_shared<MockChunkServerClient>();
+        auto addr = std::make_shared<std::string>();
+        EXPECT_CALL(*client, Init(_))
+            .WillOnce(DoAll(SaveArg<0>(addr.get()),
+                            Return(0)));
+        // 127.0.0.1:9193不在线
+        EXPECT_CALL(*client, CheckChunkServerOnline())
+            .WillOnce(Invoke([addr]() {
+                return *addr != "127.0.0.1:9193";
+            }));
+        return client;
+    };
+    CopysetCheckCore copysetCheck(mdsClient_, csClient_, factory);
+    std::map<std::string, bool> result;
+    copysetCheck.CheckChunkServersOnline(csAddrs, &result);
+    std::map<std::string, bool> expected = {{"127.0.0.1:9191", true},
+                                            {"127.0.0.1:9192", true},
+                                            {"127.0.0.1:9193", false}};
+    ASSERT_EQ(expected, result);
+}
+
 TEST_F(CopysetCheckCoreTest, CheckOperator) {
     CopysetCheckCore copysetCheck(mdsClient_, csClient_);
     std::string opName = "change_peer";
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: Mon Oct 19 2026
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <mutex>  // NOLINT
+#include <set>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/tools/fan_out.h"
+
+namespace curve {
+namespace tool {
+
+TEST(FanOutTest, ConcurrencyLimit) {
+    std::vector<std::string> addrs;
+    for (int i = 0; i < 20; ++i) {
+        addrs.emplace_back("127.0.0.1:" + std::to_string(8200 + i));
+    }
+    FanOutOption option;
+    option.concurrency = 4;
+    FanOut fanOut(option);
+
+    std::atomic<int> inflight(0);
+    std::atomic<int> maxInflight(0);
+    auto task = [&](const std::string& addr) {
+        int cur = ++inflight;
+        int prev = maxInflight.load();
+        while (cur > prev && !maxInflight.compare_exchange_weak(prev, cur)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        --inflight;
+        return addr == addrs[3] ? -1 : 0;
+    };
+    // 回调是串行的，不需要加锁
+    std::set<std::string> succeed;
+    std::set<std::string> failed;
+    auto cb = [&](const std::string& addr, int ret) {
+        if (ret == 0) {
+            succeed.emplace(addr);
+        } else {
+            failed.emplace(addr);
+        }
+    };
+    ASSERT_EQ(20, fanOut.Run(addrs, task, cb));
+    ASSERT_EQ(19, succeed.size());
+    ASSERT_EQ(1, failed.size());
+    ASSERT_EQ(1, failed.count(addrs[3]));
+    ASSERT_LE(maxInflight.load(), 4);
+    ASSERT_GT(maxInflight.load(), 1);
+}
+
+TEST(FanOutTest, Serial) {
+    std::vector<std::string> addrs = {"127.0.0.1:8200", "127.0.0.1:8201",
+                                      "127.0.0.1:8202"};
+    FanOutOption option;
+    option.concurrency = 1;
+    FanOut fanOut(option);
+    std::vector<std::string> order;
+    auto task = [](const std::string&) { return 0; };
+    auto cb = [&](const std::string& addr, int ret) {
+        ASSERT_EQ(0, ret);
+        order.emplace_back(addr);
+    };
+    ASSERT_EQ(3, fanOut.Run(addrs, task, cb));
+    ASSERT_EQ(addrs, order);
+
+    // 空列表
+    ASSERT_EQ(0, fanOut.Run({}, task, cb));
+}
+
+TEST(FanOutTest, DeadlineExceeded) {
+    std::vector<std::string> addrs;
+    for (int i = 0; i < 10; ++i) {
+        addrs.emplace_back("127.0.0.1:" + std::to_string(8200 + i));
+    }
+    FanOutOption option;
+    option.concurrency = 2;
+    option.deadlineMs = 50;
+    FanOut fanOut(option);
+    auto task = [](const std::string&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        return 0;
+    };
+    uint32_t succeed = 0;
+    uint32_t skipped = 0;
+    auto cb = [&](const std::string& addr, int ret) {
+        if (ret == 0) {
+            succeed++;
+        } else if (ret == kFanOutDeadlineExceeded) {
+            skipped++;
+        }
+    };
+    // 超时之后不再访问新的host，已经完成的结果仍然返回
+    uint32_t finished = fanOut.Run(addrs, task, cb);
+    ASSERT_EQ(succeed, finished);
+    ASSERT_GE(succeed, 2);
+    ASSERT_LT(succeed, 10);
+    ASSERT_EQ(10, succeed + skipped);
+}
+
+}  // namespace tool
+}  // namespace curve
@@ -49,6 +49,8 @@ class MockMDSClient : public MDSClient {
                                         uint64_t, PageFileSegment*));
     MOCK_METHOD2(DeleteFile, int(const std::string&, bool));
     MOCK_METHOD2(CreateFile, int(const std::string&, uint64_t));
+    MOCK_METHOD3(UpdateFileThrottleParams, int(const std::string&,
+                                               uint64_t, uint64_t));
     MOCK_METHOD3(GetChunkServerListInCopySet, int(const PoolIdType&,
                     const CopySetIdType&, std::vector<ChunkServerLocation>*));
     MOCK_METHOD3(GetChunkServerListInCopySets, int(const PoolIdType&,
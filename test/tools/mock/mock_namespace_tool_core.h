@@ -48,6 +48,8 @@ class MockNameSpaceToolCore : public NameSpaceToolCore {
                                      std::vector<ChunkServerLocation>*));
     MOCK_METHOD2(DeleteFile, int(const std::string&, bool));
     MOCK_METHOD2(CreateFile, int(const std::string&, uint64_t));
+    MOCK_METHOD3(UpdateFileThrottleParams, int(const std::string&,
+                                               uint64_t, uint64_t));
     MOCK_METHOD3(GetAllocatedSize, int(const std::string&,
                                        uint64_t*, AllocMap*));
     MOCK_METHOD2(GetFileSegments, int(const std::string&,
@@ -93,6 +93,7 @@ TEST_F(NameSpaceToolTest, SupportCommand) {
     ASSERT_TRUE(namespaceTool.SupportCommand("clean-recycle"));
     ASSERT_TRUE(namespaceTool.SupportCommand("create"));
     ASSERT_TRUE(namespaceTool.SupportCommand("chunk-location"));
+    ASSERT_TRUE(namespaceTool.SupportCommand("update-throttle"));
     ASSERT_FALSE(namespaceTool.SupportCommand("none"));
 }
 
@@ -309,6 +310,26 @@ TEST_F(NameSpaceToolTest, CreateFile) {
     ASSERT_EQ(-1, namespaceTool.RunCommand("create"));
 }
 
+TEST_F(NameSpaceToolTest, UpdateFileThrottleParams) {
+    curve::tool::NameSpaceTool namespaceTool(core_);
+    namespaceTool.PrintHelp("update-throttle");
+    EXPECT_CALL(*core_, Init(_))
+        .Times(1)
+        .WillOnce(Return(0));
+
+    // 1、正常情况
+    EXPECT_CALL(*core_, UpdateFileThrottleParams(_, _, _))
+        .Times(1)
+        .WillOnce(Return(0));
+    ASSERT_EQ(0, namespaceTool.RunCommand("update-throttle"));
+
+    // 2、修改失败
+    EXPECT_CALL(*core_, UpdateFileThrottleParams(_, _, _))
+        .Times(1)
+        .WillOnce(Return(-1));
+    ASSERT_EQ(-1, namespaceTool.RunCommand("update-throttle"));
+}
+
 TEST_F(NameSpaceToolTest, DeleteFile) {
     curve::tool::NameSpaceTool namespaceTool(core_);
     namespaceTool.PrintHelp("delete");
@@ -60,6 +60,8 @@ class StatusToolTest : public ::testing::Test {
         versionTool_ = std::make_shared<MockVersionTool>();
         metricClient_ = std::make_shared<MockMetricClient>();
         snapshotClient_ = std::make_shared<MockSnapshotCloneClient>();
+        // 用mock的client，串行访问chunkserver
+        FLAGS_fanOutConcurrency = 1;
     }
 
     void TearDown() {